@@ -10,9 +10,9 @@ AC_DEFUN([AX_LIBVSAPM_CHECK_LOCAL],
 
 dnl Function to detect if vsapmtools dependencies are available
 AC_DEFUN([AX_VSAPMTOOLS_CHECK_LOCAL],
-  [AC_CHECK_HEADERS([signal.h sys/signal.h unistd.h])
+  [AC_CHECK_HEADERS([fcntl.h signal.h sys/sendfile.h sys/signal.h sys/socket.h sys/stat.h sys/un.h unistd.h])
 
-  AC_CHECK_FUNCS([close getopt setvbuf])
+  AC_CHECK_FUNCS([close copy_file_range ftruncate getopt open_memstream pread pwrite sendfile setvbuf])
 
   AS_IF(
    [test "x$ac_cv_func_close" != xyes],
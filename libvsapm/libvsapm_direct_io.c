@@ -0,0 +1,482 @@
+/*
+ * Direct IO functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_STDLIB_H )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "libvsapm_direct_io.h"
+#include "libvsapm_libcerror.h"
+
+#if defined( HAVE_LIBVSAPM_DIRECT_IO )
+
+/* Creates a direct IO
+ * Make sure the value direct_io is referencing, is set to NULL
+ * The direct IO uses its own file descriptor of the file
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_direct_io_initialize(
+     libvsapm_direct_io_t **direct_io,
+     const char *filename,
+     size_t alignment,
+     size_t bounce_buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_direct_io_initialize";
+
+	if( direct_io == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct IO.",
+		 function );
+
+		return( -1 );
+	}
+	if( *direct_io != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid direct IO value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	/* posix_memalign requires the alignment to be a power of 2 and a multiple of the size of a pointer
+	 */
+	if( ( alignment < sizeof( void * ) )
+	 || ( ( alignment & ( alignment - 1 ) ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported alignment.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( bounce_buffer_size == 0 )
+	 || ( bounce_buffer_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+	 || ( ( bounce_buffer_size % alignment ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid bounce buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*direct_io = memory_allocate_structure(
+	              libvsapm_direct_io_t );
+
+	if( *direct_io == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create direct IO.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *direct_io,
+	     0,
+	     sizeof( libvsapm_direct_io_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear direct IO.",
+		 function );
+
+		memory_free(
+		 *direct_io );
+
+		*direct_io = NULL;
+
+		return( -1 );
+	}
+	( *direct_io )->file_descriptor = open(
+	                                   filename,
+	                                   O_RDONLY | O_DIRECT );
+
+	if( ( *direct_io )->file_descriptor == -1 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 (uint32_t) errno,
+		 "%s: unable to open file: %s for direct IO.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	( *direct_io )->alignment          = alignment;
+	( *direct_io )->bounce_buffer_size = bounce_buffer_size;
+
+	return( 1 );
+
+on_error:
+	if( *direct_io != NULL )
+	{
+		if( ( *direct_io )->file_descriptor != -1 )
+		{
+			close(
+			 ( *direct_io )->file_descriptor );
+		}
+		memory_free(
+		 *direct_io );
+
+		*direct_io = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a direct IO
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_direct_io_free(
+     libvsapm_direct_io_t **direct_io,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_direct_io_free";
+	int result            = 1;
+
+	if( direct_io == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct IO.",
+		 function );
+
+		return( -1 );
+	}
+	if( *direct_io != NULL )
+	{
+		if( close(
+		     ( *direct_io )->file_descriptor ) != 0 )
+		{
+			libcerror_system_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 (uint32_t) errno,
+			 "%s: unable to close file.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *direct_io );
+
+		*direct_io = NULL;
+	}
+	return( result );
+}
+
+/* Reads an aligned buffer at an aligned offset
+ * The buffer, buffer size and offset must be a multiple of the alignment
+ * Returns the number of bytes read, which is less than the buffer size at the end of the file, or -1 on error
+ */
+ssize_t libvsapm_direct_io_read_aligned(
+         libvsapm_direct_io_t *direct_io,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function = "libvsapm_direct_io_read_aligned";
+	size_t buffer_offset  = 0;
+	ssize_t read_count    = 0;
+
+	while( buffer_offset < buffer_size )
+	{
+		read_count = pread(
+		              direct_io->file_descriptor,
+		              &( buffer[ buffer_offset ] ),
+		              buffer_size - buffer_offset,
+		              offset + (off64_t) buffer_offset );
+
+		if( read_count < 0 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 (uint32_t) errno,
+			 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset + (off64_t) buffer_offset,
+			 offset + (off64_t) buffer_offset );
+
+			return( -1 );
+		}
+		else if( read_count == 0 )
+		{
+			break;
+		}
+		buffer_offset += (size_t) read_count;
+	}
+	return( (ssize_t) buffer_offset );
+}
+
+/* Reads a buffer at a specific offset
+ * Aligned requests are read directly into the buffer, unaligned requests are read
+ * in aligned blocks into a bounce buffer and copied into the buffer
+ * The bounce buffer is allocated per read so that concurrent reads do not serialize
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvsapm_direct_io_read_buffer_at_offset(
+         libvsapm_direct_io_t *direct_io,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	uint8_t *bounce_buffer    = NULL;
+	static char *function     = "libvsapm_direct_io_read_buffer_at_offset";
+	off64_t aligned_offset    = 0;
+	size_t aligned_size       = 0;
+	size_t bounce_buffer_size = 0;
+	size_t buffer_offset      = 0;
+	size_t copy_size          = 0;
+	size_t leading_size       = 0;
+	ssize_t read_count        = 0;
+
+	if( direct_io == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct IO.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size == 0 )
+	{
+		return( 0 );
+	}
+	if( ( ( (uintptr_t) buffer % direct_io->alignment ) == 0 )
+	 && ( ( buffer_size % direct_io->alignment ) == 0 )
+	 && ( ( (size64_t) offset % direct_io->alignment ) == 0 ) )
+	{
+		read_count = libvsapm_direct_io_read_aligned(
+		              direct_io,
+		              buffer,
+		              buffer_size,
+		              offset,
+		              error );
+
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read aligned buffer.",
+			 function );
+
+			return( -1 );
+		}
+		return( read_count );
+	}
+	leading_size       = (size_t) ( (size64_t) offset % direct_io->alignment );
+	bounce_buffer_size = leading_size + buffer_size;
+
+	if( ( bounce_buffer_size % direct_io->alignment ) != 0 )
+	{
+		bounce_buffer_size += direct_io->alignment - ( bounce_buffer_size % direct_io->alignment );
+	}
+	if( bounce_buffer_size > direct_io->bounce_buffer_size )
+	{
+		bounce_buffer_size = direct_io->bounce_buffer_size;
+	}
+	if( posix_memalign(
+	     (void **) &bounce_buffer,
+	     direct_io->alignment,
+	     bounce_buffer_size ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create bounce buffer.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < buffer_size )
+	{
+		leading_size   = (size_t) ( (size64_t) ( offset + buffer_offset ) % direct_io->alignment );
+		aligned_offset = offset + (off64_t) buffer_offset - (off64_t) leading_size;
+		aligned_size   = leading_size + ( buffer_size - buffer_offset );
+
+		if( ( aligned_size % direct_io->alignment ) != 0 )
+		{
+			aligned_size += direct_io->alignment - ( aligned_size % direct_io->alignment );
+		}
+		if( aligned_size > bounce_buffer_size )
+		{
+			aligned_size = bounce_buffer_size;
+		}
+		read_count = libvsapm_direct_io_read_aligned(
+		              direct_io,
+		              bounce_buffer,
+		              aligned_size,
+		              aligned_offset,
+		              error );
+
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read bounce buffer.",
+			 function );
+
+			goto on_error;
+		}
+		if( (size_t) read_count <= leading_size )
+		{
+			break;
+		}
+		copy_size = (size_t) read_count - leading_size;
+
+		if( copy_size > ( buffer_size - buffer_offset ) )
+		{
+			copy_size = buffer_size - buffer_offset;
+		}
+		if( memory_copy(
+		     &( buffer[ buffer_offset ] ),
+		     &( bounce_buffer[ leading_size ] ),
+		     copy_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data from bounce buffer.",
+			 function );
+
+			goto on_error;
+		}
+		buffer_offset += copy_size;
+
+		if( (size_t) read_count < aligned_size )
+		{
+			break;
+		}
+	}
+	memory_free(
+	 bounce_buffer );
+
+	return( (ssize_t) buffer_offset );
+
+on_error:
+	memory_free(
+	 bounce_buffer );
+
+	return( -1 );
+}
+
+#endif /* defined( HAVE_LIBVSAPM_DIRECT_IO ) */
+
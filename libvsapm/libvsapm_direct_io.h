@@ -0,0 +1,94 @@
+/*
+ * Direct IO functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVSAPM_DIRECT_IO_H )
+#define _LIBVSAPM_DIRECT_IO_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#include "libvsapm_libcerror.h"
+
+#if defined( O_DIRECT ) && defined( HAVE_POSIX_MEMALIGN ) && defined( HAVE_PREAD )
+#define HAVE_LIBVSAPM_DIRECT_IO
+#endif
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_LIBVSAPM_DIRECT_IO )
+
+typedef struct libvsapm_direct_io libvsapm_direct_io_t;
+
+struct libvsapm_direct_io
+{
+	/* The file descriptor
+	 */
+	int file_descriptor;
+
+	/* The alignment of buffers, offsets and sizes
+	 */
+	size_t alignment;
+
+	/* The maximum size of the bounce buffer used for unaligned reads
+	 * Every unaligned read allocates its own bounce buffer
+	 */
+	size_t bounce_buffer_size;
+};
+
+int libvsapm_direct_io_initialize(
+     libvsapm_direct_io_t **direct_io,
+     const char *filename,
+     size_t alignment,
+     size_t bounce_buffer_size,
+     libcerror_error_t **error );
+
+int libvsapm_direct_io_free(
+     libvsapm_direct_io_t **direct_io,
+     libcerror_error_t **error );
+
+ssize_t libvsapm_direct_io_read_aligned(
+         libvsapm_direct_io_t *direct_io,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+ssize_t libvsapm_direct_io_read_buffer_at_offset(
+         libvsapm_direct_io_t *direct_io,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBVSAPM_DIRECT_IO ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSAPM_DIRECT_IO_H ) */
+
@@ -0,0 +1,701 @@
+/*
+ * Glob functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+#include <wide_string.h>
+
+#include "libvsapm_glob.h"
+#include "libvsapm_libbfio.h"
+#include "libvsapm_libcerror.h"
+
+/* Globs the segment files of a (split) raw image
+ * The segment files are expected to have a numeric extension, such as .001, .002
+ * where the first segment file is the one specified by filename.
+ * If the filename has no numeric extension only the filename itself is returned
+ * Make sure the value filenames is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_glob(
+     const char *filename,
+     size_t filename_length,
+     char **filenames[],
+     int *number_of_filenames,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	char *segment_filename           = NULL;
+	void *reallocation               = NULL;
+	static char *function            = "libvsapm_glob";
+	size_t digit_index               = 0;
+	size_t number_of_digits          = 0;
+	uint32_t maximum_segment_number  = 0;
+	uint32_t segment_number          = 0;
+	uint32_t value_32bit             = 0;
+	int result                       = 0;
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( filename_length == 0 )
+	 || ( filename_length > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE - 1 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid filename length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( filenames == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filenames.",
+		 function );
+
+		return( -1 );
+	}
+	if( *filenames != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid filenames value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_filenames == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of filenames.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_filenames = 0;
+
+	/* Determine the number of digits of the segment number in the extension
+	 */
+	while( number_of_digits < filename_length )
+	{
+		if( ( filename[ filename_length - number_of_digits - 1 ] < (char) '0' )
+		 || ( filename[ filename_length - number_of_digits - 1 ] > (char) '9' ) )
+		{
+			break;
+		}
+		number_of_digits++;
+	}
+	if( ( number_of_digits == 0 )
+	 || ( number_of_digits > 9 )
+	 || ( number_of_digits == filename_length )
+	 || ( filename[ filename_length - number_of_digits - 1 ] != (char) '.' ) )
+	{
+		number_of_digits = 0;
+	}
+	for( digit_index = 0;
+	     digit_index < number_of_digits;
+	     digit_index++ )
+	{
+		segment_number *= 10;
+		segment_number += (uint32_t) ( filename[ filename_length - number_of_digits + digit_index ] - (char) '0' );
+
+		maximum_segment_number *= 10;
+		maximum_segment_number += 9;
+	}
+	if( maximum_segment_number < segment_number )
+	{
+		maximum_segment_number = segment_number;
+	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	while( segment_number <= maximum_segment_number )
+	{
+		segment_filename = narrow_string_allocate(
+		                    filename_length + 1 );
+
+		if( segment_filename == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create segment filename.",
+			 function );
+
+			goto on_error;
+		}
+		if( narrow_string_copy(
+		     segment_filename,
+		     filename,
+		     filename_length ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy filename.",
+			 function );
+
+			goto on_error;
+		}
+		segment_filename[ filename_length ] = 0;
+
+		value_32bit = segment_number;
+
+		for( digit_index = 1;
+		     digit_index <= number_of_digits;
+		     digit_index++ )
+		{
+			segment_filename[ filename_length - digit_index ] = (char) '0' + (char) ( value_32bit % 10 );
+
+			value_32bit /= 10;
+		}
+		if( libbfio_file_set_name(
+		     file_io_handle,
+		     segment_filename,
+		     filename_length,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set name in file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+		result = libbfio_handle_exists(
+		          file_io_handle,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_GENERIC,
+			 "%s: unable to test if segment file: %d exists.",
+			 function,
+			 *number_of_filenames );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			memory_free(
+			 segment_filename );
+
+			segment_filename = NULL;
+
+			break;
+		}
+		reallocation = memory_reallocate(
+		                *filenames,
+		                sizeof( char * ) * ( *number_of_filenames + 1 ) );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize filenames.",
+			 function );
+
+			goto on_error;
+		}
+		*filenames = (char **) reallocation;
+
+		( *filenames )[ *number_of_filenames ] = segment_filename;
+
+		segment_filename = NULL;
+
+		*number_of_filenames += 1;
+
+		segment_number++;
+	}
+	if( *number_of_filenames == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: missing segment file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( segment_filename != NULL )
+	{
+		memory_free(
+		 segment_filename );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( *filenames != NULL )
+	{
+		libvsapm_glob_free(
+		 *filenames,
+		 *number_of_filenames,
+		 NULL );
+
+		*filenames = NULL;
+	}
+	*number_of_filenames = 0;
+
+	return( -1 );
+}
+
+/* Frees globbed filenames
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_glob_free(
+     char *filenames[],
+     int number_of_filenames,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_glob_free";
+	int filename_index    = 0;
+
+	if( filenames == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filenames.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_filenames < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of filenames value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	for( filename_index = 0;
+	     filename_index < number_of_filenames;
+	     filename_index++ )
+	{
+		memory_free(
+		 filenames[ filename_index ] );
+	}
+	memory_free(
+	 filenames );
+
+	return( 1 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Globs the segment files of a (split) raw image
+ * The segment files are expected to have a numeric extension, such as .001, .002
+ * where the first segment file is the one specified by filename.
+ * If the filename has no numeric extension only the filename itself is returned
+ * Make sure the value filenames is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_glob_wide(
+     const wchar_t *filename,
+     size_t filename_length,
+     wchar_t **filenames[],
+     int *number_of_filenames,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	wchar_t *segment_filename        = NULL;
+	void *reallocation               = NULL;
+	static char *function            = "libvsapm_glob_wide";
+	size_t digit_index               = 0;
+	size_t number_of_digits          = 0;
+	uint32_t maximum_segment_number  = 0;
+	uint32_t segment_number          = 0;
+	uint32_t value_32bit             = 0;
+	int result                       = 0;
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( filename_length == 0 )
+	 || ( filename_length > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE - 1 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid filename length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( filenames == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filenames.",
+		 function );
+
+		return( -1 );
+	}
+	if( *filenames != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid filenames value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_filenames == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of filenames.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_filenames = 0;
+
+	/* Determine the number of digits of the segment number in the extension
+	 */
+	while( number_of_digits < filename_length )
+	{
+		if( ( filename[ filename_length - number_of_digits - 1 ] < (wchar_t) '0' )
+		 || ( filename[ filename_length - number_of_digits - 1 ] > (wchar_t) '9' ) )
+		{
+			break;
+		}
+		number_of_digits++;
+	}
+	if( ( number_of_digits == 0 )
+	 || ( number_of_digits > 9 )
+	 || ( number_of_digits == filename_length )
+	 || ( filename[ filename_length - number_of_digits - 1 ] != (wchar_t) '.' ) )
+	{
+		number_of_digits = 0;
+	}
+	for( digit_index = 0;
+	     digit_index < number_of_digits;
+	     digit_index++ )
+	{
+		segment_number *= 10;
+		segment_number += (uint32_t) ( filename[ filename_length - number_of_digits + digit_index ] - (wchar_t) '0' );
+
+		maximum_segment_number *= 10;
+		maximum_segment_number += 9;
+	}
+	if( maximum_segment_number < segment_number )
+	{
+		maximum_segment_number = segment_number;
+	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	while( segment_number <= maximum_segment_number )
+	{
+		segment_filename = wide_string_allocate(
+		                    filename_length + 1 );
+
+		if( segment_filename == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create segment filename.",
+			 function );
+
+			goto on_error;
+		}
+		if( wide_string_copy(
+		     segment_filename,
+		     filename,
+		     filename_length ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy filename.",
+			 function );
+
+			goto on_error;
+		}
+		segment_filename[ filename_length ] = 0;
+
+		value_32bit = segment_number;
+
+		for( digit_index = 1;
+		     digit_index <= number_of_digits;
+		     digit_index++ )
+		{
+			segment_filename[ filename_length - digit_index ] = (wchar_t) '0' + (wchar_t) ( value_32bit % 10 );
+
+			value_32bit /= 10;
+		}
+		if( libbfio_file_set_name_wide(
+		     file_io_handle,
+		     segment_filename,
+		     filename_length,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set name in file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+		result = libbfio_handle_exists(
+		          file_io_handle,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_GENERIC,
+			 "%s: unable to test if segment file: %d exists.",
+			 function,
+			 *number_of_filenames );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			memory_free(
+			 segment_filename );
+
+			segment_filename = NULL;
+
+			break;
+		}
+		reallocation = memory_reallocate(
+		                *filenames,
+		                sizeof( wchar_t * ) * ( *number_of_filenames + 1 ) );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize filenames.",
+			 function );
+
+			goto on_error;
+		}
+		*filenames = (wchar_t **) reallocation;
+
+		( *filenames )[ *number_of_filenames ] = segment_filename;
+
+		segment_filename = NULL;
+
+		*number_of_filenames += 1;
+
+		segment_number++;
+	}
+	if( *number_of_filenames == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: missing segment file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( segment_filename != NULL )
+	{
+		memory_free(
+		 segment_filename );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( *filenames != NULL )
+	{
+		libvsapm_glob_wide_free(
+		 *filenames,
+		 *number_of_filenames,
+		 NULL );
+
+		*filenames = NULL;
+	}
+	*number_of_filenames = 0;
+
+	return( -1 );
+}
+
+/* Frees globbed filenames
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_glob_wide_free(
+     wchar_t *filenames[],
+     int number_of_filenames,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_glob_wide_free";
+	int filename_index    = 0;
+
+	if( filenames == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filenames.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_filenames < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of filenames value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	for( filename_index = 0;
+	     filename_index < number_of_filenames;
+	     filename_index++ )
+	{
+		memory_free(
+		 filenames[ filename_index ] );
+	}
+	memory_free(
+	 filenames );
+
+	return( 1 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
@@ -1,5 +1,5 @@
 /*
- * Chunk data functions
+ * Glob functions
  *
  * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
  *
@@ -19,64 +19,54 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
-#if !defined( _LIBVSAPM_SECTOR_DATA_H )
-#define _LIBVSAPM_SECTOR_DATA_H
+#if !defined( _LIBVSAPM_GLOB_H )
+#define _LIBVSAPM_GLOB_H
 
 #include <common.h>
 #include <types.h>
 
-#include "libvsapm_libbfio.h"
+#include "libvsapm_extern.h"
 #include "libvsapm_libcerror.h"
-#include "libvsapm_libfdata.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
-typedef struct libvsapm_sector_data libvsapm_sector_data_t;
-
-struct libvsapm_sector_data
-{
-	/* The data
-	 */
-	uint8_t *data;
-
-	/* The data size
-	 */
-	size_t data_size;
-};
-
-int libvsapm_sector_data_initialize(
-     libvsapm_sector_data_t **sector_data,
-     size_t data_size,
+LIBVSAPM_EXTERN \
+int libvsapm_glob(
+     const char *filename,
+     size_t filename_length,
+     char **filenames[],
+     int *number_of_filenames,
      libcerror_error_t **error );
 
-int libvsapm_sector_data_free(
-     libvsapm_sector_data_t **sector_data,
+LIBVSAPM_EXTERN \
+int libvsapm_glob_free(
+     char *filenames[],
+     int number_of_filenames,
      libcerror_error_t **error );
 
-int libvsapm_sector_data_read_file_io_handle(
-     libvsapm_sector_data_t *sector_data,
-     libbfio_handle_t *file_io_handle,
-     off64_t sector_offset,
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+LIBVSAPM_EXTERN \
+int libvsapm_glob_wide(
+     const wchar_t *filename,
+     size_t filename_length,
+     wchar_t **filenames[],
+     int *number_of_filenames,
      libcerror_error_t **error );
 
-int libvsapm_partition_read_element_data(
-     intptr_t *data_handle,
-     libbfio_handle_t *file_io_handle,
-     libfdata_vector_t *vector,
-     libfdata_cache_t *cache,
-     int element_index,
-     int element_data_file_index,
-     off64_t element_data_offset,
-     size64_t element_data_size,
-     uint32_t element_data_flags,
-     uint8_t read_flags,
+LIBVSAPM_EXTERN \
+int libvsapm_glob_wide_free(
+     wchar_t *filenames[],
+     int number_of_filenames,
      libcerror_error_t **error );
 
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
 #if defined( __cplusplus )
 }
 #endif
 
-#endif /* !defined( _LIBVSAPM_SECTOR_DATA_H ) */
+#endif /* !defined( _LIBVSAPM_GLOB_H ) */
 
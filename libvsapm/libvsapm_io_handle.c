@@ -23,8 +23,14 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libvsapm_definitions.h"
+#include "libvsapm_direct_io.h"
 #include "libvsapm_io_handle.h"
+#include "libvsapm_io_uring.h"
 #include "libvsapm_libcerror.h"
+#include "libvsapm_libcthreads.h"
+#include "libvsapm_read_queue.h"
+#include "libvsapm_sector_cache_arena.h"
 
 /* Creates an IO handle
  * Make sure the value io_handle is referencing, is set to NULL
@@ -86,7 +92,24 @@ int libvsapm_io_handle_initialize(
 
 		goto on_error;
 	}
-	( *io_handle )->bytes_per_sector = 512;
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *io_handle )->read_queue_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create read queue mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *io_handle )->bytes_per_sector             = 512;
+	( *io_handle )->bytes_per_sector_shift       = 9;
+	( *io_handle )->sector_cache_number_of_slots = LIBVSAPM_SECTOR_CACHE_DEFAULT_NUMBER_OF_SLOTS;
 
 	return( 1 );
 
@@ -109,6 +132,7 @@ int libvsapm_io_handle_free(
      libcerror_error_t **error )
 {
 	static char *function = "libvsapm_io_handle_free";
+	int result            = 1;
 
 	if( io_handle == NULL )
 	{
@@ -123,12 +147,95 @@ int libvsapm_io_handle_free(
 	}
 	if( *io_handle != NULL )
 	{
+#if defined( HAVE_LIBVSAPM_DIRECT_IO )
+		if( ( *io_handle )->direct_io != NULL )
+		{
+			if( libvsapm_direct_io_free(
+			     &( ( *io_handle )->direct_io ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free direct IO.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
+#if defined( HAVE_LIBURING )
+		if( ( *io_handle )->io_uring != NULL )
+		{
+			if( libvsapm_io_uring_free(
+			     &( ( *io_handle )->io_uring ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free io_uring.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
+		if( ( *io_handle )->sector_cache_arena != NULL )
+		{
+			if( libvsapm_sector_cache_arena_release(
+			     &( ( *io_handle )->sector_cache_arena ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to release sector cache arena.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *io_handle )->read_queue != NULL )
+		{
+			if( libvsapm_read_queue_free(
+			     &( ( *io_handle )->read_queue ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free read queue.",
+				 function );
+
+				result = -1;
+			}
+		}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *io_handle )->read_queue_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read queue mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
 		memory_free(
 		 *io_handle );
 
 		*io_handle = NULL;
 	}
-	return( 1 );
+	return( result );
 }
 
 /* Clears the IO handle
@@ -138,7 +245,13 @@ int libvsapm_io_handle_clear(
      libvsapm_io_handle_t *io_handle,
      libcerror_error_t **error )
 {
-	static char *function = "libvsapm_io_handle_clear";
+	libvsapm_read_queue_t *read_queue = NULL;
+	static char *function             = "libvsapm_io_handle_clear";
+	int sector_cache_number_of_slots  = 0;
+
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_t *read_queue_mutex = NULL;
+#endif
 
 	if( io_handle == NULL )
 	{
@@ -151,6 +264,70 @@ int libvsapm_io_handle_clear(
 
 		return( -1 );
 	}
+#if defined( HAVE_LIBVSAPM_DIRECT_IO )
+	if( io_handle->direct_io != NULL )
+	{
+		if( libvsapm_direct_io_free(
+		     &( io_handle->direct_io ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free direct IO.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+#if defined( HAVE_LIBURING )
+	if( io_handle->io_uring != NULL )
+	{
+		if( libvsapm_io_uring_free(
+		     &( io_handle->io_uring ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free io_uring.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	if( io_handle->sector_cache_arena != NULL )
+	{
+		if( libvsapm_sector_cache_arena_release(
+		     &( io_handle->sector_cache_arena ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to release sector cache arena.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	/* The sector cache size is configured before open and is retained
+	 */
+	sector_cache_number_of_slots = io_handle->sector_cache_number_of_slots;
+
+	/* The read queue is joined when the volume is closed and is retained
+	 */
+	read_queue = io_handle->read_queue;
+
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	read_queue_mutex = io_handle->read_queue_mutex;
+#endif
+
 	if( memory_set(
 	     io_handle,
 	     0,
@@ -165,7 +342,266 @@ int libvsapm_io_handle_clear(
 
 		return( -1 );
 	}
-	io_handle->bytes_per_sector = 512;
+	io_handle->bytes_per_sector             = 512;
+	io_handle->bytes_per_sector_shift       = 9;
+	io_handle->sector_cache_number_of_slots = sector_cache_number_of_slots;
+	io_handle->read_queue                   = read_queue;
+
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	io_handle->read_queue_mutex = read_queue_mutex;
+#endif
+	return( 1 );
+}
+
+/* Retrieves the read queue
+ * Returns 1 if successful, 0 if the read queue was not created or -1 on error
+ */
+int libvsapm_io_handle_get_read_queue(
+     libvsapm_io_handle_t *io_handle,
+     libvsapm_read_queue_t **read_queue,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_io_handle_get_read_queue";
+	int result            = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     io_handle->read_queue_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read queue mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*read_queue = io_handle->read_queue;
+
+	if( *read_queue != NULL )
+	{
+		result = 1;
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     io_handle->read_queue_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read queue mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the read queue and creates it if needed
+ * The read queue is created on the first asynchronous read, so that volumes
+ * that are only read synchronously do not allocate it
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_io_handle_create_read_queue(
+     libvsapm_io_handle_t *io_handle,
+     libvsapm_read_queue_t **read_queue,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_io_handle_create_read_queue";
+	int result            = 1;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     io_handle->read_queue_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read queue mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( io_handle->read_queue == NULL )
+	{
+		if( libvsapm_read_queue_initialize(
+		     &( io_handle->read_queue ),
+		     LIBVSAPM_DEFAULT_NUMBER_OF_READ_THREADS,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create read queue.",
+			 function );
+
+			result = -1;
+		}
+	}
+	*read_queue = io_handle->read_queue;
+
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     io_handle->read_queue_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read queue mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets the number of bytes per sector
+ * The shift is set when the number of bytes per sector is a power of 2,
+ * so that sector numbers and offsets can be converted without a division
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_io_handle_set_bytes_per_sector(
+     libvsapm_io_handle_t *io_handle,
+     size_t bytes_per_sector,
+     libcerror_error_t **error )
+{
+	static char *function          = "libvsapm_io_handle_set_bytes_per_sector";
+	uint8_t bytes_per_sector_shift = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( bytes_per_sector == 0 )
+	 || ( bytes_per_sector > (size_t) UINT32_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid bytes per sector value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( bytes_per_sector & ( bytes_per_sector - 1 ) ) == 0 )
+	{
+		while( ( (size_t) 1 << bytes_per_sector_shift ) < bytes_per_sector )
+		{
+			bytes_per_sector_shift++;
+		}
+	}
+	io_handle->bytes_per_sector       = bytes_per_sector;
+	io_handle->bytes_per_sector_shift = bytes_per_sector_shift;
+
+	return( 1 );
+}
+
+
+/* Sets the size of the sector cache of a partition
+ * The size must be a power of 2 multiple of the sector cache block size
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_io_handle_set_sector_cache_size(
+     libvsapm_io_handle_t *io_handle,
+     size_t sector_cache_size,
+     libcerror_error_t **error )
+{
+	static char *function  = "libvsapm_io_handle_set_sector_cache_size";
+	size_t number_of_slots = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_slots = sector_cache_size >> LIBVSAPM_SECTOR_CACHE_BLOCK_SIZE_SHIFT;
+
+	if( ( ( sector_cache_size & ( LIBVSAPM_SECTOR_CACHE_BLOCK_SIZE - 1 ) ) != 0 )
+	 || ( number_of_slots < (size_t) LIBVSAPM_SECTOR_CACHE_MINIMUM_NUMBER_OF_SLOTS )
+	 || ( number_of_slots > (size_t) LIBVSAPM_SECTOR_CACHE_MAXIMUM_NUMBER_OF_SLOTS )
+	 || ( ( number_of_slots & ( number_of_slots - 1 ) ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid sector cache size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	io_handle->sector_cache_number_of_slots = (int) number_of_slots;
 
 	return( 1 );
 }
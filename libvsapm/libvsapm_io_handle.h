@@ -25,9 +25,14 @@
 #include <common.h>
 #include <types.h>
 
+#include "libvsapm_direct_io.h"
+#include "libvsapm_io_uring.h"
 #include "libvsapm_libbfio.h"
 #include "libvsapm_libcdata.h"
 #include "libvsapm_libcerror.h"
+#include "libvsapm_libcthreads.h"
+#include "libvsapm_read_queue.h"
+#include "libvsapm_sector_cache_arena.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -41,6 +46,52 @@ struct libvsapm_io_handle
 	 */
 	size_t bytes_per_sector;
 
+	/* The number of bytes per sector as a power of 2
+	 * or 0 if the number of bytes per sector is not a power of 2
+	 */
+	uint8_t bytes_per_sector_shift;
+
+	/* The volume data if the volume was opened from memory or NULL otherwise
+	 * The data is owned by the caller
+	 */
+	const uint8_t *memory_data;
+
+	/* The size of the volume data in memory
+	 */
+	size64_t memory_data_size;
+
+#if defined( HAVE_LIBVSAPM_DIRECT_IO )
+	/* The direct IO used to read bypassing the page cache or NULL if not used
+	 */
+	libvsapm_direct_io_t *direct_io;
+#endif
+
+#if defined( HAVE_LIBURING )
+	/* The io_uring used to read uncached asynchronously or NULL if not used
+	 */
+	libvsapm_io_uring_t *io_uring;
+#endif
+
+	/* The number of slots of the sector cache of a partition
+	 */
+	int sector_cache_number_of_slots;
+
+	/* The arena that backs the sector caches with a huge page or NULL if not used
+	 * The sector caches hold a reference to the arena
+	 */
+	libvsapm_sector_cache_arena_t *sector_cache_arena;
+
+	/* The read queue used to process asynchronous reads or NULL if not created
+	 * The read queue is created on the first asynchronous read and retained when the IO handle is cleared
+	 */
+	libvsapm_read_queue_t *read_queue;
+
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	/* The mutex that protects the creation of the read queue
+	 */
+	libcthreads_mutex_t *read_queue_mutex;
+#endif
+
 	/* Value to indicate if abort was signalled
 	 */
 	int abort;
@@ -58,6 +109,26 @@ int libvsapm_io_handle_clear(
      libvsapm_io_handle_t *io_handle,
      libcerror_error_t **error );
 
+int libvsapm_io_handle_get_read_queue(
+     libvsapm_io_handle_t *io_handle,
+     libvsapm_read_queue_t **read_queue,
+     libcerror_error_t **error );
+
+int libvsapm_io_handle_create_read_queue(
+     libvsapm_io_handle_t *io_handle,
+     libvsapm_read_queue_t **read_queue,
+     libcerror_error_t **error );
+
+int libvsapm_io_handle_set_bytes_per_sector(
+     libvsapm_io_handle_t *io_handle,
+     size_t bytes_per_sector,
+     libcerror_error_t **error );
+
+int libvsapm_io_handle_set_sector_cache_size(
+     libvsapm_io_handle_t *io_handle,
+     size_t sector_cache_size,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
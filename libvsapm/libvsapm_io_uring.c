@@ -0,0 +1,629 @@
+/*
+ * Uncached asynchronous IO (io_uring) read functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "libvsapm_io_uring.h"
+#include "libvsapm_libcerror.h"
+#include "libvsapm_libcthreads.h"
+
+#if defined( HAVE_LIBURING )
+
+/* Creates an io_uring
+ * Make sure the value io_uring is referencing, is set to NULL
+ * The io_uring uses its own file descriptor of the file
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_io_uring_initialize(
+     libvsapm_io_uring_t **io_uring,
+     const char *filename,
+     unsigned int queue_depth,
+     size_t maximum_read_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_io_uring_initialize";
+	int result            = 0;
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( *io_uring != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid io_uring value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( queue_depth == 0 )
+	 || ( queue_depth > 4096 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid queue depth value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_read_size == 0 )
+	 || ( maximum_read_size > (size_t) UINT32_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum read size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*io_uring = memory_allocate_structure(
+	             libvsapm_io_uring_t );
+
+	if( *io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create io_uring.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *io_uring,
+	     0,
+	     sizeof( libvsapm_io_uring_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear io_uring.",
+		 function );
+
+		memory_free(
+		 *io_uring );
+
+		*io_uring = NULL;
+
+		return( -1 );
+	}
+	( *io_uring )->file_descriptor = open(
+	                                  filename,
+	                                  O_RDONLY );
+
+	if( ( *io_uring )->file_descriptor == -1 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 (uint32_t) errno,
+		 "%s: unable to open file: %s.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	result = io_uring_queue_init(
+	          queue_depth,
+	          &( ( *io_uring )->ring ),
+	          0 );
+
+	if( result < 0 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 (uint32_t) -result,
+		 "%s: unable to initialize io_uring queues.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *io_uring )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
+		 function );
+
+		io_uring_queue_exit(
+		 &( ( *io_uring )->ring ) );
+
+		goto on_error;
+	}
+#endif
+	( *io_uring )->queue_depth       = queue_depth;
+	( *io_uring )->maximum_read_size = maximum_read_size;
+
+	return( 1 );
+
+on_error:
+	if( *io_uring != NULL )
+	{
+		if( ( *io_uring )->file_descriptor != -1 )
+		{
+			close(
+			 ( *io_uring )->file_descriptor );
+		}
+		memory_free(
+		 *io_uring );
+
+		*io_uring = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an io_uring
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_io_uring_free(
+     libvsapm_io_uring_t **io_uring,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_io_uring_free";
+	int result            = 1;
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( *io_uring != NULL )
+	{
+		io_uring_queue_exit(
+		 &( ( *io_uring )->ring ) );
+
+		if( close(
+		     ( *io_uring )->file_descriptor ) != 0 )
+		{
+			libcerror_system_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 (uint32_t) errno,
+			 "%s: unable to close file.",
+			 function );
+
+			result = -1;
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *io_uring )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *io_uring );
+
+		*io_uring = NULL;
+	}
+	return( result );
+}
+
+/* Queues a read request
+ * The buffer offset is stored in the request so the completion can be matched to the buffer
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_io_uring_queue_read(
+     libvsapm_io_uring_t *io_uring,
+     uint8_t *buffer,
+     size_t buffer_offset,
+     size_t read_size,
+     off64_t offset,
+     libcerror_error_t **error )
+{
+	struct io_uring_sqe *submission_queue_entry = NULL;
+	static char *function                       = "libvsapm_io_uring_queue_read";
+
+	submission_queue_entry = io_uring_get_sqe(
+	                          &( io_uring->ring ) );
+
+	if( submission_queue_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve submission queue entry.",
+		 function );
+
+		return( -1 );
+	}
+	io_uring_prep_read(
+	 submission_queue_entry,
+	 io_uring->file_descriptor,
+	 &( buffer[ buffer_offset ] ),
+	 (unsigned int) read_size,
+	 (uint64_t) ( offset + buffer_offset ) );
+
+	io_uring_sqe_set_data(
+	 submission_queue_entry,
+	 (void *) (uintptr_t) buffer_offset );
+
+	return( 1 );
+}
+
+/* Reads a buffer at a specific offset
+ * The data is read directly into the buffer and is not stored in the sector cache
+ * The buffer is split into read requests of at most the maximum read size, which are
+ * submitted up to the queue depth at once, and the completions are reaped as they arrive.
+ * Short reads are resubmitted for the remainder of the request
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvsapm_io_uring_read_buffer_at_offset(
+         libvsapm_io_uring_t *io_uring,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	struct io_uring_cqe *completion_queue_entry = NULL;
+	static char *function                       = "libvsapm_io_uring_read_buffer_at_offset";
+	size_t buffer_offset                        = 0;
+	size_t completed_size                       = 0;
+	size_t next_buffer_offset                   = 0;
+	size_t request_end_offset                   = 0;
+	size_t read_size                            = 0;
+	int number_of_pending_requests              = 0;
+	int number_of_queued_requests               = 0;
+	int read_error                              = 0;
+	int result                                  = 0;
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size == 0 )
+	{
+		return( 0 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     io_uring->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( io_uring->is_corrupted != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid io_uring - queues are corrupted.",
+		 function );
+
+		goto on_error;
+	}
+	while( ( number_of_pending_requests > 0 )
+	    || ( number_of_queued_requests > 0 )
+	    || ( ( read_error == 0 )
+	      && ( completed_size < buffer_size ) ) )
+	{
+		while( ( read_error == 0 )
+		    && ( next_buffer_offset < buffer_size )
+		    && ( ( number_of_pending_requests + number_of_queued_requests ) < (int) io_uring->queue_depth ) )
+		{
+			read_size = buffer_size - next_buffer_offset;
+
+			if( read_size > io_uring->maximum_read_size )
+			{
+				read_size = io_uring->maximum_read_size;
+			}
+			if( libvsapm_io_uring_queue_read(
+			     io_uring,
+			     buffer,
+			     next_buffer_offset,
+			     read_size,
+			     offset,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to queue read request.",
+				 function );
+
+				io_uring->is_corrupted = 1;
+
+				goto on_error;
+			}
+			next_buffer_offset        += read_size;
+			number_of_queued_requests += 1;
+		}
+		if( number_of_queued_requests > 0 )
+		{
+			result = io_uring_submit(
+			          &( io_uring->ring ) );
+
+			if( result >= 0 )
+			{
+				number_of_queued_requests  -= result;
+				number_of_pending_requests += result;
+			}
+			else if( ( result != -EAGAIN )
+			      && ( result != -EBUSY )
+			      && ( result != -EINTR ) )
+			{
+				/* The queued requests reference the buffer and cannot be withdrawn
+				 */
+				libcerror_system_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 (uint32_t) -result,
+				 "%s: unable to submit read requests.",
+				 function );
+
+				io_uring->is_corrupted = 1;
+
+				goto on_error;
+			}
+		}
+		if( number_of_pending_requests == 0 )
+		{
+			continue;
+		}
+		result = io_uring_wait_cqe(
+		          &( io_uring->ring ),
+		          &completion_queue_entry );
+
+		if( result == -EINTR )
+		{
+			continue;
+		}
+		else if( result < 0 )
+		{
+			libcerror_system_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 (uint32_t) -result,
+			 "%s: unable to wait for read completion.",
+			 function );
+
+			io_uring->is_corrupted = 1;
+
+			goto on_error;
+		}
+		buffer_offset = (size_t) (uintptr_t) io_uring_cqe_get_data(
+		                                      completion_queue_entry );
+		result        = completion_queue_entry->res;
+
+		io_uring_cqe_seen(
+		 &( io_uring->ring ),
+		 completion_queue_entry );
+
+		number_of_pending_requests -= 1;
+
+		/* Requests are aligned to the maximum read size relative to the start of the buffer
+		 */
+		request_end_offset = ( ( buffer_offset / io_uring->maximum_read_size ) + 1 ) * io_uring->maximum_read_size;
+
+		if( request_end_offset > buffer_size )
+		{
+			request_end_offset = buffer_size;
+		}
+		if( ( result == -EAGAIN )
+		 || ( result == -EINTR ) )
+		{
+			result = 0;
+		}
+		else if( result < 0 )
+		{
+			if( read_error == 0 )
+			{
+				read_error = -result;
+			}
+			continue;
+		}
+		else if( result == 0 )
+		{
+			/* The end of the file was reached before the buffer was filled
+			 */
+			if( read_error == 0 )
+			{
+				read_error = EIO;
+			}
+			continue;
+		}
+		buffer_offset  += (size_t) result;
+		completed_size += (size_t) result;
+
+		if( ( read_error == 0 )
+		 && ( buffer_offset < request_end_offset ) )
+		{
+			if( libvsapm_io_uring_queue_read(
+			     io_uring,
+			     buffer,
+			     buffer_offset,
+			     request_end_offset - buffer_offset,
+			     offset,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to queue read request.",
+				 function );
+
+				io_uring->is_corrupted = 1;
+
+				goto on_error;
+			}
+			number_of_queued_requests += 1;
+		}
+	}
+	if( read_error != 0 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 (uint32_t) read_error,
+		 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     io_uring->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( (ssize_t) completed_size );
+
+on_error:
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 io_uring->mutex,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+#endif /* defined( HAVE_LIBURING ) */
+
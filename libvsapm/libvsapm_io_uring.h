@@ -0,0 +1,105 @@
+/*
+ * Uncached asynchronous IO (io_uring) read functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVSAPM_IO_URING_H )
+#define _LIBVSAPM_IO_URING_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( HAVE_LIBURING )
+#include <liburing.h>
+#endif
+
+#include "libvsapm_libcerror.h"
+#include "libvsapm_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_LIBURING )
+
+typedef struct libvsapm_io_uring libvsapm_io_uring_t;
+
+struct libvsapm_io_uring
+{
+	/* The io_uring submission and completion queues
+	 */
+	struct io_uring ring;
+
+	/* The file descriptor
+	 */
+	int file_descriptor;
+
+	/* The number of entries in the submission queue
+	 */
+	unsigned int queue_depth;
+
+	/* The maximum size of a single read request
+	 */
+	size_t maximum_read_size;
+
+	/* Value to indicate the queues are in an unknown state and can no longer be used
+	 */
+	uint8_t is_corrupted;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The mutex that serializes access to the queues
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int libvsapm_io_uring_initialize(
+     libvsapm_io_uring_t **io_uring,
+     const char *filename,
+     unsigned int queue_depth,
+     size_t maximum_read_size,
+     libcerror_error_t **error );
+
+int libvsapm_io_uring_free(
+     libvsapm_io_uring_t **io_uring,
+     libcerror_error_t **error );
+
+int libvsapm_io_uring_queue_read(
+     libvsapm_io_uring_t *io_uring,
+     uint8_t *buffer,
+     size_t buffer_offset,
+     size_t read_size,
+     off64_t offset,
+     libcerror_error_t **error );
+
+ssize_t libvsapm_io_uring_read_buffer_at_offset(
+         libvsapm_io_uring_t *io_uring,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBURING ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSAPM_IO_URING_H ) */
+
@@ -24,17 +24,21 @@
 #include <types.h>
 
 #include "libvsapm_definitions.h"
+#include "libvsapm_direct_io.h"
 #include "libvsapm_io_handle.h"
+#include "libvsapm_io_uring.h"
 #include "libvsapm_libbfio.h"
 #include "libvsapm_libcerror.h"
+#include "libvsapm_libcnotify.h"
 #include "libvsapm_libcthreads.h"
-#include "libvsapm_libfcache.h"
-#include "libvsapm_libfdata.h"
 #include "libvsapm_partition.h"
+#include "libvsapm_partition_file_io_handle.h"
 #include "libvsapm_partition_map_entry.h"
-#include "libvsapm_sector_data.h"
+#include "libvsapm_read_queue.h"
+#include "libvsapm_sector_cache.h"
 #include "libvsapm_types.h"
 #include "libvsapm_unused.h"
+#include "libvsapm_zero_block.h"
 
 /* Creates a partition
  * Make sure the value partition is referencing, is set to NULL
@@ -51,7 +55,6 @@ int libvsapm_partition_initialize(
 	static char *function                             = "libvsapm_partition_initialize";
 	size64_t partition_size                           = 0;
 	off64_t partition_offset                          = 0;
-	int element_index                                 = 0;
 
 	if( partition == NULL )
 	{
@@ -139,7 +142,14 @@ int libvsapm_partition_initialize(
 
 		goto on_error;
 	}
-	partition_offset *= io_handle->bytes_per_sector;
+	if( io_handle->bytes_per_sector_shift != 0 )
+	{
+		partition_offset <<= io_handle->bytes_per_sector_shift;
+	}
+	else
+	{
+		partition_offset *= io_handle->bytes_per_sector;
+	}
 
 	if( libvsapm_partition_map_entry_get_number_of_sectors(
 	     partition_map_entry,
@@ -155,56 +165,28 @@ int libvsapm_partition_initialize(
 
 		goto on_error;
 	}
-	partition_size *= io_handle->bytes_per_sector;
-
-	if( libfdata_vector_initialize(
-	     &( internal_partition->sectors_vector ),
-	     io_handle->bytes_per_sector,
-	     NULL,
-	     NULL,
-	     NULL,
-	     (int (*)(intptr_t *, intptr_t *, libfdata_vector_t *, libfdata_cache_t *, int, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &libvsapm_partition_read_element_data,
-	     NULL,
-	     LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
-	     error ) != 1 )
+	if( io_handle->bytes_per_sector_shift != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create sectors vector.",
-		 function );
-
-		goto on_error;
+		partition_size <<= io_handle->bytes_per_sector_shift;
 	}
-	if( libfdata_vector_append_segment(
-	     internal_partition->sectors_vector,
-	     &element_index,
-	     0,
-	     partition_offset,
-	     partition_size,
-	     0,
-	     error ) != 1 )
+	else
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to append segment to sectors vector.",
-		 function );
-
-		goto on_error;
+		partition_size *= io_handle->bytes_per_sector;
 	}
-	if( libfcache_cache_initialize(
-	     &( internal_partition->sectors_cache ),
-	     LIBVSAPM_MAXIMUM_CACHE_ENTRIES_SECTORS,
+
+	if( libvsapm_sector_cache_initialize(
+	     &( internal_partition->sector_cache ),
+	     partition_offset,
+	     partition_size,
+	     io_handle->sector_cache_number_of_slots,
+	     io_handle->sector_cache_arena,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create sectors cache.",
+		 "%s: unable to create sector cache.",
 		 function );
 
 		goto on_error;
@@ -229,6 +211,52 @@ int libvsapm_partition_initialize(
 	internal_partition->offset              = partition_offset;
 	internal_partition->size                = partition_size;
 
+	/* When the volume was opened from memory the partition data is read directly from the buffer
+	 */
+	if( ( io_handle->memory_data != NULL )
+	 && ( (size64_t) partition_offset < io_handle->memory_data_size ) )
+	{
+		internal_partition->memory_data      = &( io_handle->memory_data[ partition_offset ] );
+		internal_partition->memory_data_size = io_handle->memory_data_size - (size64_t) partition_offset;
+
+		if( internal_partition->memory_data_size > partition_size )
+		{
+			internal_partition->memory_data_size = partition_size;
+		}
+	}
+	/* A partition that starts beyond the volume data in memory is read using the file IO handle,
+	 * which fails for data that is not in memory
+	 */
+	else if( io_handle->memory_data != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: partition offset: %" PRIi64 " (0x%08" PRIx64 ") exceeds volume data in memory.\n",
+			 function,
+			 partition_offset,
+			 partition_offset );
+		}
+#endif
+	}
+#if defined( HAVE_LIBVSAPM_DIRECT_IO )
+	/* When direct IO is used the blocks of the sector cache are read with direct IO
+	 */
+	internal_partition->sector_cache->direct_io = io_handle->direct_io;
+#endif
+#if defined( HAVE_LIBURING )
+	/* Direct IO takes precedence over asynchronous IO
+	 */
+#if defined( HAVE_LIBVSAPM_DIRECT_IO )
+	if( io_handle->direct_io == NULL )
+#endif
+	{
+		internal_partition->io_uring = io_handle->io_uring;
+	}
+#endif
+	internal_partition->io_handle = io_handle;
+
 	*partition = (libvsapm_partition_t *) internal_partition;
 
 	return( 1 );
@@ -236,6 +264,12 @@ int libvsapm_partition_initialize(
 on_error:
 	if( internal_partition != NULL )
 	{
+		if( internal_partition->sector_cache != NULL )
+		{
+			libvsapm_sector_cache_release(
+			 &( internal_partition->sector_cache ),
+			 NULL );
+		}
 		memory_free(
 		 internal_partition );
 	}
@@ -271,28 +305,28 @@ int libvsapm_partition_free(
 
 		/* The file_io_handle and partition_map_entry references are freed elsewhere
 		 */
-		if( libfdata_vector_free(
-		     &( internal_partition->sectors_vector ),
+		if( libvsapm_volume_snapshot_release(
+		     &( internal_partition->volume_snapshot ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free sectors vector.",
+			 "%s: unable to release volume snapshot.",
 			 function );
 
 			result = -1;
 		}
-		if( libfcache_cache_free(
-		     &( internal_partition->sectors_cache ),
+		if( libvsapm_sector_cache_release(
+		     &( internal_partition->sector_cache ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free sectors cache.",
+			 "%s: unable to release sector cache.",
 			 function );
 
 			result = -1;
@@ -318,164 +352,169 @@ int libvsapm_partition_free(
 	return( result );
 }
 
-/* Retrieves the ASCII encoded string of the partition name
+/* Clones a partition
+ * The clone has its own current offset, starting at 0, and shares the sector cache,
+ * the partition map entry and the IO of the source partition
+ * The clone must be freed before the volume is closed
  * Returns 1 if successful or -1 on error
  */
-int libvsapm_partition_get_name_string(
-     libvsapm_partition_t *partition,
-     char *string,
-     size_t string_size,
+int libvsapm_partition_clone(
+     libvsapm_partition_t **destination_partition,
+     libvsapm_partition_t *source_partition,
      libcerror_error_t **error )
 {
-	libvsapm_internal_partition_t *internal_partition = NULL;
-	static char *function                             = "libvsapm_partition_get_name_string";
-	int result                                        = 1;
+	libvsapm_internal_partition_t *internal_destination_partition = NULL;
+	libvsapm_internal_partition_t *internal_source_partition      = NULL;
+	static char *function                                         = "libvsapm_partition_clone";
 
-	if( partition == NULL )
+	if( destination_partition == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid partition.",
+		 "%s: invalid destination partition.",
 		 function );
 
 		return( -1 );
 	}
-	internal_partition = (libvsapm_internal_partition_t *) partition;
-
-#if defined( HAVE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_partition->read_write_lock,
-	     error ) != 1 )
+	if( *destination_partition != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid destination partition value already set.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( libvsapm_partition_map_entry_get_name_string(
-	     internal_partition->partition_map_entry,
-	     string,
-	     string_size,
-	     error ) != 1 )
+	if( source_partition == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve name string.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source partition.",
 		 function );
 
-		result = -1;
+		return( -1 );
 	}
-#if defined( HAVE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_partition->read_write_lock,
-	     error ) != 1 )
+	internal_source_partition = (libvsapm_internal_partition_t *) source_partition;
+
+	internal_destination_partition = memory_allocate_structure(
+	                                  libvsapm_internal_partition_t );
+
+	if( internal_destination_partition == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create destination partition.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	return( result );
-}
-
-/* Retrieves the ASCII encoded string of the partition type
- * Returns 1 if successful or -1 on error
- */
-int libvsapm_partition_get_type_string(
-     libvsapm_partition_t *partition,
-     char *string,
-     size_t string_size,
-     libcerror_error_t **error )
-{
-	libvsapm_internal_partition_t *internal_partition = NULL;
-	static char *function                             = "libvsapm_partition_get_type_string";
-	int result                                        = 1;
-
-	if( partition == NULL )
+	/* The values of the source partition, other than the current offset, do not change
+	 * after the partition is created and are copied without locking
+	 */
+	if( memory_copy(
+	     internal_destination_partition,
+	     internal_source_partition,
+	     sizeof( libvsapm_internal_partition_t ) ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid partition.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy source partition.",
 		 function );
 
+		memory_free(
+		 internal_destination_partition );
+
 		return( -1 );
 	}
-	internal_partition = (libvsapm_internal_partition_t *) partition;
+	internal_destination_partition->current_offset  = 0;
+	internal_destination_partition->sector_cache    = NULL;
+	internal_destination_partition->volume_snapshot = NULL;
 
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_partition->read_write_lock,
+	internal_destination_partition->read_write_lock = NULL;
+
+	if( libcthreads_read_write_lock_initialize(
+	     &( internal_destination_partition->read_write_lock ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read/write lock.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 #endif
-	if( libvsapm_partition_map_entry_get_type_string(
-	     internal_partition->partition_map_entry,
-	     string,
-	     string_size,
+	if( libvsapm_sector_cache_acquire(
+	     internal_source_partition->sector_cache,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve type string.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to acquire sector cache.",
 		 function );
 
-		result = -1;
+		goto on_error;
 	}
-#if defined( HAVE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_partition->read_write_lock,
-	     error ) != 1 )
+	internal_destination_partition->sector_cache = internal_source_partition->sector_cache;
+
+	if( internal_source_partition->volume_snapshot != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
-		 function );
+		if( libvsapm_partition_set_volume_snapshot(
+		     (libvsapm_partition_t *) internal_destination_partition,
+		     internal_source_partition->volume_snapshot,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set volume snapshot in destination partition.",
+			 function );
 
-		return( -1 );
+			goto on_error;
+		}
 	}
-#endif
-	return( result );
+	*destination_partition = (libvsapm_partition_t *) internal_destination_partition;
+
+	return( 1 );
+
+on_error:
+	if( internal_destination_partition != NULL )
+	{
+		libvsapm_partition_free(
+		 (libvsapm_partition_t **) &internal_destination_partition,
+		 NULL );
+	}
+	return( -1 );
 }
 
-/* Retrieves the partition offset relative to the start of the volume
+/* Sets the snapshot of the frozen volume the partition map entry is part of
+ * A reference to the volume snapshot is acquired that is released when the partition is freed
+ * This function should only be called before the partition is returned to the caller
  * Returns 1 if successful or -1 on error
  */
-int libvsapm_partition_get_volume_offset(
+int libvsapm_partition_set_volume_snapshot(
      libvsapm_partition_t *partition,
-     off64_t *volume_offset,
+     libvsapm_volume_snapshot_t *volume_snapshot,
      libcerror_error_t **error )
 {
 	libvsapm_internal_partition_t *internal_partition = NULL;
-	static char *function                             = "libvsapm_partition_get_volume_offset";
+	static char *function                             = "libvsapm_partition_set_volume_snapshot";
 
 	if( partition == NULL )
 	{
@@ -490,62 +529,46 @@ int libvsapm_partition_get_volume_offset(
 	}
 	internal_partition = (libvsapm_internal_partition_t *) partition;
 
-	if( volume_offset == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid volume offset.",
-		 function );
-
-		return( -1 );
-	}
-#if defined( HAVE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_partition->read_write_lock,
-	     error ) != 1 )
+	if( internal_partition->volume_snapshot != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid partition - volume snapshot value already set.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	*volume_offset = internal_partition->offset;
-
-#if defined( HAVE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_partition->read_write_lock,
+	if( libvsapm_volume_snapshot_acquire(
+	     volume_snapshot,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to acquire volume snapshot.",
 		 function );
 
 		return( -1 );
 	}
-#endif
+	internal_partition->volume_snapshot = volume_snapshot;
+
 	return( 1 );
 }
 
-/* Retrieves the partition status flags
+/* Retrieves the ASCII encoded string of the partition name
  * Returns 1 if successful or -1 on error
  */
-int libvsapm_partition_get_status_flags(
+int libvsapm_partition_get_name_string(
      libvsapm_partition_t *partition,
-     uint32_t *status_flags,
+     char *string,
+     size_t string_size,
      libcerror_error_t **error )
 {
 	libvsapm_internal_partition_t *internal_partition = NULL;
-	static char *function                             = "libvsapm_partition_get_status_flags";
+	static char *function                             = "libvsapm_partition_get_name_string";
 	int result                                        = 1;
 
 	if( partition == NULL )
@@ -562,69 +585,310 @@ int libvsapm_partition_get_status_flags(
 	internal_partition = (libvsapm_internal_partition_t *) partition;
 
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_partition->read_write_lock,
-	     error ) != 1 )
+	if( internal_partition->volume_snapshot == NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
-		 function );
+		if( libcthreads_read_write_lock_grab_for_read(
+		     internal_partition->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for reading.",
+			 function );
 
-		return( -1 );
+			return( -1 );
+		}
 	}
 #endif
-	if( libvsapm_partition_map_entry_get_status_flags(
+	if( libvsapm_partition_map_entry_get_name_string(
 	     internal_partition->partition_map_entry,
-	     status_flags,
+	     string,
+	     string_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve status flags.",
+		 "%s: unable to retrieve name string.",
 		 function );
 
 		result = -1;
 	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_partition->read_write_lock,
-	     error ) != 1 )
+	if( internal_partition->volume_snapshot == NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
-		 function );
+		if( libcthreads_read_write_lock_release_for_read(
+		     internal_partition->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for reading.",
+			 function );
 
-		return( -1 );
+			return( -1 );
+		}
 	}
 #endif
 	return( result );
 }
 
-/* Reads (partition) data at the current offset into a buffer using a Basic File IO (bfio) handle
- * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes read or -1 on error
+/* Retrieves the ASCII encoded string of the partition type
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libvsapm_internal_partition_read_buffer_from_file_io_handle(
-         libvsapm_internal_partition_t *internal_partition,
-         libbfio_handle_t *file_io_handle,
-         void *buffer,
+int libvsapm_partition_get_type_string(
+     libvsapm_partition_t *partition,
+     char *string,
+     size_t string_size,
+     libcerror_error_t **error )
+{
+	libvsapm_internal_partition_t *internal_partition = NULL;
+	static char *function                             = "libvsapm_partition_get_type_string";
+	int result                                        = 1;
+
+	if( partition == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition.",
+		 function );
+
+		return( -1 );
+	}
+	internal_partition = (libvsapm_internal_partition_t *) partition;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( internal_partition->volume_snapshot == NULL )
+	{
+		if( libcthreads_read_write_lock_grab_for_read(
+		     internal_partition->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for reading.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	if( libvsapm_partition_map_entry_get_type_string(
+	     internal_partition->partition_map_entry,
+	     string,
+	     string_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve type string.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( internal_partition->volume_snapshot == NULL )
+	{
+		if( libcthreads_read_write_lock_release_for_read(
+		     internal_partition->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for reading.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the partition offset relative to the start of the volume
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_partition_get_volume_offset(
+     libvsapm_partition_t *partition,
+     off64_t *volume_offset,
+     libcerror_error_t **error )
+{
+	libvsapm_internal_partition_t *internal_partition = NULL;
+	static char *function                             = "libvsapm_partition_get_volume_offset";
+
+	if( partition == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition.",
+		 function );
+
+		return( -1 );
+	}
+	internal_partition = (libvsapm_internal_partition_t *) partition;
+
+	if( volume_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume offset.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( internal_partition->volume_snapshot == NULL )
+	{
+		if( libcthreads_read_write_lock_grab_for_read(
+		     internal_partition->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for reading.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	*volume_offset = internal_partition->offset;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( internal_partition->volume_snapshot == NULL )
+	{
+		if( libcthreads_read_write_lock_release_for_read(
+		     internal_partition->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for reading.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the partition status flags
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_partition_get_status_flags(
+     libvsapm_partition_t *partition,
+     uint32_t *status_flags,
+     libcerror_error_t **error )
+{
+	libvsapm_internal_partition_t *internal_partition = NULL;
+	static char *function                             = "libvsapm_partition_get_status_flags";
+	int result                                        = 1;
+
+	if( partition == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition.",
+		 function );
+
+		return( -1 );
+	}
+	internal_partition = (libvsapm_internal_partition_t *) partition;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( internal_partition->volume_snapshot == NULL )
+	{
+		if( libcthreads_read_write_lock_grab_for_read(
+		     internal_partition->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for reading.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	if( libvsapm_partition_map_entry_get_status_flags(
+	     internal_partition->partition_map_entry,
+	     status_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve status flags.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( internal_partition->volume_snapshot == NULL )
+	{
+		if( libcthreads_read_write_lock_release_for_read(
+		     internal_partition->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for reading.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	return( result );
+}
+
+/* Reads (partition) data at a specific offset into a buffer using a Basic File IO (bfio) handle
+ * The current offset of the partition is not changed, the sector cache and io_uring
+ * serialize access to their own state, hence no partition lock is required
+ * Reading fails if the partition is part of a frozen volume that was closed
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvsapm_internal_partition_read_buffer_at_offset_from_file_io_handle(
+         libvsapm_internal_partition_t *internal_partition,
+         libbfio_handle_t *file_io_handle,
+         void *buffer,
          size_t buffer_size,
+         off64_t offset,
          libcerror_error_t **error )
 {
-	libvsapm_sector_data_t *sector_data = NULL;
-	static char *function               = "libvsapm_internal_partition_read_buffer_from_file_io_handle";
-	off64_t current_offset              = 0;
-	off64_t element_data_offset         = 0;
-	size_t buffer_offset                = 0;
-	size_t read_size                    = 0;
+	static char *function = "libvsapm_internal_partition_read_buffer_at_offset_from_file_io_handle";
+	ssize_t read_count    = 0;
+	int result            = 0;
 
 	if( internal_partition == NULL )
 	{
@@ -637,13 +901,13 @@ ssize_t libvsapm_internal_partition_read_buffer_from_file_io_handle(
 
 		return( -1 );
 	}
-	if( internal_partition->current_offset < 0 )
+	if( offset < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid partition - current offset value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
 		 function );
 
 		return( -1 );
@@ -674,77 +938,201 @@ ssize_t libvsapm_internal_partition_read_buffer_from_file_io_handle(
 	{
 		return( 0 );
 	}
-	if( (size64_t) internal_partition->current_offset >= internal_partition->size )
+	if( (size64_t) offset >= internal_partition->size )
 	{
 		return( 0 );
 	}
-	if( (size64_t) buffer_size > ( internal_partition->size - internal_partition->current_offset ) )
+	if( (size64_t) buffer_size > ( internal_partition->size - offset ) )
 	{
-		buffer_size = (size_t) ( internal_partition->size - internal_partition->current_offset );
+		buffer_size = (size_t) ( internal_partition->size - offset );
 	}
-	current_offset = internal_partition->current_offset;
-
-	while( buffer_size > 0 )
+	/* The IO of a frozen volume is freed when the volume is closed, while the partition can outlive it
+	 */
+	if( internal_partition->volume_snapshot != NULL )
 	{
-		if( libfdata_vector_get_element_value_at_offset(
-		     internal_partition->sectors_vector,
-		     (intptr_t *) file_io_handle,
-		     (libfdata_cache_t *) internal_partition->sectors_cache,
-		     current_offset,
-		     &element_data_offset,
-		     (intptr_t **) &sector_data,
-		     0,
-		     error ) != 1 )
+		result = libvsapm_volume_snapshot_grab_for_read(
+		          internal_partition->volume_snapshot,
+		          error );
+
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve sector data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
-			 function,
-			 current_offset,
-			 current_offset );
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab volume snapshot for reading.",
+			 function );
 
 			return( -1 );
 		}
-		if( sector_data == NULL )
+		else if( result == 0 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing sector data.",
+			 "%s: invalid partition - volume was closed.",
 			 function );
 
 			return( -1 );
 		}
-		read_size = sector_data->data_size - (size_t) element_data_offset;
-
-		if( buffer_size < read_size )
+	}
+	if( internal_partition->memory_data != NULL )
+	{
+		if( ( (size64_t) offset >= internal_partition->memory_data_size )
+		 || ( (size64_t) buffer_size > ( internal_partition->memory_data_size - offset ) ) )
 		{
-			read_size = buffer_size;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read partition data at offset: %" PRIi64 " (0x%08" PRIx64 ") - data exceeds volume data in memory.",
+			 function,
+			 offset,
+			 offset );
+
+			goto on_error;
 		}
 		if( memory_copy(
-		     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
-		     &( sector_data->data[ element_data_offset ] ),
-		     read_size ) == NULL )
+		     buffer,
+		     &( internal_partition->memory_data[ offset ] ),
+		     buffer_size ) == NULL )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_MEMORY,
 			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy sector data.",
+			 "%s: unable to copy partition data.",
+			 function );
+
+			goto on_error;
+		}
+		read_count = (ssize_t) buffer_size;
+	}
+#if defined( HAVE_LIBURING )
+	/* When asynchronous IO is used the partition data is read directly, bypassing the sectors cache
+	 */
+	else if( internal_partition->io_uring != NULL )
+	{
+		read_count = libvsapm_io_uring_read_buffer_at_offset(
+		              internal_partition->io_uring,
+		              (uint8_t *) buffer,
+		              buffer_size,
+		              internal_partition->offset + offset,
+		              error );
+	}
+#endif
+	else
+	{
+		read_count = libvsapm_sector_cache_read_buffer_at_offset(
+		              internal_partition->sector_cache,
+		              file_io_handle,
+		              (uint8_t *) buffer,
+		              buffer_size,
+		              offset,
+		              error );
+	}
+	if( read_count != (ssize_t) buffer_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read partition data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		goto on_error;
+	}
+	if( internal_partition->volume_snapshot != NULL )
+	{
+		if( libvsapm_volume_snapshot_release_for_read(
+		     internal_partition->volume_snapshot,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release volume snapshot for reading.",
 			 function );
 
 			return( -1 );
 		}
-		current_offset += read_size;
-		buffer_offset  += read_size;
-		buffer_size    -= read_size;
 	}
-	internal_partition->current_offset = current_offset;
+	return( read_count );
 
-	return( (ssize_t) buffer_offset );
+on_error:
+	if( internal_partition->volume_snapshot != NULL )
+	{
+		libvsapm_volume_snapshot_release_for_read(
+		 internal_partition->volume_snapshot,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads (partition) data at the current offset into a buffer using a Basic File IO (bfio) handle
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvsapm_internal_partition_read_buffer_from_file_io_handle(
+         libvsapm_internal_partition_t *internal_partition,
+         libbfio_handle_t *file_io_handle,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	static char *function = "libvsapm_internal_partition_read_buffer_from_file_io_handle";
+	ssize_t read_count    = 0;
+
+	if( internal_partition == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_partition->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid partition - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = libvsapm_internal_partition_read_buffer_at_offset_from_file_io_handle(
+	              internal_partition,
+	              file_io_handle,
+	              buffer,
+	              buffer_size,
+	              internal_partition->current_offset,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 internal_partition->current_offset,
+		 internal_partition->current_offset );
+
+		return( -1 );
+	}
+	internal_partition->current_offset += (off64_t) read_count;
+
+	return( read_count );
 }
 
 /* Reads (partition) data at the current offset into a buffer
@@ -824,19 +1212,194 @@ ssize_t libvsapm_partition_read_buffer(
 	return( read_count );
 }
 
-/* Reads (partition) data at a specific offset
- * Returns the number of bytes read or -1 on error
+/* Reads (partition) data at a specific offset
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvsapm_partition_read_buffer_at_offset(
+         libvsapm_partition_t *partition,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libvsapm_internal_partition_t *internal_partition = NULL;
+	static char *function                             = "libvsapm_partition_read_buffer_at_offset";
+	ssize_t read_count                                = 0;
+
+	if( partition == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition.",
+		 function );
+
+		return( -1 );
+	}
+	internal_partition = (libvsapm_internal_partition_t *) partition;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_partition->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libvsapm_internal_partition_seek_offset(
+	     internal_partition,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libvsapm_internal_partition_read_buffer_from_file_io_handle(
+		      internal_partition,
+		      internal_partition->file_io_handle,
+		      buffer,
+		      buffer_size,
+		      error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_partition->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+
+on_error:
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_partition->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Reads (partition) data of a read request
+ * The read is positional, the current offset of the partition is not changed
+ * and the partition lock is not taken, so that read requests of the same
+ * partition are processed concurrently by the worker threads
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvsapm_internal_partition_read_request(
+         libvsapm_internal_partition_t *internal_partition,
+         libvsapm_read_request_t *read_request,
+         libcerror_error_t **error )
+{
+	static char *function = "libvsapm_internal_partition_read_request";
+	ssize_t read_count    = 0;
+
+	if( internal_partition == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read request.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = libvsapm_internal_partition_read_buffer_at_offset_from_file_io_handle(
+	              internal_partition,
+	              internal_partition->file_io_handle,
+	              read_request->buffer,
+	              read_request->buffer_size,
+	              read_request->offset,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 read_request->offset,
+		 read_request->offset );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
+/* Reads (partition) data at a specific offset asynchronously
+ * The read is processed by the worker threads of the volume and the callback is
+ * called when the completion is retrieved with libvsapm_volume_poll_completions
+ * The buffer must remain valid and the partition must not be freed until then
+ * This function does not wait when the maximum number of pending reads is reached
+ * Returns 1 if successful, 0 if the read queue is full or -1 on error
  */
-ssize_t libvsapm_partition_read_buffer_at_offset(
-         libvsapm_partition_t *partition,
-         void *buffer,
-         size_t buffer_size,
-         off64_t offset,
-         libcerror_error_t **error )
+int libvsapm_partition_read_async(
+     libvsapm_partition_t *partition,
+     off64_t offset,
+     void *buffer,
+     size_t buffer_size,
+     int (*callback)(
+            libvsapm_partition_t *partition,
+            off64_t offset,
+            void *buffer,
+            ssize_t read_count,
+            void *user_data ),
+     void *user_data,
+     libcerror_error_t **error )
 {
 	libvsapm_internal_partition_t *internal_partition = NULL;
-	static char *function                             = "libvsapm_partition_read_buffer_at_offset";
-	ssize_t read_count                                = 0;
+	libvsapm_read_queue_t *read_queue                 = NULL;
+	libvsapm_read_request_t *read_request             = NULL;
+	static char *function                             = "libvsapm_partition_read_async";
+	int result                                        = 0;
+	int snapshot_grabbed                              = 0;
 
 	if( partition == NULL )
 	{
@@ -851,77 +1414,137 @@ ssize_t libvsapm_partition_read_buffer_at_offset(
 	}
 	internal_partition = (libvsapm_internal_partition_t *) partition;
 
-#if defined( HAVE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_partition->read_write_lock,
-	     error ) != 1 )
+	if( internal_partition->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid partition - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( libvsapm_internal_partition_seek_offset(
-	     internal_partition,
+	if( libvsapm_read_request_initialize(
+	     &read_request,
+	     partition,
 	     offset,
-	     SEEK_SET,
-	     error ) == -1 )
+	     buffer,
+	     buffer_size,
+	     callback,
+	     user_data,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create read request.",
 		 function );
 
 		goto on_error;
 	}
-	read_count = libvsapm_internal_partition_read_buffer_from_file_io_handle(
-		      internal_partition,
-		      internal_partition->file_io_handle,
-		      buffer,
-		      buffer_size,
-		      error );
+	/* The read queue is owned by the IO handle of the volume, a frozen volume must not be closed while pushing
+	 */
+	if( internal_partition->volume_snapshot != NULL )
+	{
+		result = libvsapm_volume_snapshot_grab_for_read(
+		          internal_partition->volume_snapshot,
+		          error );
 
-	if( read_count == -1 )
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab volume snapshot for reading.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid partition - volume was closed.",
+			 function );
+
+			goto on_error;
+		}
+		snapshot_grabbed = 1;
+	}
+	if( libvsapm_io_handle_create_read_queue(
+	     internal_partition->io_handle,
+	     &read_queue,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create read queue.",
 		 function );
 
 		goto on_error;
 	}
-#if defined( HAVE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_partition->read_write_lock,
-	     error ) != 1 )
+	result = libvsapm_read_queue_push(
+	          read_queue,
+	          read_request,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push read request.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	return( read_count );
+	else if( result == 0 )
+	{
+		/* The read queue is full, the caller should poll for completions and retry
+		 */
+		libvsapm_read_request_free(
+		 &read_request,
+		 NULL );
+	}
+	if( snapshot_grabbed != 0 )
+	{
+		if( libvsapm_volume_snapshot_release_for_read(
+		     internal_partition->volume_snapshot,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release volume snapshot for reading.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( result );
 
 on_error:
-#if defined( HAVE_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_partition->read_write_lock,
-	 NULL );
-#endif
+	if( snapshot_grabbed != 0 )
+	{
+		libvsapm_volume_snapshot_release_for_read(
+		 internal_partition->volume_snapshot,
+		 NULL );
+	}
+	if( read_request != NULL )
+	{
+		libvsapm_read_request_free(
+		 &read_request,
+		 NULL );
+	}
 	return( -1 );
 }
 
@@ -1166,37 +1789,329 @@ int libvsapm_partition_get_size(
 		return( -1 );
 	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_partition->read_write_lock,
-	     error ) != 1 )
+	if( internal_partition->volume_snapshot == NULL )
+	{
+		if( libcthreads_read_write_lock_grab_for_read(
+		     internal_partition->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for reading.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	*size = internal_partition->size;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( internal_partition->volume_snapshot == NULL )
+	{
+		if( libcthreads_read_write_lock_release_for_read(
+		     internal_partition->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for reading.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the ranges of the partition that only contain zero bytes
+ * The partition data is checked in blocks of block size, the last block can be smaller
+ * The callback function is called for every run of consecutive zero blocks, with the offset
+ * relative to the start of the partition and the size of the range. The callback function
+ * should return 1 to continue, 0 to stop or -1 on error
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_partition_get_sparse_ranges(
+     libvsapm_partition_t *partition,
+     size32_t block_size,
+     int (*callback)(
+            off64_t range_offset,
+            size64_t range_size,
+            void *callback_data ),
+     void *callback_data,
+     libcerror_error_t **error )
+{
+	libvsapm_internal_partition_t *internal_partition = NULL;
+	uint8_t *buffer                                   = NULL;
+	static char *function                             = "libvsapm_partition_get_sparse_ranges";
+	size64_t range_size                               = 0;
+	size_t block_data_size                            = 0;
+	size_t buffer_offset                              = 0;
+	size_t buffer_size                                = 0;
+	size_t read_size                                  = 0;
+	ssize_t read_count                                = 0;
+	off64_t range_offset                              = 0;
+	off64_t scan_offset                               = 0;
+	int result                                        = 0;
+
+	if( partition == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	*size = internal_partition->size;
+	internal_partition = (libvsapm_internal_partition_t *) partition;
 
-#if defined( HAVE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_partition->read_write_lock,
+	if( ( block_size == 0 )
+	 || ( block_size > LIBVSAPM_MAXIMUM_SPARSE_RANGES_BLOCK_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( callback == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callback.",
+		 function );
+
+		return( -1 );
+	}
+	/* The data is read into a buffer of a multiple of the block size and checked in place
+	 * The partition read function serializes access to the sector cache, direct IO and
+	 * io_uring state, hence no partition lock is required and the current offset is not changed
+	 */
+	buffer_size = ( LIBVSAPM_SPARSE_RANGES_BUFFER_SIZE / block_size ) * block_size;
+
+	if( buffer_size == 0 )
+	{
+		buffer_size = (size_t) block_size;
+	}
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * buffer_size );
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		goto on_error;
+	}
+	while( (size64_t) scan_offset < internal_partition->size )
+	{
+		read_size = buffer_size;
+
+		if( (size64_t) read_size > ( internal_partition->size - scan_offset ) )
+		{
+			read_size = (size_t) ( internal_partition->size - scan_offset );
+		}
+		read_count = libvsapm_internal_partition_read_buffer_at_offset_from_file_io_handle(
+		              internal_partition,
+		              internal_partition->file_io_handle,
+		              buffer,
+		              read_size,
+		              scan_offset,
+		              error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read partition data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 scan_offset,
+			 scan_offset );
+
+			goto on_error;
+		}
+		for( buffer_offset = 0;
+		     buffer_offset < read_size;
+		     buffer_offset += block_data_size )
+		{
+			block_data_size = read_size - buffer_offset;
+
+			if( block_data_size > (size_t) block_size )
+			{
+				block_data_size = (size_t) block_size;
+			}
+			result = libvsapm_zero_block_check(
+			          &( buffer[ buffer_offset ] ),
+			          block_data_size,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to determine if block at offset: %" PRIi64 " (0x%08" PRIx64 ") only contains zero bytes.",
+				 function,
+				 scan_offset + buffer_offset,
+				 scan_offset + buffer_offset );
+
+				goto on_error;
+			}
+			else if( result != 0 )
+			{
+				if( range_size == 0 )
+				{
+					range_offset = scan_offset + (off64_t) buffer_offset;
+				}
+				range_size += block_data_size;
+			}
+			else if( range_size > 0 )
+			{
+				result = callback(
+				          range_offset,
+				          range_size,
+				          callback_data );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GENERIC,
+					 "%s: callback failed for range at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+					 function,
+					 range_offset,
+					 range_offset );
+
+					goto on_error;
+				}
+				else if( result == 0 )
+				{
+					memory_free(
+					 buffer );
+
+					return( 1 );
+				}
+				range_size = 0;
+			}
+		}
+		scan_offset += (off64_t) read_size;
+	}
+	if( range_size > 0 )
+	{
+		result = callback(
+		          range_offset,
+		          range_size,
+		          callback_data );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: callback failed for range at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 range_offset,
+			 range_offset );
+
+			goto on_error;
+		}
+	}
+	memory_free(
+	 buffer );
+
+	return( 1 );
+
+on_error:
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	return( -1 );
+}
+
+
+/* Retrieves a file IO handle of the partition
+ * The file IO handle reads the partition data using its own clone of the partition
+ * and has the same lifetime as a clone of the partition
+ * The file IO handle must be freed by the caller
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_partition_get_file_io_handle(
+     libvsapm_partition_t *partition,
+     libbfio_handle_t **file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_partition_get_file_io_handle";
+
+	if( partition == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file IO handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvsapm_partition_file_io_handle_initialize_handle(
+	     file_io_handle,
+	     partition,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
 		 function );
 
 		return( -1 );
 	}
-#endif
 	return( 1 );
 }
 
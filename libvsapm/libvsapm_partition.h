@@ -27,13 +27,15 @@
 
 #include "libvsapm_extern.h"
 #include "libvsapm_io_handle.h"
+#include "libvsapm_io_uring.h"
 #include "libvsapm_libbfio.h"
 #include "libvsapm_libcerror.h"
 #include "libvsapm_libcthreads.h"
-#include "libvsapm_libfcache.h"
-#include "libvsapm_libfdata.h"
 #include "libvsapm_partition_map_entry.h"
+#include "libvsapm_read_queue.h"
+#include "libvsapm_sector_cache.h"
 #include "libvsapm_types.h"
+#include "libvsapm_volume_snapshot.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -51,13 +53,9 @@ struct libvsapm_internal_partition
 	 */
 	libvsapm_partition_map_entry_t *partition_map_entry;
 
-	/* The sectors vector
+	/* The sector cache, shared with the clones of the partition
 	 */
-	libfdata_vector_t *sectors_vector;
-
-	/* The sectors cache
-	 */
-	libfcache_cache_t *sectors_cache;
+	libvsapm_sector_cache_t *sector_cache;
 
 	/* The current offset
 	 */
@@ -71,6 +69,31 @@ struct libvsapm_internal_partition
 	 */
 	size64_t size;
 
+	/* The partition data if the volume was opened from memory or NULL otherwise
+	 */
+	const uint8_t *memory_data;
+
+	/* The size of the partition data that is available in memory
+	 */
+	size64_t memory_data_size;
+
+#if defined( HAVE_LIBURING )
+	/* The io_uring used to read the partition data uncached asynchronously or NULL if not used
+	 * The io_uring is owned by the IO handle
+	 */
+	libvsapm_io_uring_t *io_uring;
+#endif
+
+	/* The IO handle used to create the read queue on the first asynchronous read
+	 * The IO handle is owned by the volume
+	 */
+	libvsapm_io_handle_t *io_handle;
+
+	/* The snapshot of the frozen volume that contains the partition map entry or NULL if not set
+	 * The partition metadata of a frozen volume is immutable and is retrieved without locking
+	 */
+	libvsapm_volume_snapshot_t *volume_snapshot;
+
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 	/* The read/write lock
 	 */
@@ -90,6 +113,17 @@ int libvsapm_partition_free(
      libvsapm_partition_t **partition,
      libcerror_error_t **error );
 
+LIBVSAPM_EXTERN \
+int libvsapm_partition_clone(
+     libvsapm_partition_t **destination_partition,
+     libvsapm_partition_t *source_partition,
+     libcerror_error_t **error );
+
+int libvsapm_partition_set_volume_snapshot(
+     libvsapm_partition_t *partition,
+     libvsapm_volume_snapshot_t *volume_snapshot,
+     libcerror_error_t **error );
+
 LIBVSAPM_EXTERN \
 int libvsapm_partition_get_name_string(
      libvsapm_partition_t *partition,
@@ -116,6 +150,14 @@ int libvsapm_partition_get_status_flags(
      uint32_t *status_flags,
      libcerror_error_t **error );
 
+ssize_t libvsapm_internal_partition_read_buffer_at_offset_from_file_io_handle(
+         libvsapm_internal_partition_t *internal_partition,
+         libbfio_handle_t *file_io_handle,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
 ssize_t libvsapm_internal_partition_read_buffer_from_file_io_handle(
          libvsapm_internal_partition_t *internal_partition,
          libbfio_handle_t *file_io_handle,
@@ -138,6 +180,26 @@ ssize_t libvsapm_partition_read_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error );
 
+ssize_t libvsapm_internal_partition_read_request(
+         libvsapm_internal_partition_t *internal_partition,
+         libvsapm_read_request_t *read_request,
+         libcerror_error_t **error );
+
+LIBVSAPM_EXTERN \
+int libvsapm_partition_read_async(
+     libvsapm_partition_t *partition,
+     off64_t offset,
+     void *buffer,
+     size_t buffer_size,
+     int (*callback)(
+            libvsapm_partition_t *partition,
+            off64_t offset,
+            void *buffer,
+            ssize_t read_count,
+            void *user_data ),
+     void *user_data,
+     libcerror_error_t **error );
+
 off64_t libvsapm_internal_partition_seek_offset(
          libvsapm_internal_partition_t *internal_partition,
          off64_t offset,
@@ -163,6 +225,23 @@ int libvsapm_partition_get_size(
      size64_t *size,
      libcerror_error_t **error );
 
+LIBVSAPM_EXTERN \
+int libvsapm_partition_get_sparse_ranges(
+     libvsapm_partition_t *partition,
+     size32_t block_size,
+     int (*callback)(
+            off64_t range_offset,
+            size64_t range_size,
+            void *callback_data ),
+     void *callback_data,
+     libcerror_error_t **error );
+
+LIBVSAPM_EXTERN \
+int libvsapm_partition_get_file_io_handle(
+     libvsapm_partition_t *partition,
+     libbfio_handle_t **file_io_handle,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -0,0 +1,649 @@
+/*
+ * Partition file IO handle functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvsapm_libbfio.h"
+#include "libvsapm_libcerror.h"
+#include "libvsapm_partition.h"
+#include "libvsapm_partition_file_io_handle.h"
+#include "libvsapm_unused.h"
+
+/* Creates a partition file IO handle
+ * Make sure the value partition_file_io_handle is referencing, is set to NULL
+ * The partition file IO handle reads from its own clone of the partition
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_partition_file_io_handle_initialize(
+     libvsapm_partition_file_io_handle_t **partition_file_io_handle,
+     libvsapm_partition_t *partition,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_partition_file_io_handle_initialize";
+
+	if( partition_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *partition_file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid partition file IO handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( partition == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition.",
+		 function );
+
+		return( -1 );
+	}
+	*partition_file_io_handle = memory_allocate_structure(
+	                             libvsapm_partition_file_io_handle_t );
+
+	if( *partition_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create partition file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *partition_file_io_handle,
+	     0,
+	     sizeof( libvsapm_partition_file_io_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear partition file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	/* The clone holds its own references to the sector cache and the snapshot of a frozen volume
+	 */
+	if( libvsapm_partition_clone(
+	     &( ( *partition_file_io_handle )->partition ),
+	     partition,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create partition.",
+		 function );
+
+		goto on_error;
+	}
+	( *partition_file_io_handle )->partition_size = ( (libvsapm_internal_partition_t *) partition )->size;
+
+	return( 1 );
+
+on_error:
+	if( *partition_file_io_handle != NULL )
+	{
+		memory_free(
+		 *partition_file_io_handle );
+
+		*partition_file_io_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Creates a (basic file IO) handle that reads the partition data using the partition read function
+ * Make sure the value handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_partition_file_io_handle_initialize_handle(
+     libbfio_handle_t **handle,
+     libvsapm_partition_t *partition,
+     libcerror_error_t **error )
+{
+	libvsapm_partition_file_io_handle_t *partition_file_io_handle = NULL;
+	static char *function                                         = "libvsapm_partition_file_io_handle_initialize_handle";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvsapm_partition_file_io_handle_initialize(
+	     &partition_file_io_handle,
+	     partition,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create partition file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_initialize(
+	     handle,
+	     (intptr_t *) partition_file_io_handle,
+	     (int (*)(intptr_t **, libcerror_error_t **)) libvsapm_partition_file_io_handle_free,
+	     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) libvsapm_partition_file_io_handle_clone,
+	     (int (*)(intptr_t *, int, libcerror_error_t **)) libvsapm_partition_file_io_handle_open,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libvsapm_partition_file_io_handle_close,
+	     (ssize_t (*)(intptr_t *, uint8_t *, size_t, libcerror_error_t **)) libvsapm_partition_file_io_handle_read,
+	     (ssize_t (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) libvsapm_partition_file_io_handle_write,
+	     (off64_t (*)(intptr_t *, off64_t, int, libcerror_error_t **)) libvsapm_partition_file_io_handle_seek_offset,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libvsapm_partition_file_io_handle_exists,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libvsapm_partition_file_io_handle_is_open,
+	     (int (*)(intptr_t *, size64_t *, libcerror_error_t **)) libvsapm_partition_file_io_handle_get_size,
+	     LIBBFIO_FLAG_IO_HANDLE_MANAGED | LIBBFIO_FLAG_IO_HANDLE_CLONE_BY_FUNCTION,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( partition_file_io_handle != NULL )
+	{
+		libvsapm_partition_file_io_handle_free(
+		 &partition_file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a partition file IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_partition_file_io_handle_free(
+     libvsapm_partition_file_io_handle_t **partition_file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_partition_file_io_handle_free";
+	int result            = 1;
+
+	if( partition_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *partition_file_io_handle != NULL )
+	{
+		if( libvsapm_partition_free(
+		     &( ( *partition_file_io_handle )->partition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free partition.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *partition_file_io_handle );
+
+		*partition_file_io_handle = NULL;
+	}
+	return( result );
+}
+
+/* Clones (duplicates) the partition file IO handle
+ * The clone reads from its own clone of the partition
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_partition_file_io_handle_clone(
+     libvsapm_partition_file_io_handle_t **destination_partition_file_io_handle,
+     libvsapm_partition_file_io_handle_t *source_partition_file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_partition_file_io_handle_clone";
+
+	if( destination_partition_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination partition file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_partition_file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: destination partition file IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_partition_file_io_handle == NULL )
+	{
+		*destination_partition_file_io_handle = NULL;
+
+		return( 1 );
+	}
+	if( libvsapm_partition_file_io_handle_initialize(
+	     destination_partition_file_io_handle,
+	     source_partition_file_io_handle->partition,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create partition file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Opens the partition file IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_partition_file_io_handle_open(
+     libvsapm_partition_file_io_handle_t *partition_file_io_handle,
+     int access_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_partition_file_io_handle_open";
+
+	if( partition_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( access_flags & LIBBFIO_ACCESS_FLAG_WRITE ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: write access currently not supported.",
+		 function );
+
+		return( -1 );
+	}
+	/* No need to do anything here, because the partition is read using the IO of the volume
+	 */
+	partition_file_io_handle->access_flags   = access_flags;
+	partition_file_io_handle->current_offset = 0;
+
+	return( 1 );
+}
+
+/* Closes the partition file IO handle
+ * Returns 0 if successful or -1 on error
+ */
+int libvsapm_partition_file_io_handle_close(
+     libvsapm_partition_file_io_handle_t *partition_file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_partition_file_io_handle_close";
+
+	if( partition_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	/* Do not close the IO of the volume, it is managed by the volume
+	 */
+	partition_file_io_handle->access_flags = 0;
+
+	return( 0 );
+}
+
+/* Reads a buffer from the partition file IO handle
+ * The data is read using the partition read function and hence the same IO as the partition
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t libvsapm_partition_file_io_handle_read(
+         libvsapm_partition_file_io_handle_t *partition_file_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function   = "libvsapm_partition_file_io_handle_read";
+	size64_t remaining_size = 0;
+	ssize_t read_count      = 0;
+
+	if( partition_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) partition_file_io_handle->current_offset >= partition_file_io_handle->partition_size )
+	{
+		return( 0 );
+	}
+	remaining_size = partition_file_io_handle->partition_size - (size64_t) partition_file_io_handle->current_offset;
+
+	if( (size64_t) size > remaining_size )
+	{
+		size = (size_t) remaining_size;
+	}
+	if( size == 0 )
+	{
+		return( 0 );
+	}
+	read_count = libvsapm_internal_partition_read_buffer_at_offset_from_file_io_handle(
+	              (libvsapm_internal_partition_t *) partition_file_io_handle->partition,
+	              ( (libvsapm_internal_partition_t *) partition_file_io_handle->partition )->file_io_handle,
+	              buffer,
+	              size,
+	              partition_file_io_handle->current_offset,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer from partition at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 partition_file_io_handle->current_offset,
+		 partition_file_io_handle->current_offset );
+
+		return( -1 );
+	}
+	partition_file_io_handle->current_offset += (off64_t) read_count;
+
+	return( read_count );
+}
+
+/* Writes a buffer to the partition file IO handle
+ * Returns the number of bytes written if successful, or -1 on error
+ */
+ssize_t libvsapm_partition_file_io_handle_write(
+         libvsapm_partition_file_io_handle_t *partition_file_io_handle LIBVSAPM_ATTRIBUTE_UNUSED,
+         const uint8_t *buffer LIBVSAPM_ATTRIBUTE_UNUSED,
+         size_t size LIBVSAPM_ATTRIBUTE_UNUSED,
+         libcerror_error_t **error )
+{
+	static char *function = "libvsapm_partition_file_io_handle_write";
+
+	LIBVSAPM_UNREFERENCED_PARAMETER( partition_file_io_handle )
+	LIBVSAPM_UNREFERENCED_PARAMETER( buffer )
+	LIBVSAPM_UNREFERENCED_PARAMETER( size )
+
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: write access currently not supported.",
+	 function );
+
+	return( -1 );
+}
+
+/* Seeks a certain offset within the partition file IO handle
+ * Returns the offset if the seek is successful or -1 on error
+ */
+off64_t libvsapm_partition_file_io_handle_seek_offset(
+         libvsapm_partition_file_io_handle_t *partition_file_io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "libvsapm_partition_file_io_handle_seek_offset";
+
+	if( partition_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( whence == SEEK_CUR )
+	{
+		offset += partition_file_io_handle->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{
+		offset += (off64_t) partition_file_io_handle->partition_size;
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	partition_file_io_handle->current_offset = offset;
+
+	return( offset );
+}
+
+/* Function to determine if a file exists
+ * Returns 1 if file exists, 0 if not or -1 on error
+ */
+int libvsapm_partition_file_io_handle_exists(
+     libvsapm_partition_file_io_handle_t *partition_file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_partition_file_io_handle_exists";
+
+	if( partition_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( partition_file_io_handle->partition == NULL )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Check if the file is open
+ * Returns 1 if open, 0 if not or -1 on error
+ */
+int libvsapm_partition_file_io_handle_is_open(
+     libvsapm_partition_file_io_handle_t *partition_file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_partition_file_io_handle_is_open";
+
+	if( partition_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( partition_file_io_handle->access_flags == 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the partition size
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_partition_file_io_handle_get_size(
+     libvsapm_partition_file_io_handle_t *partition_file_io_handle,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_partition_file_io_handle_get_size";
+
+	if( partition_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	*size = partition_file_io_handle->partition_size;
+
+	return( 1 );
+}
+
@@ -0,0 +1,121 @@
+/*
+ * Partition file IO handle functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVSAPM_PARTITION_FILE_IO_HANDLE_H )
+#define _LIBVSAPM_PARTITION_FILE_IO_HANDLE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvsapm_libbfio.h"
+#include "libvsapm_libcerror.h"
+#include "libvsapm_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvsapm_partition_file_io_handle libvsapm_partition_file_io_handle_t;
+
+struct libvsapm_partition_file_io_handle
+{
+	/* The partition, a clone that is owned by the partition file IO handle
+	 */
+	libvsapm_partition_t *partition;
+
+	/* The size of the partition
+	 */
+	size64_t partition_size;
+
+	/* The current offset relative to the start of the partition
+	 */
+	off64_t current_offset;
+
+	/* The access flags
+	 */
+	int access_flags;
+};
+
+int libvsapm_partition_file_io_handle_initialize(
+     libvsapm_partition_file_io_handle_t **partition_file_io_handle,
+     libvsapm_partition_t *partition,
+     libcerror_error_t **error );
+
+int libvsapm_partition_file_io_handle_initialize_handle(
+     libbfio_handle_t **handle,
+     libvsapm_partition_t *partition,
+     libcerror_error_t **error );
+
+int libvsapm_partition_file_io_handle_free(
+     libvsapm_partition_file_io_handle_t **partition_file_io_handle,
+     libcerror_error_t **error );
+
+int libvsapm_partition_file_io_handle_clone(
+     libvsapm_partition_file_io_handle_t **destination_partition_file_io_handle,
+     libvsapm_partition_file_io_handle_t *source_partition_file_io_handle,
+     libcerror_error_t **error );
+
+int libvsapm_partition_file_io_handle_open(
+     libvsapm_partition_file_io_handle_t *partition_file_io_handle,
+     int access_flags,
+     libcerror_error_t **error );
+
+int libvsapm_partition_file_io_handle_close(
+     libvsapm_partition_file_io_handle_t *partition_file_io_handle,
+     libcerror_error_t **error );
+
+ssize_t libvsapm_partition_file_io_handle_read(
+         libvsapm_partition_file_io_handle_t *partition_file_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+ssize_t libvsapm_partition_file_io_handle_write(
+         libvsapm_partition_file_io_handle_t *partition_file_io_handle,
+         const uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+off64_t libvsapm_partition_file_io_handle_seek_offset(
+         libvsapm_partition_file_io_handle_t *partition_file_io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error );
+
+int libvsapm_partition_file_io_handle_exists(
+     libvsapm_partition_file_io_handle_t *partition_file_io_handle,
+     libcerror_error_t **error );
+
+int libvsapm_partition_file_io_handle_is_open(
+     libvsapm_partition_file_io_handle_t *partition_file_io_handle,
+     libcerror_error_t **error );
+
+int libvsapm_partition_file_io_handle_get_size(
+     libvsapm_partition_file_io_handle_t *partition_file_io_handle,
+     size64_t *size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSAPM_PARTITION_FILE_IO_HANDLE_H ) */
+
@@ -0,0 +1,357 @@
+/*
+ * Partition index functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvsapm_libcdata.h"
+#include "libvsapm_libcerror.h"
+#include "libvsapm_partition_index.h"
+#include "libvsapm_partition_map_entry.h"
+
+/* Creates a partition index
+ * Make sure the value partition_index is referencing, is set to NULL
+ * The partitions are sorted by start sector number, partitions without sectors are not indexed
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_partition_index_initialize(
+     libvsapm_partition_index_t **partition_index,
+     libcdata_array_t *partitions,
+     libcerror_error_t **error )
+{
+	libvsapm_partition_index_entry_t index_entry;
+
+	libvsapm_partition_map_entry_t *partition_map_entry = NULL;
+	static char *function                               = "libvsapm_partition_index_initialize";
+	uint64_t maximum_end_sector_number                  = 0;
+	int entry_index                                     = 0;
+	int number_of_partitions                            = 0;
+	int partition_array_index                           = 0;
+
+	if( partition_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *partition_index != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid partition index value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     partitions,
+	     &number_of_partitions,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of partitions.",
+		 function );
+
+		return( -1 );
+	}
+	*partition_index = memory_allocate_structure(
+	                    libvsapm_partition_index_t );
+
+	if( *partition_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create partition index.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *partition_index,
+	     0,
+	     sizeof( libvsapm_partition_index_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear partition index.",
+		 function );
+
+		memory_free(
+		 *partition_index );
+
+		*partition_index = NULL;
+
+		return( -1 );
+	}
+	if( number_of_partitions == 0 )
+	{
+		return( 1 );
+	}
+	( *partition_index )->entries = (libvsapm_partition_index_entry_t *) memory_allocate(
+	                                                                      sizeof( libvsapm_partition_index_entry_t ) * number_of_partitions );
+
+	if( ( *partition_index )->entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entries.",
+		 function );
+
+		goto on_error;
+	}
+	( *partition_index )->maximum_end_sector_numbers = (uint64_t *) memory_allocate(
+	                                                                 sizeof( uint64_t ) * number_of_partitions );
+
+	if( ( *partition_index )->maximum_end_sector_numbers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create maximum end sector numbers.",
+		 function );
+
+		goto on_error;
+	}
+	for( partition_array_index = 0;
+	     partition_array_index < number_of_partitions;
+	     partition_array_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     partitions,
+		     partition_array_index,
+		     (intptr_t **) &partition_map_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve partition map entry: %d from array.",
+			 function,
+			 partition_array_index );
+
+			goto on_error;
+		}
+		if( partition_map_entry == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing partition map entry: %d.",
+			 function,
+			 partition_array_index );
+
+			goto on_error;
+		}
+		if( partition_map_entry->number_of_sectors == 0 )
+		{
+			continue;
+		}
+		index_entry.start_sector_number = partition_map_entry->sector_number;
+		index_entry.end_sector_number   = (uint64_t) partition_map_entry->sector_number + partition_map_entry->number_of_sectors;
+		index_entry.partition_index     = partition_array_index;
+
+		/* The partition map entries are typically stored in order of start sector number,
+		 * hence an insertion sort is used since it takes linear time on sorted input
+		 */
+		entry_index = ( *partition_index )->number_of_entries;
+
+		while( entry_index > 0 )
+		{
+			if( ( *partition_index )->entries[ entry_index - 1 ].start_sector_number < index_entry.start_sector_number )
+			{
+				break;
+			}
+			if( ( ( *partition_index )->entries[ entry_index - 1 ].start_sector_number == index_entry.start_sector_number )
+			 && ( ( *partition_index )->entries[ entry_index - 1 ].end_sector_number <= index_entry.end_sector_number ) )
+			{
+				break;
+			}
+			( *partition_index )->entries[ entry_index ] = ( *partition_index )->entries[ entry_index - 1 ];
+
+			entry_index--;
+		}
+		( *partition_index )->entries[ entry_index ] = index_entry;
+
+		( *partition_index )->number_of_entries += 1;
+	}
+	for( entry_index = 0;
+	     entry_index < ( *partition_index )->number_of_entries;
+	     entry_index++ )
+	{
+		if( ( *partition_index )->entries[ entry_index ].start_sector_number < maximum_end_sector_number )
+		{
+			( *partition_index )->has_overlapping_partitions = 1;
+		}
+		if( ( *partition_index )->entries[ entry_index ].end_sector_number > maximum_end_sector_number )
+		{
+			maximum_end_sector_number = ( *partition_index )->entries[ entry_index ].end_sector_number;
+		}
+		( *partition_index )->maximum_end_sector_numbers[ entry_index ] = maximum_end_sector_number;
+	}
+	return( 1 );
+
+on_error:
+	if( *partition_index != NULL )
+	{
+		libvsapm_partition_index_free(
+		 partition_index,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a partition index
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_partition_index_free(
+     libvsapm_partition_index_t **partition_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_partition_index_free";
+
+	if( partition_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *partition_index != NULL )
+	{
+		if( ( *partition_index )->maximum_end_sector_numbers != NULL )
+		{
+			memory_free(
+			 ( *partition_index )->maximum_end_sector_numbers );
+		}
+		if( ( *partition_index )->entries != NULL )
+		{
+			memory_free(
+			 ( *partition_index )->entries );
+		}
+		memory_free(
+		 *partition_index );
+
+		*partition_index = NULL;
+	}
+	return( 1 );
+}
+
+/* Retrieves the index of the partition that contains a specific sector number
+ * If partitions overlap the partition with the largest start sector number that contains the sector is returned
+ * Returns 1 if successful, 0 if no partition contains the sector or -1 on error
+ */
+int libvsapm_partition_index_get_partition_index_by_sector_number(
+     libvsapm_partition_index_t *partition_index,
+     uint64_t sector_number,
+     int *partition_array_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_partition_index_get_partition_index_by_sector_number";
+	int entry_index       = 0;
+	int maximum_index     = 0;
+	int minimum_index     = 0;
+	int middle_index      = 0;
+
+	if( partition_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition index.",
+		 function );
+
+		return( -1 );
+	}
+	if( partition_array_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition array index.",
+		 function );
+
+		return( -1 );
+	}
+	/* Find the last entry with a start sector number that is less than or equal to the sector number
+	 */
+	minimum_index = 0;
+	maximum_index = partition_index->number_of_entries;
+
+	while( minimum_index < maximum_index )
+	{
+		middle_index = minimum_index + ( ( maximum_index - minimum_index ) / 2 );
+
+		if( partition_index->entries[ middle_index ].start_sector_number <= sector_number )
+		{
+			minimum_index = middle_index + 1;
+		}
+		else
+		{
+			maximum_index = middle_index;
+		}
+	}
+	/* Entries before the one found can only contain the sector number if the maximum end sector number
+	 * of the entries up to them is larger, which is only the case for overlapping partitions
+	 */
+	for( entry_index = minimum_index - 1;
+	     entry_index >= 0;
+	     entry_index-- )
+	{
+		if( partition_index->maximum_end_sector_numbers[ entry_index ] <= sector_number )
+		{
+			break;
+		}
+		if( partition_index->entries[ entry_index ].end_sector_number > sector_number )
+		{
+			*partition_array_index = partition_index->entries[ entry_index ].partition_index;
+
+			return( 1 );
+		}
+	}
+	return( 0 );
+}
+
@@ -0,0 +1,93 @@
+/*
+ * Partition index functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVSAPM_PARTITION_INDEX_H )
+#define _LIBVSAPM_PARTITION_INDEX_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvsapm_libcdata.h"
+#include "libvsapm_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvsapm_partition_index_entry libvsapm_partition_index_entry_t;
+
+struct libvsapm_partition_index_entry
+{
+	/* The start sector number
+	 */
+	uint64_t start_sector_number;
+
+	/* The end sector number, which is the first sector after the partition
+	 */
+	uint64_t end_sector_number;
+
+	/* The index of the partition in the partitions array
+	 */
+	int partition_index;
+};
+
+typedef struct libvsapm_partition_index libvsapm_partition_index_t;
+
+struct libvsapm_partition_index
+{
+	/* The entries sorted by start sector number
+	 */
+	libvsapm_partition_index_entry_t *entries;
+
+	/* The maximum end sector number of the entries up to and including a specific entry
+	 */
+	uint64_t *maximum_end_sector_numbers;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* Value to indicate the partitions overlap
+	 */
+	uint8_t has_overlapping_partitions;
+};
+
+int libvsapm_partition_index_initialize(
+     libvsapm_partition_index_t **partition_index,
+     libcdata_array_t *partitions,
+     libcerror_error_t **error );
+
+int libvsapm_partition_index_free(
+     libvsapm_partition_index_t **partition_index,
+     libcerror_error_t **error );
+
+int libvsapm_partition_index_get_partition_index_by_sector_number(
+     libvsapm_partition_index_t *partition_index,
+     uint64_t sector_number,
+     int *partition_array_index,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSAPM_PARTITION_INDEX_H ) */
+
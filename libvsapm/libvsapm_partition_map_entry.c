@@ -27,6 +27,7 @@
 
 #include "libvsapm_debug.h"
 #include "libvsapm_definitions.h"
+#include "libvsapm_libcdata.h"
 #include "libvsapm_libcerror.h"
 #include "libvsapm_libcnotify.h"
 #include "libvsapm_partition_map_entry.h"
@@ -136,6 +137,85 @@ int libvsapm_partition_map_entry_free(
 	return( 1 );
 }
 
+/* Clones a partition map entry
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_partition_map_entry_clone(
+     libvsapm_partition_map_entry_t **destination_partition_map_entry,
+     libvsapm_partition_map_entry_t *source_partition_map_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_partition_map_entry_clone";
+
+	if( destination_partition_map_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination partition map entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_partition_map_entry != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: destination partition map entry already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_partition_map_entry == NULL )
+	{
+		*destination_partition_map_entry = NULL;
+
+		return( 1 );
+	}
+	*destination_partition_map_entry = memory_allocate_structure(
+	                                    libvsapm_partition_map_entry_t );
+
+	if( *destination_partition_map_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create destination partition map entry.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     *destination_partition_map_entry,
+	     source_partition_map_entry,
+	     sizeof( libvsapm_partition_map_entry_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy partition map entry.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *destination_partition_map_entry != NULL )
+	{
+		memory_free(
+		 *destination_partition_map_entry );
+
+		*destination_partition_map_entry = NULL;
+	}
+	return( -1 );
+}
+
 /* Reads a partition map entry
  * Returns 1 if successful or -1 on error
  */
@@ -485,6 +565,57 @@ int libvsapm_partition_map_entry_read_file_io_handle(
 	return( 1 );
 }
 
+/* Compares two partition map entries by sector number and number of sectors
+ * Returns LIBCDATA_COMPARE_LESS, LIBCDATA_COMPARE_EQUAL, LIBCDATA_COMPARE_GREATER if successful or -1 on error
+ */
+int libvsapm_partition_map_entry_compare_by_sector_number(
+     libvsapm_partition_map_entry_t *first_partition_map_entry,
+     libvsapm_partition_map_entry_t *second_partition_map_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_partition_map_entry_compare_by_sector_number";
+
+	if( first_partition_map_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid first partition map entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( second_partition_map_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid second partition map entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( first_partition_map_entry->sector_number < second_partition_map_entry->sector_number )
+	{
+		return( LIBCDATA_COMPARE_LESS );
+	}
+	else if( first_partition_map_entry->sector_number > second_partition_map_entry->sector_number )
+	{
+		return( LIBCDATA_COMPARE_GREATER );
+	}
+	if( first_partition_map_entry->number_of_sectors < second_partition_map_entry->number_of_sectors )
+	{
+		return( LIBCDATA_COMPARE_LESS );
+	}
+	else if( first_partition_map_entry->number_of_sectors > second_partition_map_entry->number_of_sectors )
+	{
+		return( LIBCDATA_COMPARE_GREATER );
+	}
+	return( LIBCDATA_COMPARE_EQUAL );
+}
+
 /* Retrieves the partition sector number
  * Returns 1 if successful or -1 on error
  */
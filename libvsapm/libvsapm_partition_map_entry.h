@@ -77,6 +77,11 @@ int libvsapm_partition_map_entry_free(
      libvsapm_partition_map_entry_t **partition_map_entry,
      libcerror_error_t **error );
 
+int libvsapm_partition_map_entry_clone(
+     libvsapm_partition_map_entry_t **destination_partition_map_entry,
+     libvsapm_partition_map_entry_t *source_partition_map_entry,
+     libcerror_error_t **error );
+
 int libvsapm_partition_map_entry_read_data(
      libvsapm_partition_map_entry_t *partition_map_entry,
      const uint8_t *data,
@@ -89,6 +94,11 @@ int libvsapm_partition_map_entry_read_file_io_handle(
      off64_t file_offset,
      libcerror_error_t **error );
 
+int libvsapm_partition_map_entry_compare_by_sector_number(
+     libvsapm_partition_map_entry_t *first_partition_map_entry,
+     libvsapm_partition_map_entry_t *second_partition_map_entry,
+     libcerror_error_t **error );
+
 int libvsapm_partition_map_entry_get_sector_number(
      libvsapm_partition_map_entry_t *partition_map_entry,
      uint32_t *sector_number,
@@ -0,0 +1,699 @@
+/*
+ * The partition map entry batch functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( __AVX2__ )
+#include <immintrin.h>
+
+#define LIBVSAPM_PARTITION_MAP_ENTRY_BATCH_NUMBER_OF_LANES	8
+
+#elif defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && ( _M_IX86_FP >= 2 ) )
+#include <emmintrin.h>
+
+#define LIBVSAPM_PARTITION_MAP_ENTRY_BATCH_NUMBER_OF_LANES	4
+
+#endif
+
+#include "libvsapm_definitions.h"
+#include "libvsapm_libcerror.h"
+#include "libvsapm_partition_map_entry.h"
+#include "libvsapm_partition_map_entry_batch.h"
+
+#include "vsapm_partition_map_entry.h"
+
+/* The partition map entry signature "PM" as a 16-bit little-endian value
+ */
+#define LIBVSAPM_PARTITION_MAP_ENTRY_BATCH_SIGNATURE	0x4d50
+
+/* Creates a partition map entry batch
+ * Make sure the value partition_map_entry_batch is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_partition_map_entry_batch_initialize(
+     libvsapm_partition_map_entry_batch_t **partition_map_entry_batch,
+     int maximum_number_of_entries,
+     libcerror_error_t **error )
+{
+	static char *function   = "libvsapm_partition_map_entry_batch_initialize";
+	size_t values_data_size = 0;
+
+	if( partition_map_entry_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition map entry batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( *partition_map_entry_batch != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid partition map entry batch value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_entries <= 0 )
+	 || ( maximum_number_of_entries > LIBVSAPM_MAXIMUM_NUMBER_OF_BATCH_PARTITION_MAP_ENTRIES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*partition_map_entry_batch = memory_allocate_structure(
+	                              libvsapm_partition_map_entry_batch_t );
+
+	if( *partition_map_entry_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create partition map entry batch.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *partition_map_entry_batch,
+	     0,
+	     sizeof( libvsapm_partition_map_entry_batch_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear partition map entry batch.",
+		 function );
+
+		memory_free(
+		 *partition_map_entry_batch );
+
+		*partition_map_entry_batch = NULL;
+
+		return( -1 );
+	}
+	/* The arrays are stored in a single allocation, the 32-bit values first to keep them aligned
+	 */
+	values_data_size = (size_t) maximum_number_of_entries * ( ( 4 * sizeof( uint32_t ) ) + 32 + 32 + 1 );
+
+	( *partition_map_entry_batch )->values_data = (uint8_t *) memory_allocate(
+	                                                           sizeof( uint8_t ) * values_data_size );
+
+	if( ( *partition_map_entry_batch )->values_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create values data.",
+		 function );
+
+		goto on_error;
+	}
+	( *partition_map_entry_batch )->map_number_of_entries = (uint32_t *) ( *partition_map_entry_batch )->values_data;
+	( *partition_map_entry_batch )->sector_numbers        = &( ( ( *partition_map_entry_batch )->map_number_of_entries )[ maximum_number_of_entries ] );
+	( *partition_map_entry_batch )->numbers_of_sectors    = &( ( ( *partition_map_entry_batch )->sector_numbers )[ maximum_number_of_entries ] );
+	( *partition_map_entry_batch )->status_flags          = &( ( ( *partition_map_entry_batch )->numbers_of_sectors )[ maximum_number_of_entries ] );
+	( *partition_map_entry_batch )->names                 = (uint8_t *) &( ( ( *partition_map_entry_batch )->status_flags )[ maximum_number_of_entries ] );
+	( *partition_map_entry_batch )->types                 = &( ( ( *partition_map_entry_batch )->names )[ maximum_number_of_entries * 32 ] );
+	( *partition_map_entry_batch )->signature_valid       = &( ( ( *partition_map_entry_batch )->types )[ maximum_number_of_entries * 32 ] );
+
+	( *partition_map_entry_batch )->maximum_number_of_entries = maximum_number_of_entries;
+
+	return( 1 );
+
+on_error:
+	if( *partition_map_entry_batch != NULL )
+	{
+		memory_free(
+		 *partition_map_entry_batch );
+
+		*partition_map_entry_batch = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a partition map entry batch
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_partition_map_entry_batch_free(
+     libvsapm_partition_map_entry_batch_t **partition_map_entry_batch,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_partition_map_entry_batch_free";
+
+	if( partition_map_entry_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition map entry batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( *partition_map_entry_batch != NULL )
+	{
+		if( ( *partition_map_entry_batch )->values_data != NULL )
+		{
+			memory_free(
+			 ( *partition_map_entry_batch )->values_data );
+		}
+		memory_free(
+		 *partition_map_entry_batch );
+
+		*partition_map_entry_batch = NULL;
+	}
+	return( 1 );
+}
+
+#if !defined( __AVX2__ ) && defined( LIBVSAPM_PARTITION_MAP_ENTRY_BATCH_NUMBER_OF_LANES )
+
+/* Byte swaps the 32-bit values in a vector
+ */
+static __m128i libvsapm_partition_map_entry_batch_byte_swap_32bit(
+                __m128i values )
+{
+	values = _mm_or_si128(
+	          _mm_slli_epi16(
+	           values,
+	           8 ),
+	          _mm_srli_epi16(
+	           values,
+	           8 ) );
+
+	values = _mm_shufflelo_epi16(
+	          values,
+	          _MM_SHUFFLE( 2, 3, 0, 1 ) );
+
+	return( _mm_shufflehi_epi16(
+	         values,
+	         _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+}
+
+#endif /* !defined( __AVX2__ ) && defined( LIBVSAPM_PARTITION_MAP_ENTRY_BATCH_NUMBER_OF_LANES ) */
+
+/* Decodes the numeric values of contiguous 512-byte partition map entries
+ * The big-endian values are byte swapped a vector of entries at a time where
+ * supported by the compiler, the remaining entries are decoded one at a time
+ */
+void libvsapm_partition_map_entry_batch_decode_values(
+      libvsapm_partition_map_entry_batch_t *partition_map_entry_batch,
+      const uint8_t *data,
+      int number_of_entries )
+{
+	const vsapm_partition_map_entry_t *entry_data = NULL;
+	int entry_index                               = 0;
+	int number_of_valid_entries                   = 0;
+
+#if defined( LIBVSAPM_PARTITION_MAP_ENTRY_BATCH_NUMBER_OF_LANES )
+	int lane_index                                = 0;
+	int signature_mask                            = 0;
+#endif
+
+#if defined( __AVX2__ )
+	__m256i byte_swap_mask                        = _mm256_setr_epi8(
+	                                                 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+	                                                 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 );
+	__m256i entry_offsets                         = _mm256_setr_epi32(
+	                                                 0, 512, 1024, 1536, 2048, 2560, 3072, 3584 );
+	__m256i signature_values                      = _mm256_set1_epi32(
+	                                                 LIBVSAPM_PARTITION_MAP_ENTRY_BATCH_SIGNATURE );
+	__m256i signature_value_mask                  = _mm256_set1_epi32(
+	                                                 0x0000ffffUL );
+	__m256i values                                = _mm256_setzero_si256();
+
+#elif defined( LIBVSAPM_PARTITION_MAP_ENTRY_BATCH_NUMBER_OF_LANES )
+	__m128i columns[ 4 ];
+	__m128i rows[ 4 ];
+
+	__m128i signature_values                      = _mm_set1_epi32(
+	                                                 LIBVSAPM_PARTITION_MAP_ENTRY_BATCH_SIGNATURE );
+	__m128i signature_value_mask                  = _mm_set1_epi32(
+	                                                 0x0000ffffUL );
+	__m128i low_values                            = _mm_setzero_si128();
+	__m128i high_values                           = _mm_setzero_si128();
+#endif
+
+#if defined( __AVX2__ )
+	while( ( entry_index + LIBVSAPM_PARTITION_MAP_ENTRY_BATCH_NUMBER_OF_LANES ) <= number_of_entries )
+	{
+		entry_data = (const vsapm_partition_map_entry_t *) &( data[ entry_index * 512 ] );
+
+		/* Gather the first 4 bytes of 8 entries, which contain the signature
+		 */
+		values = _mm256_i32gather_epi32(
+		          (const int *) entry_data->signature,
+		          entry_offsets,
+		          1 );
+
+		signature_mask = _mm256_movemask_ps(
+		                  _mm256_castsi256_ps(
+		                   _mm256_cmpeq_epi32(
+		                    _mm256_and_si256(
+		                     values,
+		                     signature_value_mask ),
+		                    signature_values ) ) );
+
+		values = _mm256_shuffle_epi8(
+		          _mm256_i32gather_epi32(
+		           (const int *) entry_data->number_of_entries,
+		           entry_offsets,
+		           1 ),
+		          byte_swap_mask );
+
+		_mm256_storeu_si256(
+		 (__m256i *) &( partition_map_entry_batch->map_number_of_entries[ entry_index ] ),
+		 values );
+
+		values = _mm256_shuffle_epi8(
+		          _mm256_i32gather_epi32(
+		           (const int *) entry_data->start_sector,
+		           entry_offsets,
+		           1 ),
+		          byte_swap_mask );
+
+		_mm256_storeu_si256(
+		 (__m256i *) &( partition_map_entry_batch->sector_numbers[ entry_index ] ),
+		 values );
+
+		values = _mm256_shuffle_epi8(
+		          _mm256_i32gather_epi32(
+		           (const int *) entry_data->number_of_sectors,
+		           entry_offsets,
+		           1 ),
+		          byte_swap_mask );
+
+		_mm256_storeu_si256(
+		 (__m256i *) &( partition_map_entry_batch->numbers_of_sectors[ entry_index ] ),
+		 values );
+
+		values = _mm256_shuffle_epi8(
+		          _mm256_i32gather_epi32(
+		           (const int *) entry_data->status_flags,
+		           entry_offsets,
+		           1 ),
+		          byte_swap_mask );
+
+		_mm256_storeu_si256(
+		 (__m256i *) &( partition_map_entry_batch->status_flags[ entry_index ] ),
+		 values );
+
+		for( lane_index = 0;
+		     lane_index < LIBVSAPM_PARTITION_MAP_ENTRY_BATCH_NUMBER_OF_LANES;
+		     lane_index++ )
+		{
+			partition_map_entry_batch->signature_valid[ entry_index + lane_index ] = (uint8_t) ( ( signature_mask >> lane_index ) & 0x01 );
+
+			number_of_valid_entries += ( signature_mask >> lane_index ) & 0x01;
+		}
+		entry_index += LIBVSAPM_PARTITION_MAP_ENTRY_BATCH_NUMBER_OF_LANES;
+	}
+#elif defined( LIBVSAPM_PARTITION_MAP_ENTRY_BATCH_NUMBER_OF_LANES )
+	while( ( entry_index + LIBVSAPM_PARTITION_MAP_ENTRY_BATCH_NUMBER_OF_LANES ) <= number_of_entries )
+	{
+		/* Load the first 16 bytes of 4 entries, which contain the signature,
+		 * the number of entries, the start sector and the number of sectors
+		 */
+		for( lane_index = 0;
+		     lane_index < LIBVSAPM_PARTITION_MAP_ENTRY_BATCH_NUMBER_OF_LANES;
+		     lane_index++ )
+		{
+			rows[ lane_index ] = _mm_loadu_si128(
+			                      (const __m128i *) &( data[ ( entry_index + lane_index ) * 512 ] ) );
+		}
+		/* Transpose the rows of 4 entries into columns of 4 values
+		 */
+		low_values  = _mm_unpacklo_epi32(
+		               rows[ 0 ],
+		               rows[ 1 ] );
+		high_values = _mm_unpacklo_epi32(
+		               rows[ 2 ],
+		               rows[ 3 ] );
+
+		columns[ 0 ] = _mm_unpacklo_epi64(
+		                low_values,
+		                high_values );
+		columns[ 1 ] = _mm_unpackhi_epi64(
+		                low_values,
+		                high_values );
+
+		low_values  = _mm_unpackhi_epi32(
+		               rows[ 0 ],
+		               rows[ 1 ] );
+		high_values = _mm_unpackhi_epi32(
+		               rows[ 2 ],
+		               rows[ 3 ] );
+
+		columns[ 2 ] = _mm_unpacklo_epi64(
+		                low_values,
+		                high_values );
+		columns[ 3 ] = _mm_unpackhi_epi64(
+		                low_values,
+		                high_values );
+
+		signature_mask = _mm_movemask_ps(
+		                  _mm_castsi128_ps(
+		                   _mm_cmpeq_epi32(
+		                    _mm_and_si128(
+		                     columns[ 0 ],
+		                     signature_value_mask ),
+		                    signature_values ) ) );
+
+		_mm_storeu_si128(
+		 (__m128i *) &( partition_map_entry_batch->map_number_of_entries[ entry_index ] ),
+		 libvsapm_partition_map_entry_batch_byte_swap_32bit(
+		  columns[ 1 ] ) );
+
+		_mm_storeu_si128(
+		 (__m128i *) &( partition_map_entry_batch->sector_numbers[ entry_index ] ),
+		 libvsapm_partition_map_entry_batch_byte_swap_32bit(
+		  columns[ 2 ] ) );
+
+		_mm_storeu_si128(
+		 (__m128i *) &( partition_map_entry_batch->numbers_of_sectors[ entry_index ] ),
+		 libvsapm_partition_map_entry_batch_byte_swap_32bit(
+		  columns[ 3 ] ) );
+
+		for( lane_index = 0;
+		     lane_index < LIBVSAPM_PARTITION_MAP_ENTRY_BATCH_NUMBER_OF_LANES;
+		     lane_index++ )
+		{
+			entry_data = (const vsapm_partition_map_entry_t *) &( data[ ( entry_index + lane_index ) * 512 ] );
+
+			byte_stream_copy_to_uint32_big_endian(
+			 entry_data->status_flags,
+			 partition_map_entry_batch->status_flags[ entry_index + lane_index ] );
+
+			partition_map_entry_batch->signature_valid[ entry_index + lane_index ] = (uint8_t) ( ( signature_mask >> lane_index ) & 0x01 );
+
+			number_of_valid_entries += ( signature_mask >> lane_index ) & 0x01;
+		}
+		entry_index += LIBVSAPM_PARTITION_MAP_ENTRY_BATCH_NUMBER_OF_LANES;
+	}
+#endif /* defined( __AVX2__ ) */
+
+	while( entry_index < number_of_entries )
+	{
+		entry_data = (const vsapm_partition_map_entry_t *) &( data[ entry_index * 512 ] );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 entry_data->number_of_entries,
+		 partition_map_entry_batch->map_number_of_entries[ entry_index ] );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 entry_data->start_sector,
+		 partition_map_entry_batch->sector_numbers[ entry_index ] );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 entry_data->number_of_sectors,
+		 partition_map_entry_batch->numbers_of_sectors[ entry_index ] );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 entry_data->status_flags,
+		 partition_map_entry_batch->status_flags[ entry_index ] );
+
+		if( ( entry_data->signature[ 0 ] == (uint8_t) 'P' )
+		 && ( entry_data->signature[ 1 ] == (uint8_t) 'M' ) )
+		{
+			partition_map_entry_batch->signature_valid[ entry_index ] = 1;
+
+			number_of_valid_entries++;
+		}
+		else
+		{
+			partition_map_entry_batch->signature_valid[ entry_index ] = 0;
+		}
+		entry_index++;
+	}
+	partition_map_entry_batch->number_of_entries       = number_of_entries;
+	partition_map_entry_batch->number_of_valid_entries = number_of_valid_entries;
+}
+
+/* Reads contiguous 512-byte partition map entries into the batch
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_partition_map_entry_batch_read_data(
+     libvsapm_partition_map_entry_batch_t *partition_map_entry_batch,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	const vsapm_partition_map_entry_t *entry_data = NULL;
+	static char *function                         = "libvsapm_partition_map_entry_batch_read_data";
+	size_t number_of_entries                      = 0;
+	int entry_index                               = 0;
+
+	if( partition_map_entry_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition map entry batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( partition_map_entry_batch->values_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid partition map entry batch - missing values data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size == 0 )
+	 || ( ( data_size % sizeof( vsapm_partition_map_entry_t ) ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_entries = data_size / sizeof( vsapm_partition_map_entry_t );
+
+	if( number_of_entries > (size_t) partition_map_entry_batch->maximum_number_of_entries )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value exceeds maximum number of entries.",
+		 function );
+
+		return( -1 );
+	}
+	libvsapm_partition_map_entry_batch_decode_values(
+	 partition_map_entry_batch,
+	 data,
+	 (int) number_of_entries );
+
+	for( entry_index = 0;
+	     entry_index < (int) number_of_entries;
+	     entry_index++ )
+	{
+		entry_data = (const vsapm_partition_map_entry_t *) &( data[ entry_index * 512 ] );
+
+		if( memory_copy(
+		     &( partition_map_entry_batch->names[ entry_index * 32 ] ),
+		     entry_data->name,
+		     32 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy name of entry: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( memory_copy(
+		     &( partition_map_entry_batch->types[ entry_index * 32 ] ),
+		     entry_data->type,
+		     32 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy type of entry: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves a specific entry of the batch as a partition map entry
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_partition_map_entry_batch_get_entry(
+     libvsapm_partition_map_entry_batch_t *partition_map_entry_batch,
+     int entry_index,
+     libvsapm_partition_map_entry_t *partition_map_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_partition_map_entry_batch_get_entry";
+
+	if( partition_map_entry_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition map entry batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( entry_index < 0 )
+	 || ( entry_index >= partition_map_entry_batch->number_of_entries ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( partition_map_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition map entry.",
+		 function );
+
+		return( -1 );
+	}
+	partition_map_entry->number_of_entries = partition_map_entry_batch->map_number_of_entries[ entry_index ];
+	partition_map_entry->sector_number     = partition_map_entry_batch->sector_numbers[ entry_index ];
+	partition_map_entry->number_of_sectors = partition_map_entry_batch->numbers_of_sectors[ entry_index ];
+	partition_map_entry->status_flags      = partition_map_entry_batch->status_flags[ entry_index ];
+
+	if( memory_copy(
+	     partition_map_entry->name,
+	     &( partition_map_entry_batch->names[ entry_index * 32 ] ),
+	     32 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy name.",
+		 function );
+
+		return( -1 );
+	}
+	partition_map_entry->name[ 32 ] = 0;
+
+	if( memory_copy(
+	     partition_map_entry->type,
+	     &( partition_map_entry_batch->types[ entry_index * 32 ] ),
+	     32 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy type.",
+		 function );
+
+		return( -1 );
+	}
+	partition_map_entry->type[ 32 ] = 0;
+
+	partition_map_entry->name_length = narrow_string_length(
+	                                    (char *) partition_map_entry->name );
+
+	if( partition_map_entry->name_length >= 32 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid name length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	partition_map_entry->type_length = narrow_string_length(
+	                                    (char *) partition_map_entry->type );
+
+	if( ( partition_map_entry->type_length == 0 )
+	 || ( partition_map_entry->type_length >= 32 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid type length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
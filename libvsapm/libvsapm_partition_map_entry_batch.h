@@ -0,0 +1,118 @@
+/*
+ * The partition map entry batch functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVSAPM_PARTITION_MAP_ENTRY_BATCH_H )
+#define _LIBVSAPM_PARTITION_MAP_ENTRY_BATCH_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvsapm_libcerror.h"
+#include "libvsapm_partition_map_entry.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvsapm_partition_map_entry_batch libvsapm_partition_map_entry_batch_t;
+
+/* The partition map entry batch stores the values of the entries
+ * as a structure of arrays, where each array contains one value per entry
+ */
+struct libvsapm_partition_map_entry_batch
+{
+	/* The maximum number of entries
+	 */
+	int maximum_number_of_entries;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The number of entries with a valid signature
+	 */
+	int number_of_valid_entries;
+
+	/* The values data
+	 */
+	uint8_t *values_data;
+
+	/* The numbers of entries in the partition map
+	 */
+	uint32_t *map_number_of_entries;
+
+	/* The sector numbers
+	 */
+	uint32_t *sector_numbers;
+
+	/* The numbers of sectors
+	 */
+	uint32_t *numbers_of_sectors;
+
+	/* The status flags
+	 */
+	uint32_t *status_flags;
+
+	/* The names, 32 bytes per entry
+	 */
+	uint8_t *names;
+
+	/* The types, 32 bytes per entry
+	 */
+	uint8_t *types;
+
+	/* The signature valid values, 1 per entry if the signature is valid or 0 if not
+	 */
+	uint8_t *signature_valid;
+};
+
+int libvsapm_partition_map_entry_batch_initialize(
+     libvsapm_partition_map_entry_batch_t **partition_map_entry_batch,
+     int maximum_number_of_entries,
+     libcerror_error_t **error );
+
+int libvsapm_partition_map_entry_batch_free(
+     libvsapm_partition_map_entry_batch_t **partition_map_entry_batch,
+     libcerror_error_t **error );
+
+void libvsapm_partition_map_entry_batch_decode_values(
+      libvsapm_partition_map_entry_batch_t *partition_map_entry_batch,
+      const uint8_t *data,
+      int number_of_entries );
+
+int libvsapm_partition_map_entry_batch_read_data(
+     libvsapm_partition_map_entry_batch_t *partition_map_entry_batch,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libvsapm_partition_map_entry_batch_get_entry(
+     libvsapm_partition_map_entry_batch_t *partition_map_entry_batch,
+     int entry_index,
+     libvsapm_partition_map_entry_t *partition_map_entry,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSAPM_PARTITION_MAP_ENTRY_BATCH_H ) */
+
@@ -0,0 +1,842 @@
+/*
+ * Pool file IO handle functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvsapm_libbfio.h"
+#include "libvsapm_libcerror.h"
+#include "libvsapm_pool_file_io_handle.h"
+#include "libvsapm_unused.h"
+
+/* Creates a pool file IO handle
+ * Make sure the value pool_file_io_handle is referencing, is set to NULL
+ * The file IO pool is not managed by the pool file IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_pool_file_io_handle_initialize(
+     libvsapm_pool_file_io_handle_t **pool_file_io_handle,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error )
+{
+	static char *function       = "libvsapm_pool_file_io_handle_initialize";
+	size64_t segment_size       = 0;
+	size64_t total_size         = 0;
+	size_t segment_offsets_size = 0;
+	int number_of_segments      = 0;
+	int segment_index           = 0;
+
+	if( pool_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *pool_file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid pool file IO handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_pool_get_number_of_handles(
+	     file_io_pool,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of handles in file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_segments <= 0 )
+	 || ( (size_t) number_of_segments > ( ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( off64_t ) ) - 1 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of segments value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*pool_file_io_handle = memory_allocate_structure(
+	                        libvsapm_pool_file_io_handle_t );
+
+	if( *pool_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create pool file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *pool_file_io_handle,
+	     0,
+	     sizeof( libvsapm_pool_file_io_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear pool file IO handle.",
+		 function );
+
+		memory_free(
+		 *pool_file_io_handle );
+
+		*pool_file_io_handle = NULL;
+
+		return( -1 );
+	}
+	segment_offsets_size = sizeof( off64_t ) * ( number_of_segments + 1 );
+
+	( *pool_file_io_handle )->segment_offsets = (off64_t *) memory_allocate(
+	                                                         segment_offsets_size );
+
+	if( ( *pool_file_io_handle )->segment_offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segment offsets.",
+		 function );
+
+		goto on_error;
+	}
+	/* The size of every segment is retrieved up front so that reads
+	 * can be mapped onto segments without querying the file IO pool
+	 */
+	for( segment_index = 0;
+	     segment_index < number_of_segments;
+	     segment_index++ )
+	{
+		if( libbfio_pool_get_size(
+		     file_io_pool,
+		     segment_index,
+		     &segment_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve size of segment: %d.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		if( segment_size > ( (size64_t) INT64_MAX - total_size ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid segment: %d size value out of bounds.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		( *pool_file_io_handle )->segment_offsets[ segment_index ] = (off64_t) total_size;
+
+		total_size += segment_size;
+	}
+	( *pool_file_io_handle )->segment_offsets[ number_of_segments ] = (off64_t) total_size;
+
+	( *pool_file_io_handle )->file_io_pool       = file_io_pool;
+	( *pool_file_io_handle )->number_of_segments = number_of_segments;
+
+	return( 1 );
+
+on_error:
+	if( *pool_file_io_handle != NULL )
+	{
+		if( ( *pool_file_io_handle )->segment_offsets != NULL )
+		{
+			memory_free(
+			 ( *pool_file_io_handle )->segment_offsets );
+		}
+		memory_free(
+		 *pool_file_io_handle );
+
+		*pool_file_io_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Creates a (basic file IO) handle that reads the segments in the file IO pool as one continuous stream
+ * Make sure the value handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_pool_file_io_handle_initialize_handle(
+     libbfio_handle_t **handle,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error )
+{
+	libvsapm_pool_file_io_handle_t *pool_file_io_handle = NULL;
+	static char *function                               = "libvsapm_pool_file_io_handle_initialize_handle";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvsapm_pool_file_io_handle_initialize(
+	     &pool_file_io_handle,
+	     file_io_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create pool file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_initialize(
+	     handle,
+	     (intptr_t *) pool_file_io_handle,
+	     (int (*)(intptr_t **, libcerror_error_t **)) libvsapm_pool_file_io_handle_free,
+	     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) libvsapm_pool_file_io_handle_clone,
+	     (int (*)(intptr_t *, int, libcerror_error_t **)) libvsapm_pool_file_io_handle_open,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libvsapm_pool_file_io_handle_close,
+	     (ssize_t (*)(intptr_t *, uint8_t *, size_t, libcerror_error_t **)) libvsapm_pool_file_io_handle_read,
+	     (ssize_t (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) libvsapm_pool_file_io_handle_write,
+	     (off64_t (*)(intptr_t *, off64_t, int, libcerror_error_t **)) libvsapm_pool_file_io_handle_seek_offset,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libvsapm_pool_file_io_handle_exists,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libvsapm_pool_file_io_handle_is_open,
+	     (int (*)(intptr_t *, size64_t *, libcerror_error_t **)) libvsapm_pool_file_io_handle_get_size,
+	     LIBBFIO_FLAG_IO_HANDLE_MANAGED | LIBBFIO_FLAG_IO_HANDLE_CLONE_BY_FUNCTION,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( pool_file_io_handle != NULL )
+	{
+		libvsapm_pool_file_io_handle_free(
+		 &pool_file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a pool file IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_pool_file_io_handle_free(
+     libvsapm_pool_file_io_handle_t **pool_file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_pool_file_io_handle_free";
+
+	if( pool_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *pool_file_io_handle != NULL )
+	{
+		/* The file_io_pool is referenced and freed elsewhere
+		 */
+		if( ( *pool_file_io_handle )->segment_offsets != NULL )
+		{
+			memory_free(
+			 ( *pool_file_io_handle )->segment_offsets );
+		}
+		memory_free(
+		 *pool_file_io_handle );
+
+		*pool_file_io_handle = NULL;
+	}
+	return( 1 );
+}
+
+/* Clones (duplicates) the pool file IO handle
+ * The clone references the same file IO pool
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_pool_file_io_handle_clone(
+     libvsapm_pool_file_io_handle_t **destination_pool_file_io_handle,
+     libvsapm_pool_file_io_handle_t *source_pool_file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_pool_file_io_handle_clone";
+
+	if( destination_pool_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination pool file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_pool_file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: destination pool file IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_pool_file_io_handle == NULL )
+	{
+		*destination_pool_file_io_handle = NULL;
+
+		return( 1 );
+	}
+	if( libvsapm_pool_file_io_handle_initialize(
+	     destination_pool_file_io_handle,
+	     source_pool_file_io_handle->file_io_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create pool file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Opens the pool file IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_pool_file_io_handle_open(
+     libvsapm_pool_file_io_handle_t *pool_file_io_handle,
+     int access_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_pool_file_io_handle_open";
+
+	if( pool_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( access_flags & LIBBFIO_ACCESS_FLAG_WRITE ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: write access currently not supported.",
+		 function );
+
+		return( -1 );
+	}
+	/* No need to do anything here, because the file IO handles in the pool are opened on demand
+	 */
+	pool_file_io_handle->access_flags   = access_flags;
+	pool_file_io_handle->current_offset = 0;
+
+	return( 1 );
+}
+
+/* Closes the pool file IO handle
+ * Returns 0 if successful or -1 on error
+ */
+int libvsapm_pool_file_io_handle_close(
+     libvsapm_pool_file_io_handle_t *pool_file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_pool_file_io_handle_close";
+
+	if( pool_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	/* Do not close the file IO pool, it is managed by the volume
+	 */
+	pool_file_io_handle->access_flags = 0;
+
+	return( 0 );
+}
+
+/* Retrieves the index of the segment that contains a specific offset
+ * Returns 1 if successful, 0 if no such segment or -1 on error
+ */
+int libvsapm_pool_file_io_handle_get_segment_index_by_offset(
+     libvsapm_pool_file_io_handle_t *pool_file_io_handle,
+     off64_t offset,
+     int *segment_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_pool_file_io_handle_get_segment_index_by_offset";
+	int lower_index       = 0;
+	int middle_index      = 0;
+	int upper_index       = 0;
+
+	if( pool_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( pool_file_io_handle->segment_offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid pool file IO handle - missing segment offsets.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment index.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < 0 )
+	 || ( offset >= pool_file_io_handle->segment_offsets[ pool_file_io_handle->number_of_segments ] ) )
+	{
+		return( 0 );
+	}
+	/* Sequential reads mostly stay within the segment of the previous read
+	 */
+	lower_index = pool_file_io_handle->current_segment_index;
+
+	if( ( offset >= pool_file_io_handle->segment_offsets[ lower_index ] )
+	 && ( offset < pool_file_io_handle->segment_offsets[ lower_index + 1 ] ) )
+	{
+		*segment_index = lower_index;
+
+		return( 1 );
+	}
+	/* Search for the last segment that starts at or before the offset,
+	 * empty segments are skipped since their end offset equals their start offset
+	 */
+	lower_index = 0;
+	upper_index = pool_file_io_handle->number_of_segments;
+
+	while( ( upper_index - lower_index ) > 1 )
+	{
+		middle_index = lower_index + ( ( upper_index - lower_index ) / 2 );
+
+		if( pool_file_io_handle->segment_offsets[ middle_index ] <= offset )
+		{
+			lower_index = middle_index;
+		}
+		else
+		{
+			upper_index = middle_index;
+		}
+	}
+	pool_file_io_handle->current_segment_index = lower_index;
+
+	*segment_index = lower_index;
+
+	return( 1 );
+}
+
+/* Reads a buffer from the pool file IO handle
+ * Reads that span multiple segments are split into a read per segment
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t libvsapm_pool_file_io_handle_read(
+         libvsapm_pool_file_io_handle_t *pool_file_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function  = "libvsapm_pool_file_io_handle_read";
+	size_t buffer_offset   = 0;
+	size_t read_size       = 0;
+	ssize_t read_count     = 0;
+	off64_t segment_offset = 0;
+	int result             = 0;
+	int segment_index      = 0;
+
+	if( pool_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < size )
+	{
+		result = libvsapm_pool_file_io_handle_get_segment_index_by_offset(
+		          pool_file_io_handle,
+		          pool_file_io_handle->current_offset,
+		          &segment_index,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment index for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 pool_file_io_handle->current_offset,
+			 pool_file_io_handle->current_offset );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		segment_offset = pool_file_io_handle->current_offset - pool_file_io_handle->segment_offsets[ segment_index ];
+
+		read_size = size - buffer_offset;
+
+		if( (size64_t) read_size > (size64_t) ( pool_file_io_handle->segment_offsets[ segment_index + 1 ] - pool_file_io_handle->current_offset ) )
+		{
+			read_size = (size_t) ( pool_file_io_handle->segment_offsets[ segment_index + 1 ] - pool_file_io_handle->current_offset );
+		}
+		read_count = libbfio_pool_read_buffer_at_offset(
+		              pool_file_io_handle->file_io_pool,
+		              segment_index,
+		              &( buffer[ buffer_offset ] ),
+		              read_size,
+		              segment_offset,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer from segment: %d at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 segment_index,
+			 segment_offset,
+			 segment_offset );
+
+			return( -1 );
+		}
+		else if( read_count == 0 )
+		{
+			break;
+		}
+		buffer_offset                       += (size_t) read_count;
+		pool_file_io_handle->current_offset += (off64_t) read_count;
+	}
+	return( (ssize_t) buffer_offset );
+}
+
+/* Writes a buffer to the pool file IO handle
+ * Returns the number of bytes written if successful, or -1 on error
+ */
+ssize_t libvsapm_pool_file_io_handle_write(
+         libvsapm_pool_file_io_handle_t *pool_file_io_handle LIBVSAPM_ATTRIBUTE_UNUSED,
+         const uint8_t *buffer LIBVSAPM_ATTRIBUTE_UNUSED,
+         size_t size LIBVSAPM_ATTRIBUTE_UNUSED,
+         libcerror_error_t **error )
+{
+	static char *function = "libvsapm_pool_file_io_handle_write";
+
+	LIBVSAPM_UNREFERENCED_PARAMETER( pool_file_io_handle )
+	LIBVSAPM_UNREFERENCED_PARAMETER( buffer )
+	LIBVSAPM_UNREFERENCED_PARAMETER( size )
+
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: write access currently not supported.",
+	 function );
+
+	return( -1 );
+}
+
+/* Seeks a certain offset within the pool file IO handle
+ * Returns the offset if the seek is successful or -1 on error
+ */
+off64_t libvsapm_pool_file_io_handle_seek_offset(
+         libvsapm_pool_file_io_handle_t *pool_file_io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "libvsapm_pool_file_io_handle_seek_offset";
+
+	if( pool_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( whence == SEEK_CUR )
+	{
+		offset += pool_file_io_handle->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{
+		offset += pool_file_io_handle->segment_offsets[ pool_file_io_handle->number_of_segments ];
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	pool_file_io_handle->current_offset = offset;
+
+	return( offset );
+}
+
+/* Function to determine if a file exists
+ * Returns 1 if file exists, 0 if not or -1 on error
+ */
+int libvsapm_pool_file_io_handle_exists(
+     libvsapm_pool_file_io_handle_t *pool_file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_pool_file_io_handle_exists";
+
+	if( pool_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( pool_file_io_handle->file_io_pool == NULL )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Check if the file is open
+ * Returns 1 if open, 0 if not or -1 on error
+ */
+int libvsapm_pool_file_io_handle_is_open(
+     libvsapm_pool_file_io_handle_t *pool_file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_pool_file_io_handle_is_open";
+
+	if( pool_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( pool_file_io_handle->access_flags == 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the size of all segments combined
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_pool_file_io_handle_get_size(
+     libvsapm_pool_file_io_handle_t *pool_file_io_handle,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_pool_file_io_handle_get_size";
+
+	if( pool_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	*size = (size64_t) pool_file_io_handle->segment_offsets[ pool_file_io_handle->number_of_segments ];
+
+	return( 1 );
+}
+
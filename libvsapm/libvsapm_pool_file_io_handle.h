@@ -0,0 +1,135 @@
+/*
+ * Pool file IO handle functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVSAPM_POOL_FILE_IO_HANDLE_H )
+#define _LIBVSAPM_POOL_FILE_IO_HANDLE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvsapm_libbfio.h"
+#include "libvsapm_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvsapm_pool_file_io_handle libvsapm_pool_file_io_handle_t;
+
+struct libvsapm_pool_file_io_handle
+{
+	/* The file IO pool, contains a file IO handle per segment
+	 */
+	libbfio_pool_t *file_io_pool;
+
+	/* The number of segments
+	 */
+	int number_of_segments;
+
+	/* The segment offsets, contains the start offset of every segment
+	 * followed by the end offset of the last segment
+	 */
+	off64_t *segment_offsets;
+
+	/* The index of the segment of the last read
+	 */
+	int current_segment_index;
+
+	/* The current offset
+	 */
+	off64_t current_offset;
+
+	/* The access flags
+	 */
+	int access_flags;
+};
+
+int libvsapm_pool_file_io_handle_initialize(
+     libvsapm_pool_file_io_handle_t **pool_file_io_handle,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error );
+
+int libvsapm_pool_file_io_handle_initialize_handle(
+     libbfio_handle_t **handle,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error );
+
+int libvsapm_pool_file_io_handle_free(
+     libvsapm_pool_file_io_handle_t **pool_file_io_handle,
+     libcerror_error_t **error );
+
+int libvsapm_pool_file_io_handle_clone(
+     libvsapm_pool_file_io_handle_t **destination_pool_file_io_handle,
+     libvsapm_pool_file_io_handle_t *source_pool_file_io_handle,
+     libcerror_error_t **error );
+
+int libvsapm_pool_file_io_handle_open(
+     libvsapm_pool_file_io_handle_t *pool_file_io_handle,
+     int access_flags,
+     libcerror_error_t **error );
+
+int libvsapm_pool_file_io_handle_close(
+     libvsapm_pool_file_io_handle_t *pool_file_io_handle,
+     libcerror_error_t **error );
+
+int libvsapm_pool_file_io_handle_get_segment_index_by_offset(
+     libvsapm_pool_file_io_handle_t *pool_file_io_handle,
+     off64_t offset,
+     int *segment_index,
+     libcerror_error_t **error );
+
+ssize_t libvsapm_pool_file_io_handle_read(
+         libvsapm_pool_file_io_handle_t *pool_file_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+ssize_t libvsapm_pool_file_io_handle_write(
+         libvsapm_pool_file_io_handle_t *pool_file_io_handle,
+         const uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+off64_t libvsapm_pool_file_io_handle_seek_offset(
+         libvsapm_pool_file_io_handle_t *pool_file_io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error );
+
+int libvsapm_pool_file_io_handle_exists(
+     libvsapm_pool_file_io_handle_t *pool_file_io_handle,
+     libcerror_error_t **error );
+
+int libvsapm_pool_file_io_handle_is_open(
+     libvsapm_pool_file_io_handle_t *pool_file_io_handle,
+     libcerror_error_t **error );
+
+int libvsapm_pool_file_io_handle_get_size(
+     libvsapm_pool_file_io_handle_t *pool_file_io_handle,
+     size64_t *size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSAPM_POOL_FILE_IO_HANDLE_H ) */
+
@@ -0,0 +1,892 @@
+/*
+ * Asynchronous read queue functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvsapm_definitions.h"
+#include "libvsapm_libcerror.h"
+#include "libvsapm_libcnotify.h"
+#include "libvsapm_libcthreads.h"
+#include "libvsapm_partition.h"
+#include "libvsapm_read_queue.h"
+
+/* Creates a read request
+ * Make sure the value read_request is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_read_request_initialize(
+     libvsapm_read_request_t **read_request,
+     libvsapm_partition_t *partition,
+     off64_t offset,
+     void *buffer,
+     size_t buffer_size,
+     int (*callback)(
+            libvsapm_partition_t *partition,
+            off64_t offset,
+            void *buffer,
+            ssize_t read_count,
+            void *user_data ),
+     void *user_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_read_request_initialize";
+
+	if( read_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read request.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_request != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid read request value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( partition == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( callback == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callback.",
+		 function );
+
+		return( -1 );
+	}
+	*read_request = memory_allocate_structure(
+	                 libvsapm_read_request_t );
+
+	if( *read_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read request.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     *read_request,
+	     0,
+	     sizeof( libvsapm_read_request_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear read request.",
+		 function );
+
+		memory_free(
+		 *read_request );
+
+		*read_request = NULL;
+
+		return( -1 );
+	}
+	( *read_request )->partition   = partition;
+	( *read_request )->offset      = offset;
+	( *read_request )->buffer      = buffer;
+	( *read_request )->buffer_size = buffer_size;
+	( *read_request )->read_count  = -1;
+	( *read_request )->callback    = callback;
+	( *read_request )->user_data   = user_data;
+
+	return( 1 );
+}
+
+/* Frees a read request
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_read_request_free(
+     libvsapm_read_request_t **read_request,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_read_request_free";
+
+	if( read_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read request.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_request != NULL )
+	{
+		/* The partition, buffer and user data references are freed elsewhere
+		 */
+		memory_free(
+		 *read_request );
+
+		*read_request = NULL;
+	}
+	return( 1 );
+}
+
+/* Creates a read queue
+ * Make sure the value read_queue is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_read_queue_initialize(
+     libvsapm_read_queue_t **read_queue,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_read_queue_initialize";
+
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_queue != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid read queue value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > LIBVSAPM_MAXIMUM_NUMBER_OF_READ_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*read_queue = memory_allocate_structure(
+	               libvsapm_read_queue_t );
+
+	if( *read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read queue.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *read_queue,
+	     0,
+	     sizeof( libvsapm_read_queue_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear read queue.",
+		 function );
+
+		memory_free(
+		 *read_queue );
+
+		*read_queue = NULL;
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *read_queue )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *read_queue )->number_of_threads = number_of_threads;
+
+	return( 1 );
+
+on_error:
+	if( *read_queue != NULL )
+	{
+		memory_free(
+		 *read_queue );
+
+		*read_queue = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a read queue
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_read_queue_free(
+     libvsapm_read_queue_t **read_queue,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_read_queue_free";
+	int result            = 1;
+
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_queue != NULL )
+	{
+		if( libvsapm_read_queue_join(
+		     *read_queue,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join read queue.",
+			 function );
+
+			result = -1;
+		}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *read_queue )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *read_queue );
+
+		*read_queue = NULL;
+	}
+	return( result );
+}
+
+/* Waits for all pending read requests to complete and discards the completed read requests
+ * that were not polled
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_read_queue_join(
+     libvsapm_read_queue_t *read_queue,
+     libcerror_error_t **error )
+{
+	libvsapm_read_request_t *read_request = NULL;
+	static char *function                 = "libvsapm_read_queue_join";
+	int result                            = 1;
+
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	/* The thread pool processes the read requests that are still queued before it is joined
+	 */
+	if( read_queue->thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( read_queue->thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread pool.",
+			 function );
+
+			result = -1;
+		}
+	}
+#endif
+	while( read_queue->first_completed_request != NULL )
+	{
+		read_request                        = read_queue->first_completed_request;
+		read_queue->first_completed_request = read_request->next_request;
+
+		if( libvsapm_read_request_free(
+		     &read_request,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read request.",
+			 function );
+
+			result = -1;
+		}
+	}
+	read_queue->last_completed_request = NULL;
+
+	return( result );
+}
+
+/* Pushes a read request onto the queue
+ * The worker threads are created when the first read request is pushed
+ * If multi-threading is not supported the read request is processed directly
+ * Pushing does not wait when the maximum number of pending read requests is reached
+ * Returns 1 if successful, 0 if the queue is full or -1 on error
+ */
+int libvsapm_read_queue_push(
+     libvsapm_read_queue_t *read_queue,
+     libvsapm_read_request_t *read_request,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_read_queue_push";
+
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	int result            = 0;
+#endif
+
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read request.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( read_queue->thread_pool == NULL )
+	{
+		if( libcthreads_thread_pool_create(
+		     &( read_queue->thread_pool ),
+		     NULL,
+		     read_queue->number_of_threads,
+		     LIBVSAPM_MAXIMUM_NUMBER_OF_QUEUED_READ_REQUESTS,
+		     (int (*)(intptr_t *, void *)) &libvsapm_read_queue_process_request_callback,
+		     (void *) read_queue,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread pool.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	/* The thread pool push blocks when its queue is full, hence the number of
+	 * pending read requests is bounded before pushing
+	 */
+	if( libcthreads_mutex_grab(
+	     read_queue->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_queue->number_of_pending_requests < LIBVSAPM_MAXIMUM_NUMBER_OF_QUEUED_READ_REQUESTS )
+	{
+		read_queue->number_of_pending_requests += 1;
+
+		result = 1;
+	}
+	if( libcthreads_mutex_release(
+	     read_queue->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( libcthreads_thread_pool_push(
+	     read_queue->thread_pool,
+	     (intptr_t *) read_request,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push read request onto thread pool.",
+		 function );
+
+		libvsapm_read_queue_release_pending_request(
+		 read_queue,
+		 NULL );
+
+		return( -1 );
+	}
+#else
+	if( libvsapm_read_queue_process_request(
+	     read_queue,
+	     read_request,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to process read request.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Processes a read request
+ * A failed read is reported by a read count of -1 in the completed read request
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_read_queue_process_request(
+     libvsapm_read_queue_t *read_queue,
+     libvsapm_read_request_t *read_request,
+     libcerror_error_t **error )
+{
+	libcerror_error_t *read_error = NULL;
+	static char *function         = "libvsapm_read_queue_process_request";
+
+	if( read_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read request.",
+		 function );
+
+		return( -1 );
+	}
+	read_request->read_count = libvsapm_internal_partition_read_request(
+	                            (libvsapm_internal_partition_t *) read_request->partition,
+	                            read_request,
+	                            &read_error );
+
+	if( read_request->read_count == -1 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 read_error );
+		}
+#endif
+		libcerror_error_free(
+		 &read_error );
+	}
+	if( libvsapm_read_queue_append_completed_request(
+	     read_queue,
+	     read_request,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append completed read request.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Processes a read request
+ * Callback function for the read queue thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_read_queue_process_request_callback(
+     libvsapm_read_request_t *read_request,
+     libvsapm_read_queue_t *read_queue )
+{
+	libcerror_error_t *error = NULL;
+
+	if( libvsapm_read_queue_process_request(
+	     read_queue,
+	     read_request,
+	     &error ) != 1 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+
+		/* The read request cannot be completed and is not referenced elsewhere
+		 */
+		libvsapm_read_request_free(
+		 &read_request,
+		 NULL );
+
+		libvsapm_read_queue_release_pending_request(
+		 read_queue,
+		 NULL );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Releases a pending read request that will not be completed
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_read_queue_release_pending_request(
+     libvsapm_read_queue_t *read_queue,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_read_queue_release_pending_request";
+
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     read_queue->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( read_queue->number_of_pending_requests > 0 )
+	{
+		read_queue->number_of_pending_requests -= 1;
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     read_queue->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Appends a completed read request
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_read_queue_append_completed_request(
+     libvsapm_read_queue_t *read_queue,
+     libvsapm_read_request_t *read_request,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_read_queue_append_completed_request";
+
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read request.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     read_queue->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_request->next_request = NULL;
+
+	if( read_queue->last_completed_request == NULL )
+	{
+		read_queue->first_completed_request = read_request;
+	}
+	else
+	{
+		read_queue->last_completed_request->next_request = read_request;
+	}
+	read_queue->last_completed_request = read_request;
+
+	if( read_queue->number_of_pending_requests > 0 )
+	{
+		read_queue->number_of_pending_requests -= 1;
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     read_queue->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Pops a completed read request without waiting
+ * Returns 1 if successful, 0 if no completed read request is available or -1 on error
+ */
+int libvsapm_read_queue_pop_completed_request(
+     libvsapm_read_queue_t *read_queue,
+     libvsapm_read_request_t **read_request,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_read_queue_pop_completed_request";
+	int result            = 0;
+
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read request.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     read_queue->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*read_request = read_queue->first_completed_request;
+
+	if( *read_request != NULL )
+	{
+		read_queue->first_completed_request = ( *read_request )->next_request;
+
+		if( read_queue->first_completed_request == NULL )
+		{
+			read_queue->last_completed_request = NULL;
+		}
+		( *read_request )->next_request = NULL;
+
+		result = 1;
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     read_queue->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
@@ -0,0 +1,174 @@
+/*
+ * Asynchronous read queue functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVSAPM_READ_QUEUE_H )
+#define _LIBVSAPM_READ_QUEUE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvsapm_libcerror.h"
+#include "libvsapm_libcthreads.h"
+#include "libvsapm_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvsapm_read_request libvsapm_read_request_t;
+
+struct libvsapm_read_request
+{
+	/* The partition
+	 */
+	libvsapm_partition_t *partition;
+
+	/* The offset of the data in the partition
+	 */
+	off64_t offset;
+
+	/* The buffer
+	 */
+	void *buffer;
+
+	/* The size of the buffer
+	 */
+	size_t buffer_size;
+
+	/* The number of bytes read or -1 on error
+	 */
+	ssize_t read_count;
+
+	/* The completion callback
+	 */
+	int (*callback)(
+	       libvsapm_partition_t *partition,
+	       off64_t offset,
+	       void *buffer,
+	       ssize_t read_count,
+	       void *user_data );
+
+	/* The user data passed to the completion callback
+	 */
+	void *user_data;
+
+	/* The next completed read request
+	 */
+	libvsapm_read_request_t *next_request;
+};
+
+typedef struct libvsapm_read_queue libvsapm_read_queue_t;
+
+struct libvsapm_read_queue
+{
+	/* The number of worker threads
+	 */
+	int number_of_threads;
+
+	/* The number of read requests that were pushed and have not yet completed
+	 */
+	int number_of_pending_requests;
+
+	/* The first completed read request
+	 */
+	libvsapm_read_request_t *first_completed_request;
+
+	/* The last completed read request
+	 */
+	libvsapm_read_request_t *last_completed_request;
+
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	/* The worker thread pool, created when the first read request is pushed
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The mutex that protects the completed read requests
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int libvsapm_read_request_initialize(
+     libvsapm_read_request_t **read_request,
+     libvsapm_partition_t *partition,
+     off64_t offset,
+     void *buffer,
+     size_t buffer_size,
+     int (*callback)(
+            libvsapm_partition_t *partition,
+            off64_t offset,
+            void *buffer,
+            ssize_t read_count,
+            void *user_data ),
+     void *user_data,
+     libcerror_error_t **error );
+
+int libvsapm_read_request_free(
+     libvsapm_read_request_t **read_request,
+     libcerror_error_t **error );
+
+int libvsapm_read_queue_initialize(
+     libvsapm_read_queue_t **read_queue,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int libvsapm_read_queue_free(
+     libvsapm_read_queue_t **read_queue,
+     libcerror_error_t **error );
+
+int libvsapm_read_queue_join(
+     libvsapm_read_queue_t *read_queue,
+     libcerror_error_t **error );
+
+int libvsapm_read_queue_push(
+     libvsapm_read_queue_t *read_queue,
+     libvsapm_read_request_t *read_request,
+     libcerror_error_t **error );
+
+int libvsapm_read_queue_process_request(
+     libvsapm_read_queue_t *read_queue,
+     libvsapm_read_request_t *read_request,
+     libcerror_error_t **error );
+
+int libvsapm_read_queue_process_request_callback(
+     libvsapm_read_request_t *read_request,
+     libvsapm_read_queue_t *read_queue );
+
+int libvsapm_read_queue_release_pending_request(
+     libvsapm_read_queue_t *read_queue,
+     libcerror_error_t **error );
+
+int libvsapm_read_queue_append_completed_request(
+     libvsapm_read_queue_t *read_queue,
+     libvsapm_read_request_t *read_request,
+     libcerror_error_t **error );
+
+int libvsapm_read_queue_pop_completed_request(
+     libvsapm_read_queue_t *read_queue,
+     libvsapm_read_request_t **read_request,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSAPM_READ_QUEUE_H ) */
+
@@ -0,0 +1,1397 @@
+/*
+ * Parallel volume scan functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvsapm_definitions.h"
+#include "libvsapm_libbfio.h"
+#include "libvsapm_libcerror.h"
+#include "libvsapm_libcnotify.h"
+#include "libvsapm_libcthreads.h"
+#include "libvsapm_scan_job.h"
+#include "libvsapm_unused.h"
+
+/* Creates a scan worker
+ * Make sure the value scan_worker is referencing, is set to NULL
+ * If a file IO handle is provided the worker reads from its own clone of the file IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_scan_worker_initialize(
+     libvsapm_scan_worker_t **scan_worker,
+     libvsapm_scan_job_t *scan_job,
+     int worker_index,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function      = "libvsapm_scan_worker_initialize";
+	int file_io_handle_is_open = 0;
+
+	if( scan_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scan worker.",
+		 function );
+
+		return( -1 );
+	}
+	if( *scan_worker != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid scan worker value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( scan_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scan job.",
+		 function );
+
+		return( -1 );
+	}
+	if( worker_index < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid worker index value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	*scan_worker = memory_allocate_structure(
+	                libvsapm_scan_worker_t );
+
+	if( *scan_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create scan worker.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *scan_worker,
+	     0,
+	     sizeof( libvsapm_scan_worker_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear scan worker.",
+		 function );
+
+		memory_free(
+		 *scan_worker );
+
+		*scan_worker = NULL;
+
+		return( -1 );
+	}
+	if( file_io_handle != NULL )
+	{
+		( *scan_worker )->buffer = (uint8_t *) memory_allocate(
+		                                        sizeof( uint8_t ) * scan_job->chunk_size );
+
+		if( ( *scan_worker )->buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create buffer.",
+			 function );
+
+			goto on_error;
+		}
+		if( libbfio_handle_clone(
+		     &( ( *scan_worker )->file_io_handle ),
+		     file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to clone file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+		file_io_handle_is_open = libbfio_handle_is_open(
+		                          ( *scan_worker )->file_io_handle,
+		                          error );
+
+		if( file_io_handle_is_open == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if file IO handle is open.",
+			 function );
+
+			goto on_error;
+		}
+		else if( file_io_handle_is_open == 0 )
+		{
+			if( libbfio_handle_open(
+			     ( *scan_worker )->file_io_handle,
+			     LIBBFIO_OPEN_READ,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to open file IO handle.",
+				 function );
+
+				goto on_error;
+			}
+			( *scan_worker )->file_io_handle_opened = 1;
+		}
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *scan_worker )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *scan_worker )->scan_job     = scan_job;
+	( *scan_worker )->worker_index = worker_index;
+	( *scan_worker )->result       = 1;
+
+	return( 1 );
+
+on_error:
+	if( *scan_worker != NULL )
+	{
+		libvsapm_scan_worker_free(
+		 scan_worker,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a scan worker
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_scan_worker_free(
+     libvsapm_scan_worker_t **scan_worker,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_scan_worker_free";
+	int result            = 1;
+
+	if( scan_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scan worker.",
+		 function );
+
+		return( -1 );
+	}
+	if( *scan_worker != NULL )
+	{
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+		if( ( *scan_worker )->mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *scan_worker )->mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
+		if( ( *scan_worker )->file_io_handle_opened != 0 )
+		{
+			if( libbfio_handle_close(
+			     ( *scan_worker )->file_io_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close file IO handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *scan_worker )->file_io_handle != NULL )
+		{
+			if( libbfio_handle_free(
+			     &( ( *scan_worker )->file_io_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file IO handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *scan_worker )->buffer != NULL )
+		{
+			memory_free(
+			 ( *scan_worker )->buffer );
+		}
+		memory_free(
+		 *scan_worker );
+
+		*scan_worker = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves the index of the next chunk to scan
+ * The chunk is taken from the front of the chunks of the worker, if the worker has no chunks left
+ * half of the remaining chunks of another worker are taken from the back of its chunks
+ * Returns 1 if successful, 0 if no chunks remain or -1 on error
+ */
+int libvsapm_scan_worker_get_next_chunk_index(
+     libvsapm_scan_worker_t *scan_worker,
+     uint64_t *chunk_index,
+     libcerror_error_t **error )
+{
+	static char *function                 = "libvsapm_scan_worker_get_next_chunk_index";
+	int result                            = 0;
+
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	libvsapm_scan_worker_t *victim_worker = NULL;
+	uint64_t number_of_remaining_chunks   = 0;
+	uint64_t number_of_stolen_chunks      = 0;
+	uint64_t stolen_chunk_index           = 0;
+	int victim_offset                     = 0;
+#endif
+
+	if( scan_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scan worker.",
+		 function );
+
+		return( -1 );
+	}
+	if( scan_worker->scan_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid scan worker - missing scan job.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk index.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     scan_worker->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( scan_worker->first_chunk_index < scan_worker->last_chunk_index )
+	{
+		*chunk_index = scan_worker->first_chunk_index;
+
+		scan_worker->first_chunk_index += 1;
+
+		result = 1;
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     scan_worker->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	/* Only one mutex is held at a time so that workers that steal from each other cannot deadlock
+	 */
+	for( victim_offset = 1;
+	     ( result == 0 ) && ( victim_offset < scan_worker->scan_job->number_of_workers );
+	     victim_offset++ )
+	{
+		victim_worker = scan_worker->scan_job->workers[ ( scan_worker->worker_index + victim_offset ) % scan_worker->scan_job->number_of_workers ];
+
+		if( libcthreads_mutex_grab(
+		     victim_worker->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex of worker: %d.",
+			 function,
+			 victim_worker->worker_index );
+
+			return( -1 );
+		}
+		number_of_stolen_chunks = 0;
+
+		if( victim_worker->first_chunk_index < victim_worker->last_chunk_index )
+		{
+			number_of_remaining_chunks = victim_worker->last_chunk_index - victim_worker->first_chunk_index;
+			number_of_stolen_chunks    = ( number_of_remaining_chunks + 1 ) / 2;
+
+			victim_worker->last_chunk_index -= number_of_stolen_chunks;
+
+			stolen_chunk_index = victim_worker->last_chunk_index;
+		}
+		if( libcthreads_mutex_release(
+		     victim_worker->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex of worker: %d.",
+			 function,
+			 victim_worker->worker_index );
+
+			return( -1 );
+		}
+		if( number_of_stolen_chunks == 0 )
+		{
+			continue;
+		}
+		if( libcthreads_mutex_grab(
+		     scan_worker->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			return( -1 );
+		}
+		scan_worker->first_chunk_index = stolen_chunk_index + 1;
+		scan_worker->last_chunk_index  = stolen_chunk_index + number_of_stolen_chunks;
+
+		if( libcthreads_mutex_release(
+		     scan_worker->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			return( -1 );
+		}
+		*chunk_index = stolen_chunk_index;
+
+		result = 1;
+	}
+#endif /* defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT ) */
+
+	return( result );
+}
+
+/* Scans chunks until no chunks remain or the scan job is aborted
+ * Returns 1 if successful, 0 if the scan was stopped by the callback or -1 on error
+ */
+int libvsapm_scan_worker_scan(
+     libvsapm_scan_worker_t *scan_worker,
+     libcerror_error_t **error )
+{
+	libvsapm_scan_job_t *scan_job = NULL;
+	const uint8_t *data           = NULL;
+	static char *function         = "libvsapm_scan_worker_scan";
+	size_t chunk_size             = 0;
+	ssize_t read_count            = 0;
+	uint64_t chunk_index          = 0;
+	off64_t chunk_offset          = 0;
+	off64_t volume_offset         = 0;
+	int partition_index           = 0;
+	int result                    = 0;
+
+	if( scan_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scan worker.",
+		 function );
+
+		return( -1 );
+	}
+	if( scan_worker->scan_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid scan worker - missing scan job.",
+		 function );
+
+		return( -1 );
+	}
+	scan_job = scan_worker->scan_job;
+
+	while( scan_job->abort == 0 )
+	{
+		result = libvsapm_scan_worker_get_next_chunk_index(
+		          scan_worker,
+		          &chunk_index,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next chunk index.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		if( libvsapm_scan_job_get_chunk(
+		     scan_job,
+		     chunk_index,
+		     &partition_index,
+		     &volume_offset,
+		     &chunk_offset,
+		     &chunk_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 ".",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		/* When the volume was opened from memory the callback is passed the volume data directly
+		 */
+		if( scan_job->memory_data != NULL )
+		{
+			if( ( (size64_t) volume_offset >= scan_job->memory_data_size )
+			 || ( (size64_t) chunk_size > ( scan_job->memory_data_size - volume_offset ) ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read chunk data at offset: %" PRIi64 " (0x%08" PRIx64 ") - data exceeds volume data in memory.",
+				 function,
+				 volume_offset,
+				 volume_offset );
+
+				goto on_error;
+			}
+			data = &( scan_job->memory_data[ volume_offset ] );
+		}
+		else
+		{
+			read_count = libbfio_handle_read_buffer_at_offset(
+			              scan_worker->file_io_handle,
+			              scan_worker->buffer,
+			              chunk_size,
+			              volume_offset,
+			              error );
+
+			if( read_count != (ssize_t) chunk_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read chunk data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 volume_offset,
+				 volume_offset );
+
+				goto on_error;
+			}
+			data = scan_worker->buffer;
+		}
+		result = scan_job->callback(
+		          partition_index,
+		          chunk_offset,
+		          data,
+		          chunk_size,
+		          scan_job->user_data );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: callback failed for chunk of partition: %d at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 partition_index,
+			 chunk_offset,
+			 chunk_offset );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			scan_job->abort = 1;
+
+			return( 0 );
+		}
+	}
+	return( 1 );
+
+on_error:
+	scan_job->abort = 1;
+
+	return( -1 );
+}
+
+/* Scans chunks from a thread pool
+ * Any error is stored as the result of the scan worker
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_scan_worker_scan_callback(
+     libvsapm_scan_worker_t *scan_worker,
+     void *arguments LIBVSAPM_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+
+	LIBVSAPM_UNREFERENCED_PARAMETER( arguments )
+
+	if( scan_worker == NULL )
+	{
+		return( -1 );
+	}
+	scan_worker->result = libvsapm_scan_worker_scan(
+	                       scan_worker,
+	                       &error );
+
+	if( scan_worker->result == -1 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Creates a scan job
+ * Make sure the value scan_job is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_scan_job_initialize(
+     libvsapm_scan_job_t **scan_job,
+     size_t chunk_size,
+     int (*callback)(
+            int partition_index,
+            off64_t offset,
+            const uint8_t *data,
+            size_t data_size,
+            void *user_data ),
+     void *user_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_scan_job_initialize";
+
+	if( scan_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scan job.",
+		 function );
+
+		return( -1 );
+	}
+	if( *scan_job != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid scan job value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_size == 0 )
+	 || ( chunk_size > (size_t) LIBVSAPM_MAXIMUM_SCAN_CHUNK_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( callback == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callback.",
+		 function );
+
+		return( -1 );
+	}
+	*scan_job = memory_allocate_structure(
+	             libvsapm_scan_job_t );
+
+	if( *scan_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create scan job.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     *scan_job,
+	     0,
+	     sizeof( libvsapm_scan_job_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear scan job.",
+		 function );
+
+		memory_free(
+		 *scan_job );
+
+		*scan_job = NULL;
+
+		return( -1 );
+	}
+	( *scan_job )->chunk_size = chunk_size;
+	( *scan_job )->callback   = callback;
+	( *scan_job )->user_data  = user_data;
+
+	return( 1 );
+}
+
+/* Frees a scan job
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_scan_job_free(
+     libvsapm_scan_job_t **scan_job,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_scan_job_free";
+	int result            = 1;
+	int worker_index      = 0;
+
+	if( scan_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scan job.",
+		 function );
+
+		return( -1 );
+	}
+	if( *scan_job != NULL )
+	{
+		if( ( *scan_job )->workers != NULL )
+		{
+			for( worker_index = 0;
+			     worker_index < ( *scan_job )->number_of_workers;
+			     worker_index++ )
+			{
+				if( libvsapm_scan_worker_free(
+				     &( ( *scan_job )->workers[ worker_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free scan worker: %d.",
+					 function,
+					 worker_index );
+
+					result = -1;
+				}
+			}
+			memory_free(
+			 ( *scan_job )->workers );
+		}
+		if( ( *scan_job )->ranges != NULL )
+		{
+			memory_free(
+			 ( *scan_job )->ranges );
+		}
+		memory_free(
+		 *scan_job );
+
+		*scan_job = NULL;
+	}
+	return( result );
+}
+
+/* Appends a range to scan
+ * The offset is the offset of the start of the range that is reported to the callback
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_scan_job_append_range(
+     libvsapm_scan_job_t *scan_job,
+     int partition_index,
+     off64_t volume_offset,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error )
+{
+	libvsapm_scan_range_t *ranges  = NULL;
+	static char *function          = "libvsapm_scan_job_append_range";
+	int number_of_allocated_ranges = 0;
+
+	if( scan_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scan job.",
+		 function );
+
+		return( -1 );
+	}
+	if( scan_job->workers != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid scan job - workers value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( volume_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid volume offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == 0 )
+	{
+		return( 1 );
+	}
+	if( scan_job->number_of_ranges >= scan_job->number_of_allocated_ranges )
+	{
+		if( scan_job->number_of_allocated_ranges == 0 )
+		{
+			number_of_allocated_ranges = 16;
+		}
+		else
+		{
+			if( scan_job->number_of_allocated_ranges > ( INT_MAX / 2 ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+				 "%s: invalid scan job - number of allocated ranges value exceeds maximum.",
+				 function );
+
+				return( -1 );
+			}
+			number_of_allocated_ranges = scan_job->number_of_allocated_ranges * 2;
+		}
+		ranges = (libvsapm_scan_range_t *) memory_reallocate(
+		                                    scan_job->ranges,
+		                                    sizeof( libvsapm_scan_range_t ) * number_of_allocated_ranges );
+
+		if( ranges == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize ranges.",
+			 function );
+
+			return( -1 );
+		}
+		scan_job->ranges                     = ranges;
+		scan_job->number_of_allocated_ranges = number_of_allocated_ranges;
+	}
+	ranges = &( scan_job->ranges[ scan_job->number_of_ranges ] );
+
+	ranges->partition_index   = partition_index;
+	ranges->volume_offset     = volume_offset;
+	ranges->offset            = offset;
+	ranges->size              = size;
+	ranges->first_chunk_index = scan_job->number_of_chunks;
+
+	scan_job->number_of_chunks += ( size + scan_job->chunk_size - 1 ) / scan_job->chunk_size;
+	scan_job->number_of_ranges += 1;
+
+	return( 1 );
+}
+
+/* Retrieves a specific chunk
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_scan_job_get_chunk(
+     libvsapm_scan_job_t *scan_job,
+     uint64_t chunk_index,
+     int *partition_index,
+     off64_t *volume_offset,
+     off64_t *offset,
+     size_t *size,
+     libcerror_error_t **error )
+{
+	libvsapm_scan_range_t *range = NULL;
+	static char *function        = "libvsapm_scan_job_get_chunk";
+	size64_t chunk_offset        = 0;
+	int range_index              = 0;
+	int range_index_end          = 0;
+	int range_index_start        = 0;
+
+	if( scan_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scan job.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index >= scan_job->number_of_chunks )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( partition_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition index.",
+		 function );
+
+		return( -1 );
+	}
+	if( volume_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	/* The ranges are sorted by first chunk index, find the last range
+	 * with a first chunk index that is less than or equal to the chunk index
+	 */
+	range_index_start = 0;
+	range_index_end   = scan_job->number_of_ranges;
+
+	while( ( range_index_end - range_index_start ) > 1 )
+	{
+		range_index = range_index_start + ( ( range_index_end - range_index_start ) / 2 );
+
+		if( scan_job->ranges[ range_index ].first_chunk_index <= chunk_index )
+		{
+			range_index_start = range_index;
+		}
+		else
+		{
+			range_index_end = range_index;
+		}
+	}
+	range = &( scan_job->ranges[ range_index_start ] );
+
+	chunk_offset = ( chunk_index - range->first_chunk_index ) * scan_job->chunk_size;
+
+	*partition_index = range->partition_index;
+	*volume_offset   = range->volume_offset + (off64_t) chunk_offset;
+	*offset          = range->offset + (off64_t) chunk_offset;
+	*size            = scan_job->chunk_size;
+
+	if( (size64_t) *size > ( range->size - chunk_offset ) )
+	{
+		*size = (size_t) ( range->size - chunk_offset );
+	}
+	return( 1 );
+}
+
+/* Creates the workers and divides the chunks evenly over them
+ * If the volume data is not available in memory every worker reads from its own clone of the file IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_scan_job_initialize_workers(
+     libvsapm_scan_job_t *scan_job,
+     int number_of_threads,
+     libbfio_handle_t *file_io_handle,
+     const uint8_t *memory_data,
+     size64_t memory_data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_scan_job_initialize_workers";
+	int number_of_workers = 0;
+	int worker_index      = 0;
+
+	if( scan_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scan job.",
+		 function );
+
+		return( -1 );
+	}
+	if( scan_job->workers != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid scan job - workers value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > LIBVSAPM_MAXIMUM_NUMBER_OF_SCAN_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_io_handle == NULL )
+	 && ( memory_data == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	number_of_workers = number_of_threads;
+#else
+	number_of_workers = 1;
+#endif
+	/* There is no point in having workers without chunks to start with
+	 */
+	if( (uint64_t) number_of_workers > scan_job->number_of_chunks )
+	{
+		number_of_workers = (int) scan_job->number_of_chunks;
+	}
+	if( number_of_workers == 0 )
+	{
+		return( 1 );
+	}
+	scan_job->workers = (libvsapm_scan_worker_t **) memory_allocate(
+	                                                 sizeof( libvsapm_scan_worker_t * ) * number_of_workers );
+
+	if( scan_job->workers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create workers.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     scan_job->workers,
+	     0,
+	     sizeof( libvsapm_scan_worker_t * ) * number_of_workers ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear workers.",
+		 function );
+
+		goto on_error;
+	}
+	scan_job->number_of_workers = number_of_workers;
+	scan_job->memory_data       = memory_data;
+	scan_job->memory_data_size  = memory_data_size;
+
+	if( memory_data != NULL )
+	{
+		file_io_handle = NULL;
+	}
+	for( worker_index = 0;
+	     worker_index < number_of_workers;
+	     worker_index++ )
+	{
+		if( libvsapm_scan_worker_initialize(
+		     &( scan_job->workers[ worker_index ] ),
+		     scan_job,
+		     worker_index,
+		     file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create scan worker: %d.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+		scan_job->workers[ worker_index ]->first_chunk_index = ( scan_job->number_of_chunks * worker_index ) / number_of_workers;
+		scan_job->workers[ worker_index ]->last_chunk_index  = ( scan_job->number_of_chunks * ( worker_index + 1 ) ) / number_of_workers;
+	}
+	return( 1 );
+
+on_error:
+	if( scan_job->workers != NULL )
+	{
+		for( worker_index = 0;
+		     worker_index < number_of_workers;
+		     worker_index++ )
+		{
+			libvsapm_scan_worker_free(
+			 &( scan_job->workers[ worker_index ] ),
+			 NULL );
+		}
+		memory_free(
+		 scan_job->workers );
+
+		scan_job->workers = NULL;
+	}
+	scan_job->number_of_workers = 0;
+
+	return( -1 );
+}
+
+/* Runs the scan job
+ * Every worker runs on a separate thread if multi-threading is supported
+ * Returns 1 if successful, 0 if the scan was stopped by the callback or -1 on error
+ */
+int libvsapm_scan_job_run(
+     libvsapm_scan_job_t *scan_job,
+     libcerror_error_t **error )
+{
+	static char *function                  = "libvsapm_scan_job_run";
+	int result                             = 1;
+	int worker_index                       = 0;
+
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	libcthreads_thread_pool_t *thread_pool = NULL;
+#endif
+
+	if( scan_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scan job.",
+		 function );
+
+		return( -1 );
+	}
+	if( scan_job->number_of_workers == 0 )
+	{
+		return( 1 );
+	}
+	scan_job->abort = 0;
+
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( scan_job->number_of_workers > 1 )
+	{
+		if( libcthreads_thread_pool_create(
+		     &thread_pool,
+		     NULL,
+		     scan_job->number_of_workers,
+		     scan_job->number_of_workers,
+		     (int (*)(intptr_t *, void *)) &libvsapm_scan_worker_scan_callback,
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread pool.",
+			 function );
+
+			return( -1 );
+		}
+		for( worker_index = 0;
+		     worker_index < scan_job->number_of_workers;
+		     worker_index++ )
+		{
+			if( libcthreads_thread_pool_push(
+			     thread_pool,
+			     (intptr_t *) scan_job->workers[ worker_index ],
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push scan worker: %d onto thread pool.",
+				 function,
+				 worker_index );
+
+				/* The workers that were pushed stop at their next chunk
+				 */
+				scan_job->abort = 1;
+
+				libcthreads_thread_pool_join(
+				 &thread_pool,
+				 NULL );
+
+				return( -1 );
+			}
+		}
+		if( libcthreads_thread_pool_join(
+		     &thread_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread pool.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else
+#endif /* defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT ) */
+	{
+		scan_job->workers[ 0 ]->result = libvsapm_scan_worker_scan(
+		                                  scan_job->workers[ 0 ],
+		                                  error );
+
+		if( scan_job->workers[ 0 ]->result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to scan chunks of worker: 0.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	for( worker_index = 0;
+	     worker_index < scan_job->number_of_workers;
+	     worker_index++ )
+	{
+		if( scan_job->workers[ worker_index ]->result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to scan chunks of worker: %d.",
+			 function,
+			 worker_index );
+
+			return( -1 );
+		}
+		else if( scan_job->workers[ worker_index ]->result == 0 )
+		{
+			result = 0;
+		}
+	}
+	return( result );
+}
+
@@ -0,0 +1,236 @@
+/*
+ * Parallel volume scan functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVSAPM_SCAN_JOB_H )
+#define _LIBVSAPM_SCAN_JOB_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvsapm_libbfio.h"
+#include "libvsapm_libcerror.h"
+#include "libvsapm_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvsapm_scan_range libvsapm_scan_range_t;
+
+struct libvsapm_scan_range
+{
+	/* The partition index or -1 for unallocated data
+	 */
+	int partition_index;
+
+	/* The offset of the range in the volume
+	 */
+	off64_t volume_offset;
+
+	/* The offset of the range that is reported to the callback
+	 */
+	off64_t offset;
+
+	/* The size of the range
+	 */
+	size64_t size;
+
+	/* The index of the first chunk of the range
+	 */
+	uint64_t first_chunk_index;
+};
+
+typedef struct libvsapm_scan_worker libvsapm_scan_worker_t;
+typedef struct libvsapm_scan_job libvsapm_scan_job_t;
+
+struct libvsapm_scan_worker
+{
+	/* The scan job
+	 */
+	libvsapm_scan_job_t *scan_job;
+
+	/* The index of the worker
+	 */
+	int worker_index;
+
+	/* The file IO handle, a clone of the volume file IO handle
+	 * or NULL if the volume data is read from memory
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* Value to indicate if the file IO handle was opened by the worker
+	 */
+	uint8_t file_io_handle_opened;
+
+	/* The read buffer, reused for every chunk
+	 */
+	uint8_t *buffer;
+
+	/* The index of the first chunk that remains to be scanned by the worker
+	 */
+	uint64_t first_chunk_index;
+
+	/* The index of the chunk after the last chunk that remains to be scanned by the worker
+	 */
+	uint64_t last_chunk_index;
+
+	/* The result of the worker
+	 */
+	int result;
+
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	/* The mutex that protects the remaining chunks of the worker
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+struct libvsapm_scan_job
+{
+	/* The chunk size
+	 */
+	size_t chunk_size;
+
+	/* The ranges
+	 */
+	libvsapm_scan_range_t *ranges;
+
+	/* The number of ranges
+	 */
+	int number_of_ranges;
+
+	/* The number of allocated ranges
+	 */
+	int number_of_allocated_ranges;
+
+	/* The number of chunks
+	 */
+	uint64_t number_of_chunks;
+
+	/* The volume data if the volume was opened from memory or NULL otherwise
+	 */
+	const uint8_t *memory_data;
+
+	/* The size of the volume data in memory
+	 */
+	size64_t memory_data_size;
+
+	/* The workers
+	 */
+	libvsapm_scan_worker_t **workers;
+
+	/* The number of workers
+	 */
+	int number_of_workers;
+
+	/* The scan callback
+	 */
+	int (*callback)(
+	       int partition_index,
+	       off64_t offset,
+	       const uint8_t *data,
+	       size_t data_size,
+	       void *user_data );
+
+	/* The user data passed to the scan callback
+	 */
+	void *user_data;
+
+	/* Value to indicate the workers should stop
+	 */
+	int abort;
+};
+
+int libvsapm_scan_worker_initialize(
+     libvsapm_scan_worker_t **scan_worker,
+     libvsapm_scan_job_t *scan_job,
+     int worker_index,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libvsapm_scan_worker_free(
+     libvsapm_scan_worker_t **scan_worker,
+     libcerror_error_t **error );
+
+int libvsapm_scan_worker_get_next_chunk_index(
+     libvsapm_scan_worker_t *scan_worker,
+     uint64_t *chunk_index,
+     libcerror_error_t **error );
+
+int libvsapm_scan_worker_scan(
+     libvsapm_scan_worker_t *scan_worker,
+     libcerror_error_t **error );
+
+int libvsapm_scan_worker_scan_callback(
+     libvsapm_scan_worker_t *scan_worker,
+     void *arguments );
+
+int libvsapm_scan_job_initialize(
+     libvsapm_scan_job_t **scan_job,
+     size_t chunk_size,
+     int (*callback)(
+            int partition_index,
+            off64_t offset,
+            const uint8_t *data,
+            size_t data_size,
+            void *user_data ),
+     void *user_data,
+     libcerror_error_t **error );
+
+int libvsapm_scan_job_free(
+     libvsapm_scan_job_t **scan_job,
+     libcerror_error_t **error );
+
+int libvsapm_scan_job_append_range(
+     libvsapm_scan_job_t *scan_job,
+     int partition_index,
+     off64_t volume_offset,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error );
+
+int libvsapm_scan_job_get_chunk(
+     libvsapm_scan_job_t *scan_job,
+     uint64_t chunk_index,
+     int *partition_index,
+     off64_t *volume_offset,
+     off64_t *offset,
+     size_t *size,
+     libcerror_error_t **error );
+
+int libvsapm_scan_job_initialize_workers(
+     libvsapm_scan_job_t *scan_job,
+     int number_of_threads,
+     libbfio_handle_t *file_io_handle,
+     const uint8_t *memory_data,
+     size64_t memory_data_size,
+     libcerror_error_t **error );
+
+int libvsapm_scan_job_run(
+     libvsapm_scan_job_t *scan_job,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSAPM_SCAN_JOB_H ) */
+
@@ -0,0 +1,912 @@
+/*
+ * Partition map entry scanner functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( __AVX2__ )
+#include <immintrin.h>
+
+#define LIBVSAPM_SCANNER_NUMBER_OF_LANES	8
+
+#elif defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && ( _M_IX86_FP >= 2 ) )
+#include <emmintrin.h>
+
+#define LIBVSAPM_SCANNER_NUMBER_OF_LANES	8
+
+#endif
+
+#include "libvsapm_definitions.h"
+#include "libvsapm_libbfio.h"
+#include "libvsapm_libcdata.h"
+#include "libvsapm_libcerror.h"
+#include "libvsapm_libcnotify.h"
+#include "libvsapm_partition_map_entry.h"
+#include "libvsapm_scanner.h"
+#include "libvsapm_unused.h"
+
+#include "vsapm_partition_map_entry.h"
+
+/* The signatures as 16-bit little-endian values, used by the vector search
+ */
+#define LIBVSAPM_SCANNER_SIGNATURE_DRIVER_DESCRIPTOR	0x5245
+#define LIBVSAPM_SCANNER_SIGNATURE_PARTITION_MAP_ENTRY	0x4d50
+
+/* Creates a scanner
+ * Make sure the value scanner is referencing, is set to NULL
+ * If clone_file_io_handle is set the scanner reads from its own clone of the file IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_scanner_initialize(
+     libvsapm_scanner_t **scanner,
+     libbfio_handle_t *file_io_handle,
+     uint8_t clone_file_io_handle,
+     size64_t data_size,
+     off64_t range_start_offset,
+     off64_t range_end_offset,
+     libcerror_error_t **error )
+{
+	static char *function       = "libvsapm_scanner_initialize";
+	size64_t range_size         = 0;
+	int file_io_handle_is_open  = 0;
+
+	if( scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( *scanner != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid scanner value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( range_start_offset < 0 )
+	 || ( ( range_start_offset % 512 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid range start offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( range_end_offset < range_start_offset )
+	 || ( (size64_t) range_end_offset > data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid range end offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*scanner = memory_allocate_structure(
+	            libvsapm_scanner_t );
+
+	if( *scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create scanner.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *scanner,
+	     0,
+	     sizeof( libvsapm_scanner_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear scanner.",
+		 function );
+
+		memory_free(
+		 *scanner );
+
+		*scanner = NULL;
+
+		return( -1 );
+	}
+	if( libcdata_array_initialize(
+	     &( ( *scanner )->partition_map_entries ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create partition map entries array.",
+		 function );
+
+		goto on_error;
+	}
+	range_size = (size64_t) ( range_end_offset - range_start_offset );
+
+	if( range_size > (size64_t) LIBVSAPM_SCANNER_BUFFER_SIZE )
+	{
+		( *scanner )->buffer_size = LIBVSAPM_SCANNER_BUFFER_SIZE;
+	}
+	else
+	{
+		( *scanner )->buffer_size = (size_t) range_size;
+	}
+	if( ( *scanner )->buffer_size > 0 )
+	{
+		( *scanner )->buffer = (uint8_t *) memory_allocate(
+		                                    sizeof( uint8_t ) * ( *scanner )->buffer_size );
+
+		if( ( *scanner )->buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create buffer.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( clone_file_io_handle != 0 )
+	{
+		if( libbfio_handle_clone(
+		     &( ( *scanner )->file_io_handle ),
+		     file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to clone file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+		( *scanner )->file_io_handle_cloned = 1;
+
+		file_io_handle_is_open = libbfio_handle_is_open(
+		                          ( *scanner )->file_io_handle,
+		                          error );
+
+		if( file_io_handle_is_open == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if file IO handle is open.",
+			 function );
+
+			goto on_error;
+		}
+		else if( file_io_handle_is_open == 0 )
+		{
+			if( libbfio_handle_open(
+			     ( *scanner )->file_io_handle,
+			     LIBBFIO_OPEN_READ,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to open file IO handle.",
+				 function );
+
+				goto on_error;
+			}
+			( *scanner )->file_io_handle_opened = 1;
+		}
+	}
+	else
+	{
+		( *scanner )->file_io_handle = file_io_handle;
+	}
+	( *scanner )->data_size          = data_size;
+	( *scanner )->range_start_offset = range_start_offset;
+	( *scanner )->range_end_offset   = range_end_offset;
+	( *scanner )->result             = 1;
+
+	return( 1 );
+
+on_error:
+	if( *scanner != NULL )
+	{
+		libvsapm_scanner_free(
+		 scanner,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a scanner
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_scanner_free(
+     libvsapm_scanner_t **scanner,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_scanner_free";
+	int result            = 1;
+
+	if( scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( *scanner != NULL )
+	{
+		if( ( *scanner )->file_io_handle_opened != 0 )
+		{
+			if( libbfio_handle_close(
+			     ( *scanner )->file_io_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close file IO handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *scanner )->file_io_handle_cloned != 0 )
+		{
+			if( libbfio_handle_free(
+			     &( ( *scanner )->file_io_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file IO handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *scanner )->partition_map_entries != NULL )
+		{
+			if( libcdata_array_free(
+			     &( ( *scanner )->partition_map_entries ),
+			     (int (*)(intptr_t **, libcerror_error_t **)) &libvsapm_partition_map_entry_free,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free partition map entries array.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *scanner )->buffer != NULL )
+		{
+			memory_free(
+			 ( *scanner )->buffer );
+		}
+		memory_free(
+		 *scanner );
+
+		*scanner = NULL;
+	}
+	return( result );
+}
+
+/* Searches data for a driver descriptor or partition map entry signature at a 512-byte boundary
+ * The data offset must be a multiple of 512 and is set to the offset of the signature if found.
+ * When the compiler targets AVX2 or SSE2 the signatures of 8 sectors are compared at a time,
+ * otherwise the sectors are compared one at a time
+ * Returns 1 if a signature was found, 0 if not or -1 on error
+ */
+int libvsapm_scanner_find_signature(
+     const uint8_t *data,
+     size_t data_size,
+     size_t *data_offset,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_scanner_find_signature";
+	size_t safe_offset    = 0;
+
+#if defined( __AVX2__ )
+	__m256i driver_descriptor_vector;
+	__m256i indexes_vector;
+	__m256i mask_vector;
+	__m256i matches_vector;
+	__m256i partition_map_entry_vector;
+	__m256i signatures_vector;
+#elif defined( LIBVSAPM_SCANNER_NUMBER_OF_LANES )
+	__m128i driver_descriptor_vector;
+	__m128i matches_vector;
+	__m128i partition_map_entry_vector;
+	__m128i signatures_vector;
+#endif
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( *data_offset % 512 ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	safe_offset = *data_offset;
+
+#if defined( __AVX2__ )
+	driver_descriptor_vector   = _mm256_set1_epi32( LIBVSAPM_SCANNER_SIGNATURE_DRIVER_DESCRIPTOR );
+	partition_map_entry_vector = _mm256_set1_epi32( LIBVSAPM_SCANNER_SIGNATURE_PARTITION_MAP_ENTRY );
+	mask_vector                = _mm256_set1_epi32( 0x0000ffff );
+	indexes_vector             = _mm256_setr_epi32( 0, 512, 1024, 1536, 2048, 2560, 3072, 3584 );
+
+	while( ( safe_offset + ( LIBVSAPM_SCANNER_NUMBER_OF_LANES * 512 ) ) <= data_size )
+	{
+		signatures_vector = _mm256_and_si256(
+		                     _mm256_i32gather_epi32(
+		                      (const int *) &( data[ safe_offset ] ),
+		                      indexes_vector,
+		                      1 ),
+		                     mask_vector );
+
+		matches_vector = _mm256_or_si256(
+		                  _mm256_cmpeq_epi32(
+		                   signatures_vector,
+		                   driver_descriptor_vector ),
+		                  _mm256_cmpeq_epi32(
+		                   signatures_vector,
+		                   partition_map_entry_vector ) );
+
+		if( _mm256_testz_si256(
+		     matches_vector,
+		     matches_vector ) == 0 )
+		{
+			break;
+		}
+		safe_offset += LIBVSAPM_SCANNER_NUMBER_OF_LANES * 512;
+	}
+#elif defined( LIBVSAPM_SCANNER_NUMBER_OF_LANES )
+	driver_descriptor_vector   = _mm_set1_epi16( (short) LIBVSAPM_SCANNER_SIGNATURE_DRIVER_DESCRIPTOR );
+	partition_map_entry_vector = _mm_set1_epi16( (short) LIBVSAPM_SCANNER_SIGNATURE_PARTITION_MAP_ENTRY );
+
+	while( ( safe_offset + ( LIBVSAPM_SCANNER_NUMBER_OF_LANES * 512 ) ) <= data_size )
+	{
+		signatures_vector = _mm_set_epi16(
+		                     *( (const short *) &( data[ safe_offset + 3584 ] ) ),
+		                     *( (const short *) &( data[ safe_offset + 3072 ] ) ),
+		                     *( (const short *) &( data[ safe_offset + 2560 ] ) ),
+		                     *( (const short *) &( data[ safe_offset + 2048 ] ) ),
+		                     *( (const short *) &( data[ safe_offset + 1536 ] ) ),
+		                     *( (const short *) &( data[ safe_offset + 1024 ] ) ),
+		                     *( (const short *) &( data[ safe_offset + 512 ] ) ),
+		                     *( (const short *) &( data[ safe_offset ] ) ) );
+
+		matches_vector = _mm_or_si128(
+		                  _mm_cmpeq_epi16(
+		                   signatures_vector,
+		                   driver_descriptor_vector ),
+		                  _mm_cmpeq_epi16(
+		                   signatures_vector,
+		                   partition_map_entry_vector ) );
+
+		if( _mm_movemask_epi8(
+		     matches_vector ) != 0 )
+		{
+			break;
+		}
+		safe_offset += LIBVSAPM_SCANNER_NUMBER_OF_LANES * 512;
+	}
+#endif /* defined( __AVX2__ ) */
+
+	/* Determine the exact sector of a vector match and check the remaining sectors
+	 */
+	while( ( safe_offset + 2 ) <= data_size )
+	{
+		if( ( ( data[ safe_offset ] == (uint8_t) 'P' )
+		  &&  ( data[ safe_offset + 1 ] == (uint8_t) 'M' ) )
+		 || ( ( data[ safe_offset ] == (uint8_t) 'E' )
+		  &&  ( data[ safe_offset + 1 ] == (uint8_t) 'R' ) ) )
+		{
+			*data_offset = safe_offset;
+
+			return( 1 );
+		}
+		safe_offset += 512;
+	}
+	*data_offset = safe_offset;
+
+	return( 0 );
+}
+
+/* Checks if data contains a plausible partition map entry and if so adds it to the scanner
+ * Returns 1 if the partition map entry was added, 0 if not or -1 on error
+ */
+int libvsapm_scanner_check_partition_map_entry(
+     libvsapm_scanner_t *scanner,
+     const uint8_t *data,
+     size_t data_size,
+     off64_t file_offset,
+     libcerror_error_t **error )
+{
+	libvsapm_partition_map_entry_t *partition_map_entry = NULL;
+	static char *function                               = "libvsapm_scanner_check_partition_map_entry";
+	uint64_t maximum_number_of_sectors                  = 0;
+	size_t type_index                                   = 0;
+	int entry_index                                     = 0;
+
+	if( scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size < sizeof( vsapm_partition_map_entry_t ) )
+	{
+		return( 0 );
+	}
+	if( ( data[ 0 ] != (uint8_t) 'P' )
+	 || ( data[ 1 ] != (uint8_t) 'M' ) )
+	{
+		return( 0 );
+	}
+	if( libvsapm_partition_map_entry_initialize(
+	     &partition_map_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create partition map entry.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvsapm_partition_map_entry_read_data(
+	     partition_map_entry,
+	     data,
+	     sizeof( vsapm_partition_map_entry_t ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read partition map entry at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 file_offset,
+		 file_offset );
+
+		goto on_error;
+	}
+	/* The sector values are checked against 512-byte sectors, the smallest supported sector size
+	 */
+	maximum_number_of_sectors = scanner->data_size / 512;
+
+	if( ( partition_map_entry->number_of_entries == 0 )
+	 || ( (uint64_t) partition_map_entry->number_of_entries >= maximum_number_of_sectors )
+	 || ( partition_map_entry->number_of_sectors == 0 )
+	 || ( ( (uint64_t) partition_map_entry->sector_number + partition_map_entry->number_of_sectors ) > maximum_number_of_sectors )
+	 || ( partition_map_entry->type[ 0 ] == 0 ) )
+	{
+		goto on_implausible;
+	}
+	for( type_index = 0;
+	     type_index < 32;
+	     type_index++ )
+	{
+		if( partition_map_entry->type[ type_index ] == 0 )
+		{
+			break;
+		}
+		if( ( partition_map_entry->type[ type_index ] < 0x20 )
+		 || ( partition_map_entry->type[ type_index ] > 0x7e ) )
+		{
+			goto on_implausible;
+		}
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: found partition map entry at offset: %" PRIi64 " (0x%08" PRIx64 ").\n",
+		 function,
+		 file_offset,
+		 file_offset );
+	}
+#endif
+	if( libcdata_array_append_entry(
+	     scanner->partition_map_entries,
+	     &entry_index,
+	     (intptr_t *) partition_map_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append partition map entry to array.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_implausible:
+	if( libvsapm_partition_map_entry_free(
+	     &partition_map_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free partition map entry.",
+		 function );
+
+		goto on_error;
+	}
+	return( 0 );
+
+on_error:
+	if( partition_map_entry != NULL )
+	{
+		libvsapm_partition_map_entry_free(
+		 &partition_map_entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Checks if data contains a plausible driver descriptor and if so stores its block size in the scanner
+ * Returns 1 if the driver descriptor is plausible, 0 if not or -1 on error
+ */
+int libvsapm_scanner_check_driver_descriptor(
+     libvsapm_scanner_t *scanner,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_scanner_check_driver_descriptor";
+	uint32_t block_count  = 0;
+	uint16_t block_size   = 0;
+
+	if( scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size < 8 )
+	{
+		return( 0 );
+	}
+	if( ( data[ 0 ] != (uint8_t) 'E' )
+	 || ( data[ 1 ] != (uint8_t) 'R' ) )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint16_big_endian(
+	 &( data[ 2 ] ),
+	 block_size );
+
+	byte_stream_copy_to_uint32_big_endian(
+	 &( data[ 4 ] ),
+	 block_count );
+
+	if( ( block_size != 512 )
+	 && ( block_size != 1024 )
+	 && ( block_size != 2048 )
+	 && ( block_size != 4096 ) )
+	{
+		return( 0 );
+	}
+	if( ( block_count == 0 )
+	 || ( ( (uint64_t) block_count * block_size ) > ( scanner->data_size + block_size ) ) )
+	{
+		return( 0 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: found driver descriptor with block size: %" PRIu16 " and block count: %" PRIu32 ".\n",
+		 function,
+		 block_size,
+		 block_count );
+	}
+#endif
+	scanner->driver_descriptor_block_size = block_size;
+
+	return( 1 );
+}
+
+/* Scans the range of the scanner for a driver descriptor and partition map entries
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_scanner_scan_range(
+     libvsapm_scanner_t *scanner,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_scanner_scan_range";
+	size_t data_offset    = 0;
+	size_t read_size      = 0;
+	ssize_t read_count    = 0;
+	off64_t file_offset   = 0;
+	int result            = 0;
+
+	if( scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scanner.",
+		 function );
+
+		return( -1 );
+	}
+	file_offset = scanner->range_start_offset;
+
+	while( file_offset < scanner->range_end_offset )
+	{
+		read_size = scanner->buffer_size;
+
+		if( (size64_t) read_size > (size64_t) ( scanner->range_end_offset - file_offset ) )
+		{
+			read_size = (size_t) ( scanner->range_end_offset - file_offset );
+		}
+		read_count = libbfio_handle_read_buffer_at_offset(
+		              scanner->file_io_handle,
+		              scanner->buffer,
+		              read_size,
+		              file_offset,
+		              error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 file_offset,
+			 file_offset );
+
+			return( -1 );
+		}
+		data_offset = 0;
+
+		do
+		{
+			result = libvsapm_scanner_find_signature(
+			          scanner->buffer,
+			          read_size,
+			          &data_offset,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to find signature in data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 file_offset,
+				 file_offset );
+
+				return( -1 );
+			}
+			else if( result != 0 )
+			{
+				if( scanner->buffer[ data_offset ] == (uint8_t) 'P' )
+				{
+					result = libvsapm_scanner_check_partition_map_entry(
+					          scanner,
+					          &( scanner->buffer[ data_offset ] ),
+					          read_size - data_offset,
+					          file_offset + (off64_t) data_offset,
+					          error );
+				}
+				else if( ( file_offset + (off64_t) data_offset ) == 0 )
+				{
+					result = libvsapm_scanner_check_driver_descriptor(
+					          scanner,
+					          &( scanner->buffer[ data_offset ] ),
+					          read_size - data_offset,
+					          error );
+				}
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GENERIC,
+					 "%s: unable to check candidate at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+					 function,
+					 file_offset + (off64_t) data_offset,
+					 file_offset + (off64_t) data_offset );
+
+					return( -1 );
+				}
+				data_offset += 512;
+
+				result = 1;
+			}
+		}
+		while( result != 0 );
+
+		file_offset += (off64_t) read_size;
+	}
+	return( 1 );
+}
+
+/* Scans the range of the scanner from a thread pool
+ * Any error is stored as the result of the scanner
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_scanner_scan_range_callback(
+     libvsapm_scanner_t *scanner,
+     void *arguments LIBVSAPM_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+
+	LIBVSAPM_UNREFERENCED_PARAMETER( arguments )
+
+	if( scanner == NULL )
+	{
+		return( -1 );
+	}
+	scanner->result = libvsapm_scanner_scan_range(
+	                   scanner,
+	                   &error );
+
+	if( scanner->result != 1 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( scanner->result );
+}
+
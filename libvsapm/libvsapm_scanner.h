@@ -0,0 +1,130 @@
+/*
+ * Partition map entry scanner functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVSAPM_SCANNER_H )
+#define _LIBVSAPM_SCANNER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvsapm_libbfio.h"
+#include "libvsapm_libcdata.h"
+#include "libvsapm_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvsapm_scanner libvsapm_scanner_t;
+
+struct libvsapm_scanner
+{
+	/* The file IO handle
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* Value to indicate if the file IO handle was cloned by the scanner
+	 */
+	uint8_t file_io_handle_cloned;
+
+	/* Value to indicate if the file IO handle was opened by the scanner
+	 */
+	uint8_t file_io_handle_opened;
+
+	/* The size of the data that is scanned
+	 */
+	size64_t data_size;
+
+	/* The offset of the start of the range to scan
+	 */
+	off64_t range_start_offset;
+
+	/* The offset of the end of the range to scan
+	 */
+	off64_t range_end_offset;
+
+	/* The read buffer
+	 */
+	uint8_t *buffer;
+
+	/* The read buffer size
+	 */
+	size_t buffer_size;
+
+	/* The partition map entries found in the range
+	 */
+	libcdata_array_t *partition_map_entries;
+
+	/* The block size of the driver descriptor at offset 0 or 0 if not found
+	 */
+	uint16_t driver_descriptor_block_size;
+
+	/* The result of the scan
+	 */
+	int result;
+};
+
+int libvsapm_scanner_initialize(
+     libvsapm_scanner_t **scanner,
+     libbfio_handle_t *file_io_handle,
+     uint8_t clone_file_io_handle,
+     size64_t data_size,
+     off64_t range_start_offset,
+     off64_t range_end_offset,
+     libcerror_error_t **error );
+
+int libvsapm_scanner_free(
+     libvsapm_scanner_t **scanner,
+     libcerror_error_t **error );
+
+int libvsapm_scanner_find_signature(
+     const uint8_t *data,
+     size_t data_size,
+     size_t *data_offset,
+     libcerror_error_t **error );
+
+int libvsapm_scanner_check_partition_map_entry(
+     libvsapm_scanner_t *scanner,
+     const uint8_t *data,
+     size_t data_size,
+     off64_t file_offset,
+     libcerror_error_t **error );
+
+int libvsapm_scanner_check_driver_descriptor(
+     libvsapm_scanner_t *scanner,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libvsapm_scanner_scan_range(
+     libvsapm_scanner_t *scanner,
+     libcerror_error_t **error );
+
+int libvsapm_scanner_scan_range_callback(
+     libvsapm_scanner_t *scanner,
+     void *arguments );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSAPM_SCANNER_H ) */
+
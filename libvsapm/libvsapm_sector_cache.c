@@ -0,0 +1,1183 @@
+/*
+ * Shared sector cache functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H )
+#include <stdlib.h>
+#endif
+
+#include "libvsapm_definitions.h"
+#include "libvsapm_direct_io.h"
+#include "libvsapm_libbfio.h"
+#include "libvsapm_libcerror.h"
+#include "libvsapm_libcnotify.h"
+#include "libvsapm_libcthreads.h"
+#include "libvsapm_sector_cache.h"
+#include "libvsapm_sector_cache_arena.h"
+
+/* Creates a sector cache
+ * Make sure the value sector_cache is referencing, is set to NULL
+ * The number of slots must be a power of 2 within the minimum and maximum number of slots
+ * The sector cache is created with a reference count of 1
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_sector_cache_initialize(
+     libvsapm_sector_cache_t **sector_cache,
+     off64_t partition_offset,
+     size64_t partition_size,
+     int number_of_slots,
+     libvsapm_sector_cache_arena_t *arena,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_sector_cache_initialize";
+
+	if( sector_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *sector_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid sector cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( partition_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid partition offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_slots < LIBVSAPM_SECTOR_CACHE_MINIMUM_NUMBER_OF_SLOTS )
+	 || ( number_of_slots > LIBVSAPM_SECTOR_CACHE_MAXIMUM_NUMBER_OF_SLOTS )
+	 || ( ( number_of_slots & ( number_of_slots - 1 ) ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of slots value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*sector_cache = memory_allocate_structure(
+	                 libvsapm_sector_cache_t );
+
+	if( *sector_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create sector cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *sector_cache,
+	     0,
+	     sizeof( libvsapm_sector_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear sector cache.",
+		 function );
+
+		memory_free(
+		 *sector_cache );
+
+		*sector_cache = NULL;
+
+		return( -1 );
+	}
+	( *sector_cache )->partition_offset = partition_offset;
+	( *sector_cache )->partition_size   = partition_size;
+	( *sector_cache )->number_of_slots  = number_of_slots;
+
+	( *sector_cache )->slots = (libvsapm_sector_cache_slot_t *) memory_allocate(
+	                                                             sizeof( libvsapm_sector_cache_slot_t ) * ( *sector_cache )->number_of_slots );
+
+	if( ( *sector_cache )->slots == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create slots.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *sector_cache )->slots,
+	     0,
+	     sizeof( libvsapm_sector_cache_slot_t ) * ( *sector_cache )->number_of_slots ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear slots.",
+		 function );
+
+		goto on_error;
+	}
+
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *sector_cache )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( arena != NULL )
+	{
+		if( libvsapm_sector_cache_arena_acquire(
+		     arena,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to acquire arena.",
+			 function );
+
+			goto on_error;
+		}
+		( *sector_cache )->arena = arena;
+	}
+	( *sector_cache )->reference_count = 1;
+
+	return( 1 );
+
+on_error:
+	if( *sector_cache != NULL )
+	{
+		libvsapm_sector_cache_free(
+		 sector_cache,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a sector cache
+ * The sector cache is freed regardless of its reference count, use release to drop a reference
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_sector_cache_free(
+     libvsapm_sector_cache_t **sector_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_sector_cache_free";
+	int result            = 1;
+
+	if( sector_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *sector_cache != NULL )
+	{
+		if( ( *sector_cache )->blocks_data != NULL )
+		{
+			if( ( *sector_cache )->blocks_data_in_arena != 0 )
+			{
+				if( libvsapm_sector_cache_arena_free_region(
+				     ( *sector_cache )->arena,
+				     ( *sector_cache )->blocks_data,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free blocks data region of arena.",
+					 function );
+
+					result = -1;
+				}
+			}
+			else
+			{
+				memory_free(
+				 ( *sector_cache )->blocks_data );
+			}
+		}
+		if( ( *sector_cache )->arena != NULL )
+		{
+			if( libvsapm_sector_cache_arena_release(
+			     &( ( *sector_cache )->arena ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to release arena.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *sector_cache )->slots != NULL )
+		{
+			memory_free(
+			 ( *sector_cache )->slots );
+		}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+		if( ( *sector_cache )->mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *sector_cache )->mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
+		memory_free(
+		 *sector_cache );
+
+		*sector_cache = NULL;
+	}
+	return( result );
+}
+
+/* Acquires a reference to a sector cache
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_sector_cache_acquire(
+     libvsapm_sector_cache_t *sector_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_sector_cache_acquire";
+	int result            = 1;
+
+	if( sector_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector cache.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     sector_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( sector_cache->reference_count <= 0 )
+	 || ( sector_cache->reference_count == INT_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid sector cache - reference count value out of bounds.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		sector_cache->reference_count += 1;
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     sector_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Releases a reference to a sector cache
+ * The sector cache is freed when the last reference is released
+ * The value sector_cache is referencing is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_sector_cache_release(
+     libvsapm_sector_cache_t **sector_cache,
+     libcerror_error_t **error )
+{
+	libvsapm_sector_cache_t *safe_sector_cache = NULL;
+	static char *function                      = "libvsapm_sector_cache_release";
+	int reference_count                        = 0;
+
+	if( sector_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *sector_cache == NULL )
+	{
+		return( 1 );
+	}
+	safe_sector_cache = *sector_cache;
+	*sector_cache     = NULL;
+
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     safe_sector_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( safe_sector_cache->reference_count > 0 )
+	{
+		safe_sector_cache->reference_count -= 1;
+	}
+	reference_count = safe_sector_cache->reference_count;
+
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     safe_sector_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( reference_count == 0 )
+	{
+		if( libvsapm_sector_cache_free(
+		     &safe_sector_cache,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free sector cache.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Allocates the blocks data
+ * When an arena is used the blocks data is allocated from a region of the arena,
+ * if no region is available the blocks data is allocated from normal memory instead
+ * that is aligned to the direct IO alignment
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_sector_cache_allocate_blocks_data(
+     libvsapm_sector_cache_t *sector_cache,
+     libcerror_error_t **error )
+{
+	static char *function   = "libvsapm_sector_cache_allocate_blocks_data";
+	size_t blocks_data_size = 0;
+	int result              = 0;
+
+	if( sector_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( sector_cache->blocks_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid sector cache - blocks data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	blocks_data_size = (size_t) sector_cache->number_of_slots << LIBVSAPM_SECTOR_CACHE_BLOCK_SIZE_SHIFT;
+
+	if( ( sector_cache->arena != NULL )
+	 && ( blocks_data_size == sector_cache->arena->region_size ) )
+	{
+		result = libvsapm_sector_cache_arena_allocate_region(
+		          sector_cache->arena,
+		          &( sector_cache->blocks_data ),
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to allocate blocks data region of arena.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			sector_cache->blocks_data_size     = blocks_data_size;
+			sector_cache->blocks_data_in_arena = 1;
+
+			return( 1 );
+		}
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: no region of arena available falling back to normal memory.\n",
+			 function );
+		}
+#endif
+	}
+#if defined( HAVE_LIBVSAPM_DIRECT_IO )
+	if( posix_memalign(
+	     (void **) &( sector_cache->blocks_data ),
+	     LIBVSAPM_DIRECT_IO_ALIGNMENT,
+	     sizeof( uint8_t ) * blocks_data_size ) != 0 )
+	{
+		sector_cache->blocks_data = NULL;
+	}
+#else
+	sector_cache->blocks_data = (uint8_t *) memory_allocate(
+	                                         sizeof( uint8_t ) * blocks_data_size );
+#endif
+	if( sector_cache->blocks_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create blocks data.",
+		 function );
+
+		return( -1 );
+	}
+	sector_cache->blocks_data_size     = blocks_data_size;
+	sector_cache->blocks_data_in_arena = 0;
+
+	return( 1 );
+}
+
+/* Retrieves the index of the slot of a block of the partition data
+ * This function must be called with the mutex held
+ * If the block is not cached the slot of the least recently used block is marked as loading
+ * for the block, the block should then be read using libvsapm_sector_cache_read_block
+ * without holding the mutex, since no other reader uses a slot that is loading
+ * Returns 1 if the block is cached, 0 if not or -1 on error
+ * The slot index is set to -1 if the block is not cached and no slot can be used,
+ * because the block is being read by another reader or all candidate slots are loading
+ */
+int libvsapm_sector_cache_get_slot_index(
+     libvsapm_sector_cache_t *sector_cache,
+     uint64_t block_index,
+     int *slot_index,
+     libcerror_error_t **error )
+{
+	libvsapm_sector_cache_slot_t *slot = NULL;
+	static char *function              = "libvsapm_sector_cache_get_slot_index";
+	int free_slot_index                = -1;
+	int least_recently_used_slot_index = -1;
+	int probe_distance                 = 0;
+	int safe_slot_index                = 0;
+
+	if( sector_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_index >= (uint64_t) ( ( sector_cache->partition_size + LIBVSAPM_SECTOR_CACHE_BLOCK_SIZE - 1 ) >> LIBVSAPM_SECTOR_CACHE_BLOCK_SIZE_SHIFT ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( slot_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid slot index.",
+		 function );
+
+		return( -1 );
+	}
+	sector_cache->access_counter += 1;
+
+	safe_slot_index = (int) ( block_index & (uint64_t) ( sector_cache->number_of_slots - 1 ) );
+
+	for( probe_distance = 0;
+	     probe_distance < LIBVSAPM_SECTOR_CACHE_MAXIMUM_PROBE_DISTANCE;
+	     probe_distance++ )
+	{
+		slot = &( sector_cache->slots[ safe_slot_index ] );
+
+		if( slot->is_loading != 0 )
+		{
+			if( slot->block_index == block_index )
+			{
+				*slot_index = -1;
+
+				return( 0 );
+			}
+		}
+		else if( slot->data_size == 0 )
+		{
+			if( free_slot_index == -1 )
+			{
+				free_slot_index = safe_slot_index;
+			}
+		}
+		else if( slot->block_index == block_index )
+		{
+			slot->last_access = sector_cache->access_counter;
+
+			*slot_index = safe_slot_index;
+
+			return( 1 );
+		}
+		else if( ( least_recently_used_slot_index == -1 )
+		      || ( slot->last_access < sector_cache->slots[ least_recently_used_slot_index ].last_access ) )
+		{
+			least_recently_used_slot_index = safe_slot_index;
+		}
+		safe_slot_index = ( safe_slot_index + 1 ) & ( sector_cache->number_of_slots - 1 );
+	}
+	if( free_slot_index != -1 )
+	{
+		safe_slot_index = free_slot_index;
+	}
+	else
+	{
+		safe_slot_index = least_recently_used_slot_index;
+	}
+	if( safe_slot_index == -1 )
+	{
+		*slot_index = -1;
+
+		return( 0 );
+	}
+	if( sector_cache->blocks_data == NULL )
+	{
+		if( libvsapm_sector_cache_allocate_blocks_data(
+		     sector_cache,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to allocate blocks data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	slot = &( sector_cache->slots[ safe_slot_index ] );
+
+	/* The slot is empty until the block was read successfully
+	 */
+	slot->block_index = block_index;
+	slot->data_size   = 0;
+	slot->is_loading  = 1;
+
+	*slot_index = safe_slot_index;
+
+	return( 0 );
+}
+
+/* Reads a block of the partition data into a slot that is marked as loading
+ * This function should be called without holding the mutex, the slot is not
+ * used by other readers until libvsapm_sector_cache_set_slot_loaded is called
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvsapm_sector_cache_read_block(
+         libvsapm_sector_cache_t *sector_cache,
+         libbfio_handle_t *file_io_handle,
+         int slot_index,
+         libcerror_error_t **error )
+{
+	libvsapm_sector_cache_slot_t *slot = NULL;
+	static char *function              = "libvsapm_sector_cache_read_block";
+	size64_t block_offset              = 0;
+	size_t read_size                   = 0;
+	ssize_t read_count                 = 0;
+
+	if( sector_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( sector_cache->blocks_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid sector cache - missing blocks data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( slot_index < 0 )
+	 || ( slot_index >= sector_cache->number_of_slots ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid slot index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	slot = &( sector_cache->slots[ slot_index ] );
+
+	if( slot->is_loading == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid slot: %d - not loading.",
+		 function,
+		 slot_index );
+
+		return( -1 );
+	}
+	block_offset = (size64_t) slot->block_index << LIBVSAPM_SECTOR_CACHE_BLOCK_SIZE_SHIFT;
+
+	read_size = LIBVSAPM_SECTOR_CACHE_BLOCK_SIZE;
+
+	if( (size64_t) read_size > ( sector_cache->partition_size - block_offset ) )
+	{
+		read_size = (size_t) ( sector_cache->partition_size - block_offset );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: reading block: %" PRIu64 " at offset: %" PRIi64 " (0x%08" PRIx64 ") into slot: %d\n",
+		 function,
+		 slot->block_index,
+		 sector_cache->partition_offset + (off64_t) block_offset,
+		 sector_cache->partition_offset + (off64_t) block_offset,
+		 slot_index );
+	}
+#endif
+	/* A block at the end of the volume can be smaller than the block size
+	 */
+#if defined( HAVE_LIBVSAPM_DIRECT_IO )
+	if( sector_cache->direct_io != NULL )
+	{
+		read_count = libvsapm_direct_io_read_buffer_at_offset(
+		              sector_cache->direct_io,
+		              &( sector_cache->blocks_data[ (size_t) slot_index << LIBVSAPM_SECTOR_CACHE_BLOCK_SIZE_SHIFT ] ),
+		              read_size,
+		              sector_cache->partition_offset + (off64_t) block_offset,
+		              error );
+	}
+	else
+#endif
+	{
+		read_count = libbfio_handle_read_buffer_at_offset(
+		              file_io_handle,
+		              &( sector_cache->blocks_data[ (size_t) slot_index << LIBVSAPM_SECTOR_CACHE_BLOCK_SIZE_SHIFT ] ),
+		              read_size,
+		              sector_cache->partition_offset + (off64_t) block_offset,
+		              error );
+	}
+
+	if( read_count <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read block: %" PRIu64 " at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 slot->block_index,
+		 sector_cache->partition_offset + (off64_t) block_offset,
+		 sector_cache->partition_offset + (off64_t) block_offset );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
+/* Marks a slot that is loading as loaded
+ * This function must be called with the mutex held
+ * A data size of 0 marks the slot as empty, which is used when reading the block failed
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_sector_cache_set_slot_loaded(
+     libvsapm_sector_cache_t *sector_cache,
+     int slot_index,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libvsapm_sector_cache_slot_t *slot = NULL;
+	static char *function              = "libvsapm_sector_cache_set_slot_loaded";
+
+	if( sector_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( slot_index < 0 )
+	 || ( slot_index >= sector_cache->number_of_slots ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid slot index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) LIBVSAPM_SECTOR_CACHE_BLOCK_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	slot = &( sector_cache->slots[ slot_index ] );
+
+	slot->data_size   = data_size;
+	slot->last_access = sector_cache->access_counter;
+	slot->is_loading  = 0;
+
+	return( 1 );
+}
+
+/* Reads data at a specific offset from the sector cache
+ * The offset is relative to the start of the partition, the blocks are read
+ * using the file IO handle when they are not cached
+ * The mutex is not held while a block is read, so that readers of cached blocks
+ * are not blocked by a read of another block. If a block is being read by another
+ * reader or no slot is available the data is read without caching it
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvsapm_sector_cache_read_buffer_at_offset(
+         libvsapm_sector_cache_t *sector_cache,
+         libbfio_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function    = "libvsapm_sector_cache_read_buffer_at_offset";
+	size_t block_data_offset = 0;
+	size_t block_data_size   = 0;
+	size_t buffer_offset     = 0;
+	size_t read_size         = 0;
+	ssize_t read_count       = 0;
+	uint64_t block_index     = 0;
+	int result               = 0;
+	int slot_index           = 0;
+
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	uint8_t mutex_is_held    = 0;
+#endif
+
+	if( sector_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_size > 0 )
+	{
+		if( (size64_t) offset >= sector_cache->partition_size )
+		{
+			break;
+		}
+		block_index       = (uint64_t) offset >> LIBVSAPM_SECTOR_CACHE_BLOCK_SIZE_SHIFT;
+		block_data_offset = (size_t) ( offset & ( LIBVSAPM_SECTOR_CACHE_BLOCK_SIZE - 1 ) );
+
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     sector_cache->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			goto on_error;
+		}
+		mutex_is_held = 1;
+#endif
+		result = libvsapm_sector_cache_get_slot_index(
+		          sector_cache,
+		          block_index,
+		          &slot_index,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve slot of block at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			goto on_error;
+		}
+		else if( ( result == 0 )
+		      && ( slot_index != -1 ) )
+		{
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+			if( libcthreads_mutex_release(
+			     sector_cache->mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release mutex.",
+				 function );
+
+				goto on_error;
+			}
+			mutex_is_held = 0;
+#endif
+			read_count = libvsapm_sector_cache_read_block(
+			              sector_cache,
+			              file_io_handle,
+			              slot_index,
+			              error );
+
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+			if( libcthreads_mutex_grab(
+			     sector_cache->mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to grab mutex.",
+				 function );
+
+				goto on_error;
+			}
+			mutex_is_held = 1;
+#endif
+			if( libvsapm_sector_cache_set_slot_loaded(
+			     sector_cache,
+			     slot_index,
+			     ( read_count > 0 ) ? (size_t) read_count : 0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set slot: %d loaded.",
+				 function,
+				 slot_index );
+
+				goto on_error;
+			}
+			if( read_count <= 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read block at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 offset,
+				 offset );
+
+				goto on_error;
+			}
+			result = 1;
+		}
+		if( result != 0 )
+		{
+			block_data_size = sector_cache->slots[ slot_index ].data_size;
+
+			if( block_data_offset >= block_data_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read data at offset: %" PRIi64 " (0x%08" PRIx64 ") - data exceeds volume.",
+				 function,
+				 offset,
+				 offset );
+
+				goto on_error;
+			}
+			read_size = block_data_size - block_data_offset;
+
+			if( buffer_size < read_size )
+			{
+				read_size = buffer_size;
+			}
+			/* The block data is copied while the mutex is held, since another reader can evict it
+			 */
+			if( memory_copy(
+			     &( buffer[ buffer_offset ] ),
+			     &( sector_cache->blocks_data[ ( (size_t) slot_index << LIBVSAPM_SECTOR_CACHE_BLOCK_SIZE_SHIFT ) + block_data_offset ] ),
+			     read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy block data.",
+				 function );
+
+				goto on_error;
+			}
+		}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     sector_cache->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			goto on_error;
+		}
+		mutex_is_held = 0;
+#endif
+		if( result == 0 )
+		{
+			read_size = LIBVSAPM_SECTOR_CACHE_BLOCK_SIZE - block_data_offset;
+
+			if( buffer_size < read_size )
+			{
+				read_size = buffer_size;
+			}
+			if( (size64_t) read_size > ( sector_cache->partition_size - offset ) )
+			{
+				read_size = (size_t) ( sector_cache->partition_size - offset );
+			}
+			read_count = libbfio_handle_read_buffer_at_offset(
+			              file_io_handle,
+			              &( buffer[ buffer_offset ] ),
+			              read_size,
+			              sector_cache->partition_offset + offset,
+			              error );
+
+			if( read_count != (ssize_t) read_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 offset,
+				 offset );
+
+				goto on_error;
+			}
+		}
+		offset        += read_size;
+		buffer_offset += read_size;
+		buffer_size   -= read_size;
+	}
+	return( (ssize_t) buffer_offset );
+
+on_error:
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( mutex_is_held != 0 )
+	{
+		libcthreads_mutex_release(
+		 sector_cache->mutex,
+		 NULL );
+	}
+#endif
+	return( -1 );
+}
@@ -0,0 +1,176 @@
+/*
+ * Shared sector cache functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVSAPM_SECTOR_CACHE_H )
+#define _LIBVSAPM_SECTOR_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvsapm_definitions.h"
+#include "libvsapm_direct_io.h"
+#include "libvsapm_libbfio.h"
+#include "libvsapm_libcerror.h"
+#include "libvsapm_libcthreads.h"
+#include "libvsapm_sector_cache_arena.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvsapm_sector_cache_slot libvsapm_sector_cache_slot_t;
+
+struct libvsapm_sector_cache_slot
+{
+	/* The index of the block stored in the slot
+	 */
+	uint64_t block_index;
+
+	/* The size of the block data or 0 if the slot is empty
+	 */
+	size_t data_size;
+
+	/* The value of the access counter when the slot was last used
+	 */
+	uint64_t last_access;
+
+	/* Value to indicate the block is being read into the slot
+	 */
+	uint8_t is_loading;
+};
+
+typedef struct libvsapm_sector_cache libvsapm_sector_cache_t;
+
+struct libvsapm_sector_cache
+{
+	/* The offset of the partition in the volume
+	 */
+	off64_t partition_offset;
+
+	/* The size of the partition
+	 */
+	size64_t partition_size;
+
+	/* The slots, indexed by the block index modulo the number of slots
+	 */
+	libvsapm_sector_cache_slot_t *slots;
+
+	/* The number of slots, which is a power of 2
+	 */
+	int number_of_slots;
+
+	/* The arena the blocks data is allocated from or NULL if not used
+	 */
+	libvsapm_sector_cache_arena_t *arena;
+
+#if defined( HAVE_LIBVSAPM_DIRECT_IO )
+	/* The direct IO used to read the blocks bypassing the page cache or NULL if not used
+	 * The direct IO is owned by the IO handle
+	 */
+	libvsapm_direct_io_t *direct_io;
+#endif
+
+	/* The blocks data, which contains a block for every slot
+	 * or NULL if no block was read yet
+	 * The blocks data is aligned so that blocks can be read with direct IO
+	 */
+	uint8_t *blocks_data;
+
+	/* The size of the blocks data
+	 */
+	size_t blocks_data_size;
+
+	/* Value to indicate the blocks data was allocated from the arena
+	 */
+	uint8_t blocks_data_in_arena;
+
+	/* The access counter
+	 */
+	uint64_t access_counter;
+
+	/* The number of references to the sector cache
+	 */
+	int reference_count;
+
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	/* The mutex that protects the slots, the blocks data and the reference count
+	 * The data of a slot that is loading is not protected by the mutex
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int libvsapm_sector_cache_initialize(
+     libvsapm_sector_cache_t **sector_cache,
+     off64_t partition_offset,
+     size64_t partition_size,
+     int number_of_slots,
+     libvsapm_sector_cache_arena_t *arena,
+     libcerror_error_t **error );
+
+int libvsapm_sector_cache_free(
+     libvsapm_sector_cache_t **sector_cache,
+     libcerror_error_t **error );
+
+int libvsapm_sector_cache_acquire(
+     libvsapm_sector_cache_t *sector_cache,
+     libcerror_error_t **error );
+
+int libvsapm_sector_cache_release(
+     libvsapm_sector_cache_t **sector_cache,
+     libcerror_error_t **error );
+
+int libvsapm_sector_cache_allocate_blocks_data(
+     libvsapm_sector_cache_t *sector_cache,
+     libcerror_error_t **error );
+
+int libvsapm_sector_cache_get_slot_index(
+     libvsapm_sector_cache_t *sector_cache,
+     uint64_t block_index,
+     int *slot_index,
+     libcerror_error_t **error );
+
+ssize_t libvsapm_sector_cache_read_block(
+         libvsapm_sector_cache_t *sector_cache,
+         libbfio_handle_t *file_io_handle,
+         int slot_index,
+         libcerror_error_t **error );
+
+int libvsapm_sector_cache_set_slot_loaded(
+     libvsapm_sector_cache_t *sector_cache,
+     int slot_index,
+     size_t data_size,
+     libcerror_error_t **error );
+
+ssize_t libvsapm_sector_cache_read_buffer_at_offset(
+         libvsapm_sector_cache_t *sector_cache,
+         libbfio_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSAPM_SECTOR_CACHE_H ) */
+
@@ -0,0 +1,708 @@
+/*
+ * Sector cache arena functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvsapm_definitions.h"
+#include "libvsapm_libcerror.h"
+#include "libvsapm_libcthreads.h"
+#include "libvsapm_sector_cache_arena.h"
+
+/* Creates a sector cache arena
+ * Make sure the value sector_cache_arena is referencing, is set to NULL
+ * The arena is shared by the sector caches of a volume and contains the requested number
+ * of regions, rounded up to a multiple of the huge page size and limited to the maximum
+ * arena size. It is first mapped with explicit huge pages and otherwise aligned to the
+ * huge page size so that transparent huge pages can back it
+ * The sector cache arena is created with a reference count of 1
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_sector_cache_arena_initialize(
+     libvsapm_sector_cache_arena_t **sector_cache_arena,
+     size_t region_size,
+     int number_of_regions,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_sector_cache_arena_initialize";
+
+#if defined( HAVE_LIBVSAPM_SECTOR_CACHE_ARENA_MMAP )
+	uint8_t *aligned_data = NULL;
+	uint8_t *mapped_data  = NULL;
+	size_t data_size      = 0;
+	size_t mapped_size    = 0;
+#endif
+
+	if( sector_cache_arena == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector cache arena.",
+		 function );
+
+		return( -1 );
+	}
+	if( *sector_cache_arena != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid sector cache arena value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( region_size == 0 )
+	 || ( region_size > (size_t) LIBVSAPM_SECTOR_CACHE_ARENA_MAXIMUM_SIZE )
+	 || ( ( region_size % LIBVSAPM_SECTOR_CACHE_BLOCK_SIZE ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid region size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_regions <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of regions value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( HAVE_LIBVSAPM_SECTOR_CACHE_ARENA_MMAP )
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: huge pages are not supported.",
+	 function );
+
+	return( -1 );
+#else
+	if( (size_t) number_of_regions > ( (size_t) LIBVSAPM_SECTOR_CACHE_ARENA_MAXIMUM_SIZE / region_size ) )
+	{
+		number_of_regions = (int) ( (size_t) LIBVSAPM_SECTOR_CACHE_ARENA_MAXIMUM_SIZE / region_size );
+	}
+	data_size = region_size * (size_t) number_of_regions;
+
+	if( ( data_size % LIBVSAPM_SECTOR_CACHE_HUGE_PAGE_SIZE ) != 0 )
+	{
+		data_size += LIBVSAPM_SECTOR_CACHE_HUGE_PAGE_SIZE - ( data_size % LIBVSAPM_SECTOR_CACHE_HUGE_PAGE_SIZE );
+	}
+	*sector_cache_arena = memory_allocate_structure(
+	                       libvsapm_sector_cache_arena_t );
+
+	if( *sector_cache_arena == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create sector cache arena.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *sector_cache_arena,
+	     0,
+	     sizeof( libvsapm_sector_cache_arena_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear sector cache arena.",
+		 function );
+
+		memory_free(
+		 *sector_cache_arena );
+
+		*sector_cache_arena = NULL;
+
+		return( -1 );
+	}
+	/* The regions that fit in the remainder of the last huge page are used as well
+	 */
+	( *sector_cache_arena )->data_size         = data_size;
+	( *sector_cache_arena )->region_size       = region_size;
+	( *sector_cache_arena )->number_of_regions = (int) ( data_size / region_size );
+
+	( *sector_cache_arena )->regions_in_use = (uint8_t *) memory_allocate(
+	                                                       sizeof( uint8_t ) * ( *sector_cache_arena )->number_of_regions );
+
+	if( ( *sector_cache_arena )->regions_in_use == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create regions in use.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *sector_cache_arena )->regions_in_use,
+	     0,
+	     sizeof( uint8_t ) * ( *sector_cache_arena )->number_of_regions ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear regions in use.",
+		 function );
+
+		goto on_error;
+	}
+
+#if defined( MAP_HUGETLB )
+	/* Explicit huge pages are only available when reserved by the system administrator
+	 */
+	mapped_data = (uint8_t *) mmap(
+	                           NULL,
+	                           ( *sector_cache_arena )->data_size,
+	                           PROT_READ | PROT_WRITE,
+	                           MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+	                           -1,
+	                           0 );
+
+	if( mapped_data != (uint8_t *) MAP_FAILED )
+	{
+		( *sector_cache_arena )->data = mapped_data;
+	}
+#endif /* defined( MAP_HUGETLB ) */
+
+	if( ( *sector_cache_arena )->data == NULL )
+	{
+		/* Otherwise map more than needed so that the arena can be aligned to the huge page size,
+		 * which is required for transparent huge pages to back it
+		 */
+		mapped_size = ( *sector_cache_arena )->data_size + LIBVSAPM_SECTOR_CACHE_HUGE_PAGE_SIZE;
+
+		mapped_data = (uint8_t *) mmap(
+		                           NULL,
+		                           mapped_size,
+		                           PROT_READ | PROT_WRITE,
+		                           MAP_PRIVATE | MAP_ANONYMOUS,
+		                           -1,
+		                           0 );
+
+		if( mapped_data == (uint8_t *) MAP_FAILED )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to map arena data.",
+			 function );
+
+			goto on_error;
+		}
+		aligned_data = (uint8_t *) ( ( (intptr_t) mapped_data + LIBVSAPM_SECTOR_CACHE_HUGE_PAGE_SIZE - 1 ) & ~( (intptr_t) LIBVSAPM_SECTOR_CACHE_HUGE_PAGE_SIZE - 1 ) );
+
+		if( aligned_data > mapped_data )
+		{
+			munmap(
+			 mapped_data,
+			 (size_t) ( aligned_data - mapped_data ) );
+		}
+		if( ( mapped_data + mapped_size ) > ( aligned_data + ( *sector_cache_arena )->data_size ) )
+		{
+			munmap(
+			 aligned_data + ( *sector_cache_arena )->data_size,
+			 (size_t) ( ( mapped_data + mapped_size ) - ( aligned_data + ( *sector_cache_arena )->data_size ) ) );
+		}
+#if defined( HAVE_MADVISE ) && defined( MADV_HUGEPAGE )
+		/* If transparent huge pages are disabled the arena is backed by normal pages
+		 */
+		madvise(
+		 aligned_data,
+		 ( *sector_cache_arena )->data_size,
+		 MADV_HUGEPAGE );
+#endif
+		( *sector_cache_arena )->data = aligned_data;
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *sector_cache_arena )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *sector_cache_arena )->reference_count = 1;
+
+	return( 1 );
+
+on_error:
+	if( *sector_cache_arena != NULL )
+	{
+		libvsapm_sector_cache_arena_free(
+		 sector_cache_arena,
+		 NULL );
+	}
+	return( -1 );
+
+#endif /* !defined( HAVE_LIBVSAPM_SECTOR_CACHE_ARENA_MMAP ) */
+}
+
+/* Frees a sector cache arena
+ * The sector cache arena is freed regardless of its reference count, use release to drop a reference
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_sector_cache_arena_free(
+     libvsapm_sector_cache_arena_t **sector_cache_arena,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_sector_cache_arena_free";
+	int result            = 1;
+
+	if( sector_cache_arena == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector cache arena.",
+		 function );
+
+		return( -1 );
+	}
+	if( *sector_cache_arena != NULL )
+	{
+#if defined( HAVE_LIBVSAPM_SECTOR_CACHE_ARENA_MMAP )
+		if( ( *sector_cache_arena )->data != NULL )
+		{
+			if( munmap(
+			     ( *sector_cache_arena )->data,
+			     ( *sector_cache_arena )->data_size ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to unmap arena data.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+		if( ( *sector_cache_arena )->mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *sector_cache_arena )->mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
+		if( ( *sector_cache_arena )->regions_in_use != NULL )
+		{
+			memory_free(
+			 ( *sector_cache_arena )->regions_in_use );
+		}
+		memory_free(
+		 *sector_cache_arena );
+
+		*sector_cache_arena = NULL;
+	}
+	return( result );
+}
+
+/* Acquires a reference to a sector cache arena
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_sector_cache_arena_acquire(
+     libvsapm_sector_cache_arena_t *sector_cache_arena,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_sector_cache_arena_acquire";
+	int result            = 1;
+
+	if( sector_cache_arena == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector cache arena.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     sector_cache_arena->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( sector_cache_arena->reference_count <= 0 )
+	 || ( sector_cache_arena->reference_count == INT_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid sector cache arena - reference count value out of bounds.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		sector_cache_arena->reference_count += 1;
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     sector_cache_arena->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Releases a reference to a sector cache arena
+ * The sector cache arena is freed when the last reference is released
+ * The value sector_cache_arena is referencing is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_sector_cache_arena_release(
+     libvsapm_sector_cache_arena_t **sector_cache_arena,
+     libcerror_error_t **error )
+{
+	libvsapm_sector_cache_arena_t *safe_sector_cache_arena = NULL;
+	static char *function                                  = "libvsapm_sector_cache_arena_release";
+	int reference_count                                    = 0;
+
+	if( sector_cache_arena == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector cache arena.",
+		 function );
+
+		return( -1 );
+	}
+	if( *sector_cache_arena == NULL )
+	{
+		return( 1 );
+	}
+	safe_sector_cache_arena = *sector_cache_arena;
+	*sector_cache_arena     = NULL;
+
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     safe_sector_cache_arena->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( safe_sector_cache_arena->reference_count > 0 )
+	{
+		safe_sector_cache_arena->reference_count -= 1;
+	}
+	reference_count = safe_sector_cache_arena->reference_count;
+
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     safe_sector_cache_arena->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( reference_count == 0 )
+	{
+		if( libvsapm_sector_cache_arena_free(
+		     &safe_sector_cache_arena,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free sector cache arena.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Allocates a region of the sector cache arena
+ * Returns 1 if successful, 0 if no region is available or -1 on error
+ */
+int libvsapm_sector_cache_arena_allocate_region(
+     libvsapm_sector_cache_arena_t *sector_cache_arena,
+     uint8_t **region_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_sector_cache_arena_allocate_region";
+	int region_index      = 0;
+	int result            = 0;
+
+	if( sector_cache_arena == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector cache arena.",
+		 function );
+
+		return( -1 );
+	}
+	if( region_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid region data.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     sector_cache_arena->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	for( region_index = 0;
+	     region_index < sector_cache_arena->number_of_regions;
+	     region_index++ )
+	{
+		if( sector_cache_arena->regions_in_use[ region_index ] == 0 )
+		{
+			sector_cache_arena->regions_in_use[ region_index ] = 1;
+
+			*region_data = &( sector_cache_arena->data[ (size_t) region_index * sector_cache_arena->region_size ] );
+
+			result = 1;
+
+			break;
+		}
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     sector_cache_arena->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Frees a region of the sector cache arena
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_sector_cache_arena_free_region(
+     libvsapm_sector_cache_arena_t *sector_cache_arena,
+     uint8_t *region_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_sector_cache_arena_free_region";
+	size_t region_offset  = 0;
+	int region_index      = 0;
+	int result            = 1;
+
+	if( sector_cache_arena == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector cache arena.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( region_data < sector_cache_arena->data )
+	 || ( region_data >= ( sector_cache_arena->data + sector_cache_arena->data_size ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid region data value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	region_offset = (size_t) ( region_data - sector_cache_arena->data );
+
+	if( ( region_offset % sector_cache_arena->region_size ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid region data value not aligned to region.",
+		 function );
+
+		return( -1 );
+	}
+	region_index = (int) ( region_offset / sector_cache_arena->region_size );
+
+	if( region_index >= sector_cache_arena->number_of_regions )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid region data value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     sector_cache_arena->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( sector_cache_arena->regions_in_use[ region_index ] == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid region - region not in use.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		sector_cache_arena->regions_in_use[ region_index ] = 0;
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     sector_cache_arena->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
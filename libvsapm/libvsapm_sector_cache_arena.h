@@ -0,0 +1,112 @@
+/*
+ * Sector cache arena functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVSAPM_SECTOR_CACHE_ARENA_H )
+#define _LIBVSAPM_SECTOR_CACHE_ARENA_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( HAVE_SYS_MMAN_H )
+#include <sys/mman.h>
+#endif
+
+#include "libvsapm_definitions.h"
+#include "libvsapm_libcerror.h"
+#include "libvsapm_libcthreads.h"
+
+#if defined( HAVE_MMAP ) && defined( HAVE_MUNMAP ) && defined( MAP_ANONYMOUS )
+#define HAVE_LIBVSAPM_SECTOR_CACHE_ARENA_MMAP
+#endif
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvsapm_sector_cache_arena libvsapm_sector_cache_arena_t;
+
+struct libvsapm_sector_cache_arena
+{
+	/* The arena data, a multiple of the huge page size that is divided in regions
+	 */
+	uint8_t *data;
+
+	/* The size of the arena data
+	 */
+	size_t data_size;
+
+	/* The size of a region, which contains the blocks data of a sector cache
+	 */
+	size_t region_size;
+
+	/* The number of regions
+	 */
+	int number_of_regions;
+
+	/* The regions in use, a value per region that is non-zero if the region is in use
+	 */
+	uint8_t *regions_in_use;
+
+	/* The number of references to the arena
+	 */
+	int reference_count;
+
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	/* The mutex that protects the regions in use and the reference count
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int libvsapm_sector_cache_arena_initialize(
+     libvsapm_sector_cache_arena_t **sector_cache_arena,
+     size_t region_size,
+     int number_of_regions,
+     libcerror_error_t **error );
+
+int libvsapm_sector_cache_arena_free(
+     libvsapm_sector_cache_arena_t **sector_cache_arena,
+     libcerror_error_t **error );
+
+int libvsapm_sector_cache_arena_acquire(
+     libvsapm_sector_cache_arena_t *sector_cache_arena,
+     libcerror_error_t **error );
+
+int libvsapm_sector_cache_arena_release(
+     libvsapm_sector_cache_arena_t **sector_cache_arena,
+     libcerror_error_t **error );
+
+int libvsapm_sector_cache_arena_allocate_region(
+     libvsapm_sector_cache_arena_t *sector_cache_arena,
+     uint8_t **region_data,
+     libcerror_error_t **error );
+
+int libvsapm_sector_cache_arena_free_region(
+     libvsapm_sector_cache_arena_t *sector_cache_arena,
+     uint8_t *region_data,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSAPM_SECTOR_CACHE_ARENA_H ) */
+
@@ -27,14 +27,28 @@
 
 #include "libvsapm_debug.h"
 #include "libvsapm_definitions.h"
+#include "libvsapm_direct_io.h"
 #include "libvsapm_volume.h"
 #include "libvsapm_io_handle.h"
+#include "libvsapm_io_uring.h"
 #include "libvsapm_libbfio.h"
+#include "libvsapm_libcdata.h"
 #include "libvsapm_libcerror.h"
 #include "libvsapm_libcnotify.h"
+#include "libvsapm_libcthreads.h"
 #include "libvsapm_partition.h"
+#include "libvsapm_partition_index.h"
 #include "libvsapm_partition_map_entry.h"
+#include "libvsapm_partition_map_entry_batch.h"
+#include "libvsapm_pool_file_io_handle.h"
+#include "libvsapm_read_queue.h"
+#include "libvsapm_scan_job.h"
+#include "libvsapm_scanner.h"
+#include "libvsapm_sector_cache_arena.h"
 #include "libvsapm_types.h"
+#include "libvsapm_volume_snapshot.h"
+
+#include "vsapm_partition_map_entry.h"
 
 /* Creates a volume
  * Make sure the value volume is referencing, is set to NULL
@@ -113,6 +127,10 @@ int libvsapm_volume_initialize(
 
 		goto on_error;
 	}
+	internal_volume->maximum_number_of_partition_map_entries = LIBVSAPM_DEFAULT_MAXIMUM_NUMBER_OF_PARTITION_MAP_ENTRIES;
+	internal_volume->maximum_partition_map_size              = LIBVSAPM_DEFAULT_MAXIMUM_PARTITION_MAP_SIZE;
+	internal_volume->maximum_number_of_open_handles          = LIBVSAPM_DEFAULT_MAXIMUM_NUMBER_OF_OPEN_HANDLES;
+
 	if( libcdata_array_initialize(
 	     &( internal_volume->partitions ),
 	     0,
@@ -127,6 +145,20 @@ int libvsapm_volume_initialize(
 
 		goto on_error;
 	}
+	if( libcdata_array_initialize(
+	     &( internal_volume->unallocated_ranges ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create unallocated ranges array.",
+		 function );
+
+		goto on_error;
+	}
 #if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_initialize(
 	     &( internal_volume->read_write_lock ),
@@ -149,6 +181,20 @@ int libvsapm_volume_initialize(
 on_error:
 	if( internal_volume != NULL )
 	{
+		if( internal_volume->unallocated_ranges != NULL )
+		{
+			libcdata_array_free(
+			 &( internal_volume->unallocated_ranges ),
+			 NULL,
+			 NULL );
+		}
+		if( internal_volume->partitions != NULL )
+		{
+			libcdata_array_free(
+			 &( internal_volume->partitions ),
+			 NULL,
+			 NULL );
+		}
 		if( internal_volume->io_handle != NULL )
 		{
 			libvsapm_io_handle_free(
@@ -220,6 +266,25 @@ int libvsapm_volume_free(
 			result = -1;
 		}
 #endif
+		if( internal_volume->partition_map_entries != NULL )
+		{
+			if( libcdata_array_empty(
+			     internal_volume->partitions,
+			     NULL,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+				 "%s: unable to empty the partitions array.",
+				 function );
+
+				result = -1;
+			}
+			memory_free(
+			 internal_volume->partition_map_entries );
+		}
 		if( libcdata_array_free(
 		     &( internal_volume->partitions ),
 		     (int (*)(intptr_t **, libcerror_error_t **)) &libvsapm_partition_map_entry_free,
@@ -234,6 +299,20 @@ int libvsapm_volume_free(
 
 			result = -1;
 		}
+		if( libcdata_array_free(
+		     &( internal_volume->unallocated_ranges ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libvsapm_partition_map_entry_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free the unallocated ranges array.",
+			 function );
+
+			result = -1;
+		}
 		if( libvsapm_io_handle_free(
 		     &( internal_volume->io_handle ),
 		     error ) != 1 )
@@ -305,6 +384,7 @@ int libvsapm_volume_open(
 	libvsapm_internal_volume_t *internal_volume = NULL;
 	static char *function                       = "libvsapm_volume_open";
 	size_t filename_length                      = 0;
+	int volume_is_open                          = 0;
 
 	if( volume == NULL )
 	{
@@ -403,7 +483,7 @@ int libvsapm_volume_open(
 	if( libvsapm_volume_open_file_io_handle(
 	     volume,
 	     file_io_handle,
-	     access_flags,
+	     access_flags & ~( LIBVSAPM_ACCESS_FLAG_DIRECT_IO ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -416,6 +496,8 @@ int libvsapm_volume_open(
 
 		goto on_error;
 	}
+	volume_is_open = 1;
+
 #if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_volume->read_write_lock,
@@ -428,11 +510,67 @@ int libvsapm_volume_open(
 		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 #endif
 	internal_volume->file_io_handle_created_in_library = 1;
 
+#if defined( HAVE_LIBVSAPM_DIRECT_IO )
+	if( ( access_flags & LIBVSAPM_ACCESS_FLAG_DIRECT_IO ) != 0 )
+	{
+		/* If direct IO is not supported, e.g. by the file system, fall back to buffered reads
+		 */
+		if( libvsapm_direct_io_initialize(
+		     &( internal_volume->io_handle->direct_io ),
+		     filename,
+		     LIBVSAPM_DIRECT_IO_ALIGNMENT,
+		     LIBVSAPM_DIRECT_IO_BOUNCE_BUFFER_SIZE,
+		     error ) != 1 )
+		{
+#if defined( HAVE_VERBOSE_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: unable to initialize direct IO falling back to buffered reads.\n",
+				 function );
+
+				libcnotify_print_error_backtrace(
+				 *error );
+			}
+#endif
+			libcerror_error_free(
+			 error );
+		}
+	}
+#endif
+#if defined( HAVE_LIBURING )
+	if( ( access_flags & LIBVSAPM_ACCESS_FLAG_ASYNCHRONOUS_IO ) != 0 )
+	{
+		/* If io_uring is not available, e.g. disabled in the kernel, fall back to synchronous reads
+		 */
+		if( libvsapm_io_uring_initialize(
+		     &( internal_volume->io_handle->io_uring ),
+		     filename,
+		     LIBVSAPM_IO_URING_QUEUE_DEPTH,
+		     LIBVSAPM_IO_URING_MAXIMUM_READ_SIZE,
+		     error ) != 1 )
+		{
+#if defined( HAVE_VERBOSE_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: unable to initialize io_uring falling back to synchronous reads.\n",
+				 function );
+
+				libcnotify_print_error_backtrace(
+				 *error );
+			}
+#endif
+			libcerror_error_free(
+			 error );
+		}
+	}
+#endif
 #if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_volume->read_write_lock,
@@ -451,6 +589,17 @@ int libvsapm_volume_open(
 	return( 1 );
 
 on_error:
+	if( volume_is_open != 0 )
+	{
+		/* The file IO handle is referenced by the volume until it is closed
+		 */
+		if( libvsapm_volume_close(
+		     volume,
+		     NULL ) != 0 )
+		{
+			file_io_handle = NULL;
+		}
+	}
 	if( file_io_handle != NULL )
 	{
 		libbfio_handle_free(
@@ -475,6 +624,7 @@ int libvsapm_volume_open_wide(
 	libvsapm_internal_volume_t *internal_volume = NULL;
 	static char *function                       = "libvsapm_volume_open_wide";
 	size_t filename_length                      = 0;
+	int volume_is_open                          = 0;
 
 	if( volume == NULL )
 	{
@@ -523,6 +673,19 @@ int libvsapm_volume_open_wide(
 
 		return( -1 );
 	}
+	/* Direct IO requires a narrow filename to open the file with O_DIRECT
+	 */
+	if( ( access_flags & LIBVSAPM_ACCESS_FLAG_DIRECT_IO ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: direct IO access not supported.",
+		 function );
+
+		return( -1 );
+	}
 	if( libbfio_file_initialize(
 	     &file_io_handle,
 	     error ) != 1 )
@@ -586,6 +749,8 @@ int libvsapm_volume_open_wide(
 
 		goto on_error;
 	}
+	volume_is_open = 1;
+
 #if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_volume->read_write_lock,
@@ -598,7 +763,7 @@ int libvsapm_volume_open_wide(
 		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 #endif
 	internal_volume->file_io_handle_created_in_library = 1;
@@ -621,6 +786,17 @@ int libvsapm_volume_open_wide(
 	return( 1 );
 
 on_error:
+	if( volume_is_open != 0 )
+	{
+		/* The file IO handle is referenced by the volume until it is closed
+		 */
+		if( libvsapm_volume_close(
+		     volume,
+		     NULL ) != 0 )
+		{
+			file_io_handle = NULL;
+		}
+	}
 	if( file_io_handle != NULL )
 	{
 		libbfio_handle_free(
@@ -646,6 +822,9 @@ int libvsapm_volume_open_file_io_handle(
 	uint8_t file_io_handle_opened_in_library    = 0;
 	int bfio_access_flags                       = 0;
 	int file_io_handle_is_open                  = 0;
+	int number_of_partitions                    = 0;
+	int number_of_unallocated_ranges            = 0;
+	int result                                  = 0;
 
 	if( volume == NULL )
 	{
@@ -705,6 +884,19 @@ int libvsapm_volume_open_file_io_handle(
 
 		return( -1 );
 	}
+	/* Direct IO opens the file by name, which is not known for a file IO handle
+	 */
+	if( ( access_flags & LIBVSAPM_ACCESS_FLAG_DIRECT_IO ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: direct IO access not supported.",
+		 function );
+
+		return( -1 );
+	}
 	if( ( access_flags & LIBVSAPM_ACCESS_FLAG_READ ) != 0 )
 	{
 		bfio_access_flags = LIBBFIO_ACCESS_FLAG_READ;
@@ -742,10 +934,21 @@ int libvsapm_volume_open_file_io_handle(
 		}
 		file_io_handle_opened_in_library = 1;
 	}
-	if( libvsapm_internal_volume_open_read(
-	     internal_volume,
-	     file_io_handle,
-	     error ) != 1 )
+	if( internal_volume->number_of_scan_threads > 0 )
+	{
+		result = libvsapm_internal_volume_scan_read(
+		          internal_volume,
+		          file_io_handle,
+		          error );
+	}
+	else
+	{
+		result = libvsapm_internal_volume_open_read(
+		          internal_volume,
+		          file_io_handle,
+		          error );
+	}
+	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
@@ -756,6 +959,73 @@ int libvsapm_volume_open_file_io_handle(
 
 		goto on_error;
 	}
+	/* When the partition map entries are read on demand the partition index
+	 * is created when first needed
+	 */
+	if( ( internal_volume->read_partition_map_on_demand == 0 )
+	 || ( internal_volume->number_of_scan_threads > 0 ) )
+	{
+		if( libvsapm_partition_index_initialize(
+		     &( internal_volume->partition_index ),
+		     internal_volume->partitions,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create partition index.",
+			 function );
+
+			goto on_error;
+		}
+		if( libvsapm_internal_volume_read_unallocated_ranges(
+		     internal_volume,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine unallocated ranges.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( ( access_flags & LIBVSAPM_ACCESS_FLAG_HUGE_PAGES ) != 0 )
+	{
+		/* The arena contains a region for the sector cache of every partition and unallocated range
+		 */
+		if( libvsapm_internal_volume_get_number_of_partitions(
+		     internal_volume,
+		     &number_of_partitions,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of partitions.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcdata_array_get_number_of_entries(
+		     internal_volume->unallocated_ranges,
+		     &number_of_unallocated_ranges,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of unallocated ranges.",
+			 function );
+
+			goto on_error;
+		}
+	}
 #if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_volume->read_write_lock,
@@ -768,12 +1038,38 @@ int libvsapm_volume_open_file_io_handle(
 		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 #endif
 	internal_volume->file_io_handle                   = file_io_handle;
 	internal_volume->file_io_handle_opened_in_library = file_io_handle_opened_in_library;
 
+	/* If huge pages are not available the sector caches are allocated from normal memory
+	 */
+	if( ( ( access_flags & LIBVSAPM_ACCESS_FLAG_HUGE_PAGES ) != 0 )
+	 && ( ( number_of_partitions + number_of_unallocated_ranges ) > 0 ) )
+	{
+		if( libvsapm_sector_cache_arena_initialize(
+		     &( internal_volume->io_handle->sector_cache_arena ),
+		     (size_t) internal_volume->io_handle->sector_cache_number_of_slots << LIBVSAPM_SECTOR_CACHE_BLOCK_SIZE_SHIFT,
+		     number_of_partitions + number_of_unallocated_ranges,
+		     error ) != 1 )
+		{
+#if defined( HAVE_VERBOSE_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: unable to initialize sector cache arena falling back to normal memory.\n",
+				 function );
+
+				libcnotify_print_error_backtrace(
+				 *error );
+			}
+#endif
+			libcerror_error_free(
+			 error );
+		}
+	}
 #if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_volume->read_write_lock,
@@ -792,6 +1088,24 @@ int libvsapm_volume_open_file_io_handle(
 	return( 1 );
 
 on_error:
+	libcdata_array_empty(
+	 internal_volume->unallocated_ranges,
+	 (int (*)(intptr_t **, libcerror_error_t **)) &libvsapm_partition_map_entry_free,
+	 NULL );
+
+	if( internal_volume->partition_index != NULL )
+	{
+		libvsapm_partition_index_free(
+		 &( internal_volume->partition_index ),
+		 NULL );
+	}
+	if( internal_volume->partition_map_entries != NULL )
+	{
+		memory_free(
+		 internal_volume->partition_map_entries );
+
+		internal_volume->partition_map_entries = NULL;
+	}
 	if( file_io_handle_opened_in_library != 0 )
 	{
 		libbfio_handle_close(
@@ -801,16 +1115,21 @@ on_error:
 	return( -1 );
 }
 
-/* Closes a volume
- * Returns 0 if successful or -1 on error
+/* Opens a volume from data in memory
+ * The data is not copied and must remain available until the volume is closed
+ * Returns 1 if successful or -1 on error
  */
-int libvsapm_volume_close(
+int libvsapm_volume_open_memory(
      libvsapm_volume_t *volume,
+     const uint8_t *data,
+     size_t data_size,
+     int access_flags,
      libcerror_error_t **error )
 {
+	libbfio_handle_t *file_io_handle            = NULL;
 	libvsapm_internal_volume_t *internal_volume = NULL;
-	static char *function                       = "libvsapm_volume_close";
-	int result                                  = 0;
+	static char *function                       = "libvsapm_volume_open_memory";
+	int volume_is_open                          = 0;
 
 	if( volume == NULL )
 	{
@@ -825,116 +1144,3864 @@ int libvsapm_volume_close(
 	}
 	internal_volume = (libvsapm_internal_volume_t *) volume;
 
-	if( internal_volume->file_io_handle == NULL )
+	if( internal_volume->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing file IO handle.",
+		 "%s: invalid volume - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	if( data == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		if( internal_volume->file_io_handle_created_in_library != 0 )
-		{
-			if( libvsapm_debug_print_read_offsets(
-			     internal_volume->file_io_handle,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-				 "%s: unable to print the read offsets.",
-				 function );
-
-				result = -1;
-			}
-		}
-	}
-#endif
-	if( internal_volume->file_io_handle_opened_in_library != 0 )
-	{
-		if( libbfio_handle_close(
-		     internal_volume->file_io_handle,
-		     error ) != 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
-			 "%s: unable to close file IO handle.",
-			 function );
-
-			result = -1;
-		}
-		internal_volume->file_io_handle_opened_in_library = 0;
-	}
-	if( internal_volume->file_io_handle_created_in_library != 0 )
+	if( data_size > (size_t) SSIZE_MAX )
 	{
-		if( libbfio_handle_free(
-		     &( internal_volume->file_io_handle ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free file IO handle.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
 
-			result = -1;
-		}
-		internal_volume->file_io_handle_created_in_library = 0;
+		return( -1 );
 	}
-	internal_volume->file_io_handle = NULL;
-
-	if( libvsapm_io_handle_clear(
-	     internal_volume->io_handle,
+	/* The partition map is read using a memory range file IO handle,
+	 * partition data is read directly from the data
+	 */
+	if( libbfio_memory_range_initialize(
+	     &file_io_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to clear the IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
 		 function );
 
+		goto on_error;
+	}
+	if( libbfio_memory_range_set(
+	     file_io_handle,
+	     (uint8_t *) data,
+	     data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set memory range in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvsapm_volume_open_file_io_handle(
+	     volume,
+	     file_io_handle,
+	     access_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open volume from memory.",
+		 function );
+
+		goto on_error;
+	}
+	volume_is_open = 1;
+
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	internal_volume->file_io_handle_created_in_library = 1;
+	internal_volume->io_handle->memory_data            = data;
+	internal_volume->io_handle->memory_data_size       = (size64_t) data_size;
+
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( volume_is_open != 0 )
+	{
+		/* The file IO handle is referenced by the volume until it is closed
+		 */
+		if( libvsapm_volume_close(
+		     volume,
+		     NULL ) != 0 )
+		{
+			file_io_handle = NULL;
+		}
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Opens a volume by scanning it for partition map entries
+ * This can be used to recover the partitions when the partition map is damaged
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_volume_open_scan(
+     libvsapm_volume_t *volume,
+     const char *filename,
+     int access_flags,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	libvsapm_internal_volume_t *internal_volume = NULL;
+	static char *function                       = "libvsapm_volume_open_scan";
+	int result                                  = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvsapm_internal_volume_t *) volume;
+
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > LIBVSAPM_MAXIMUM_NUMBER_OF_SCAN_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume->number_of_scan_threads = number_of_threads;
+
+	result = libvsapm_volume_open(
+	          volume,
+	          filename,
+	          access_flags,
+	          error );
+
+	internal_volume->number_of_scan_threads = 0;
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open volume.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Opens a volume that consists of multiple segment files
+ * The segment files are read as one continuous volume in the order specified
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_volume_open_multiple(
+     libvsapm_volume_t *volume,
+     char * const filenames[],
+     int number_of_filenames,
+     int access_flags,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle            = NULL;
+	libbfio_pool_t *file_io_pool                = NULL;
+	libvsapm_internal_volume_t *internal_volume = NULL;
+	static char *function                       = "libvsapm_volume_open_multiple";
+	size_t filename_length                      = 0;
+	int entry_index                             = 0;
+	int filename_index                          = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvsapm_internal_volume_t *) volume;
+
+	if( filenames == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filenames.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_filenames <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of filenames value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	/* The file IO handles in the pool are opened on demand
+	 * and at most the maximum number of open handles are kept open
+	 */
+	if( libbfio_pool_initialize(
+	     &file_io_pool,
+	     0,
+	     internal_volume->maximum_number_of_open_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	for( filename_index = 0;
+	     filename_index < number_of_filenames;
+	     filename_index++ )
+	{
+		if( filenames[ filename_index ] == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid filename: %d.",
+			 function,
+			 filename_index );
+
+			goto on_error;
+		}
+		filename_length = narrow_string_length(
+		                   filenames[ filename_index ] );
+
+		if( libbfio_file_initialize(
+		     &file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( libbfio_file_set_name(
+		     file_io_handle,
+		     filenames[ filename_index ],
+		     filename_length,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set filename in file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( libbfio_pool_append_handle(
+		     file_io_pool,
+		     &entry_index,
+		     file_io_handle,
+		     LIBBFIO_OPEN_READ,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append file IO handle: %d to pool.",
+			 function,
+			 filename_index );
+
+			goto on_error;
+		}
+		/* The file IO handle is now managed by the file IO pool
+		 */
+		file_io_handle = NULL;
+	}
+	if( libvsapm_volume_open_file_io_pool(
+	     volume,
+	     file_io_pool,
+	     access_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open volume using a file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_volume->file_io_pool_created_in_library = 1;
+
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( file_io_pool != NULL )
+	{
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Opens a volume that consists of multiple segment files
+ * The segment files are read as one continuous volume in the order specified
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_volume_open_multiple_wide(
+     libvsapm_volume_t *volume,
+     wchar_t * const filenames[],
+     int number_of_filenames,
+     int access_flags,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle            = NULL;
+	libbfio_pool_t *file_io_pool                = NULL;
+	libvsapm_internal_volume_t *internal_volume = NULL;
+	static char *function                       = "libvsapm_volume_open_multiple_wide";
+	size_t filename_length                      = 0;
+	int entry_index                             = 0;
+	int filename_index                          = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvsapm_internal_volume_t *) volume;
+
+	if( filenames == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filenames.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_filenames <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of filenames value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	/* The file IO handles in the pool are opened on demand
+	 * and at most the maximum number of open handles are kept open
+	 */
+	if( libbfio_pool_initialize(
+	     &file_io_pool,
+	     0,
+	     internal_volume->maximum_number_of_open_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	for( filename_index = 0;
+	     filename_index < number_of_filenames;
+	     filename_index++ )
+	{
+		if( filenames[ filename_index ] == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid filename: %d.",
+			 function,
+			 filename_index );
+
+			goto on_error;
+		}
+		filename_length = wide_string_length(
+		                   filenames[ filename_index ] );
+
+		if( libbfio_file_initialize(
+		     &file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( libbfio_file_set_name_wide(
+		     file_io_handle,
+		     filenames[ filename_index ],
+		     filename_length,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set filename in file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( libbfio_pool_append_handle(
+		     file_io_pool,
+		     &entry_index,
+		     file_io_handle,
+		     LIBBFIO_OPEN_READ,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append file IO handle: %d to pool.",
+			 function,
+			 filename_index );
+
+			goto on_error;
+		}
+		/* The file IO handle is now managed by the file IO pool
+		 */
+		file_io_handle = NULL;
+	}
+	if( libvsapm_volume_open_file_io_pool(
+	     volume,
+	     file_io_pool,
+	     access_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open volume using a file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_volume->file_io_pool_created_in_library = 1;
+
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( file_io_pool != NULL )
+	{
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Opens a volume using a Basic File IO (bfio) pool
+ * The file IO handles in the pool are read as one continuous volume in the order of the pool entries
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_volume_open_file_io_pool(
+     libvsapm_volume_t *volume,
+     libbfio_pool_t *file_io_pool,
+     int access_flags,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle            = NULL;
+	libvsapm_internal_volume_t *internal_volume = NULL;
+	static char *function                       = "libvsapm_volume_open_file_io_pool";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvsapm_internal_volume_t *) volume;
+
+	if( internal_volume->file_io_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvsapm_pool_file_io_handle_initialize_handle(
+	     &file_io_handle,
+	     file_io_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvsapm_volume_open_file_io_handle(
+	     volume,
+	     file_io_handle,
+	     access_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open volume using a file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_volume->file_io_handle_created_in_library = 1;
+	internal_volume->file_io_pool                      = file_io_pool;
+
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Opens a volume by scanning it for partition map entries
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_volume_open_scan_wide(
+     libvsapm_volume_t *volume,
+     const wchar_t *filename,
+     int access_flags,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	libvsapm_internal_volume_t *internal_volume = NULL;
+	static char *function                       = "libvsapm_volume_open_scan_wide";
+	int result                                  = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvsapm_internal_volume_t *) volume;
+
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > LIBVSAPM_MAXIMUM_NUMBER_OF_SCAN_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume->number_of_scan_threads = number_of_threads;
+
+	result = libvsapm_volume_open_wide(
+	          volume,
+	          filename,
+	          access_flags,
+	          error );
+
+	internal_volume->number_of_scan_threads = 0;
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open volume.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Opens a volume by scanning it for partition map entries using a Basic File IO (bfio) handle
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_volume_open_scan_file_io_handle(
+     libvsapm_volume_t *volume,
+     libbfio_handle_t *file_io_handle,
+     int access_flags,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	libvsapm_internal_volume_t *internal_volume = NULL;
+	static char *function                       = "libvsapm_volume_open_scan_file_io_handle";
+	int result                                  = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvsapm_internal_volume_t *) volume;
+
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > LIBVSAPM_MAXIMUM_NUMBER_OF_SCAN_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume->number_of_scan_threads = number_of_threads;
+
+	result = libvsapm_volume_open_file_io_handle(
+	          volume,
+	          file_io_handle,
+	          access_flags,
+	          error );
+
+	internal_volume->number_of_scan_threads = 0;
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open volume.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Closes a volume
+ * Returns 0 if successful or -1 on error
+ */
+int libvsapm_volume_close(
+     libvsapm_volume_t *volume,
+     libcerror_error_t **error )
+{
+	libvsapm_internal_volume_t *internal_volume = NULL;
+	libvsapm_read_queue_t *read_queue           = NULL;
+	static char *function                       = "libvsapm_volume_close";
+	int read_queue_result                       = 0;
+	int result                                  = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvsapm_internal_volume_t *) volume;
+
+	if( internal_volume->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	/* Pending asynchronous reads reference the file IO handle
+	 */
+	read_queue_result = libvsapm_io_handle_get_read_queue(
+	                     internal_volume->io_handle,
+	                     &read_queue,
+	                     error );
+
+	if( read_queue_result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve read queue.",
+		 function );
+
+		result = -1;
+	}
+	else if( read_queue_result != 0 )
+	{
+		if( libvsapm_read_queue_join(
+		     read_queue,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join read queue.",
+			 function );
+
+			result = -1;
+		}
+	}
+	/* Partitions of a frozen volume can outlive the volume, reading them fails
+	 * once the IO of the volume is freed
+	 */
+	if( internal_volume->volume_snapshot != NULL )
+	{
+		if( libvsapm_volume_snapshot_close(
+		     internal_volume->volume_snapshot,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to close volume snapshot.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		if( internal_volume->file_io_handle_created_in_library != 0 )
+		{
+			if( libvsapm_debug_print_read_offsets(
+			     internal_volume->file_io_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print the read offsets.",
+				 function );
+
+				result = -1;
+			}
+		}
+	}
+#endif
+	if( internal_volume->file_io_handle_opened_in_library != 0 )
+	{
+		if( libbfio_handle_close(
+		     internal_volume->file_io_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close file IO handle.",
+			 function );
+
+			result = -1;
+		}
+		internal_volume->file_io_handle_opened_in_library = 0;
+	}
+	if( internal_volume->file_io_handle_created_in_library != 0 )
+	{
+		if( libbfio_handle_free(
+		     &( internal_volume->file_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file IO handle.",
+			 function );
+
+			result = -1;
+		}
+		internal_volume->file_io_handle_created_in_library = 0;
+	}
+	if( internal_volume->file_io_pool_created_in_library != 0 )
+	{
+		if( libbfio_pool_close_all(
+		     internal_volume->file_io_pool,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close all file IO handles in pool.",
+			 function );
+
+			result = -1;
+		}
+		if( libbfio_pool_free(
+		     &( internal_volume->file_io_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file IO pool.",
+			 function );
+
+			result = -1;
+		}
+		internal_volume->file_io_pool_created_in_library = 0;
+	}
+	internal_volume->file_io_pool                    = NULL;
+	internal_volume->file_io_handle                  = NULL;
+	internal_volume->bytes_per_sector_set_by_library = 0;
+	internal_volume->partition_map_sector_number     = 0;
+	internal_volume->partition_map_number_of_sectors = 0;
+	internal_volume->partition_map_number_of_entries = 0;
+
+	if( libvsapm_volume_snapshot_release(
+	     &( internal_volume->volume_snapshot ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to release volume snapshot.",
+		 function );
+
+		result = -1;
+	}
+	if( libvsapm_partition_index_free(
+	     &( internal_volume->partition_index ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free partition index.",
+		 function );
+
+		result = -1;
+	}
+	if( libvsapm_io_handle_clear(
+	     internal_volume->io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to clear the IO handle.",
+		 function );
+
+		result = -1;
+	}
+	/* The partition map entries that are read on demand are owned by the volume
+	 * and only referenced by the partitions array
+	 */
+	if( internal_volume->partition_map_entries != NULL )
+	{
+		if( libcdata_array_empty(
+		     internal_volume->partitions,
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to empty the partitions array.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 internal_volume->partition_map_entries );
+
+		internal_volume->partition_map_entries = NULL;
+	}
+	else if( libcdata_array_empty(
+	          internal_volume->partitions,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libvsapm_partition_map_entry_free,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to empty the partitions array.",
+		 function );
+
+		result = -1;
+	}
+	if( libcdata_array_empty(
+	     internal_volume->unallocated_ranges,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libvsapm_partition_map_entry_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to empty the unallocated ranges array.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Freezes an opened volume into an immutable snapshot
+ * The partition map entries are copied into a reference counted snapshot, after which
+ * the metadata getters of the volume and of the partitions it returns no longer lock
+ * This function should be called before the volume is shared between threads
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_volume_freeze(
+     libvsapm_volume_t *volume,
+     libcerror_error_t **error )
+{
+	libvsapm_internal_volume_t *internal_volume = NULL;
+	static char *function                       = "libvsapm_volume_freeze";
+	int result                                  = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvsapm_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	/* The snapshot requires all partition map entries to be read
+	 */
+	if( internal_volume->read_partition_map_on_demand != 0 )
+	{
+		if( libvsapm_internal_volume_read_partition_index(
+		     internal_volume,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read partition index.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_volume->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing file IO handle.",
+		 function );
+
+		result = -1;
+	}
+	else if( internal_volume->volume_snapshot == NULL )
+	{
+		if( libvsapm_volume_snapshot_initialize(
+		     &( internal_volume->volume_snapshot ),
+		     internal_volume->io_handle->bytes_per_sector,
+		     internal_volume->io_handle->bytes_per_sector_shift,
+		     internal_volume->partitions,
+		     internal_volume->unallocated_ranges,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create volume snapshot.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Opens a volume for reading
+ * The first partition map entry is read on its own to determine the number of entries,
+ * the remaining entries are read and decoded in batches
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_internal_volume_open_read(
+     libvsapm_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	libvsapm_partition_map_entry_t *partition_map_entry             = NULL;
+	libvsapm_partition_map_entry_batch_t *partition_map_entry_batch = NULL;
+	uint8_t *partition_map_entries_data                             = NULL;
+	static char *function                                           = "libvsapm_internal_volume_open_read";
+	size_t read_size                                                = 0;
+	ssize_t read_count                                              = 0;
+	off64_t partition_map_entry_offset                              = 512;
+	uint32_t partition_map_entry_index                              = 0;
+	uint32_t partition_map_number_of_entries                        = 0;
+	int batch_entry_index                                           = 0;
+	int batch_number_of_entries                                     = 0;
+	int entry_index                                                 = 0;
+	int maximum_batch_number_of_entries                             = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid internal volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_get_size(
+	     file_io_handle,
+	     &( internal_volume->size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve size from file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: reading Apple Partition Map (APM).\n",
+		 function );
+	}
+#endif
+	if( libvsapm_partition_map_entry_initialize(
+	     &partition_map_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create partition map entry: 0.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvsapm_partition_map_entry_read_file_io_handle(
+	     partition_map_entry,
+	     file_io_handle,
+	     partition_map_entry_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read partition map entry: 0 from file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_compare(
+	     partition_map_entry->type,
+	     "Apple_partition_map\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00",
+	     32 ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid partition map entry: 0 - unsupported type.",
+		 function );
+
+		goto on_error;
+	}
+	partition_map_number_of_entries = partition_map_entry->number_of_entries;
+
+	internal_volume->partition_map_sector_number     = partition_map_entry->sector_number;
+	internal_volume->partition_map_number_of_sectors = partition_map_entry->number_of_sectors;
+
+	if( libvsapm_partition_map_entry_free(
+	     &partition_map_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free partition map entry: 0.",
+		 function );
+
+		goto on_error;
+	}
+	partition_map_entry_offset += 512;
+	partition_map_entry_index   = 1;
+
+	if( partition_map_number_of_entries <= 1 )
+	{
+		return( 1 );
+	}
+	if( partition_map_number_of_entries > internal_volume->maximum_number_of_partition_map_entries )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid partition map number of entries value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( (size64_t) partition_map_number_of_entries * 512 ) > internal_volume->maximum_partition_map_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid partition map size value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	if( (size64_t) partition_map_number_of_entries > ( ( internal_volume->size - 512 ) / 512 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid partition map number of entries value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	internal_volume->partition_map_number_of_entries = partition_map_number_of_entries;
+
+	if( internal_volume->read_partition_map_on_demand != 0 )
+	{
+		/* The partition map entries are read when first used into a single
+		 * allocation that contains an entry per partition
+		 */
+		internal_volume->partition_map_entries = (libvsapm_partition_map_entry_t *) memory_allocate(
+		                                          sizeof( libvsapm_partition_map_entry_t ) * ( partition_map_number_of_entries - 1 ) );
+
+		if( internal_volume->partition_map_entries == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create partition map entries.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     internal_volume->partition_map_entries,
+		     0,
+		     sizeof( libvsapm_partition_map_entry_t ) * ( partition_map_number_of_entries - 1 ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear partition map entries.",
+			 function );
+
+			goto on_error;
+		}
+		return( 1 );
+	}
+	if( ( partition_map_number_of_entries - 1 ) < (uint32_t) LIBVSAPM_PARTITION_MAP_ENTRY_BATCH_SIZE )
+	{
+		maximum_batch_number_of_entries = (int) ( partition_map_number_of_entries - 1 );
+	}
+	else
+	{
+		maximum_batch_number_of_entries = LIBVSAPM_PARTITION_MAP_ENTRY_BATCH_SIZE;
+	}
+	if( libvsapm_partition_map_entry_batch_initialize(
+	     &partition_map_entry_batch,
+	     maximum_batch_number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create partition map entry batch.",
+		 function );
+
+		goto on_error;
+	}
+	partition_map_entries_data = (uint8_t *) memory_allocate(
+	                                          sizeof( uint8_t ) * maximum_batch_number_of_entries * 512 );
+
+	if( partition_map_entries_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create partition map entries data.",
+		 function );
+
+		goto on_error;
+	}
+	while( partition_map_entry_index < partition_map_number_of_entries )
+	{
+		batch_number_of_entries = maximum_batch_number_of_entries;
+
+		if( (uint32_t) batch_number_of_entries > ( partition_map_number_of_entries - partition_map_entry_index ) )
+		{
+			batch_number_of_entries = (int) ( partition_map_number_of_entries - partition_map_entry_index );
+		}
+		read_size = (size_t) batch_number_of_entries * 512;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: reading %d partition map entries at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+			 function,
+			 batch_number_of_entries,
+			 partition_map_entry_offset,
+			 partition_map_entry_offset );
+		}
+#endif
+		read_count = libbfio_handle_read_buffer_at_offset(
+		              file_io_handle,
+		              partition_map_entries_data,
+		              read_size,
+		              partition_map_entry_offset,
+		              error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read partition map entries data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 partition_map_entry_offset,
+			 partition_map_entry_offset );
+
+			goto on_error;
+		}
+		if( libvsapm_partition_map_entry_batch_read_data(
+		     partition_map_entry_batch,
+		     partition_map_entries_data,
+		     read_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read partition map entries: %" PRIu32 " to %" PRIu32 ".",
+			 function,
+			 partition_map_entry_index,
+			 partition_map_entry_index + batch_number_of_entries - 1 );
+
+			goto on_error;
+		}
+		for( batch_entry_index = 0;
+		     batch_entry_index < batch_number_of_entries;
+		     batch_entry_index++ )
+		{
+			if( partition_map_entry_batch->signature_valid[ batch_entry_index ] == 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+				 "%s: invalid partition map entry: %" PRIu32 " - unsupported signature.",
+				 function,
+				 partition_map_entry_index );
+
+				goto on_error;
+			}
+			if( partition_map_entry_batch->map_number_of_entries[ batch_entry_index ] != partition_map_number_of_entries )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid partition map entry: %" PRIu32 " number of entries value out of bounds.",
+				 function,
+				 partition_map_entry_index );
+
+				goto on_error;
+			}
+			if( libvsapm_partition_map_entry_initialize(
+			     &partition_map_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create partition map entry: %" PRIu32 ".",
+				 function,
+				 partition_map_entry_index );
+
+				goto on_error;
+			}
+			if( libvsapm_partition_map_entry_batch_get_entry(
+			     partition_map_entry_batch,
+			     batch_entry_index,
+			     partition_map_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve partition map entry: %" PRIu32 " from batch.",
+				 function,
+				 partition_map_entry_index );
+
+				goto on_error;
+			}
+			if( libcdata_array_append_entry(
+			     internal_volume->partitions,
+			     &entry_index,
+			     (intptr_t *) partition_map_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append partition map entry: %" PRIu32 " to array.",
+				 function,
+				 partition_map_entry_index );
+
+				goto on_error;
+			}
+			partition_map_entry = NULL;
+
+			partition_map_entry_index++;
+		}
+		partition_map_entry_offset += (off64_t) read_size;
+	}
+	memory_free(
+	 partition_map_entries_data );
+
+	partition_map_entries_data = NULL;
+
+	if( libvsapm_partition_map_entry_batch_free(
+	     &partition_map_entry_batch,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free partition map entry batch.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( internal_volume->partition_map_entries != NULL )
+	{
+		memory_free(
+		 internal_volume->partition_map_entries );
+
+		internal_volume->partition_map_entries = NULL;
+	}
+	if( partition_map_entries_data != NULL )
+	{
+		memory_free(
+		 partition_map_entries_data );
+	}
+	if( partition_map_entry_batch != NULL )
+	{
+		libvsapm_partition_map_entry_batch_free(
+		 &partition_map_entry_batch,
+		 NULL );
+	}
+	if( partition_map_entry != NULL )
+	{
+		libvsapm_partition_map_entry_free(
+		 &partition_map_entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads a volume by scanning it for partition map entries
+ * The volume is divided into disjoint ranges that are scanned by separate threads,
+ * the plausible partition map entries found are merged into the partitions sorted
+ * by sector number, where duplicate entries and partition map entries are ignored
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_internal_volume_scan_read(
+     libvsapm_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	libvsapm_partition_map_entry_t *partition_map_entry = NULL;
+	libvsapm_scanner_t **scanners                       = NULL;
+	static char *function                               = "libvsapm_internal_volume_scan_read";
+	size64_t range_size                                 = 0;
+	off64_t range_end_offset                            = 0;
+	off64_t range_start_offset                          = 0;
+	int entry_index                                     = 0;
+	int number_of_entries                               = 0;
+	int number_of_partitions                            = 0;
+	int number_of_scanners                              = 0;
+	int result                                          = 0;
+	int scanner_index                                   = 0;
+
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	libcthreads_thread_pool_t *scan_thread_pool         = NULL;
+#endif
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid internal volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid internal volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_volume->number_of_scan_threads <= 0 )
+	 || ( internal_volume->number_of_scan_threads > LIBVSAPM_MAXIMUM_NUMBER_OF_SCAN_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid internal volume - number of scan threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_get_size(
+	     file_io_handle,
+	     &( internal_volume->size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve size from file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: scanning for Apple Partition Map (APM) entries.\n",
+		 function );
+	}
+#endif
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	number_of_scanners = internal_volume->number_of_scan_threads;
+#else
+	number_of_scanners = 1;
+#endif
+	/* The ranges are a multiple of the scanner buffer size so that every range
+	 * starts at a sector boundary and is read with full size buffers
+	 */
+	range_size = internal_volume->size / number_of_scanners;
+
+	if( ( range_size % LIBVSAPM_SCANNER_BUFFER_SIZE ) != 0 )
+	{
+		range_size = ( ( range_size / LIBVSAPM_SCANNER_BUFFER_SIZE ) + 1 ) * LIBVSAPM_SCANNER_BUFFER_SIZE;
+	}
+	if( range_size == 0 )
+	{
+		range_size = LIBVSAPM_SCANNER_BUFFER_SIZE;
+	}
+	number_of_scanners = (int) ( ( internal_volume->size + range_size - 1 ) / range_size );
+
+	if( number_of_scanners == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid volume size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	scanners = (libvsapm_scanner_t **) memory_allocate(
+	                                    sizeof( libvsapm_scanner_t * ) * number_of_scanners );
+
+	if( scanners == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create scanners.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     scanners,
+	     0,
+	     sizeof( libvsapm_scanner_t * ) * number_of_scanners ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear scanners.",
+		 function );
+
+		goto on_error;
+	}
+	for( scanner_index = 0;
+	     scanner_index < number_of_scanners;
+	     scanner_index++ )
+	{
+		range_start_offset = (off64_t) ( range_size * scanner_index );
+		range_end_offset   = range_start_offset + (off64_t) range_size;
+
+		if( range_end_offset > (off64_t) internal_volume->size )
+		{
+			range_end_offset = (off64_t) internal_volume->size;
+		}
+		if( libvsapm_scanner_initialize(
+		     &( scanners[ scanner_index ] ),
+		     file_io_handle,
+		     (uint8_t) ( number_of_scanners > 1 ),
+		     internal_volume->size,
+		     range_start_offset,
+		     range_end_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create scanner: %d.",
+			 function,
+			 scanner_index );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( number_of_scanners > 1 )
+	{
+		if( libcthreads_thread_pool_create(
+		     &scan_thread_pool,
+		     NULL,
+		     number_of_scanners,
+		     number_of_scanners,
+		     (int (*)(intptr_t *, void *)) &libvsapm_scanner_scan_range_callback,
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create scan thread pool.",
+			 function );
+
+			goto on_error;
+		}
+		for( scanner_index = 0;
+		     scanner_index < number_of_scanners;
+		     scanner_index++ )
+		{
+			if( libcthreads_thread_pool_push(
+			     scan_thread_pool,
+			     (intptr_t *) scanners[ scanner_index ],
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push scanner: %d onto scan thread pool.",
+				 function,
+				 scanner_index );
+
+				goto on_error;
+			}
+		}
+		if( libcthreads_thread_pool_join(
+		     &scan_thread_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join scan thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else
+#endif /* defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT ) */
+	{
+		scanners[ 0 ]->result = libvsapm_scanner_scan_range(
+		                         scanners[ 0 ],
+		                         error );
+	}
+	for( scanner_index = 0;
+	     scanner_index < number_of_scanners;
+	     scanner_index++ )
+	{
+		if( scanners[ scanner_index ]->result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to scan range of scanner: %d.",
+			 function,
+			 scanner_index );
+
+			goto on_error;
+		}
+	}
+	/* A driver descriptor only provides the sector size when it was not set explicitly
+	 */
+	if( ( scanners[ 0 ]->driver_descriptor_block_size != 0 )
+	 && ( internal_volume->io_handle->bytes_per_sector == 512 ) )
+	{
+		if( libvsapm_io_handle_set_bytes_per_sector(
+		     internal_volume->io_handle,
+		     (size_t) scanners[ 0 ]->driver_descriptor_block_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set bytes per sector in IO handle.",
+			 function );
+
+			goto on_error;
+		}
+		internal_volume->bytes_per_sector_set_by_library = 1;
+	}
+	for( scanner_index = 0;
+	     scanner_index < number_of_scanners;
+	     scanner_index++ )
+	{
+		if( libcdata_array_get_number_of_entries(
+		     scanners[ scanner_index ]->partition_map_entries,
+		     &number_of_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of partition map entries of scanner: %d.",
+			 function,
+			 scanner_index );
+
+			goto on_error;
+		}
+		for( entry_index = 0;
+		     entry_index < number_of_entries;
+		     entry_index++ )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     scanners[ scanner_index ]->partition_map_entries,
+			     entry_index,
+			     (intptr_t **) &partition_map_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve partition map entry: %d of scanner: %d.",
+				 function,
+				 entry_index,
+				 scanner_index );
+
+				goto on_error;
+			}
+			if( libcdata_array_set_entry_by_index(
+			     scanners[ scanner_index ]->partition_map_entries,
+			     entry_index,
+			     NULL,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set partition map entry: %d of scanner: %d.",
+				 function,
+				 entry_index,
+				 scanner_index );
+
+				partition_map_entry = NULL;
+
+				goto on_error;
+			}
+			if( memory_compare(
+			     partition_map_entry->type,
+			     "Apple_partition_map\x00",
+			     20 ) == 0 )
+			{
+				internal_volume->partition_map_sector_number     = partition_map_entry->sector_number;
+				internal_volume->partition_map_number_of_sectors = partition_map_entry->number_of_sectors;
+
+				result = 0;
+			}
+			else
+			{
+				result = libcdata_array_insert_entry(
+				          internal_volume->partitions,
+				          &number_of_partitions,
+				          (intptr_t *) partition_map_entry,
+				          (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &libvsapm_partition_map_entry_compare_by_sector_number,
+				          LIBCDATA_INSERT_FLAG_UNIQUE_ENTRIES,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to insert partition map entry: %d of scanner: %d into array.",
+					 function,
+					 entry_index,
+					 scanner_index );
+
+					goto on_error;
+				}
+			}
+			if( result == 0 )
+			{
+				if( libvsapm_partition_map_entry_free(
+				     &partition_map_entry,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free partition map entry.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			partition_map_entry = NULL;
+		}
+	}
+	for( scanner_index = 0;
+	     scanner_index < number_of_scanners;
+	     scanner_index++ )
+	{
+		if( libvsapm_scanner_free(
+		     &( scanners[ scanner_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free scanner: %d.",
+			 function,
+			 scanner_index );
+
+			goto on_error;
+		}
+	}
+	memory_free(
+	 scanners );
+
+	scanners = NULL;
+
+	if( libcdata_array_get_number_of_entries(
+	     internal_volume->partitions,
+	     &number_of_partitions,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of partitions.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_partitions == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: no plausible partition map entries found.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( scan_thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &scan_thread_pool,
+		 NULL );
+	}
+#endif
+	if( partition_map_entry != NULL )
+	{
+		libvsapm_partition_map_entry_free(
+		 &partition_map_entry,
+		 NULL );
+	}
+	if( scanners != NULL )
+	{
+		for( scanner_index = 0;
+		     scanner_index < number_of_scanners;
+		     scanner_index++ )
+		{
+			if( scanners[ scanner_index ] != NULL )
+			{
+				libvsapm_scanner_free(
+				 &( scanners[ scanner_index ] ),
+				 NULL );
+			}
+		}
+		memory_free(
+		 scanners );
+	}
+	libcdata_array_empty(
+	 internal_volume->partitions,
+	 (int (*)(intptr_t **, libcerror_error_t **)) &libvsapm_partition_map_entry_free,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Retrieves the number of bytes per sector
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_volume_get_bytes_per_sector(
+     libvsapm_volume_t *volume,
+     uint32_t *bytes_per_sector,
+     libcerror_error_t **error )
+{
+	libvsapm_internal_volume_t *internal_volume = NULL;
+	static char *function                       = "libvsapm_volume_get_bytes_per_sector";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvsapm_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( bytes_per_sector == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bytes per sector.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->volume_snapshot != NULL )
+	{
+		*bytes_per_sector = internal_volume->volume_snapshot->bytes_per_sector;
+
+		return( 1 );
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*bytes_per_sector = internal_volume->io_handle->bytes_per_sector;
+
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the number of bytes per sector
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_volume_set_bytes_per_sector(
+     libvsapm_volume_t *volume,
+     uint32_t bytes_per_sector,
+     libcerror_error_t **error )
+{
+	libvsapm_internal_volume_t *internal_volume = NULL;
+	static char *function                       = "libvsapm_volume_set_bytes_per_sector";
+	int result                                  = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvsapm_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->volume_snapshot != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - volume is frozen.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->bytes_per_sector_set_by_library != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: bytes per sector value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( bytes_per_sector != 512 )
+	 && ( bytes_per_sector != 1024 )
+	 && ( bytes_per_sector != 2048 )
+	 && ( bytes_per_sector != 4096 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported bytes per sector.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libvsapm_io_handle_set_bytes_per_sector(
+	     internal_volume->io_handle,
+	     (size_t) bytes_per_sector,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set bytes per sector in IO handle.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets the maximum number of partition map entries
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_volume_set_maximum_number_of_partition_map_entries(
+     libvsapm_volume_t *volume,
+     uint32_t maximum_number_of_entries,
+     libcerror_error_t **error )
+{
+	libvsapm_internal_volume_t *internal_volume = NULL;
+	static char *function                       = "libvsapm_volume_set_maximum_number_of_partition_map_entries";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvsapm_internal_volume_t *) volume;
+
+	if( internal_volume->file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_entries == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of entries value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_volume->maximum_number_of_partition_map_entries = maximum_number_of_entries;
+
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the maximum size of the partition map
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_volume_set_maximum_partition_map_size(
+     libvsapm_volume_t *volume,
+     size64_t maximum_size,
+     libcerror_error_t **error )
+{
+	libvsapm_internal_volume_t *internal_volume = NULL;
+	static char *function                       = "libvsapm_volume_set_maximum_partition_map_size";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvsapm_internal_volume_t *) volume;
+
+	if( internal_volume->file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_size < 512 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_volume->maximum_partition_map_size = maximum_size;
+
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the size of the sector cache of each partition
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_volume_set_sector_cache_size(
+     libvsapm_volume_t *volume,
+     size_t sector_cache_size,
+     libcerror_error_t **error )
+{
+	libvsapm_internal_volume_t *internal_volume = NULL;
+	static char *function                       = "libvsapm_volume_set_sector_cache_size";
+	int result                                  = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvsapm_internal_volume_t *) volume;
+
+	if( internal_volume->file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libvsapm_io_handle_set_sector_cache_size(
+	     internal_volume->io_handle,
+	     sector_cache_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set sector cache size in IO handle.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets the value to indicate if the partition map entries should be read on demand
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_volume_set_read_partition_map_on_demand(
+     libvsapm_volume_t *volume,
+     uint8_t read_on_demand,
+     libcerror_error_t **error )
+{
+	libvsapm_internal_volume_t *internal_volume = NULL;
+	static char *function                       = "libvsapm_volume_set_read_partition_map_on_demand";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvsapm_internal_volume_t *) volume;
+
+	if( internal_volume->file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_volume->read_partition_map_on_demand = (uint8_t) ( read_on_demand != 0 );
+
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the maximum number of open handles
+ * This applies to the file IO pool that is created by libvsapm_volume_open_multiple
+ * A value of 0 represents no limit
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_volume_set_maximum_number_of_open_handles(
+     libvsapm_volume_t *volume,
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error )
+{
+	libvsapm_internal_volume_t *internal_volume = NULL;
+	static char *function                       = "libvsapm_volume_set_maximum_number_of_open_handles";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvsapm_internal_volume_t *) volume;
+
+	if( maximum_number_of_open_handles < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid maximum number of open handles value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_volume->maximum_number_of_open_handles = maximum_number_of_open_handles;
+
+	if( internal_volume->file_io_pool_created_in_library != 0 )
+	{
+		if( libbfio_pool_set_maximum_number_of_open_handles(
+		     internal_volume->file_io_pool,
+		     maximum_number_of_open_handles,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum number of open handles in file IO pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_volume->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Polls for completed asynchronous reads
+ * The callback of each completed read is called from the polling thread
+ * This function does not wait for pending reads to complete
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_volume_poll_completions(
+     libvsapm_volume_t *volume,
+     int maximum_number_of_completions,
+     int *number_of_completions,
+     libcerror_error_t **error )
+{
+	libvsapm_internal_volume_t *internal_volume = NULL;
+	libvsapm_read_queue_t *read_queue           = NULL;
+	libvsapm_read_request_t *read_request       = NULL;
+	static char *function                       = "libvsapm_volume_poll_completions";
+	int callback_result                         = 0;
+	int completion_index                        = 0;
+	int result                                  = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvsapm_internal_volume_t *) volume;
+
+	if( maximum_number_of_completions <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of completions value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_completions == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of completions.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_completions = 0;
+
+	/* The read queue is created on the first asynchronous read
+	 */
+	result = libvsapm_io_handle_get_read_queue(
+	          internal_volume->io_handle,
+	          &read_queue,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve read queue.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 1 );
+	}
+	for( completion_index = 0;
+	     completion_index < maximum_number_of_completions;
+	     completion_index++ )
+	{
+		result = libvsapm_read_queue_pop_completed_request(
+		          read_queue,
+		          &read_request,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve completed read request.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		callback_result = read_request->callback(
+		                   read_request->partition,
+		                   read_request->offset,
+		                   read_request->buffer,
+		                   read_request->read_count,
+		                   read_request->user_data );
+
+		if( libvsapm_read_request_free(
+		     &read_request,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read request.",
+			 function );
+
+			return( -1 );
+		}
+		*number_of_completions += 1;
+
+		if( callback_result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: completion callback failed.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves the number of partitions
+ * When the partition map entries are read on demand the partitions array is only filled
+ * once the partition index is read
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_internal_volume_get_number_of_partitions(
+     libvsapm_internal_volume_t *internal_volume,
+     int *number_of_partitions,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_internal_volume_get_number_of_partitions";
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid internal volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_partitions == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of partitions.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->partition_map_entries != NULL )
+	{
+		*number_of_partitions = (int) ( internal_volume->partition_map_number_of_entries - 1 );
+
+		return( 1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     internal_volume->partitions,
+	     number_of_partitions,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of partitions from array.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the number of partitions
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_volume_get_number_of_partitions(
+     libvsapm_volume_t *volume,
+     int *number_of_partitions,
+     libcerror_error_t **error )
+{
+	libvsapm_internal_volume_t *internal_volume = NULL;
+	static char *function                       = "libvsapm_volume_get_number_of_partitions";
+	int result                                  = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvsapm_internal_volume_t *) volume;
+
+	if( internal_volume->volume_snapshot != NULL )
+	{
+		if( libvsapm_volume_snapshot_get_number_of_partitions(
+		     internal_volume->volume_snapshot,
+		     number_of_partitions,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of partitions from volume snapshot.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libvsapm_internal_volume_get_number_of_partitions(
+	     internal_volume,
+	     number_of_partitions,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of partitions.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves a specific partition map entry
+ * When the partition map entries are read on demand the entry is read if needed,
+ * in which case the caller must hold the read/write lock for writing
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_internal_volume_get_partition_map_entry_by_index(
+     libvsapm_internal_volume_t *internal_volume,
+     int partition_index,
+     libvsapm_partition_map_entry_t **partition_map_entry,
+     libcerror_error_t **error )
+{
+	uint8_t partition_map_entry_data[ sizeof( vsapm_partition_map_entry_t ) ];
+
+	libvsapm_partition_map_entry_t safe_partition_map_entry;
+
+	static char *function              = "libvsapm_internal_volume_get_partition_map_entry_by_index";
+	ssize_t read_count                 = 0;
+	off64_t partition_map_entry_offset = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid internal volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( partition_map_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition map entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->partition_map_entries == NULL )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_volume->partitions,
+		     partition_index,
+		     (intptr_t **) partition_map_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve partition map entry: %d from array.",
+			 function,
+			 partition_index );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	/* The first partition map entry describes the partition map and is not stored with the partitions
+	 */
+	if( ( partition_index < 0 )
+	 || ( (uint32_t) partition_index >= ( internal_volume->partition_map_number_of_entries - 1 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid partition index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->partition_map_entries[ partition_index ].number_of_entries != 0 )
+	{
+		*partition_map_entry = &( internal_volume->partition_map_entries[ partition_index ] );
+
+		return( 1 );
+	}
+	partition_map_entry_offset = (off64_t) ( partition_index + 2 ) << LIBVSAPM_PARTITION_MAP_ENTRY_SIZE_SHIFT;
+
+	read_count = libbfio_handle_read_buffer_at_offset(
+	              internal_volume->file_io_handle,
+	              partition_map_entry_data,
+	              sizeof( vsapm_partition_map_entry_t ),
+	              partition_map_entry_offset,
+	              error );
+
+	if( read_count != (ssize_t) sizeof( vsapm_partition_map_entry_t ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read partition map entry: %d data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 partition_index + 1,
+		 partition_map_entry_offset,
+		 partition_map_entry_offset );
+
+		return( -1 );
+	}
+	if( memory_compare(
+	     ( (vsapm_partition_map_entry_t *) partition_map_entry_data )->signature,
+	     "PM",
+	     2 ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid partition map entry: %d - unsupported signature.",
+		 function,
+		 partition_index + 1 );
+
+		return( -1 );
+	}
+	/* The entry is decoded into a local copy so that a partial read does not mark it as read
+	 */
+	if( memory_set(
+	     &safe_partition_map_entry,
+	     0,
+	     sizeof( libvsapm_partition_map_entry_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear partition map entry: %d.",
+		 function,
+		 partition_index + 1 );
+
+		return( -1 );
+	}
+	if( libvsapm_partition_map_entry_read_data(
+	     &safe_partition_map_entry,
+	     partition_map_entry_data,
+	     sizeof( vsapm_partition_map_entry_t ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read partition map entry: %d.",
+		 function,
+		 partition_index + 1 );
+
+		return( -1 );
+	}
+	if( safe_partition_map_entry.number_of_entries != internal_volume->partition_map_number_of_entries )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid partition map entry: %d number of entries value out of bounds.",
+		 function,
+		 partition_index + 1 );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     &( internal_volume->partition_map_entries[ partition_index ] ),
+	     &safe_partition_map_entry,
+	     sizeof( libvsapm_partition_map_entry_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy partition map entry: %d.",
+		 function,
+		 partition_index + 1 );
+
+		return( -1 );
+	}
+	*partition_map_entry = &( internal_volume->partition_map_entries[ partition_index ] );
+
+	return( 1 );
+}
+
+/* Creates a partition for a partition map entry of the volume snapshot
+ * The partition holds a reference to the volume snapshot
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_internal_volume_initialize_snapshot_partition(
+     libvsapm_internal_volume_t *internal_volume,
+     libvsapm_partition_t **partition,
+     libvsapm_partition_map_entry_t *partition_map_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_internal_volume_initialize_snapshot_partition";
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid internal volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvsapm_partition_initialize(
+	     partition,
+	     internal_volume->io_handle,
+	     internal_volume->file_io_handle,
+	     partition_map_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create partition.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvsapm_partition_set_volume_snapshot(
+	     *partition,
+	     internal_volume->volume_snapshot,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set volume snapshot in partition.",
+		 function );
+
+		libvsapm_partition_free(
+		 partition,
+		 NULL );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves a specific partition
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_volume_get_partition_by_index(
+     libvsapm_volume_t *volume,
+     int partition_index,
+     libvsapm_partition_t **partition,
+     libcerror_error_t **error )
+{
+	libvsapm_internal_volume_t *internal_volume         = NULL;
+	libvsapm_partition_map_entry_t *partition_map_entry = NULL;
+	static char *function                               = "libvsapm_volume_get_partition_by_index";
+	uint8_t read_on_demand                              = 0;
+	int result                                          = 1;
+
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	int release_result                                  = 0;
+#endif
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvsapm_internal_volume_t *) volume;
+
+	if( partition == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition.",
+		 function );
+
+		return( -1 );
+	}
+	if( *partition != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid partition value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->volume_snapshot != NULL )
+	{
+		if( libvsapm_volume_snapshot_get_partition_map_entry_by_index(
+		     internal_volume->volume_snapshot,
+		     partition_index,
+		     &partition_map_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve partition map entry: %d from volume snapshot.",
+			 function,
+			 partition_index );
+
+			return( -1 );
+		}
+		if( libvsapm_internal_volume_initialize_snapshot_partition(
+		     internal_volume,
+		     partition,
+		     partition_map_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create partition: %d.",
+			 function,
+			 partition_index );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	/* Reading a partition map entry on demand modifies the partitions array
+	 */
+	read_on_demand = internal_volume->read_partition_map_on_demand;
+
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( read_on_demand != 0 )
+	{
+		result = libcthreads_read_write_lock_grab_for_write(
+		          internal_volume->read_write_lock,
+		          error );
+	}
+	else
+	{
+		result = libcthreads_read_write_lock_grab_for_read(
+		          internal_volume->read_write_lock,
+		          error );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libvsapm_internal_volume_get_partition_map_entry_by_index(
+	     internal_volume,
+	     partition_index,
+	     &partition_map_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve partition map entry: %d.",
+		 function,
+		 partition_index );
+
 		result = -1;
 	}
-	if( libcdata_array_empty(
-	     internal_volume->partitions,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libvsapm_partition_map_entry_free,
+	else
+	{
+		if( libvsapm_partition_initialize(
+		     partition,
+		     internal_volume->io_handle,
+		     internal_volume->file_io_handle,
+		     partition_map_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create partition: %d.",
+			 function,
+			 partition_index );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( read_on_demand != 0 )
+	{
+		release_result = libcthreads_read_write_lock_release_for_write(
+		                  internal_volume->read_write_lock,
+		                  error );
+	}
+	else
+	{
+		release_result = libcthreads_read_write_lock_release_for_read(
+		                  internal_volume->read_write_lock,
+		                  error );
+	}
+	if( release_result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the index of the partition that contains a specific offset
+ * The offset is relative to the start of the volume
+ * If partitions overlap the partition with the largest start offset that contains the offset is returned
+ * Returns 1 if successful, 0 if no partition contains the offset or -1 on error
+ */
+int libvsapm_volume_get_partition_index_by_offset(
+     libvsapm_volume_t *volume,
+     off64_t offset,
+     int *partition_index,
+     libcerror_error_t **error )
+{
+	libvsapm_internal_volume_t *internal_volume = NULL;
+	static char *function                       = "libvsapm_volume_get_partition_index_by_offset";
+	uint64_t sector_number                      = 0;
+	int result                                  = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvsapm_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( partition_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition index.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->volume_snapshot != NULL )
+	{
+		result = libvsapm_volume_snapshot_get_partition_index_by_offset(
+		          internal_volume->volume_snapshot,
+		          offset,
+		          partition_index,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve partition index from volume snapshot.",
+			 function );
+		}
+		return( result );
+	}
+	if( internal_volume->read_partition_map_on_demand != 0 )
+	{
+		if( libvsapm_internal_volume_read_partition_index(
+		     internal_volume,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read partition index.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
-		 "%s: unable to empty the partitions array.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_volume->partition_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing partition index.",
+		 function );
+
+		result = -1;
+	}
+	else if( internal_volume->io_handle->bytes_per_sector == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid volume - invalid IO handle - bytes per sector value out of bounds.",
 		 function );
 
 		result = -1;
 	}
+	else
+	{
+		if( internal_volume->io_handle->bytes_per_sector_shift != 0 )
+		{
+			sector_number = (uint64_t) offset >> internal_volume->io_handle->bytes_per_sector_shift;
+		}
+		else
+		{
+			sector_number = (uint64_t) offset / internal_volume->io_handle->bytes_per_sector;
+		}
+
+		result = libvsapm_partition_index_get_partition_index_by_sector_number(
+		          internal_volume->partition_index,
+		          sector_number,
+		          partition_index,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve partition index for sector: %" PRIu64 ".",
+			 function,
+			 sector_number );
+		}
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Reads the partition index if the partition map entries are read on demand
+ * All partition map entries that were not read yet are read to create the partition index
+ * and to determine the unallocated ranges
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_internal_volume_read_partition_index(
+     libvsapm_internal_volume_t *internal_volume,
+     libcerror_error_t **error )
+{
+	libvsapm_partition_map_entry_t *partition_map_entry = NULL;
+	static char *function                               = "libvsapm_internal_volume_read_partition_index";
+	int number_of_partitions                            = 0;
+	int partition_index                                 = 0;
+	int result                                          = 1;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid internal volume.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	/* The partition index is only created once the volume is opened
+	 */
+	if( ( internal_volume->file_io_handle != NULL )
+	 && ( internal_volume->partition_index == NULL ) )
+	{
+		if( libvsapm_internal_volume_get_number_of_partitions(
+		     internal_volume,
+		     &number_of_partitions,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of partitions.",
+			 function );
+
+			result = -1;
+		}
+		/* The partitions array references the partition map entries that are read on demand
+		 */
+		else if( internal_volume->partition_map_entries != NULL )
+		{
+			if( libcdata_array_resize(
+			     internal_volume->partitions,
+			     number_of_partitions,
+			     NULL,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+				 "%s: unable to resize partitions array.",
+				 function );
+
+				result = -1;
+			}
+		}
+		for( partition_index = 0;
+		     ( result == 1 ) && ( partition_index < number_of_partitions );
+		     partition_index++ )
+		{
+			partition_map_entry = NULL;
+
+			if( libvsapm_internal_volume_get_partition_map_entry_by_index(
+			     internal_volume,
+			     partition_index,
+			     &partition_map_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve partition map entry: %d.",
+				 function,
+				 partition_index );
+
+				result = -1;
+			}
+			else if( internal_volume->partition_map_entries != NULL )
+			{
+				if( libcdata_array_set_entry_by_index(
+				     internal_volume->partitions,
+				     partition_index,
+				     (intptr_t *) partition_map_entry,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set partition map entry: %d in array.",
+					 function,
+					 partition_index );
+
+					result = -1;
+				}
+			}
+		}
+		if( result == 1 )
+		{
+			if( libvsapm_partition_index_initialize(
+			     &( internal_volume->partition_index ),
+			     internal_volume->partitions,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create partition index.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( result == 1 )
+		{
+			if( libvsapm_internal_volume_read_unallocated_ranges(
+			     internal_volume,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine unallocated ranges.",
+				 function );
+
+				libvsapm_partition_index_free(
+				 &( internal_volume->partition_index ),
+				 NULL );
+
+				result = -1;
+			}
+		}
+	}
 #if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_volume->read_write_lock,
@@ -953,20 +5020,25 @@ int libvsapm_volume_close(
 	return( result );
 }
 
-/* Opens a volume for reading
+/* Determines the unallocated ranges of the volume from the partition index
+ * Sector 0, that contains the driver descriptor, and the partition map are not considered unallocated
  * Returns 1 if successful or -1 on error
  */
-int libvsapm_internal_volume_open_read(
+int libvsapm_internal_volume_read_unallocated_ranges(
      libvsapm_internal_volume_t *internal_volume,
-     libbfio_handle_t *file_io_handle,
      libcerror_error_t **error )
 {
 	libvsapm_partition_map_entry_t *partition_map_entry = NULL;
-	static char *function                               = "libvsapm_internal_volume_open_read";
-	off64_t partition_map_entry_offset                  = 512;
-	uint32_t partition_map_entry_index                  = 0;
-	uint32_t partition_map_number_of_entries            = 0;
+	static char *function                               = "libvsapm_internal_volume_read_unallocated_ranges";
+	uint64_t extent_end_sector_number                   = 0;
+	uint64_t extent_start_sector_number                 = 0;
+	uint64_t range_end_sector_number                    = 0;
+	uint64_t range_start_sector_number                  = 1;
+	uint64_t volume_number_of_sectors                   = 0;
+	uint8_t last_extent                                 = 0;
+	uint8_t partition_map_extent_pending                = 0;
 	int entry_index                                     = 0;
+	int range_index                                     = 0;
 
 	if( internal_volume == NULL )
 	{
@@ -974,120 +5046,117 @@ int libvsapm_internal_volume_open_read(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid internal volume.",
+		 "%s: invalid volume.",
 		 function );
 
 		return( -1 );
 	}
-	if( libbfio_handle_get_size(
-	     file_io_handle,
-	     &( internal_volume->size ),
-	     error ) != 1 )
+	if( internal_volume->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve size from file IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle->bytes_per_sector == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid volume - invalid IO handle - bytes per sector value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->partition_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing partition index.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	if( internal_volume->io_handle->bytes_per_sector_shift != 0 )
 	{
-		libcnotify_printf(
-		 "%s: reading Apple Partition Map (APM).\n",
-		 function );
+		volume_number_of_sectors = internal_volume->size >> internal_volume->io_handle->bytes_per_sector_shift;
 	}
-#endif
+	else
+	{
+		volume_number_of_sectors = internal_volume->size / internal_volume->io_handle->bytes_per_sector;
+	}
+
+	/* A partition map entry cannot describe sectors beyond the 32-bit sector number range
+	 */
+	if( volume_number_of_sectors > (uint64_t) 0xffffffffUL )
+	{
+		volume_number_of_sectors = (uint64_t) 0xffffffffUL;
+	}
+	/* The partition index entries are sorted by start sector number, every extent
+	 * that starts after the sectors covered so far is preceded by an unallocated range.
+	 * The extent of the partition map itself is merged in, since it is not part of
+	 * the partitions array
+	 */
+	partition_map_extent_pending = (uint8_t) ( internal_volume->partition_map_number_of_sectors > 0 );
+
 	do
 	{
-		if( libvsapm_partition_map_entry_initialize(
-		     &partition_map_entry,
-		     error ) != 1 )
+		if( ( partition_map_extent_pending != 0 )
+		 && ( ( entry_index >= internal_volume->partition_index->number_of_entries )
+		  ||  ( internal_volume->partition_index->entries[ entry_index ].start_sector_number >= (uint64_t) internal_volume->partition_map_sector_number ) ) )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create partition map entry: %d.",
-			 function,
-			 partition_map_entry_index );
+			extent_start_sector_number = (uint64_t) internal_volume->partition_map_sector_number;
+			extent_end_sector_number   = extent_start_sector_number + internal_volume->partition_map_number_of_sectors;
 
-			goto on_error;
+			partition_map_extent_pending = 0;
 		}
-		if( libvsapm_partition_map_entry_read_file_io_handle(
-		     partition_map_entry,
-		     file_io_handle,
-		     partition_map_entry_offset,
-		     error ) != 1 )
+		else if( entry_index < internal_volume->partition_index->number_of_entries )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read partition map entry: %d from file IO handle.",
-			 function,
-			 partition_map_entry_index );
+			extent_start_sector_number = internal_volume->partition_index->entries[ entry_index ].start_sector_number;
+			extent_end_sector_number   = internal_volume->partition_index->entries[ entry_index ].end_sector_number;
 
-			goto on_error;
+			entry_index++;
 		}
-		if( partition_map_entry_index == 0 )
+		else
 		{
-			if( memory_compare(
-			     partition_map_entry->type,
-			     "Apple_partition_map\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00",
-			     32 ) != 0 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-				 "%s: invalid partition map entry: %d - unsupported type.",
-				 function,
-				 partition_map_entry_index );
-
-				goto on_error;
-			}
-			partition_map_number_of_entries = partition_map_entry->number_of_entries;
+			extent_start_sector_number = volume_number_of_sectors;
+			extent_end_sector_number   = volume_number_of_sectors;
+			last_extent                = 1;
 		}
-		else if( partition_map_entry->number_of_entries != partition_map_number_of_entries )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: invalid partition map entry: %d number of entries value out of bounds.",
-			 function,
-			 partition_map_entry_index );
+		range_end_sector_number = extent_start_sector_number;
 
-			goto on_error;
+		if( range_end_sector_number > volume_number_of_sectors )
+		{
+			range_end_sector_number = volume_number_of_sectors;
 		}
-		partition_map_entry_offset += 512;
-
-		if( partition_map_entry_index == 0 )
+		if( range_end_sector_number > range_start_sector_number )
 		{
-			if( libvsapm_partition_map_entry_free(
+			if( libvsapm_partition_map_entry_initialize(
 			     &partition_map_entry,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free partition map entry: %d.",
-				 function,
-				 partition_map_entry_index );
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create partition map entry.",
+				 function );
 
 				goto on_error;
 			}
-		}
-		else
-		{
+			partition_map_entry->sector_number     = (uint32_t) range_start_sector_number;
+			partition_map_entry->number_of_sectors = (uint32_t) ( range_end_sector_number - range_start_sector_number );
+
 			if( libcdata_array_append_entry(
-			     internal_volume->partitions,
-			     &entry_index,
+			     internal_volume->unallocated_ranges,
+			     &range_index,
 			     (intptr_t *) partition_map_entry,
 			     error ) != 1 )
 			{
@@ -1095,17 +5164,19 @@ int libvsapm_internal_volume_open_read(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to append partition map entry: %d to array.",
-				 function,
-				 partition_map_entry_index );
+				 "%s: unable to append unallocated range to array.",
+				 function );
 
 				goto on_error;
 			}
 			partition_map_entry = NULL;
 		}
-		partition_map_entry_index++;
+		if( extent_end_sector_number > range_start_sector_number )
+		{
+			range_start_sector_number = extent_end_sector_number;
+		}
 	}
-	while( partition_map_entry_index < partition_map_number_of_entries );
+	while( last_extent == 0 );
 
 	return( 1 );
 
@@ -1116,19 +5187,25 @@ on_error:
 		 &partition_map_entry,
 		 NULL );
 	}
+	libcdata_array_empty(
+	 internal_volume->unallocated_ranges,
+	 (int (*)(intptr_t **, libcerror_error_t **)) &libvsapm_partition_map_entry_free,
+	 NULL );
+
 	return( -1 );
 }
 
-/* Retrieves the number of bytes per sector
+/* Retrieves the number of unallocated ranges
  * Returns 1 if successful or -1 on error
  */
-int libvsapm_volume_get_bytes_per_sector(
+int libvsapm_volume_get_number_of_unallocated_ranges(
      libvsapm_volume_t *volume,
-     uint32_t *bytes_per_sector,
+     int *number_of_unallocated_ranges,
      libcerror_error_t **error )
 {
 	libvsapm_internal_volume_t *internal_volume = NULL;
-	static char *function                       = "libvsapm_volume_get_bytes_per_sector";
+	static char *function                       = "libvsapm_volume_get_number_of_unallocated_ranges";
+	int result                                  = 1;
 
 	if( volume == NULL )
 	{
@@ -1143,27 +5220,39 @@ int libvsapm_volume_get_bytes_per_sector(
 	}
 	internal_volume = (libvsapm_internal_volume_t *) volume;
 
-	if( internal_volume->io_handle == NULL )
+	if( internal_volume->volume_snapshot != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing IO handle.",
-		 function );
+		if( libvsapm_volume_snapshot_get_number_of_unallocated_ranges(
+		     internal_volume->volume_snapshot,
+		     number_of_unallocated_ranges,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of unallocated ranges from volume snapshot.",
+			 function );
 
-		return( -1 );
+			return( -1 );
+		}
+		return( 1 );
 	}
-	if( bytes_per_sector == NULL )
+	if( internal_volume->read_partition_map_on_demand != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid bytes per sector.",
-		 function );
+		if( libvsapm_internal_volume_read_partition_index(
+		     internal_volume,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read partition index.",
+			 function );
 
-		return( -1 );
+			return( -1 );
+		}
 	}
 #if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_read(
@@ -1180,8 +5269,20 @@ int libvsapm_volume_get_bytes_per_sector(
 		return( -1 );
 	}
 #endif
-	*bytes_per_sector = internal_volume->io_handle->bytes_per_sector;
+	if( libcdata_array_get_number_of_entries(
+	     internal_volume->unallocated_ranges,
+	     number_of_unallocated_ranges,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of unallocated ranges from array.",
+		 function );
 
+		result = -1;
+	}
 #if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
 	     internal_volume->read_write_lock,
@@ -1197,19 +5298,23 @@ int libvsapm_volume_get_bytes_per_sector(
 		return( -1 );
 	}
 #endif
-	return( 1 );
+	return( result );
 }
 
-/* Sets the number of bytes per sector
+/* Retrieves a specific unallocated range
+ * The unallocated range is a partition without name and type
  * Returns 1 if successful or -1 on error
  */
-int libvsapm_volume_set_bytes_per_sector(
+int libvsapm_volume_get_unallocated_range_by_index(
      libvsapm_volume_t *volume,
-     uint32_t bytes_per_sector,
+     int unallocated_range_index,
+     libvsapm_partition_t **unallocated_range,
      libcerror_error_t **error )
 {
-	libvsapm_internal_volume_t *internal_volume = NULL;
-	static char *function                       = "libvsapm_volume_set_bytes_per_sector";
+	libvsapm_internal_volume_t *internal_volume         = NULL;
+	libvsapm_partition_map_entry_t *partition_map_entry = NULL;
+	static char *function                               = "libvsapm_volume_get_unallocated_range_by_index";
+	int result                                          = 1;
 
 	if( volume == NULL )
 	{
@@ -1224,44 +5329,199 @@ int libvsapm_volume_set_bytes_per_sector(
 	}
 	internal_volume = (libvsapm_internal_volume_t *) volume;
 
-	if( internal_volume->io_handle == NULL )
+	if( unallocated_range == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid unallocated range.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_volume->bytes_per_sector_set_by_library != 0 )
+	if( *unallocated_range != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: bytes per sector value already set.",
+		 "%s: invalid unallocated range value already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( bytes_per_sector != 512 )
-	 && ( bytes_per_sector != 1024 )
-	 && ( bytes_per_sector != 2048 )
-	 && ( bytes_per_sector != 4096 ) )
+	if( internal_volume->volume_snapshot != NULL )
+	{
+		if( libvsapm_volume_snapshot_get_unallocated_range_by_index(
+		     internal_volume->volume_snapshot,
+		     unallocated_range_index,
+		     &partition_map_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve unallocated range: %d from volume snapshot.",
+			 function,
+			 unallocated_range_index );
+
+			return( -1 );
+		}
+		if( libvsapm_internal_volume_initialize_snapshot_partition(
+		     internal_volume,
+		     unallocated_range,
+		     partition_map_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create unallocated range: %d.",
+			 function,
+			 unallocated_range_index );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	if( internal_volume->read_partition_map_on_demand != 0 )
+	{
+		if( libvsapm_internal_volume_read_partition_index(
+		     internal_volume,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read partition index.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libcdata_array_get_entry_by_index(
+	     internal_volume->unallocated_ranges,
+	     unallocated_range_index,
+	     (intptr_t **) &partition_map_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve unallocated range: %d from array.",
+		 function,
+		 unallocated_range_index );
+
+		result = -1;
+	}
+	else
+	{
+		if( libvsapm_partition_initialize(
+		     unallocated_range,
+		     internal_volume->io_handle,
+		     internal_volume->file_io_handle,
+		     partition_map_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create unallocated range: %d.",
+			 function,
+			 unallocated_range_index );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Determines if partitions of the volume overlap
+ * Returns 1 if partitions overlap, 0 if not or -1 on error
+ */
+int libvsapm_volume_has_overlapping_partitions(
+     libvsapm_volume_t *volume,
+     libcerror_error_t **error )
+{
+	libvsapm_internal_volume_t *internal_volume = NULL;
+	static char *function                       = "libvsapm_volume_has_overlapping_partitions";
+	int result                                  = 0;
+
+	if( volume == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported bytes per sector.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
 		 function );
 
-		return( -1 );
+		return( -1 );
+	}
+	internal_volume = (libvsapm_internal_volume_t *) volume;
+
+	if( internal_volume->volume_snapshot != NULL )
+	{
+		if( internal_volume->volume_snapshot->partition_index->has_overlapping_partitions != 0 )
+		{
+			return( 1 );
+		}
+		return( 0 );
+	}
+	if( internal_volume->read_partition_map_on_demand != 0 )
+	{
+		if( libvsapm_internal_volume_read_partition_index(
+		     internal_volume,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read partition index.",
+			 function );
+
+			return( -1 );
+		}
 	}
 #if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -1269,16 +5529,29 @@ int libvsapm_volume_set_bytes_per_sector(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	internal_volume->io_handle->bytes_per_sector = bytes_per_sector;
+	if( internal_volume->partition_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing partition index.",
+		 function );
 
+		result = -1;
+	}
+	else if( internal_volume->partition_index->has_overlapping_partitions != 0 )
+	{
+		result = 1;
+	}
 #if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -1286,58 +5559,69 @@ int libvsapm_volume_set_bytes_per_sector(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( 1 );
+	return( result );
 }
 
-/* Retrieves the number of partitions
+
+/* Adds the ranges to scan to a scan job and creates its workers
  * Returns 1 if successful or -1 on error
  */
-int libvsapm_volume_get_number_of_partitions(
-     libvsapm_volume_t *volume,
-     int *number_of_partitions,
+int libvsapm_internal_volume_initialize_scan_job(
+     libvsapm_internal_volume_t *internal_volume,
+     libvsapm_scan_job_t *scan_job,
+     int number_of_threads,
+     uint8_t scan_flags,
      libcerror_error_t **error )
 {
-	libvsapm_internal_volume_t *internal_volume = NULL;
-	static char *function                       = "libvsapm_volume_get_number_of_partitions";
-	int result                                  = 1;
+	libvsapm_partition_map_entry_t *partition_map_entry = NULL;
+	static char *function                               = "libvsapm_internal_volume_initialize_scan_job";
+	size64_t range_size                                 = 0;
+	off64_t range_offset                                = 0;
+	int entry_index                                     = 0;
+	int number_of_entries                               = 0;
 
-	if( volume == NULL )
+	if( internal_volume == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid volume.",
+		 "%s: invalid internal volume.",
 		 function );
 
 		return( -1 );
 	}
-	internal_volume = (libvsapm_internal_volume_t *) volume;
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid internal volume - missing IO handle.",
+		 function );
 
-#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+		return( -1 );
+	}
+	if( internal_volume->file_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid internal volume - missing file IO handle.",
 		 function );
 
 		return( -1 );
 	}
-#endif
 	if( libcdata_array_get_number_of_entries(
 	     internal_volume->partitions,
-	     number_of_partitions,
+	     &number_of_entries,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -1347,39 +5631,217 @@ int libvsapm_volume_get_number_of_partitions(
 		 "%s: unable to retrieve number of partitions from array.",
 		 function );
 
-		result = -1;
+		return( -1 );
 	}
-#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_volume->read_write_lock,
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_volume->partitions,
+		     entry_index,
+		     (intptr_t **) &partition_map_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve partition map entry: %d from array.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( partition_map_entry == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing partition map entry: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( internal_volume->io_handle->bytes_per_sector_shift != 0 )
+		{
+			range_offset = (off64_t) partition_map_entry->sector_number << internal_volume->io_handle->bytes_per_sector_shift;
+			range_size   = (size64_t) partition_map_entry->number_of_sectors << internal_volume->io_handle->bytes_per_sector_shift;
+		}
+		else
+		{
+			range_offset = (off64_t) partition_map_entry->sector_number * internal_volume->io_handle->bytes_per_sector;
+			range_size   = (size64_t) partition_map_entry->number_of_sectors * internal_volume->io_handle->bytes_per_sector;
+		}
+
+		/* The part of a partition that lies beyond the end of the volume is not scanned
+		 */
+		if( (size64_t) range_offset >= internal_volume->size )
+		{
+			continue;
+		}
+		if( range_size > ( internal_volume->size - range_offset ) )
+		{
+			range_size = internal_volume->size - range_offset;
+		}
+		if( libvsapm_scan_job_append_range(
+		     scan_job,
+		     entry_index,
+		     range_offset,
+		     0,
+		     range_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append range of partition: %d to scan job.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+	}
+	if( ( scan_flags & LIBVSAPM_SCAN_FLAG_UNALLOCATED ) != 0 )
+	{
+		if( libcdata_array_get_number_of_entries(
+		     internal_volume->unallocated_ranges,
+		     &number_of_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of unallocated ranges from array.",
+			 function );
+
+			return( -1 );
+		}
+		for( entry_index = 0;
+		     entry_index < number_of_entries;
+		     entry_index++ )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     internal_volume->unallocated_ranges,
+			     entry_index,
+			     (intptr_t **) &partition_map_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve unallocated range: %d from array.",
+				 function,
+				 entry_index );
+
+				return( -1 );
+			}
+			if( partition_map_entry == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing unallocated range: %d.",
+				 function,
+				 entry_index );
+
+				return( -1 );
+			}
+			if( internal_volume->io_handle->bytes_per_sector_shift != 0 )
+			{
+				range_offset = (off64_t) partition_map_entry->sector_number << internal_volume->io_handle->bytes_per_sector_shift;
+				range_size   = (size64_t) partition_map_entry->number_of_sectors << internal_volume->io_handle->bytes_per_sector_shift;
+			}
+			else
+			{
+				range_offset = (off64_t) partition_map_entry->sector_number * internal_volume->io_handle->bytes_per_sector;
+				range_size   = (size64_t) partition_map_entry->number_of_sectors * internal_volume->io_handle->bytes_per_sector;
+			}
+
+			if( (size64_t) range_offset >= internal_volume->size )
+			{
+				continue;
+			}
+			if( range_size > ( internal_volume->size - range_offset ) )
+			{
+				range_size = internal_volume->size - range_offset;
+			}
+			/* Unallocated data is reported with partition index -1 and its offset in the volume
+			 */
+			if( libvsapm_scan_job_append_range(
+			     scan_job,
+			     -1,
+			     range_offset,
+			     range_offset,
+			     range_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append unallocated range: %d to scan job.",
+				 function,
+				 entry_index );
+
+				return( -1 );
+			}
+		}
+	}
+	if( libvsapm_scan_job_initialize_workers(
+	     scan_job,
+	     number_of_threads,
+	     internal_volume->file_io_handle,
+	     internal_volume->io_handle->memory_data,
+	     internal_volume->io_handle->memory_data_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create scan workers.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	return( result );
+	return( 1 );
 }
 
-/* Retrieves a specific partition
- * Returns 1 if successful or -1 on error
+/* Scans the data of the partitions and optionally the unallocated ranges of the volume
+ * The data is divided into chunks that are scanned by separate threads, where a thread
+ * that runs out of chunks takes over half of the remaining chunks of another thread.
+ * The callback is called for every chunk with the partition index and the offset relative
+ * to the start of the partition, or -1 and the offset relative to the start of the volume
+ * for unallocated data. The callback can be called from multiple threads at the same time,
+ * the chunk data is only valid during the callback. The callback returns 1 to continue,
+ * 0 to stop the scan or -1 on error
+ * Returns 1 if successful, 0 if the scan was stopped by the callback or -1 on error
  */
-int libvsapm_volume_get_partition_by_index(
+int libvsapm_volume_scan(
      libvsapm_volume_t *volume,
-     int partition_index,
-     libvsapm_partition_t **partition,
+     size_t chunk_size,
+     int number_of_threads,
+     uint8_t scan_flags,
+     int (*callback)(
+            int partition_index,
+            off64_t offset,
+            const uint8_t *data,
+            size_t data_size,
+            void *user_data ),
+     void *user_data,
      libcerror_error_t **error )
 {
-	libvsapm_internal_volume_t *internal_volume         = NULL;
-	libvsapm_partition_map_entry_t *partition_map_entry = NULL;
-	static char *function                               = "libvsapm_volume_get_partition_by_index";
-	int result                                          = 1;
+	libvsapm_internal_volume_t *internal_volume = NULL;
+	libvsapm_scan_job_t *scan_job               = NULL;
+	static char *function                       = "libvsapm_volume_scan";
+	int result                                  = 1;
 
 	if( volume == NULL )
 	{
@@ -1394,27 +5856,61 @@ int libvsapm_volume_get_partition_by_index(
 	}
 	internal_volume = (libvsapm_internal_volume_t *) volume;
 
-	if( partition == NULL )
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > LIBVSAPM_MAXIMUM_NUMBER_OF_SCAN_THREADS ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid partition.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( *partition != NULL )
+	if( ( scan_flags & ~( LIBVSAPM_SCAN_FLAG_UNALLOCATED ) ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported scan flags: 0x%02" PRIx8 ".",
+		 function,
+		 scan_flags );
+
+		return( -1 );
+	}
+	if( libvsapm_scan_job_initialize(
+	     &scan_job,
+	     chunk_size,
+	     callback,
+	     user_data,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid partition value already set.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create scan job.",
 		 function );
 
-		return( -1 );
+		goto on_error;
+	}
+	if( internal_volume->read_partition_map_on_demand != 0 )
+	{
+		if( libvsapm_internal_volume_read_partition_index(
+		     internal_volume,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read partition index.",
+			 function );
+
+			goto on_error;
+		}
 	}
 #if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_read(
@@ -1428,45 +5924,28 @@ int libvsapm_volume_get_partition_by_index(
 		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 #endif
-	if( libcdata_array_get_entry_by_index(
-	     internal_volume->partitions,
-	     partition_index,
-	     (intptr_t **) &partition_map_entry,
+	/* The workers read from their own clones of the file IO handle so that
+	 * the lock does not need to be held while the chunks are scanned
+	 */
+	if( libvsapm_internal_volume_initialize_scan_job(
+	     internal_volume,
+	     scan_job,
+	     number_of_threads,
+	     scan_flags,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve partition map entry: %d from array.",
-		 function,
-		 partition_index );
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize scan job.",
+		 function );
 
 		result = -1;
 	}
-	else
-	{
-		if( libvsapm_partition_initialize(
-		     partition,
-		     internal_volume->io_handle,
-		     internal_volume->file_io_handle,
-		     partition_map_entry,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create partition: %d.",
-			 function,
-			 partition_index );
-
-			result = -1;
-		}
-	}
 #if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
 	     internal_volume->read_write_lock,
@@ -1479,9 +5958,50 @@ int libvsapm_volume_get_partition_by_index(
 		 "%s: unable to release read/write lock for reading.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 #endif
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	result = libvsapm_scan_job_run(
+	          scan_job,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to run scan job.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvsapm_scan_job_free(
+	     &scan_job,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free scan job.",
+		 function );
+
+		goto on_error;
+	}
 	return( result );
+
+on_error:
+	if( scan_job != NULL )
+	{
+		libvsapm_scan_job_free(
+		 &scan_job,
+		 NULL );
+	}
+	return( -1 );
 }
 
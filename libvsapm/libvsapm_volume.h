@@ -31,7 +31,11 @@
 #include "libvsapm_libcdata.h"
 #include "libvsapm_libcerror.h"
 #include "libvsapm_libcthreads.h"
+#include "libvsapm_partition_index.h"
+#include "libvsapm_partition_map_entry.h"
+#include "libvsapm_scan_job.h"
 #include "libvsapm_types.h"
+#include "libvsapm_volume_snapshot.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -49,6 +53,44 @@ struct libvsapm_internal_volume
 	 */
 	libcdata_array_t *partitions;
 
+	/* The partition index, used to look up partitions by offset
+	 */
+	libvsapm_partition_index_t *partition_index;
+
+	/* The unallocated ranges array, contains partition map entries without name and type
+	 * for the ranges of sectors that are not part of a partition
+	 */
+	libcdata_array_t *unallocated_ranges;
+
+	/* The sector number of the partition map
+	 */
+	uint32_t partition_map_sector_number;
+
+	/* The number of sectors of the partition map
+	 */
+	uint32_t partition_map_number_of_sectors;
+
+	/* The number of entries of the partition map
+	 */
+	uint32_t partition_map_number_of_entries;
+
+	/* The maximum number of partition map entries
+	 */
+	uint32_t maximum_number_of_partition_map_entries;
+
+	/* The maximum size of the partition map
+	 */
+	size64_t maximum_partition_map_size;
+
+	/* Value to indicate if the partition map entries should be read on demand
+	 */
+	uint8_t read_partition_map_on_demand;
+
+	/* The partition map entries that are read on demand, an entry per partition
+	 * An entry that was not read yet has a number of entries of 0
+	 */
+	libvsapm_partition_map_entry_t *partition_map_entries;
+
 	/* The IO handle
 	 */
 	libvsapm_io_handle_t *io_handle;
@@ -65,10 +107,30 @@ struct libvsapm_internal_volume
 	 */
 	uint8_t file_io_handle_opened_in_library;
 
+	/* The file IO pool, used when the volume consists of multiple segment files
+	 */
+	libbfio_pool_t *file_io_pool;
+
+	/* Value to indicate if the file IO pool was created inside the library
+	 */
+	uint8_t file_io_pool_created_in_library;
+
+	/* The maximum number of open handles in a file IO pool created inside the library
+	 */
+	int maximum_number_of_open_handles;
+
 	/* Value to indicate if bytes per sector was set by library
 	 */
 	uint8_t bytes_per_sector_set_by_library;
 
+	/* The number of threads used to scan for partition map entries or 0 to read the partition map
+	 */
+	int number_of_scan_threads;
+
+	/* The immutable snapshot of the volume metadata if the volume was frozen or NULL otherwise
+	 */
+	libvsapm_volume_snapshot_t *volume_snapshot;
+
 #if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
 	/* The read/write lock
 	 */
@@ -116,16 +178,89 @@ int libvsapm_volume_open_file_io_handle(
      int access_flags,
      libcerror_error_t **error );
 
+LIBVSAPM_EXTERN \
+int libvsapm_volume_open_memory(
+     libvsapm_volume_t *volume,
+     const uint8_t *data,
+     size_t data_size,
+     int access_flags,
+     libcerror_error_t **error );
+
+LIBVSAPM_EXTERN \
+int libvsapm_volume_open_multiple(
+     libvsapm_volume_t *volume,
+     char * const filenames[],
+     int number_of_filenames,
+     int access_flags,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+LIBVSAPM_EXTERN \
+int libvsapm_volume_open_multiple_wide(
+     libvsapm_volume_t *volume,
+     wchar_t * const filenames[],
+     int number_of_filenames,
+     int access_flags,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+LIBVSAPM_EXTERN \
+int libvsapm_volume_open_file_io_pool(
+     libvsapm_volume_t *volume,
+     libbfio_pool_t *file_io_pool,
+     int access_flags,
+     libcerror_error_t **error );
+
+LIBVSAPM_EXTERN \
+int libvsapm_volume_open_scan(
+     libvsapm_volume_t *volume,
+     char const *filename,
+     int access_flags,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+LIBVSAPM_EXTERN \
+int libvsapm_volume_open_scan_wide(
+     libvsapm_volume_t *volume,
+     wchar_t const *filename,
+     int access_flags,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+LIBVSAPM_EXTERN \
+int libvsapm_volume_open_scan_file_io_handle(
+     libvsapm_volume_t *volume,
+     libbfio_handle_t *file_io_handle,
+     int access_flags,
+     int number_of_threads,
+     libcerror_error_t **error );
+
 LIBVSAPM_EXTERN \
 int libvsapm_volume_close(
      libvsapm_volume_t *volume,
      libcerror_error_t **error );
 
+LIBVSAPM_EXTERN \
+int libvsapm_volume_freeze(
+     libvsapm_volume_t *volume,
+     libcerror_error_t **error );
+
 int libvsapm_internal_volume_open_read(
      libvsapm_internal_volume_t *internal_volume,
      libbfio_handle_t *file_io_handle,
      libcerror_error_t **error );
 
+int libvsapm_internal_volume_scan_read(
+     libvsapm_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
 LIBVSAPM_EXTERN \
 int libvsapm_volume_get_bytes_per_sector(
      libvsapm_volume_t *volume,
@@ -138,12 +273,60 @@ int libvsapm_volume_set_bytes_per_sector(
      uint32_t bytes_per_sector,
      libcerror_error_t **error );
 
+LIBVSAPM_EXTERN \
+int libvsapm_volume_set_maximum_number_of_partition_map_entries(
+     libvsapm_volume_t *volume,
+     uint32_t maximum_number_of_entries,
+     libcerror_error_t **error );
+
+LIBVSAPM_EXTERN \
+int libvsapm_volume_set_maximum_partition_map_size(
+     libvsapm_volume_t *volume,
+     size64_t maximum_size,
+     libcerror_error_t **error );
+
+LIBVSAPM_EXTERN \
+int libvsapm_volume_set_sector_cache_size(
+     libvsapm_volume_t *volume,
+     size_t sector_cache_size,
+     libcerror_error_t **error );
+
+LIBVSAPM_EXTERN \
+int libvsapm_volume_set_read_partition_map_on_demand(
+     libvsapm_volume_t *volume,
+     uint8_t read_on_demand,
+     libcerror_error_t **error );
+
+LIBVSAPM_EXTERN \
+int libvsapm_volume_set_maximum_number_of_open_handles(
+     libvsapm_volume_t *volume,
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error );
+
+LIBVSAPM_EXTERN \
+int libvsapm_volume_poll_completions(
+     libvsapm_volume_t *volume,
+     int maximum_number_of_completions,
+     int *number_of_completions,
+     libcerror_error_t **error );
+
+int libvsapm_internal_volume_get_number_of_partitions(
+     libvsapm_internal_volume_t *internal_volume,
+     int *number_of_partitions,
+     libcerror_error_t **error );
+
 LIBVSAPM_EXTERN \
 int libvsapm_volume_get_number_of_partitions(
      libvsapm_volume_t *volume,
      int *number_of_partitions,
      libcerror_error_t **error );
 
+int libvsapm_internal_volume_initialize_snapshot_partition(
+     libvsapm_internal_volume_t *internal_volume,
+     libvsapm_partition_t **partition,
+     libvsapm_partition_map_entry_t *partition_map_entry,
+     libcerror_error_t **error );
+
 LIBVSAPM_EXTERN \
 int libvsapm_volume_get_partition_by_index(
      libvsapm_volume_t *volume,
@@ -151,6 +334,67 @@ int libvsapm_volume_get_partition_by_index(
      libvsapm_partition_t **partition,
      libcerror_error_t **error );
 
+LIBVSAPM_EXTERN \
+int libvsapm_volume_get_partition_index_by_offset(
+     libvsapm_volume_t *volume,
+     off64_t offset,
+     int *partition_index,
+     libcerror_error_t **error );
+
+int libvsapm_internal_volume_get_partition_map_entry_by_index(
+     libvsapm_internal_volume_t *internal_volume,
+     int partition_index,
+     libvsapm_partition_map_entry_t **partition_map_entry,
+     libcerror_error_t **error );
+
+int libvsapm_internal_volume_read_partition_index(
+     libvsapm_internal_volume_t *internal_volume,
+     libcerror_error_t **error );
+
+int libvsapm_internal_volume_read_unallocated_ranges(
+     libvsapm_internal_volume_t *internal_volume,
+     libcerror_error_t **error );
+
+LIBVSAPM_EXTERN \
+int libvsapm_volume_get_number_of_unallocated_ranges(
+     libvsapm_volume_t *volume,
+     int *number_of_unallocated_ranges,
+     libcerror_error_t **error );
+
+LIBVSAPM_EXTERN \
+int libvsapm_volume_get_unallocated_range_by_index(
+     libvsapm_volume_t *volume,
+     int unallocated_range_index,
+     libvsapm_partition_t **unallocated_range,
+     libcerror_error_t **error );
+
+LIBVSAPM_EXTERN \
+int libvsapm_volume_has_overlapping_partitions(
+     libvsapm_volume_t *volume,
+     libcerror_error_t **error );
+
+int libvsapm_internal_volume_initialize_scan_job(
+     libvsapm_internal_volume_t *internal_volume,
+     libvsapm_scan_job_t *scan_job,
+     int number_of_threads,
+     uint8_t scan_flags,
+     libcerror_error_t **error );
+
+LIBVSAPM_EXTERN \
+int libvsapm_volume_scan(
+     libvsapm_volume_t *volume,
+     size_t chunk_size,
+     int number_of_threads,
+     uint8_t scan_flags,
+     int (*callback)(
+            int partition_index,
+            off64_t offset,
+            const uint8_t *data,
+            size_t data_size,
+            void *user_data ),
+     void *user_data,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -0,0 +1,933 @@
+/*
+ * Immutable volume snapshot functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvsapm_libcdata.h"
+#include "libvsapm_libcerror.h"
+#include "libvsapm_libcthreads.h"
+#include "libvsapm_partition_index.h"
+#include "libvsapm_partition_map_entry.h"
+#include "libvsapm_volume_snapshot.h"
+
+/* Creates a volume snapshot
+ * Make sure the value volume_snapshot is referencing, is set to NULL
+ * The partition map entries are copied so that the snapshot does not depend on the volume
+ * The snapshot is created with a reference count of 1
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_volume_snapshot_initialize(
+     libvsapm_volume_snapshot_t **volume_snapshot,
+     uint32_t bytes_per_sector,
+     uint8_t bytes_per_sector_shift,
+     libcdata_array_t *partitions,
+     libcdata_array_t *unallocated_ranges,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_volume_snapshot_initialize";
+
+	if( volume_snapshot == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume snapshot.",
+		 function );
+
+		return( -1 );
+	}
+	if( *volume_snapshot != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume snapshot value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( bytes_per_sector == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid bytes per sector value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( bytes_per_sector_shift != 0 )
+	 && ( ( bytes_per_sector_shift >= 32 )
+	  || ( ( (uint32_t) 1 << bytes_per_sector_shift ) != bytes_per_sector ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid bytes per sector shift value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( partitions == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partitions array.",
+		 function );
+
+		return( -1 );
+	}
+	if( unallocated_ranges == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid unallocated ranges array.",
+		 function );
+
+		return( -1 );
+	}
+	*volume_snapshot = memory_allocate_structure(
+	                    libvsapm_volume_snapshot_t );
+
+	if( *volume_snapshot == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create volume snapshot.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *volume_snapshot,
+	     0,
+	     sizeof( libvsapm_volume_snapshot_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear volume snapshot.",
+		 function );
+
+		memory_free(
+		 *volume_snapshot );
+
+		*volume_snapshot = NULL;
+
+		return( -1 );
+	}
+	if( libcdata_array_clone(
+	     &( ( *volume_snapshot )->partitions ),
+	     partitions,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libvsapm_partition_map_entry_free,
+	     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) &libvsapm_partition_map_entry_clone,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to clone partitions array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_clone(
+	     &( ( *volume_snapshot )->unallocated_ranges ),
+	     unallocated_ranges,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libvsapm_partition_map_entry_free,
+	     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) &libvsapm_partition_map_entry_clone,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to clone unallocated ranges array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvsapm_partition_index_initialize(
+	     &( ( *volume_snapshot )->partition_index ),
+	     ( *volume_snapshot )->partitions,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create partition index.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *volume_snapshot )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_read_write_lock_initialize(
+	     &( ( *volume_snapshot )->read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *volume_snapshot )->bytes_per_sector       = bytes_per_sector;
+	( *volume_snapshot )->bytes_per_sector_shift = bytes_per_sector_shift;
+	( *volume_snapshot )->reference_count        = 1;
+
+	return( 1 );
+
+on_error:
+	if( *volume_snapshot != NULL )
+	{
+		libvsapm_volume_snapshot_free(
+		 volume_snapshot,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a volume snapshot
+ * The volume snapshot is freed regardless of its reference count, use release to drop a reference
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_volume_snapshot_free(
+     libvsapm_volume_snapshot_t **volume_snapshot,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_volume_snapshot_free";
+	int result            = 1;
+
+	if( volume_snapshot == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume snapshot.",
+		 function );
+
+		return( -1 );
+	}
+	if( *volume_snapshot != NULL )
+	{
+		if( ( *volume_snapshot )->partition_index != NULL )
+		{
+			if( libvsapm_partition_index_free(
+			     &( ( *volume_snapshot )->partition_index ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free partition index.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *volume_snapshot )->unallocated_ranges != NULL )
+		{
+			if( libcdata_array_free(
+			     &( ( *volume_snapshot )->unallocated_ranges ),
+			     (int (*)(intptr_t **, libcerror_error_t **)) &libvsapm_partition_map_entry_free,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free the unallocated ranges array.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *volume_snapshot )->partitions != NULL )
+		{
+			if( libcdata_array_free(
+			     &( ( *volume_snapshot )->partitions ),
+			     (int (*)(intptr_t **, libcerror_error_t **)) &libvsapm_partition_map_entry_free,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free the partitions array.",
+				 function );
+
+				result = -1;
+			}
+		}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+		if( ( *volume_snapshot )->mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *volume_snapshot )->mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *volume_snapshot )->read_write_lock != NULL )
+		{
+			if( libcthreads_read_write_lock_free(
+			     &( ( *volume_snapshot )->read_write_lock ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free read/write lock.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
+		memory_free(
+		 *volume_snapshot );
+
+		*volume_snapshot = NULL;
+	}
+	return( result );
+}
+
+/* Acquires a reference to a volume snapshot
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_volume_snapshot_acquire(
+     libvsapm_volume_snapshot_t *volume_snapshot,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_volume_snapshot_acquire";
+	int result            = 1;
+
+	if( volume_snapshot == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume snapshot.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     volume_snapshot->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( volume_snapshot->reference_count <= 0 )
+	 || ( volume_snapshot->reference_count == INT_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid volume snapshot - reference count value out of bounds.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		volume_snapshot->reference_count += 1;
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     volume_snapshot->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Releases a reference to a volume snapshot
+ * The volume snapshot is freed when the last reference is released
+ * The value volume_snapshot is referencing is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_volume_snapshot_release(
+     libvsapm_volume_snapshot_t **volume_snapshot,
+     libcerror_error_t **error )
+{
+	libvsapm_volume_snapshot_t *safe_volume_snapshot = NULL;
+	static char *function                            = "libvsapm_volume_snapshot_release";
+	int reference_count                              = 0;
+
+	if( volume_snapshot == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume snapshot.",
+		 function );
+
+		return( -1 );
+	}
+	if( *volume_snapshot == NULL )
+	{
+		return( 1 );
+	}
+	safe_volume_snapshot = *volume_snapshot;
+	*volume_snapshot     = NULL;
+
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     safe_volume_snapshot->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( safe_volume_snapshot->reference_count > 0 )
+	{
+		safe_volume_snapshot->reference_count -= 1;
+	}
+	reference_count = safe_volume_snapshot->reference_count;
+
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     safe_volume_snapshot->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( reference_count == 0 )
+	{
+		if( libvsapm_volume_snapshot_free(
+		     &safe_volume_snapshot,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free volume snapshot.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Marks the volume of the snapshot as closed
+ * Waits for partition data that is being read to complete, after which the
+ * partition data can no longer be read
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_volume_snapshot_close(
+     libvsapm_volume_snapshot_t *volume_snapshot,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_volume_snapshot_close";
+
+	if( volume_snapshot == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume snapshot.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     volume_snapshot->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	volume_snapshot->is_closed = 1;
+
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     volume_snapshot->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Grabs the volume snapshot for reading partition data
+ * The volume cannot be closed until libvsapm_volume_snapshot_release_for_read is called
+ * Returns 1 if successful, 0 if the volume was closed or -1 on error
+ */
+int libvsapm_volume_snapshot_grab_for_read(
+     libvsapm_volume_snapshot_t *volume_snapshot,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_volume_snapshot_grab_for_read";
+
+	if( volume_snapshot == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume snapshot.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     volume_snapshot->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( volume_snapshot->is_closed != 0 )
+	{
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_release_for_read(
+		     volume_snapshot->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for reading.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Releases the volume snapshot after reading partition data
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_volume_snapshot_release_for_read(
+     libvsapm_volume_snapshot_t *volume_snapshot,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_volume_snapshot_release_for_read";
+
+	if( volume_snapshot == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume snapshot.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     volume_snapshot->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the number of partitions
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_volume_snapshot_get_number_of_partitions(
+     libvsapm_volume_snapshot_t *volume_snapshot,
+     int *number_of_partitions,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_volume_snapshot_get_number_of_partitions";
+
+	if( volume_snapshot == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume snapshot.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     volume_snapshot->partitions,
+	     number_of_partitions,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of partitions from array.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves a specific partition map entry
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_volume_snapshot_get_partition_map_entry_by_index(
+     libvsapm_volume_snapshot_t *volume_snapshot,
+     int partition_index,
+     libvsapm_partition_map_entry_t **partition_map_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_volume_snapshot_get_partition_map_entry_by_index";
+
+	if( volume_snapshot == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume snapshot.",
+		 function );
+
+		return( -1 );
+	}
+	if( partition_map_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition map entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_entry_by_index(
+	     volume_snapshot->partitions,
+	     partition_index,
+	     (intptr_t **) partition_map_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve partition map entry: %d from array.",
+		 function,
+		 partition_index );
+
+		return( -1 );
+	}
+	if( *partition_map_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing partition map entry: %d.",
+		 function,
+		 partition_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the index of the partition that contains a specific offset
+ * The offset is relative to the start of the volume
+ * Returns 1 if successful, 0 if no partition contains the offset or -1 on error
+ */
+int libvsapm_volume_snapshot_get_partition_index_by_offset(
+     libvsapm_volume_snapshot_t *volume_snapshot,
+     off64_t offset,
+     int *partition_index,
+     libcerror_error_t **error )
+{
+	static char *function  = "libvsapm_volume_snapshot_get_partition_index_by_offset";
+	uint64_t sector_number = 0;
+	int result             = 0;
+
+	if( volume_snapshot == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume snapshot.",
+		 function );
+
+		return( -1 );
+	}
+	if( volume_snapshot->bytes_per_sector == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid volume snapshot - bytes per sector value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( volume_snapshot->bytes_per_sector_shift != 0 )
+	{
+		sector_number = (uint64_t) offset >> volume_snapshot->bytes_per_sector_shift;
+	}
+	else
+	{
+		sector_number = (uint64_t) offset / volume_snapshot->bytes_per_sector;
+	}
+
+	result = libvsapm_partition_index_get_partition_index_by_sector_number(
+	          volume_snapshot->partition_index,
+	          sector_number,
+	          partition_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve partition index for sector: %" PRIu64 ".",
+		 function,
+		 sector_number );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Retrieves the number of unallocated ranges
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_volume_snapshot_get_number_of_unallocated_ranges(
+     libvsapm_volume_snapshot_t *volume_snapshot,
+     int *number_of_unallocated_ranges,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_volume_snapshot_get_number_of_unallocated_ranges";
+
+	if( volume_snapshot == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume snapshot.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     volume_snapshot->unallocated_ranges,
+	     number_of_unallocated_ranges,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of unallocated ranges from array.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the partition map entry of a specific unallocated range
+ * Returns 1 if successful or -1 on error
+ */
+int libvsapm_volume_snapshot_get_unallocated_range_by_index(
+     libvsapm_volume_snapshot_t *volume_snapshot,
+     int unallocated_range_index,
+     libvsapm_partition_map_entry_t **partition_map_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_volume_snapshot_get_unallocated_range_by_index";
+
+	if( volume_snapshot == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume snapshot.",
+		 function );
+
+		return( -1 );
+	}
+	if( partition_map_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition map entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_entry_by_index(
+	     volume_snapshot->unallocated_ranges,
+	     unallocated_range_index,
+	     (intptr_t **) partition_map_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve unallocated range: %d from array.",
+		 function,
+		 unallocated_range_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
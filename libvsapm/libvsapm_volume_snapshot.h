@@ -0,0 +1,149 @@
+/*
+ * Immutable volume snapshot functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVSAPM_VOLUME_SNAPSHOT_H )
+#define _LIBVSAPM_VOLUME_SNAPSHOT_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvsapm_libcdata.h"
+#include "libvsapm_libcerror.h"
+#include "libvsapm_libcthreads.h"
+#include "libvsapm_partition_index.h"
+#include "libvsapm_partition_map_entry.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvsapm_volume_snapshot libvsapm_volume_snapshot_t;
+
+struct libvsapm_volume_snapshot
+{
+	/* The number of bytes per sector
+	 */
+	uint32_t bytes_per_sector;
+
+	/* The number of bytes per sector as a power of 2
+	 * or 0 if the number of bytes per sector is not a power of 2
+	 */
+	uint8_t bytes_per_sector_shift;
+
+	/* The partitions array
+	 */
+	libcdata_array_t *partitions;
+
+	/* The unallocated ranges array
+	 */
+	libcdata_array_t *unallocated_ranges;
+
+	/* The partition index
+	 */
+	libvsapm_partition_index_t *partition_index;
+
+	/* The number of references to the snapshot
+	 */
+	int reference_count;
+
+	/* Value to indicate the volume was closed
+	 * The IO of the volume is freed when it is closed, hence partitions can no longer be read
+	 */
+	uint8_t is_closed;
+
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT )
+	/* The mutex that protects the reference count
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The read/write lock that is held for reading while partition data is read
+	 * and for writing when the volume is closed
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
+};
+
+int libvsapm_volume_snapshot_initialize(
+     libvsapm_volume_snapshot_t **volume_snapshot,
+     uint32_t bytes_per_sector,
+     uint8_t bytes_per_sector_shift,
+     libcdata_array_t *partitions,
+     libcdata_array_t *unallocated_ranges,
+     libcerror_error_t **error );
+
+int libvsapm_volume_snapshot_free(
+     libvsapm_volume_snapshot_t **volume_snapshot,
+     libcerror_error_t **error );
+
+int libvsapm_volume_snapshot_acquire(
+     libvsapm_volume_snapshot_t *volume_snapshot,
+     libcerror_error_t **error );
+
+int libvsapm_volume_snapshot_release(
+     libvsapm_volume_snapshot_t **volume_snapshot,
+     libcerror_error_t **error );
+
+int libvsapm_volume_snapshot_close(
+     libvsapm_volume_snapshot_t *volume_snapshot,
+     libcerror_error_t **error );
+
+int libvsapm_volume_snapshot_grab_for_read(
+     libvsapm_volume_snapshot_t *volume_snapshot,
+     libcerror_error_t **error );
+
+int libvsapm_volume_snapshot_release_for_read(
+     libvsapm_volume_snapshot_t *volume_snapshot,
+     libcerror_error_t **error );
+
+int libvsapm_volume_snapshot_get_number_of_partitions(
+     libvsapm_volume_snapshot_t *volume_snapshot,
+     int *number_of_partitions,
+     libcerror_error_t **error );
+
+int libvsapm_volume_snapshot_get_partition_map_entry_by_index(
+     libvsapm_volume_snapshot_t *volume_snapshot,
+     int partition_index,
+     libvsapm_partition_map_entry_t **partition_map_entry,
+     libcerror_error_t **error );
+
+int libvsapm_volume_snapshot_get_partition_index_by_offset(
+     libvsapm_volume_snapshot_t *volume_snapshot,
+     off64_t offset,
+     int *partition_index,
+     libcerror_error_t **error );
+
+int libvsapm_volume_snapshot_get_number_of_unallocated_ranges(
+     libvsapm_volume_snapshot_t *volume_snapshot,
+     int *number_of_unallocated_ranges,
+     libcerror_error_t **error );
+
+int libvsapm_volume_snapshot_get_unallocated_range_by_index(
+     libvsapm_volume_snapshot_t *volume_snapshot,
+     int unallocated_range_index,
+     libvsapm_partition_map_entry_t **partition_map_entry,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSAPM_VOLUME_SNAPSHOT_H ) */
+
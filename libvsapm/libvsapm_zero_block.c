@@ -0,0 +1,177 @@
+/*
+ * Zero block functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <types.h>
+
+#if defined( __AVX2__ )
+#include <immintrin.h>
+
+#define LIBVSAPM_ZERO_BLOCK_VECTOR_SIZE		32
+
+#elif defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && ( _M_IX86_FP >= 2 ) )
+#include <emmintrin.h>
+
+#define LIBVSAPM_ZERO_BLOCK_VECTOR_SIZE		16
+
+#endif
+
+#include "libvsapm_libcerror.h"
+#include "libvsapm_zero_block.h"
+
+/* Determines if a block of data only contains zero bytes
+ * The bulk of the data is checked using AVX2 or SSE2 when the compiler targets
+ * these instruction sets, otherwise the data is checked 64-bits at a time
+ * Returns 1 if the block only contains zero bytes, 0 if not or -1 on error
+ */
+int libvsapm_zero_block_check(
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvsapm_zero_block_check";
+	size_t data_offset    = 0;
+	uint64_t value_64bit  = 0;
+
+#if defined( __AVX2__ )
+	__m256i vector_value;
+#elif defined( LIBVSAPM_ZERO_BLOCK_VECTOR_SIZE )
+	__m128i vector_value;
+	__m128i zero_vector;
+#endif
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( LIBVSAPM_ZERO_BLOCK_VECTOR_SIZE )
+	/* Check the bytes up to the first vector aligned offset
+	 */
+	while( ( data_offset < data_size )
+	    && ( ( (intptr_t) &( data[ data_offset ] ) % LIBVSAPM_ZERO_BLOCK_VECTOR_SIZE ) != 0 ) )
+	{
+		if( data[ data_offset ] != 0 )
+		{
+			return( 0 );
+		}
+		data_offset++;
+	}
+#if defined( __AVX2__ )
+	while( ( data_offset + ( 4 * LIBVSAPM_ZERO_BLOCK_VECTOR_SIZE ) ) <= data_size )
+	{
+		vector_value = _mm256_or_si256(
+		                _mm256_or_si256(
+		                 _mm256_load_si256( (const __m256i *) &( data[ data_offset ] ) ),
+		                 _mm256_load_si256( (const __m256i *) &( data[ data_offset + 32 ] ) ) ),
+		                _mm256_or_si256(
+		                 _mm256_load_si256( (const __m256i *) &( data[ data_offset + 64 ] ) ),
+		                 _mm256_load_si256( (const __m256i *) &( data[ data_offset + 96 ] ) ) ) );
+
+		if( _mm256_testz_si256(
+		     vector_value,
+		     vector_value ) == 0 )
+		{
+			return( 0 );
+		}
+		data_offset += 4 * LIBVSAPM_ZERO_BLOCK_VECTOR_SIZE;
+	}
+#else
+	zero_vector = _mm_setzero_si128();
+
+	while( ( data_offset + ( 4 * LIBVSAPM_ZERO_BLOCK_VECTOR_SIZE ) ) <= data_size )
+	{
+		vector_value = _mm_or_si128(
+		                _mm_or_si128(
+		                 _mm_load_si128( (const __m128i *) &( data[ data_offset ] ) ),
+		                 _mm_load_si128( (const __m128i *) &( data[ data_offset + 16 ] ) ) ),
+		                _mm_or_si128(
+		                 _mm_load_si128( (const __m128i *) &( data[ data_offset + 32 ] ) ),
+		                 _mm_load_si128( (const __m128i *) &( data[ data_offset + 48 ] ) ) ) );
+
+		if( _mm_movemask_epi8(
+		     _mm_cmpeq_epi8(
+		      vector_value,
+		      zero_vector ) ) != 0xffff )
+		{
+			return( 0 );
+		}
+		data_offset += 4 * LIBVSAPM_ZERO_BLOCK_VECTOR_SIZE;
+	}
+#endif /* defined( __AVX2__ ) */
+
+#else
+	/* Check the bytes up to the first 64-bit aligned offset
+	 */
+	while( ( data_offset < data_size )
+	    && ( ( (intptr_t) &( data[ data_offset ] ) % sizeof( uint64_t ) ) != 0 ) )
+	{
+		if( data[ data_offset ] != 0 )
+		{
+			return( 0 );
+		}
+		data_offset++;
+	}
+#endif /* defined( LIBVSAPM_ZERO_BLOCK_VECTOR_SIZE ) */
+
+	/* The data offset is 64-bit aligned at this point
+	 */
+	while( ( data_offset + ( 4 * sizeof( uint64_t ) ) ) <= data_size )
+	{
+		value_64bit = ( (const uint64_t *) &( data[ data_offset ] ) )[ 0 ]
+		            | ( (const uint64_t *) &( data[ data_offset ] ) )[ 1 ]
+		            | ( (const uint64_t *) &( data[ data_offset ] ) )[ 2 ]
+		            | ( (const uint64_t *) &( data[ data_offset ] ) )[ 3 ];
+
+		if( value_64bit != 0 )
+		{
+			return( 0 );
+		}
+		data_offset += 4 * sizeof( uint64_t );
+	}
+	while( data_offset < data_size )
+	{
+		if( data[ data_offset ] != 0 )
+		{
+			return( 0 );
+		}
+		data_offset++;
+	}
+	return( 1 );
+}
+
@@ -1,5 +1,5 @@
 /*
- * The libfcache header wrapper
+ * Zero block functions
  *
  * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
  *
@@ -19,32 +19,26 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
-#if !defined( _LIBVSAPM_LIBFCACHE_H )
-#define _LIBVSAPM_LIBFCACHE_H
+#if !defined( _LIBVSAPM_ZERO_BLOCK_H )
+#define _LIBVSAPM_ZERO_BLOCK_H
 
 #include <common.h>
+#include <types.h>
 
-/* Define HAVE_LOCAL_LIBFCACHE for local use of libfcache
- */
-#if defined( HAVE_LOCAL_LIBFCACHE )
-
-#include <libfcache_cache.h>
-#include <libfcache_date_time.h>
-#include <libfcache_definitions.h>
-#include <libfcache_types.h>
-
-#else
+#include "libvsapm_libcerror.h"
 
-/* If libtool DLL support is enabled set LIBFCACHE_DLL_IMPORT
- * before including libfcache.h
- */
-#if defined( _WIN32 ) && defined( DLL_IMPORT )
-#define LIBFCACHE_DLL_IMPORT
+#if defined( __cplusplus )
+extern "C" {
 #endif
 
-#include <libfcache.h>
+int libvsapm_zero_block_check(
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
 
-#endif /* defined( HAVE_LOCAL_LIBFCACHE ) */
+#if defined( __cplusplus )
+}
+#endif
 
-#endif /* !defined( _LIBVSAPM_LIBFCACHE_H ) */
+#endif /* !defined( _LIBVSAPM_ZERO_BLOCK_H ) */
 
@@ -47,6 +47,8 @@ int LLVMFuzzerTestOneInput(
      const uint8_t *data,
      size_t size )
 {
+	uint8_t buffer[ 512 ];
+
 	libbfio_handle_t *file_io_handle = NULL;
 	libvsapm_partition_t *partition  = NULL;
 	libvsapm_volume_t *volume        = NULL;
@@ -95,6 +97,12 @@ int LLVMFuzzerTestOneInput(
 		     &partition,
 		     NULL ) == 1 )
 		{
+			libvsapm_partition_read_buffer(
+			 partition,
+			 buffer,
+			 512,
+			 NULL );
+
 			libvsapm_partition_free(
 			 &partition,
 			 NULL );
@@ -28,6 +28,7 @@
 #endif
 
 #include "pyvsapm.h"
+#include "pyvsapm_chunks.h"
 #include "pyvsapm_error.h"
 #include "pyvsapm_file_object_io_handle.h"
 #include "pyvsapm_libbfio.h"
@@ -605,6 +606,23 @@ PyMODINIT_FUNC initpyvsapm(
 #endif
 	gil_state = PyGILState_Ensure();
 
+	/* Setup the chunks type object
+	 */
+	pyvsapm_chunks_type_object.tp_new = PyType_GenericNew;
+
+	if( PyType_Ready(
+	     &pyvsapm_chunks_type_object ) < 0 )
+	{
+		goto on_error;
+	}
+	Py_IncRef(
+	 (PyObject *) &pyvsapm_chunks_type_object );
+
+	PyModule_AddObject(
+	 module,
+	 "chunks",
+	 (PyObject *) &pyvsapm_chunks_type_object );
+
 	/* Setup the partition type object
 	 */
 	pyvsapm_partition_type_object.tp_new = PyType_GenericNew;
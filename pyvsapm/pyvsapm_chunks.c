@@ -0,0 +1,998 @@
+/*
+ * Python object definition of the iterator object of partition data chunks
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( HAVE_WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "pyvsapm_chunks.h"
+#include "pyvsapm_error.h"
+#include "pyvsapm_libcerror.h"
+#include "pyvsapm_libcthreads.h"
+#include "pyvsapm_libvsapm.h"
+#include "pyvsapm_python.h"
+
+PyTypeObject pyvsapm_chunks_type_object = {
+	PyVarObject_HEAD_INIT( NULL, 0 )
+
+	/* tp_name */
+	"pyvsapm.chunks",
+	/* tp_basicsize */
+	sizeof( pyvsapm_chunks_t ),
+	/* tp_itemsize */
+	0,
+	/* tp_dealloc */
+	(destructor) pyvsapm_chunks_free,
+	/* tp_print */
+	0,
+	/* tp_getattr */
+	0,
+	/* tp_setattr */
+	0,
+	/* tp_compare */
+	0,
+	/* tp_repr */
+	0,
+	/* tp_as_number */
+	0,
+	/* tp_as_sequence */
+	0,
+	/* tp_as_mapping */
+	0,
+	/* tp_hash */
+	0,
+	/* tp_call */
+	0,
+	/* tp_str */
+	0,
+	/* tp_getattro */
+	0,
+	/* tp_setattro */
+	0,
+	/* tp_as_buffer */
+	0,
+	/* tp_flags */
+	Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_ITER,
+	/* tp_doc */
+	"pyvsapm iterator object of partition data chunks",
+	/* tp_traverse */
+	0,
+	/* tp_clear */
+	0,
+	/* tp_richcompare */
+	0,
+	/* tp_weaklistoffset */
+	0,
+	/* tp_iter */
+	(getiterfunc) pyvsapm_chunks_iter,
+	/* tp_iternext */
+	(iternextfunc) pyvsapm_chunks_iternext,
+	/* tp_methods */
+	0,
+	/* tp_members */
+	0,
+	/* tp_getset */
+	0,
+	/* tp_base */
+	0,
+	/* tp_dict */
+	0,
+	/* tp_descr_get */
+	0,
+	/* tp_descr_set */
+	0,
+	/* tp_dictoffset */
+	0,
+	/* tp_init */
+	(initproc) pyvsapm_chunks_init,
+	/* tp_alloc */
+	0,
+	/* tp_new */
+	0,
+	/* tp_free */
+	0,
+	/* tp_is_gc */
+	0,
+	/* tp_bases */
+	NULL,
+	/* tp_mro */
+	NULL,
+	/* tp_cache */
+	NULL,
+	/* tp_subclasses */
+	NULL,
+	/* tp_weaklist */
+	NULL,
+	/* tp_del */
+	0
+};
+
+/* Reads a chunk into a buffer
+ * This function does not use the Python API and can be called without holding the GIL
+ * Returns 1 if successful or -1 on error
+ */
+int pyvsapm_chunks_read_buffer(
+     pyvsapm_chunks_t *chunks_object,
+     uint8_t *buffer,
+     off64_t offset,
+     size_t *read_count,
+     libcerror_error_t **error )
+{
+	static char *function   = "pyvsapm_chunks_read_buffer";
+	size64_t remaining_size = 0;
+	size_t read_size        = 0;
+	ssize_t result          = 0;
+
+	if( chunks_object == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunks object.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_count == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read count.",
+		 function );
+
+		return( -1 );
+	}
+	remaining_size = chunks_object->partition_size - (size64_t) offset;
+	read_size      = chunks_object->chunk_size;
+
+	if( (size64_t) read_size > remaining_size )
+	{
+		read_size = (size_t) remaining_size;
+	}
+	result = libvsapm_partition_read_buffer_at_offset(
+	          chunks_object->partition,
+	          buffer,
+	          read_size,
+	          offset,
+	          error );
+
+	if( result != (ssize_t) read_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	*read_count = read_size;
+
+	return( 1 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Prefetches chunks into the free buffers of the ring
+ * This function runs on a native thread and does not use the Python API
+ * Returns 1 if successful or -1 on error
+ */
+int pyvsapm_chunks_prefetch_thread_function(
+     pyvsapm_chunks_t *chunks_object )
+{
+	libcerror_error_t *error = NULL;
+	uint8_t *buffer          = NULL;
+	static char *function    = "pyvsapm_chunks_prefetch_thread_function";
+	off64_t prefetch_offset  = 0;
+	size_t read_count        = 0;
+	int buffer_index         = 0;
+	int result               = 1;
+
+	if( chunks_object == NULL )
+	{
+		return( -1 );
+	}
+	while( result == 1 )
+	{
+		if( libcthreads_mutex_grab(
+		     chunks_object->condition_mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab condition mutex.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+		while( ( chunks_object->abort == 0 )
+		    && ( chunks_object->number_of_free_buffers == 0 )
+		    && ( (size64_t) chunks_object->prefetch_offset < chunks_object->partition_size ) )
+		{
+			if( libcthreads_condition_wait(
+			     chunks_object->buffer_freed_condition,
+			     chunks_object->condition_mutex,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to wait for buffer freed condition.",
+				 function );
+
+				result = -1;
+
+				break;
+			}
+		}
+		if( ( result == 1 )
+		 && ( chunks_object->abort == 0 )
+		 && ( (size64_t) chunks_object->prefetch_offset < chunks_object->partition_size ) )
+		{
+			buffer_index    = chunks_object->write_buffer_index;
+			buffer          = chunks_object->buffers[ buffer_index ];
+			prefetch_offset = chunks_object->prefetch_offset;
+
+			chunks_object->number_of_free_buffers -= 1;
+		}
+		else
+		{
+			buffer = NULL;
+		}
+		if( libcthreads_mutex_release(
+		     chunks_object->condition_mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release condition mutex.",
+			 function );
+
+			result = -1;
+		}
+		if( ( result != 1 )
+		 || ( buffer == NULL ) )
+		{
+			break;
+		}
+		/* The buffer is owned by the prefetch thread until it is marked as filled
+		 */
+		result = pyvsapm_chunks_read_buffer(
+		          chunks_object,
+		          buffer,
+		          prefetch_offset,
+		          &read_count,
+		          &error );
+
+		if( libcthreads_mutex_grab(
+		     chunks_object->condition_mutex,
+		     NULL ) != 1 )
+		{
+			result = -1;
+
+			break;
+		}
+		if( result == 1 )
+		{
+			chunks_object->read_counts[ buffer_index ] = read_count;
+			chunks_object->write_buffer_index          = ( buffer_index + 1 ) % chunks_object->number_of_buffers;
+			chunks_object->prefetch_offset            += (off64_t) read_count;
+			chunks_object->number_of_filled_buffers   += 1;
+		}
+		libcthreads_condition_broadcast(
+		 chunks_object->buffer_filled_condition,
+		 NULL );
+
+		libcthreads_mutex_release(
+		 chunks_object->condition_mutex,
+		 NULL );
+	}
+	if( libcthreads_mutex_grab(
+	     chunks_object->condition_mutex,
+	     NULL ) == 1 )
+	{
+		if( result != 1 )
+		{
+			chunks_object->prefetch_error = error;
+
+			error = NULL;
+		}
+		chunks_object->prefetch_done = 1;
+
+		libcthreads_condition_broadcast(
+		 chunks_object->buffer_filled_condition,
+		 NULL );
+
+		libcthreads_mutex_release(
+		 chunks_object->condition_mutex,
+		 NULL );
+	}
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* Creates a new chunks iterator object
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyvsapm_chunks_new(
+           libvsapm_partition_t *partition,
+           PyObject *parent_object,
+           size_t chunk_size,
+           int prefetch )
+{
+	pyvsapm_chunks_t *chunks_object = NULL;
+	libcerror_error_t *error        = NULL;
+	static char *function           = "pyvsapm_chunks_new";
+	size64_t partition_size         = 0;
+	int buffer_index                = 0;
+	int result                      = 0;
+
+	if( partition == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid partition.",
+		 function );
+
+		return( NULL );
+	}
+	if( ( chunk_size == 0 )
+	 || ( chunk_size > (size_t) INT_MAX ) )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid chunk size value out of bounds.",
+		 function );
+
+		return( NULL );
+	}
+	if( ( prefetch < 0 )
+	 || ( prefetch > PYVSAPM_CHUNKS_MAXIMUM_PREFETCH ) )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid prefetch value out of bounds.",
+		 function );
+
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libvsapm_partition_get_size(
+	          partition,
+	          &partition_size,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pyvsapm_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to retrieve size.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+	/* PyObject_New does not invoke tp_init
+	 */
+	chunks_object = PyObject_New(
+	                 struct pyvsapm_chunks,
+	                 &pyvsapm_chunks_type_object );
+
+	if( chunks_object == NULL )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to create chunks object.",
+		 function );
+
+		goto on_error;
+	}
+	chunks_object->partition                = partition;
+	chunks_object->parent_object            = parent_object;
+	chunks_object->chunk_size               = chunk_size;
+	chunks_object->partition_size           = partition_size;
+	chunks_object->current_offset           = 0;
+	chunks_object->prefetch_offset          = 0;
+	chunks_object->number_of_buffers        = prefetch + 1;
+	chunks_object->buffer_objects           = NULL;
+	chunks_object->buffers                  = NULL;
+	chunks_object->read_counts              = NULL;
+	chunks_object->read_buffer_index        = 0;
+	chunks_object->write_buffer_index       = 0;
+	chunks_object->held_buffer_index        = -1;
+	chunks_object->number_of_filled_buffers = 0;
+	chunks_object->number_of_free_buffers   = prefetch + 1;
+	chunks_object->prefetch_done            = 0;
+	chunks_object->abort                    = 0;
+	chunks_object->prefetch_error           = NULL;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	chunks_object->prefetch_thread          = NULL;
+	chunks_object->condition_mutex          = NULL;
+	chunks_object->buffer_filled_condition  = NULL;
+	chunks_object->buffer_freed_condition   = NULL;
+#else
+	/* Without native threads there is nothing to prefetch into
+	 */
+	chunks_object->number_of_buffers        = 1;
+	chunks_object->number_of_free_buffers   = 1;
+#endif
+	if( chunks_object->parent_object != NULL )
+	{
+		Py_IncRef(
+		 chunks_object->parent_object );
+	}
+	chunks_object->buffer_objects = (PyObject **) PyMem_Malloc(
+	                                               sizeof( PyObject * ) * chunks_object->number_of_buffers );
+
+	chunks_object->buffers = (uint8_t **) PyMem_Malloc(
+	                                       sizeof( uint8_t * ) * chunks_object->number_of_buffers );
+
+	chunks_object->read_counts = (size_t *) PyMem_Malloc(
+	                                         sizeof( size_t ) * chunks_object->number_of_buffers );
+
+	if( ( chunks_object->buffer_objects == NULL )
+	 || ( chunks_object->buffers == NULL )
+	 || ( chunks_object->read_counts == NULL ) )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to create buffers.",
+		 function );
+
+		goto on_error;
+	}
+	for( buffer_index = 0;
+	     buffer_index < chunks_object->number_of_buffers;
+	     buffer_index++ )
+	{
+		chunks_object->buffer_objects[ buffer_index ] = NULL;
+	}
+	for( buffer_index = 0;
+	     buffer_index < chunks_object->number_of_buffers;
+	     buffer_index++ )
+	{
+		chunks_object->buffer_objects[ buffer_index ] = PyByteArray_FromStringAndSize(
+		                                                 NULL,
+		                                                 (Py_ssize_t) chunk_size );
+
+		if( chunks_object->buffer_objects[ buffer_index ] == NULL )
+		{
+			goto on_error;
+		}
+		chunks_object->buffers[ buffer_index ] = (uint8_t *) PyByteArray_AsString(
+		                                                      chunks_object->buffer_objects[ buffer_index ] );
+
+		chunks_object->read_counts[ buffer_index ] = 0;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( chunks_object->condition_mutex ),
+	     &error ) != 1 )
+	{
+		pyvsapm_error_raise(
+		 error,
+		 PyExc_MemoryError,
+		 "%s: unable to initialize condition mutex.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( chunks_object->buffer_filled_condition ),
+	     &error ) != 1 )
+	{
+		pyvsapm_error_raise(
+		 error,
+		 PyExc_MemoryError,
+		 "%s: unable to initialize buffer filled condition.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( chunks_object->buffer_freed_condition ),
+	     &error ) != 1 )
+	{
+		pyvsapm_error_raise(
+		 error,
+		 PyExc_MemoryError,
+		 "%s: unable to initialize buffer freed condition.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		goto on_error;
+	}
+	if( libcthreads_thread_create(
+	     &( chunks_object->prefetch_thread ),
+	     NULL,
+	     (int (*)(void *)) &pyvsapm_chunks_prefetch_thread_function,
+	     (void *) chunks_object,
+	     &error ) != 1 )
+	{
+		pyvsapm_error_raise(
+		 error,
+		 PyExc_RuntimeError,
+		 "%s: unable to create prefetch thread.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		goto on_error;
+	}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	return( (PyObject *) chunks_object );
+
+on_error:
+	if( chunks_object != NULL )
+	{
+		Py_DecRef(
+		 (PyObject *) chunks_object );
+	}
+	return( NULL );
+}
+
+/* Initializes a chunks iterator object
+ * Returns 0 if successful or -1 on error
+ */
+int pyvsapm_chunks_init(
+     pyvsapm_chunks_t *chunks_object )
+{
+	static char *function = "pyvsapm_chunks_init";
+
+	if( chunks_object == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid chunks object.",
+		 function );
+
+		return( -1 );
+	}
+	/* Make sure the chunks values are initialized
+	 */
+	chunks_object->partition      = NULL;
+	chunks_object->parent_object  = NULL;
+	chunks_object->buffer_objects = NULL;
+	chunks_object->buffers        = NULL;
+	chunks_object->read_counts    = NULL;
+	chunks_object->prefetch_error = NULL;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	chunks_object->prefetch_thread         = NULL;
+	chunks_object->condition_mutex         = NULL;
+	chunks_object->buffer_filled_condition = NULL;
+	chunks_object->buffer_freed_condition  = NULL;
+#endif
+	PyErr_Format(
+	 PyExc_NotImplementedError,
+	 "%s: initialize of chunks not supported.",
+	 function );
+
+	return( -1 );
+}
+
+/* Frees a chunks iterator object
+ */
+void pyvsapm_chunks_free(
+      pyvsapm_chunks_t *chunks_object )
+{
+	struct _typeobject *ob_type = NULL;
+	static char *function       = "pyvsapm_chunks_free";
+	int buffer_index            = 0;
+
+	if( chunks_object == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid chunks object.",
+		 function );
+
+		return;
+	}
+	ob_type = Py_TYPE(
+	           chunks_object );
+
+	if( ob_type == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: missing ob_type.",
+		 function );
+
+		return;
+	}
+	if( ob_type->tp_free == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid ob_type - missing tp_free.",
+		 function );
+
+		return;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( chunks_object->prefetch_thread != NULL )
+	{
+		Py_BEGIN_ALLOW_THREADS
+
+		if( libcthreads_mutex_grab(
+		     chunks_object->condition_mutex,
+		     NULL ) == 1 )
+		{
+			chunks_object->abort = 1;
+
+			libcthreads_condition_broadcast(
+			 chunks_object->buffer_freed_condition,
+			 NULL );
+
+			libcthreads_mutex_release(
+			 chunks_object->condition_mutex,
+			 NULL );
+		}
+		libcthreads_thread_join(
+		 &( chunks_object->prefetch_thread ),
+		 NULL );
+
+		Py_END_ALLOW_THREADS
+	}
+	if( chunks_object->buffer_freed_condition != NULL )
+	{
+		libcthreads_condition_free(
+		 &( chunks_object->buffer_freed_condition ),
+		 NULL );
+	}
+	if( chunks_object->buffer_filled_condition != NULL )
+	{
+		libcthreads_condition_free(
+		 &( chunks_object->buffer_filled_condition ),
+		 NULL );
+	}
+	if( chunks_object->condition_mutex != NULL )
+	{
+		libcthreads_mutex_free(
+		 &( chunks_object->condition_mutex ),
+		 NULL );
+	}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	if( chunks_object->prefetch_error != NULL )
+	{
+		libcerror_error_free(
+		 &( chunks_object->prefetch_error ) );
+	}
+	if( chunks_object->buffer_objects != NULL )
+	{
+		for( buffer_index = 0;
+		     buffer_index < chunks_object->number_of_buffers;
+		     buffer_index++ )
+		{
+			if( chunks_object->buffer_objects[ buffer_index ] != NULL )
+			{
+				Py_DecRef(
+				 chunks_object->buffer_objects[ buffer_index ] );
+			}
+		}
+		PyMem_Free(
+		 chunks_object->buffer_objects );
+	}
+	if( chunks_object->buffers != NULL )
+	{
+		PyMem_Free(
+		 chunks_object->buffers );
+	}
+	if( chunks_object->read_counts != NULL )
+	{
+		PyMem_Free(
+		 chunks_object->read_counts );
+	}
+	if( chunks_object->parent_object != NULL )
+	{
+		Py_DecRef(
+		 chunks_object->parent_object );
+	}
+	ob_type->tp_free(
+	 (PyObject*) chunks_object );
+}
+
+/* Releases the buffer that was returned last so it can be reused
+ * If the caller still references the previous chunk the buffer is replaced
+ * by a new one, so the data of returned chunks is never overwritten
+ * Returns 1 if successful or -1 on error
+ */
+int pyvsapm_chunks_release_buffer(
+     pyvsapm_chunks_t *chunks_object )
+{
+	PyObject *buffer_object = NULL;
+	static char *function   = "pyvsapm_chunks_release_buffer";
+	int buffer_index        = 0;
+
+	if( chunks_object == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid chunks object.",
+		 function );
+
+		return( -1 );
+	}
+	buffer_index = chunks_object->held_buffer_index;
+
+	if( buffer_index < 0 )
+	{
+		return( 1 );
+	}
+	if( Py_REFCNT( chunks_object->buffer_objects[ buffer_index ] ) > 1 )
+	{
+		buffer_object = PyByteArray_FromStringAndSize(
+		                 NULL,
+		                 (Py_ssize_t) chunks_object->chunk_size );
+
+		if( buffer_object == NULL )
+		{
+			return( -1 );
+		}
+		Py_DecRef(
+		 chunks_object->buffer_objects[ buffer_index ] );
+
+		chunks_object->buffer_objects[ buffer_index ] = buffer_object;
+		chunks_object->buffers[ buffer_index ]        = (uint8_t *) PyByteArray_AsString(
+		                                                             buffer_object );
+	}
+	chunks_object->held_buffer_index = -1;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	Py_BEGIN_ALLOW_THREADS
+
+	if( libcthreads_mutex_grab(
+	     chunks_object->condition_mutex,
+	     NULL ) == 1 )
+	{
+		chunks_object->number_of_free_buffers += 1;
+
+		libcthreads_condition_broadcast(
+		 chunks_object->buffer_freed_condition,
+		 NULL );
+
+		libcthreads_mutex_release(
+		 chunks_object->condition_mutex,
+		 NULL );
+	}
+	Py_END_ALLOW_THREADS
+#else
+	chunks_object->number_of_free_buffers += 1;
+#endif
+	return( 1 );
+}
+
+/* The chunks iter() function
+ */
+PyObject *pyvsapm_chunks_iter(
+           pyvsapm_chunks_t *chunks_object )
+{
+	static char *function = "pyvsapm_chunks_iter";
+
+	if( chunks_object == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid chunks object.",
+		 function );
+
+		return( NULL );
+	}
+	Py_IncRef(
+	 (PyObject *) chunks_object );
+
+	return( (PyObject *) chunks_object );
+}
+
+/* The chunks iternext() function
+ * Returns a memoryview of the next chunk
+ */
+PyObject *pyvsapm_chunks_iternext(
+           pyvsapm_chunks_t *chunks_object )
+{
+	PyObject *memoryview_object = NULL;
+	PyObject *slice_object      = NULL;
+	libcerror_error_t *error    = NULL;
+	static char *function       = "pyvsapm_chunks_iternext";
+	size_t read_count           = 0;
+	int buffer_index            = -1;
+	int result                  = 0;
+
+	if( chunks_object == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid chunks object.",
+		 function );
+
+		return( NULL );
+	}
+	if( chunks_object->buffer_objects == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid chunks object - missing buffer objects.",
+		 function );
+
+		return( NULL );
+	}
+	if( pyvsapm_chunks_release_buffer(
+	     chunks_object ) != 1 )
+	{
+		return( NULL );
+	}
+	if( (size64_t) chunks_object->current_offset >= chunks_object->partition_size )
+	{
+		PyErr_SetNone(
+		 PyExc_StopIteration );
+
+		return( NULL );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libcthreads_mutex_grab(
+	          chunks_object->condition_mutex,
+	          &error );
+
+	while( ( result == 1 )
+	    && ( chunks_object->number_of_filled_buffers == 0 )
+	    && ( chunks_object->prefetch_done == 0 ) )
+	{
+		result = libcthreads_condition_wait(
+		          chunks_object->buffer_filled_condition,
+		          chunks_object->condition_mutex,
+		          &error );
+	}
+	if( result == 1 )
+	{
+		if( chunks_object->number_of_filled_buffers > 0 )
+		{
+			buffer_index = chunks_object->read_buffer_index;
+			read_count   = chunks_object->read_counts[ buffer_index ];
+
+			chunks_object->read_buffer_index         = ( buffer_index + 1 ) % chunks_object->number_of_buffers;
+			chunks_object->number_of_filled_buffers -= 1;
+		}
+		else if( chunks_object->prefetch_error != NULL )
+		{
+			error = chunks_object->prefetch_error;
+
+			chunks_object->prefetch_error = NULL;
+
+			result = -1;
+		}
+		else
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: prefetch stopped before end of partition.",
+			 function );
+
+			result = -1;
+		}
+		libcthreads_mutex_release(
+		 chunks_object->condition_mutex,
+		 NULL );
+	}
+	Py_END_ALLOW_THREADS
+
+#else
+	buffer_index = 0;
+
+	Py_BEGIN_ALLOW_THREADS
+
+	result = pyvsapm_chunks_read_buffer(
+	          chunks_object,
+	          chunks_object->buffers[ buffer_index ],
+	          chunks_object->current_offset,
+	          &read_count,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result == 1 )
+	{
+		chunks_object->number_of_free_buffers -= 1;
+	}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	if( result != 1 )
+	{
+		pyvsapm_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to read chunk.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+	chunks_object->held_buffer_index = buffer_index;
+	chunks_object->current_offset   += (off64_t) read_count;
+
+	memoryview_object = PyMemoryView_FromObject(
+	                     chunks_object->buffer_objects[ buffer_index ] );
+
+	if( memoryview_object == NULL )
+	{
+		return( NULL );
+	}
+	if( read_count < chunks_object->chunk_size )
+	{
+		slice_object = PySequence_GetSlice(
+		                memoryview_object,
+		                0,
+		                (Py_ssize_t) read_count );
+
+		Py_DecRef(
+		 memoryview_object );
+
+		memoryview_object = slice_object;
+	}
+	return( memoryview_object );
+}
+
@@ -0,0 +1,182 @@
+/*
+ * Python object definition of the iterator object of partition data chunks
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _PYVSAPM_CHUNKS_H )
+#define _PYVSAPM_CHUNKS_H
+
+#include <common.h>
+#include <types.h>
+
+#include "pyvsapm_libcerror.h"
+#include "pyvsapm_libcthreads.h"
+#include "pyvsapm_libvsapm.h"
+#include "pyvsapm_python.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The maximum number of chunks that can be prefetched
+ */
+#define PYVSAPM_CHUNKS_MAXIMUM_PREFETCH		64
+
+typedef struct pyvsapm_chunks pyvsapm_chunks_t;
+
+struct pyvsapm_chunks
+{
+	/* Python object initialization
+	 */
+	PyObject_HEAD
+
+	/* The libvsapm partition
+	 */
+	libvsapm_partition_t *partition;
+
+	/* The parent object
+	 */
+	PyObject *parent_object;
+
+	/* The chunk size
+	 */
+	size_t chunk_size;
+
+	/* The partition size
+	 */
+	size64_t partition_size;
+
+	/* The offset of the next chunk to return
+	 */
+	off64_t current_offset;
+
+	/* The offset of the next chunk to prefetch
+	 */
+	off64_t prefetch_offset;
+
+	/* The number of buffers in the ring
+	 */
+	int number_of_buffers;
+
+	/* The buffer (bytearray) objects
+	 */
+	PyObject **buffer_objects;
+
+	/* The buffers, which point to the data of the buffer objects
+	 */
+	uint8_t **buffers;
+
+	/* The number of bytes read into each buffer
+	 */
+	size_t *read_counts;
+
+	/* The index of the next buffer to return
+	 */
+	int read_buffer_index;
+
+	/* The index of the next buffer to prefetch into
+	 */
+	int write_buffer_index;
+
+	/* The index of the buffer last returned or -1 if not set
+	 */
+	int held_buffer_index;
+
+	/* The number of filled buffers
+	 */
+	int number_of_filled_buffers;
+
+	/* The number of free buffers
+	 */
+	int number_of_free_buffers;
+
+	/* Value to indicate the prefetch has finished
+	 */
+	int prefetch_done;
+
+	/* Value to indicate the prefetch should abort
+	 */
+	int abort;
+
+	/* The prefetch error
+	 */
+	libcerror_error_t *prefetch_error;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The prefetch thread
+	 */
+	libcthreads_thread_t *prefetch_thread;
+
+	/* The condition mutex
+	 */
+	libcthreads_mutex_t *condition_mutex;
+
+	/* The buffer filled condition
+	 */
+	libcthreads_condition_t *buffer_filled_condition;
+
+	/* The buffer freed condition
+	 */
+	libcthreads_condition_t *buffer_freed_condition;
+#endif
+};
+
+extern PyTypeObject pyvsapm_chunks_type_object;
+
+int pyvsapm_chunks_read_buffer(
+     pyvsapm_chunks_t *chunks_object,
+     uint8_t *buffer,
+     off64_t offset,
+     size_t *read_count,
+     libcerror_error_t **error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int pyvsapm_chunks_prefetch_thread_function(
+     pyvsapm_chunks_t *chunks_object );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+PyObject *pyvsapm_chunks_new(
+           libvsapm_partition_t *partition,
+           PyObject *parent_object,
+           size_t chunk_size,
+           int prefetch );
+
+int pyvsapm_chunks_init(
+     pyvsapm_chunks_t *chunks_object );
+
+void pyvsapm_chunks_free(
+      pyvsapm_chunks_t *chunks_object );
+
+int pyvsapm_chunks_release_buffer(
+     pyvsapm_chunks_t *chunks_object );
+
+PyObject *pyvsapm_chunks_iter(
+           pyvsapm_chunks_t *chunks_object );
+
+PyObject *pyvsapm_chunks_iternext(
+           pyvsapm_chunks_t *chunks_object );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _PYVSAPM_CHUNKS_H ) */
+
@@ -27,6 +27,7 @@
 #include <stdlib.h>
 #endif
 
+#include "pyvsapm_chunks.h"
 #include "pyvsapm_error.h"
 #include "pyvsapm_integer.h"
 #include "pyvsapm_libcerror.h"
@@ -34,6 +35,7 @@
 #include "pyvsapm_partition.h"
 #include "pyvsapm_python.h"
 #include "pyvsapm_unused.h"
+#include "pyvsapm_volume.h"
 
 PyMethodDef pyvsapm_partition_object_methods[] = {
 
@@ -121,6 +123,22 @@ PyMethodDef pyvsapm_partition_object_methods[] = {
 	  "\n"
 	  "Retrieves the size." },
 
+	{ "iter_chunks",
+	  (PyCFunction) pyvsapm_partition_iter_chunks,
+	  METH_VARARGS | METH_KEYWORDS,
+	  "iter_chunks(chunk_size, prefetch=2) -> Object\n"
+	  "\n"
+	  "Retrieves an iterator of memoryview objects over the data in chunks.\n"
+	  "Up to prefetch chunks are read ahead by a native thread." },
+
+	{ "memoryview",
+	  (PyCFunction) pyvsapm_partition_memoryview,
+	  METH_NOARGS,
+	  "memoryview() -> Object\n"
+	  "\n"
+	  "Retrieves a read-only memoryview of the data without copying it.\n"
+	  "Only supported if the volume was opened from a local file." },
+
 	/* Sentinel */
 	{ NULL, NULL, 0, NULL }
 };
@@ -161,6 +179,17 @@ PyGetSetDef pyvsapm_partition_object_get_set_definitions[] = {
 	{ NULL, NULL, NULL, NULL, NULL }
 };
 
+#if PY_MAJOR_VERSION >= 3
+
+PyBufferProcs pyvsapm_partition_buffer_procs = {
+	/* bf_getbuffer */
+	(getbufferproc) pyvsapm_partition_getbuffer,
+	/* bf_releasebuffer */
+	(releasebufferproc) pyvsapm_partition_releasebuffer
+};
+
+#endif /* PY_MAJOR_VERSION >= 3 */
+
 PyTypeObject pyvsapm_partition_type_object = {
 	PyVarObject_HEAD_INIT( NULL, 0 )
 
@@ -199,7 +228,11 @@ PyTypeObject pyvsapm_partition_type_object = {
 	/* tp_setattro */
 	0,
 	/* tp_as_buffer */
+#if PY_MAJOR_VERSION >= 3
+	&pyvsapm_partition_buffer_procs,
+#else
 	0,
+#endif
 	/* tp_flags */
 	Py_TPFLAGS_DEFAULT,
 	/* tp_doc */
@@ -1257,3 +1290,219 @@ PyObject *pyvsapm_partition_get_size(
 	return( integer_object );
 }
 
+/* Retrieves an iterator of the data in chunks
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyvsapm_partition_iter_chunks(
+           pyvsapm_partition_t *pyvsapm_partition,
+           PyObject *arguments,
+           PyObject *keywords )
+{
+	PyObject *chunks_object     = NULL;
+	static char *function       = "pyvsapm_partition_iter_chunks";
+	static char *keyword_list[] = { "chunk_size", "prefetch", NULL };
+	Py_ssize_t chunk_size       = 0;
+	int prefetch                = 2;
+
+	if( pyvsapm_partition == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid partition.",
+		 function );
+
+		return( NULL );
+	}
+	if( PyArg_ParseTupleAndKeywords(
+	     arguments,
+	     keywords,
+	     "n|i",
+	     keyword_list,
+	     &chunk_size,
+	     &prefetch ) == 0 )
+	{
+		return( NULL );
+	}
+	if( chunk_size <= 0 )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid chunk size value zero or less.",
+		 function );
+
+		return( NULL );
+	}
+	chunks_object = pyvsapm_chunks_new(
+	                 pyvsapm_partition->partition,
+	                 (PyObject *) pyvsapm_partition,
+	                 (size_t) chunk_size,
+	                 prefetch );
+
+	return( chunks_object );
+}
+
+#if PY_MAJOR_VERSION >= 3
+
+/* Retrieves a buffer of the data that is backed by the mapped volume data
+ * Returns 0 if successful or -1 on error
+ */
+int pyvsapm_partition_getbuffer(
+     pyvsapm_partition_t *pyvsapm_partition,
+     Py_buffer *buffer,
+     int flags )
+{
+	libcerror_error_t *error         = NULL;
+	pyvsapm_volume_t *pyvsapm_volume = NULL;
+	uint8_t *mapped_data             = NULL;
+	static char *function            = "pyvsapm_partition_getbuffer";
+	size64_t size                    = 0;
+	size_t mapped_data_size          = 0;
+	off64_t volume_offset            = 0;
+	int result                       = 0;
+
+	if( pyvsapm_partition == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid partition.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( pyvsapm_partition->parent_object == NULL )
+	 || ( PyObject_TypeCheck(
+	       pyvsapm_partition->parent_object,
+	       &pyvsapm_volume_type_object ) == 0 ) )
+	{
+		PyErr_Format(
+		 PyExc_BufferError,
+		 "%s: invalid partition - missing parent volume.",
+		 function );
+
+		return( -1 );
+	}
+	pyvsapm_volume = (pyvsapm_volume_t *) pyvsapm_partition->parent_object;
+
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libvsapm_partition_get_volume_offset(
+	          pyvsapm_partition->partition,
+	          &volume_offset,
+	          &error );
+
+	if( result == 1 )
+	{
+		result = libvsapm_partition_get_size(
+		          pyvsapm_partition->partition,
+		          &size,
+		          &error );
+	}
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pyvsapm_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to retrieve volume offset and size.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( -1 );
+	}
+	if( pyvsapm_volume_get_mapped_data(
+	     pyvsapm_volume,
+	     &mapped_data,
+	     &mapped_data_size ) != 1 )
+	{
+		return( -1 );
+	}
+	if( ( volume_offset < 0 )
+	 || ( (size64_t) volume_offset > (size64_t) mapped_data_size )
+	 || ( size > ( (size64_t) mapped_data_size - (size64_t) volume_offset ) ) )
+	{
+		PyErr_Format(
+		 PyExc_IOError,
+		 "%s: partition exceeds mapped volume data.",
+		 function );
+
+		return( -1 );
+	}
+	if( PyBuffer_FillInfo(
+	     buffer,
+	     (PyObject *) pyvsapm_partition,
+	     (void *) &( mapped_data[ volume_offset ] ),
+	     (Py_ssize_t) size,
+	     1,
+	     flags ) != 0 )
+	{
+		return( -1 );
+	}
+	pyvsapm_volume->number_of_mapped_data_exports += 1;
+
+	return( 0 );
+}
+
+/* Releases a buffer of the data
+ */
+void pyvsapm_partition_releasebuffer(
+      pyvsapm_partition_t *pyvsapm_partition,
+      Py_buffer *buffer PYVSAPM_ATTRIBUTE_UNUSED )
+{
+	pyvsapm_volume_t *pyvsapm_volume = NULL;
+
+	PYVSAPM_UNREFERENCED_PARAMETER( buffer )
+
+	if( pyvsapm_partition == NULL )
+	{
+		return;
+	}
+	if( pyvsapm_partition->parent_object == NULL )
+	{
+		return;
+	}
+	pyvsapm_volume = (pyvsapm_volume_t *) pyvsapm_partition->parent_object;
+
+	if( pyvsapm_volume->number_of_mapped_data_exports > 0 )
+	{
+		pyvsapm_volume->number_of_mapped_data_exports -= 1;
+	}
+}
+
+#endif /* PY_MAJOR_VERSION >= 3 */
+
+/* Retrieves a memoryview of the data
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyvsapm_partition_memoryview(
+           pyvsapm_partition_t *pyvsapm_partition,
+           PyObject *arguments PYVSAPM_ATTRIBUTE_UNUSED )
+{
+	static char *function = "pyvsapm_partition_memoryview";
+
+	PYVSAPM_UNREFERENCED_PARAMETER( arguments )
+
+	if( pyvsapm_partition == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid partition.",
+		 function );
+
+		return( NULL );
+	}
+#if PY_MAJOR_VERSION >= 3
+	return( PyMemoryView_FromObject(
+	         (PyObject *) pyvsapm_partition ) );
+#else
+	PyErr_Format(
+	 PyExc_NotImplementedError,
+	 "%s: memoryview of partition not supported.",
+	 function );
+
+	return( NULL );
+#endif
+}
+
@@ -101,6 +101,28 @@ PyObject *pyvsapm_partition_get_size(
            pyvsapm_partition_t *pyvsapm_partition,
            PyObject *arguments );
 
+PyObject *pyvsapm_partition_iter_chunks(
+           pyvsapm_partition_t *pyvsapm_partition,
+           PyObject *arguments,
+           PyObject *keywords );
+
+#if PY_MAJOR_VERSION >= 3
+
+int pyvsapm_partition_getbuffer(
+     pyvsapm_partition_t *pyvsapm_partition,
+     Py_buffer *buffer,
+     int flags );
+
+void pyvsapm_partition_releasebuffer(
+      pyvsapm_partition_t *pyvsapm_partition,
+      Py_buffer *buffer );
+
+#endif /* PY_MAJOR_VERSION >= 3 */
+
+PyObject *pyvsapm_partition_memoryview(
+           pyvsapm_partition_t *pyvsapm_partition,
+           PyObject *arguments );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -20,12 +20,26 @@
  */
 
 #include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( HAVE_WINAPI )
 #include <stdlib.h>
 #endif
 
+#if defined( HAVE_SYS_MMAN_H )
+#include <sys/mman.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
 #include "pyvsapm_error.h"
 #include "pyvsapm_file_object_io_handle.h"
 #include "pyvsapm_libbfio.h"
@@ -242,8 +256,12 @@ int pyvsapm_volume_init(
 	}
 	/* Make sure libvsapm volume is set to NULL
 	 */
-	pyvsapm_volume->volume         = NULL;
-	pyvsapm_volume->file_io_handle = NULL;
+	pyvsapm_volume->volume                        = NULL;
+	pyvsapm_volume->file_io_handle                = NULL;
+	pyvsapm_volume->filename                      = NULL;
+	pyvsapm_volume->mapped_data                   = NULL;
+	pyvsapm_volume->mapped_data_size              = 0;
+	pyvsapm_volume->number_of_mapped_data_exports = 0;
 
 	if( libvsapm_volume_initialize(
 	     &( pyvsapm_volume->volume ),
@@ -312,6 +330,19 @@ void pyvsapm_volume_free(
 			return;
 		}
 	}
+	/* The partition objects keep a reference to the volume object
+	 * so no exported buffers remain at this point
+	 */
+	pyvsapm_volume_unmap_data(
+	 pyvsapm_volume );
+
+	if( pyvsapm_volume->filename != NULL )
+	{
+		PyMem_Free(
+		 pyvsapm_volume->filename );
+
+		pyvsapm_volume->filename = NULL;
+	}
 	if( pyvsapm_volume->volume != NULL )
 	{
 		Py_BEGIN_ALLOW_THREADS
@@ -516,6 +547,18 @@ PyObject *pyvsapm_volume_open(
 
 		Py_END_ALLOW_THREADS
 
+		if( result == 1 )
+		{
+			if( pyvsapm_volume_set_filename(
+			     pyvsapm_volume,
+			     filename_narrow ) != 1 )
+			{
+				Py_DecRef(
+				 utf8_string_object );
+
+				return( NULL );
+			}
+		}
 		Py_DecRef(
 		 utf8_string_object );
 #endif
@@ -591,6 +634,12 @@ PyObject *pyvsapm_volume_open(
 
 			return( NULL );
 		}
+		if( pyvsapm_volume_set_filename(
+		     pyvsapm_volume,
+		     filename_narrow ) != 1 )
+		{
+			return( NULL );
+		}
 		Py_IncRef(
 		 Py_None );
 
@@ -765,6 +814,27 @@ PyObject *pyvsapm_volume_close(
 
 		return( NULL );
 	}
+	if( pyvsapm_volume->number_of_mapped_data_exports > 0 )
+	{
+		PyErr_Format(
+		 PyExc_BufferError,
+		 "%s: unable to close volume while memoryviews of its data exist.",
+		 function );
+
+		return( NULL );
+	}
+	if( pyvsapm_volume_unmap_data(
+	     pyvsapm_volume ) != 1 )
+	{
+		return( NULL );
+	}
+	if( pyvsapm_volume->filename != NULL )
+	{
+		PyMem_Free(
+		 pyvsapm_volume->filename );
+
+		pyvsapm_volume->filename = NULL;
+	}
 	Py_BEGIN_ALLOW_THREADS
 
 	result = libvsapm_volume_close(
@@ -1087,3 +1157,231 @@ PyObject *pyvsapm_volume_get_partitions(
 	return( sequence_object );
 }
 
+/* Sets the filename used to map the volume data
+ * Returns 1 if successful or -1 on error
+ */
+int pyvsapm_volume_set_filename(
+     pyvsapm_volume_t *pyvsapm_volume,
+     const char *filename )
+{
+	static char *function = "pyvsapm_volume_set_filename";
+	size_t filename_size  = 0;
+
+	if( pyvsapm_volume == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( pyvsapm_volume->filename != NULL )
+	{
+		PyMem_Free(
+		 pyvsapm_volume->filename );
+
+		pyvsapm_volume->filename = NULL;
+	}
+	filename_size = narrow_string_length(
+	                 filename ) + 1;
+
+	pyvsapm_volume->filename = (char *) PyMem_Malloc(
+	                                     sizeof( char ) * filename_size );
+
+	if( pyvsapm_volume->filename == NULL )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to create filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     pyvsapm_volume->filename,
+	     filename,
+	     filename_size ) == NULL )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to copy filename.",
+		 function );
+
+		PyMem_Free(
+		 pyvsapm_volume->filename );
+
+		pyvsapm_volume->filename = NULL;
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the mapped volume data
+ * The volume data is mapped read-only on first use and remains mapped
+ * until the volume is closed
+ * Returns 1 if successful or -1 on error
+ */
+int pyvsapm_volume_get_mapped_data(
+     pyvsapm_volume_t *pyvsapm_volume,
+     uint8_t **mapped_data,
+     size_t *mapped_data_size )
+{
+	static char *function = "pyvsapm_volume_get_mapped_data";
+
+#if defined( HAVE_MMAP ) && defined( HAVE_MUNMAP )
+	void *data            = NULL;
+	off_t file_size       = 0;
+	int file_descriptor   = -1;
+#endif
+
+	if( pyvsapm_volume == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( mapped_data == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid mapped data.",
+		 function );
+
+		return( -1 );
+	}
+	if( mapped_data_size == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid mapped data size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MMAP ) && defined( HAVE_MUNMAP )
+	if( pyvsapm_volume->mapped_data == NULL )
+	{
+		if( pyvsapm_volume->filename == NULL )
+		{
+			PyErr_Format(
+			 PyExc_IOError,
+			 "%s: unable to map volume data - volume was not opened from a local file.",
+			 function );
+
+			return( -1 );
+		}
+		Py_BEGIN_ALLOW_THREADS
+
+		file_descriptor = open(
+		                   pyvsapm_volume->filename,
+		                   O_RDONLY );
+
+		if( file_descriptor != -1 )
+		{
+			/* Use lseek instead of fstat so the size of block devices is determined as well
+			 */
+			file_size = lseek(
+			             file_descriptor,
+			             0,
+			             SEEK_END );
+
+			if( ( file_size > 0 )
+			 && ( (uint64_t) file_size <= (uint64_t) SSIZE_MAX ) )
+			{
+				data = mmap(
+				        NULL,
+				        (size_t) file_size,
+				        PROT_READ,
+				        MAP_SHARED,
+				        file_descriptor,
+				        0 );
+			}
+			else
+			{
+				data = MAP_FAILED;
+			}
+			close(
+			 file_descriptor );
+		}
+		Py_END_ALLOW_THREADS
+
+		if( ( file_descriptor == -1 )
+		 || ( data == MAP_FAILED ) )
+		{
+			PyErr_Format(
+			 PyExc_IOError,
+			 "%s: unable to map volume data of file: %s.",
+			 function,
+			 pyvsapm_volume->filename );
+
+			return( -1 );
+		}
+		pyvsapm_volume->mapped_data      = (uint8_t *) data;
+		pyvsapm_volume->mapped_data_size = (size_t) file_size;
+	}
+	*mapped_data      = pyvsapm_volume->mapped_data;
+	*mapped_data_size = pyvsapm_volume->mapped_data_size;
+
+	return( 1 );
+#else
+	PyErr_Format(
+	 PyExc_NotImplementedError,
+	 "%s: mapping volume data not supported on this platform.",
+	 function );
+
+	return( -1 );
+#endif /* defined( HAVE_MMAP ) && defined( HAVE_MUNMAP ) */
+}
+
+/* Unmaps the volume data
+ * Returns 1 if successful or -1 on error
+ */
+int pyvsapm_volume_unmap_data(
+     pyvsapm_volume_t *pyvsapm_volume )
+{
+	static char *function = "pyvsapm_volume_unmap_data";
+
+	if( pyvsapm_volume == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MMAP ) && defined( HAVE_MUNMAP )
+	if( pyvsapm_volume->mapped_data != NULL )
+	{
+		if( munmap(
+		     pyvsapm_volume->mapped_data,
+		     pyvsapm_volume->mapped_data_size ) != 0 )
+		{
+			PyErr_Format(
+			 PyExc_IOError,
+			 "%s: unable to unmap volume data.",
+			 function );
+
+			return( -1 );
+		}
+		pyvsapm_volume->mapped_data      = NULL;
+		pyvsapm_volume->mapped_data_size = 0;
+	}
+#endif
+	return( 1 );
+}
+
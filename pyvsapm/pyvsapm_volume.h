@@ -48,6 +48,22 @@ struct pyvsapm_volume
 	/* The libbfio file IO handle
 	 */
 	libbfio_handle_t *file_io_handle;
+
+	/* The filename, used to map the volume data
+	 */
+	char *filename;
+
+	/* The mapped volume data
+	 */
+	uint8_t *mapped_data;
+
+	/* The mapped volume data size
+	 */
+	size_t mapped_data_size;
+
+	/* The number of buffers exported from the mapped volume data
+	 */
+	int number_of_mapped_data_exports;
 };
 
 extern PyMethodDef pyvsapm_volume_object_methods[];
@@ -98,6 +114,18 @@ PyObject *pyvsapm_volume_get_partitions(
            pyvsapm_volume_t *pyvsapm_volume,
            PyObject *arguments );
 
+int pyvsapm_volume_set_filename(
+     pyvsapm_volume_t *pyvsapm_volume,
+     const char *filename );
+
+int pyvsapm_volume_get_mapped_data(
+     pyvsapm_volume_t *pyvsapm_volume,
+     uint8_t **mapped_data,
+     size_t *mapped_data_size );
+
+int pyvsapm_volume_unmap_data(
+     pyvsapm_volume_t *pyvsapm_volume );
+
 #if defined( __cplusplus )
 }
 #endif
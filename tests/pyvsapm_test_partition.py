@@ -184,6 +184,93 @@ class PartitionTypeTests(unittest.TestCase):
     finally:
       vsapm_volume.close()
 
+  def test_iter_chunks(self):
+    """Tests the iter_chunks function."""
+    test_source = getattr(unittest, "source", None)
+    if not test_source:
+      raise unittest.SkipTest("missing source")
+
+    vsapm_volume = pyvsapm.volume()
+
+    vsapm_volume.open(test_source)
+
+    try:
+      if not vsapm_volume.number_of_partitions:
+        raise unittest.SkipTest("missing partitions")
+
+      vsapm_partition = vsapm_volume.get_partition(0)
+
+      size = vsapm_partition.get_size()
+
+      chunk_size = 4096
+      if size > 16 * chunk_size:
+        size = 16 * chunk_size
+
+      expected_data = vsapm_partition.read_buffer_at_offset(size, 0)
+
+      for prefetch in (0, 1, 4):
+        chunks = []
+        for chunk in vsapm_partition.iter_chunks(chunk_size, prefetch=prefetch):
+          self.assertIsInstance(chunk, memoryview)
+          self.assertLessEqual(len(chunk), chunk_size)
+
+          chunks.append(chunk)
+
+          if sum(len(chunk) for chunk in chunks) >= size:
+            break
+
+        # Chunks that are still referenced must not be overwritten.
+        data = b"".join(chunk.tobytes() for chunk in chunks)
+        self.assertEqual(data[:size], expected_data)
+
+      with self.assertRaises(ValueError):
+        vsapm_partition.iter_chunks(0)
+
+      with self.assertRaises(ValueError):
+        vsapm_partition.iter_chunks(chunk_size, prefetch=-1)
+
+    finally:
+      vsapm_volume.close()
+
+  def test_memoryview(self):
+    """Tests the memoryview function."""
+    test_source = getattr(unittest, "source", None)
+    if not test_source:
+      raise unittest.SkipTest("missing source")
+
+    vsapm_volume = pyvsapm.volume()
+
+    vsapm_volume.open(test_source)
+
+    try:
+      if not vsapm_volume.number_of_partitions:
+        raise unittest.SkipTest("missing partitions")
+
+      vsapm_partition = vsapm_volume.get_partition(0)
+
+      size = vsapm_partition.get_size()
+
+      try:
+        data_view = vsapm_partition.memoryview()
+      except NotImplementedError:
+        raise unittest.SkipTest("memoryview not supported")
+
+      self.assertEqual(len(data_view), size)
+      self.assertTrue(data_view.readonly)
+
+      read_size = min(size, 4096)
+      expected_data = vsapm_partition.read_buffer_at_offset(read_size, 0)
+      self.assertEqual(data_view[:read_size].tobytes(), expected_data)
+
+      # The volume cannot be closed while its data is exported.
+      with self.assertRaises(BufferError):
+        vsapm_volume.close()
+
+      data_view.release()
+
+    finally:
+      vsapm_volume.close()
+
   def test_seek_offset(self):
     """Tests the seek_offset function."""
     test_source = getattr(unittest, "source", None)
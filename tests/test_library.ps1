@@ -6,7 +6,7 @@ $ExitSuccess = 0
 $ExitFailure = 1
 $ExitIgnore = 77
 
-$LibraryTests = "error io_handle notify partition_map_entry sector_data"
+$LibraryTests = "direct_io error io_handle io_uring notify partition_file_io_handle partition_index partition_map_entry partition_map_entry_batch pool_file_io_handle scanner sector_cache sector_cache_arena zero_block"
 $LibraryTestsWithInput = "partition support volume"
 $OptionSets = ""
 
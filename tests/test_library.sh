@@ -7,7 +7,7 @@ EXIT_SUCCESS=0;
 EXIT_FAILURE=1;
 EXIT_IGNORE=77;
 
-LIBRARY_TESTS="error io_handle notify partition_map_entry sector_data";
+LIBRARY_TESTS="direct_io error io_handle io_uring notify partition_file_io_handle partition_index partition_map_entry partition_map_entry_batch pool_file_io_handle scanner sector_cache sector_cache_arena zero_block";
 LIBRARY_TESTS_WITH_INPUT="partition support volume";
 OPTION_SETS=();
 
@@ -0,0 +1,890 @@
+/*
+ * Library direct IO type test program
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "vsapm_test_libcerror.h"
+#include "vsapm_test_libvsapm.h"
+#include "vsapm_test_macros.h"
+#include "vsapm_test_memory.h"
+#include "vsapm_test_unused.h"
+
+#include "../libvsapm/libvsapm_direct_io.h"
+
+/* The test data is read with a small bounce buffer so that an unaligned
+ * read requires more than one read into the bounce buffer
+ */
+#define VSAPM_TEST_DIRECT_IO_DATA_SIZE		( 64 * 1024 )
+#define VSAPM_TEST_DIRECT_IO_ALIGNMENT		4096
+#define VSAPM_TEST_DIRECT_IO_BOUNCE_BUFFER_SIZE	( 2 * VSAPM_TEST_DIRECT_IO_ALIGNMENT )
+
+#if defined( HAVE_LIBVSAPM_DIRECT_IO ) && defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT )
+
+uint8_t vsapm_test_direct_io_data[ VSAPM_TEST_DIRECT_IO_DATA_SIZE ];
+
+char vsapm_test_direct_io_filename[ 32 ];
+
+/* Creates the test file
+ * Returns 1 if successful or -1 on error
+ */
+int vsapm_test_direct_io_create_file(
+     void )
+{
+	size_t data_offset  = 0;
+	ssize_t write_count = 0;
+	int file_descriptor = -1;
+
+	for( data_offset = 0;
+	     data_offset < VSAPM_TEST_DIRECT_IO_DATA_SIZE;
+	     data_offset++ )
+	{
+		vsapm_test_direct_io_data[ data_offset ] = (uint8_t) ( ( data_offset * 7 ) + ( data_offset >> 12 ) );
+	}
+	if( memory_copy(
+	     vsapm_test_direct_io_filename,
+	     "vsapm_test_direct_io.XXXXXX",
+	     28 ) == NULL )
+	{
+		return( -1 );
+	}
+	file_descriptor = mkstemp(
+	                   vsapm_test_direct_io_filename );
+
+	if( file_descriptor == -1 )
+	{
+		return( -1 );
+	}
+	write_count = write(
+	               file_descriptor,
+	               vsapm_test_direct_io_data,
+	               VSAPM_TEST_DIRECT_IO_DATA_SIZE );
+
+	close(
+	 file_descriptor );
+
+	if( write_count != (ssize_t) VSAPM_TEST_DIRECT_IO_DATA_SIZE )
+	{
+		unlink(
+		 vsapm_test_direct_io_filename );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Tests the libvsapm_direct_io_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_direct_io_initialize(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libvsapm_direct_io_t *direct_io = NULL;
+	int result                      = 0;
+
+#if defined( HAVE_VSAPM_TEST_MEMORY )
+	int number_of_malloc_fail_tests = 1;
+	int number_of_memset_fail_tests = 1;
+	int test_number                 = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libvsapm_direct_io_initialize(
+	          &direct_io,
+	          vsapm_test_direct_io_filename,
+	          VSAPM_TEST_DIRECT_IO_ALIGNMENT,
+	          VSAPM_TEST_DIRECT_IO_BOUNCE_BUFFER_SIZE,
+	          &error );
+
+	VSAPM_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	if( result == 1 )
+	{
+		VSAPM_TEST_ASSERT_IS_NOT_NULL(
+		 "direct_io",
+		 direct_io );
+
+		VSAPM_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		VSAPM_TEST_ASSERT_EQUAL_SIZE(
+		 "direct_io->alignment",
+		 direct_io->alignment,
+		 (size_t) VSAPM_TEST_DIRECT_IO_ALIGNMENT );
+
+		VSAPM_TEST_ASSERT_EQUAL_SIZE(
+		 "direct_io->bounce_buffer_size",
+		 direct_io->bounce_buffer_size,
+		 (size_t) VSAPM_TEST_DIRECT_IO_BOUNCE_BUFFER_SIZE );
+
+		result = libvsapm_direct_io_free(
+		          &direct_io,
+		          &error );
+
+		VSAPM_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSAPM_TEST_ASSERT_IS_NULL(
+		 "direct_io",
+		 direct_io );
+
+		VSAPM_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	else
+	{
+		/* O_DIRECT was rejected, e.g. by the file system
+		 */
+		VSAPM_TEST_ASSERT_IS_NULL(
+		 "direct_io",
+		 direct_io );
+
+		VSAPM_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	/* Test error cases
+	 */
+	result = libvsapm_direct_io_initialize(
+	          NULL,
+	          vsapm_test_direct_io_filename,
+	          VSAPM_TEST_DIRECT_IO_ALIGNMENT,
+	          VSAPM_TEST_DIRECT_IO_BOUNCE_BUFFER_SIZE,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	direct_io = (libvsapm_direct_io_t *) 0x12345678UL;
+
+	result = libvsapm_direct_io_initialize(
+	          &direct_io,
+	          vsapm_test_direct_io_filename,
+	          VSAPM_TEST_DIRECT_IO_ALIGNMENT,
+	          VSAPM_TEST_DIRECT_IO_BOUNCE_BUFFER_SIZE,
+	          &error );
+
+	direct_io = NULL;
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_direct_io_initialize(
+	          &direct_io,
+	          NULL,
+	          VSAPM_TEST_DIRECT_IO_ALIGNMENT,
+	          VSAPM_TEST_DIRECT_IO_BOUNCE_BUFFER_SIZE,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_direct_io_initialize(
+	          &direct_io,
+	          vsapm_test_direct_io_filename,
+	          VSAPM_TEST_DIRECT_IO_ALIGNMENT - 1,
+	          VSAPM_TEST_DIRECT_IO_BOUNCE_BUFFER_SIZE,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_direct_io_initialize(
+	          &direct_io,
+	          vsapm_test_direct_io_filename,
+	          VSAPM_TEST_DIRECT_IO_ALIGNMENT,
+	          0,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_direct_io_initialize(
+	          &direct_io,
+	          vsapm_test_direct_io_filename,
+	          VSAPM_TEST_DIRECT_IO_ALIGNMENT,
+	          VSAPM_TEST_DIRECT_IO_BOUNCE_BUFFER_SIZE + 1,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test that a failure leaves no direct IO behind, the volume relies on this
+	 * to fall back to buffered reads when the file cannot be opened with O_DIRECT
+	 */
+	result = libvsapm_direct_io_initialize(
+	          &direct_io,
+	          "vsapm_test_direct_io.missing",
+	          VSAPM_TEST_DIRECT_IO_ALIGNMENT,
+	          VSAPM_TEST_DIRECT_IO_BOUNCE_BUFFER_SIZE,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "direct_io",
+	 direct_io );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_VSAPM_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvsapm_direct_io_initialize with malloc failing
+		 */
+		vsapm_test_malloc_attempts_before_fail = test_number;
+
+		result = libvsapm_direct_io_initialize(
+		          &direct_io,
+		          vsapm_test_direct_io_filename,
+		          VSAPM_TEST_DIRECT_IO_ALIGNMENT,
+		          VSAPM_TEST_DIRECT_IO_BOUNCE_BUFFER_SIZE,
+		          &error );
+
+		if( vsapm_test_malloc_attempts_before_fail != -1 )
+		{
+			vsapm_test_malloc_attempts_before_fail = -1;
+
+			if( direct_io != NULL )
+			{
+				libvsapm_direct_io_free(
+				 &direct_io,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSAPM_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSAPM_TEST_ASSERT_IS_NULL(
+			 "direct_io",
+			 direct_io );
+
+			VSAPM_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvsapm_direct_io_initialize with memset failing
+		 */
+		vsapm_test_memset_attempts_before_fail = test_number;
+
+		result = libvsapm_direct_io_initialize(
+		          &direct_io,
+		          vsapm_test_direct_io_filename,
+		          VSAPM_TEST_DIRECT_IO_ALIGNMENT,
+		          VSAPM_TEST_DIRECT_IO_BOUNCE_BUFFER_SIZE,
+		          &error );
+
+		if( vsapm_test_memset_attempts_before_fail != -1 )
+		{
+			vsapm_test_memset_attempts_before_fail = -1;
+
+			if( direct_io != NULL )
+			{
+				libvsapm_direct_io_free(
+				 &direct_io,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSAPM_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSAPM_TEST_ASSERT_IS_NULL(
+			 "direct_io",
+			 direct_io );
+
+			VSAPM_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VSAPM_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( direct_io != NULL )
+	{
+		libvsapm_direct_io_free(
+		 &direct_io,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvsapm_direct_io_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_direct_io_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvsapm_direct_io_free(
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvsapm_direct_io_read_buffer_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_direct_io_read_buffer_at_offset(
+     void )
+{
+	uint8_t buffer[ VSAPM_TEST_DIRECT_IO_DATA_SIZE ];
+
+	libcerror_error_t *error        = NULL;
+	libvsapm_direct_io_t *direct_io = NULL;
+	uint8_t *aligned_buffer         = NULL;
+	ssize_t read_count              = 0;
+	int result                      = 0;
+
+	/* Initialize test
+	 */
+	result = libvsapm_direct_io_initialize(
+	          &direct_io,
+	          vsapm_test_direct_io_filename,
+	          VSAPM_TEST_DIRECT_IO_ALIGNMENT,
+	          VSAPM_TEST_DIRECT_IO_BOUNCE_BUFFER_SIZE,
+	          &error );
+
+	if( result == -1 )
+	{
+		/* O_DIRECT was rejected, e.g. by the file system
+		 */
+		libcerror_error_free(
+		 &error );
+
+		return( 1 );
+	}
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "direct_io",
+	 direct_io );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = posix_memalign(
+	          (void **) &aligned_buffer,
+	          VSAPM_TEST_DIRECT_IO_ALIGNMENT,
+	          VSAPM_TEST_DIRECT_IO_DATA_SIZE );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "aligned_buffer",
+	 aligned_buffer );
+
+	/* Test regular cases
+	 * An aligned read is read directly into the buffer and is larger than the bounce buffer
+	 */
+	read_count = libvsapm_direct_io_read_buffer_at_offset(
+	              direct_io,
+	              aligned_buffer,
+	              VSAPM_TEST_DIRECT_IO_DATA_SIZE,
+	              0,
+	              &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) VSAPM_TEST_DIRECT_IO_DATA_SIZE );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          aligned_buffer,
+	          vsapm_test_direct_io_data,
+	          VSAPM_TEST_DIRECT_IO_DATA_SIZE );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	read_count = libvsapm_direct_io_read_buffer_at_offset(
+	              direct_io,
+	              aligned_buffer,
+	              VSAPM_TEST_DIRECT_IO_ALIGNMENT,
+	              2 * VSAPM_TEST_DIRECT_IO_ALIGNMENT,
+	              &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) VSAPM_TEST_DIRECT_IO_ALIGNMENT );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          aligned_buffer,
+	          &( vsapm_test_direct_io_data[ 2 * VSAPM_TEST_DIRECT_IO_ALIGNMENT ] ),
+	          VSAPM_TEST_DIRECT_IO_ALIGNMENT );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* An unaligned read is read through a bounce buffer, in multiple parts
+	 * since it is larger than the bounce buffer
+	 */
+	read_count = libvsapm_direct_io_read_buffer_at_offset(
+	              direct_io,
+	              buffer,
+	              ( 5 * VSAPM_TEST_DIRECT_IO_ALIGNMENT ) + 100,
+	              1000,
+	              &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) ( 5 * VSAPM_TEST_DIRECT_IO_ALIGNMENT ) + 100 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer,
+	          &( vsapm_test_direct_io_data[ 1000 ] ),
+	          ( 5 * VSAPM_TEST_DIRECT_IO_ALIGNMENT ) + 100 );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* An aligned offset and size into an unaligned buffer is read through a bounce buffer
+	 */
+	read_count = libvsapm_direct_io_read_buffer_at_offset(
+	              direct_io,
+	              &( aligned_buffer[ 1 ] ),
+	              VSAPM_TEST_DIRECT_IO_ALIGNMENT,
+	              VSAPM_TEST_DIRECT_IO_ALIGNMENT,
+	              &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) VSAPM_TEST_DIRECT_IO_ALIGNMENT );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          &( aligned_buffer[ 1 ] ),
+	          &( vsapm_test_direct_io_data[ VSAPM_TEST_DIRECT_IO_ALIGNMENT ] ),
+	          VSAPM_TEST_DIRECT_IO_ALIGNMENT );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* An unaligned read at the end of the file returns the remaining data
+	 */
+	read_count = libvsapm_direct_io_read_buffer_at_offset(
+	              direct_io,
+	              buffer,
+	              1000,
+	              VSAPM_TEST_DIRECT_IO_DATA_SIZE - 100,
+	              &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 100 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer,
+	          &( vsapm_test_direct_io_data[ VSAPM_TEST_DIRECT_IO_DATA_SIZE - 100 ] ),
+	          100 );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	read_count = libvsapm_direct_io_read_buffer_at_offset(
+	              direct_io,
+	              buffer,
+	              1000,
+	              VSAPM_TEST_DIRECT_IO_DATA_SIZE + 100,
+	              &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libvsapm_direct_io_read_buffer_at_offset(
+	              direct_io,
+	              buffer,
+	              0,
+	              0,
+	              &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	read_count = libvsapm_direct_io_read_buffer_at_offset(
+	              NULL,
+	              buffer,
+	              1000,
+	              0,
+	              &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvsapm_direct_io_read_buffer_at_offset(
+	              direct_io,
+	              NULL,
+	              1000,
+	              0,
+	              &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvsapm_direct_io_read_buffer_at_offset(
+	              direct_io,
+	              buffer,
+	              (size_t) SSIZE_MAX + 1,
+	              0,
+	              &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvsapm_direct_io_read_buffer_at_offset(
+	              direct_io,
+	              buffer,
+	              1000,
+	              -1,
+	              &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	free(
+	 aligned_buffer );
+
+	aligned_buffer = NULL;
+
+	result = libvsapm_direct_io_free(
+	          &direct_io,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "direct_io",
+	 direct_io );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( aligned_buffer != NULL )
+	{
+		free(
+		 aligned_buffer );
+	}
+	if( direct_io != NULL )
+	{
+		libvsapm_direct_io_free(
+		 &direct_io,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_LIBVSAPM_DIRECT_IO ) && defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VSAPM_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VSAPM_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VSAPM_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VSAPM_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VSAPM_TEST_UNREFERENCED_PARAMETER( argc )
+	VSAPM_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( HAVE_LIBVSAPM_DIRECT_IO ) && defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT )
+
+	if( vsapm_test_direct_io_create_file() != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create test file.\n" );
+
+		goto on_error;
+	}
+	VSAPM_TEST_RUN(
+	 "libvsapm_direct_io_initialize",
+	 vsapm_test_direct_io_initialize );
+
+	VSAPM_TEST_RUN(
+	 "libvsapm_direct_io_free",
+	 vsapm_test_direct_io_free );
+
+	VSAPM_TEST_RUN(
+	 "libvsapm_direct_io_read_buffer_at_offset",
+	 vsapm_test_direct_io_read_buffer_at_offset );
+
+	unlink(
+	 vsapm_test_direct_io_filename );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	unlink(
+	 vsapm_test_direct_io_filename );
+
+	return( EXIT_FAILURE );
+
+#else
+	return( EXIT_SUCCESS );
+
+#endif /* defined( HAVE_LIBVSAPM_DIRECT_IO ) && defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT ) */
+}
@@ -398,6 +398,590 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libvsapm_io_handle_set_bytes_per_sector function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_io_handle_set_bytes_per_sector(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libvsapm_io_handle_t *io_handle = NULL;
+	int result                      = 0;
+
+	/* Initialize test
+	 */
+	result = libvsapm_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSAPM_TEST_ASSERT_EQUAL_UINT8(
+	 "io_handle->bytes_per_sector_shift",
+	 io_handle->bytes_per_sector_shift,
+	 9 );
+
+	/* Test regular cases
+	 */
+	result = libvsapm_io_handle_set_bytes_per_sector(
+	          io_handle,
+	          2048,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SIZE(
+	 "io_handle->bytes_per_sector",
+	 io_handle->bytes_per_sector,
+	 (size_t) 2048 );
+
+	VSAPM_TEST_ASSERT_EQUAL_UINT8(
+	 "io_handle->bytes_per_sector_shift",
+	 io_handle->bytes_per_sector_shift,
+	 11 );
+
+	/* Test a number of bytes per sector that is not a power of 2
+	 */
+	result = libvsapm_io_handle_set_bytes_per_sector(
+	          io_handle,
+	          2352,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SIZE(
+	 "io_handle->bytes_per_sector",
+	 io_handle->bytes_per_sector,
+	 (size_t) 2352 );
+
+	VSAPM_TEST_ASSERT_EQUAL_UINT8(
+	 "io_handle->bytes_per_sector_shift",
+	 io_handle->bytes_per_sector_shift,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libvsapm_io_handle_set_bytes_per_sector(
+	          NULL,
+	          512,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_io_handle_set_bytes_per_sector(
+	          io_handle,
+	          0,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvsapm_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_handle != NULL )
+	{
+		libvsapm_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvsapm_io_handle_set_sector_cache_size function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_io_handle_set_sector_cache_size(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libvsapm_io_handle_t *io_handle = NULL;
+	int result                      = 0;
+
+	/* Initialize test
+	 */
+	result = libvsapm_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "io_handle->sector_cache_number_of_slots",
+	 io_handle->sector_cache_number_of_slots,
+	 LIBVSAPM_SECTOR_CACHE_DEFAULT_NUMBER_OF_SLOTS );
+
+	/* Test regular cases
+	 */
+	result = libvsapm_io_handle_set_sector_cache_size(
+	          io_handle,
+	          1024 * 1024,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "io_handle->sector_cache_number_of_slots",
+	 io_handle->sector_cache_number_of_slots,
+	 256 );
+
+	/* Test that the sector cache size is retained when the IO handle is cleared
+	 */
+	result = libvsapm_io_handle_clear(
+	          io_handle,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "io_handle->sector_cache_number_of_slots",
+	 io_handle->sector_cache_number_of_slots,
+	 256 );
+
+	/* Test error cases
+	 */
+	result = libvsapm_io_handle_set_sector_cache_size(
+	          NULL,
+	          1024 * 1024,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_io_handle_set_sector_cache_size(
+	          io_handle,
+	          0,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_io_handle_set_sector_cache_size(
+	          io_handle,
+	          ( LIBVSAPM_SECTOR_CACHE_MINIMUM_NUMBER_OF_SLOTS - 1 ) * LIBVSAPM_SECTOR_CACHE_BLOCK_SIZE,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_io_handle_set_sector_cache_size(
+	          io_handle,
+	          ( LIBVSAPM_SECTOR_CACHE_MAXIMUM_NUMBER_OF_SLOTS * 2 ) * LIBVSAPM_SECTOR_CACHE_BLOCK_SIZE,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_io_handle_set_sector_cache_size(
+	          io_handle,
+	          ( 1024 * 1024 ) + 512,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvsapm_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_handle != NULL )
+	{
+		libvsapm_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvsapm_io_handle_create_read_queue function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_io_handle_create_read_queue(
+     void )
+{
+	libcerror_error_t *error           = NULL;
+	libvsapm_io_handle_t *io_handle    = NULL;
+	libvsapm_read_queue_t *read_queue  = NULL;
+	libvsapm_read_queue_t *read_queue2 = NULL;
+	int result                         = 0;
+
+	/* Initialize test
+	 */
+	result = libvsapm_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvsapm_io_handle_get_read_queue(
+	          io_handle,
+	          &read_queue,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "read_queue",
+	 read_queue );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_io_handle_create_read_queue(
+	          io_handle,
+	          &read_queue,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "read_queue",
+	 read_queue );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that the read queue is created once and retained when the IO handle is cleared
+	 */
+	result = libvsapm_io_handle_clear(
+	          io_handle,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_io_handle_create_read_queue(
+	          io_handle,
+	          &read_queue2,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_EQUAL_INTPTR(
+	 "read_queue2",
+	 (intptr_t) read_queue2,
+	 (intptr_t) read_queue );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_io_handle_get_read_queue(
+	          io_handle,
+	          &read_queue2,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_EQUAL_INTPTR(
+	 "read_queue2",
+	 (intptr_t) read_queue2,
+	 (intptr_t) read_queue );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvsapm_io_handle_create_read_queue(
+	          NULL,
+	          &read_queue,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_io_handle_create_read_queue(
+	          io_handle,
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_io_handle_get_read_queue(
+	          NULL,
+	          &read_queue,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_io_handle_get_read_queue(
+	          io_handle,
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvsapm_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_handle != NULL )
+	{
+		libvsapm_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT ) */
 
 /* The main program
@@ -429,6 +1013,18 @@ int main(
 	 "libvsapm_io_handle_clear",
 	 vsapm_test_io_handle_clear );
 
+	VSAPM_TEST_RUN(
+	 "libvsapm_io_handle_set_bytes_per_sector",
+	 vsapm_test_io_handle_set_bytes_per_sector );
+
+	VSAPM_TEST_RUN(
+	 "libvsapm_io_handle_set_sector_cache_size",
+	 vsapm_test_io_handle_set_sector_cache_size );
+
+	VSAPM_TEST_RUN(
+	 "libvsapm_io_handle_create_read_queue",
+	 vsapm_test_io_handle_create_read_queue );
+
 #endif /* defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT ) */
 
 	return( EXIT_SUCCESS );
@@ -44,6 +44,7 @@
 #include "vsapm_test_macros.h"
 #include "vsapm_test_memory.h"
 #include "vsapm_test_rwlock.h"
+#include "vsapm_test_unused.h"
 
 #include "../libvsapm/libvsapm_io_handle.h"
 #include "../libvsapm/libvsapm_partition.h"
@@ -2710,6 +2711,430 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libvsapm_partition_clone function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_partition_clone(
+     libvsapm_partition_t *partition )
+{
+	uint8_t clone_buffer[ VSAPM_TEST_PARTITION_READ_BUFFER_SIZE ];
+	uint8_t partition_buffer[ VSAPM_TEST_PARTITION_READ_BUFFER_SIZE ];
+
+	libcerror_error_t *error              = NULL;
+	libvsapm_partition_t *clone_partition = NULL;
+	size64_t partition_size               = 0;
+	size_t read_size                      = 0;
+	ssize_t read_count                    = 0;
+	off64_t offset                        = 0;
+	int result                            = 0;
+
+	/* Initialize test
+	 */
+	result = libvsapm_partition_get_size(
+	          partition,
+	          &partition_size,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_size = VSAPM_TEST_PARTITION_READ_BUFFER_SIZE;
+
+	if( partition_size < VSAPM_TEST_PARTITION_READ_BUFFER_SIZE )
+	{
+		read_size = (size_t) partition_size;
+	}
+	offset = libvsapm_partition_seek_offset(
+	          partition,
+	          0,
+	          SEEK_END,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) partition_size );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvsapm_partition_clone(
+	          &clone_partition,
+	          partition,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "clone_partition",
+	 clone_partition );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The clone has its own current offset
+	 */
+	result = libvsapm_partition_get_offset(
+	          clone_partition,
+	          &offset,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 0 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libvsapm_partition_read_buffer(
+	              clone_partition,
+	              clone_buffer,
+	              read_size,
+	              &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) read_size );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_partition_get_offset(
+	          partition,
+	          &offset,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) partition_size );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The clone shares the sector cache and reads the same data
+	 */
+	read_count = libvsapm_partition_read_buffer_at_offset(
+	              partition,
+	              partition_buffer,
+	              read_size,
+	              0,
+	              &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) read_size );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          clone_buffer,
+	          partition_buffer,
+	          read_size );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libvsapm_partition_free(
+	          &clone_partition,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "clone_partition",
+	 clone_partition );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvsapm_partition_clone(
+	          NULL,
+	          partition,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	clone_partition = (libvsapm_partition_t *) 0x12345678UL;
+
+	result = libvsapm_partition_clone(
+	          &clone_partition,
+	          partition,
+	          &error );
+
+	clone_partition = NULL;
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_partition_clone(
+	          &clone_partition,
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( clone_partition != NULL )
+	{
+		libvsapm_partition_free(
+		 &clone_partition,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Callback function to test the libvsapm_partition_get_sparse_ranges function
+ * Returns 1 to continue
+ */
+int vsapm_test_partition_sparse_range_callback(
+     off64_t range_offset,
+     size64_t range_size,
+     void *callback_data )
+{
+	size64_t *ranges_size = (size64_t *) callback_data;
+
+	if( ( range_offset < 0 )
+	 || ( range_size == 0 ) )
+	{
+		return( -1 );
+	}
+	*ranges_size += range_size;
+
+	return( 1 );
+}
+
+/* Callback function to test the libvsapm_partition_get_sparse_ranges function
+ * Returns -1 to signal an error
+ */
+int vsapm_test_partition_sparse_range_error_callback(
+     off64_t range_offset VSAPM_TEST_ATTRIBUTE_UNUSED,
+     size64_t range_size VSAPM_TEST_ATTRIBUTE_UNUSED,
+     void *callback_data VSAPM_TEST_ATTRIBUTE_UNUSED )
+{
+	VSAPM_TEST_UNREFERENCED_PARAMETER( range_offset )
+	VSAPM_TEST_UNREFERENCED_PARAMETER( range_size )
+	VSAPM_TEST_UNREFERENCED_PARAMETER( callback_data )
+
+	return( -1 );
+}
+
+/* Tests the libvsapm_partition_get_sparse_ranges function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_partition_get_sparse_ranges(
+     libvsapm_partition_t *partition )
+{
+	libcerror_error_t *error = NULL;
+	size64_t ranges_size     = 0;
+	size64_t size            = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = libvsapm_partition_get_size(
+	          partition,
+	          &size,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvsapm_partition_get_sparse_ranges(
+	          partition,
+	          4096,
+	          &vsapm_test_partition_sparse_range_callback,
+	          (void *) &ranges_size,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSAPM_TEST_ASSERT_LESS_THAN_UINT64(
+	 "ranges_size",
+	 (uint64_t) ranges_size,
+	 (uint64_t) size + 1 );
+
+	/* Test error cases
+	 */
+	result = libvsapm_partition_get_sparse_ranges(
+	          NULL,
+	          4096,
+	          &vsapm_test_partition_sparse_range_callback,
+	          (void *) &ranges_size,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_partition_get_sparse_ranges(
+	          partition,
+	          0,
+	          &vsapm_test_partition_sparse_range_callback,
+	          (void *) &ranges_size,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_partition_get_sparse_ranges(
+	          partition,
+	          4096,
+	          NULL,
+	          (void *) &ranges_size,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( ranges_size > 0 )
+	{
+		result = libvsapm_partition_get_sparse_ranges(
+		          partition,
+		          4096,
+		          &vsapm_test_partition_sparse_range_error_callback,
+		          NULL,
+		          &error );
+
+		VSAPM_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VSAPM_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 /* The main program
  */
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -2937,6 +3362,16 @@ int main(
 			 vsapm_test_partition_get_size,
 			 partition );
 
+			VSAPM_TEST_RUN_WITH_ARGS(
+			 "libvsapm_partition_clone",
+			 vsapm_test_partition_clone,
+			 partition );
+
+			VSAPM_TEST_RUN_WITH_ARGS(
+			 "libvsapm_partition_get_sparse_ranges",
+			 vsapm_test_partition_get_sparse_ranges,
+			 partition );
+
 			result = libvsapm_partition_free(
 			          &partition,
 			          &error );
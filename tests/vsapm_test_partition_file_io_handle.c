@@ -0,0 +1,756 @@
+/*
+ * Library partition_file_io_handle type test program
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vsapm_test_functions.h"
+#include "vsapm_test_libbfio.h"
+#include "vsapm_test_libcerror.h"
+#include "vsapm_test_libvsapm.h"
+#include "vsapm_test_macros.h"
+#include "vsapm_test_memory.h"
+#include "vsapm_test_unused.h"
+
+#include "../libvsapm/libvsapm_io_handle.h"
+#include "../libvsapm/libvsapm_partition.h"
+#include "../libvsapm/libvsapm_partition_file_io_handle.h"
+#include "../libvsapm/libvsapm_partition_map_entry.h"
+
+#if defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT )
+
+/* Tests the libvsapm_partition_file_io_handle_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_partition_file_io_handle_initialize(
+     void )
+{
+	uint8_t data[ 1024 ];
+
+	libbfio_handle_t *file_io_handle                              = NULL;
+	libcerror_error_t *error                                      = NULL;
+	libvsapm_io_handle_t *io_handle                               = NULL;
+	libvsapm_partition_t *partition                               = NULL;
+	libvsapm_partition_file_io_handle_t *partition_file_io_handle = NULL;
+	libvsapm_partition_map_entry_t *partition_map_entry           = NULL;
+	int result                                                    = 0;
+
+	/* Initialize test
+	 */
+	result = vsapm_test_open_file_io_handle(
+	          &file_io_handle,
+	          data,
+	          1024,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_partition_map_entry_initialize(
+	          &partition_map_entry,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "partition_map_entry",
+	 partition_map_entry );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	partition_map_entry->sector_number     = 1;
+	partition_map_entry->number_of_sectors = 1;
+
+	result = libvsapm_partition_initialize(
+	          &partition,
+	          io_handle,
+	          file_io_handle,
+	          partition_map_entry,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "partition",
+	 partition );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvsapm_partition_file_io_handle_initialize(
+	          &partition_file_io_handle,
+	          partition,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "partition_file_io_handle",
+	 partition_file_io_handle );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_partition_file_io_handle_free(
+	          &partition_file_io_handle,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "partition_file_io_handle",
+	 partition_file_io_handle );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvsapm_partition_file_io_handle_initialize(
+	          NULL,
+	          partition,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_partition_file_io_handle_initialize(
+	          &partition_file_io_handle,
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "partition_file_io_handle",
+	 partition_file_io_handle );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvsapm_partition_free(
+	          &partition,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_partition_map_entry_free(
+	          &partition_map_entry,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vsapm_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( partition_file_io_handle != NULL )
+	{
+		libvsapm_partition_file_io_handle_free(
+		 &partition_file_io_handle,
+		 NULL );
+	}
+	if( partition != NULL )
+	{
+		libvsapm_partition_free(
+		 &partition,
+		 NULL );
+	}
+	if( partition_map_entry != NULL )
+	{
+		libvsapm_partition_map_entry_free(
+		 &partition_map_entry,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libvsapm_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvsapm_partition_file_io_handle_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_partition_file_io_handle_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvsapm_partition_file_io_handle_free(
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests reading from a handle created by libvsapm_partition_file_io_handle_initialize_handle
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_partition_file_io_handle_read(
+     void )
+{
+	uint8_t buffer[ 1024 ];
+	uint8_t data[ 2048 ];
+
+	libbfio_handle_t *file_io_handle                    = NULL;
+	libbfio_handle_t *partition_file_io_handle          = NULL;
+	libcerror_error_t *error                            = NULL;
+	libvsapm_io_handle_t *io_handle                     = NULL;
+	libvsapm_partition_t *partition                     = NULL;
+	libvsapm_partition_map_entry_t *partition_map_entry = NULL;
+	size64_t size                                       = 0;
+	ssize_t read_count                                  = 0;
+	off64_t offset                                      = 0;
+	size_t data_offset                                  = 0;
+	int result                                          = 0;
+
+	/* Initialize test
+	 */
+	for( data_offset = 0;
+	     data_offset < 2048;
+	     data_offset++ )
+	{
+		data[ data_offset ] = (uint8_t) ( data_offset / 256 );
+	}
+	result = vsapm_test_open_file_io_handle(
+	          &file_io_handle,
+	          data,
+	          2048,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_partition_map_entry_initialize(
+	          &partition_map_entry,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "partition_map_entry",
+	 partition_map_entry );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	partition_map_entry->sector_number     = 1;
+	partition_map_entry->number_of_sectors = 1;
+
+	result = libvsapm_partition_initialize(
+	          &partition,
+	          io_handle,
+	          file_io_handle,
+	          partition_map_entry,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "partition",
+	 partition );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_partition_file_io_handle_initialize_handle(
+	          &partition_file_io_handle,
+	          partition,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "partition_file_io_handle",
+	 partition_file_io_handle );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The handle holds its own clone of the partition
+	 */
+	result = libvsapm_partition_free(
+	          &partition,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_open(
+	          partition_file_io_handle,
+	          LIBBFIO_OPEN_READ,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libbfio_handle_get_size(
+	          partition_file_io_handle,
+	          &size,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_EQUAL_UINT64(
+	 "size",
+	 size,
+	 (uint64_t) 512 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The read is limited to the size of the partition
+	 */
+	read_count = libbfio_handle_read_buffer_at_offset(
+	              partition_file_io_handle,
+	              buffer,
+	              1024,
+	              0,
+	              &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 512 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSAPM_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 0 ]",
+	 buffer[ 0 ],
+	 2 );
+
+	VSAPM_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 511 ]",
+	 buffer[ 511 ],
+	 3 );
+
+	/* Test seek relative to the end of the partition
+	 */
+	offset = libbfio_handle_seek_offset(
+	          partition_file_io_handle,
+	          -16,
+	          SEEK_END,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 (int64_t) offset,
+	 (int64_t) 496 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libbfio_handle_read_buffer(
+	              partition_file_io_handle,
+	              buffer,
+	              1024,
+	              &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 16 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test read beyond the end of the partition
+	 */
+	read_count = libbfio_handle_read_buffer(
+	              partition_file_io_handle,
+	              buffer,
+	              1024,
+	              &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	offset = libbfio_handle_seek_offset(
+	          partition_file_io_handle,
+	          -1,
+	          SEEK_SET,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 (int64_t) offset,
+	 (int64_t) -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbfio_handle_free(
+	          &partition_file_io_handle,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_partition_map_entry_free(
+	          &partition_map_entry,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vsapm_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( partition_file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &partition_file_io_handle,
+		 NULL );
+	}
+	if( partition != NULL )
+	{
+		libvsapm_partition_free(
+		 &partition,
+		 NULL );
+	}
+	if( partition_map_entry != NULL )
+	{
+		libvsapm_partition_map_entry_free(
+		 &partition_map_entry,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libvsapm_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VSAPM_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VSAPM_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VSAPM_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VSAPM_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VSAPM_TEST_UNREFERENCED_PARAMETER( argc )
+	VSAPM_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT )
+
+	VSAPM_TEST_RUN(
+	 "libvsapm_partition_file_io_handle_initialize",
+	 vsapm_test_partition_file_io_handle_initialize );
+
+	VSAPM_TEST_RUN(
+	 "libvsapm_partition_file_io_handle_free",
+	 vsapm_test_partition_file_io_handle_free );
+
+	VSAPM_TEST_RUN(
+	 "libvsapm_partition_file_io_handle_read",
+	 vsapm_test_partition_file_io_handle_read );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT ) */
+}
+
@@ -0,0 +1,755 @@
+/*
+ * Library partition_index type test program
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vsapm_test_libcerror.h"
+#include "vsapm_test_libvsapm.h"
+#include "vsapm_test_macros.h"
+#include "vsapm_test_memory.h"
+#include "vsapm_test_unused.h"
+
+#include "../libvsapm/libvsapm_libcdata.h"
+#include "../libvsapm/libvsapm_partition_index.h"
+#include "../libvsapm/libvsapm_partition_map_entry.h"
+
+#if defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT )
+
+/* Appends a partition map entry to the partitions array
+ * Returns 1 if successful or -1 on error
+ */
+int vsapm_test_partition_index_append_partition(
+     libcdata_array_t *partitions,
+     uint32_t sector_number,
+     uint32_t number_of_sectors,
+     libcerror_error_t **error )
+{
+	libvsapm_partition_map_entry_t *partition_map_entry = NULL;
+	int entry_index                                     = 0;
+
+	if( libvsapm_partition_map_entry_initialize(
+	     &partition_map_entry,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	partition_map_entry->sector_number     = sector_number;
+	partition_map_entry->number_of_sectors = number_of_sectors;
+
+	if( libcdata_array_append_entry(
+	     partitions,
+	     &entry_index,
+	     (intptr_t *) partition_map_entry,
+	     error ) != 1 )
+	{
+		libvsapm_partition_map_entry_free(
+		 &partition_map_entry,
+		 NULL );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Tests the libvsapm_partition_index_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_partition_index_initialize(
+     void )
+{
+	libcdata_array_t *partitions                = NULL;
+	libcerror_error_t *error                    = NULL;
+	libvsapm_partition_index_t *partition_index = NULL;
+	int result                                  = 0;
+
+#if defined( HAVE_VSAPM_TEST_MEMORY )
+	int number_of_malloc_fail_tests             = 3;
+	int number_of_memset_fail_tests             = 1;
+	int test_number                             = 0;
+#endif
+
+	/* Initialize test
+	 */
+	result = libcdata_array_initialize(
+	          &partitions,
+	          0,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "partitions",
+	 partitions );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vsapm_test_partition_index_append_partition(
+	          partitions,
+	          64,
+	          32,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvsapm_partition_index_initialize(
+	          &partition_index,
+	          partitions,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "partition_index",
+	 partition_index );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_partition_index_free(
+	          &partition_index,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "partition_index",
+	 partition_index );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvsapm_partition_index_initialize(
+	          NULL,
+	          partitions,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	partition_index = (libvsapm_partition_index_t *) 0x12345678UL;
+
+	result = libvsapm_partition_index_initialize(
+	          &partition_index,
+	          partitions,
+	          &error );
+
+	partition_index = NULL;
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_partition_index_initialize(
+	          &partition_index,
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_VSAPM_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvsapm_partition_index_initialize with malloc failing
+		 */
+		vsapm_test_malloc_attempts_before_fail = test_number;
+
+		result = libvsapm_partition_index_initialize(
+		          &partition_index,
+		          partitions,
+		          &error );
+
+		if( vsapm_test_malloc_attempts_before_fail != -1 )
+		{
+			vsapm_test_malloc_attempts_before_fail = -1;
+
+			if( partition_index != NULL )
+			{
+				libvsapm_partition_index_free(
+				 &partition_index,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSAPM_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSAPM_TEST_ASSERT_IS_NULL(
+			 "partition_index",
+			 partition_index );
+
+			VSAPM_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvsapm_partition_index_initialize with memset failing
+		 */
+		vsapm_test_memset_attempts_before_fail = test_number;
+
+		result = libvsapm_partition_index_initialize(
+		          &partition_index,
+		          partitions,
+		          &error );
+
+		if( vsapm_test_memset_attempts_before_fail != -1 )
+		{
+			vsapm_test_memset_attempts_before_fail = -1;
+
+			if( partition_index != NULL )
+			{
+				libvsapm_partition_index_free(
+				 &partition_index,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSAPM_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSAPM_TEST_ASSERT_IS_NULL(
+			 "partition_index",
+			 partition_index );
+
+			VSAPM_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VSAPM_TEST_MEMORY ) */
+
+	/* Clean up
+	 */
+	result = libcdata_array_free(
+	          &partitions,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libvsapm_partition_map_entry_free,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( partition_index != NULL )
+	{
+		libvsapm_partition_index_free(
+		 &partition_index,
+		 NULL );
+	}
+	if( partitions != NULL )
+	{
+		libcdata_array_free(
+		 &partitions,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libvsapm_partition_map_entry_free,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvsapm_partition_index_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_partition_index_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvsapm_partition_index_free(
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvsapm_partition_index_get_partition_index_by_sector_number function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_partition_index_get_partition_index_by_sector_number(
+     void )
+{
+	/* The sector numbers to look up and the expected partition array index or -1 if not contained
+	 */
+	int test_values[ 11 ][ 2 ] = {
+		{ 0, -1 }, { 7, -1 }, { 8, 1 }, { 23, 1 }, { 24, 3 }, { 31, 3 },
+		{ 32, -1 }, { 63, -1 }, { 64, 0 }, { 95, 0 }, { 96, -1 } };
+
+	libcdata_array_t *partitions                = NULL;
+	libcerror_error_t *error                    = NULL;
+	libvsapm_partition_index_t *partition_index = NULL;
+	int partition_array_index                   = 0;
+	int result                                  = 0;
+	int test_index                              = 0;
+
+	/* Initialize test
+	 */
+	result = libcdata_array_initialize(
+	          &partitions,
+	          0,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "partitions",
+	 partitions );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Add the partitions out of order and one without sectors
+	 */
+	result = vsapm_test_partition_index_append_partition(
+	          partitions,
+	          64,
+	          32,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = vsapm_test_partition_index_append_partition(
+	          partitions,
+	          8,
+	          16,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = vsapm_test_partition_index_append_partition(
+	          partitions,
+	          100,
+	          0,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = vsapm_test_partition_index_append_partition(
+	          partitions,
+	          24,
+	          8,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_partition_index_initialize(
+	          &partition_index,
+	          partitions,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "partition_index",
+	 partition_index );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "partition_index->number_of_entries",
+	 partition_index->number_of_entries,
+	 3 );
+
+	VSAPM_TEST_ASSERT_EQUAL_UINT8(
+	 "partition_index->has_overlapping_partitions",
+	 partition_index->has_overlapping_partitions,
+	 (uint8_t) 0 );
+
+	/* Test regular cases
+	 */
+	for( test_index = 0;
+	     test_index < 11;
+	     test_index++ )
+	{
+		partition_array_index = -1;
+
+		result = libvsapm_partition_index_get_partition_index_by_sector_number(
+		          partition_index,
+		          (uint64_t) test_values[ test_index ][ 0 ],
+		          &partition_array_index,
+		          &error );
+
+		VSAPM_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 ( test_values[ test_index ][ 1 ] == -1 ) ? 0 : 1 );
+
+		VSAPM_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		VSAPM_TEST_ASSERT_EQUAL_INT(
+		 "partition_array_index",
+		 partition_array_index,
+		 test_values[ test_index ][ 1 ] );
+	}
+	result = libvsapm_partition_index_free(
+	          &partition_index,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test with a partition that overlaps the partition at sector 64
+	 */
+	result = vsapm_test_partition_index_append_partition(
+	          partitions,
+	          70,
+	          10,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_partition_index_initialize(
+	          &partition_index,
+	          partitions,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSAPM_TEST_ASSERT_EQUAL_UINT8(
+	 "partition_index->has_overlapping_partitions",
+	 partition_index->has_overlapping_partitions,
+	 (uint8_t) 1 );
+
+	result = libvsapm_partition_index_get_partition_index_by_sector_number(
+	          partition_index,
+	          75,
+	          &partition_array_index,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "partition_array_index",
+	 partition_array_index,
+	 4 );
+
+	result = libvsapm_partition_index_get_partition_index_by_sector_number(
+	          partition_index,
+	          85,
+	          &partition_array_index,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "partition_array_index",
+	 partition_array_index,
+	 0 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvsapm_partition_index_get_partition_index_by_sector_number(
+	          NULL,
+	          64,
+	          &partition_array_index,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_partition_index_get_partition_index_by_sector_number(
+	          partition_index,
+	          64,
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvsapm_partition_index_free(
+	          &partition_index,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_array_free(
+	          &partitions,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libvsapm_partition_map_entry_free,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( partition_index != NULL )
+	{
+		libvsapm_partition_index_free(
+		 &partition_index,
+		 NULL );
+	}
+	if( partitions != NULL )
+	{
+		libcdata_array_free(
+		 &partitions,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libvsapm_partition_map_entry_free,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VSAPM_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VSAPM_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VSAPM_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VSAPM_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VSAPM_TEST_UNREFERENCED_PARAMETER( argc )
+	VSAPM_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT )
+
+	VSAPM_TEST_RUN(
+	 "libvsapm_partition_index_initialize",
+	 vsapm_test_partition_index_initialize );
+
+	VSAPM_TEST_RUN(
+	 "libvsapm_partition_index_free",
+	 vsapm_test_partition_index_free );
+
+	VSAPM_TEST_RUN(
+	 "libvsapm_partition_index_get_partition_index_by_sector_number",
+	 vsapm_test_partition_index_get_partition_index_by_sector_number );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT ) */
+}
+
@@ -306,6 +306,204 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libvsapm_partition_map_entry_clone function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_partition_map_entry_clone(
+     void )
+{
+	libcerror_error_t *error                                        = NULL;
+	libvsapm_partition_map_entry_t *destination_partition_map_entry = NULL;
+	libvsapm_partition_map_entry_t *source_partition_map_entry      = NULL;
+	uint32_t sector_number                                          = 0;
+	int result                                                      = 0;
+
+	/* Initialize test
+	 */
+	result = libvsapm_partition_map_entry_initialize(
+	          &source_partition_map_entry,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "source_partition_map_entry",
+	 source_partition_map_entry );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_partition_map_entry_read_data(
+	          source_partition_map_entry,
+	          vsapm_test_partition_map_entry_data1,
+	          512,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvsapm_partition_map_entry_clone(
+	          &destination_partition_map_entry,
+	          source_partition_map_entry,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "destination_partition_map_entry",
+	 destination_partition_map_entry );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_partition_map_entry_get_sector_number(
+	          destination_partition_map_entry,
+	          &sector_number,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_EQUAL_UINT32(
+	 "sector_number",
+	 sector_number,
+	 (uint32_t) 0x42 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_partition_map_entry_free(
+	          &destination_partition_map_entry,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_partition_map_entry_clone(
+	          &destination_partition_map_entry,
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "destination_partition_map_entry",
+	 destination_partition_map_entry );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvsapm_partition_map_entry_clone(
+	          NULL,
+	          source_partition_map_entry,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	destination_partition_map_entry = (libvsapm_partition_map_entry_t *) 0x12345678UL;
+
+	result = libvsapm_partition_map_entry_clone(
+	          &destination_partition_map_entry,
+	          source_partition_map_entry,
+	          &error );
+
+	destination_partition_map_entry = NULL;
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvsapm_partition_map_entry_free(
+	          &source_partition_map_entry,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "source_partition_map_entry",
+	 source_partition_map_entry );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( destination_partition_map_entry != NULL )
+	{
+		libvsapm_partition_map_entry_free(
+		 &destination_partition_map_entry,
+		 NULL );
+	}
+	if( source_partition_map_entry != NULL )
+	{
+		libvsapm_partition_map_entry_free(
+		 &source_partition_map_entry,
+		 NULL );
+	}
+	return( 0 );
+}
+
 /* Tests the libvsapm_partition_map_entry_read_data function
  * Returns 1 if successful or 0 if not
  */
@@ -704,6 +902,10 @@ int main(
 	 "libvsapm_partition_map_entry_free",
 	 vsapm_test_partition_map_entry_free );
 
+	VSAPM_TEST_RUN(
+	 "libvsapm_partition_map_entry_clone",
+	 vsapm_test_partition_map_entry_clone );
+
 	VSAPM_TEST_RUN(
 	 "libvsapm_partition_map_entry_read_data",
 	 vsapm_test_partition_map_entry_read_data );
@@ -0,0 +1,561 @@
+/*
+ * Library pool_file_io_handle type test program
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vsapm_test_libbfio.h"
+#include "vsapm_test_libcerror.h"
+#include "vsapm_test_libvsapm.h"
+#include "vsapm_test_macros.h"
+#include "vsapm_test_memory.h"
+#include "vsapm_test_unused.h"
+
+#include "../libvsapm/libvsapm_pool_file_io_handle.h"
+
+#if defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT )
+
+/* Creates a file IO pool with a memory range file IO handle per segment
+ * Returns 1 if successful or -1 on error
+ */
+int vsapm_test_pool_file_io_handle_create_pool(
+     libbfio_pool_t **file_io_pool,
+     uint8_t *data,
+     size_t *segment_sizes,
+     int number_of_segments,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	size_t data_offset               = 0;
+	int entry_index                  = 0;
+	int segment_index                = 0;
+
+	if( libbfio_pool_initialize(
+	     file_io_pool,
+	     0,
+	     0,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	for( segment_index = 0;
+	     segment_index < number_of_segments;
+	     segment_index++ )
+	{
+		if( libbfio_memory_range_initialize(
+		     &file_io_handle,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+		if( libbfio_memory_range_set(
+		     file_io_handle,
+		     &( data[ data_offset ] ),
+		     segment_sizes[ segment_index ],
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+		if( libbfio_pool_append_handle(
+		     *file_io_pool,
+		     &entry_index,
+		     file_io_handle,
+		     LIBBFIO_OPEN_READ,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+		file_io_handle = NULL;
+
+		data_offset += segment_sizes[ segment_index ];
+	}
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( *file_io_pool != NULL )
+	{
+		libbfio_pool_free(
+		 file_io_pool,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Tests the libvsapm_pool_file_io_handle_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_pool_file_io_handle_initialize(
+     void )
+{
+	uint8_t data[ 1024 ];
+
+	size_t segment_sizes[ 2 ]                           = { 512, 512 };
+	libbfio_pool_t *file_io_pool                        = NULL;
+	libcerror_error_t *error                            = NULL;
+	libvsapm_pool_file_io_handle_t *pool_file_io_handle = NULL;
+	size64_t size                                       = 0;
+	int result                                          = 0;
+
+	/* Initialize test
+	 */
+	result = vsapm_test_pool_file_io_handle_create_pool(
+	          &file_io_pool,
+	          data,
+	          segment_sizes,
+	          2,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_pool",
+	 file_io_pool );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvsapm_pool_file_io_handle_initialize(
+	          &pool_file_io_handle,
+	          file_io_pool,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "pool_file_io_handle",
+	 pool_file_io_handle );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_pool_file_io_handle_get_size(
+	          pool_file_io_handle,
+	          &size,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_EQUAL_UINT64(
+	 "size",
+	 size,
+	 (uint64_t) 1024 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_pool_file_io_handle_free(
+	          &pool_file_io_handle,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "pool_file_io_handle",
+	 pool_file_io_handle );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvsapm_pool_file_io_handle_initialize(
+	          NULL,
+	          file_io_pool,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_pool_file_io_handle_initialize(
+	          &pool_file_io_handle,
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "pool_file_io_handle",
+	 pool_file_io_handle );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbfio_pool_free(
+	          &file_io_pool,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( pool_file_io_handle != NULL )
+	{
+		libvsapm_pool_file_io_handle_free(
+		 &pool_file_io_handle,
+		 NULL );
+	}
+	if( file_io_pool != NULL )
+	{
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvsapm_pool_file_io_handle_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_pool_file_io_handle_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvsapm_pool_file_io_handle_free(
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests reading from a handle created by libvsapm_pool_file_io_handle_initialize_handle
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_pool_file_io_handle_read(
+     void )
+{
+	uint8_t buffer[ 1024 ];
+	uint8_t data[ 1024 ];
+
+	size_t segment_sizes[ 3 ]             = { 300, 200, 524 };
+	libbfio_handle_t *pool_file_io_handle = NULL;
+	libbfio_pool_t *file_io_pool          = NULL;
+	libcerror_error_t *error              = NULL;
+	ssize_t read_count                    = 0;
+	size_t data_offset                    = 0;
+	int result                            = 0;
+
+	/* Initialize test
+	 */
+	for( data_offset = 0;
+	     data_offset < 1024;
+	     data_offset++ )
+	{
+		data[ data_offset ] = (uint8_t) data_offset;
+	}
+	result = vsapm_test_pool_file_io_handle_create_pool(
+	          &file_io_pool,
+	          data,
+	          segment_sizes,
+	          3,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_pool",
+	 file_io_pool );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_pool_file_io_handle_initialize_handle(
+	          &pool_file_io_handle,
+	          file_io_pool,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "pool_file_io_handle",
+	 pool_file_io_handle );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_open(
+	          pool_file_io_handle,
+	          LIBBFIO_OPEN_READ,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test read that spans multiple segments
+	 */
+	read_count = libbfio_handle_read_buffer_at_offset(
+	              pool_file_io_handle,
+	              buffer,
+	              512,
+	              256,
+	              &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 512 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer,
+	          &( data[ 256 ] ),
+	          512 );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test read that is limited to the end of the last segment
+	 */
+	read_count = libbfio_handle_read_buffer_at_offset(
+	              pool_file_io_handle,
+	              buffer,
+	              1024,
+	              1000,
+	              &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 24 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSAPM_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 23 ]",
+	 buffer[ 23 ],
+	 data[ 1023 ] );
+
+	/* Test read beyond the end of the last segment
+	 */
+	read_count = libbfio_handle_read_buffer(
+	              pool_file_io_handle,
+	              buffer,
+	              1024,
+	              &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libbfio_handle_free(
+	          &pool_file_io_handle,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_pool_free(
+	          &file_io_pool,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( pool_file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &pool_file_io_handle,
+		 NULL );
+	}
+	if( file_io_pool != NULL )
+	{
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VSAPM_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VSAPM_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VSAPM_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VSAPM_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VSAPM_TEST_UNREFERENCED_PARAMETER( argc )
+	VSAPM_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT )
+
+	VSAPM_TEST_RUN(
+	 "libvsapm_pool_file_io_handle_initialize",
+	 vsapm_test_pool_file_io_handle_initialize );
+
+	VSAPM_TEST_RUN(
+	 "libvsapm_pool_file_io_handle_free",
+	 vsapm_test_pool_file_io_handle_free );
+
+	VSAPM_TEST_RUN(
+	 "libvsapm_pool_file_io_handle_read",
+	 vsapm_test_pool_file_io_handle_read );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT ) */
+}
+
@@ -0,0 +1,874 @@
+/*
+ * Library scanner functions test program
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vsapm_test_functions.h"
+#include "vsapm_test_libbfio.h"
+#include "vsapm_test_libcerror.h"
+#include "vsapm_test_libvsapm.h"
+#include "vsapm_test_macros.h"
+#include "vsapm_test_memory.h"
+#include "vsapm_test_unused.h"
+
+#include "../libvsapm/libvsapm_scanner.h"
+
+#if defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT )
+
+/* The number of sectors of the test image
+ */
+#define VSAPM_TEST_SCANNER_NUMBER_OF_SECTORS	32
+
+uint8_t vsapm_test_scanner_data[ VSAPM_TEST_SCANNER_NUMBER_OF_SECTORS * 512 ];
+
+/* Sets a partition map entry in the test image
+ */
+void vsapm_test_scanner_set_partition_map_entry(
+      int sector_index,
+      uint32_t start_sector,
+      uint32_t number_of_sectors,
+      const char *type )
+{
+	uint8_t *entry_data = &( vsapm_test_scanner_data[ sector_index * 512 ] );
+
+	entry_data[ 0 ] = 'P';
+	entry_data[ 1 ] = 'M';
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( entry_data[ 4 ] ),
+	 2 );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( entry_data[ 8 ] ),
+	 start_sector );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( entry_data[ 12 ] ),
+	 number_of_sectors );
+
+	memory_copy(
+	 &( entry_data[ 48 ] ),
+	 type,
+	 narrow_string_length( type ) );
+}
+
+/* Creates the test image
+ * The image contains a driver descriptor, a partition map with 2 entries
+ * and a backup copy of the second entry in a later sector
+ */
+void vsapm_test_scanner_create_image(
+      void )
+{
+	memory_set(
+	 vsapm_test_scanner_data,
+	 0,
+	 VSAPM_TEST_SCANNER_NUMBER_OF_SECTORS * 512 );
+
+	vsapm_test_scanner_data[ 0 ] = 'E';
+	vsapm_test_scanner_data[ 1 ] = 'R';
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( vsapm_test_scanner_data[ 2 ] ),
+	 512 );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( vsapm_test_scanner_data[ 4 ] ),
+	 VSAPM_TEST_SCANNER_NUMBER_OF_SECTORS );
+
+	vsapm_test_scanner_set_partition_map_entry(
+	 1,
+	 1,
+	 2,
+	 "Apple_partition_map" );
+
+	vsapm_test_scanner_set_partition_map_entry(
+	 2,
+	 8,
+	 16,
+	 "Apple_HFS" );
+
+	vsapm_test_scanner_set_partition_map_entry(
+	 20,
+	 8,
+	 16,
+	 "Apple_HFS" );
+}
+
+/* Tests the libvsapm_scanner_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_scanner_initialize(
+     void )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	libcerror_error_t *error         = NULL;
+	libvsapm_scanner_t *scanner      = NULL;
+	int result                       = 0;
+
+#if defined( HAVE_VSAPM_TEST_MEMORY )
+	int number_of_malloc_fail_tests  = 3;
+	int number_of_memset_fail_tests  = 1;
+	int test_number                  = 0;
+#endif
+
+	/* Initialize test
+	 */
+	vsapm_test_scanner_create_image();
+
+	result = vsapm_test_open_file_io_handle(
+	          &file_io_handle,
+	          vsapm_test_scanner_data,
+	          VSAPM_TEST_SCANNER_NUMBER_OF_SECTORS * 512,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvsapm_scanner_initialize(
+	          &scanner,
+	          file_io_handle,
+	          0,
+	          VSAPM_TEST_SCANNER_NUMBER_OF_SECTORS * 512,
+	          0,
+	          VSAPM_TEST_SCANNER_NUMBER_OF_SECTORS * 512,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "scanner",
+	 scanner );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_scanner_free(
+	          &scanner,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "scanner",
+	 scanner );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvsapm_scanner_initialize(
+	          NULL,
+	          file_io_handle,
+	          0,
+	          VSAPM_TEST_SCANNER_NUMBER_OF_SECTORS * 512,
+	          0,
+	          VSAPM_TEST_SCANNER_NUMBER_OF_SECTORS * 512,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	scanner = (libvsapm_scanner_t *) 0x12345678UL;
+
+	result = libvsapm_scanner_initialize(
+	          &scanner,
+	          file_io_handle,
+	          0,
+	          VSAPM_TEST_SCANNER_NUMBER_OF_SECTORS * 512,
+	          0,
+	          VSAPM_TEST_SCANNER_NUMBER_OF_SECTORS * 512,
+	          &error );
+
+	scanner = NULL;
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_scanner_initialize(
+	          &scanner,
+	          NULL,
+	          0,
+	          VSAPM_TEST_SCANNER_NUMBER_OF_SECTORS * 512,
+	          0,
+	          VSAPM_TEST_SCANNER_NUMBER_OF_SECTORS * 512,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_scanner_initialize(
+	          &scanner,
+	          file_io_handle,
+	          0,
+	          VSAPM_TEST_SCANNER_NUMBER_OF_SECTORS * 512,
+	          100,
+	          VSAPM_TEST_SCANNER_NUMBER_OF_SECTORS * 512,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_scanner_initialize(
+	          &scanner,
+	          file_io_handle,
+	          0,
+	          VSAPM_TEST_SCANNER_NUMBER_OF_SECTORS * 512,
+	          0,
+	          ( VSAPM_TEST_SCANNER_NUMBER_OF_SECTORS + 1 ) * 512,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_VSAPM_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvsapm_scanner_initialize with malloc failing
+		 */
+		vsapm_test_malloc_attempts_before_fail = test_number;
+
+		result = libvsapm_scanner_initialize(
+		          &scanner,
+		          file_io_handle,
+		          0,
+		          VSAPM_TEST_SCANNER_NUMBER_OF_SECTORS * 512,
+		          0,
+		          VSAPM_TEST_SCANNER_NUMBER_OF_SECTORS * 512,
+		          &error );
+
+		if( vsapm_test_malloc_attempts_before_fail != -1 )
+		{
+			vsapm_test_malloc_attempts_before_fail = -1;
+
+			if( scanner != NULL )
+			{
+				libvsapm_scanner_free(
+				 &scanner,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSAPM_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSAPM_TEST_ASSERT_IS_NULL(
+			 "scanner",
+			 scanner );
+
+			VSAPM_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvsapm_scanner_initialize with memset failing
+		 */
+		vsapm_test_memset_attempts_before_fail = test_number;
+
+		result = libvsapm_scanner_initialize(
+		          &scanner,
+		          file_io_handle,
+		          0,
+		          VSAPM_TEST_SCANNER_NUMBER_OF_SECTORS * 512,
+		          0,
+		          VSAPM_TEST_SCANNER_NUMBER_OF_SECTORS * 512,
+		          &error );
+
+		if( vsapm_test_memset_attempts_before_fail != -1 )
+		{
+			vsapm_test_memset_attempts_before_fail = -1;
+
+			if( scanner != NULL )
+			{
+				libvsapm_scanner_free(
+				 &scanner,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSAPM_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSAPM_TEST_ASSERT_IS_NULL(
+			 "scanner",
+			 scanner );
+
+			VSAPM_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VSAPM_TEST_MEMORY ) */
+
+	/* Clean up
+	 */
+	result = vsapm_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( scanner != NULL )
+	{
+		libvsapm_scanner_free(
+		 &scanner,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvsapm_scanner_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_scanner_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvsapm_scanner_free(
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvsapm_scanner_find_signature function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_scanner_find_signature(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	size_t data_offset       = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	vsapm_test_scanner_create_image();
+
+	/* Signatures that are not at a sector boundary are ignored
+	 */
+	vsapm_test_scanner_data[ ( 10 * 512 ) + 2 ] = 'P';
+	vsapm_test_scanner_data[ ( 10 * 512 ) + 3 ] = 'M';
+
+	/* Test regular cases
+	 */
+	result = libvsapm_scanner_find_signature(
+	          vsapm_test_scanner_data,
+	          VSAPM_TEST_SCANNER_NUMBER_OF_SECTORS * 512,
+	          &data_offset,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_EQUAL_SIZE(
+	 "data_offset",
+	 data_offset,
+	 (size_t) 0 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	data_offset = 3 * 512;
+
+	result = libvsapm_scanner_find_signature(
+	          vsapm_test_scanner_data,
+	          VSAPM_TEST_SCANNER_NUMBER_OF_SECTORS * 512,
+	          &data_offset,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_EQUAL_SIZE(
+	 "data_offset",
+	 data_offset,
+	 (size_t) ( 20 * 512 ) );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	data_offset = 21 * 512;
+
+	result = libvsapm_scanner_find_signature(
+	          vsapm_test_scanner_data,
+	          VSAPM_TEST_SCANNER_NUMBER_OF_SECTORS * 512,
+	          &data_offset,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	data_offset = 0;
+
+	result = libvsapm_scanner_find_signature(
+	          NULL,
+	          VSAPM_TEST_SCANNER_NUMBER_OF_SECTORS * 512,
+	          &data_offset,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_scanner_find_signature(
+	          vsapm_test_scanner_data,
+	          (size_t) SSIZE_MAX + 1,
+	          &data_offset,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_scanner_find_signature(
+	          vsapm_test_scanner_data,
+	          VSAPM_TEST_SCANNER_NUMBER_OF_SECTORS * 512,
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	data_offset = 100;
+
+	result = libvsapm_scanner_find_signature(
+	          vsapm_test_scanner_data,
+	          VSAPM_TEST_SCANNER_NUMBER_OF_SECTORS * 512,
+	          &data_offset,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvsapm_scanner_scan_range function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_scanner_scan_range(
+     void )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	libcerror_error_t *error         = NULL;
+	libvsapm_scanner_t *scanner      = NULL;
+	int number_of_entries            = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	vsapm_test_scanner_create_image();
+
+	/* Add an entry of which the sectors exceed the size of the image
+	 */
+	vsapm_test_scanner_set_partition_map_entry(
+	 25,
+	 8,
+	 VSAPM_TEST_SCANNER_NUMBER_OF_SECTORS,
+	 "Apple_HFS" );
+
+	result = vsapm_test_open_file_io_handle(
+	          &file_io_handle,
+	          vsapm_test_scanner_data,
+	          VSAPM_TEST_SCANNER_NUMBER_OF_SECTORS * 512,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_scanner_initialize(
+	          &scanner,
+	          file_io_handle,
+	          0,
+	          VSAPM_TEST_SCANNER_NUMBER_OF_SECTORS * 512,
+	          0,
+	          VSAPM_TEST_SCANNER_NUMBER_OF_SECTORS * 512,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "scanner",
+	 scanner );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvsapm_scanner_scan_range(
+	          scanner,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSAPM_TEST_ASSERT_EQUAL_UINT16(
+	 "scanner->driver_descriptor_block_size",
+	 scanner->driver_descriptor_block_size,
+	 (uint16_t) 512 );
+
+	result = libcdata_array_get_number_of_entries(
+	          scanner->partition_map_entries,
+	          &number_of_entries,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "number_of_entries",
+	 number_of_entries,
+	 3 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvsapm_scanner_scan_range(
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvsapm_scanner_free(
+	          &scanner,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vsapm_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( scanner != NULL )
+	{
+		libvsapm_scanner_free(
+		 &scanner,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VSAPM_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VSAPM_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VSAPM_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VSAPM_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VSAPM_TEST_UNREFERENCED_PARAMETER( argc )
+	VSAPM_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT )
+
+	VSAPM_TEST_RUN(
+	 "libvsapm_scanner_initialize",
+	 vsapm_test_scanner_initialize );
+
+	VSAPM_TEST_RUN(
+	 "libvsapm_scanner_free",
+	 vsapm_test_scanner_free );
+
+	VSAPM_TEST_RUN(
+	 "libvsapm_scanner_find_signature",
+	 vsapm_test_scanner_find_signature );
+
+	VSAPM_TEST_RUN(
+	 "libvsapm_scanner_scan_range",
+	 vsapm_test_scanner_scan_range );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
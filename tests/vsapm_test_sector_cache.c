@@ -0,0 +1,1641 @@
+/*
+ * Library sector_cache type test program
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vsapm_test_functions.h"
+#include "vsapm_test_libbfio.h"
+#include "vsapm_test_libcerror.h"
+#include "vsapm_test_libvsapm.h"
+#include "vsapm_test_macros.h"
+#include "vsapm_test_memory.h"
+#include "vsapm_test_unused.h"
+
+#include "../libvsapm/libvsapm_sector_cache.h"
+#include "../libvsapm/libvsapm_sector_cache_arena.h"
+
+/* The test data contains more blocks than the sector cache has slots
+ * so that blocks are evicted
+ */
+#define VSAPM_TEST_SECTOR_CACHE_DATA_SIZE		( ( LIBVSAPM_SECTOR_CACHE_DEFAULT_NUMBER_OF_SLOTS + 8 ) * LIBVSAPM_SECTOR_CACHE_BLOCK_SIZE )
+#define VSAPM_TEST_SECTOR_CACHE_PARTITION_OFFSET	512
+#define VSAPM_TEST_SECTOR_CACHE_PARTITION_SIZE		( VSAPM_TEST_SECTOR_CACHE_DATA_SIZE - 1024 )
+
+uint8_t vsapm_test_sector_cache_data[ VSAPM_TEST_SECTOR_CACHE_DATA_SIZE ];
+
+#if defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT )
+
+/* Tests the libvsapm_sector_cache_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_sector_cache_initialize(
+     void )
+{
+	libcerror_error_t *error              = NULL;
+	libvsapm_sector_cache_t *sector_cache = NULL;
+	int result                            = 0;
+
+#if defined( HAVE_VSAPM_TEST_MEMORY )
+	int number_of_malloc_fail_tests       = 1;
+	int number_of_memset_fail_tests       = 1;
+	int test_number                       = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libvsapm_sector_cache_initialize(
+	          &sector_cache,
+	          VSAPM_TEST_SECTOR_CACHE_PARTITION_OFFSET,
+	          VSAPM_TEST_SECTOR_CACHE_PARTITION_SIZE,
+	          LIBVSAPM_SECTOR_CACHE_DEFAULT_NUMBER_OF_SLOTS,
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "sector_cache",
+	 sector_cache );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_sector_cache_free(
+	          &sector_cache,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "sector_cache",
+	 sector_cache );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvsapm_sector_cache_initialize(
+	          NULL,
+	          VSAPM_TEST_SECTOR_CACHE_PARTITION_OFFSET,
+	          VSAPM_TEST_SECTOR_CACHE_PARTITION_SIZE,
+	          LIBVSAPM_SECTOR_CACHE_DEFAULT_NUMBER_OF_SLOTS,
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	sector_cache = (libvsapm_sector_cache_t *) 0x12345678UL;
+
+	result = libvsapm_sector_cache_initialize(
+	          &sector_cache,
+	          VSAPM_TEST_SECTOR_CACHE_PARTITION_OFFSET,
+	          VSAPM_TEST_SECTOR_CACHE_PARTITION_SIZE,
+	          LIBVSAPM_SECTOR_CACHE_DEFAULT_NUMBER_OF_SLOTS,
+	          NULL,
+	          &error );
+
+	sector_cache = NULL;
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_sector_cache_initialize(
+	          &sector_cache,
+	          -1,
+	          VSAPM_TEST_SECTOR_CACHE_PARTITION_SIZE,
+	          LIBVSAPM_SECTOR_CACHE_DEFAULT_NUMBER_OF_SLOTS,
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_sector_cache_initialize(
+	          &sector_cache,
+	          VSAPM_TEST_SECTOR_CACHE_PARTITION_OFFSET,
+	          VSAPM_TEST_SECTOR_CACHE_PARTITION_SIZE,
+	          LIBVSAPM_SECTOR_CACHE_MINIMUM_NUMBER_OF_SLOTS - 1,
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "sector_cache",
+	 sector_cache );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_sector_cache_initialize(
+	          &sector_cache,
+	          VSAPM_TEST_SECTOR_CACHE_PARTITION_OFFSET,
+	          VSAPM_TEST_SECTOR_CACHE_PARTITION_SIZE,
+	          LIBVSAPM_SECTOR_CACHE_MAXIMUM_NUMBER_OF_SLOTS * 2,
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "sector_cache",
+	 sector_cache );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_sector_cache_initialize(
+	          &sector_cache,
+	          VSAPM_TEST_SECTOR_CACHE_PARTITION_OFFSET,
+	          VSAPM_TEST_SECTOR_CACHE_PARTITION_SIZE,
+	          LIBVSAPM_SECTOR_CACHE_DEFAULT_NUMBER_OF_SLOTS + 1,
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "sector_cache",
+	 sector_cache );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_VSAPM_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvsapm_sector_cache_initialize with malloc failing
+		 */
+		vsapm_test_malloc_attempts_before_fail = test_number;
+
+		result = libvsapm_sector_cache_initialize(
+		          &sector_cache,
+		          VSAPM_TEST_SECTOR_CACHE_PARTITION_OFFSET,
+		          VSAPM_TEST_SECTOR_CACHE_PARTITION_SIZE,
+		          LIBVSAPM_SECTOR_CACHE_DEFAULT_NUMBER_OF_SLOTS,
+		          NULL,
+		          &error );
+
+		if( vsapm_test_malloc_attempts_before_fail != -1 )
+		{
+			vsapm_test_malloc_attempts_before_fail = -1;
+
+			if( sector_cache != NULL )
+			{
+				libvsapm_sector_cache_free(
+				 &sector_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSAPM_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSAPM_TEST_ASSERT_IS_NULL(
+			 "sector_cache",
+			 sector_cache );
+
+			VSAPM_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvsapm_sector_cache_initialize with memset failing
+		 */
+		vsapm_test_memset_attempts_before_fail = test_number;
+
+		result = libvsapm_sector_cache_initialize(
+		          &sector_cache,
+		          VSAPM_TEST_SECTOR_CACHE_PARTITION_OFFSET,
+		          VSAPM_TEST_SECTOR_CACHE_PARTITION_SIZE,
+		          LIBVSAPM_SECTOR_CACHE_DEFAULT_NUMBER_OF_SLOTS,
+		          NULL,
+		          &error );
+
+		if( vsapm_test_memset_attempts_before_fail != -1 )
+		{
+			vsapm_test_memset_attempts_before_fail = -1;
+
+			if( sector_cache != NULL )
+			{
+				libvsapm_sector_cache_free(
+				 &sector_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSAPM_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSAPM_TEST_ASSERT_IS_NULL(
+			 "sector_cache",
+			 sector_cache );
+
+			VSAPM_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VSAPM_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( sector_cache != NULL )
+	{
+		libvsapm_sector_cache_free(
+		 &sector_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvsapm_sector_cache_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_sector_cache_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvsapm_sector_cache_free(
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvsapm_sector_cache_acquire and libvsapm_sector_cache_release functions
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_sector_cache_acquire(
+     void )
+{
+	libcerror_error_t *error                     = NULL;
+	libvsapm_sector_cache_t *sector_cache        = NULL;
+	libvsapm_sector_cache_t *shared_sector_cache = NULL;
+	int result                                   = 0;
+
+	/* Initialize test
+	 */
+	result = libvsapm_sector_cache_initialize(
+	          &sector_cache,
+	          VSAPM_TEST_SECTOR_CACHE_PARTITION_OFFSET,
+	          VSAPM_TEST_SECTOR_CACHE_PARTITION_SIZE,
+	          LIBVSAPM_SECTOR_CACHE_DEFAULT_NUMBER_OF_SLOTS,
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "sector_cache",
+	 sector_cache );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvsapm_sector_cache_acquire(
+	          sector_cache,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	shared_sector_cache = sector_cache;
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "shared_sector_cache->reference_count",
+	 shared_sector_cache->reference_count,
+	 2 );
+
+	result = libvsapm_sector_cache_release(
+	          &shared_sector_cache,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "shared_sector_cache",
+	 shared_sector_cache );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "sector_cache->reference_count",
+	 sector_cache->reference_count,
+	 1 );
+
+	/* Test error cases
+	 */
+	result = libvsapm_sector_cache_acquire(
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_sector_cache_release(
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvsapm_sector_cache_release(
+	          &sector_cache,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "sector_cache",
+	 sector_cache );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( sector_cache != NULL )
+	{
+		libvsapm_sector_cache_free(
+		 &sector_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvsapm_sector_cache_get_slot_index, libvsapm_sector_cache_read_block
+ * and libvsapm_sector_cache_set_slot_loaded functions
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_sector_cache_get_slot_index(
+     void )
+{
+	uint8_t buffer[ 100 ];
+
+	libbfio_handle_t *file_io_handle      = NULL;
+	libcerror_error_t *error              = NULL;
+	libvsapm_sector_cache_t *sector_cache = NULL;
+	uint64_t last_block_index             = 0;
+	ssize_t read_count                    = 0;
+	int loading_slot_index                = 0;
+	int result                            = 0;
+	int slot_index                        = 0;
+
+	/* Initialize test
+	 */
+	result = vsapm_test_open_file_io_handle(
+	          &file_io_handle,
+	          vsapm_test_sector_cache_data,
+	          VSAPM_TEST_SECTOR_CACHE_DATA_SIZE,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_sector_cache_initialize(
+	          &sector_cache,
+	          VSAPM_TEST_SECTOR_CACHE_PARTITION_OFFSET,
+	          VSAPM_TEST_SECTOR_CACHE_PARTITION_SIZE,
+	          LIBVSAPM_SECTOR_CACHE_DEFAULT_NUMBER_OF_SLOTS,
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "sector_cache",
+	 sector_cache );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvsapm_sector_cache_get_slot_index(
+	          sector_cache,
+	          1,
+	          &loading_slot_index,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "loading_slot_index",
+	 loading_slot_index,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "sector_cache->slots[ 1 ].is_loading",
+	 (int) sector_cache->slots[ 1 ].is_loading,
+	 1 );
+
+	/* Test that a block that is being read by another reader has no slot
+	 */
+	result = libvsapm_sector_cache_get_slot_index(
+	          sector_cache,
+	          1,
+	          &slot_index,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "slot_index",
+	 slot_index,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that a block that is being read by another reader is read without caching
+	 */
+	read_count = libvsapm_sector_cache_read_buffer_at_offset(
+	              sector_cache,
+	              file_io_handle,
+	              buffer,
+	              100,
+	              LIBVSAPM_SECTOR_CACHE_BLOCK_SIZE + 10,
+	              &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 100 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer,
+	          &( vsapm_test_sector_cache_data[ VSAPM_TEST_SECTOR_CACHE_PARTITION_OFFSET + LIBVSAPM_SECTOR_CACHE_BLOCK_SIZE + 10 ] ),
+	          100 );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "sector_cache->slots[ 1 ].is_loading",
+	 (int) sector_cache->slots[ 1 ].is_loading,
+	 1 );
+
+	read_count = libvsapm_sector_cache_read_block(
+	              sector_cache,
+	              file_io_handle,
+	              loading_slot_index,
+	              &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) LIBVSAPM_SECTOR_CACHE_BLOCK_SIZE );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_sector_cache_set_slot_loaded(
+	          sector_cache,
+	          loading_slot_index,
+	          (size_t) read_count,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that a cached block is found
+	 */
+	result = libvsapm_sector_cache_get_slot_index(
+	          sector_cache,
+	          1,
+	          &slot_index,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "slot_index",
+	 slot_index,
+	 loading_slot_index );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          &( sector_cache->blocks_data[ (size_t) slot_index << LIBVSAPM_SECTOR_CACHE_BLOCK_SIZE_SHIFT ] ),
+	          &( vsapm_test_sector_cache_data[ VSAPM_TEST_SECTOR_CACHE_PARTITION_OFFSET + LIBVSAPM_SECTOR_CACHE_BLOCK_SIZE ] ),
+	          LIBVSAPM_SECTOR_CACHE_BLOCK_SIZE );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test that the last block is smaller than the block size
+	 */
+	last_block_index = ( VSAPM_TEST_SECTOR_CACHE_PARTITION_SIZE - 1 ) >> LIBVSAPM_SECTOR_CACHE_BLOCK_SIZE_SHIFT;
+
+	result = libvsapm_sector_cache_get_slot_index(
+	          sector_cache,
+	          last_block_index,
+	          &slot_index,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libvsapm_sector_cache_read_block(
+	              sector_cache,
+	              file_io_handle,
+	              slot_index,
+	              &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) ( VSAPM_TEST_SECTOR_CACHE_PARTITION_SIZE - ( last_block_index << LIBVSAPM_SECTOR_CACHE_BLOCK_SIZE_SHIFT ) ) );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that a slot that failed to load is empty
+	 */
+	result = libvsapm_sector_cache_set_slot_loaded(
+	          sector_cache,
+	          slot_index,
+	          0,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SIZE(
+	 "sector_cache->slots[ slot_index ].data_size",
+	 sector_cache->slots[ slot_index ].data_size,
+	 (size_t) 0 );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "sector_cache->slots[ slot_index ].is_loading",
+	 (int) sector_cache->slots[ slot_index ].is_loading,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libvsapm_sector_cache_get_slot_index(
+	          NULL,
+	          1,
+	          &slot_index,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_sector_cache_get_slot_index(
+	          sector_cache,
+	          last_block_index + 1,
+	          &slot_index,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_sector_cache_get_slot_index(
+	          sector_cache,
+	          1,
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvsapm_sector_cache_read_block(
+	              NULL,
+	              file_io_handle,
+	              loading_slot_index,
+	              &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvsapm_sector_cache_read_block(
+	              sector_cache,
+	              file_io_handle,
+	              -1,
+	              &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test reading into a slot that is not loading
+	 */
+	read_count = libvsapm_sector_cache_read_block(
+	              sector_cache,
+	              file_io_handle,
+	              loading_slot_index,
+	              &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_sector_cache_set_slot_loaded(
+	          NULL,
+	          loading_slot_index,
+	          0,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_sector_cache_set_slot_loaded(
+	          sector_cache,
+	          sector_cache->number_of_slots,
+	          0,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_sector_cache_set_slot_loaded(
+	          sector_cache,
+	          loading_slot_index,
+	          LIBVSAPM_SECTOR_CACHE_BLOCK_SIZE + 1,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvsapm_sector_cache_free(
+	          &sector_cache,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "sector_cache",
+	 sector_cache );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vsapm_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( sector_cache != NULL )
+	{
+		libvsapm_sector_cache_free(
+		 &sector_cache,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests that a block that was evicted is read again
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_sector_cache_evict_block(
+     void )
+{
+	uint8_t buffer[ 100 ];
+
+	libbfio_handle_t *file_io_handle      = NULL;
+	libcerror_error_t *error              = NULL;
+	libvsapm_sector_cache_t *sector_cache = NULL;
+	ssize_t read_count                    = 0;
+	off64_t offset                        = 0;
+	int block_index                       = 0;
+	int number_of_cached_blocks           = 0;
+	int result                            = 0;
+	int slot_index                        = 0;
+
+	/* Initialize test
+	 */
+	result = vsapm_test_open_file_io_handle(
+	          &file_io_handle,
+	          vsapm_test_sector_cache_data,
+	          VSAPM_TEST_SECTOR_CACHE_DATA_SIZE,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Use the minimum number of slots so that all slots are probed for every block
+	 */
+	result = libvsapm_sector_cache_initialize(
+	          &sector_cache,
+	          VSAPM_TEST_SECTOR_CACHE_PARTITION_OFFSET,
+	          VSAPM_TEST_SECTOR_CACHE_PARTITION_SIZE,
+	          LIBVSAPM_SECTOR_CACHE_MINIMUM_NUMBER_OF_SLOTS,
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "sector_cache",
+	 sector_cache );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 * Read one more block than the sector cache has slots, which evicts the first block
+	 */
+	for( block_index = 0;
+	     block_index <= LIBVSAPM_SECTOR_CACHE_MINIMUM_NUMBER_OF_SLOTS;
+	     block_index++ )
+	{
+		offset = ( (off64_t) block_index << LIBVSAPM_SECTOR_CACHE_BLOCK_SIZE_SHIFT ) + 10;
+
+		read_count = libvsapm_sector_cache_read_buffer_at_offset(
+		              sector_cache,
+		              file_io_handle,
+		              buffer,
+		              100,
+		              offset,
+		              &error );
+
+		VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 100 );
+
+		VSAPM_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	for( slot_index = 0;
+	     slot_index < LIBVSAPM_SECTOR_CACHE_MINIMUM_NUMBER_OF_SLOTS;
+	     slot_index++ )
+	{
+		VSAPM_TEST_ASSERT_NOT_EQUAL_INT64(
+		 "sector_cache->slots[ slot_index ].block_index",
+		 (int64_t) sector_cache->slots[ slot_index ].block_index,
+		 (int64_t) 0 );
+
+		if( sector_cache->slots[ slot_index ].data_size != 0 )
+		{
+			number_of_cached_blocks++;
+		}
+	}
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "number_of_cached_blocks",
+	 number_of_cached_blocks,
+	 LIBVSAPM_SECTOR_CACHE_MINIMUM_NUMBER_OF_SLOTS );
+
+	/* Read the evicted block again
+	 */
+	read_count = libvsapm_sector_cache_read_buffer_at_offset(
+	              sector_cache,
+	              file_io_handle,
+	              buffer,
+	              100,
+	              10,
+	              &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 100 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer,
+	          &( vsapm_test_sector_cache_data[ VSAPM_TEST_SECTOR_CACHE_PARTITION_OFFSET + 10 ] ),
+	          100 );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libvsapm_sector_cache_get_slot_index(
+	          sector_cache,
+	          0,
+	          &slot_index,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The second block was the least recently used block and was evicted
+	 */
+	for( slot_index = 0;
+	     slot_index < LIBVSAPM_SECTOR_CACHE_MINIMUM_NUMBER_OF_SLOTS;
+	     slot_index++ )
+	{
+		VSAPM_TEST_ASSERT_NOT_EQUAL_INT64(
+		 "sector_cache->slots[ slot_index ].block_index",
+		 (int64_t) sector_cache->slots[ slot_index ].block_index,
+		 (int64_t) 1 );
+	}
+	/* Clean up
+	 */
+	result = libvsapm_sector_cache_free(
+	          &sector_cache,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "sector_cache",
+	 sector_cache );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vsapm_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( sector_cache != NULL )
+	{
+		libvsapm_sector_cache_free(
+		 &sector_cache,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvsapm_sector_cache_read_buffer_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_sector_cache_read_buffer_at_offset(
+     uint8_t use_arena )
+{
+	uint8_t buffer[ 1000 ];
+
+	libbfio_handle_t *file_io_handle                  = NULL;
+	libcerror_error_t *error                          = NULL;
+	libvsapm_sector_cache_t *sector_cache             = NULL;
+	libvsapm_sector_cache_arena_t *sector_cache_arena = NULL;
+	ssize_t read_count                                = 0;
+	off64_t offset                                    = 0;
+	int read_iteration                                = 0;
+	int result                                        = 0;
+
+	/* Initialize test
+	 */
+	result = vsapm_test_open_file_io_handle(
+	          &file_io_handle,
+	          vsapm_test_sector_cache_data,
+	          VSAPM_TEST_SECTOR_CACHE_DATA_SIZE,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( use_arena != 0 )
+	{
+		result = libvsapm_sector_cache_arena_initialize(
+		          &sector_cache_arena,
+		          (size_t) LIBVSAPM_SECTOR_CACHE_DEFAULT_NUMBER_OF_SLOTS << LIBVSAPM_SECTOR_CACHE_BLOCK_SIZE_SHIFT,
+		          1,
+		          &error );
+
+		VSAPM_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSAPM_TEST_ASSERT_IS_NOT_NULL(
+		 "sector_cache_arena",
+		 sector_cache_arena );
+
+		VSAPM_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libvsapm_sector_cache_initialize(
+	          &sector_cache,
+	          VSAPM_TEST_SECTOR_CACHE_PARTITION_OFFSET,
+	          VSAPM_TEST_SECTOR_CACHE_PARTITION_SIZE,
+	          LIBVSAPM_SECTOR_CACHE_DEFAULT_NUMBER_OF_SLOTS,
+	          sector_cache_arena,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "sector_cache",
+	 sector_cache );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The sector cache holds a reference to the arena
+	 */
+	result = libvsapm_sector_cache_arena_release(
+	          &sector_cache_arena,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "sector_cache_arena",
+	 sector_cache_arena );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 * Read the partition twice in buffers that span block boundaries
+	 * so that blocks are both cached and evicted
+	 */
+	for( read_iteration = 0;
+	     read_iteration < 2;
+	     read_iteration++ )
+	{
+		for( offset = 0;
+		     ( offset + 1000 ) <= VSAPM_TEST_SECTOR_CACHE_PARTITION_SIZE;
+		     offset += 1000 )
+		{
+			read_count = libvsapm_sector_cache_read_buffer_at_offset(
+			              sector_cache,
+			              file_io_handle,
+			              buffer,
+			              1000,
+			              offset,
+			              &error );
+
+			VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+			 "read_count",
+			 read_count,
+			 (ssize_t) 1000 );
+
+			VSAPM_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			result = memory_compare(
+			          buffer,
+			          &( vsapm_test_sector_cache_data[ VSAPM_TEST_SECTOR_CACHE_PARTITION_OFFSET + offset ] ),
+			          1000 );
+
+			VSAPM_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 0 );
+		}
+	}
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "sector_cache->blocks_data_in_arena",
+	 (int) sector_cache->blocks_data_in_arena,
+	 (int) use_arena );
+
+	/* Test reading beyond the end of the partition
+	 */
+	read_count = libvsapm_sector_cache_read_buffer_at_offset(
+	              sector_cache,
+	              file_io_handle,
+	              buffer,
+	              1000,
+	              VSAPM_TEST_SECTOR_CACHE_PARTITION_SIZE - 100,
+	              &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 100 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libvsapm_sector_cache_read_buffer_at_offset(
+	              sector_cache,
+	              file_io_handle,
+	              buffer,
+	              1000,
+	              VSAPM_TEST_SECTOR_CACHE_PARTITION_SIZE,
+	              &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	read_count = libvsapm_sector_cache_read_buffer_at_offset(
+	              NULL,
+	              file_io_handle,
+	              buffer,
+	              1000,
+	              0,
+	              &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvsapm_sector_cache_read_buffer_at_offset(
+	              sector_cache,
+	              file_io_handle,
+	              NULL,
+	              1000,
+	              0,
+	              &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvsapm_sector_cache_read_buffer_at_offset(
+	              sector_cache,
+	              file_io_handle,
+	              buffer,
+	              (size_t) SSIZE_MAX + 1,
+	              0,
+	              &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvsapm_sector_cache_read_buffer_at_offset(
+	              sector_cache,
+	              file_io_handle,
+	              buffer,
+	              1000,
+	              -1,
+	              &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvsapm_sector_cache_free(
+	          &sector_cache,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "sector_cache",
+	 sector_cache );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vsapm_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( sector_cache != NULL )
+	{
+		libvsapm_sector_cache_free(
+		 &sector_cache,
+		 NULL );
+	}
+	if( sector_cache_arena != NULL )
+	{
+		libvsapm_sector_cache_arena_free(
+		 &sector_cache_arena,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VSAPM_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VSAPM_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VSAPM_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VSAPM_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+#if defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT )
+	size_t data_offset = 0;
+#endif
+
+	VSAPM_TEST_UNREFERENCED_PARAMETER( argc )
+	VSAPM_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT )
+
+	for( data_offset = 0;
+	     data_offset < VSAPM_TEST_SECTOR_CACHE_DATA_SIZE;
+	     data_offset++ )
+	{
+		vsapm_test_sector_cache_data[ data_offset ] = (uint8_t) ( ( data_offset * 7 ) + ( data_offset >> 12 ) );
+	}
+	VSAPM_TEST_RUN(
+	 "libvsapm_sector_cache_initialize",
+	 vsapm_test_sector_cache_initialize );
+
+	VSAPM_TEST_RUN(
+	 "libvsapm_sector_cache_free",
+	 vsapm_test_sector_cache_free );
+
+	VSAPM_TEST_RUN(
+	 "libvsapm_sector_cache_acquire",
+	 vsapm_test_sector_cache_acquire );
+
+	VSAPM_TEST_RUN(
+	 "libvsapm_sector_cache_get_slot_index",
+	 vsapm_test_sector_cache_get_slot_index );
+
+	VSAPM_TEST_RUN(
+	 "libvsapm_sector_cache_evict_block",
+	 vsapm_test_sector_cache_evict_block );
+
+	VSAPM_TEST_RUN_WITH_ARGS(
+	 "libvsapm_sector_cache_read_buffer_at_offset",
+	 vsapm_test_sector_cache_read_buffer_at_offset,
+	 0 );
+
+#if defined( HAVE_LIBVSAPM_SECTOR_CACHE_ARENA_MMAP )
+	VSAPM_TEST_RUN_WITH_ARGS(
+	 "libvsapm_sector_cache_read_buffer_at_offset",
+	 vsapm_test_sector_cache_read_buffer_at_offset,
+	 1 );
+#endif
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,907 @@
+/*
+ * Library sector_cache_arena type test program
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vsapm_test_libcerror.h"
+#include "vsapm_test_libvsapm.h"
+#include "vsapm_test_macros.h"
+#include "vsapm_test_memory.h"
+#include "vsapm_test_unused.h"
+
+#include "../libvsapm/libvsapm_sector_cache_arena.h"
+
+#define VSAPM_TEST_SECTOR_CACHE_ARENA_REGION_SIZE		( (size_t) LIBVSAPM_SECTOR_CACHE_DEFAULT_NUMBER_OF_SLOTS << LIBVSAPM_SECTOR_CACHE_BLOCK_SIZE_SHIFT )
+#define VSAPM_TEST_SECTOR_CACHE_ARENA_NUMBER_OF_REGIONS	40
+
+#if defined( HAVE_LIBVSAPM_SECTOR_CACHE_ARENA_MMAP ) && defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT )
+
+/* Tests the libvsapm_sector_cache_arena_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_sector_cache_arena_initialize(
+     void )
+{
+	libcerror_error_t *error                          = NULL;
+	libvsapm_sector_cache_arena_t *sector_cache_arena = NULL;
+	int result                                        = 0;
+
+#if defined( HAVE_VSAPM_TEST_MEMORY )
+	int number_of_malloc_fail_tests                   = 2;
+	int number_of_memset_fail_tests                   = 2;
+	int test_number                                   = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libvsapm_sector_cache_arena_initialize(
+	          &sector_cache_arena,
+	          VSAPM_TEST_SECTOR_CACHE_ARENA_REGION_SIZE,
+	          9,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "sector_cache_arena",
+	 sector_cache_arena );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "sector_cache_arena->data",
+	 sector_cache_arena->data );
+
+	VSAPM_TEST_ASSERT_EQUAL_SIZE(
+	 "sector_cache_arena->data_size",
+	 sector_cache_arena->data_size,
+	 (size_t) ( 2 * LIBVSAPM_SECTOR_CACHE_HUGE_PAGE_SIZE ) );
+
+	VSAPM_TEST_ASSERT_EQUAL_SIZE(
+	 "sector_cache_arena->region_size * sector_cache_arena->number_of_regions",
+	 sector_cache_arena->region_size * sector_cache_arena->number_of_regions,
+	 sector_cache_arena->data_size );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "sector_cache_arena->number_of_regions",
+	 sector_cache_arena->number_of_regions,
+	 16 );
+
+	result = libvsapm_sector_cache_arena_free(
+	          &sector_cache_arena,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that the arena is limited to the maximum size
+	 */
+	result = libvsapm_sector_cache_arena_initialize(
+	          &sector_cache_arena,
+	          VSAPM_TEST_SECTOR_CACHE_ARENA_REGION_SIZE,
+	          1024,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "sector_cache_arena",
+	 sector_cache_arena );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SIZE(
+	 "sector_cache_arena->data_size",
+	 sector_cache_arena->data_size,
+	 (size_t) LIBVSAPM_SECTOR_CACHE_ARENA_MAXIMUM_SIZE );
+
+	result = libvsapm_sector_cache_arena_free(
+	          &sector_cache_arena,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "sector_cache_arena",
+	 sector_cache_arena );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvsapm_sector_cache_arena_initialize(
+	          NULL,
+	          VSAPM_TEST_SECTOR_CACHE_ARENA_REGION_SIZE,
+	          VSAPM_TEST_SECTOR_CACHE_ARENA_NUMBER_OF_REGIONS,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	sector_cache_arena = (libvsapm_sector_cache_arena_t *) 0x12345678UL;
+
+	result = libvsapm_sector_cache_arena_initialize(
+	          &sector_cache_arena,
+	          VSAPM_TEST_SECTOR_CACHE_ARENA_REGION_SIZE,
+	          VSAPM_TEST_SECTOR_CACHE_ARENA_NUMBER_OF_REGIONS,
+	          &error );
+
+	sector_cache_arena = NULL;
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_sector_cache_arena_initialize(
+	          &sector_cache_arena,
+	          0,
+	          VSAPM_TEST_SECTOR_CACHE_ARENA_NUMBER_OF_REGIONS,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "sector_cache_arena",
+	 sector_cache_arena );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_sector_cache_arena_initialize(
+	          &sector_cache_arena,
+	          VSAPM_TEST_SECTOR_CACHE_ARENA_REGION_SIZE + 1,
+	          VSAPM_TEST_SECTOR_CACHE_ARENA_NUMBER_OF_REGIONS,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "sector_cache_arena",
+	 sector_cache_arena );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_sector_cache_arena_initialize(
+	          &sector_cache_arena,
+	          (size_t) LIBVSAPM_SECTOR_CACHE_ARENA_MAXIMUM_SIZE + LIBVSAPM_SECTOR_CACHE_BLOCK_SIZE,
+	          VSAPM_TEST_SECTOR_CACHE_ARENA_NUMBER_OF_REGIONS,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "sector_cache_arena",
+	 sector_cache_arena );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_sector_cache_arena_initialize(
+	          &sector_cache_arena,
+	          VSAPM_TEST_SECTOR_CACHE_ARENA_REGION_SIZE,
+	          0,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "sector_cache_arena",
+	 sector_cache_arena );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_VSAPM_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvsapm_sector_cache_arena_initialize with malloc failing
+		 */
+		vsapm_test_malloc_attempts_before_fail = test_number;
+
+		result = libvsapm_sector_cache_arena_initialize(
+		          &sector_cache_arena,
+		          VSAPM_TEST_SECTOR_CACHE_ARENA_REGION_SIZE,
+		          VSAPM_TEST_SECTOR_CACHE_ARENA_NUMBER_OF_REGIONS,
+		          &error );
+
+		if( vsapm_test_malloc_attempts_before_fail != -1 )
+		{
+			vsapm_test_malloc_attempts_before_fail = -1;
+
+			if( sector_cache_arena != NULL )
+			{
+				libvsapm_sector_cache_arena_free(
+				 &sector_cache_arena,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSAPM_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSAPM_TEST_ASSERT_IS_NULL(
+			 "sector_cache_arena",
+			 sector_cache_arena );
+
+			VSAPM_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvsapm_sector_cache_arena_initialize with memset failing
+		 */
+		vsapm_test_memset_attempts_before_fail = test_number;
+
+		result = libvsapm_sector_cache_arena_initialize(
+		          &sector_cache_arena,
+		          VSAPM_TEST_SECTOR_CACHE_ARENA_REGION_SIZE,
+		          VSAPM_TEST_SECTOR_CACHE_ARENA_NUMBER_OF_REGIONS,
+		          &error );
+
+		if( vsapm_test_memset_attempts_before_fail != -1 )
+		{
+			vsapm_test_memset_attempts_before_fail = -1;
+
+			if( sector_cache_arena != NULL )
+			{
+				libvsapm_sector_cache_arena_free(
+				 &sector_cache_arena,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSAPM_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSAPM_TEST_ASSERT_IS_NULL(
+			 "sector_cache_arena",
+			 sector_cache_arena );
+
+			VSAPM_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VSAPM_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( sector_cache_arena != NULL )
+	{
+		libvsapm_sector_cache_arena_free(
+		 &sector_cache_arena,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvsapm_sector_cache_arena_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_sector_cache_arena_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvsapm_sector_cache_arena_free(
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvsapm_sector_cache_arena_acquire and libvsapm_sector_cache_arena_release functions
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_sector_cache_arena_acquire(
+     void )
+{
+	libcerror_error_t *error                                 = NULL;
+	libvsapm_sector_cache_arena_t *sector_cache_arena        = NULL;
+	libvsapm_sector_cache_arena_t *shared_sector_cache_arena = NULL;
+	int result                                               = 0;
+
+	/* Initialize test
+	 */
+	result = libvsapm_sector_cache_arena_initialize(
+	          &sector_cache_arena,
+	          VSAPM_TEST_SECTOR_CACHE_ARENA_REGION_SIZE,
+	          VSAPM_TEST_SECTOR_CACHE_ARENA_NUMBER_OF_REGIONS,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "sector_cache_arena",
+	 sector_cache_arena );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvsapm_sector_cache_arena_acquire(
+	          sector_cache_arena,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	shared_sector_cache_arena = sector_cache_arena;
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "shared_sector_cache_arena->reference_count",
+	 shared_sector_cache_arena->reference_count,
+	 2 );
+
+	result = libvsapm_sector_cache_arena_release(
+	          &shared_sector_cache_arena,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "shared_sector_cache_arena",
+	 shared_sector_cache_arena );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "sector_cache_arena->reference_count",
+	 sector_cache_arena->reference_count,
+	 1 );
+
+	/* Test error cases
+	 */
+	result = libvsapm_sector_cache_arena_acquire(
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_sector_cache_arena_release(
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up, releasing the last reference frees the arena
+	 */
+	result = libvsapm_sector_cache_arena_release(
+	          &sector_cache_arena,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "sector_cache_arena",
+	 sector_cache_arena );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( sector_cache_arena != NULL )
+	{
+		libvsapm_sector_cache_arena_free(
+		 &sector_cache_arena,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvsapm_sector_cache_arena_allocate_region and libvsapm_sector_cache_arena_free_region functions
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_sector_cache_arena_allocate_region(
+     void )
+{
+	uint8_t *region_data[ VSAPM_TEST_SECTOR_CACHE_ARENA_NUMBER_OF_REGIONS ];
+
+	libcerror_error_t *error                          = NULL;
+	libvsapm_sector_cache_arena_t *sector_cache_arena = NULL;
+	uint8_t *extra_region_data                        = NULL;
+	int region_index                                  = 0;
+	int result                                        = 0;
+
+	/* Initialize test
+	 */
+	result = libvsapm_sector_cache_arena_initialize(
+	          &sector_cache_arena,
+	          VSAPM_TEST_SECTOR_CACHE_ARENA_REGION_SIZE,
+	          VSAPM_TEST_SECTOR_CACHE_ARENA_NUMBER_OF_REGIONS,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "sector_cache_arena",
+	 sector_cache_arena );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 * Allocate every region and write to it
+	 */
+	for( region_index = 0;
+	     region_index < VSAPM_TEST_SECTOR_CACHE_ARENA_NUMBER_OF_REGIONS;
+	     region_index++ )
+	{
+		region_data[ region_index ] = NULL;
+
+		result = libvsapm_sector_cache_arena_allocate_region(
+		          sector_cache_arena,
+		          &( region_data[ region_index ] ),
+		          &error );
+
+		VSAPM_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSAPM_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		VSAPM_TEST_ASSERT_EQUAL_SIZE(
+		 "region_data offset",
+		 (size_t) ( region_data[ region_index ] - sector_cache_arena->data ),
+		 (size_t) region_index * sector_cache_arena->region_size );
+
+		memory_set(
+		 region_data[ region_index ],
+		 region_index,
+		 sector_cache_arena->region_size );
+	}
+	/* Test that no region is available when all regions are in use
+	 */
+	result = libvsapm_sector_cache_arena_allocate_region(
+	          sector_cache_arena,
+	          &extra_region_data,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "extra_region_data",
+	 extra_region_data );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that a freed region is reused
+	 */
+	result = libvsapm_sector_cache_arena_free_region(
+	          sector_cache_arena,
+	          region_data[ 1 ],
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_sector_cache_arena_allocate_region(
+	          sector_cache_arena,
+	          &extra_region_data,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_EQUAL_INTPTR(
+	 "extra_region_data",
+	 (intptr_t) extra_region_data,
+	 (intptr_t) region_data[ 1 ] );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvsapm_sector_cache_arena_allocate_region(
+	          NULL,
+	          &extra_region_data,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_sector_cache_arena_allocate_region(
+	          sector_cache_arena,
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_sector_cache_arena_free_region(
+	          NULL,
+	          region_data[ 0 ],
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_sector_cache_arena_free_region(
+	          sector_cache_arena,
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_sector_cache_arena_free_region(
+	          sector_cache_arena,
+	          &( region_data[ 0 ][ 1 ] ),
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	for( region_index = 0;
+	     region_index < VSAPM_TEST_SECTOR_CACHE_ARENA_NUMBER_OF_REGIONS;
+	     region_index++ )
+	{
+		result = libvsapm_sector_cache_arena_free_region(
+		          sector_cache_arena,
+		          region_data[ region_index ],
+		          &error );
+
+		VSAPM_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSAPM_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error case where the region is not in use
+	 */
+	result = libvsapm_sector_cache_arena_free_region(
+	          sector_cache_arena,
+	          region_data[ 0 ],
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_sector_cache_arena_free(
+	          &sector_cache_arena,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "sector_cache_arena",
+	 sector_cache_arena );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( sector_cache_arena != NULL )
+	{
+		libvsapm_sector_cache_arena_free(
+		 &sector_cache_arena,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_LIBVSAPM_SECTOR_CACHE_ARENA_MMAP ) && defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VSAPM_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VSAPM_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VSAPM_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VSAPM_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VSAPM_TEST_UNREFERENCED_PARAMETER( argc )
+	VSAPM_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( HAVE_LIBVSAPM_SECTOR_CACHE_ARENA_MMAP ) && defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT )
+
+	VSAPM_TEST_RUN(
+	 "libvsapm_sector_cache_arena_initialize",
+	 vsapm_test_sector_cache_arena_initialize );
+
+	VSAPM_TEST_RUN(
+	 "libvsapm_sector_cache_arena_free",
+	 vsapm_test_sector_cache_arena_free );
+
+	VSAPM_TEST_RUN(
+	 "libvsapm_sector_cache_arena_acquire",
+	 vsapm_test_sector_cache_arena_acquire );
+
+	VSAPM_TEST_RUN(
+	 "libvsapm_sector_cache_arena_allocate_region",
+	 vsapm_test_sector_cache_arena_allocate_region );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+
+#else
+	return( EXIT_SUCCESS );
+
+#endif /* defined( HAVE_LIBVSAPM_SECTOR_CACHE_ARENA_MMAP ) && defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT ) */
+}
+
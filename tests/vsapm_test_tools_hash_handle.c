@@ -0,0 +1,632 @@
+/*
+ * Tools hash_handle type test program
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vsapm_test_libcerror.h"
+#include "vsapm_test_macros.h"
+#include "vsapm_test_memory.h"
+#include "vsapm_test_unused.h"
+
+#include "../vsapmtools/hash_handle.h"
+
+/* Tests the hash_handle_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_tools_hash_handle_initialize(
+     void )
+{
+	hash_handle_t *hash_handle      = NULL;
+	libcerror_error_t *error        = NULL;
+	int result                      = 0;
+
+#if defined( HAVE_VSAPM_TEST_MEMORY )
+	int number_of_malloc_fail_tests = 1;
+	int number_of_memset_fail_tests = 1;
+	int test_number                 = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = hash_handle_initialize(
+	          &hash_handle,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "hash_handle",
+	 hash_handle );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = hash_handle_free(
+	          &hash_handle,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "hash_handle",
+	 hash_handle );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = hash_handle_initialize(
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	hash_handle = (hash_handle_t *) 0x12345678UL;
+
+	result = hash_handle_initialize(
+	          &hash_handle,
+	          &error );
+
+	hash_handle = NULL;
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_VSAPM_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test hash_handle_initialize with malloc failing
+		 */
+		vsapm_test_malloc_attempts_before_fail = test_number;
+
+		result = hash_handle_initialize(
+		          &hash_handle,
+		          &error );
+
+		if( vsapm_test_malloc_attempts_before_fail != -1 )
+		{
+			vsapm_test_malloc_attempts_before_fail = -1;
+
+			if( hash_handle != NULL )
+			{
+				hash_handle_free(
+				 &hash_handle,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSAPM_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSAPM_TEST_ASSERT_IS_NULL(
+			 "hash_handle",
+			 hash_handle );
+
+			VSAPM_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test hash_handle_initialize with memset failing
+		 */
+		vsapm_test_memset_attempts_before_fail = test_number;
+
+		result = hash_handle_initialize(
+		          &hash_handle,
+		          &error );
+
+		if( vsapm_test_memset_attempts_before_fail != -1 )
+		{
+			vsapm_test_memset_attempts_before_fail = -1;
+
+			if( hash_handle != NULL )
+			{
+				hash_handle_free(
+				 &hash_handle,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSAPM_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSAPM_TEST_ASSERT_IS_NULL(
+			 "hash_handle",
+			 hash_handle );
+
+			VSAPM_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VSAPM_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( hash_handle != NULL )
+	{
+		hash_handle_free(
+		 &hash_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the hash_handle_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_tools_hash_handle_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = hash_handle_free(
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the hash_handle_set_digest_types function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_tools_hash_handle_set_digest_types(
+     void )
+{
+	hash_handle_t *hash_handle = NULL;
+	libcerror_error_t *error   = NULL;
+	int result                 = 0;
+
+	/* Initialize test
+	 */
+	result = hash_handle_initialize(
+	          &hash_handle,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "hash_handle",
+	 hash_handle );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = hash_handle_set_digest_types(
+	          hash_handle,
+	          _SYSTEM_STRING( "sha256,MD5" ),
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSAPM_TEST_ASSERT_EQUAL_UINT8(
+	 "hash_handle->enabled_digest_types[ HASH_HANDLE_DIGEST_TYPE_MD5 ]",
+	 hash_handle->enabled_digest_types[ HASH_HANDLE_DIGEST_TYPE_MD5 ],
+	 (uint8_t) 1 );
+
+	VSAPM_TEST_ASSERT_EQUAL_UINT8(
+	 "hash_handle->enabled_digest_types[ HASH_HANDLE_DIGEST_TYPE_SHA1 ]",
+	 hash_handle->enabled_digest_types[ HASH_HANDLE_DIGEST_TYPE_SHA1 ],
+	 (uint8_t) 0 );
+
+	VSAPM_TEST_ASSERT_EQUAL_UINT8(
+	 "hash_handle->enabled_digest_types[ HASH_HANDLE_DIGEST_TYPE_SHA256 ]",
+	 hash_handle->enabled_digest_types[ HASH_HANDLE_DIGEST_TYPE_SHA256 ],
+	 (uint8_t) 1 );
+
+	result = hash_handle_set_digest_types(
+	          hash_handle,
+	          _SYSTEM_STRING( "all" ),
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSAPM_TEST_ASSERT_EQUAL_UINT8(
+	 "hash_handle->enabled_digest_types[ HASH_HANDLE_DIGEST_TYPE_SHA1 ]",
+	 hash_handle->enabled_digest_types[ HASH_HANDLE_DIGEST_TYPE_SHA1 ],
+	 (uint8_t) 1 );
+
+	/* Test error cases
+	 */
+	result = hash_handle_set_digest_types(
+	          NULL,
+	          _SYSTEM_STRING( "md5" ),
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = hash_handle_set_digest_types(
+	          hash_handle,
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = hash_handle_set_digest_types(
+	          hash_handle,
+	          _SYSTEM_STRING( "md5,crc32" ),
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = hash_handle_set_digest_types(
+	          hash_handle,
+	          _SYSTEM_STRING( "" ),
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = hash_handle_free(
+	          &hash_handle,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "hash_handle",
+	 hash_handle );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( hash_handle != NULL )
+	{
+		hash_handle_free(
+		 &hash_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the hash_handle_set_block_size function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_tools_hash_handle_set_block_size(
+     void )
+{
+	hash_handle_t *hash_handle = NULL;
+	libcerror_error_t *error   = NULL;
+	int result                 = 0;
+
+	/* Initialize test
+	 */
+	result = hash_handle_initialize(
+	          &hash_handle,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "hash_handle",
+	 hash_handle );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = hash_handle_set_block_size(
+	          hash_handle,
+	          _SYSTEM_STRING( "65536" ),
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SIZE(
+	 "hash_handle->block_size",
+	 hash_handle->block_size,
+	 (size_t) 65536 );
+
+	/* Test error cases
+	 */
+	result = hash_handle_set_block_size(
+	          NULL,
+	          _SYSTEM_STRING( "65536" ),
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = hash_handle_set_block_size(
+	          hash_handle,
+	          _SYSTEM_STRING( "1000" ),
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = hash_handle_set_block_size(
+	          hash_handle,
+	          _SYSTEM_STRING( "256" ),
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = hash_handle_free(
+	          &hash_handle,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "hash_handle",
+	 hash_handle );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( hash_handle != NULL )
+	{
+		hash_handle_free(
+		 &hash_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VSAPM_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VSAPM_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VSAPM_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VSAPM_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VSAPM_TEST_UNREFERENCED_PARAMETER( argc )
+	VSAPM_TEST_UNREFERENCED_PARAMETER( argv )
+
+	VSAPM_TEST_RUN(
+	 "hash_handle_initialize",
+	 vsapm_test_tools_hash_handle_initialize );
+
+	VSAPM_TEST_RUN(
+	 "hash_handle_free",
+	 vsapm_test_tools_hash_handle_free );
+
+	VSAPM_TEST_RUN(
+	 "hash_handle_set_digest_types",
+	 vsapm_test_tools_hash_handle_set_digest_types );
+
+	VSAPM_TEST_RUN(
+	 "hash_handle_set_block_size",
+	 vsapm_test_tools_hash_handle_set_block_size );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -1,5 +1,5 @@
 /*
- * Library sector_data type test program
+ * Tools nbd_handle type test program
  *
  * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
  *
@@ -21,45 +21,42 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
 #include <stdlib.h>
 #endif
 
-#include "vsapm_test_functions.h"
-#include "vsapm_test_libbfio.h"
 #include "vsapm_test_libcerror.h"
-#include "vsapm_test_libvsapm.h"
 #include "vsapm_test_macros.h"
 #include "vsapm_test_memory.h"
 #include "vsapm_test_unused.h"
 
-#include "../libvsapm/libvsapm_sector_data.h"
+#include "../vsapmtools/nbd_handle.h"
 
-#if defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT )
-
-/* Tests the libvsapm_sector_data_initialize function
+/* Tests the nbd_handle_initialize function
  * Returns 1 if successful or 0 if not
  */
-int vsapm_test_sector_data_initialize(
+int vsapm_test_tools_nbd_handle_initialize(
      void )
 {
-	libcerror_error_t *error            = NULL;
-	libvsapm_sector_data_t *sector_data = NULL;
-	int result                          = 0;
+	nbd_handle_t *nbd_handle        = NULL;
+	libcerror_error_t *error        = NULL;
+	int result                      = 0;
 
 #if defined( HAVE_VSAPM_TEST_MEMORY )
-	int number_of_malloc_fail_tests     = 1;
-	int number_of_memset_fail_tests     = 1;
-	int test_number                     = 0;
+	int number_of_malloc_fail_tests = 1;
+	int number_of_memset_fail_tests = 1;
+	int test_number                 = 0;
 #endif
 
 	/* Test regular cases
 	 */
-	result = libvsapm_sector_data_initialize(
-	          &sector_data,
-	          512,
+	result = nbd_handle_initialize(
+	          &nbd_handle,
+	          1,
 	          &error );
 
 	VSAPM_TEST_ASSERT_EQUAL_INT(
@@ -68,15 +65,15 @@ int vsapm_test_sector_data_initialize(
 	 1 );
 
 	VSAPM_TEST_ASSERT_IS_NOT_NULL(
-	 "sector_data",
-	 sector_data );
+	 "nbd_handle",
+	 nbd_handle );
 
 	VSAPM_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	result = libvsapm_sector_data_free(
-	          &sector_data,
+	result = nbd_handle_free(
+	          &nbd_handle,
 	          &error );
 
 	VSAPM_TEST_ASSERT_EQUAL_INT(
@@ -85,8 +82,8 @@ int vsapm_test_sector_data_initialize(
 	 1 );
 
 	VSAPM_TEST_ASSERT_IS_NULL(
-	 "sector_data",
-	 sector_data );
+	 "nbd_handle",
+	 nbd_handle );
 
 	VSAPM_TEST_ASSERT_IS_NULL(
 	 "error",
@@ -94,32 +91,11 @@ int vsapm_test_sector_data_initialize(
 
 	/* Test error cases
 	 */
-	result = libvsapm_sector_data_initialize(
+	result = nbd_handle_initialize(
 	          NULL,
-	          512,
-	          &error );
-
-	VSAPM_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 -1 );
-
-	VSAPM_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
-
-	libcerror_error_free(
-	 &error );
-
-	sector_data = (libvsapm_sector_data_t *) 0x12345678UL;
-
-	result = libvsapm_sector_data_initialize(
-	          &sector_data,
-	          512,
+	          1,
 	          &error );
 
-	sector_data = NULL;
-
 	VSAPM_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
@@ -132,8 +108,8 @@ int vsapm_test_sector_data_initialize(
 	libcerror_error_free(
 	 &error );
 
-	result = libvsapm_sector_data_initialize(
-	          &sector_data,
+	result = nbd_handle_initialize(
+	          &nbd_handle,
 	          0,
 	          &error );
 
@@ -149,11 +125,15 @@ int vsapm_test_sector_data_initialize(
 	libcerror_error_free(
 	 &error );
 
-	result = libvsapm_sector_data_initialize(
-	          &sector_data,
-	          (size_t) SSIZE_MAX + 1,
+	nbd_handle = (nbd_handle_t *) 0x12345678UL;
+
+	result = nbd_handle_initialize(
+	          &nbd_handle,
+	          1,
 	          &error );
 
+	nbd_handle = NULL;
+
 	VSAPM_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
@@ -172,23 +152,23 @@ int vsapm_test_sector_data_initialize(
 	     test_number < number_of_malloc_fail_tests;
 	     test_number++ )
 	{
-		/* Test libvsapm_sector_data_initialize with malloc failing
+		/* Test nbd_handle_initialize with malloc failing
 		 */
 		vsapm_test_malloc_attempts_before_fail = test_number;
 
-		result = libvsapm_sector_data_initialize(
-		          &sector_data,
-		          512,
+		result = nbd_handle_initialize(
+		          &nbd_handle,
+		          1,
 		          &error );
 
 		if( vsapm_test_malloc_attempts_before_fail != -1 )
 		{
 			vsapm_test_malloc_attempts_before_fail = -1;
 
-			if( sector_data != NULL )
+			if( nbd_handle != NULL )
 			{
-				libvsapm_sector_data_free(
-				 &sector_data,
+				nbd_handle_free(
+				 &nbd_handle,
 				 NULL );
 			}
 		}
@@ -200,8 +180,8 @@ int vsapm_test_sector_data_initialize(
 			 -1 );
 
 			VSAPM_TEST_ASSERT_IS_NULL(
-			 "sector_data",
-			 sector_data );
+			 "nbd_handle",
+			 nbd_handle );
 
 			VSAPM_TEST_ASSERT_IS_NOT_NULL(
 			 "error",
@@ -215,23 +195,23 @@ int vsapm_test_sector_data_initialize(
 	     test_number < number_of_memset_fail_tests;
 	     test_number++ )
 	{
-		/* Test libvsapm_sector_data_initialize with memset failing
+		/* Test nbd_handle_initialize with memset failing
 		 */
 		vsapm_test_memset_attempts_before_fail = test_number;
 
-		result = libvsapm_sector_data_initialize(
-		          &sector_data,
-		          512,
+		result = nbd_handle_initialize(
+		          &nbd_handle,
+		          1,
 		          &error );
 
 		if( vsapm_test_memset_attempts_before_fail != -1 )
 		{
 			vsapm_test_memset_attempts_before_fail = -1;
 
-			if( sector_data != NULL )
+			if( nbd_handle != NULL )
 			{
-				libvsapm_sector_data_free(
-				 &sector_data,
+				nbd_handle_free(
+				 &nbd_handle,
 				 NULL );
 			}
 		}
@@ -243,8 +223,8 @@ int vsapm_test_sector_data_initialize(
 			 -1 );
 
 			VSAPM_TEST_ASSERT_IS_NULL(
-			 "sector_data",
-			 sector_data );
+			 "nbd_handle",
+			 nbd_handle );
 
 			VSAPM_TEST_ASSERT_IS_NOT_NULL(
 			 "error",
@@ -264,19 +244,19 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-	if( sector_data != NULL )
+	if( nbd_handle != NULL )
 	{
-		libvsapm_sector_data_free(
-		 &sector_data,
+		nbd_handle_free(
+		 &nbd_handle,
 		 NULL );
 	}
 	return( 0 );
 }
 
-/* Tests the libvsapm_sector_data_free function
+/* Tests the nbd_handle_free function
  * Returns 1 if successful or 0 if not
  */
-int vsapm_test_sector_data_free(
+int vsapm_test_tools_nbd_handle_free(
      void )
 {
 	libcerror_error_t *error = NULL;
@@ -284,7 +264,7 @@ int vsapm_test_sector_data_free(
 
 	/* Test error cases
 	 */
-	result = libvsapm_sector_data_free(
+	result = nbd_handle_free(
 	          NULL,
 	          &error );
 
@@ -311,24 +291,21 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libvsapm_sector_data_read_file_io_handle function
+/* Tests the nbd_handle_set_bytes_per_sector function
  * Returns 1 if successful or 0 if not
  */
-int vsapm_test_sector_data_read_file_io_handle(
+int vsapm_test_tools_nbd_handle_set_bytes_per_sector(
      void )
 {
-	uint8_t test_data[ 512 ];
-
-	libbfio_handle_t *file_io_handle    = NULL;
-	libcerror_error_t *error            = NULL;
-	libvsapm_sector_data_t *sector_data = NULL;
-	int result                          = 0;
+	libcerror_error_t *error = NULL;
+	nbd_handle_t *nbd_handle = NULL;
+	int result               = 0;
 
 	/* Initialize test
 	 */
-	result = libvsapm_sector_data_initialize(
-	          &sector_data,
-	          512,
+	result = nbd_handle_initialize(
+	          &nbd_handle,
+	          1,
 	          &error );
 
 	VSAPM_TEST_ASSERT_EQUAL_INT(
@@ -337,19 +314,18 @@ int vsapm_test_sector_data_read_file_io_handle(
 	 1 );
 
 	VSAPM_TEST_ASSERT_IS_NOT_NULL(
-	 "sector_data",
-	 sector_data );
+	 "nbd_handle",
+	 nbd_handle );
 
 	VSAPM_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Initialize file IO handle
+	/* Test regular cases
 	 */
-	result = vsapm_test_open_file_io_handle(
-	          &file_io_handle,
-	          test_data,
-	          512,
+	result = nbd_handle_set_bytes_per_sector(
+	          nbd_handle,
+	          _SYSTEM_STRING( "4096" ),
 	          &error );
 
 	VSAPM_TEST_ASSERT_EQUAL_INT(
@@ -357,20 +333,20 @@ int vsapm_test_sector_data_read_file_io_handle(
 	 result,
 	 1 );
 
-	VSAPM_TEST_ASSERT_IS_NOT_NULL(
-	 "file_io_handle",
-	 file_io_handle );
-
 	VSAPM_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
+	VSAPM_TEST_ASSERT_EQUAL_UINT32(
+	 "nbd_handle->bytes_per_sector",
+	 nbd_handle->bytes_per_sector,
+	 (uint32_t) 4096 );
+
 	/* Test error cases
 	 */
-	result = libvsapm_sector_data_read_file_io_handle(
+	result = nbd_handle_set_bytes_per_sector(
 	          NULL,
-	          file_io_handle,
-	          0,
+	          _SYSTEM_STRING( "512" ),
 	          &error );
 
 	VSAPM_TEST_ASSERT_EQUAL_INT(
@@ -385,10 +361,96 @@ int vsapm_test_sector_data_read_file_io_handle(
 	libcerror_error_free(
 	 &error );
 
-	result = libvsapm_sector_data_read_file_io_handle(
-	          sector_data,
+	result = nbd_handle_set_bytes_per_sector(
+	          nbd_handle,
+	          _SYSTEM_STRING( "500" ),
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = nbd_handle_free(
+	          &nbd_handle,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "nbd_handle",
+	 nbd_handle );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( nbd_handle != NULL )
+	{
+		nbd_handle_free(
+		 &nbd_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the nbd_handle_open_socket function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_tools_nbd_handle_open_socket(
+     void )
+{
+	char socket_path[ 512 ];
+
+	libcerror_error_t *error = NULL;
+	nbd_handle_t *nbd_handle = NULL;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = nbd_handle_initialize(
+	          &nbd_handle,
+	          1,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "nbd_handle",
+	 nbd_handle );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = nbd_handle_open_socket(
 	          NULL,
-	          0,
+	          "vsapmnbd.sock",
 	          &error );
 
 	VSAPM_TEST_ASSERT_EQUAL_INT(
@@ -403,10 +465,9 @@ int vsapm_test_sector_data_read_file_io_handle(
 	libcerror_error_free(
 	 &error );
 
-	result = libvsapm_sector_data_read_file_io_handle(
-	          sector_data,
-	          file_io_handle,
-	          -1,
+	result = nbd_handle_open_socket(
+	          nbd_handle,
+	          NULL,
 	          &error );
 
 	VSAPM_TEST_ASSERT_EQUAL_INT(
@@ -421,27 +482,36 @@ int vsapm_test_sector_data_read_file_io_handle(
 	libcerror_error_free(
 	 &error );
 
-	/* Clean up file IO handle
+	/* Test with a socket path that exceeds the maximum supported length
 	 */
-	result = vsapm_test_close_file_io_handle(
-	          &file_io_handle,
+	memory_set(
+	 socket_path,
+	 'a',
+	 511 );
+
+	socket_path[ 511 ] = 0;
+
+	result = nbd_handle_open_socket(
+	          nbd_handle,
+	          socket_path,
 	          &error );
 
 	VSAPM_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 0 );
+	 -1 );
 
-	VSAPM_TEST_ASSERT_IS_NULL(
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-/* TODO test data too small */
+	libcerror_error_free(
+	 &error );
 
 	/* Clean up
 	 */
-	result = libvsapm_sector_data_free(
-	          &sector_data,
+	result = nbd_handle_free(
+	          &nbd_handle,
 	          &error );
 
 	VSAPM_TEST_ASSERT_EQUAL_INT(
@@ -450,8 +520,8 @@ int vsapm_test_sector_data_read_file_io_handle(
 	 1 );
 
 	VSAPM_TEST_ASSERT_IS_NULL(
-	 "sector_data",
-	 sector_data );
+	 "nbd_handle",
+	 nbd_handle );
 
 	VSAPM_TEST_ASSERT_IS_NULL(
 	 "error",
@@ -465,23 +535,15 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-	if( file_io_handle != NULL )
+	if( nbd_handle != NULL )
 	{
-		libbfio_handle_free(
-		 &file_io_handle,
-		 NULL );
-	}
-	if( sector_data != NULL )
-	{
-		libvsapm_sector_data_free(
-		 &sector_data,
+		nbd_handle_free(
+		 &nbd_handle,
 		 NULL );
 	}
 	return( 0 );
 }
 
-#endif /* defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT ) */
-
 /* The main program
  */
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -497,21 +559,21 @@ int main(
 	VSAPM_TEST_UNREFERENCED_PARAMETER( argc )
 	VSAPM_TEST_UNREFERENCED_PARAMETER( argv )
 
-#if defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT )
-
 	VSAPM_TEST_RUN(
-	 "libvsapm_sector_data_initialize",
-	 vsapm_test_sector_data_initialize );
+	 "nbd_handle_initialize",
+	 vsapm_test_tools_nbd_handle_initialize );
 
 	VSAPM_TEST_RUN(
-	 "libvsapm_sector_data_free",
-	 vsapm_test_sector_data_free );
+	 "nbd_handle_free",
+	 vsapm_test_tools_nbd_handle_free );
 
 	VSAPM_TEST_RUN(
-	 "libvsapm_sector_data_read_file_io_handle",
-	 vsapm_test_sector_data_read_file_io_handle );
+	 "nbd_handle_set_bytes_per_sector",
+	 vsapm_test_tools_nbd_handle_set_bytes_per_sector );
 
-#endif /* defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT ) */
+	VSAPM_TEST_RUN(
+	 "nbd_handle_open_socket",
+	 vsapm_test_tools_nbd_handle_open_socket );
 
 	return( EXIT_SUCCESS );
 
@@ -19,8 +19,10 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <byte_stream.h>
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <narrow_string.h>
 #include <system_string.h>
 #include <types.h>
@@ -30,6 +32,8 @@
 #include <stdlib.h>
 #endif
 
+#include <time.h>
+
 #include "vsapm_test_functions.h"
 #include "vsapm_test_getopt.h"
 #include "vsapm_test_libbfio.h"
@@ -40,6 +44,8 @@
 #include "vsapm_test_unused.h"
 
 #if defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT )
+#include "../libvsapm/libvsapm_definitions.h"
+#include "../libvsapm/libvsapm_read_queue.h"
 #include "../libvsapm/libvsapm_volume.h"
 #endif
 
@@ -925,6 +931,24 @@ int vsapm_test_volume_open_file_io_handle(
 	libcerror_error_free(
 	 &error );
 
+	result = libvsapm_volume_open_file_io_handle(
+	          volume,
+	          file_io_handle,
+	          LIBVSAPM_OPEN_READ | LIBVSAPM_ACCESS_FLAG_DIRECT_IO,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
 	/* Test open when already opened
 	 */
 	result = libvsapm_volume_open_file_io_handle(
@@ -1004,56 +1028,75 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libvsapm_volume_close function
+/* Tests the libvsapm_volume_open_memory function
  * Returns 1 if successful or 0 if not
  */
-int vsapm_test_volume_close(
+int vsapm_test_volume_open_memory(
      void )
 {
-	libcerror_error_t *error = NULL;
-	int result               = 0;
+	uint8_t partition_data[ 512 ];
+	uint8_t volume_data[ 4096 ];
 
-	/* Test error cases
+	libcerror_error_t *error        = NULL;
+	libvsapm_partition_t *partition = NULL;
+	libvsapm_volume_t *volume       = NULL;
+	ssize_t read_count              = 0;
+	size_t data_offset              = 0;
+	int number_of_partitions        = 0;
+	int result                      = 0;
+
+	/* Initialize test
+	 * Create a volume of 8 sectors with a partition map of 2 entries
+	 * and a partition in sectors 4 to 7
 	 */
-	result = libvsapm_volume_close(
-	          NULL,
-	          &error );
+	memory_set(
+	 volume_data,
+	 0,
+	 4096 );
+
+	for( data_offset = 512;
+	     data_offset <= 1024;
+	     data_offset += 512 )
+	{
+		volume_data[ data_offset ]     = 'P';
+		volume_data[ data_offset + 1 ] = 'M';
 
-	VSAPM_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 -1 );
+		byte_stream_copy_from_uint32_big_endian(
+		 &( volume_data[ data_offset + 4 ] ),
+		 2 );
+	}
+	byte_stream_copy_from_uint32_big_endian(
+	 &( volume_data[ 512 + 8 ] ),
+	 1 );
 
-	VSAPM_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
+	byte_stream_copy_from_uint32_big_endian(
+	 &( volume_data[ 512 + 12 ] ),
+	 2 );
 
-	libcerror_error_free(
-	 &error );
+	memory_copy(
+	 &( volume_data[ 512 + 48 ] ),
+	 "Apple_partition_map",
+	 19 );
 
-	return( 1 );
+	byte_stream_copy_from_uint32_big_endian(
+	 &( volume_data[ 1024 + 8 ] ),
+	 4 );
 
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	return( 0 );
-}
+	byte_stream_copy_from_uint32_big_endian(
+	 &( volume_data[ 1024 + 12 ] ),
+	 4 );
 
-/* Tests the libvsapm_volume_open and libvsapm_volume_close functions
- * Returns 1 if successful or 0 if not
- */
-int vsapm_test_volume_open_close(
-     const system_character_t *source )
-{
-	libcerror_error_t *error  = NULL;
-	libvsapm_volume_t *volume = NULL;
-	int result                = 0;
+	memory_copy(
+	 &( volume_data[ 1024 + 48 ] ),
+	 "Apple_HFS",
+	 9 );
 
-	/* Initialize test
-	 */
+	for( data_offset = 2048;
+	     data_offset < 4096;
+	     data_offset++ )
+	{
+		volume_data[ data_offset ] = (uint8_t) data_offset;
+	}
 	result = libvsapm_volume_initialize(
 	          &volume,
 	          &error );
@@ -1071,21 +1114,14 @@ int vsapm_test_volume_open_close(
 	 "error",
 	 error );
 
-	/* Test open and close
+	/* Test regular cases
 	 */
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	result = libvsapm_volume_open_wide(
-	          volume,
-	          source,
-	          LIBVSAPM_OPEN_READ,
-	          &error );
-#else
-	result = libvsapm_volume_open(
+	result = libvsapm_volume_open_memory(
 	          volume,
-	          source,
+	          volume_data,
+	          4096,
 	          LIBVSAPM_OPEN_READ,
 	          &error );
-#endif
 
 	VSAPM_TEST_ASSERT_EQUAL_INT(
 	 "result",
@@ -1096,34 +1132,73 @@ int vsapm_test_volume_open_close(
 	 "error",
 	 error );
 
-	result = libvsapm_volume_close(
+	result = libvsapm_volume_get_number_of_partitions(
 	          volume,
+	          &number_of_partitions,
 	          &error );
 
 	VSAPM_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 0 );
+	 1 );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "number_of_partitions",
+	 number_of_partitions,
+	 1 );
 
 	VSAPM_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Test open and close a second time to validate clean up on close
-	 */
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	result = libvsapm_volume_open_wide(
+	result = libvsapm_volume_get_partition_by_index(
 	          volume,
-	          source,
-	          LIBVSAPM_OPEN_READ,
+	          0,
+	          &partition,
 	          &error );
-#else
-	result = libvsapm_volume_open(
-	          volume,
-	          source,
-	          LIBVSAPM_OPEN_READ,
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "partition",
+	 partition );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libvsapm_partition_read_buffer_at_offset(
+	              partition,
+	              partition_data,
+	              512,
+	              512,
+	              &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 512 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          partition_data,
+	          &( volume_data[ 2048 + 512 ] ),
+	          512 );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libvsapm_partition_free(
+	          &partition,
 	          &error );
-#endif
 
 	VSAPM_TEST_ASSERT_EQUAL_INT(
 	 "result",
@@ -1134,6 +1209,8 @@ int vsapm_test_volume_open_close(
 	 "error",
 	 error );
 
+	/* Test a partition that starts beyond the volume data in memory
+	 */
 	result = libvsapm_volume_close(
 	          volume,
 	          &error );
@@ -1147,10 +1224,11 @@ int vsapm_test_volume_open_close(
 	 "error",
 	 error );
 
-	/* Clean up
-	 */
-	result = libvsapm_volume_free(
-	          &volume,
+	result = libvsapm_volume_open_memory(
+	          volume,
+	          volume_data,
+	          2048,
+	          LIBVSAPM_OPEN_READ,
 	          &error );
 
 	VSAPM_TEST_ASSERT_EQUAL_INT(
@@ -1159,43 +1237,49 @@ int vsapm_test_volume_open_close(
 	 1 );
 
 	VSAPM_TEST_ASSERT_IS_NULL(
-	 "volume",
-	 volume );
+	 "error",
+	 error );
+
+	result = libvsapm_volume_get_partition_by_index(
+	          volume,
+	          0,
+	          &partition,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "partition",
+	 partition );
 
 	VSAPM_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	return( 1 );
+	read_count = libvsapm_partition_read_buffer_at_offset(
+	              partition,
+	              partition_data,
+	              512,
+	              0,
+	              &error );
 
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	if( volume != NULL )
-	{
-		libvsapm_volume_free(
-		 &volume,
-		 NULL );
-	}
-	return( 0 );
-}
+	VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
 
-/* Tests the libvsapm_volume_signal_abort function
- * Returns 1 if successful or 0 if not
- */
-int vsapm_test_volume_signal_abort(
-     libvsapm_volume_t *volume )
-{
-	libcerror_error_t *error = NULL;
-	int result               = 0;
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
-	/* Test regular cases
-	 */
-	result = libvsapm_volume_signal_abort(
-	          volume,
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_partition_free(
+	          &partition,
 	          &error );
 
 	VSAPM_TEST_ASSERT_EQUAL_INT(
@@ -1209,8 +1293,11 @@ int vsapm_test_volume_signal_abort(
 
 	/* Test error cases
 	 */
-	result = libvsapm_volume_signal_abort(
-	          NULL,
+	result = libvsapm_volume_open_memory(
+	          volume,
+	          volume_data,
+	          4096,
+	          LIBVSAPM_OPEN_READ,
 	          &error );
 
 	VSAPM_TEST_ASSERT_EQUAL_INT(
@@ -1225,48 +1312,24 @@ int vsapm_test_volume_signal_abort(
 	libcerror_error_free(
 	 &error );
 
-	return( 1 );
-
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	return( 0 );
-}
-
-/* Tests the libvsapm_volume_get_bytes_per_sector function
- * Returns 1 if successful or 0 if not
- */
-int vsapm_test_volume_get_bytes_per_sector(
-     libvsapm_volume_t *volume )
-{
-	libcerror_error_t *error  = NULL;
-	uint32_t bytes_per_sector = 0;
-	int result                = 0;
-
-	/* Test regular cases
-	 */
-	result = libvsapm_volume_get_bytes_per_sector(
+	result = libvsapm_volume_close(
 	          volume,
-	          &bytes_per_sector,
 	          &error );
 
 	VSAPM_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 0 );
 
 	VSAPM_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Test error cases
-	 */
-	result = libvsapm_volume_get_bytes_per_sector(
+	result = libvsapm_volume_open_memory(
 	          NULL,
-	          &bytes_per_sector,
+	          volume_data,
+	          4096,
+	          LIBVSAPM_OPEN_READ,
 	          &error );
 
 	VSAPM_TEST_ASSERT_EQUAL_INT(
@@ -1281,9 +1344,11 @@ int vsapm_test_volume_get_bytes_per_sector(
 	libcerror_error_free(
 	 &error );
 
-	result = libvsapm_volume_get_bytes_per_sector(
+	result = libvsapm_volume_open_memory(
 	          volume,
 	          NULL,
+	          4096,
+	          LIBVSAPM_OPEN_READ,
 	          &error );
 
 	VSAPM_TEST_ASSERT_EQUAL_INT(
@@ -1298,55 +1363,3657 @@ int vsapm_test_volume_get_bytes_per_sector(
 	libcerror_error_free(
 	 &error );
 
-	return( 1 );
-
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	return( 0 );
-}
-
-/* Tests the libvsapm_volume_get_number_of_partitions function
- * Returns 1 if successful or 0 if not
- */
-int vsapm_test_volume_get_number_of_partitions(
-     libvsapm_volume_t *volume )
-{
-	libcerror_error_t *error = NULL;
-	int number_of_partitions = 0;
-	int result               = 0;
-
-	/* Test regular cases
-	 */
-	result = libvsapm_volume_get_number_of_partitions(
+	result = libvsapm_volume_open_memory(
 	          volume,
-	          &number_of_partitions,
+	          volume_data,
+	          (size_t) SSIZE_MAX + 1,
+	          LIBVSAPM_OPEN_READ,
 	          &error );
 
 	VSAPM_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 -1 );
 
-	VSAPM_TEST_ASSERT_IS_NULL(
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	/* Test error cases
-	 */
-	result = libvsapm_volume_get_number_of_partitions(
-	          NULL,
-	          &number_of_partitions,
-	          &error );
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_volume_open_memory(
+	          volume,
+	          volume_data,
+	          4096,
+	          LIBVSAPM_OPEN_WRITE,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvsapm_volume_free(
+	          &volume,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "volume",
+	 volume );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( partition != NULL )
+	{
+		libvsapm_partition_free(
+		 &partition,
+		 NULL );
+	}
+	if( volume != NULL )
+	{
+		libvsapm_volume_free(
+		 &volume,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvsapm_volume_open_file_io_pool function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_volume_open_file_io_pool(
+     void )
+{
+	uint8_t partition_data[ 512 ];
+	uint8_t volume_data[ 4096 ];
+
+	libbfio_handle_t *file_io_handle = NULL;
+	libbfio_pool_t *file_io_pool     = NULL;
+	libcerror_error_t *error         = NULL;
+	libvsapm_partition_t *partition  = NULL;
+	libvsapm_volume_t *volume        = NULL;
+	ssize_t read_count               = 0;
+	size_t data_offset               = 0;
+	int entry_index                  = 0;
+	int number_of_partitions         = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 * Create a volume of 8 sectors with a partition map of 2 entries
+	 * and a partition in sectors 4 to 7, that is split into 2 segments
+	 * where the segment boundary is within the partition data
+	 */
+	memory_set(
+	 volume_data,
+	 0,
+	 4096 );
+
+	for( data_offset = 512;
+	     data_offset <= 1024;
+	     data_offset += 512 )
+	{
+		volume_data[ data_offset ]     = 'P';
+		volume_data[ data_offset + 1 ] = 'M';
+
+		byte_stream_copy_from_uint32_big_endian(
+		 &( volume_data[ data_offset + 4 ] ),
+		 2 );
+	}
+	byte_stream_copy_from_uint32_big_endian(
+	 &( volume_data[ 512 + 8 ] ),
+	 1 );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( volume_data[ 512 + 12 ] ),
+	 2 );
+
+	memory_copy(
+	 &( volume_data[ 512 + 48 ] ),
+	 "Apple_partition_map",
+	 19 );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( volume_data[ 1024 + 8 ] ),
+	 4 );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( volume_data[ 1024 + 12 ] ),
+	 4 );
+
+	memory_copy(
+	 &( volume_data[ 1024 + 48 ] ),
+	 "Apple_HFS",
+	 9 );
+
+	for( data_offset = 2048;
+	     data_offset < 4096;
+	     data_offset++ )
+	{
+		volume_data[ data_offset ] = (uint8_t) data_offset;
+	}
+	result = libbfio_pool_initialize(
+	          &file_io_pool,
+	          0,
+	          0,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_pool",
+	 file_io_pool );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( data_offset = 0;
+	     data_offset < 4096;
+	     data_offset += 2816 )
+	{
+		result = libbfio_memory_range_initialize(
+		          &file_io_handle,
+		          &error );
+
+		VSAPM_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSAPM_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libbfio_memory_range_set(
+		          file_io_handle,
+		          &( volume_data[ data_offset ] ),
+		          ( data_offset == 0 ) ? 2816 : 4096 - 2816,
+		          &error );
+
+		VSAPM_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSAPM_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libbfio_pool_append_handle(
+		          file_io_pool,
+		          &entry_index,
+		          file_io_handle,
+		          LIBBFIO_OPEN_READ,
+		          &error );
+
+		VSAPM_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSAPM_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		file_io_handle = NULL;
+	}
+	result = libvsapm_volume_initialize(
+	          &volume,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvsapm_volume_open_file_io_pool(
+	          volume,
+	          file_io_pool,
+	          LIBVSAPM_OPEN_READ,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_volume_get_number_of_partitions(
+	          volume,
+	          &number_of_partitions,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "number_of_partitions",
+	 number_of_partitions,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_volume_get_partition_by_index(
+	          volume,
+	          0,
+	          &partition,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "partition",
+	 partition );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libvsapm_partition_read_buffer_at_offset(
+	              partition,
+	              partition_data,
+	              512,
+	              512,
+	              &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 512 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          partition_data,
+	          &( volume_data[ 2048 + 512 ] ),
+	          512 );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libvsapm_partition_free(
+	          &partition,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvsapm_volume_open_file_io_pool(
+	          volume,
+	          file_io_pool,
+	          LIBVSAPM_OPEN_READ,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_volume_close(
+	          volume,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_volume_open_file_io_pool(
+	          NULL,
+	          file_io_pool,
+	          LIBVSAPM_OPEN_READ,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_volume_open_file_io_pool(
+	          volume,
+	          NULL,
+	          LIBVSAPM_OPEN_READ,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_volume_open_file_io_pool(
+	          volume,
+	          file_io_pool,
+	          LIBVSAPM_OPEN_WRITE,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvsapm_volume_free(
+	          &volume,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "volume",
+	 volume );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_pool_free(
+	          &file_io_pool,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( partition != NULL )
+	{
+		libvsapm_partition_free(
+		 &partition,
+		 NULL );
+	}
+	if( volume != NULL )
+	{
+		libvsapm_volume_free(
+		 &volume,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( file_io_pool != NULL )
+	{
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* The result of an asynchronous read
+ */
+typedef struct vsapm_test_read_completion vsapm_test_read_completion_t;
+
+struct vsapm_test_read_completion
+{
+	/* The offset of the read
+	 */
+	off64_t offset;
+
+	/* The number of bytes read
+	 */
+	ssize_t read_count;
+
+	/* The number of times the callback was called
+	 */
+	int number_of_calls;
+};
+
+/* Completion callback for libvsapm_partition_read_async
+ * Returns 1 if successful or -1 on error
+ */
+int vsapm_test_volume_read_completion_callback(
+     libvsapm_partition_t *partition VSAPM_TEST_ATTRIBUTE_UNUSED,
+     off64_t offset,
+     void *buffer VSAPM_TEST_ATTRIBUTE_UNUSED,
+     ssize_t read_count,
+     void *user_data )
+{
+	vsapm_test_read_completion_t *read_completion = NULL;
+
+	VSAPM_TEST_UNREFERENCED_PARAMETER( partition );
+	VSAPM_TEST_UNREFERENCED_PARAMETER( buffer );
+
+	if( user_data == NULL )
+	{
+		return( -1 );
+	}
+	read_completion = (vsapm_test_read_completion_t *) user_data;
+
+	read_completion->offset           = offset;
+	read_completion->read_count       = read_count;
+	read_completion->number_of_calls += 1;
+
+	return( 1 );
+}
+
+/* Tests the libvsapm_partition_read_async and libvsapm_volume_poll_completions functions
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_volume_poll_completions(
+     void )
+{
+	uint8_t partition_data[ 1024 ];
+	uint8_t volume_data[ 4096 ];
+
+	vsapm_test_read_completion_t read_completions[ 2 ];
+
+	libcerror_error_t *error        = NULL;
+	libvsapm_partition_t *partition = NULL;
+	libvsapm_volume_t *volume       = NULL;
+	time_t start_time               = 0;
+	size_t data_offset              = 0;
+	int number_of_completions       = 0;
+	int result                      = 0;
+	int total_number_of_completions = 0;
+
+	/* Initialize test
+	 * Create a volume of 8 sectors with a partition map of 2 entries
+	 * and a partition in sectors 4 to 7
+	 */
+	memory_set(
+	 volume_data,
+	 0,
+	 4096 );
+
+	memory_set(
+	 read_completions,
+	 0,
+	 sizeof( vsapm_test_read_completion_t ) * 2 );
+
+	for( data_offset = 512;
+	     data_offset <= 1024;
+	     data_offset += 512 )
+	{
+		volume_data[ data_offset ]     = 'P';
+		volume_data[ data_offset + 1 ] = 'M';
+
+		byte_stream_copy_from_uint32_big_endian(
+		 &( volume_data[ data_offset + 4 ] ),
+		 2 );
+	}
+	byte_stream_copy_from_uint32_big_endian(
+	 &( volume_data[ 512 + 8 ] ),
+	 1 );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( volume_data[ 512 + 12 ] ),
+	 2 );
+
+	memory_copy(
+	 &( volume_data[ 512 + 48 ] ),
+	 "Apple_partition_map",
+	 19 );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( volume_data[ 1024 + 8 ] ),
+	 4 );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( volume_data[ 1024 + 12 ] ),
+	 4 );
+
+	memory_copy(
+	 &( volume_data[ 1024 + 48 ] ),
+	 "Apple_HFS",
+	 9 );
+
+	for( data_offset = 2048;
+	     data_offset < 4096;
+	     data_offset++ )
+	{
+		volume_data[ data_offset ] = (uint8_t) data_offset;
+	}
+	result = libvsapm_volume_initialize(
+	          &volume,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_volume_open_memory(
+	          volume,
+	          volume_data,
+	          4096,
+	          LIBVSAPM_OPEN_READ,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_volume_get_partition_by_index(
+	          volume,
+	          0,
+	          &partition,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "partition",
+	 partition );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that polling before the first asynchronous read does not create the read queue
+	 */
+	result = libvsapm_volume_poll_completions(
+	          volume,
+	          16,
+	          &number_of_completions,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "number_of_completions",
+	 number_of_completions,
+	 0 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#if defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT )
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "read_queue",
+	 ( (libvsapm_internal_volume_t *) volume )->io_handle->read_queue );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT ) */
+
+	/* Test regular cases
+	 */
+	result = libvsapm_partition_read_async(
+	          partition,
+	          512,
+	          partition_data,
+	          512,
+	          &vsapm_test_volume_read_completion_callback,
+	          (void *) &( read_completions[ 0 ] ),
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Reads beyond the end of the partition are truncated
+	 */
+	result = libvsapm_partition_read_async(
+	          partition,
+	          1536,
+	          &( partition_data[ 512 ] ),
+	          512,
+	          &vsapm_test_volume_read_completion_callback,
+	          (void *) &( read_completions[ 1 ] ),
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	start_time = time(
+	              NULL );
+
+	while( total_number_of_completions < 2 )
+	{
+		result = libvsapm_volume_poll_completions(
+		          volume,
+		          16,
+		          &number_of_completions,
+		          &error );
+
+		VSAPM_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSAPM_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		total_number_of_completions += number_of_completions;
+
+		if( ( time( NULL ) - start_time ) > 30 )
+		{
+			break;
+		}
+	}
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "total_number_of_completions",
+	 total_number_of_completions,
+	 2 );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "read_completions[ 0 ].number_of_calls",
+	 read_completions[ 0 ].number_of_calls,
+	 1 );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT64(
+	 "read_completions[ 0 ].offset",
+	 (int64_t) read_completions[ 0 ].offset,
+	 (int64_t) 512 );
+
+	VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_completions[ 0 ].read_count",
+	 read_completions[ 0 ].read_count,
+	 (ssize_t) 512 );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "read_completions[ 1 ].number_of_calls",
+	 read_completions[ 1 ].number_of_calls,
+	 1 );
+
+	VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_completions[ 1 ].read_count",
+	 read_completions[ 1 ].read_count,
+	 (ssize_t) 512 );
+
+	result = memory_compare(
+	          partition_data,
+	          &( volume_data[ 2048 + 512 ] ),
+	          512 );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = memory_compare(
+	          &( partition_data[ 512 ] ),
+	          &( volume_data[ 2048 + 1536 ] ),
+	          512 );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* No completions are pending
+	 */
+	result = libvsapm_volume_poll_completions(
+	          volume,
+	          16,
+	          &number_of_completions,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "number_of_completions",
+	 number_of_completions,
+	 0 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#if defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT ) && defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT )
+
+	/* Test that a read is rejected without waiting when the read queue is full
+	 */
+	( (libvsapm_internal_volume_t *) volume )->io_handle->read_queue->number_of_pending_requests = LIBVSAPM_MAXIMUM_NUMBER_OF_QUEUED_READ_REQUESTS;
+
+	result = libvsapm_partition_read_async(
+	          partition,
+	          0,
+	          partition_data,
+	          512,
+	          &vsapm_test_volume_read_completion_callback,
+	          NULL,
+	          &error );
+
+	( (libvsapm_internal_volume_t *) volume )->io_handle->read_queue->number_of_pending_requests = 0;
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#endif /* defined( HAVE_LIBVSAPM_MULTI_THREAD_SUPPORT ) && defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT ) */
+
+	/* Test error cases
+	 */
+	result = libvsapm_partition_read_async(
+	          NULL,
+	          0,
+	          partition_data,
+	          512,
+	          &vsapm_test_volume_read_completion_callback,
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_partition_read_async(
+	          partition,
+	          0,
+	          partition_data,
+	          512,
+	          NULL,
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_volume_poll_completions(
+	          NULL,
+	          16,
+	          &number_of_completions,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_volume_poll_completions(
+	          volume,
+	          0,
+	          &number_of_completions,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_volume_poll_completions(
+	          volume,
+	          16,
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvsapm_partition_free(
+	          &partition,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_volume_free(
+	          &volume,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "volume",
+	 volume );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( partition != NULL )
+	{
+		libvsapm_partition_free(
+		 &partition,
+		 NULL );
+	}
+	if( volume != NULL )
+	{
+		libvsapm_volume_free(
+		 &volume,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* The result of a volume scan
+ */
+typedef struct vsapm_test_scan_result vsapm_test_scan_result_t;
+
+struct vsapm_test_scan_result
+{
+	/* The copy of the scanned data at its volume offset
+	 */
+	uint8_t *data;
+
+	/* The number of bytes of the partition that were scanned
+	 */
+	size_t partition_data_size;
+
+	/* The number of bytes of unallocated data that were scanned
+	 */
+	size_t unallocated_data_size;
+
+	/* The value returned by the callback
+	 */
+	int callback_result;
+};
+
+/* Callback for libvsapm_volume_scan
+ * Returns 1 to continue, 0 to stop or -1 on error
+ */
+int vsapm_test_volume_scan_callback(
+     int partition_index,
+     off64_t offset,
+     const uint8_t *data,
+     size_t data_size,
+     void *user_data )
+{
+	vsapm_test_scan_result_t *scan_result = NULL;
+	off64_t volume_offset                 = 0;
+
+	if( ( data == NULL )
+	 || ( user_data == NULL ) )
+	{
+		return( -1 );
+	}
+	scan_result = (vsapm_test_scan_result_t *) user_data;
+
+	if( scan_result->callback_result != 1 )
+	{
+		return( scan_result->callback_result );
+	}
+	if( partition_index == 0 )
+	{
+		/* The partition starts at sector 4
+		 */
+		volume_offset = 2048 + offset;
+
+		scan_result->partition_data_size += data_size;
+	}
+	else if( partition_index == -1 )
+	{
+		volume_offset = offset;
+
+		scan_result->unallocated_data_size += data_size;
+	}
+	else
+	{
+		return( -1 );
+	}
+	if( ( volume_offset < 0 )
+	 || ( ( volume_offset + (off64_t) data_size ) > 4096 ) )
+	{
+		return( -1 );
+	}
+	memory_copy(
+	 &( scan_result->data[ volume_offset ] ),
+	 data,
+	 data_size );
+
+	return( 1 );
+}
+
+/* Tests the libvsapm_volume_scan function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_volume_scan(
+     void )
+{
+	uint8_t scan_data[ 4096 ];
+	uint8_t volume_data[ 4096 ];
+
+	vsapm_test_scan_result_t scan_result;
+
+	libcerror_error_t *error  = NULL;
+	libvsapm_volume_t *volume = NULL;
+	size_t data_offset        = 0;
+	int result                = 0;
+
+	/* Initialize test
+	 * Create a volume of 8 sectors with a partition map of 2 entries
+	 * and a partition in sectors 4 to 7
+	 */
+	memory_set(
+	 volume_data,
+	 0,
+	 4096 );
+
+	memory_set(
+	 &scan_result,
+	 0,
+	 sizeof( vsapm_test_scan_result_t ) );
+
+	memory_set(
+	 scan_data,
+	 0,
+	 4096 );
+
+	for( data_offset = 512;
+	     data_offset <= 1024;
+	     data_offset += 512 )
+	{
+		volume_data[ data_offset ]     = 'P';
+		volume_data[ data_offset + 1 ] = 'M';
+
+		byte_stream_copy_from_uint32_big_endian(
+		 &( volume_data[ data_offset + 4 ] ),
+		 2 );
+	}
+	byte_stream_copy_from_uint32_big_endian(
+	 &( volume_data[ 512 + 8 ] ),
+	 1 );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( volume_data[ 512 + 12 ] ),
+	 2 );
+
+	memory_copy(
+	 &( volume_data[ 512 + 48 ] ),
+	 "Apple_partition_map",
+	 19 );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( volume_data[ 1024 + 8 ] ),
+	 4 );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( volume_data[ 1024 + 12 ] ),
+	 4 );
+
+	memory_copy(
+	 &( volume_data[ 1024 + 48 ] ),
+	 "Apple_HFS",
+	 9 );
+
+	for( data_offset = 2048;
+	     data_offset < 4096;
+	     data_offset++ )
+	{
+		volume_data[ data_offset ] = (uint8_t) data_offset;
+	}
+	scan_result.data            = scan_data;
+	scan_result.callback_result = 1;
+
+	result = libvsapm_volume_initialize(
+	          &volume,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_volume_open_memory(
+	          volume,
+	          volume_data,
+	          4096,
+	          LIBVSAPM_OPEN_READ,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 * A single thread is used since the callback does not synchronize access to the scan result
+	 */
+	result = libvsapm_volume_scan(
+	          volume,
+	          768,
+	          1,
+	          0,
+	          &vsapm_test_volume_scan_callback,
+	          (void *) &scan_result,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SIZE(
+	 "scan_result.partition_data_size",
+	 scan_result.partition_data_size,
+	 (size_t) 2048 );
+
+	VSAPM_TEST_ASSERT_EQUAL_SIZE(
+	 "scan_result.unallocated_data_size",
+	 scan_result.unallocated_data_size,
+	 (size_t) 0 );
+
+	result = memory_compare(
+	          &( scan_data[ 2048 ] ),
+	          &( volume_data[ 2048 ] ),
+	          2048 );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Sector 3 is the only unallocated sector
+	 */
+	scan_result.partition_data_size   = 0;
+	scan_result.unallocated_data_size = 0;
+
+	result = libvsapm_volume_scan(
+	          volume,
+	          512,
+	          1,
+	          LIBVSAPM_SCAN_FLAG_UNALLOCATED,
+	          &vsapm_test_volume_scan_callback,
+	          (void *) &scan_result,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SIZE(
+	 "scan_result.partition_data_size",
+	 scan_result.partition_data_size,
+	 (size_t) 2048 );
+
+	VSAPM_TEST_ASSERT_EQUAL_SIZE(
+	 "scan_result.unallocated_data_size",
+	 scan_result.unallocated_data_size,
+	 (size_t) 512 );
+
+	/* The scan is stopped when the callback returns 0
+	 */
+	scan_result.callback_result = 0;
+
+	result = libvsapm_volume_scan(
+	          volume,
+	          512,
+	          4,
+	          0,
+	          &vsapm_test_volume_scan_callback,
+	          (void *) &scan_result,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	scan_result.callback_result = -1;
+
+	result = libvsapm_volume_scan(
+	          volume,
+	          512,
+	          4,
+	          0,
+	          &vsapm_test_volume_scan_callback,
+	          (void *) &scan_result,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_volume_scan(
+	          NULL,
+	          512,
+	          1,
+	          0,
+	          &vsapm_test_volume_scan_callback,
+	          (void *) &scan_result,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_volume_scan(
+	          volume,
+	          0,
+	          1,
+	          0,
+	          &vsapm_test_volume_scan_callback,
+	          (void *) &scan_result,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_volume_scan(
+	          volume,
+	          512,
+	          0,
+	          0,
+	          &vsapm_test_volume_scan_callback,
+	          (void *) &scan_result,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_volume_scan(
+	          volume,
+	          512,
+	          1,
+	          0xff,
+	          &vsapm_test_volume_scan_callback,
+	          (void *) &scan_result,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_volume_scan(
+	          volume,
+	          512,
+	          1,
+	          0,
+	          NULL,
+	          (void *) &scan_result,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvsapm_volume_free(
+	          &volume,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "volume",
+	 volume );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libvsapm_volume_free(
+		 &volume,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvsapm_volume_freeze function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_volume_freeze(
+     void )
+{
+	uint8_t partition_data[ 512 ];
+	uint8_t volume_data[ 4096 ];
+	char type_string[ 33 ];
+
+	libcerror_error_t *error               = NULL;
+	libvsapm_partition_t *clone_partition  = NULL;
+	libvsapm_partition_t *partition        = NULL;
+	libvsapm_volume_t *volume              = NULL;
+	size64_t partition_size                = 0;
+	off64_t volume_offset                  = 0;
+	size_t data_offset                     = 0;
+	ssize_t read_count                     = 0;
+	uint32_t bytes_per_sector              = 0;
+	int number_of_partitions               = 0;
+	int number_of_unallocated_ranges       = 0;
+	int partition_index                    = 0;
+	int result                             = 0;
+
+	/* Initialize test
+	 * Create a volume of 8 sectors with a partition map of 2 entries
+	 * and a partition in sectors 4 to 7
+	 */
+	memory_set(
+	 volume_data,
+	 0,
+	 4096 );
+
+	for( data_offset = 512;
+	     data_offset <= 1024;
+	     data_offset += 512 )
+	{
+		volume_data[ data_offset ]     = 'P';
+		volume_data[ data_offset + 1 ] = 'M';
+
+		byte_stream_copy_from_uint32_big_endian(
+		 &( volume_data[ data_offset + 4 ] ),
+		 2 );
+	}
+	byte_stream_copy_from_uint32_big_endian(
+	 &( volume_data[ 512 + 8 ] ),
+	 1 );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( volume_data[ 512 + 12 ] ),
+	 2 );
+
+	memory_copy(
+	 &( volume_data[ 512 + 48 ] ),
+	 "Apple_partition_map",
+	 19 );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( volume_data[ 1024 + 8 ] ),
+	 4 );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( volume_data[ 1024 + 12 ] ),
+	 4 );
+
+	memory_copy(
+	 &( volume_data[ 1024 + 48 ] ),
+	 "Apple_HFS",
+	 9 );
+
+	result = libvsapm_volume_initialize(
+	          &volume,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error case where the volume is not opened
+	 */
+	result = libvsapm_volume_freeze(
+	          volume,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_volume_open_memory(
+	          volume,
+	          volume_data,
+	          4096,
+	          LIBVSAPM_OPEN_READ,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvsapm_volume_freeze(
+	          volume,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Freezing a frozen volume has no effect
+	 */
+	result = libvsapm_volume_freeze(
+	          volume,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_volume_get_bytes_per_sector(
+	          volume,
+	          &bytes_per_sector,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_EQUAL_UINT32(
+	 "bytes_per_sector",
+	 bytes_per_sector,
+	 (uint32_t) 512 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_volume_get_number_of_partitions(
+	          volume,
+	          &number_of_partitions,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "number_of_partitions",
+	 number_of_partitions,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_volume_get_number_of_unallocated_ranges(
+	          volume,
+	          &number_of_unallocated_ranges,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "number_of_unallocated_ranges",
+	 number_of_unallocated_ranges,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_volume_get_partition_index_by_offset(
+	          volume,
+	          3000,
+	          &partition_index,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "partition_index",
+	 partition_index,
+	 0 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_volume_get_partition_index_by_offset(
+	          volume,
+	          1536,
+	          &partition_index,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_volume_has_overlapping_partitions(
+	          volume,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_volume_get_partition_by_index(
+	          volume,
+	          0,
+	          &partition,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "partition",
+	 partition );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error case where bytes per sector is set on a frozen volume
+	 */
+	result = libvsapm_volume_set_bytes_per_sector(
+	          volume,
+	          4096,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvsapm_partition_read_buffer_at_offset(
+	              partition,
+	              partition_data,
+	              512,
+	              0,
+	              &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 512 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_partition_clone(
+	          &clone_partition,
+	          partition,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "clone_partition",
+	 clone_partition );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that the partition metadata remains available after the volume is closed
+	 */
+	result = libvsapm_volume_close(
+	          volume,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error case where the partition data is read after the volume is closed
+	 */
+	read_count = libvsapm_partition_read_buffer_at_offset(
+	              partition,
+	              partition_data,
+	              512,
+	              0,
+	              &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_partition_read_async(
+	          partition,
+	          0,
+	          partition_data,
+	          512,
+	          &vsapm_test_volume_read_completion_callback,
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the clone is read after the volume is closed
+	 */
+	read_count = libvsapm_partition_read_buffer(
+	              clone_partition,
+	              partition_data,
+	              512,
+	              &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_partition_get_size(
+	          clone_partition,
+	          &partition_size,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_EQUAL_UINT64(
+	 "partition_size",
+	 (uint64_t) partition_size,
+	 (uint64_t) 2048 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_partition_free(
+	          &clone_partition,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "clone_partition",
+	 clone_partition );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_partition_get_volume_offset(
+	          partition,
+	          &volume_offset,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT64(
+	 "volume_offset",
+	 (int64_t) volume_offset,
+	 (int64_t) 2048 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_partition_get_size(
+	          partition,
+	          &partition_size,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_EQUAL_UINT64(
+	 "partition_size",
+	 (uint64_t) partition_size,
+	 (uint64_t) 2048 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_partition_get_type_string(
+	          partition,
+	          type_string,
+	          33,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = narrow_string_compare(
+	          type_string,
+	          "Apple_HFS",
+	          10 );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Clean up
+	 */
+	result = libvsapm_partition_free(
+	          &partition,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "partition",
+	 partition );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvsapm_volume_freeze(
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvsapm_volume_free(
+	          &volume,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "volume",
+	 volume );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( clone_partition != NULL )
+	{
+		libvsapm_partition_free(
+		 &clone_partition,
+		 NULL );
+	}
+	if( partition != NULL )
+	{
+		libvsapm_partition_free(
+		 &partition,
+		 NULL );
+	}
+	if( volume != NULL )
+	{
+		libvsapm_volume_free(
+		 &volume,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvsapm_volume_close function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_volume_close(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvsapm_volume_close(
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvsapm_volume_open and libvsapm_volume_close functions
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_volume_open_close(
+     const system_character_t *source )
+{
+	libcerror_error_t *error  = NULL;
+	libvsapm_volume_t *volume = NULL;
+	int result                = 0;
+
+	/* Initialize test
+	 */
+	result = libvsapm_volume_initialize(
+	          &volume,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test open and close
+	 */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvsapm_volume_open_wide(
+	          volume,
+	          source,
+	          LIBVSAPM_OPEN_READ,
+	          &error );
+#else
+	result = libvsapm_volume_open(
+	          volume,
+	          source,
+	          LIBVSAPM_OPEN_READ,
+	          &error );
+#endif
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_volume_close(
+	          volume,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test open and close a second time to validate clean up on close
+	 */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvsapm_volume_open_wide(
+	          volume,
+	          source,
+	          LIBVSAPM_OPEN_READ,
+	          &error );
+#else
+	result = libvsapm_volume_open(
+	          volume,
+	          source,
+	          LIBVSAPM_OPEN_READ,
+	          &error );
+#endif
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_volume_close(
+	          volume,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libvsapm_volume_free(
+	          &volume,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "volume",
+	 volume );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libvsapm_volume_free(
+		 &volume,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests reading the partition map entries on demand
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_volume_open_read_partition_map_on_demand(
+     const system_character_t *source )
+{
+	libcerror_error_t *error        = NULL;
+	libvsapm_partition_t *partition = NULL;
+	libvsapm_volume_t *volume       = NULL;
+	int number_of_partitions        = 0;
+	int partition_index             = 0;
+	int result                      = 0;
+
+	/* Initialize test
+	 */
+	result = libvsapm_volume_initialize(
+	          &volume,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_volume_set_read_partition_map_on_demand(
+	          volume,
+	          1,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test open and read the partitions on demand
+	 */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvsapm_volume_open_wide(
+	          volume,
+	          source,
+	          LIBVSAPM_OPEN_READ,
+	          &error );
+#else
+	result = libvsapm_volume_open(
+	          volume,
+	          source,
+	          LIBVSAPM_OPEN_READ,
+	          &error );
+#endif
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_volume_get_number_of_partitions(
+	          volume,
+	          &number_of_partitions,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( partition_index = 0;
+	     partition_index < number_of_partitions;
+	     partition_index++ )
+	{
+		result = libvsapm_volume_get_partition_by_index(
+		          volume,
+		          partition_index,
+		          &partition,
+		          &error );
+
+		VSAPM_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSAPM_TEST_ASSERT_IS_NOT_NULL(
+		 "partition",
+		 partition );
+
+		VSAPM_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libvsapm_partition_free(
+		          &partition,
+		          &error );
+
+		VSAPM_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSAPM_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error case where the partition index is out of bounds
+	 */
+	result = libvsapm_volume_get_partition_by_index(
+	          volume,
+	          number_of_partitions,
+	          &partition,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "partition",
+	 partition );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* The partition index is created on demand
+	 */
+	result = libvsapm_volume_has_overlapping_partitions(
+	          volume,
+	          &error );
+
+	VSAPM_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvsapm_volume_set_read_partition_map_on_demand(
+	          volume,
+	          0,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvsapm_volume_close(
+	          volume,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_volume_free(
+	          &volume,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "volume",
+	 volume );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( partition != NULL )
+	{
+		libvsapm_partition_free(
+		 &partition,
+		 NULL );
+	}
+	if( volume != NULL )
+	{
+		libvsapm_volume_free(
+		 &volume,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvsapm_volume_open function with additional access flags
+ * The partition data is compared with that of a volume opened without the access flags
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_volume_open_with_access_flags(
+     const system_character_t *source,
+     int access_flags )
+{
+	uint8_t *buffer                           = NULL;
+	uint8_t *reference_buffer                 = NULL;
+	libcerror_error_t *error                  = NULL;
+	libvsapm_partition_t *partition           = NULL;
+	libvsapm_partition_t *reference_partition = NULL;
+	libvsapm_volume_t *reference_volume       = NULL;
+	libvsapm_volume_t *volume                 = NULL;
+	size64_t partition_size                   = 0;
+	ssize_t read_count                        = 0;
+	size_t read_size                          = 0;
+	off64_t read_offset                       = 0;
+	int number_of_partitions                  = 0;
+	int partition_index                       = 0;
+	int read_index                            = 0;
+	int result                                = 0;
+
+	/* Initialize test
+	 */
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * 65536 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "buffer",
+	 buffer );
+
+	reference_buffer = (uint8_t *) memory_allocate(
+	                                sizeof( uint8_t ) * 65536 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "reference_buffer",
+	 reference_buffer );
+
+	result = libvsapm_volume_initialize(
+	          &reference_volume,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvsapm_volume_open_wide(
+	          reference_volume,
+	          source,
+	          LIBVSAPM_OPEN_READ,
+	          &error );
+#else
+	result = libvsapm_volume_open(
+	          reference_volume,
+	          source,
+	          LIBVSAPM_OPEN_READ,
+	          &error );
+#endif
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_volume_initialize(
+	          &volume,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test open
+	 * If the access flags are not supported the volume falls back to regular reads
+	 */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvsapm_volume_open_wide(
+	          volume,
+	          source,
+	          LIBVSAPM_OPEN_READ | access_flags,
+	          &error );
+#else
+	result = libvsapm_volume_open(
+	          volume,
+	          source,
+	          LIBVSAPM_OPEN_READ | access_flags,
+	          &error );
+#endif
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_volume_get_number_of_partitions(
+	          volume,
+	          &number_of_partitions,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test read of the start of each partition and of an unaligned range
+	 */
+	for( partition_index = 0;
+	     partition_index < number_of_partitions;
+	     partition_index++ )
+	{
+		result = libvsapm_volume_get_partition_by_index(
+		          volume,
+		          partition_index,
+		          &partition,
+		          &error );
+
+		VSAPM_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSAPM_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libvsapm_volume_get_partition_by_index(
+		          reference_volume,
+		          partition_index,
+		          &reference_partition,
+		          &error );
+
+		VSAPM_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSAPM_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libvsapm_partition_get_size(
+		          partition,
+		          &partition_size,
+		          &error );
+
+		VSAPM_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSAPM_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		for( read_index = 0;
+		     read_index < 2;
+		     read_index++ )
+		{
+			if( read_index == 0 )
+			{
+				read_offset = 0;
+				read_size   = 65536;
+			}
+			else
+			{
+				read_offset = 1000;
+				read_size   = 5000;
+			}
+			if( (size64_t) read_offset >= partition_size )
+			{
+				continue;
+			}
+			if( read_size > (size_t) ( partition_size - read_offset ) )
+			{
+				read_size = (size_t) ( partition_size - read_offset );
+			}
+			read_count = libvsapm_partition_read_buffer_at_offset(
+			              partition,
+			              buffer,
+			              read_size,
+			              read_offset,
+			              &error );
+
+			VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+			 "read_count",
+			 read_count,
+			 (ssize_t) read_size );
+
+			VSAPM_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			read_count = libvsapm_partition_read_buffer_at_offset(
+			              reference_partition,
+			              reference_buffer,
+			              read_size,
+			              read_offset,
+			              &error );
+
+			VSAPM_TEST_ASSERT_EQUAL_SSIZE(
+			 "read_count",
+			 read_count,
+			 (ssize_t) read_size );
+
+			VSAPM_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			result = memory_compare(
+			          buffer,
+			          reference_buffer,
+			          read_size );
+
+			VSAPM_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 0 );
+		}
+		result = libvsapm_partition_free(
+		          &reference_partition,
+		          &error );
+
+		VSAPM_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSAPM_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libvsapm_partition_free(
+		          &partition,
+		          &error );
+
+		VSAPM_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSAPM_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Clean up
+	 */
+	result = libvsapm_volume_close(
+	          volume,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_volume_free(
+	          &volume,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_volume_close(
+	          reference_volume,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_volume_free(
+	          &reference_volume,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 reference_buffer );
+
+	memory_free(
+	 buffer );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( reference_partition != NULL )
+	{
+		libvsapm_partition_free(
+		 &reference_partition,
+		 NULL );
+	}
+	if( partition != NULL )
+	{
+		libvsapm_partition_free(
+		 &partition,
+		 NULL );
+	}
+	if( volume != NULL )
+	{
+		libvsapm_volume_free(
+		 &volume,
+		 NULL );
+	}
+	if( reference_volume != NULL )
+	{
+		libvsapm_volume_free(
+		 &reference_volume,
+		 NULL );
+	}
+	if( reference_buffer != NULL )
+	{
+		memory_free(
+		 reference_buffer );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	return( 0 );
+}
+
+/* Tests the libvsapm_volume_signal_abort function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_volume_signal_abort(
+     libvsapm_volume_t *volume )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libvsapm_volume_signal_abort(
+	          volume,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvsapm_volume_signal_abort(
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvsapm_volume_get_bytes_per_sector function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_volume_get_bytes_per_sector(
+     libvsapm_volume_t *volume )
+{
+	libcerror_error_t *error  = NULL;
+	uint32_t bytes_per_sector = 0;
+	int result                = 0;
+
+	/* Test regular cases
+	 */
+	result = libvsapm_volume_get_bytes_per_sector(
+	          volume,
+	          &bytes_per_sector,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvsapm_volume_get_bytes_per_sector(
+	          NULL,
+	          &bytes_per_sector,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_volume_get_bytes_per_sector(
+	          volume,
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvsapm_volume_set_maximum_number_of_partition_map_entries function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_volume_set_maximum_number_of_partition_map_entries(
+     void )
+{
+	libcerror_error_t *error  = NULL;
+	libvsapm_volume_t *volume = NULL;
+	int result                = 0;
+
+	/* Initialize test
+	 */
+	result = libvsapm_volume_initialize(
+	          &volume,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvsapm_volume_set_maximum_number_of_partition_map_entries(
+	          volume,
+	          64,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvsapm_volume_set_maximum_number_of_partition_map_entries(
+	          NULL,
+	          64,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_volume_set_maximum_number_of_partition_map_entries(
+	          volume,
+	          0,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvsapm_volume_free(
+	          &volume,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "volume",
+	 volume );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libvsapm_volume_free(
+		 &volume,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvsapm_volume_set_maximum_partition_map_size function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_volume_set_maximum_partition_map_size(
+     void )
+{
+	libcerror_error_t *error  = NULL;
+	libvsapm_volume_t *volume = NULL;
+	int result                = 0;
+
+	/* Initialize test
+	 */
+	result = libvsapm_volume_initialize(
+	          &volume,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvsapm_volume_set_maximum_partition_map_size(
+	          volume,
+	          64 * 512,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvsapm_volume_set_maximum_partition_map_size(
+	          NULL,
+	          64 * 512,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_volume_set_maximum_partition_map_size(
+	          volume,
+	          0,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvsapm_volume_free(
+	          &volume,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "volume",
+	 volume );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libvsapm_volume_free(
+		 &volume,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvsapm_volume_set_sector_cache_size function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_volume_set_sector_cache_size(
+     void )
+{
+	libcerror_error_t *error  = NULL;
+	libvsapm_volume_t *volume = NULL;
+	int result                = 0;
+
+	/* Initialize test
+	 */
+	result = libvsapm_volume_initialize(
+	          &volume,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvsapm_volume_set_sector_cache_size(
+	          volume,
+	          128 * 4096,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvsapm_volume_set_sector_cache_size(
+	          NULL,
+	          128 * 4096,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_volume_set_sector_cache_size(
+	          volume,
+	          0,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_volume_set_sector_cache_size(
+	          volume,
+	          100 * 4096,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_volume_set_sector_cache_size(
+	          volume,
+	          ( 128 * 4096 ) + 1,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvsapm_volume_free(
+	          &volume,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "volume",
+	 volume );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libvsapm_volume_free(
+		 &volume,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvsapm_volume_set_read_partition_map_on_demand function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_volume_set_read_partition_map_on_demand(
+     void )
+{
+	libcerror_error_t *error  = NULL;
+	libvsapm_volume_t *volume = NULL;
+	int result                = 0;
+
+	/* Initialize test
+	 */
+	result = libvsapm_volume_initialize(
+	          &volume,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvsapm_volume_set_read_partition_map_on_demand(
+	          volume,
+	          1,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvsapm_volume_set_read_partition_map_on_demand(
+	          NULL,
+	          1,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvsapm_volume_free(
+	          &volume,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "volume",
+	 volume );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libvsapm_volume_free(
+		 &volume,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvsapm_volume_get_number_of_partitions function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_volume_get_number_of_partitions(
+     libvsapm_volume_t *volume )
+{
+	libcerror_error_t *error = NULL;
+	int number_of_partitions = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libvsapm_volume_get_number_of_partitions(
+	          volume,
+	          &number_of_partitions,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvsapm_volume_get_number_of_partitions(
+	          NULL,
+	          &number_of_partitions,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_volume_get_number_of_partitions(
+	          volume,
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvsapm_volume_get_partition_by_index function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_volume_get_partition_by_index(
+     libvsapm_volume_t *volume )
+{
+	libcerror_error_t *error                 = NULL;
+	libvsapm_partition_t *partition_by_index = 0;
+	int number_of_partitions                 = 0;
+	int result                               = 0;
+
+	/* Test regular cases
+	 */
+	result = libvsapm_volume_get_number_of_partitions(
+	          volume,
+	          &number_of_partitions,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( number_of_partitions == 0 )
+	{
+		return( 1 );
+	}
+	result = libvsapm_volume_get_partition_by_index(
+	          volume,
+	          0,
+	          &partition_by_index,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "partition_by_index",
+	 partition_by_index );
+
+	result = libvsapm_partition_free(
+	          &partition_by_index,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvsapm_volume_get_partition_by_index(
+	          NULL,
+	          0,
+	          &partition_by_index,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "partition_by_index",
+	 partition_by_index );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_volume_get_partition_by_index(
+	          volume,
+	          -1,
+	          &partition_by_index,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "partition_by_index",
+	 partition_by_index );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_volume_get_partition_by_index(
+	          volume,
+	          0,
+	          NULL,
+	          &error );
 
 	VSAPM_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
 	 -1 );
 
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "partition_by_index",
+	 partition_by_index );
+
 	VSAPM_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
@@ -1354,7 +5021,63 @@ int vsapm_test_volume_get_number_of_partitions(
 	libcerror_error_free(
 	 &error );
 
-	result = libvsapm_volume_get_number_of_partitions(
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvsapm_volume_get_number_of_unallocated_ranges function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_volume_get_number_of_unallocated_ranges(
+     libvsapm_volume_t *volume )
+{
+	libcerror_error_t *error         = NULL;
+	int number_of_unallocated_ranges = 0;
+	int result                       = 0;
+
+	/* Test regular cases
+	 */
+	result = libvsapm_volume_get_number_of_unallocated_ranges(
+	          volume,
+	          &number_of_unallocated_ranges,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvsapm_volume_get_number_of_unallocated_ranges(
+	          NULL,
+	          &number_of_unallocated_ranges,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_volume_get_number_of_unallocated_ranges(
 	          volume,
 	          NULL,
 	          &error );
@@ -1382,22 +5105,22 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libvsapm_volume_get_partition_by_index function
+/* Tests the libvsapm_volume_get_unallocated_range_by_index function
  * Returns 1 if successful or 0 if not
  */
-int vsapm_test_volume_get_partition_by_index(
+int vsapm_test_volume_get_unallocated_range_by_index(
      libvsapm_volume_t *volume )
 {
-	libcerror_error_t *error                 = NULL;
-	libvsapm_partition_t *partition_by_index = 0;
-	int number_of_partitions                 = 0;
-	int result                               = 0;
+	libcerror_error_t *error                = NULL;
+	libvsapm_partition_t *unallocated_range = NULL;
+	int number_of_unallocated_ranges        = 0;
+	int result                              = 0;
 
 	/* Test regular cases
 	 */
-	result = libvsapm_volume_get_number_of_partitions(
+	result = libvsapm_volume_get_number_of_unallocated_ranges(
 	          volume,
-	          &number_of_partitions,
+	          &number_of_unallocated_ranges,
 	          &error );
 
 	VSAPM_TEST_ASSERT_EQUAL_INT(
@@ -1409,14 +5132,14 @@ int vsapm_test_volume_get_partition_by_index(
 	 "error",
 	 error );
 
-	if( number_of_partitions == 0 )
+	if( number_of_unallocated_ranges == 0 )
 	{
 		return( 1 );
 	}
-	result = libvsapm_volume_get_partition_by_index(
+	result = libvsapm_volume_get_unallocated_range_by_index(
 	          volume,
 	          0,
-	          &partition_by_index,
+	          &unallocated_range,
 	          &error );
 
 	VSAPM_TEST_ASSERT_EQUAL_INT(
@@ -1429,11 +5152,11 @@ int vsapm_test_volume_get_partition_by_index(
 	 error );
 
 	VSAPM_TEST_ASSERT_IS_NOT_NULL(
-	 "partition_by_index",
-	 partition_by_index );
+	 "unallocated_range",
+	 unallocated_range );
 
 	result = libvsapm_partition_free(
-	          &partition_by_index,
+	          &unallocated_range,
 	          &error );
 
 	VSAPM_TEST_ASSERT_EQUAL_INT(
@@ -1447,10 +5170,10 @@ int vsapm_test_volume_get_partition_by_index(
 
 	/* Test error cases
 	 */
-	result = libvsapm_volume_get_partition_by_index(
+	result = libvsapm_volume_get_unallocated_range_by_index(
 	          NULL,
 	          0,
-	          &partition_by_index,
+	          &unallocated_range,
 	          &error );
 
 	VSAPM_TEST_ASSERT_EQUAL_INT(
@@ -1459,8 +5182,8 @@ int vsapm_test_volume_get_partition_by_index(
 	 -1 );
 
 	VSAPM_TEST_ASSERT_IS_NULL(
-	 "partition_by_index",
-	 partition_by_index );
+	 "unallocated_range",
+	 unallocated_range );
 
 	VSAPM_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -1469,10 +5192,10 @@ int vsapm_test_volume_get_partition_by_index(
 	libcerror_error_free(
 	 &error );
 
-	result = libvsapm_volume_get_partition_by_index(
+	result = libvsapm_volume_get_unallocated_range_by_index(
 	          volume,
 	          -1,
-	          &partition_by_index,
+	          &unallocated_range,
 	          &error );
 
 	VSAPM_TEST_ASSERT_EQUAL_INT(
@@ -1481,8 +5204,8 @@ int vsapm_test_volume_get_partition_by_index(
 	 -1 );
 
 	VSAPM_TEST_ASSERT_IS_NULL(
-	 "partition_by_index",
-	 partition_by_index );
+	 "unallocated_range",
+	 unallocated_range );
 
 	VSAPM_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -1491,7 +5214,7 @@ int vsapm_test_volume_get_partition_by_index(
 	libcerror_error_free(
 	 &error );
 
-	result = libvsapm_volume_get_partition_by_index(
+	result = libvsapm_volume_get_unallocated_range_by_index(
 	          volume,
 	          0,
 	          NULL,
@@ -1503,8 +5226,176 @@ int vsapm_test_volume_get_partition_by_index(
 	 -1 );
 
 	VSAPM_TEST_ASSERT_IS_NULL(
-	 "partition_by_index",
-	 partition_by_index );
+	 "unallocated_range",
+	 unallocated_range );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvsapm_volume_get_partition_index_by_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_volume_get_partition_index_by_offset(
+     libvsapm_volume_t *volume )
+{
+	libcerror_error_t *error        = NULL;
+	libvsapm_partition_t *partition = NULL;
+	off64_t volume_offset           = 0;
+	int number_of_partitions        = 0;
+	int partition_index             = 0;
+	int result                      = 0;
+
+	/* Test regular cases
+	 */
+	result = libvsapm_volume_get_number_of_partitions(
+	          volume,
+	          &number_of_partitions,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( number_of_partitions == 0 )
+	{
+		return( 1 );
+	}
+	result = libvsapm_volume_get_partition_by_index(
+	          volume,
+	          0,
+	          &partition,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "partition",
+	 partition );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_partition_get_volume_offset(
+	          partition,
+	          &volume_offset,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_partition_free(
+	          &partition,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvsapm_volume_get_partition_index_by_offset(
+	          volume,
+	          volume_offset,
+	          &partition_index,
+	          &error );
+
+	VSAPM_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( result != 0 )
+	{
+		VSAPM_TEST_ASSERT_LESS_THAN_INT(
+		 "partition_index",
+		 partition_index,
+		 number_of_partitions );
+	}
+	/* Test error cases
+	 */
+	result = libvsapm_volume_get_partition_index_by_offset(
+	          NULL,
+	          volume_offset,
+	          &partition_index,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_volume_get_partition_index_by_offset(
+	          volume,
+	          -1,
+	          &partition_index,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_volume_get_partition_index_by_offset(
+	          volume,
+	          volume_offset,
+	          NULL,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	VSAPM_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -1521,6 +5412,12 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( partition != NULL )
+	{
+		libvsapm_partition_free(
+		 &partition,
+		 NULL );
+	}
 	return( 0 );
 }
 
@@ -1581,6 +5478,42 @@ int main(
 	 "libvsapm_volume_free",
 	 vsapm_test_volume_free );
 
+	VSAPM_TEST_RUN(
+	 "libvsapm_volume_set_maximum_number_of_partition_map_entries",
+	 vsapm_test_volume_set_maximum_number_of_partition_map_entries );
+
+	VSAPM_TEST_RUN(
+	 "libvsapm_volume_set_maximum_partition_map_size",
+	 vsapm_test_volume_set_maximum_partition_map_size );
+
+	VSAPM_TEST_RUN(
+	 "libvsapm_volume_set_sector_cache_size",
+	 vsapm_test_volume_set_sector_cache_size );
+
+	VSAPM_TEST_RUN(
+	 "libvsapm_volume_set_read_partition_map_on_demand",
+	 vsapm_test_volume_set_read_partition_map_on_demand );
+
+	VSAPM_TEST_RUN(
+	 "libvsapm_volume_open_memory",
+	 vsapm_test_volume_open_memory );
+
+	VSAPM_TEST_RUN(
+	 "libvsapm_volume_open_file_io_pool",
+	 vsapm_test_volume_open_file_io_pool );
+
+	VSAPM_TEST_RUN(
+	 "libvsapm_volume_poll_completions",
+	 vsapm_test_volume_poll_completions );
+
+	VSAPM_TEST_RUN(
+	 "libvsapm_volume_scan",
+	 vsapm_test_volume_scan );
+
+	VSAPM_TEST_RUN(
+	 "libvsapm_volume_freeze",
+	 vsapm_test_volume_freeze );
+
 #if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
 	if( source != NULL )
 	{
@@ -1669,6 +5602,23 @@ int main(
 		 vsapm_test_volume_open_close,
 		 source );
 
+		VSAPM_TEST_RUN_WITH_ARGS(
+		 "libvsapm_volume_open_read_partition_map_on_demand",
+		 vsapm_test_volume_open_read_partition_map_on_demand,
+		 source );
+
+		VSAPM_TEST_RUN_WITH_ARGS(
+		 "libvsapm_volume_open_with_access_flags",
+		 vsapm_test_volume_open_with_access_flags,
+		 source,
+		 LIBVSAPM_ACCESS_FLAG_ASYNCHRONOUS_IO );
+
+		VSAPM_TEST_RUN_WITH_ARGS(
+		 "libvsapm_volume_open_with_access_flags",
+		 vsapm_test_volume_open_with_access_flags,
+		 source,
+		 LIBVSAPM_ACCESS_FLAG_DIRECT_IO );
+
 		/* Initialize volume for tests
 		 */
 		result = vsapm_test_volume_open_source(
@@ -1717,6 +5667,21 @@ int main(
 		 vsapm_test_volume_get_partition_by_index,
 		 volume );
 
+		VSAPM_TEST_RUN_WITH_ARGS(
+		 "libvsapm_volume_get_partition_index_by_offset",
+		 vsapm_test_volume_get_partition_index_by_offset,
+		 volume );
+
+		VSAPM_TEST_RUN_WITH_ARGS(
+		 "libvsapm_volume_get_number_of_unallocated_ranges",
+		 vsapm_test_volume_get_number_of_unallocated_ranges,
+		 volume );
+
+		VSAPM_TEST_RUN_WITH_ARGS(
+		 "libvsapm_volume_get_unallocated_range_by_index",
+		 vsapm_test_volume_get_unallocated_range_by_index,
+		 volume );
+
 		/* Clean up
 		 */
 		result = vsapm_test_volume_close_source(
@@ -0,0 +1,212 @@
+/*
+ * Library zero block functions test program
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vsapm_test_libcerror.h"
+#include "vsapm_test_libvsapm.h"
+#include "vsapm_test_macros.h"
+#include "vsapm_test_unused.h"
+
+#include "../libvsapm/libvsapm_zero_block.h"
+
+#if defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT )
+
+/* Tests the libvsapm_zero_block_check function
+ * Returns 1 if successful or 0 if not
+ */
+int vsapm_test_zero_block_check(
+     void )
+{
+	uint8_t data[ 1024 ];
+
+	libcerror_error_t *error = NULL;
+	size_t data_offset       = 0;
+	size_t data_size         = 0;
+	size_t non_zero_offset   = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = memory_set(
+	          data,
+	          0,
+	          1024 ) != NULL;
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test regular cases
+	 * Different offsets and sizes are used to cover the unaligned head,
+	 * the vectorized bulk and the tail of the data
+	 */
+	for( data_offset = 0;
+	     data_offset < 64;
+	     data_offset++ )
+	{
+		for( data_size = 0;
+		     data_size <= 512;
+		     data_size += 31 )
+		{
+			result = libvsapm_zero_block_check(
+			          &( data[ data_offset ] ),
+			          data_size,
+			          &error );
+
+			VSAPM_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			VSAPM_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			for( non_zero_offset = 0;
+			     non_zero_offset < data_size;
+			     non_zero_offset += 17 )
+			{
+				data[ data_offset + non_zero_offset ] = 0x80;
+
+				result = libvsapm_zero_block_check(
+				          &( data[ data_offset ] ),
+				          data_size,
+				          &error );
+
+				data[ data_offset + non_zero_offset ] = 0;
+
+				VSAPM_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 0 );
+
+				VSAPM_TEST_ASSERT_IS_NULL(
+				 "error",
+				 error );
+			}
+			/* Test that the bytes surrounding the data are not checked
+			 */
+			data[ data_offset + data_size ] = 0xff;
+
+			result = libvsapm_zero_block_check(
+			          &( data[ data_offset ] ),
+			          data_size,
+			          &error );
+
+			data[ data_offset + data_size ] = 0;
+
+			VSAPM_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			VSAPM_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+	}
+	/* Test error cases
+	 */
+	result = libvsapm_zero_block_check(
+	          NULL,
+	          1024,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvsapm_zero_block_check(
+	          data,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	VSAPM_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSAPM_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VSAPM_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VSAPM_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VSAPM_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VSAPM_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VSAPM_TEST_UNREFERENCED_PARAMETER( argc )
+	VSAPM_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT )
+
+	VSAPM_TEST_RUN(
+	 "libvsapm_zero_block_check",
+	 vsapm_test_zero_block_check );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSAPM_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,1565 @@
+/*
+ * Batch handle
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "batch_handle.h"
+#include "info_handle.h"
+#include "vsapmtools_libcerror.h"
+#include "vsapmtools_libcthreads.h"
+
+#define BATCH_HANDLE_OUTPUT_STREAM		stdout
+
+#define BATCH_HANDLE_MAXIMUM_SOURCE_LENGTH	8192
+
+/* Creates a batch handle
+ * Make sure the value batch_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int batch_handle_initialize(
+     batch_handle_t **batch_handle,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "batch_handle_initialize";
+	size_t results_size   = 0;
+
+	if( batch_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *batch_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid batch handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > BATCH_HANDLE_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*batch_handle = memory_allocate_structure(
+	                 batch_handle_t );
+
+	if( *batch_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create batch handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *batch_handle,
+	     0,
+	     sizeof( batch_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear batch handle.",
+		 function );
+
+		memory_free(
+		 *batch_handle );
+
+		*batch_handle = NULL;
+
+		return( -1 );
+	}
+#if !defined( HAVE_MULTI_THREAD_SUPPORT )
+	number_of_threads = 1;
+#endif
+	( *batch_handle )->output_format             = INFO_HANDLE_OUTPUT_FORMAT_TEXT;
+	( *batch_handle )->number_of_threads         = number_of_threads;
+	( *batch_handle )->output_stream             = BATCH_HANDLE_OUTPUT_STREAM;
+	( *batch_handle )->maximum_number_of_results = number_of_threads * BATCH_HANDLE_MAXIMUM_NUMBER_OF_PENDING_RESULTS_PER_THREAD;
+
+	results_size = sizeof( char * ) * ( *batch_handle )->maximum_number_of_results;
+
+	( *batch_handle )->results = (char **) memory_allocate(
+	                                        results_size );
+
+	if( ( *batch_handle )->results == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create results.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *batch_handle )->results,
+	     0,
+	     results_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear results.",
+		 function );
+
+		goto on_error;
+	}
+	results_size = sizeof( size_t ) * ( *batch_handle )->maximum_number_of_results;
+
+	( *batch_handle )->result_sizes = (size_t *) memory_allocate(
+	                                              results_size );
+
+	if( ( *batch_handle )->result_sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create result sizes.",
+		 function );
+
+		goto on_error;
+	}
+	results_size = sizeof( uint8_t ) * ( *batch_handle )->maximum_number_of_results;
+
+	( *batch_handle )->result_is_set = (uint8_t *) memory_allocate(
+	                                                results_size );
+
+	if( ( *batch_handle )->result_is_set == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create result is set values.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *batch_handle )->result_is_set,
+	     0,
+	     results_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear result is set values.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *batch_handle )->result_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize result mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *batch_handle )->result_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize result condition.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *batch_handle != NULL )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *batch_handle )->result_mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *batch_handle )->result_mutex ),
+			 NULL );
+		}
+#endif
+		if( ( *batch_handle )->result_is_set != NULL )
+		{
+			memory_free(
+			 ( *batch_handle )->result_is_set );
+		}
+		if( ( *batch_handle )->result_sizes != NULL )
+		{
+			memory_free(
+			 ( *batch_handle )->result_sizes );
+		}
+		if( ( *batch_handle )->results != NULL )
+		{
+			memory_free(
+			 ( *batch_handle )->results );
+		}
+		memory_free(
+		 *batch_handle );
+
+		*batch_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a batch handle
+ * Returns 1 if successful or -1 on error
+ */
+int batch_handle_free(
+     batch_handle_t **batch_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "batch_handle_free";
+	int result            = 1;
+	int result_index      = 0;
+
+	if( batch_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *batch_handle != NULL )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *batch_handle )->process_thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *batch_handle )->process_thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join process thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libcthreads_condition_free(
+		     &( ( *batch_handle )->result_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free result condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *batch_handle )->result_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free result mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		for( result_index = 0;
+		     result_index < ( *batch_handle )->maximum_number_of_results;
+		     result_index++ )
+		{
+			if( ( *batch_handle )->results[ result_index ] != NULL )
+			{
+				memory_free(
+				 ( *batch_handle )->results[ result_index ] );
+			}
+		}
+		memory_free(
+		 ( *batch_handle )->result_is_set );
+
+		memory_free(
+		 ( *batch_handle )->result_sizes );
+
+		memory_free(
+		 ( *batch_handle )->results );
+
+		memory_free(
+		 *batch_handle );
+
+		*batch_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the batch handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int batch_handle_signal_abort(
+     batch_handle_t *batch_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "batch_handle_signal_abort";
+
+	if( batch_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch handle.",
+		 function );
+
+		return( -1 );
+	}
+	batch_handle->abort = 1;
+
+	return( 1 );
+}
+
+/* Sets the bytes per sector string that is applied to every source
+ * The string is not copied and must remain valid while the batch handle is used
+ * Returns 1 if successful or -1 on error
+ */
+int batch_handle_set_bytes_per_sector(
+     batch_handle_t *batch_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "batch_handle_set_bytes_per_sector";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( batch_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	/* Validate the value here so that it does not fail for every source
+	 */
+	if( vsapmtools_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( value_64bit != 512 )
+	 && ( value_64bit != 1024 )
+	 && ( value_64bit != 2048 )
+	 && ( value_64bit != 4096 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported bytes per sector value.",
+		 function );
+
+		return( -1 );
+	}
+	batch_handle->bytes_per_sector_string = string;
+
+	return( 1 );
+}
+
+/* Sets the output format
+ * Returns 1 if successful or -1 on error
+ */
+int batch_handle_set_output_format(
+     batch_handle_t *batch_handle,
+     int output_format,
+     libcerror_error_t **error )
+{
+	static char *function = "batch_handle_set_output_format";
+
+	if( batch_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( output_format != INFO_HANDLE_OUTPUT_FORMAT_JSON )
+	 && ( output_format != INFO_HANDLE_OUTPUT_FORMAT_TEXT ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported output format.",
+		 function );
+
+		return( -1 );
+	}
+	batch_handle->output_format = output_format;
+
+	return( 1 );
+}
+
+/* Starts the worker threads
+ * Returns 1 if successful or -1 on error
+ */
+int batch_handle_start(
+     batch_handle_t *batch_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "batch_handle_start";
+
+	if( batch_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( batch_handle->process_thread_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid batch handle - process thread pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_thread_pool_create(
+	     &( batch_handle->process_thread_pool ),
+	     NULL,
+	     batch_handle->number_of_threads,
+	     batch_handle->maximum_number_of_results,
+	     (int (*)(intptr_t *, void *)) &batch_handle_process_source_callback,
+	     (void *) batch_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create process thread pool.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Stops the worker threads and prints the remaining results
+ * Returns 1 if successful or -1 on error
+ */
+int batch_handle_stop(
+     batch_handle_t *batch_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "batch_handle_stop";
+
+	if( batch_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( batch_handle->process_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( batch_handle->process_thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join process thread pool.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	while( batch_handle->next_result_index < batch_handle->next_source_index )
+	{
+		if( batch_handle_print_results(
+		     batch_handle,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print results.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Frees a batch source
+ * Returns 1 if successful or -1 on error
+ */
+int batch_handle_source_free(
+     batch_handle_source_t **batch_source,
+     libcerror_error_t **error )
+{
+	static char *function = "batch_handle_source_free";
+
+	if( batch_source == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch source.",
+		 function );
+
+		return( -1 );
+	}
+	if( *batch_source != NULL )
+	{
+		if( ( *batch_source )->source != NULL )
+		{
+			memory_free(
+			 ( *batch_source )->source );
+		}
+		memory_free(
+		 *batch_source );
+
+		*batch_source = NULL;
+	}
+	return( 1 );
+}
+
+/* Pushes a source to be processed
+ * Blocks while the maximum number of results is pending and prints results in source order
+ * Returns 1 if successful or -1 on error
+ */
+int batch_handle_push_source(
+     batch_handle_t *batch_handle,
+     const system_character_t *source,
+     size_t source_length,
+     libcerror_error_t **error )
+{
+	batch_handle_source_t *batch_source = NULL;
+	static char *function               = "batch_handle_push_source";
+
+	if( batch_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( source == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( source_length == 0 )
+	 || ( source_length > (size_t) BATCH_HANDLE_MAXIMUM_SOURCE_LENGTH ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid source length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* Make sure the reorder buffer has room for the result of this source
+	 */
+	while( ( batch_handle->next_source_index - batch_handle->next_result_index ) >= batch_handle->maximum_number_of_results )
+	{
+		if( batch_handle_print_results(
+		     batch_handle,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print results.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	batch_source = memory_allocate_structure(
+	                batch_handle_source_t );
+
+	if( batch_source == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create batch source.",
+		 function );
+
+		goto on_error;
+	}
+	batch_source->source_index = batch_handle->next_source_index;
+	batch_source->source       = system_string_allocate(
+	                              source_length + 1 );
+
+	if( batch_source->source == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create source.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     batch_source->source,
+	     source,
+	     source_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy source.",
+		 function );
+
+		goto on_error;
+	}
+	batch_source->source[ source_length ] = 0;
+
+	batch_handle->next_source_index += 1;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_thread_pool_push(
+	     batch_handle->process_thread_pool,
+	     (intptr_t *) batch_source,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push source onto process thread pool queue.",
+		 function );
+
+		batch_handle->next_source_index -= 1;
+
+		goto on_error;
+	}
+	batch_source = NULL;
+#else
+	if( batch_handle_process_source_callback(
+	     batch_source,
+	     batch_handle ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to process source.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	/* Print the results that are available without waiting
+	 */
+	if( batch_handle_print_results(
+	     batch_handle,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print results.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( batch_source != NULL )
+	{
+		batch_handle_source_free(
+		 &batch_source,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Pushes the sources read from a stream, one per line
+ * Returns 1 if successful or -1 on error
+ */
+int batch_handle_push_sources_from_stream(
+     batch_handle_t *batch_handle,
+     FILE *stream,
+     libcerror_error_t **error )
+{
+	system_character_t source[ BATCH_HANDLE_MAXIMUM_SOURCE_LENGTH + 2 ];
+
+	static char *function = "batch_handle_push_sources_from_stream";
+	size_t source_length  = 0;
+
+	if( batch_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	while( batch_handle->abort == 0 )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( file_stream_get_string_wide(
+		     stream,
+		     source,
+		     BATCH_HANDLE_MAXIMUM_SOURCE_LENGTH + 2 ) == NULL )
+#else
+		if( file_stream_get_string(
+		     stream,
+		     source,
+		     BATCH_HANDLE_MAXIMUM_SOURCE_LENGTH + 2 ) == NULL )
+#endif
+		{
+			break;
+		}
+		source_length = system_string_length(
+		                 source );
+
+		while( ( source_length > 0 )
+		    && ( ( source[ source_length - 1 ] == (system_character_t) '\n' )
+		      || ( source[ source_length - 1 ] == (system_character_t) '\r' ) ) )
+		{
+			source_length--;
+		}
+		source[ source_length ] = 0;
+
+		if( source_length == 0 )
+		{
+			continue;
+		}
+		if( batch_handle_push_source(
+		     batch_handle,
+		     source,
+		     source_length,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push source.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Processes a source and writes its information into an output buffer
+ * The output buffer is allocated by this function and must be freed with memory_free
+ * Returns 1 if successful, 0 if the source could not be processed or -1 on error
+ */
+int batch_handle_process_source(
+     batch_handle_t *batch_handle,
+     const system_character_t *source,
+     char **output,
+     size_t *output_size,
+     libcerror_error_t **error )
+{
+	char error_string[ 512 ];
+
+	info_handle_t *info_handle        = NULL;
+	libcerror_error_t *process_error  = NULL;
+	FILE *output_stream               = NULL;
+	char *stream_data                 = NULL;
+	static char *function             = "batch_handle_process_source";
+	size_t stream_data_size           = 0;
+	int result                        = 1;
+
+#if !defined( HAVE_OPEN_MEMSTREAM )
+	off64_t stream_offset             = 0;
+#endif
+
+	if( batch_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( output == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_OPEN_MEMSTREAM )
+	output_stream = open_memstream(
+	                 &stream_data,
+	                 &stream_data_size );
+#else
+	output_stream = tmpfile();
+#endif
+	if( output_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open output stream.",
+		 function );
+
+		goto on_error;
+	}
+	if( info_handle_initialize(
+	     &info_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize info handle.",
+		 function );
+
+		goto on_error;
+	}
+	info_handle->notify_stream = output_stream;
+
+	if( batch_handle->bytes_per_sector_string != NULL )
+	{
+		if( info_handle_set_bytes_per_sector(
+		     info_handle,
+		     batch_handle->bytes_per_sector_string,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set bytes per sector.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( batch_handle->output_format == INFO_HANDLE_OUTPUT_FORMAT_TEXT )
+	{
+		fprintf(
+		 output_stream,
+		 "Source\t\t\t\t: %" PRIs_SYSTEM "\n",
+		 source );
+	}
+	if( batch_handle->abort != 0 )
+	{
+		result = 0;
+	}
+	else if( info_handle_open_input(
+	          info_handle,
+	          source,
+	          &process_error ) != 1 )
+	{
+		result = 0;
+	}
+	else
+	{
+		if( batch_handle->output_format == INFO_HANDLE_OUTPUT_FORMAT_JSON )
+		{
+			result = info_handle_partitions_json_fprint(
+			          info_handle,
+			          source,
+			          &process_error );
+		}
+		else
+		{
+			result = info_handle_partitions_fprint(
+			          info_handle,
+			          &process_error );
+		}
+		if( result != 1 )
+		{
+			result = 0;
+		}
+		if( info_handle_close_input(
+		     info_handle,
+		     ( process_error == NULL ) ? &process_error : NULL ) != 0 )
+		{
+			result = 0;
+		}
+	}
+	if( result == 0 )
+	{
+		if( batch_handle->output_format == INFO_HANDLE_OUTPUT_FORMAT_JSON )
+		{
+			info_handle_json_error_fprint(
+			 source,
+			 process_error,
+			 output_stream );
+		}
+		else
+		{
+			error_string[ 0 ] = 0;
+
+			if( process_error != NULL )
+			{
+				if( libcerror_error_sprint(
+				     process_error,
+				     error_string,
+				     512 ) <= 0 )
+				{
+					error_string[ 0 ] = 0;
+				}
+			}
+			fprintf(
+			 output_stream,
+			 "Unable to process source: %s\n\n",
+			 error_string );
+		}
+		if( process_error != NULL )
+		{
+			libcerror_error_free(
+			 &process_error );
+		}
+	}
+	if( info_handle_free(
+	     &info_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free info handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_OPEN_MEMSTREAM )
+	if( file_stream_close(
+	     output_stream ) != 0 )
+	{
+		output_stream = NULL;
+
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close output stream.",
+		 function );
+
+		goto on_error;
+	}
+	output_stream = NULL;
+#else
+	stream_offset = ftello(
+	                 output_stream );
+
+	if( ( stream_offset < 0 )
+	 || ( (uint64_t) stream_offset >= (uint64_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: invalid output stream offset value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	stream_data_size = (size_t) stream_offset;
+
+	stream_data = (char *) memory_allocate(
+	                        sizeof( char ) * ( stream_data_size + 1 ) );
+
+	if( stream_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create output data.",
+		 function );
+
+		goto on_error;
+	}
+	if( file_stream_seek_offset(
+	     output_stream,
+	     0,
+	     SEEK_SET ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek start of output stream.",
+		 function );
+
+		goto on_error;
+	}
+	if( file_stream_read(
+	     output_stream,
+	     stream_data,
+	     stream_data_size ) != stream_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read output stream.",
+		 function );
+
+		goto on_error;
+	}
+	stream_data[ stream_data_size ] = 0;
+
+	file_stream_close(
+	 output_stream );
+
+	output_stream = NULL;
+#endif /* defined( HAVE_OPEN_MEMSTREAM ) */
+
+	*output      = stream_data;
+	*output_size = stream_data_size;
+
+	return( result );
+
+on_error:
+	if( process_error != NULL )
+	{
+		libcerror_error_free(
+		 &process_error );
+	}
+	if( info_handle != NULL )
+	{
+		info_handle_free(
+		 &info_handle,
+		 NULL );
+	}
+	if( output_stream != NULL )
+	{
+		file_stream_close(
+		 output_stream );
+	}
+	if( stream_data != NULL )
+	{
+		memory_free(
+		 stream_data );
+	}
+	return( -1 );
+}
+
+/* Callback function to process a source
+ * Returns 1 if successful or -1 on error
+ */
+int batch_handle_process_source_callback(
+     batch_handle_source_t *batch_source,
+     batch_handle_t *batch_handle )
+{
+	libcerror_error_t *error = NULL;
+	char *output             = NULL;
+	static char *function    = "batch_handle_process_source_callback";
+	size_t output_size       = 0;
+	int result               = 0;
+
+	if( batch_source == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch source.",
+		 function );
+
+		goto on_error;
+	}
+	result = batch_handle_process_source(
+	          batch_handle,
+	          batch_source->source,
+	          &output,
+	          &output_size,
+	          &error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to process source: %" PRIs_SYSTEM ".",
+		 function,
+		 batch_source->source );
+
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+
+		libcerror_error_free(
+		 &error );
+	}
+	/* Always set a result so the results that follow in source order can be printed
+	 */
+	if( batch_handle_set_result(
+	     batch_handle,
+	     batch_source->source_index,
+	     output,
+	     output_size,
+	     result,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set result.",
+		 function );
+
+		goto on_error;
+	}
+	output = NULL;
+
+	if( batch_handle_source_free(
+	     &batch_source,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free batch source.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+
+		libcerror_error_free(
+		 &error );
+	}
+	if( output != NULL )
+	{
+		memory_free(
+		 output );
+	}
+	if( batch_source != NULL )
+	{
+		batch_handle_source_free(
+		 &batch_source,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Sets the result of a source in the reorder buffer
+ * The batch handle takes over ownership of the output
+ * Returns 1 if successful or -1 on error
+ */
+int batch_handle_set_result(
+     batch_handle_t *batch_handle,
+     int source_index,
+     char *output,
+     size_t output_size,
+     int result,
+     libcerror_error_t **error )
+{
+	static char *function = "batch_handle_set_result";
+	int result_index      = 0;
+
+	if( batch_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_index < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid source index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	result_index = source_index % batch_handle->maximum_number_of_results;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     batch_handle->result_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab result mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	batch_handle->results[ result_index ]       = output;
+	batch_handle->result_sizes[ result_index ]  = output_size;
+	batch_handle->result_is_set[ result_index ] = 1;
+
+	if( result != 1 )
+	{
+		batch_handle->number_of_failed_sources += 1;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_condition_broadcast(
+	     batch_handle->result_condition,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast result condition.",
+		 function );
+
+		libcthreads_mutex_release(
+		 batch_handle->result_mutex,
+		 NULL );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_release(
+	     batch_handle->result_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release result mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Prints the results that are available in source order
+ * If wait_for_result is set, waits until the next result in source order is available
+ * Returns 1 if successful or -1 on error
+ */
+int batch_handle_print_results(
+     batch_handle_t *batch_handle,
+     int wait_for_result,
+     libcerror_error_t **error )
+{
+	char *output          = NULL;
+	static char *function = "batch_handle_print_results";
+	size_t output_size    = 0;
+	uint8_t result_is_set = 0;
+	int result_index      = 0;
+
+	if( batch_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch handle.",
+		 function );
+
+		return( -1 );
+	}
+	while( batch_handle->next_result_index < batch_handle->next_source_index )
+	{
+		result_index = batch_handle->next_result_index % batch_handle->maximum_number_of_results;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     batch_handle->result_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to grab result mutex.",
+			 function );
+
+			return( -1 );
+		}
+		while( ( wait_for_result != 0 )
+		    && ( batch_handle->result_is_set[ result_index ] == 0 ) )
+		{
+			if( libcthreads_condition_wait(
+			     batch_handle->result_condition,
+			     batch_handle->result_mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to wait for result condition.",
+				 function );
+
+				libcthreads_mutex_release(
+				 batch_handle->result_mutex,
+				 NULL );
+
+				return( -1 );
+			}
+		}
+#endif
+		result_is_set = batch_handle->result_is_set[ result_index ];
+
+		if( result_is_set != 0 )
+		{
+			output      = batch_handle->results[ result_index ];
+			output_size = batch_handle->result_sizes[ result_index ];
+
+			batch_handle->results[ result_index ]       = NULL;
+			batch_handle->result_sizes[ result_index ]  = 0;
+			batch_handle->result_is_set[ result_index ] = 0;
+
+			batch_handle->next_result_index += 1;
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     batch_handle->result_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to release result mutex.",
+			 function );
+
+			if( output != NULL )
+			{
+				memory_free(
+				 output );
+			}
+			return( -1 );
+		}
+#endif
+		if( result_is_set == 0 )
+		{
+			break;
+		}
+		/* Only wait for the first result, print the others if they are available
+		 */
+		wait_for_result = 0;
+
+		/* A result without output is set if the source could not be processed
+		 */
+		if( output == NULL )
+		{
+			continue;
+		}
+		if( output_size > 0 )
+		{
+			if( file_stream_write(
+			     batch_handle->output_stream,
+			     output,
+			     output_size ) != output_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write result.",
+				 function );
+
+				memory_free(
+				 output );
+
+				return( -1 );
+			}
+		}
+		memory_free(
+		 output );
+
+		output = NULL;
+	}
+	return( 1 );
+}
+
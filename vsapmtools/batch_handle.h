@@ -0,0 +1,199 @@
+/*
+ * Batch handle
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _BATCH_HANDLE_H )
+#define _BATCH_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "vsapmtools_libcerror.h"
+#include "vsapmtools_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The maximum number of results that can be pending per thread
+ */
+#define BATCH_HANDLE_MAXIMUM_NUMBER_OF_PENDING_RESULTS_PER_THREAD	4
+
+/* The maximum number of threads
+ */
+#define BATCH_HANDLE_MAXIMUM_NUMBER_OF_THREADS				64
+
+typedef struct batch_handle batch_handle_t;
+
+struct batch_handle
+{
+	/* The bytes per sector string
+	 */
+	const system_character_t *bytes_per_sector_string;
+
+	/* The output format
+	 */
+	int output_format;
+
+	/* The number of threads
+	 */
+	int number_of_threads;
+
+	/* The output stream
+	 */
+	FILE *output_stream;
+
+	/* The maximum number of pending results
+	 */
+	int maximum_number_of_results;
+
+	/* The results, which are indexed by source index modulo the maximum number of results
+	 */
+	char **results;
+
+	/* The sizes of the results
+	 */
+	size_t *result_sizes;
+
+	/* Values to indicate a result is set
+	 */
+	uint8_t *result_is_set;
+
+	/* The index of the next source
+	 */
+	int next_source_index;
+
+	/* The index of the next result to print
+	 */
+	int next_result_index;
+
+	/* The number of sources that could not be processed
+	 */
+	int number_of_failed_sources;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The process thread pool
+	 */
+	libcthreads_thread_pool_t *process_thread_pool;
+
+	/* The result mutex
+	 */
+	libcthreads_mutex_t *result_mutex;
+
+	/* The result set condition
+	 */
+	libcthreads_condition_t *result_condition;
+#endif
+};
+
+typedef struct batch_handle_source batch_handle_source_t;
+
+struct batch_handle_source
+{
+	/* The index of the source
+	 */
+	int source_index;
+
+	/* The source
+	 */
+	system_character_t *source;
+};
+
+int batch_handle_initialize(
+     batch_handle_t **batch_handle,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int batch_handle_free(
+     batch_handle_t **batch_handle,
+     libcerror_error_t **error );
+
+int batch_handle_signal_abort(
+     batch_handle_t *batch_handle,
+     libcerror_error_t **error );
+
+int batch_handle_set_bytes_per_sector(
+     batch_handle_t *batch_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int batch_handle_set_output_format(
+     batch_handle_t *batch_handle,
+     int output_format,
+     libcerror_error_t **error );
+
+int batch_handle_start(
+     batch_handle_t *batch_handle,
+     libcerror_error_t **error );
+
+int batch_handle_stop(
+     batch_handle_t *batch_handle,
+     libcerror_error_t **error );
+
+int batch_handle_source_free(
+     batch_handle_source_t **batch_source,
+     libcerror_error_t **error );
+
+int batch_handle_push_source(
+     batch_handle_t *batch_handle,
+     const system_character_t *source,
+     size_t source_length,
+     libcerror_error_t **error );
+
+int batch_handle_push_sources_from_stream(
+     batch_handle_t *batch_handle,
+     FILE *stream,
+     libcerror_error_t **error );
+
+int batch_handle_process_source(
+     batch_handle_t *batch_handle,
+     const system_character_t *source,
+     char **output,
+     size_t *output_size,
+     libcerror_error_t **error );
+
+int batch_handle_process_source_callback(
+     batch_handle_source_t *batch_source,
+     batch_handle_t *batch_handle );
+
+int batch_handle_set_result(
+     batch_handle_t *batch_handle,
+     int source_index,
+     char *output,
+     size_t output_size,
+     int result,
+     libcerror_error_t **error );
+
+int batch_handle_print_results(
+     batch_handle_t *batch_handle,
+     int wait_for_result,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _BATCH_HANDLE_H ) */
+
@@ -0,0 +1,1736 @@
+/*
+ * Export handle
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_SYS_SENDFILE_H )
+#include <sys/sendfile.h>
+#endif
+
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "export_handle.h"
+#include "info_handle.h"
+#include "vsapmtools_libcerror.h"
+#include "vsapmtools_libcthreads.h"
+#include "vsapmtools_libvsapm.h"
+
+#define EXPORT_HANDLE_NOTIFY_STREAM	stdout
+
+/* Creates an export handle
+ * Make sure the value export_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_initialize(
+     export_handle_t **export_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_initialize";
+	int buffer_index      = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *export_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*export_handle = memory_allocate_structure(
+	                  export_handle_t );
+
+	if( *export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create export handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *export_handle,
+	     0,
+	     sizeof( export_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear export handle.",
+		 function );
+
+		memory_free(
+		 *export_handle );
+
+		*export_handle = NULL;
+
+		return( -1 );
+	}
+	if( libvsapm_volume_initialize(
+	     &( ( *export_handle )->input_volume ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input handle.",
+		 function );
+
+		goto on_error;
+	}
+	for( buffer_index = 0;
+	     buffer_index < 2;
+	     buffer_index++ )
+	{
+		( *export_handle )->buffers[ buffer_index ].data = (uint8_t *) memory_allocate(
+		                                                                sizeof( uint8_t ) * EXPORT_HANDLE_BUFFER_SIZE );
+
+		if( ( *export_handle )->buffers[ buffer_index ].data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create buffer: %d.",
+			 function,
+			 buffer_index );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *export_handle )->buffers_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize buffers mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *export_handle )->buffers_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize buffers condition.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *export_handle )->bytes_per_sector   = 512;
+	( *export_handle )->input_descriptor   = -1;
+	( *export_handle )->output_descriptor  = -1;
+	( *export_handle )->use_kernel_copy    = 1;
+	( *export_handle )->notify_stream      = EXPORT_HANDLE_NOTIFY_STREAM;
+
+	return( 1 );
+
+on_error:
+	if( *export_handle != NULL )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *export_handle )->buffers_mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *export_handle )->buffers_mutex ),
+			 NULL );
+		}
+#endif
+		for( buffer_index = 0;
+		     buffer_index < 2;
+		     buffer_index++ )
+		{
+			if( ( *export_handle )->buffers[ buffer_index ].data != NULL )
+			{
+				memory_free(
+				 ( *export_handle )->buffers[ buffer_index ].data );
+			}
+		}
+		if( ( *export_handle )->input_volume != NULL )
+		{
+			libvsapm_volume_free(
+			 &( ( *export_handle )->input_volume ),
+			 NULL );
+		}
+		memory_free(
+		 *export_handle );
+
+		*export_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an export handle
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_free(
+     export_handle_t **export_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_free";
+	int buffer_index      = 0;
+	int result            = 1;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *export_handle != NULL )
+	{
+		if( ( *export_handle )->input_descriptor != -1 )
+		{
+			close(
+			 ( *export_handle )->input_descriptor );
+		}
+		if( ( *export_handle )->input_volume != NULL )
+		{
+			if( libvsapm_volume_free(
+			     &( ( *export_handle )->input_volume ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free input handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_condition_free(
+		     &( ( *export_handle )->buffers_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free buffers condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *export_handle )->buffers_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free buffers mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		if( ( *export_handle )->write_error != NULL )
+		{
+			libcerror_error_free(
+			 &( ( *export_handle )->write_error ) );
+		}
+		for( buffer_index = 0;
+		     buffer_index < 2;
+		     buffer_index++ )
+		{
+			memory_free(
+			 ( *export_handle )->buffers[ buffer_index ].data );
+		}
+		memory_free(
+		 *export_handle );
+
+		*export_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the export handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_signal_abort(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_signal_abort";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	export_handle->abort = 1;
+
+	if( export_handle->input_volume != NULL )
+	{
+		if( libvsapm_volume_signal_abort(
+		     export_handle->input_volume,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal input handle to abort.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the bytes per sector
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_set_bytes_per_sector(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_set_bytes_per_sector";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( vsapmtools_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( value_64bit != 512 )
+	 && ( value_64bit != 1024 )
+	 && ( value_64bit != 2048 )
+	 && ( value_64bit != 4096 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported bytes per sector value.",
+		 function );
+
+		return( -1 );
+	}
+	export_handle->bytes_per_sector = (uint32_t) value_64bit;
+
+	return( 1 );
+}
+
+/* Opens the input
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_open_input(
+     export_handle_t *export_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_open_input";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvsapm_volume_set_bytes_per_sector(
+	     export_handle->input_volume,
+	     export_handle->bytes_per_sector,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set bytes per sector in input handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libvsapm_volume_open_wide(
+	     export_handle->input_volume,
+	     filename,
+	     LIBVSAPM_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libvsapm_volume_open(
+	     export_handle->input_volume,
+	     filename,
+	     LIBVSAPM_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open input handle.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( HAVE_WIDE_SYSTEM_CHARACTER ) && ( defined( HAVE_COPY_FILE_RANGE ) || defined( HAVE_SENDFILE ) )
+	/* The partition data is stored contiguously in the source, hence the kernel
+	 * can copy it directly from a separate descriptor of the same file
+	 */
+	export_handle->input_descriptor = open(
+	                                   filename,
+	                                   O_RDONLY );
+#endif
+	return( 1 );
+}
+
+/* Closes the input
+ * Returns the 0 if succesful or -1 on error
+ */
+int export_handle_close_input(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_close_input";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->input_descriptor != -1 )
+	{
+		close(
+		 export_handle->input_descriptor );
+
+		export_handle->input_descriptor = -1;
+	}
+	if( libvsapm_volume_close(
+	     export_handle->input_volume,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close input handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 0 );
+}
+
+/* Determines if a block of data only contains 0-byte values
+ * Returns 1 if all zero or 0 if not
+ */
+int export_handle_is_zero_block(
+     const uint8_t *data,
+     size_t data_size )
+{
+	const uint64_t *aligned_data = NULL;
+	size_t data_index            = 0;
+	uint64_t aligned_value       = 0;
+
+	if( data == NULL )
+	{
+		return( 0 );
+	}
+	/* Check the unaligned head byte-by-byte
+	 */
+	while( ( data_index < data_size )
+	    && ( ( (intptr_t) &( data[ data_index ] ) % sizeof( uint64_t ) ) != 0 ) )
+	{
+		if( data[ data_index ] != 0 )
+		{
+			return( 0 );
+		}
+		data_index++;
+	}
+	aligned_data = (const uint64_t *) &( data[ data_index ] );
+
+	while( ( data_index + ( 4 * sizeof( uint64_t ) ) ) <= data_size )
+	{
+		aligned_value = aligned_data[ 0 ] | aligned_data[ 1 ] | aligned_data[ 2 ] | aligned_data[ 3 ];
+
+		if( aligned_value != 0 )
+		{
+			return( 0 );
+		}
+		aligned_data += 4;
+		data_index   += 4 * sizeof( uint64_t );
+	}
+	while( data_index < data_size )
+	{
+		if( data[ data_index ] != 0 )
+		{
+			return( 0 );
+		}
+		data_index++;
+	}
+	return( 1 );
+}
+
+/* Writes data to the output
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_write_data(
+     export_handle_t *export_handle,
+     const uint8_t *data,
+     size_t data_size,
+     off64_t output_offset,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_write_data";
+	ssize_t write_count   = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	while( data_size > 0 )
+	{
+#if defined( HAVE_PWRITE )
+		if( export_handle->output_is_seekable != 0 )
+		{
+			write_count = pwrite(
+			               export_handle->output_descriptor,
+			               data,
+			               data_size,
+			               (off_t) output_offset );
+		}
+		else
+#endif
+		{
+			write_count = write(
+			               export_handle->output_descriptor,
+			               data,
+			               data_size );
+		}
+		if( write_count < 0 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 errno,
+			 "%s: unable to write data at offset: %" PRIi64 ".",
+			 function,
+			 output_offset );
+
+			return( -1 );
+		}
+		else if( write_count == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write data at offset: %" PRIi64 ".",
+			 function,
+			 output_offset );
+
+			return( -1 );
+		}
+		data          += write_count;
+		data_size     -= (size_t) write_count;
+		output_offset += (off64_t) write_count;
+	}
+	return( 1 );
+}
+
+/* Writes a filled buffer to the output
+ * All-zero blocks are skipped when sparse output is enabled, which leaves holes in the output
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_write_buffer(
+     export_handle_t *export_handle,
+     export_handle_buffer_t *buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_write_buffer";
+	size_t block_size     = 0;
+	size_t data_offset    = 0;
+	size_t run_offset     = 0;
+	int is_zero_block     = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( export_handle->use_sparse_output == 0 )
+	 || ( export_handle->output_is_seekable == 0 ) )
+	{
+		return( export_handle_write_data(
+		         export_handle,
+		         buffer->data,
+		         buffer->data_size,
+		         buffer->output_offset,
+		         error ) );
+	}
+	/* Write consecutive non-zero blocks with a single write
+	 */
+	while( data_offset < buffer->data_size )
+	{
+		block_size = buffer->data_size - data_offset;
+
+		if( block_size > EXPORT_HANDLE_SPARSE_BLOCK_SIZE )
+		{
+			block_size = EXPORT_HANDLE_SPARSE_BLOCK_SIZE;
+		}
+		is_zero_block = export_handle_is_zero_block(
+		                 &( buffer->data[ data_offset ] ),
+		                 block_size );
+
+		if( is_zero_block != 0 )
+		{
+			if( run_offset < data_offset )
+			{
+				if( export_handle_write_data(
+				     export_handle,
+				     &( buffer->data[ run_offset ] ),
+				     data_offset - run_offset,
+				     buffer->output_offset + (off64_t) run_offset,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write data.",
+					 function );
+
+					return( -1 );
+				}
+			}
+			export_handle->sparse_size += block_size;
+
+			run_offset = data_offset + block_size;
+		}
+		data_offset += block_size;
+	}
+	if( run_offset < data_offset )
+	{
+		if( export_handle_write_data(
+		     export_handle,
+		     &( buffer->data[ run_offset ] ),
+		     data_offset - run_offset,
+		     buffer->output_offset + (off64_t) run_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The writer thread function, writes the buffers in the order they are filled
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_write_thread_function(
+     export_handle_t *export_handle )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "export_handle_write_thread_function";
+	int buffer_index         = 0;
+	int is_filled            = 0;
+	int result               = 1;
+
+	if( export_handle == NULL )
+	{
+		return( -1 );
+	}
+	while( result == 1 )
+	{
+		if( libcthreads_mutex_grab(
+		     export_handle->buffers_mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab buffers mutex.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+		while( ( export_handle->buffers[ buffer_index ].is_filled == 0 )
+		    && ( export_handle->read_done == 0 )
+		    && ( export_handle->abort == 0 ) )
+		{
+			if( libcthreads_condition_wait(
+			     export_handle->buffers_condition,
+			     export_handle->buffers_mutex,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to wait for buffers condition.",
+				 function );
+
+				result = -1;
+
+				break;
+			}
+		}
+		is_filled = export_handle->buffers[ buffer_index ].is_filled;
+
+		if( libcthreads_mutex_release(
+		     export_handle->buffers_mutex,
+		     ( error == NULL ) ? &error : NULL ) != 1 )
+		{
+			result = -1;
+		}
+		if( ( result != 1 )
+		 || ( is_filled == 0 )
+		 || ( export_handle->abort != 0 ) )
+		{
+			break;
+		}
+		if( export_handle_write_buffer(
+		     export_handle,
+		     &( export_handle->buffers[ buffer_index ] ),
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write buffer: %d.",
+			 function,
+			 buffer_index );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_grab(
+		     export_handle->buffers_mutex,
+		     ( error == NULL ) ? &error : NULL ) != 1 )
+		{
+			result = -1;
+
+			break;
+		}
+		export_handle->buffers[ buffer_index ].is_filled = 0;
+
+		libcthreads_condition_broadcast(
+		 export_handle->buffers_condition,
+		 NULL );
+
+		libcthreads_mutex_release(
+		 export_handle->buffers_mutex,
+		 NULL );
+
+		buffer_index = 1 - buffer_index;
+	}
+	if( result != 1 )
+	{
+		/* Hand the error to the reader, which stops filling buffers
+		 */
+		libcthreads_mutex_grab(
+		 export_handle->buffers_mutex,
+		 NULL );
+
+		export_handle->write_error = error;
+
+		libcthreads_condition_broadcast(
+		 export_handle->buffers_condition,
+		 NULL );
+
+		libcthreads_mutex_release(
+		 export_handle->buffers_mutex,
+		 NULL );
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* Copies the partition data to the output using the kernel without a user space buffer
+ * Returns 1 if successful, 0 if not supported for the input and output or -1 on error
+ */
+int export_handle_copy_partition_with_kernel(
+     export_handle_t *export_handle,
+     libvsapm_partition_t *partition,
+     size64_t partition_size,
+     libcerror_error_t **error )
+{
+	static char *function    = "export_handle_copy_partition_with_kernel";
+	size64_t remaining_size  = 0;
+	size_t copy_size         = 0;
+	ssize_t copy_count       = 0;
+	off64_t volume_offset    = 0;
+	int use_copy_file_range  = 0;
+
+#if defined( HAVE_SENDFILE )
+	off_t input_offset       = 0;
+#endif
+#if defined( HAVE_COPY_FILE_RANGE )
+	loff_t range_offset      = 0;
+
+	use_copy_file_range = 1;
+#endif
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( export_handle->use_kernel_copy == 0 )
+	 || ( export_handle->use_sparse_output != 0 )
+	 || ( export_handle->input_descriptor == -1 ) )
+	{
+		return( 0 );
+	}
+	if( libvsapm_partition_get_volume_offset(
+	     partition,
+	     &volume_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve partition volume offset.",
+		 function );
+
+		return( -1 );
+	}
+	remaining_size = partition_size;
+
+#if defined( HAVE_COPY_FILE_RANGE )
+	range_offset = (loff_t) volume_offset;
+#endif
+#if defined( HAVE_SENDFILE )
+	input_offset = (off_t) volume_offset;
+#endif
+	while( remaining_size > 0 )
+	{
+		if( export_handle->abort != 0 )
+		{
+			return( -1 );
+		}
+		copy_size = EXPORT_HANDLE_KERNEL_COPY_SIZE;
+
+		if( remaining_size < (size64_t) copy_size )
+		{
+			copy_size = (size_t) remaining_size;
+		}
+		copy_count = -1;
+
+#if defined( HAVE_COPY_FILE_RANGE )
+		if( use_copy_file_range != 0 )
+		{
+			copy_count = copy_file_range(
+			              export_handle->input_descriptor,
+			              &range_offset,
+			              export_handle->output_descriptor,
+			              NULL,
+			              copy_size,
+			              0 );
+
+			/* Fall back to sendfile if the file systems or file types are not supported
+			 */
+			if( ( copy_count < 0 )
+			 && ( remaining_size == partition_size )
+			 && ( ( errno == EXDEV )
+			  || ( errno == EINVAL )
+			  || ( errno == ENOSYS )
+			  || ( errno == EOPNOTSUPP )
+			  || ( errno == EBADF ) ) )
+			{
+				use_copy_file_range = 0;
+
+				continue;
+			}
+		}
+#endif
+#if defined( HAVE_SENDFILE )
+		if( use_copy_file_range == 0 )
+		{
+			copy_count = sendfile(
+			              export_handle->output_descriptor,
+			              export_handle->input_descriptor,
+			              &input_offset,
+			              copy_size );
+
+			if( ( copy_count < 0 )
+			 && ( remaining_size == partition_size )
+			 && ( ( errno == EINVAL )
+			  || ( errno == ENOSYS ) ) )
+			{
+				return( 0 );
+			}
+		}
+#else
+		if( use_copy_file_range == 0 )
+		{
+			return( 0 );
+		}
+#endif
+		if( copy_count < 0 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 errno,
+			 "%s: unable to copy partition data.",
+			 function );
+
+			return( -1 );
+		}
+		else if( copy_count == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unexpected end of input.",
+			 function );
+
+			return( -1 );
+		}
+		remaining_size -= (size64_t) copy_count;
+	}
+	return( 1 );
+}
+
+/* Copies the partition data to the output using a reader and a writer buffer
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_copy_partition_with_buffers(
+     export_handle_t *export_handle,
+     libvsapm_partition_t *partition,
+     size64_t partition_size,
+     libcerror_error_t **error )
+{
+	export_handle_buffer_t *buffer = NULL;
+	static char *function          = "export_handle_copy_partition_with_buffers";
+	size_t read_size               = 0;
+	ssize_t read_count             = 0;
+	off64_t partition_offset       = 0;
+	int buffer_index               = 0;
+	int result                     = 1;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	export_handle->buffers[ 0 ].is_filled = 0;
+	export_handle->buffers[ 1 ].is_filled = 0;
+	export_handle->read_done              = 0;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_thread_create(
+	     &( export_handle->write_thread ),
+	     NULL,
+	     (int (*)(void *)) &export_handle_write_thread_function,
+	     (void *) export_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create write thread.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	while( (size64_t) partition_offset < partition_size )
+	{
+		if( export_handle->abort != 0 )
+		{
+			result = -1;
+
+			break;
+		}
+		buffer = &( export_handle->buffers[ buffer_index ] );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		/* Wait until the writer is done with the buffer
+		 */
+		if( libcthreads_mutex_grab(
+		     export_handle->buffers_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab buffers mutex.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+		while( ( buffer->is_filled != 0 )
+		    && ( export_handle->write_error == NULL ) )
+		{
+			if( libcthreads_condition_wait(
+			     export_handle->buffers_condition,
+			     export_handle->buffers_mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to wait for buffers condition.",
+				 function );
+
+				result = -1;
+
+				break;
+			}
+		}
+		if( export_handle->write_error != NULL )
+		{
+			result = -1;
+		}
+		libcthreads_mutex_release(
+		 export_handle->buffers_mutex,
+		 NULL );
+
+		if( result != 1 )
+		{
+			break;
+		}
+#endif
+		read_size = EXPORT_HANDLE_BUFFER_SIZE;
+
+		if( ( partition_size - (size64_t) partition_offset ) < (size64_t) read_size )
+		{
+			read_size = (size_t) ( partition_size - (size64_t) partition_offset );
+		}
+		read_count = libvsapm_partition_read_buffer_at_offset(
+		              partition,
+		              buffer->data,
+		              read_size,
+		              partition_offset,
+		              error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read partition data at offset: %" PRIi64 ".",
+			 function,
+			 partition_offset );
+
+			result = -1;
+
+			break;
+		}
+		buffer->data_size     = read_size;
+		buffer->output_offset = partition_offset;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     export_handle->buffers_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab buffers mutex.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+		buffer->is_filled = 1;
+
+		libcthreads_condition_broadcast(
+		 export_handle->buffers_condition,
+		 NULL );
+
+		libcthreads_mutex_release(
+		 export_handle->buffers_mutex,
+		 NULL );
+#else
+		if( export_handle_write_buffer(
+		     export_handle,
+		     buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write buffer.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+#endif
+		partition_offset += (off64_t) read_size;
+
+		buffer_index = 1 - buffer_index;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_grab(
+	 export_handle->buffers_mutex,
+	 NULL );
+
+	export_handle->read_done = 1;
+
+	if( result != 1 )
+	{
+		/* Discard the pending buffers
+		 */
+		export_handle->buffers[ 0 ].is_filled = 0;
+		export_handle->buffers[ 1 ].is_filled = 0;
+	}
+	libcthreads_condition_broadcast(
+	 export_handle->buffers_condition,
+	 NULL );
+
+	libcthreads_mutex_release(
+	 export_handle->buffers_mutex,
+	 NULL );
+
+	if( libcthreads_thread_join(
+	     &( export_handle->write_thread ),
+	     ( result == 1 ) ? error : NULL ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to join write thread.",
+		 function );
+
+		result = -1;
+	}
+	if( export_handle->write_error != NULL )
+	{
+		if( ( error != NULL )
+		 && ( *error == NULL ) )
+		{
+			*error = export_handle->write_error;
+		}
+		else
+		{
+			libcerror_error_free(
+			 &( export_handle->write_error ) );
+		}
+		export_handle->write_error = NULL;
+
+		result = -1;
+	}
+#endif
+	if( ( result == 1 )
+	 && ( export_handle->abort != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_ABORT_REQUESTED,
+		 "%s: abort requested.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+/* Exports a partition to a target path or stdout if the target path is "-"
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_export_partition(
+     export_handle_t *export_handle,
+     libvsapm_partition_t *partition,
+     const system_character_t *target_path,
+     libcerror_error_t **error )
+{
+	struct stat file_statistics;
+
+	static char *function   = "export_handle_export_partition";
+	size64_t partition_size = 0;
+	int result              = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( target_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid target path.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->output_descriptor != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export handle - output descriptor value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvsapm_partition_get_size(
+	     partition,
+	     &partition_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve partition size.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( target_path[ 0 ] == (system_character_t) '-' )
+	 && ( target_path[ 1 ] == 0 ) )
+	{
+		export_handle->output_descriptor = 1;
+	}
+	else
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: wide character target paths are not supported.",
+		 function );
+
+		goto on_error;
+#else
+		/* Do not overwrite existing files
+		 */
+		export_handle->output_descriptor = open(
+		                                    target_path,
+		                                    O_WRONLY | O_CREAT | O_EXCL,
+		                                    0644 );
+
+		if( export_handle->output_descriptor == -1 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 errno,
+			 "%s: unable to open target: %s.",
+			 function,
+			 target_path );
+
+			goto on_error;
+		}
+#endif
+	}
+	export_handle->output_is_seekable = 0;
+	export_handle->sparse_size        = 0;
+
+	if( fstat(
+	     export_handle->output_descriptor,
+	     &file_statistics ) == 0 )
+	{
+		if( S_ISREG( file_statistics.st_mode ) )
+		{
+			export_handle->output_is_seekable = 1;
+		}
+	}
+	result = export_handle_copy_partition_with_kernel(
+	          export_handle,
+	          partition,
+	          partition_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to copy partition data.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		if( export_handle_copy_partition_with_buffers(
+		     export_handle,
+		     partition,
+		     partition_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to copy partition data.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	/* Trailing holes are not written hence the size of the output needs to be set
+	 */
+	if( ( export_handle->sparse_size > 0 )
+	 && ( export_handle->output_is_seekable != 0 ) )
+	{
+		if( ftruncate(
+		     export_handle->output_descriptor,
+		     (off_t) partition_size ) != 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 errno,
+			 "%s: unable to set size of target.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( export_handle->output_descriptor != 1 )
+	{
+		if( close(
+		     export_handle->output_descriptor ) != 0 )
+		{
+			export_handle->output_descriptor = -1;
+
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 errno,
+			 "%s: unable to close target.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	export_handle->output_descriptor = -1;
+
+	return( 1 );
+
+on_error:
+	if( ( export_handle->output_descriptor != -1 )
+	 && ( export_handle->output_descriptor != 1 ) )
+	{
+		close(
+		 export_handle->output_descriptor );
+	}
+	export_handle->output_descriptor = -1;
+
+	return( -1 );
+}
+
+/* Exports the partitions
+ * If partition_index is -1 all partitions are exported to files named target_path
+ * followed by the partition number, otherwise the partition is exported to target_path
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_export_partitions(
+     export_handle_t *export_handle,
+     int partition_index,
+     const system_character_t *target_path,
+     libcerror_error_t **error )
+{
+	system_character_t *partition_target_path = NULL;
+	libvsapm_partition_t *partition            = NULL;
+	static char *function                      = "export_handle_export_partitions";
+	size_t target_path_size                    = 0;
+	int first_partition_index                  = 0;
+	int number_of_partitions                   = 0;
+	int print_count                            = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( target_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid target path.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvsapm_volume_get_number_of_partitions(
+	     export_handle->input_volume,
+	     &number_of_partitions,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of partitions.",
+		 function );
+
+		goto on_error;
+	}
+	if( partition_index != -1 )
+	{
+		if( ( partition_index < 0 )
+		 || ( partition_index >= number_of_partitions ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid partition index value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		first_partition_index = partition_index;
+		number_of_partitions  = partition_index + 1;
+	}
+	else
+	{
+		if( ( target_path[ 0 ] == (system_character_t) '-' )
+		 && ( target_path[ 1 ] == 0 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unable to export all partitions to stdout.",
+			 function );
+
+			goto on_error;
+		}
+		target_path_size = system_string_length(
+		                    target_path ) + 12;
+
+		partition_target_path = system_string_allocate(
+		                         target_path_size );
+
+		if( partition_target_path == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create partition target path.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	for( partition_index = first_partition_index;
+	     partition_index < number_of_partitions;
+	     partition_index++ )
+	{
+		if( export_handle->abort != 0 )
+		{
+			break;
+		}
+		if( libvsapm_volume_get_partition_by_index(
+		     export_handle->input_volume,
+		     partition_index,
+		     &partition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve partition: %d.",
+			 function,
+			 partition_index );
+
+			goto on_error;
+		}
+		if( partition_target_path != NULL )
+		{
+			print_count = system_string_sprintf(
+			               partition_target_path,
+			               target_path_size,
+			               _SYSTEM_STRING( "%" PRIs_SYSTEM "%d" ),
+			               target_path,
+			               partition_index + 1 );
+
+			if( ( print_count < 0 )
+			 || ( (size_t) print_count >= target_path_size ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set partition target path.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		fprintf(
+		 stderr,
+		 "Exporting partition: %d to: %" PRIs_SYSTEM "\n",
+		 partition_index + 1,
+		 ( partition_target_path != NULL ) ? partition_target_path : target_path );
+
+		if( export_handle_export_partition(
+		     export_handle,
+		     partition,
+		     ( partition_target_path != NULL ) ? partition_target_path : target_path,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to export partition: %d.",
+			 function,
+			 partition_index );
+
+			goto on_error;
+		}
+		if( libvsapm_partition_free(
+		     &partition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free partition: %d.",
+			 function,
+			 partition_index );
+
+			goto on_error;
+		}
+	}
+	if( partition_target_path != NULL )
+	{
+		memory_free(
+		 partition_target_path );
+	}
+	return( 1 );
+
+on_error:
+	if( partition != NULL )
+	{
+		libvsapm_partition_free(
+		 &partition,
+		 NULL );
+	}
+	if( partition_target_path != NULL )
+	{
+		memory_free(
+		 partition_target_path );
+	}
+	return( -1 );
+}
+
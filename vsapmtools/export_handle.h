@@ -0,0 +1,219 @@
+/*
+ * Export handle
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _EXPORT_HANDLE_H )
+#define _EXPORT_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "vsapmtools_libcerror.h"
+#include "vsapmtools_libcthreads.h"
+#include "vsapmtools_libvsapm.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The size of the read buffers
+ */
+#define EXPORT_HANDLE_BUFFER_SIZE		( 8 * 1024 * 1024 )
+
+/* The size of the blocks that are checked for being all zero
+ */
+#define EXPORT_HANDLE_SPARSE_BLOCK_SIZE		4096
+
+/* The maximum number of bytes copied by the kernel per call
+ */
+#define EXPORT_HANDLE_KERNEL_COPY_SIZE		( 64 * 1024 * 1024 )
+
+typedef struct export_handle_buffer export_handle_buffer_t;
+
+struct export_handle_buffer
+{
+	/* The data
+	 */
+	uint8_t *data;
+
+	/* The number of bytes of data that are set
+	 */
+	size_t data_size;
+
+	/* The offset of the data in the output
+	 */
+	off64_t output_offset;
+
+	/* Value to indicate the buffer is filled and waiting to be written
+	 */
+	int is_filled;
+};
+
+typedef struct export_handle export_handle_t;
+
+struct export_handle
+{
+	/* The number of bytes per sector
+	 */
+	uint32_t bytes_per_sector;
+
+	/* The libvsapm input volume
+	 */
+	libvsapm_volume_t *input_volume;
+
+	/* The input file descriptor used for kernel copies or -1 if not available
+	 */
+	int input_descriptor;
+
+	/* Value to indicate the kernel is allowed to copy the data
+	 */
+	int use_kernel_copy;
+
+	/* Value to indicate all-zero blocks should be written as holes
+	 */
+	int use_sparse_output;
+
+	/* The read buffers
+	 */
+	export_handle_buffer_t buffers[ 2 ];
+
+	/* The output file descriptor
+	 */
+	int output_descriptor;
+
+	/* Value to indicate the output supports positional writes
+	 */
+	int output_is_seekable;
+
+	/* Value to indicate all data was read
+	 */
+	int read_done;
+
+	/* The write error
+	 */
+	libcerror_error_t *write_error;
+
+	/* The number of bytes written as holes
+	 */
+	size64_t sparse_size;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The writer thread
+	 */
+	libcthreads_thread_t *write_thread;
+
+	/* The buffers mutex
+	 */
+	libcthreads_mutex_t *buffers_mutex;
+
+	/* The buffers condition
+	 */
+	libcthreads_condition_t *buffers_condition;
+#endif
+};
+
+int export_handle_initialize(
+     export_handle_t **export_handle,
+     libcerror_error_t **error );
+
+int export_handle_free(
+     export_handle_t **export_handle,
+     libcerror_error_t **error );
+
+int export_handle_signal_abort(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+int export_handle_set_bytes_per_sector(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int export_handle_open_input(
+     export_handle_t *export_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int export_handle_close_input(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+int export_handle_is_zero_block(
+     const uint8_t *data,
+     size_t data_size );
+
+int export_handle_write_data(
+     export_handle_t *export_handle,
+     const uint8_t *data,
+     size_t data_size,
+     off64_t output_offset,
+     libcerror_error_t **error );
+
+int export_handle_write_buffer(
+     export_handle_t *export_handle,
+     export_handle_buffer_t *buffer,
+     libcerror_error_t **error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int export_handle_write_thread_function(
+     export_handle_t *export_handle );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+int export_handle_copy_partition_with_kernel(
+     export_handle_t *export_handle,
+     libvsapm_partition_t *partition,
+     size64_t partition_size,
+     libcerror_error_t **error );
+
+int export_handle_copy_partition_with_buffers(
+     export_handle_t *export_handle,
+     libvsapm_partition_t *partition,
+     size64_t partition_size,
+     libcerror_error_t **error );
+
+int export_handle_export_partition(
+     export_handle_t *export_handle,
+     libvsapm_partition_t *partition,
+     const system_character_t *target_path,
+     libcerror_error_t **error );
+
+int export_handle_export_partitions(
+     export_handle_t *export_handle,
+     int partition_index,
+     const system_character_t *target_path,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _EXPORT_HANDLE_H ) */
+
@@ -0,0 +1,2048 @@
+/*
+ * Hash handle
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include "hash_handle.h"
+#include "info_handle.h"
+#include "vsapmtools_libcerror.h"
+#include "vsapmtools_libcthreads.h"
+#include "vsapmtools_libhmac.h"
+#include "vsapmtools_libvsapm.h"
+
+#define HASH_HANDLE_NOTIFY_STREAM	stdout
+
+/* Creates a hash handle
+ * Make sure the value hash_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_initialize(
+     hash_handle_t **hash_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_initialize";
+	int buffer_index      = 0;
+	int digest_type       = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *hash_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid hash handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*hash_handle = memory_allocate_structure(
+	                hash_handle_t );
+
+	if( *hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create hash handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *hash_handle,
+	     0,
+	     sizeof( hash_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear hash handle.",
+		 function );
+
+		memory_free(
+		 *hash_handle );
+
+		*hash_handle = NULL;
+
+		return( -1 );
+	}
+	if( libvsapm_volume_initialize(
+	     &( ( *hash_handle )->input_volume ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input handle.",
+		 function );
+
+		goto on_error;
+	}
+	for( buffer_index = 0;
+	     buffer_index < HASH_HANDLE_NUMBER_OF_BUFFERS;
+	     buffer_index++ )
+	{
+		( *hash_handle )->buffers[ buffer_index ].data = (uint8_t *) memory_allocate(
+		                                                              sizeof( uint8_t ) * HASH_HANDLE_BUFFER_SIZE );
+
+		if( ( *hash_handle )->buffers[ buffer_index ].data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create buffer: %d.",
+			 function,
+			 buffer_index );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *hash_handle )->buffers_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize buffers mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *hash_handle )->buffers_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize buffers condition.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	for( digest_type = 0;
+	     digest_type < HASH_HANDLE_NUMBER_OF_DIGEST_TYPES;
+	     digest_type++ )
+	{
+		( *hash_handle )->digests[ digest_type ].hash_handle = *hash_handle;
+		( *hash_handle )->digests[ digest_type ].digest_type = digest_type;
+		( *hash_handle )->enabled_digest_types[ digest_type ] = 1;
+	}
+	( *hash_handle )->digests[ HASH_HANDLE_DIGEST_TYPE_MD5 ].hash_size    = LIBHMAC_MD5_HASH_SIZE;
+	( *hash_handle )->digests[ HASH_HANDLE_DIGEST_TYPE_SHA1 ].hash_size   = LIBHMAC_SHA1_HASH_SIZE;
+	( *hash_handle )->digests[ HASH_HANDLE_DIGEST_TYPE_SHA256 ].hash_size = LIBHMAC_SHA256_HASH_SIZE;
+
+	( *hash_handle )->bytes_per_sector = 512;
+	( *hash_handle )->notify_stream    = HASH_HANDLE_NOTIFY_STREAM;
+
+	return( 1 );
+
+on_error:
+	if( *hash_handle != NULL )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *hash_handle )->buffers_mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *hash_handle )->buffers_mutex ),
+			 NULL );
+		}
+#endif
+		for( buffer_index = 0;
+		     buffer_index < HASH_HANDLE_NUMBER_OF_BUFFERS;
+		     buffer_index++ )
+		{
+			if( ( *hash_handle )->buffers[ buffer_index ].data != NULL )
+			{
+				memory_free(
+				 ( *hash_handle )->buffers[ buffer_index ].data );
+			}
+		}
+		if( ( *hash_handle )->input_volume != NULL )
+		{
+			libvsapm_volume_free(
+			 &( ( *hash_handle )->input_volume ),
+			 NULL );
+		}
+		memory_free(
+		 *hash_handle );
+
+		*hash_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a hash handle
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_free(
+     hash_handle_t **hash_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_free";
+	int buffer_index      = 0;
+	int digest_type       = 0;
+	int result            = 1;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *hash_handle != NULL )
+	{
+		if( ( *hash_handle )->input_volume != NULL )
+		{
+			if( libvsapm_volume_free(
+			     &( ( *hash_handle )->input_volume ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free input handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_condition_free(
+		     &( ( *hash_handle )->buffers_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free buffers condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *hash_handle )->buffers_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free buffers mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		for( digest_type = 0;
+		     digest_type < HASH_HANDLE_NUMBER_OF_DIGEST_TYPES;
+		     digest_type++ )
+		{
+			if( hash_handle_digest_free_context(
+			     &( ( *hash_handle )->digests[ digest_type ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free digest: %d context.",
+				 function,
+				 digest_type );
+
+				result = -1;
+			}
+			if( ( *hash_handle )->digests[ digest_type ].block_hashes != NULL )
+			{
+				memory_free(
+				 ( *hash_handle )->digests[ digest_type ].block_hashes );
+			}
+			if( ( *hash_handle )->digests[ digest_type ].error != NULL )
+			{
+				libcerror_error_free(
+				 &( ( *hash_handle )->digests[ digest_type ].error ) );
+			}
+		}
+		for( buffer_index = 0;
+		     buffer_index < HASH_HANDLE_NUMBER_OF_BUFFERS;
+		     buffer_index++ )
+		{
+			memory_free(
+			 ( *hash_handle )->buffers[ buffer_index ].data );
+		}
+		memory_free(
+		 *hash_handle );
+
+		*hash_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the hash handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_signal_abort(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_signal_abort";
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	hash_handle->abort = 1;
+
+	if( hash_handle->input_volume != NULL )
+	{
+		if( libvsapm_volume_signal_abort(
+		     hash_handle->input_volume,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal input handle to abort.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the bytes per sector
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_set_bytes_per_sector(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_set_bytes_per_sector";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( vsapmtools_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( value_64bit != 512 )
+	 && ( value_64bit != 1024 )
+	 && ( value_64bit != 2048 )
+	 && ( value_64bit != 4096 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported bytes per sector value.",
+		 function );
+
+		return( -1 );
+	}
+	hash_handle->bytes_per_sector = (uint32_t) value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the digest types from a comma separated string, such as "md5,sha256"
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_set_digest_types(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	uint8_t enabled_digest_types[ HASH_HANDLE_NUMBER_OF_DIGEST_TYPES ];
+
+	static char *function = "hash_handle_set_digest_types";
+	size_t segment_length = 0;
+	size_t string_index   = 0;
+	size_t segment_start  = 0;
+	int digest_type       = 0;
+	int number_of_digests = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     enabled_digest_types,
+	     0,
+	     sizeof( uint8_t ) * HASH_HANDLE_NUMBER_OF_DIGEST_TYPES ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear enabled digest types.",
+		 function );
+
+		return( -1 );
+	}
+	do
+	{
+		if( ( string[ string_index ] != (system_character_t) ',' )
+		 && ( string[ string_index ] != 0 ) )
+		{
+			string_index++;
+
+			continue;
+		}
+		segment_length = string_index - segment_start;
+
+		if( ( segment_length == 3 )
+		 && ( system_string_compare_no_case(
+		       &( string[ segment_start ] ),
+		       _SYSTEM_STRING( "md5" ),
+		       3 ) == 0 ) )
+		{
+			enabled_digest_types[ HASH_HANDLE_DIGEST_TYPE_MD5 ] = 1;
+		}
+		else if( ( segment_length == 4 )
+		      && ( system_string_compare_no_case(
+		            &( string[ segment_start ] ),
+		            _SYSTEM_STRING( "sha1" ),
+		            4 ) == 0 ) )
+		{
+			enabled_digest_types[ HASH_HANDLE_DIGEST_TYPE_SHA1 ] = 1;
+		}
+		else if( ( segment_length == 6 )
+		      && ( system_string_compare_no_case(
+		            &( string[ segment_start ] ),
+		            _SYSTEM_STRING( "sha256" ),
+		            6 ) == 0 ) )
+		{
+			enabled_digest_types[ HASH_HANDLE_DIGEST_TYPE_SHA256 ] = 1;
+		}
+		else if( ( segment_length == 3 )
+		      && ( system_string_compare_no_case(
+		            &( string[ segment_start ] ),
+		            _SYSTEM_STRING( "all" ),
+		            3 ) == 0 ) )
+		{
+			for( digest_type = 0;
+			     digest_type < HASH_HANDLE_NUMBER_OF_DIGEST_TYPES;
+			     digest_type++ )
+			{
+				enabled_digest_types[ digest_type ] = 1;
+			}
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported digest type at index: %" PRIzd ".",
+			 function,
+			 segment_start );
+
+			return( -1 );
+		}
+		if( string[ string_index ] == 0 )
+		{
+			break;
+		}
+		string_index++;
+
+		segment_start = string_index;
+	}
+	while( 1 );
+
+	for( digest_type = 0;
+	     digest_type < HASH_HANDLE_NUMBER_OF_DIGEST_TYPES;
+	     digest_type++ )
+	{
+		hash_handle->enabled_digest_types[ digest_type ] = enabled_digest_types[ digest_type ];
+
+		number_of_digests += enabled_digest_types[ digest_type ];
+	}
+	if( number_of_digests == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: missing digest types.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the block size of the block hashes
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_set_block_size(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_set_block_size";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( vsapmtools_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	/* The block size must be a power of 2 so that the blocks never cross a buffer boundary
+	 */
+	if( ( value_64bit < 512 )
+	 || ( value_64bit > (uint64_t) HASH_HANDLE_BUFFER_SIZE )
+	 || ( ( value_64bit & ( value_64bit - 1 ) ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported block size value.",
+		 function );
+
+		return( -1 );
+	}
+	hash_handle->block_size = (size_t) value_64bit;
+
+	return( 1 );
+}
+
+/* Opens the input
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_open_input(
+     hash_handle_t *hash_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_open_input";
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvsapm_volume_set_bytes_per_sector(
+	     hash_handle->input_volume,
+	     hash_handle->bytes_per_sector,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set bytes per sector in input handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libvsapm_volume_open_wide(
+	     hash_handle->input_volume,
+	     filename,
+	     LIBVSAPM_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libvsapm_volume_open(
+	     hash_handle->input_volume,
+	     filename,
+	     LIBVSAPM_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open input handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Closes the input
+ * Returns the 0 if succesful or -1 on error
+ */
+int hash_handle_close_input(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_close_input";
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvsapm_volume_close(
+	     hash_handle->input_volume,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close input handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 0 );
+}
+
+/* Retrieves the name of a digest type
+ * Returns the name or NULL if not supported
+ */
+const char *hash_handle_get_digest_name(
+             int digest_type )
+{
+	switch( digest_type )
+	{
+		case HASH_HANDLE_DIGEST_TYPE_MD5:
+			return( "MD5" );
+
+		case HASH_HANDLE_DIGEST_TYPE_SHA1:
+			return( "SHA1" );
+
+		case HASH_HANDLE_DIGEST_TYPE_SHA256:
+			return( "SHA256" );
+
+		default:
+			break;
+	}
+	return( NULL );
+}
+
+/* Initializes the hash context of a digest
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_digest_initialize_context(
+     hash_handle_digest_t *digest,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_digest_initialize_context";
+	int result            = -1;
+
+	if( digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest->context != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid digest - context value already set.",
+		 function );
+
+		return( -1 );
+	}
+	switch( digest->digest_type )
+	{
+		case HASH_HANDLE_DIGEST_TYPE_MD5:
+			result = libhmac_md5_initialize(
+			          (libhmac_md5_context_t **) &( digest->context ),
+			          error );
+			break;
+
+		case HASH_HANDLE_DIGEST_TYPE_SHA1:
+			result = libhmac_sha1_initialize(
+			          (libhmac_sha1_context_t **) &( digest->context ),
+			          error );
+			break;
+
+		case HASH_HANDLE_DIGEST_TYPE_SHA256:
+			result = libhmac_sha256_initialize(
+			          (libhmac_sha256_context_t **) &( digest->context ),
+			          error );
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported digest type.",
+			 function );
+
+			return( -1 );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize %s context.",
+		 function,
+		 hash_handle_get_digest_name(
+		  digest->digest_type ) );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Frees the hash context of a digest
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_digest_free_context(
+     hash_handle_digest_t *digest,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_digest_free_context";
+	int result            = 1;
+
+	if( digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest->context == NULL )
+	{
+		return( 1 );
+	}
+	switch( digest->digest_type )
+	{
+		case HASH_HANDLE_DIGEST_TYPE_MD5:
+			result = libhmac_md5_free(
+			          (libhmac_md5_context_t **) &( digest->context ),
+			          error );
+			break;
+
+		case HASH_HANDLE_DIGEST_TYPE_SHA1:
+			result = libhmac_sha1_free(
+			          (libhmac_sha1_context_t **) &( digest->context ),
+			          error );
+			break;
+
+		case HASH_HANDLE_DIGEST_TYPE_SHA256:
+			result = libhmac_sha256_free(
+			          (libhmac_sha256_context_t **) &( digest->context ),
+			          error );
+			break;
+
+		default:
+			break;
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free context.",
+		 function );
+
+		return( -1 );
+	}
+	digest->context = NULL;
+
+	return( 1 );
+}
+
+/* Updates the hash context of a digest
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_digest_update(
+     hash_handle_digest_t *digest,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_digest_update";
+	int result            = -1;
+
+	if( digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest.",
+		 function );
+
+		return( -1 );
+	}
+	switch( digest->digest_type )
+	{
+		case HASH_HANDLE_DIGEST_TYPE_MD5:
+			result = libhmac_md5_update(
+			          (libhmac_md5_context_t *) digest->context,
+			          data,
+			          data_size,
+			          error );
+			break;
+
+		case HASH_HANDLE_DIGEST_TYPE_SHA1:
+			result = libhmac_sha1_update(
+			          (libhmac_sha1_context_t *) digest->context,
+			          data,
+			          data_size,
+			          error );
+			break;
+
+		case HASH_HANDLE_DIGEST_TYPE_SHA256:
+			result = libhmac_sha256_update(
+			          (libhmac_sha256_context_t *) digest->context,
+			          data,
+			          data_size,
+			          error );
+			break;
+
+		default:
+			break;
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update context.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Finalizes the hash context of a digest and stores the hash
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_digest_finalize(
+     hash_handle_digest_t *digest,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_digest_finalize";
+	int result            = -1;
+
+	if( digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest.",
+		 function );
+
+		return( -1 );
+	}
+	switch( digest->digest_type )
+	{
+		case HASH_HANDLE_DIGEST_TYPE_MD5:
+			result = libhmac_md5_finalize(
+			          (libhmac_md5_context_t *) digest->context,
+			          digest->hash,
+			          digest->hash_size,
+			          error );
+			break;
+
+		case HASH_HANDLE_DIGEST_TYPE_SHA1:
+			result = libhmac_sha1_finalize(
+			          (libhmac_sha1_context_t *) digest->context,
+			          digest->hash,
+			          digest->hash_size,
+			          error );
+			break;
+
+		case HASH_HANDLE_DIGEST_TYPE_SHA256:
+			result = libhmac_sha256_finalize(
+			          (libhmac_sha256_context_t *) digest->context,
+			          digest->hash,
+			          digest->hash_size,
+			          error );
+			break;
+
+		default:
+			break;
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to finalize context.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Calculates the hash of data in one pass
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_digest_calculate(
+     hash_handle_digest_t *digest,
+     const uint8_t *data,
+     size_t data_size,
+     uint8_t *hash,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_digest_calculate";
+	int result            = -1;
+
+	if( digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest.",
+		 function );
+
+		return( -1 );
+	}
+	switch( digest->digest_type )
+	{
+		case HASH_HANDLE_DIGEST_TYPE_MD5:
+			result = libhmac_md5_calculate(
+			          data,
+			          data_size,
+			          hash,
+			          digest->hash_size,
+			          error );
+			break;
+
+		case HASH_HANDLE_DIGEST_TYPE_SHA1:
+			result = libhmac_sha1_calculate(
+			          data,
+			          data_size,
+			          hash,
+			          digest->hash_size,
+			          error );
+			break;
+
+		case HASH_HANDLE_DIGEST_TYPE_SHA256:
+			result = libhmac_sha256_calculate(
+			          data,
+			          data_size,
+			          hash,
+			          digest->hash_size,
+			          error );
+			break;
+
+		default:
+			break;
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to calculate hash.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Processes a buffer with a digest
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_digest_process_buffer(
+     hash_handle_digest_t *digest,
+     hash_handle_buffer_t *buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_digest_process_buffer";
+	size_t block_size     = 0;
+	size_t data_offset    = 0;
+	uint64_t block_index  = 0;
+
+	if( digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle_digest_update(
+	     digest,
+	     buffer->data,
+	     buffer->data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update %s hash.",
+		 function,
+		 hash_handle_get_digest_name(
+		  digest->digest_type ) );
+
+		return( -1 );
+	}
+	if( digest->block_hashes == NULL )
+	{
+		return( 1 );
+	}
+	/* The buffer size is a multiple of the block size hence blocks start at the start of the buffer
+	 */
+	block_size  = digest->hash_handle->block_size;
+	block_index = (uint64_t) buffer->partition_offset / block_size;
+
+	while( data_offset < buffer->data_size )
+	{
+		if( block_index >= digest->number_of_block_hashes )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid block index value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		if( block_size > ( buffer->data_size - data_offset ) )
+		{
+			block_size = buffer->data_size - data_offset;
+		}
+		if( hash_handle_digest_calculate(
+		     digest,
+		     &( buffer->data[ data_offset ] ),
+		     block_size,
+		     &( digest->block_hashes[ block_index * digest->hash_size ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to calculate %s hash of block: %" PRIu64 ".",
+			 function,
+			 hash_handle_get_digest_name(
+			  digest->digest_type ),
+			 block_index );
+
+			return( -1 );
+		}
+		data_offset += block_size;
+
+		block_index++;
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The digest thread function, processes the shared buffers in chunk order
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_digest_thread_function(
+     hash_handle_digest_t *digest )
+{
+	hash_handle_buffer_t *buffer = NULL;
+	hash_handle_t *hash_handle   = NULL;
+	libcerror_error_t *error     = NULL;
+	static char *function        = "hash_handle_digest_thread_function";
+	int64_t chunk_index          = 0;
+	int result                   = 1;
+
+	if( digest == NULL )
+	{
+		return( -1 );
+	}
+	hash_handle = digest->hash_handle;
+
+	while( result == 1 )
+	{
+		buffer = &( hash_handle->buffers[ chunk_index % HASH_HANDLE_NUMBER_OF_BUFFERS ] );
+
+		if( libcthreads_mutex_grab(
+		     hash_handle->buffers_mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab buffers mutex.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+		while( ( buffer->chunk_index != chunk_index )
+		    && ( ( hash_handle->number_of_chunks == -1 )
+		      || ( chunk_index < hash_handle->number_of_chunks ) )
+		    && ( hash_handle->abort == 0 ) )
+		{
+			if( libcthreads_condition_wait(
+			     hash_handle->buffers_condition,
+			     hash_handle->buffers_mutex,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to wait for buffers condition.",
+				 function );
+
+				result = -1;
+
+				break;
+			}
+		}
+		if( buffer->chunk_index != chunk_index )
+		{
+			/* All chunks were processed or the hashing was aborted
+			 */
+			libcthreads_mutex_release(
+			 hash_handle->buffers_mutex,
+			 NULL );
+
+			break;
+		}
+		if( libcthreads_mutex_release(
+		     hash_handle->buffers_mutex,
+		     ( error == NULL ) ? &error : NULL ) != 1 )
+		{
+			result = -1;
+		}
+		if( result != 1 )
+		{
+			break;
+		}
+		/* The buffer is not modified by the reader until all digests processed it
+		 */
+		if( hash_handle_digest_process_buffer(
+		     digest,
+		     buffer,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to process chunk: %" PRIi64 ".",
+			 function,
+			 chunk_index );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_grab(
+		     hash_handle->buffers_mutex,
+		     ( error == NULL ) ? &error : NULL ) != 1 )
+		{
+			result = -1;
+
+			break;
+		}
+		buffer->number_of_pending_digests -= 1;
+
+		if( result != 1 )
+		{
+			hash_handle->digest_failed = 1;
+		}
+		libcthreads_condition_broadcast(
+		 hash_handle->buffers_condition,
+		 NULL );
+
+		libcthreads_mutex_release(
+		 hash_handle->buffers_mutex,
+		 NULL );
+
+		chunk_index++;
+	}
+	if( result != 1 )
+	{
+		libcthreads_mutex_grab(
+		 hash_handle->buffers_mutex,
+		 NULL );
+
+		hash_handle->digest_failed = 1;
+		digest->error              = error;
+
+		libcthreads_condition_broadcast(
+		 hash_handle->buffers_condition,
+		 NULL );
+
+		libcthreads_mutex_release(
+		 hash_handle->buffers_mutex,
+		 NULL );
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* Hashes a partition
+ * The partition is read by the calling thread and the buffers are hashed by
+ * a thread per digest type
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_hash_partition(
+     hash_handle_t *hash_handle,
+     libvsapm_partition_t *partition,
+     size64_t partition_size,
+     libcerror_error_t **error )
+{
+	hash_handle_buffer_t *buffer  = NULL;
+	hash_handle_digest_t *digest  = NULL;
+	static char *function         = "hash_handle_hash_partition";
+	size_t block_hashes_size      = 0;
+	size_t read_size              = 0;
+	ssize_t read_count            = 0;
+	uint64_t number_of_blocks     = 0;
+	off64_t partition_offset      = 0;
+	int64_t chunk_index           = 0;
+	int buffer_index              = 0;
+	int digest_type               = 0;
+	int number_of_digests         = 0;
+	int result                    = 1;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle->block_size > 0 )
+	{
+		number_of_blocks = ( partition_size + hash_handle->block_size - 1 ) / hash_handle->block_size;
+	}
+	for( digest_type = 0;
+	     digest_type < HASH_HANDLE_NUMBER_OF_DIGEST_TYPES;
+	     digest_type++ )
+	{
+		if( hash_handle->enabled_digest_types[ digest_type ] == 0 )
+		{
+			continue;
+		}
+		digest = &( hash_handle->digests[ digest_type ] );
+
+		if( hash_handle_digest_free_context(
+		     digest,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free digest context.",
+			 function );
+
+			return( -1 );
+		}
+		if( hash_handle_digest_initialize_context(
+		     digest,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize digest context.",
+			 function );
+
+			return( -1 );
+		}
+		if( digest->block_hashes != NULL )
+		{
+			memory_free(
+			 digest->block_hashes );
+
+			digest->block_hashes = NULL;
+		}
+		digest->number_of_block_hashes = 0;
+
+		if( number_of_blocks > 0 )
+		{
+			if( number_of_blocks > ( (uint64_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / digest->hash_size ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+				 "%s: invalid number of blocks value exceeds maximum.",
+				 function );
+
+				return( -1 );
+			}
+			block_hashes_size = (size_t) number_of_blocks * digest->hash_size;
+
+			digest->block_hashes = (uint8_t *) memory_allocate(
+			                                    sizeof( uint8_t ) * block_hashes_size );
+
+			if( digest->block_hashes == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create block hashes.",
+				 function );
+
+				return( -1 );
+			}
+			digest->number_of_block_hashes = number_of_blocks;
+		}
+		number_of_digests++;
+	}
+	for( buffer_index = 0;
+	     buffer_index < HASH_HANDLE_NUMBER_OF_BUFFERS;
+	     buffer_index++ )
+	{
+		hash_handle->buffers[ buffer_index ].chunk_index               = -1;
+		hash_handle->buffers[ buffer_index ].number_of_pending_digests = 0;
+	}
+	hash_handle->number_of_chunks = -1;
+	hash_handle->digest_failed    = 0;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	for( digest_type = 0;
+	     digest_type < HASH_HANDLE_NUMBER_OF_DIGEST_TYPES;
+	     digest_type++ )
+	{
+		if( hash_handle->enabled_digest_types[ digest_type ] == 0 )
+		{
+			continue;
+		}
+		if( libcthreads_thread_create(
+		     &( hash_handle->digests[ digest_type ].thread ),
+		     NULL,
+		     (int (*)(void *)) &hash_handle_digest_thread_function,
+		     (void *) &( hash_handle->digests[ digest_type ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create %s thread.",
+			 function,
+			 hash_handle_get_digest_name(
+			  digest_type ) );
+
+			result = -1;
+
+			break;
+		}
+	}
+#endif
+	while( ( result == 1 )
+	    && ( (size64_t) partition_offset < partition_size ) )
+	{
+		if( hash_handle->abort != 0 )
+		{
+			result = -1;
+
+			break;
+		}
+		buffer = &( hash_handle->buffers[ chunk_index % HASH_HANDLE_NUMBER_OF_BUFFERS ] );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		/* Wait until all digests are done with the previous chunk in the buffer
+		 */
+		if( libcthreads_mutex_grab(
+		     hash_handle->buffers_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab buffers mutex.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+		while( ( buffer->number_of_pending_digests > 0 )
+		    && ( hash_handle->digest_failed == 0 )
+		    && ( hash_handle->abort == 0 ) )
+		{
+			if( libcthreads_condition_wait(
+			     hash_handle->buffers_condition,
+			     hash_handle->buffers_mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to wait for buffers condition.",
+				 function );
+
+				result = -1;
+
+				break;
+			}
+		}
+		if( ( hash_handle->digest_failed != 0 )
+		 || ( hash_handle->abort != 0 ) )
+		{
+			result = -1;
+		}
+		libcthreads_mutex_release(
+		 hash_handle->buffers_mutex,
+		 NULL );
+
+		if( result != 1 )
+		{
+			break;
+		}
+#endif
+		read_size = HASH_HANDLE_BUFFER_SIZE;
+
+		if( ( partition_size - (size64_t) partition_offset ) < (size64_t) read_size )
+		{
+			read_size = (size_t) ( partition_size - (size64_t) partition_offset );
+		}
+		read_count = libvsapm_partition_read_buffer_at_offset(
+		              partition,
+		              buffer->data,
+		              read_size,
+		              partition_offset,
+		              error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read partition data at offset: %" PRIi64 ".",
+			 function,
+			 partition_offset );
+
+			result = -1;
+
+			break;
+		}
+		buffer->data_size        = read_size;
+		buffer->partition_offset = partition_offset;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     hash_handle->buffers_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab buffers mutex.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+		buffer->chunk_index               = chunk_index;
+		buffer->number_of_pending_digests = number_of_digests;
+
+		libcthreads_condition_broadcast(
+		 hash_handle->buffers_condition,
+		 NULL );
+
+		libcthreads_mutex_release(
+		 hash_handle->buffers_mutex,
+		 NULL );
+#else
+		buffer->chunk_index = chunk_index;
+
+		for( digest_type = 0;
+		     digest_type < HASH_HANDLE_NUMBER_OF_DIGEST_TYPES;
+		     digest_type++ )
+		{
+			if( hash_handle->enabled_digest_types[ digest_type ] == 0 )
+			{
+				continue;
+			}
+			if( hash_handle_digest_process_buffer(
+			     &( hash_handle->digests[ digest_type ] ),
+			     buffer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to process chunk: %" PRIi64 ".",
+				 function,
+				 chunk_index );
+
+				result = -1;
+
+				break;
+			}
+		}
+#endif
+		partition_offset += (off64_t) read_size;
+
+		chunk_index++;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_grab(
+	 hash_handle->buffers_mutex,
+	 NULL );
+
+	/* Chunks that were not read are not processed
+	 */
+	hash_handle->number_of_chunks = chunk_index;
+
+	if( result != 1 )
+	{
+		hash_handle->abort = 1;
+	}
+	libcthreads_condition_broadcast(
+	 hash_handle->buffers_condition,
+	 NULL );
+
+	libcthreads_mutex_release(
+	 hash_handle->buffers_mutex,
+	 NULL );
+
+	for( digest_type = 0;
+	     digest_type < HASH_HANDLE_NUMBER_OF_DIGEST_TYPES;
+	     digest_type++ )
+	{
+		digest = &( hash_handle->digests[ digest_type ] );
+
+		if( digest->thread == NULL )
+		{
+			continue;
+		}
+		if( libcthreads_thread_join(
+		     &( digest->thread ),
+		     ( result == 1 ) ? error : NULL ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join %s thread.",
+			 function,
+			 hash_handle_get_digest_name(
+			  digest_type ) );
+
+			result = -1;
+		}
+		if( digest->error != NULL )
+		{
+			if( ( result == 1 )
+			 && ( error != NULL )
+			 && ( *error == NULL ) )
+			{
+				*error = digest->error;
+			}
+			else
+			{
+				libcerror_error_free(
+				 &( digest->error ) );
+			}
+			digest->error = NULL;
+
+			result = -1;
+		}
+	}
+#endif
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+	for( digest_type = 0;
+	     digest_type < HASH_HANDLE_NUMBER_OF_DIGEST_TYPES;
+	     digest_type++ )
+	{
+		if( hash_handle->enabled_digest_types[ digest_type ] == 0 )
+		{
+			continue;
+		}
+		if( hash_handle_digest_finalize(
+		     &( hash_handle->digests[ digest_type ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to finalize %s hash.",
+			 function,
+			 hash_handle_get_digest_name(
+			  digest_type ) );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Prints a hash as a hexadecimal string
+ */
+void hash_handle_hash_fprint(
+      const uint8_t *hash,
+      size_t hash_size,
+      FILE *notify_stream )
+{
+	size_t hash_index = 0;
+
+	if( ( hash == NULL )
+	 || ( notify_stream == NULL ) )
+	{
+		return;
+	}
+	for( hash_index = 0;
+	     hash_index < hash_size;
+	     hash_index++ )
+	{
+		fprintf(
+		 notify_stream,
+		 "%02" PRIx8 "",
+		 hash[ hash_index ] );
+	}
+}
+
+/* Prints the hashes of a partition
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_partition_hashes_fprint(
+     hash_handle_t *hash_handle,
+     int partition_index,
+     size64_t partition_size,
+     libcerror_error_t **error )
+{
+	hash_handle_digest_t *digest = NULL;
+	static char *function        = "hash_handle_partition_hashes_fprint";
+	uint64_t block_index         = 0;
+	uint64_t number_of_blocks    = 0;
+	int digest_type              = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	fprintf(
+	 hash_handle->notify_stream,
+	 "Partition: %d\n",
+	 partition_index + 1 );
+
+	fprintf(
+	 hash_handle->notify_stream,
+	 "\tSize\t\t\t: %" PRIu64 "\n",
+	 partition_size );
+
+	for( digest_type = 0;
+	     digest_type < HASH_HANDLE_NUMBER_OF_DIGEST_TYPES;
+	     digest_type++ )
+	{
+		if( hash_handle->enabled_digest_types[ digest_type ] == 0 )
+		{
+			continue;
+		}
+		digest = &( hash_handle->digests[ digest_type ] );
+
+		fprintf(
+		 hash_handle->notify_stream,
+		 "\t%s\t\t\t: ",
+		 hash_handle_get_digest_name(
+		  digest_type ) );
+
+		hash_handle_hash_fprint(
+		 digest->hash,
+		 digest->hash_size,
+		 hash_handle->notify_stream );
+
+		fprintf(
+		 hash_handle->notify_stream,
+		 "\n" );
+
+		number_of_blocks = digest->number_of_block_hashes;
+	}
+	if( number_of_blocks > 0 )
+	{
+		fprintf(
+		 hash_handle->notify_stream,
+		 "\n\tBlock hashes (block size: %" PRIzd "):\n",
+		 hash_handle->block_size );
+
+		for( block_index = 0;
+		     block_index < number_of_blocks;
+		     block_index++ )
+		{
+			fprintf(
+			 hash_handle->notify_stream,
+			 "\t0x%08" PRIx64 "",
+			 block_index * hash_handle->block_size );
+
+			for( digest_type = 0;
+			     digest_type < HASH_HANDLE_NUMBER_OF_DIGEST_TYPES;
+			     digest_type++ )
+			{
+				if( hash_handle->enabled_digest_types[ digest_type ] == 0 )
+				{
+					continue;
+				}
+				digest = &( hash_handle->digests[ digest_type ] );
+
+				fprintf(
+				 hash_handle->notify_stream,
+				 " %s: ",
+				 hash_handle_get_digest_name(
+				  digest_type ) );
+
+				hash_handle_hash_fprint(
+				 &( digest->block_hashes[ block_index * digest->hash_size ] ),
+				 digest->hash_size,
+				 hash_handle->notify_stream );
+			}
+			fprintf(
+			 hash_handle->notify_stream,
+			 "\n" );
+		}
+	}
+	fprintf(
+	 hash_handle->notify_stream,
+	 "\n" );
+
+	return( 1 );
+}
+
+/* Hashes the partitions
+ * If partition_index is -1 all partitions are hashed
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_hash_partitions(
+     hash_handle_t *hash_handle,
+     int partition_index,
+     libcerror_error_t **error )
+{
+	libvsapm_partition_t *partition = NULL;
+	static char *function           = "hash_handle_hash_partitions";
+	size64_t partition_size         = 0;
+	int first_partition_index       = 0;
+	int number_of_partitions        = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvsapm_volume_get_number_of_partitions(
+	     hash_handle->input_volume,
+	     &number_of_partitions,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of partitions.",
+		 function );
+
+		goto on_error;
+	}
+	if( partition_index != -1 )
+	{
+		if( ( partition_index < 0 )
+		 || ( partition_index >= number_of_partitions ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid partition index value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		first_partition_index = partition_index;
+		number_of_partitions  = partition_index + 1;
+	}
+	for( partition_index = first_partition_index;
+	     partition_index < number_of_partitions;
+	     partition_index++ )
+	{
+		if( hash_handle->abort != 0 )
+		{
+			break;
+		}
+		if( libvsapm_volume_get_partition_by_index(
+		     hash_handle->input_volume,
+		     partition_index,
+		     &partition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve partition: %d.",
+			 function,
+			 partition_index );
+
+			goto on_error;
+		}
+		if( libvsapm_partition_get_size(
+		     partition,
+		     &partition_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve partition: %d size.",
+			 function,
+			 partition_index );
+
+			goto on_error;
+		}
+		if( hash_handle_hash_partition(
+		     hash_handle,
+		     partition,
+		     partition_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to hash partition: %d.",
+			 function,
+			 partition_index );
+
+			goto on_error;
+		}
+		if( hash_handle_partition_hashes_fprint(
+		     hash_handle,
+		     partition_index,
+		     partition_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print partition: %d hashes.",
+			 function,
+			 partition_index );
+
+			goto on_error;
+		}
+		if( libvsapm_partition_free(
+		     &partition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free partition: %d.",
+			 function,
+			 partition_index );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( partition != NULL )
+	{
+		libvsapm_partition_free(
+		 &partition,
+		 NULL );
+	}
+	return( -1 );
+}
+
@@ -0,0 +1,285 @@
+/*
+ * Hash handle
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _HASH_HANDLE_H )
+#define _HASH_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "vsapmtools_libcerror.h"
+#include "vsapmtools_libcthreads.h"
+#include "vsapmtools_libhmac.h"
+#include "vsapmtools_libvsapm.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The size of the read buffers
+ */
+#define HASH_HANDLE_BUFFER_SIZE			( 4 * 1024 * 1024 )
+
+/* The number of read buffers that are shared by the digest threads
+ */
+#define HASH_HANDLE_NUMBER_OF_BUFFERS		4
+
+/* The maximum size of a digest hash
+ */
+#define HASH_HANDLE_MAXIMUM_HASH_SIZE		32
+
+enum HASH_HANDLE_DIGEST_TYPES
+{
+	HASH_HANDLE_DIGEST_TYPE_MD5		= 0,
+	HASH_HANDLE_DIGEST_TYPE_SHA1		= 1,
+	HASH_HANDLE_DIGEST_TYPE_SHA256		= 2
+};
+
+#define HASH_HANDLE_NUMBER_OF_DIGEST_TYPES	3
+
+typedef struct hash_handle hash_handle_t;
+
+typedef struct hash_handle_buffer hash_handle_buffer_t;
+
+struct hash_handle_buffer
+{
+	/* The data
+	 */
+	uint8_t *data;
+
+	/* The number of bytes of data that are set
+	 */
+	size_t data_size;
+
+	/* The offset of the data in the partition
+	 */
+	off64_t partition_offset;
+
+	/* The index of the chunk stored in the buffer or -1 if not set
+	 */
+	int64_t chunk_index;
+
+	/* The number of digests that still need to process the buffer
+	 */
+	int number_of_pending_digests;
+};
+
+typedef struct hash_handle_digest hash_handle_digest_t;
+
+struct hash_handle_digest
+{
+	/* The hash handle
+	 */
+	hash_handle_t *hash_handle;
+
+	/* The digest type
+	 */
+	int digest_type;
+
+	/* The hash context
+	 */
+	intptr_t *context;
+
+	/* The hash
+	 */
+	uint8_t hash[ HASH_HANDLE_MAXIMUM_HASH_SIZE ];
+
+	/* The hash size
+	 */
+	size_t hash_size;
+
+	/* The block hashes
+	 */
+	uint8_t *block_hashes;
+
+	/* The number of block hashes
+	 */
+	uint64_t number_of_block_hashes;
+
+	/* The error of the digest thread
+	 */
+	libcerror_error_t *error;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The digest thread
+	 */
+	libcthreads_thread_t *thread;
+#endif
+};
+
+struct hash_handle
+{
+	/* The number of bytes per sector
+	 */
+	uint32_t bytes_per_sector;
+
+	/* The libvsapm input volume
+	 */
+	libvsapm_volume_t *input_volume;
+
+	/* Values to indicate which digest types are enabled
+	 */
+	uint8_t enabled_digest_types[ HASH_HANDLE_NUMBER_OF_DIGEST_TYPES ];
+
+	/* The block size of the block hashes or 0 if not set
+	 */
+	size_t block_size;
+
+	/* The read buffers
+	 */
+	hash_handle_buffer_t buffers[ HASH_HANDLE_NUMBER_OF_BUFFERS ];
+
+	/* The digests
+	 */
+	hash_handle_digest_t digests[ HASH_HANDLE_NUMBER_OF_DIGEST_TYPES ];
+
+	/* The number of chunks that were read or -1 while reading
+	 */
+	int64_t number_of_chunks;
+
+	/* Value to indicate a digest failed
+	 */
+	int digest_failed;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The buffers mutex
+	 */
+	libcthreads_mutex_t *buffers_mutex;
+
+	/* The buffers condition
+	 */
+	libcthreads_condition_t *buffers_condition;
+#endif
+};
+
+int hash_handle_initialize(
+     hash_handle_t **hash_handle,
+     libcerror_error_t **error );
+
+int hash_handle_free(
+     hash_handle_t **hash_handle,
+     libcerror_error_t **error );
+
+int hash_handle_signal_abort(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error );
+
+int hash_handle_set_bytes_per_sector(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int hash_handle_set_digest_types(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int hash_handle_set_block_size(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int hash_handle_open_input(
+     hash_handle_t *hash_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int hash_handle_close_input(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error );
+
+const char *hash_handle_get_digest_name(
+             int digest_type );
+
+int hash_handle_digest_initialize_context(
+     hash_handle_digest_t *digest,
+     libcerror_error_t **error );
+
+int hash_handle_digest_free_context(
+     hash_handle_digest_t *digest,
+     libcerror_error_t **error );
+
+int hash_handle_digest_update(
+     hash_handle_digest_t *digest,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int hash_handle_digest_finalize(
+     hash_handle_digest_t *digest,
+     libcerror_error_t **error );
+
+int hash_handle_digest_calculate(
+     hash_handle_digest_t *digest,
+     const uint8_t *data,
+     size_t data_size,
+     uint8_t *hash,
+     libcerror_error_t **error );
+
+int hash_handle_digest_process_buffer(
+     hash_handle_digest_t *digest,
+     hash_handle_buffer_t *buffer,
+     libcerror_error_t **error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int hash_handle_digest_thread_function(
+     hash_handle_digest_t *digest );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+int hash_handle_hash_partition(
+     hash_handle_t *hash_handle,
+     libvsapm_partition_t *partition,
+     size64_t partition_size,
+     libcerror_error_t **error );
+
+void hash_handle_hash_fprint(
+      const uint8_t *hash,
+      size_t hash_size,
+      FILE *notify_stream );
+
+int hash_handle_partition_hashes_fprint(
+     hash_handle_t *hash_handle,
+     int partition_index,
+     size64_t partition_size,
+     libcerror_error_t **error );
+
+int hash_handle_hash_partitions(
+     hash_handle_t *hash_handle,
+     int partition_index,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _HASH_HANDLE_H ) */
+
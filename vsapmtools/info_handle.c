@@ -836,3 +836,417 @@ on_error:
 	return( -1 );
 }
 
+/* Prints a narrow character string as a JSON string
+ */
+void info_handle_json_narrow_string_fprint(
+      const char *string,
+      FILE *notify_stream )
+{
+	size_t string_index = 0;
+	uint8_t character   = 0;
+
+	if( ( string == NULL )
+	 || ( notify_stream == NULL ) )
+	{
+		return;
+	}
+	fprintf(
+	 notify_stream,
+	 "\"" );
+
+	for( string_index = 0;
+	     string[ string_index ] != 0;
+	     string_index++ )
+	{
+		character = (uint8_t) string[ string_index ];
+
+		if( ( character == (uint8_t) '"' )
+		 || ( character == (uint8_t) '\\' ) )
+		{
+			fprintf(
+			 notify_stream,
+			 "\\%c",
+			 (char) character );
+		}
+		else if( character < 0x20 )
+		{
+			fprintf(
+			 notify_stream,
+			 "\\u%04" PRIx8 "",
+			 character );
+		}
+		else
+		{
+			fprintf(
+			 notify_stream,
+			 "%c",
+			 (char) character );
+		}
+	}
+	fprintf(
+	 notify_stream,
+	 "\"" );
+}
+
+/* Prints a system character string as a JSON string
+ */
+void info_handle_json_system_string_fprint(
+      const system_character_t *string,
+      FILE *notify_stream )
+{
+	size_t string_index = 0;
+
+	if( ( string == NULL )
+	 || ( notify_stream == NULL ) )
+	{
+		return;
+	}
+	fprintf(
+	 notify_stream,
+	 "\"" );
+
+	for( string_index = 0;
+	     string[ string_index ] != 0;
+	     string_index++ )
+	{
+		if( ( string[ string_index ] == (system_character_t) '"' )
+		 || ( string[ string_index ] == (system_character_t) '\\' ) )
+		{
+			fprintf(
+			 notify_stream,
+			 "\\%" PRIc_SYSTEM "",
+			 string[ string_index ] );
+		}
+		else if( (uint32_t) string[ string_index ] < 0x20 )
+		{
+			fprintf(
+			 notify_stream,
+			 "\\u%04" PRIx32 "",
+			 (uint32_t) string[ string_index ] );
+		}
+		else
+		{
+			fprintf(
+			 notify_stream,
+			 "%" PRIc_SYSTEM "",
+			 string[ string_index ] );
+		}
+	}
+	fprintf(
+	 notify_stream,
+	 "\"" );
+}
+
+/* Prints the partition information as a JSON object
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_partition_json_fprint(
+     info_handle_t *info_handle,
+     int partition_index,
+     libvsapm_partition_t *partition,
+     libcerror_error_t **error )
+{
+	char name_string[ 32 ];
+	char type_string[ 32 ];
+
+	static char *function = "info_handle_partition_json_fprint";
+	size64_t size         = 0;
+	off64_t volume_offset = 0;
+	uint32_t status_flags = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvsapm_partition_get_type_string(
+	     partition,
+	     type_string,
+	     32,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve partition type string.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvsapm_partition_get_name_string(
+	     partition,
+	     name_string,
+	     32,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve partition name string.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvsapm_partition_get_volume_offset(
+	     partition,
+	     &volume_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve partition offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvsapm_partition_get_size(
+	     partition,
+	     &size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve partition size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvsapm_partition_get_status_flags(
+	     partition,
+	     &status_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve partition status flags.",
+		 function );
+
+		return( -1 );
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "{\"index\":%d,\"type\":",
+	 partition_index + 1 );
+
+	info_handle_json_narrow_string_fprint(
+	 type_string,
+	 info_handle->notify_stream );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 ",\"name\":" );
+
+	info_handle_json_narrow_string_fprint(
+	 name_string,
+	 info_handle->notify_stream );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 ",\"offset\":%" PRIi64 ",\"size\":%" PRIu64 ",\"status_flags\":%" PRIu32 "}",
+	 volume_offset,
+	 size,
+	 status_flags );
+
+	return( 1 );
+}
+
+/* Prints the partitions information as a single line JSON object
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_partitions_json_fprint(
+     info_handle_t *info_handle,
+     const system_character_t *source,
+     libcerror_error_t **error )
+{
+	libvsapm_partition_t *partition = NULL;
+	static char *function           = "info_handle_partitions_json_fprint";
+	uint32_t bytes_per_sector       = 0;
+	int number_of_partitions        = 0;
+	int partition_index             = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvsapm_volume_get_bytes_per_sector(
+	     info_handle->input_volume,
+	     &bytes_per_sector,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of bytes per sector.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvsapm_volume_get_number_of_partitions(
+	     info_handle->input_volume,
+	     &number_of_partitions,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of partitions.",
+		 function );
+
+		goto on_error;
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "{\"source\":" );
+
+	info_handle_json_system_string_fprint(
+	 source,
+	 info_handle->notify_stream );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 ",\"bytes_per_sector\":%" PRIu32 ",\"number_of_partitions\":%d,\"partitions\":[",
+	 bytes_per_sector,
+	 number_of_partitions );
+
+	for( partition_index = 0;
+	     partition_index < number_of_partitions;
+	     partition_index++ )
+	{
+		if( libvsapm_volume_get_partition_by_index(
+		     info_handle->input_volume,
+		     partition_index,
+		     &partition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve partition: %d.",
+			 function,
+			 partition_index );
+
+			goto on_error;
+		}
+		if( partition_index > 0 )
+		{
+			fprintf(
+			 info_handle->notify_stream,
+			 "," );
+		}
+		if( info_handle_partition_json_fprint(
+		     info_handle,
+		     partition_index,
+		     partition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print partition: %d information.",
+			 function,
+			 partition_index );
+
+			goto on_error;
+		}
+		if( libvsapm_partition_free(
+		     &partition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free partition: %d.",
+			 function,
+			 partition_index );
+
+			goto on_error;
+		}
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "]}\n" );
+
+	return( 1 );
+
+on_error:
+	if( partition != NULL )
+	{
+		libvsapm_partition_free(
+		 &partition,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Prints an error of a source as a single line JSON object
+ */
+void info_handle_json_error_fprint(
+      const system_character_t *source,
+      libcerror_error_t *error,
+      FILE *notify_stream )
+{
+	char error_string[ 512 ];
+
+	if( notify_stream == NULL )
+	{
+		return;
+	}
+	error_string[ 0 ] = 0;
+
+	if( error != NULL )
+	{
+		if( libcerror_error_sprint(
+		     error,
+		     error_string,
+		     512 ) <= 0 )
+		{
+			error_string[ 0 ] = 0;
+		}
+	}
+	fprintf(
+	 notify_stream,
+	 "{\"source\":" );
+
+	info_handle_json_system_string_fprint(
+	 source,
+	 notify_stream );
+
+	fprintf(
+	 notify_stream,
+	 ",\"error\":" );
+
+	info_handle_json_narrow_string_fprint(
+	 error_string,
+	 notify_stream );
+
+	fprintf(
+	 notify_stream,
+	 "}\n" );
+}
+
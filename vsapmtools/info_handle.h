@@ -33,6 +33,12 @@
 extern "C" {
 #endif
 
+enum INFO_HANDLE_OUTPUT_FORMATS
+{
+	INFO_HANDLE_OUTPUT_FORMAT_JSON		= (int) 'j',
+	INFO_HANDLE_OUTPUT_FORMAT_TEXT		= (int) 't'
+};
+
 typedef struct info_handle info_handle_t;
 
 struct info_handle
@@ -99,6 +105,30 @@ int info_handle_partitions_fprint(
      info_handle_t *info_handle,
      libcerror_error_t **error );
 
+void info_handle_json_narrow_string_fprint(
+      const char *string,
+      FILE *notify_stream );
+
+void info_handle_json_system_string_fprint(
+      const system_character_t *string,
+      FILE *notify_stream );
+
+int info_handle_partition_json_fprint(
+     info_handle_t *info_handle,
+     int partition_index,
+     libvsapm_partition_t *partition,
+     libcerror_error_t **error );
+
+int info_handle_partitions_json_fprint(
+     info_handle_t *info_handle,
+     const system_character_t *source,
+     libcerror_error_t **error );
+
+void info_handle_json_error_fprint(
+      const system_character_t *source,
+      libcerror_error_t *error,
+      FILE *notify_stream );
+
 #if defined( __cplusplus )
 }
 #endif
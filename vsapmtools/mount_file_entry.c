@@ -0,0 +1,692 @@
+/*
+ * Mount file entry
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "mount_file_entry.h"
+#include "mount_file_system.h"
+#include "vsapmtools_libcerror.h"
+#include "vsapmtools_libvsapm.h"
+
+/* Creates a file entry
+ * The partition index is -1 for the root directory
+ * Make sure the value file_entry is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_entry_initialize(
+     mount_file_entry_t **file_entry,
+     mount_file_system_t *file_system,
+     int partition_index,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_entry_initialize";
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_entry != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file entry value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( partition_index < -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid partition index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*file_entry = memory_allocate_structure(
+	               mount_file_entry_t );
+
+	if( *file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create file entry.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *file_entry,
+	     0,
+	     sizeof( mount_file_entry_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file entry.",
+		 function );
+
+		memory_free(
+		 *file_entry );
+
+		*file_entry = NULL;
+
+		return( -1 );
+	}
+	( *file_entry )->file_system     = file_system;
+	( *file_entry )->partition_index = partition_index;
+
+	if( partition_index == -1 )
+	{
+		( *file_entry )->name_size = 1;
+	}
+	else
+	{
+		if( mount_file_system_get_partition_name_by_index(
+		     file_system,
+		     partition_index,
+		     ( *file_entry )->name,
+		     MOUNT_FILE_ENTRY_MAXIMUM_NAME_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve partition: %d name.",
+			 function,
+			 partition_index );
+
+			goto on_error;
+		}
+		( *file_entry )->name_size = system_string_length(
+		                              ( *file_entry )->name ) + 1;
+
+		if( mount_file_system_get_partition_by_index(
+		     file_system,
+		     partition_index,
+		     &( ( *file_entry )->partition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve partition: %d.",
+			 function,
+			 partition_index );
+
+			goto on_error;
+		}
+		if( libvsapm_partition_get_volume_offset(
+		     ( *file_entry )->partition,
+		     &( ( *file_entry )->volume_offset ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve partition: %d volume offset.",
+			 function,
+			 partition_index );
+
+			goto on_error;
+		}
+		if( libvsapm_partition_get_size(
+		     ( *file_entry )->partition,
+		     &( ( *file_entry )->size ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve partition: %d size.",
+			 function,
+			 partition_index );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( *file_entry != NULL )
+	{
+		memory_free(
+		 *file_entry );
+
+		*file_entry = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a file entry
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_entry_free(
+     mount_file_entry_t **file_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_entry_free";
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_entry != NULL )
+	{
+		/* The partition is managed by the file system
+		 */
+		memory_free(
+		 *file_entry );
+
+		*file_entry = NULL;
+	}
+	return( 1 );
+}
+
+/* Retrieves the size of the name
+ * The returned size includes the end of string character
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_entry_get_name_size(
+     mount_file_entry_t *file_entry,
+     size_t *string_size,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_entry_get_name_size";
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( string_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string size.",
+		 function );
+
+		return( -1 );
+	}
+	*string_size = file_entry->name_size;
+
+	return( 1 );
+}
+
+/* Retrieves the name
+ * The size should include the end of string character
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_entry_get_name(
+     mount_file_entry_t *file_entry,
+     system_character_t *string,
+     size_t string_size,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_entry_get_name";
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( string_size < file_entry->name_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid string size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( system_string_copy(
+	     string,
+	     file_entry->name,
+	     file_entry->name_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy name.",
+		 function );
+
+		return( -1 );
+	}
+	string[ file_entry->name_size - 1 ] = 0;
+
+	return( 1 );
+}
+
+/* Retrieves the mounted timestamp, which is used for all date and time values
+ * The timestamp is a signed 64-bit POSIX date and time value in number of nanoseconds
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_entry_get_mounted_timestamp(
+     mount_file_entry_t *file_entry,
+     uint64_t *mounted_timestamp,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_entry_get_mounted_timestamp";
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( mount_file_system_get_mounted_timestamp(
+	     file_entry->file_system,
+	     mounted_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve mounted timestamp.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the number of sub file entries
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_entry_get_number_of_sub_file_entries(
+     mount_file_entry_t *file_entry,
+     int *number_of_sub_file_entries,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_entry_get_number_of_sub_file_entries";
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_sub_file_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of sub file entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_entry->partition_index != -1 )
+	{
+		*number_of_sub_file_entries = 0;
+
+		return( 1 );
+	}
+	if( mount_file_system_get_number_of_partitions(
+	     file_entry->file_system,
+	     number_of_sub_file_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of partitions.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the sub file entry for the specific index
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_entry_get_sub_file_entry_by_index(
+     mount_file_entry_t *file_entry,
+     int sub_file_entry_index,
+     mount_file_entry_t **sub_file_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_entry_get_sub_file_entry_by_index";
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_entry->partition_index != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid file entry - not a directory.",
+		 function );
+
+		return( -1 );
+	}
+	if( sub_file_entry_index < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid sub file entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( mount_file_entry_initialize(
+	     sub_file_entry,
+	     file_entry->file_system,
+	     sub_file_entry_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize sub file entry: %d.",
+		 function,
+		 sub_file_entry_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads data at a specific offset
+ * When the file system has an input file descriptor the data is read with
+ * a positional read, which allows concurrent reads without locking
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t mount_file_entry_read_buffer_at_offset(
+         mount_file_entry_t *file_entry,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function = "mount_file_entry_read_buffer_at_offset";
+	ssize_t read_count    = 0;
+
+#if defined( HAVE_PREAD )
+	size_t buffer_offset  = 0;
+#endif
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_entry->partition == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file entry - missing partition.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_PREAD )
+	if( file_entry->file_system->input_descriptor != -1 )
+	{
+		if( (size64_t) offset >= file_entry->size )
+		{
+			return( 0 );
+		}
+		if( (size64_t) buffer_size > ( file_entry->size - (size64_t) offset ) )
+		{
+			buffer_size = (size_t) ( file_entry->size - (size64_t) offset );
+		}
+		offset += file_entry->volume_offset;
+
+		while( buffer_offset < buffer_size )
+		{
+			read_count = pread(
+			              file_entry->file_system->input_descriptor,
+			              &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			              buffer_size - buffer_offset,
+			              (off_t) offset );
+
+			if( read_count < 0 )
+			{
+				if( errno == EINTR )
+				{
+					continue;
+				}
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 errno,
+				 "%s: unable to read data at offset: %" PRIi64 ".",
+				 function,
+				 offset );
+
+				return( -1 );
+			}
+			else if( read_count == 0 )
+			{
+				break;
+			}
+			buffer_offset += (size_t) read_count;
+			offset        += (off64_t) read_count;
+		}
+		return( (ssize_t) buffer_offset );
+	}
+#endif /* defined( HAVE_PREAD ) */
+
+	read_count = libvsapm_partition_read_buffer_at_offset(
+	              file_entry->partition,
+	              buffer,
+	              buffer_size,
+	              offset,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ") from partition.",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
+/* Retrieves the size
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_entry_get_size(
+     mount_file_entry_t *file_entry,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_entry_get_size";
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	*size = file_entry->size;
+
+	return( 1 );
+}
+
@@ -0,0 +1,802 @@
+/*
+ * Mount file system
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include <time.h>
+
+#include "mount_file_system.h"
+#include "vsapmtools_libcdata.h"
+#include "vsapmtools_libcerror.h"
+#include "vsapmtools_libvsapm.h"
+
+/* Creates a file system
+ * Make sure the value file_system is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_system_initialize(
+     mount_file_system_t **file_system,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_system_initialize";
+	time_t timestamp      = 0;
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_system != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file system value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*file_system = memory_allocate_structure(
+	                mount_file_system_t );
+
+	if( *file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create file system.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *file_system,
+	     0,
+	     sizeof( mount_file_system_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file system.",
+		 function );
+
+		memory_free(
+		 *file_system );
+
+		*file_system = NULL;
+
+		return( -1 );
+	}
+	if( libcdata_array_initialize(
+	     &( ( *file_system )->partitions_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize partitions array.",
+		 function );
+
+		goto on_error;
+	}
+	timestamp = time(
+	             NULL );
+
+	if( timestamp == (time_t) -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time.",
+		 function );
+
+		goto on_error;
+	}
+	/* The mounted timestamp is stored as the number of nano seconds since January 1, 1970
+	 */
+	( *file_system )->mounted_timestamp = (uint64_t) timestamp * 1000000000;
+	( *file_system )->input_descriptor  = -1;
+
+	return( 1 );
+
+on_error:
+	if( *file_system != NULL )
+	{
+		if( ( *file_system )->partitions_array != NULL )
+		{
+			libcdata_array_free(
+			 &( ( *file_system )->partitions_array ),
+			 NULL,
+			 NULL );
+		}
+		memory_free(
+		 *file_system );
+
+		*file_system = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a file system
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_system_free(
+     mount_file_system_t **file_system,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_system_free";
+	int result            = 1;
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_system != NULL )
+	{
+		if( ( *file_system )->path_prefix != NULL )
+		{
+			memory_free(
+			 ( *file_system )->path_prefix );
+		}
+		if( libcdata_array_free(
+		     &( ( *file_system )->partitions_array ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libvsapm_partition_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free partitions array.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *file_system );
+
+		*file_system = NULL;
+	}
+	return( result );
+}
+
+/* Signals the file system to abort
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_system_signal_abort(
+     mount_file_system_t *file_system,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_system_signal_abort";
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_system->volume != NULL )
+	{
+		if( libvsapm_volume_signal_abort(
+		     file_system->volume,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal volume to abort.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the path prefix
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_system_set_path_prefix(
+     mount_file_system_t *file_system,
+     const system_character_t *path_prefix,
+     size_t path_prefix_size,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_system_set_path_prefix";
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_system->path_prefix != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file system - path prefix value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( path_prefix == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path prefix.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( path_prefix_size <= 1 )
+	 || ( path_prefix_size > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( system_character_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid path prefix size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	file_system->path_prefix = system_string_allocate(
+	                            path_prefix_size );
+
+	if( file_system->path_prefix == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create path prefix string.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     file_system->path_prefix,
+	     path_prefix,
+	     path_prefix_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy path prefix.",
+		 function );
+
+		goto on_error;
+	}
+	file_system->path_prefix[ path_prefix_size - 1 ] = 0;
+
+	file_system->path_prefix_size = path_prefix_size;
+
+	return( 1 );
+
+on_error:
+	if( file_system->path_prefix != NULL )
+	{
+		memory_free(
+		 file_system->path_prefix );
+
+		file_system->path_prefix = NULL;
+	}
+	file_system->path_prefix_size = 0;
+
+	return( -1 );
+}
+
+/* Sets the volume
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_system_set_volume(
+     mount_file_system_t *file_system,
+     libvsapm_volume_t *volume,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_system_set_volume";
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	file_system->volume = volume;
+
+	return( 1 );
+}
+
+/* Retrieves the volume
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_system_get_volume(
+     mount_file_system_t *file_system,
+     libvsapm_volume_t **volume,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_system_get_volume";
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	*volume = file_system->volume;
+
+	return( 1 );
+}
+
+/* Sets the input file descriptor used for positional reads
+ * The file descriptor is not managed by the file system
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_system_set_input_descriptor(
+     mount_file_system_t *file_system,
+     int input_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_system_set_input_descriptor";
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	file_system->input_descriptor = input_descriptor;
+
+	return( 1 );
+}
+
+/* Appends a partition to the file system
+ * The partition is managed by the file system after a successful append
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_system_append_partition(
+     mount_file_system_t *file_system,
+     libvsapm_partition_t *partition,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_system_append_partition";
+	int entry_index       = 0;
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_append_entry(
+	     file_system->partitions_array,
+	     &entry_index,
+	     (intptr_t *) partition,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append partition to array.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the mounted timestamp
+ * On Windows the timestamp is an unsigned 64-bit FILETIME timestamp
+ * otherwise the timestamp is a signed 64-bit POSIX date and time value in number of nanoseconds
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_system_get_mounted_timestamp(
+     mount_file_system_t *file_system,
+     uint64_t *mounted_timestamp,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_system_get_mounted_timestamp";
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( mounted_timestamp == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mounted timestamp.",
+		 function );
+
+		return( -1 );
+	}
+	*mounted_timestamp = file_system->mounted_timestamp;
+
+	return( 1 );
+}
+
+/* Retrieves the number of partitions
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_system_get_number_of_partitions(
+     mount_file_system_t *file_system,
+     int *number_of_partitions,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_system_get_number_of_partitions";
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     file_system->partitions_array,
+	     number_of_partitions,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of partitions.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves a specific partition
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_system_get_partition_by_index(
+     mount_file_system_t *file_system,
+     int partition_index,
+     libvsapm_partition_t **partition,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_system_get_partition_by_index";
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_entry_by_index(
+	     file_system->partitions_array,
+	     partition_index,
+	     (intptr_t **) partition,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve partition: %d.",
+		 function,
+		 partition_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the partition index from a path
+ * Returns 1 if successful, 0 if no such partition index or -1 on error
+ */
+int mount_file_system_get_partition_index_from_path(
+     mount_file_system_t *file_system,
+     const system_character_t *path,
+     size_t path_length,
+     int *partition_index,
+     libcerror_error_t **error )
+{
+	static char *function        = "mount_file_system_get_partition_index_from_path";
+	system_character_t character = 0;
+	size_t path_index            = 0;
+	int number_of_partitions     = 0;
+	int safe_partition_index     = 0;
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_system->path_prefix == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file system - missing path prefix.",
+		 function );
+
+		return( -1 );
+	}
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		return( -1 );
+	}
+	if( partition_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition index.",
+		 function );
+
+		return( -1 );
+	}
+	/* The path consists of the path prefix followed by the partition number, starting at 1
+	 */
+	path_index = file_system->path_prefix_size - 1;
+
+	if( ( path_length <= path_index )
+	 || ( ( path_length - path_index ) > 4 ) )
+	{
+		return( 0 );
+	}
+	if( system_string_compare(
+	     path,
+	     file_system->path_prefix,
+	     path_index ) != 0 )
+	{
+		return( 0 );
+	}
+	if( path[ path_index ] == (system_character_t) '0' )
+	{
+		return( 0 );
+	}
+	while( path_index < path_length )
+	{
+		character = path[ path_index++ ];
+
+		if( ( character < (system_character_t) '0' )
+		 || ( character > (system_character_t) '9' ) )
+		{
+			return( 0 );
+		}
+		safe_partition_index *= 10;
+		safe_partition_index += (int) ( character - (system_character_t) '0' );
+	}
+	safe_partition_index -= 1;
+
+	if( mount_file_system_get_number_of_partitions(
+	     file_system,
+	     &number_of_partitions,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of partitions.",
+		 function );
+
+		return( -1 );
+	}
+	if( safe_partition_index >= number_of_partitions )
+	{
+		return( 0 );
+	}
+	*partition_index = safe_partition_index;
+
+	return( 1 );
+}
+
+/* Retrieves the name of a specific partition
+ * The name consists of the path prefix without the leading separator followed by the partition number
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_system_get_partition_name_by_index(
+     mount_file_system_t *file_system,
+     int partition_index,
+     system_character_t *name,
+     size_t name_size,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_system_get_partition_name_by_index";
+	int print_count       = 0;
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_system->path_prefix == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file system - missing path prefix.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( partition_index < 0 )
+	 || ( partition_index > 9998 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid partition index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	if( name_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid name size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	print_count = system_string_sprintf(
+	               name,
+	               name_size,
+	               _SYSTEM_STRING( "%" PRIs_SYSTEM "%d" ),
+	               &( file_system->path_prefix[ 1 ] ),
+	               partition_index + 1 );
+
+	if( ( print_count < 0 )
+	 || ( (size_t) print_count >= name_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set name.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,138 @@
+/*
+ * Mount file system
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _MOUNT_FILE_SYSTEM_H )
+#define _MOUNT_FILE_SYSTEM_H
+
+#include <common.h>
+#include <types.h>
+
+#include "vsapmtools_libcdata.h"
+#include "vsapmtools_libcerror.h"
+#include "vsapmtools_libvsapm.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct mount_file_system mount_file_system_t;
+
+struct mount_file_system
+{
+	/* The path prefix
+	 */
+	system_character_t *path_prefix;
+
+	/* The path prefix size
+	 */
+	size_t path_prefix_size;
+
+	/* The mounted timestamp
+	 */
+	uint64_t mounted_timestamp;
+
+	/* The volume
+	 */
+	libvsapm_volume_t *volume;
+
+	/* The partitions array
+	 */
+	libcdata_array_t *partitions_array;
+
+	/* The input file descriptor used for positional reads or -1 if not available
+	 */
+	int input_descriptor;
+};
+
+int mount_file_system_initialize(
+     mount_file_system_t **file_system,
+     libcerror_error_t **error );
+
+int mount_file_system_free(
+     mount_file_system_t **file_system,
+     libcerror_error_t **error );
+
+int mount_file_system_signal_abort(
+     mount_file_system_t *file_system,
+     libcerror_error_t **error );
+
+int mount_file_system_set_path_prefix(
+     mount_file_system_t *file_system,
+     const system_character_t *path_prefix,
+     size_t path_prefix_size,
+     libcerror_error_t **error );
+
+int mount_file_system_set_volume(
+     mount_file_system_t *file_system,
+     libvsapm_volume_t *volume,
+     libcerror_error_t **error );
+
+int mount_file_system_get_volume(
+     mount_file_system_t *file_system,
+     libvsapm_volume_t **volume,
+     libcerror_error_t **error );
+
+int mount_file_system_set_input_descriptor(
+     mount_file_system_t *file_system,
+     int input_descriptor,
+     libcerror_error_t **error );
+
+int mount_file_system_append_partition(
+     mount_file_system_t *file_system,
+     libvsapm_partition_t *partition,
+     libcerror_error_t **error );
+
+int mount_file_system_get_mounted_timestamp(
+     mount_file_system_t *file_system,
+     uint64_t *mounted_timestamp,
+     libcerror_error_t **error );
+
+int mount_file_system_get_number_of_partitions(
+     mount_file_system_t *file_system,
+     int *number_of_partitions,
+     libcerror_error_t **error );
+
+int mount_file_system_get_partition_by_index(
+     mount_file_system_t *file_system,
+     int partition_index,
+     libvsapm_partition_t **partition,
+     libcerror_error_t **error );
+
+int mount_file_system_get_partition_index_from_path(
+     mount_file_system_t *file_system,
+     const system_character_t *path,
+     size_t path_length,
+     int *partition_index,
+     libcerror_error_t **error );
+
+int mount_file_system_get_partition_name_by_index(
+     mount_file_system_t *file_system,
+     int partition_index,
+     system_character_t *name,
+     size_t name_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _MOUNT_FILE_SYSTEM_H ) */
+
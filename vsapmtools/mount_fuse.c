@@ -0,0 +1,1097 @@
+/*
+ * Mount tool fuse functions
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "mount_file_entry.h"
+#include "mount_fuse.h"
+#include "mount_handle.h"
+#include "vsapmtools_libcerror.h"
+#include "vsapmtools_libcnotify.h"
+#include "vsapmtools_unused.h"
+
+#if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 )
+
+/* Sets the values in a stat info structure
+ * The mounted timestamp is a signed 64-bit POSIX date and time value in number of nanoseconds
+ * Returns 1 if successful or -1 on error
+ */
+int mount_fuse_set_stat_info(
+     struct stat *stat_info,
+     size64_t size,
+     uint16_t file_mode,
+     uint64_t mounted_timestamp,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_fuse_set_stat_info";
+
+	if( stat_info == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stat info.",
+		 function );
+
+		return( -1 );
+	}
+#if SIZEOF_OFF_T <= 4
+	if( size > (size64_t) UINT32_MAX )
+#else
+	if( size > (size64_t) INT64_MAX )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	stat_info->st_size  = (off_t) size;
+	stat_info->st_mode  = file_mode;
+	stat_info->st_nlink = ( ( file_mode & S_IFDIR ) != 0 ) ? 2 : 1;
+
+#if defined( HAVE_GETEUID )
+	stat_info->st_uid = geteuid();
+#else
+	stat_info->st_uid = 0;
+#endif
+#if defined( HAVE_GETEGID )
+	stat_info->st_gid = getegid();
+#else
+	stat_info->st_gid = 0;
+#endif
+	stat_info->st_atime = (time_t) ( mounted_timestamp / 1000000000 );
+	stat_info->st_mtime = (time_t) ( mounted_timestamp / 1000000000 );
+	stat_info->st_ctime = (time_t) ( mounted_timestamp / 1000000000 );
+
+	return( 1 );
+}
+
+/* Fills a directory entry
+ * Returns 1 if successful or -1 on error
+ */
+int mount_fuse_filldir(
+     void *buffer,
+     fuse_fill_dir_t filler,
+     const char *name,
+     struct stat *stat_info,
+     mount_file_entry_t *file_entry,
+     libcerror_error_t **error )
+{
+	static char *function      = "mount_fuse_filldir";
+	size64_t file_size         = 0;
+	uint64_t mounted_timestamp = 0;
+	uint16_t file_mode         = 0;
+
+	if( filler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filler.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_entry == NULL )
+	{
+		file_mode = S_IFDIR | 0555;
+	}
+	else
+	{
+		if( file_entry->partition_index == -1 )
+		{
+			file_mode = S_IFDIR | 0555;
+		}
+		else
+		{
+			file_mode = S_IFREG | 0444;
+		}
+		if( mount_file_entry_get_size(
+		     file_entry,
+		     &file_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file entry size.",
+			 function );
+
+			return( -1 );
+		}
+		if( mount_file_entry_get_mounted_timestamp(
+		     file_entry,
+		     &mounted_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve mounted timestamp.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( memory_set(
+	     stat_info,
+	     0,
+	     sizeof( struct stat ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear stat info.",
+		 function );
+
+		return( -1 );
+	}
+	if( mount_fuse_set_stat_info(
+	     stat_info,
+	     file_size,
+	     file_mode,
+	     mounted_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set stat info.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFUSE3 )
+	if( filler(
+	     buffer,
+	     name,
+	     stat_info,
+	     0,
+	     0 ) == 1 )
+#else
+	if( filler(
+	     buffer,
+	     name,
+	     stat_info,
+	     0 ) == 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set directory entry.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Opens a file or directory
+ * Returns 0 if successful or a negative errno value otherwise
+ */
+int mount_fuse_open(
+     const char *path,
+     struct fuse_file_info *file_info )
+{
+	libcerror_error_t *error         = NULL;
+	mount_file_entry_t *file_entry   = NULL;
+	mount_handle_t *mount_handle     = NULL;
+	static char *function            = "mount_fuse_open";
+	int result                       = 0;
+
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( file_info == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file info.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( ( file_info->flags & 0x03 ) != O_RDONLY )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: write access currently not supported.",
+		 function );
+
+		result = -EACCES;
+
+		goto on_error;
+	}
+	mount_handle = (mount_handle_t *) fuse_get_context()->private_data;
+
+	result = mount_handle_get_file_entry_by_path(
+	          mount_handle,
+	          path,
+	          &file_entry,
+	          &error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file entry for path: %s.",
+		 function,
+		 path );
+
+		result = -ENOENT;
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		return( -ENOENT );
+	}
+	if( file_entry->partition_index == -1 )
+	{
+		mount_file_entry_free(
+		 &file_entry,
+		 NULL );
+
+		return( -EISDIR );
+	}
+	/* The partition data does not change hence the kernel page cache
+	 * does not need to be invalidated when the file is reopened
+	 */
+	file_info->fh         = (uint64_t) file_entry;
+	file_info->keep_cache = 1;
+
+	return( 0 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_entry != NULL )
+	{
+		mount_file_entry_free(
+		 &file_entry,
+		 NULL );
+	}
+	return( result );
+}
+
+/* Reads a buffer of data at the specified offset
+ * This function is called concurrently by the fuse worker threads
+ * Returns number of bytes read if successful or a negative errno value otherwise
+ */
+int mount_fuse_read(
+     const char *path,
+     char *buffer,
+     size_t size,
+     off_t offset,
+     struct fuse_file_info *file_info )
+{
+	libcerror_error_t *error       = NULL;
+	mount_file_entry_t *file_entry = NULL;
+	static char *function          = "mount_fuse_read";
+	ssize_t read_count             = 0;
+	int result                     = 0;
+
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( size > (size_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( file_info == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file info.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( file_info->fh == (uint64_t) NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file info - missing file handle.",
+		 function );
+
+		result = -EBADF;
+
+		goto on_error;
+	}
+	file_entry = (mount_file_entry_t *) file_info->fh;
+
+	read_count = mount_file_entry_read_buffer_at_offset(
+	              file_entry,
+	              (uint8_t *) buffer,
+	              size,
+	              (off64_t) offset,
+	              &error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read from file entry.",
+		 function );
+
+		result = -EIO;
+
+		goto on_error;
+	}
+	return( (int) read_count );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+/* Releases a file entry
+ * Returns 0 if successful or a negative errno value otherwise
+ */
+int mount_fuse_release(
+     const char *path,
+     struct fuse_file_info *file_info )
+{
+	libcerror_error_t *error       = NULL;
+	mount_file_entry_t *file_entry = NULL;
+	static char *function          = "mount_fuse_release";
+	int result                     = 0;
+
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( file_info == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file info.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	file_entry = (mount_file_entry_t *) file_info->fh;
+
+	if( mount_file_entry_free(
+	     &file_entry,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file entry.",
+		 function );
+
+		result = -EIO;
+
+		goto on_error;
+	}
+	file_info->fh = (uint64_t) NULL;
+
+	return( 0 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+/* Opens a directory
+ * Returns 0 if successful or a negative errno value otherwise
+ */
+int mount_fuse_opendir(
+     const char *path,
+     struct fuse_file_info *file_info )
+{
+	libcerror_error_t *error       = NULL;
+	mount_file_entry_t *file_entry = NULL;
+	mount_handle_t *mount_handle   = NULL;
+	static char *function          = "mount_fuse_opendir";
+	int result                     = 0;
+
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( file_info == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file info.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	mount_handle = (mount_handle_t *) fuse_get_context()->private_data;
+
+	result = mount_handle_get_file_entry_by_path(
+	          mount_handle,
+	          path,
+	          &file_entry,
+	          &error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file entry for path: %s.",
+		 function,
+		 path );
+
+		result = -ENOENT;
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		return( -ENOENT );
+	}
+	if( file_entry->partition_index != -1 )
+	{
+		mount_file_entry_free(
+		 &file_entry,
+		 NULL );
+
+		return( -ENOTDIR );
+	}
+	file_info->fh = (uint64_t) file_entry;
+
+	return( 0 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_entry != NULL )
+	{
+		mount_file_entry_free(
+		 &file_entry,
+		 NULL );
+	}
+	return( result );
+}
+
+/* Reads a directory
+ * Returns 0 if successful or a negative errno value otherwise
+ */
+#if defined( HAVE_LIBFUSE3 )
+int mount_fuse_readdir(
+     const char *path,
+     void *buffer,
+     fuse_fill_dir_t filler,
+     off_t offset VSAPMTOOLS_ATTRIBUTE_UNUSED,
+     struct fuse_file_info *file_info,
+     enum fuse_readdir_flags flags VSAPMTOOLS_ATTRIBUTE_UNUSED )
+#else
+int mount_fuse_readdir(
+     const char *path,
+     void *buffer,
+     fuse_fill_dir_t filler,
+     off_t offset VSAPMTOOLS_ATTRIBUTE_UNUSED,
+     struct fuse_file_info *file_info )
+#endif
+{
+	char name[ MOUNT_FILE_ENTRY_MAXIMUM_NAME_SIZE ];
+
+	struct stat *stat_info             = NULL;
+	libcerror_error_t *error           = NULL;
+	mount_file_entry_t *file_entry     = NULL;
+	mount_file_entry_t *sub_file_entry = NULL;
+	static char *function              = "mount_fuse_readdir";
+	int number_of_sub_file_entries     = 0;
+	int result                         = 0;
+	int sub_file_entry_index           = 0;
+
+	VSAPMTOOLS_UNREFERENCED_PARAMETER( offset )
+
+#if defined( HAVE_LIBFUSE3 )
+	VSAPMTOOLS_UNREFERENCED_PARAMETER( flags )
+#endif
+
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( file_info == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file info.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( file_info->fh == (uint64_t) NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file info - missing file handle.",
+		 function );
+
+		result = -EBADF;
+
+		goto on_error;
+	}
+	file_entry = (mount_file_entry_t *) file_info->fh;
+
+	stat_info = memory_allocate_structure(
+	             struct stat );
+
+	if( stat_info == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create stat info.",
+		 function );
+
+		result = -EIO;
+
+		goto on_error;
+	}
+	if( mount_fuse_filldir(
+	     buffer,
+	     filler,
+	     ".",
+	     stat_info,
+	     file_entry,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set self directory entry.",
+		 function );
+
+		result = -EIO;
+
+		goto on_error;
+	}
+	if( mount_fuse_filldir(
+	     buffer,
+	     filler,
+	     "..",
+	     stat_info,
+	     NULL,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set parent directory entry.",
+		 function );
+
+		result = -EIO;
+
+		goto on_error;
+	}
+	if( mount_file_entry_get_number_of_sub_file_entries(
+	     file_entry,
+	     &number_of_sub_file_entries,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of sub file entries.",
+		 function );
+
+		result = -EIO;
+
+		goto on_error;
+	}
+	for( sub_file_entry_index = 0;
+	     sub_file_entry_index < number_of_sub_file_entries;
+	     sub_file_entry_index++ )
+	{
+		if( mount_file_entry_get_sub_file_entry_by_index(
+		     file_entry,
+		     sub_file_entry_index,
+		     &sub_file_entry,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sub file entry: %d.",
+			 function,
+			 sub_file_entry_index );
+
+			result = -EIO;
+
+			goto on_error;
+		}
+		if( mount_file_entry_get_name(
+		     sub_file_entry,
+		     name,
+		     MOUNT_FILE_ENTRY_MAXIMUM_NAME_SIZE,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sub file entry: %d name.",
+			 function,
+			 sub_file_entry_index );
+
+			result = -EIO;
+
+			goto on_error;
+		}
+		if( mount_fuse_filldir(
+		     buffer,
+		     filler,
+		     name,
+		     stat_info,
+		     sub_file_entry,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set directory entry: %d.",
+			 function,
+			 sub_file_entry_index );
+
+			result = -EIO;
+
+			goto on_error;
+		}
+		if( mount_file_entry_free(
+		     &sub_file_entry,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free sub file entry: %d.",
+			 function,
+			 sub_file_entry_index );
+
+			result = -EIO;
+
+			goto on_error;
+		}
+	}
+	memory_free(
+	 stat_info );
+
+	return( 0 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( sub_file_entry != NULL )
+	{
+		mount_file_entry_free(
+		 &sub_file_entry,
+		 NULL );
+	}
+	if( stat_info != NULL )
+	{
+		memory_free(
+		 stat_info );
+	}
+	return( result );
+}
+
+/* Releases a directory
+ * Returns 0 if successful or a negative errno value otherwise
+ */
+int mount_fuse_releasedir(
+     const char *path,
+     struct fuse_file_info *file_info )
+{
+	return( mount_fuse_release(
+	         path,
+	         file_info ) );
+}
+
+/* Retrieves the file stat info
+ * Returns 0 if successful or a negative errno value otherwise
+ */
+#if defined( HAVE_LIBFUSE3 )
+int mount_fuse_getattr(
+     const char *path,
+     struct stat *stat_info,
+     struct fuse_file_info *file_info VSAPMTOOLS_ATTRIBUTE_UNUSED )
+#else
+int mount_fuse_getattr(
+     const char *path,
+     struct stat *stat_info )
+#endif
+{
+	libcerror_error_t *error       = NULL;
+	mount_file_entry_t *file_entry = NULL;
+	mount_handle_t *mount_handle   = NULL;
+	static char *function          = "mount_fuse_getattr";
+	size64_t file_size             = 0;
+	uint64_t mounted_timestamp     = 0;
+	uint16_t file_mode             = 0;
+	int result                     = 0;
+
+#if defined( HAVE_LIBFUSE3 )
+	VSAPMTOOLS_UNREFERENCED_PARAMETER( file_info )
+#endif
+
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( stat_info == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stat info.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( memory_set(
+	     stat_info,
+	     0,
+	     sizeof( struct stat ) ) == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear stat info.",
+		 function );
+
+		result = -EIO;
+
+		goto on_error;
+	}
+	mount_handle = (mount_handle_t *) fuse_get_context()->private_data;
+
+	result = mount_handle_get_file_entry_by_path(
+	          mount_handle,
+	          path,
+	          &file_entry,
+	          &error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file entry for path: %s.",
+		 function,
+		 path );
+
+		result = -ENOENT;
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		return( -ENOENT );
+	}
+	if( file_entry->partition_index == -1 )
+	{
+		file_mode = S_IFDIR | 0555;
+	}
+	else
+	{
+		file_mode = S_IFREG | 0444;
+	}
+	if( mount_file_entry_get_size(
+	     file_entry,
+	     &file_size,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file entry size.",
+		 function );
+
+		result = -EIO;
+
+		goto on_error;
+	}
+	if( mount_file_entry_get_mounted_timestamp(
+	     file_entry,
+	     &mounted_timestamp,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve mounted timestamp.",
+		 function );
+
+		result = -EIO;
+
+		goto on_error;
+	}
+	if( mount_fuse_set_stat_info(
+	     stat_info,
+	     file_size,
+	     file_mode,
+	     mounted_timestamp,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set stat info.",
+		 function );
+
+		result = -EIO;
+
+		goto on_error;
+	}
+	if( mount_file_entry_free(
+	     &file_entry,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file entry.",
+		 function );
+
+		result = -EIO;
+
+		goto on_error;
+	}
+	return( 0 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_entry != NULL )
+	{
+		mount_file_entry_free(
+		 &file_entry,
+		 NULL );
+	}
+	return( result );
+}
+
+/* Initializes the file system connection
+ * The partition data is read-only hence the kernel is allowed to cache it
+ * and to read ahead up to the maximum read size
+ * Returns the private data of the fuse context
+ */
+#if defined( HAVE_LIBFUSE3 )
+void *mount_fuse_init(
+       struct fuse_conn_info *connection_info,
+       struct fuse_config *configuration )
+#else
+void *mount_fuse_init(
+       struct fuse_conn_info *connection_info )
+#endif
+{
+	if( connection_info != NULL )
+	{
+		if( connection_info->max_readahead < MOUNT_FUSE_MAXIMUM_READ_SIZE )
+		{
+			connection_info->max_readahead = MOUNT_FUSE_MAXIMUM_READ_SIZE;
+		}
+	}
+#if defined( HAVE_LIBFUSE3 )
+	if( configuration != NULL )
+	{
+		configuration->kernel_cache  = 1;
+		configuration->entry_timeout = 3600.0;
+		configuration->attr_timeout  = 3600.0;
+	}
+#endif
+	return( fuse_get_context()->private_data );
+}
+
+#endif /* defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 ) */
+
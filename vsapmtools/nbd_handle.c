@@ -0,0 +1,2777 @@
+/*
+ * Network Block Device (NBD) handle
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <byte_stream.h>
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_SYS_SOCKET_H )
+#include <sys/socket.h>
+#endif
+
+#if defined( HAVE_SYS_UN_H )
+#include <sys/un.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "export_handle.h"
+#include "info_handle.h"
+#include "nbd_handle.h"
+#include "vsapmtools_libcerror.h"
+#include "vsapmtools_libcnotify.h"
+#include "vsapmtools_libcthreads.h"
+#include "vsapmtools_libvsapm.h"
+
+#define NBD_HANDLE_NOTIFY_STREAM	stdout
+
+#if defined( MSG_NOSIGNAL )
+#define NBD_HANDLE_SEND_FLAGS		MSG_NOSIGNAL
+#else
+#define NBD_HANDLE_SEND_FLAGS		0
+#endif
+
+/* Creates a NBD handle
+ * Make sure the value nbd_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_initialize(
+     nbd_handle_t **nbd_handle,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_handle_initialize";
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *nbd_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid NBD handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > NBD_HANDLE_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*nbd_handle = memory_allocate_structure(
+	               nbd_handle_t );
+
+	if( *nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create NBD handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *nbd_handle,
+	     0,
+	     sizeof( nbd_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear NBD handle.",
+		 function );
+
+		memory_free(
+		 *nbd_handle );
+
+		*nbd_handle = NULL;
+
+		return( -1 );
+	}
+	if( libvsapm_volume_initialize(
+	     &( ( *nbd_handle )->input_volume ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *nbd_handle )->reply_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize reply mutex.",
+		 function );
+
+		goto on_error;
+	}
+#else
+	number_of_threads = 1;
+#endif
+	( *nbd_handle )->bytes_per_sector      = 512;
+	( *nbd_handle )->number_of_threads     = number_of_threads;
+	( *nbd_handle )->input_descriptor      = -1;
+	( *nbd_handle )->listen_descriptor     = -1;
+	( *nbd_handle )->connection_descriptor = -1;
+	( *nbd_handle )->notify_stream         = NBD_HANDLE_NOTIFY_STREAM;
+
+	return( 1 );
+
+on_error:
+	if( *nbd_handle != NULL )
+	{
+		if( ( *nbd_handle )->input_volume != NULL )
+		{
+			libvsapm_volume_free(
+			 &( ( *nbd_handle )->input_volume ),
+			 NULL );
+		}
+		memory_free(
+		 *nbd_handle );
+
+		*nbd_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a NBD handle
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_free(
+     nbd_handle_t **nbd_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_handle_free";
+	int result            = 1;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *nbd_handle != NULL )
+	{
+		if( ( *nbd_handle )->connection_descriptor != -1 )
+		{
+			close(
+			 ( *nbd_handle )->connection_descriptor );
+		}
+		if( ( *nbd_handle )->listen_descriptor != -1 )
+		{
+			close(
+			 ( *nbd_handle )->listen_descriptor );
+		}
+		if( ( *nbd_handle )->socket_path != NULL )
+		{
+			memory_free(
+			 ( *nbd_handle )->socket_path );
+		}
+		if( ( *nbd_handle )->input_descriptor != -1 )
+		{
+			close(
+			 ( *nbd_handle )->input_descriptor );
+		}
+		if( ( *nbd_handle )->input_partition != NULL )
+		{
+			if( libvsapm_partition_free(
+			     &( ( *nbd_handle )->input_partition ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free input partition.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *nbd_handle )->input_volume != NULL )
+		{
+			if( libvsapm_volume_free(
+			     &( ( *nbd_handle )->input_volume ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free input handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *nbd_handle )->request_thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *nbd_handle )->request_thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join request thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *nbd_handle )->reply_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free reply mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *nbd_handle );
+
+		*nbd_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the NBD handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_signal_abort(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_handle_signal_abort";
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	nbd_handle->abort = 1;
+
+#if defined( HAVE_SYS_SOCKET_H )
+	/* Shutting down the sockets wakes up a blocking accept or read
+	 */
+	if( nbd_handle->listen_descriptor != -1 )
+	{
+		shutdown(
+		 nbd_handle->listen_descriptor,
+		 SHUT_RDWR );
+	}
+	if( nbd_handle->connection_descriptor != -1 )
+	{
+		shutdown(
+		 nbd_handle->connection_descriptor,
+		 SHUT_RDWR );
+	}
+#endif
+	if( nbd_handle->input_volume != NULL )
+	{
+		if( libvsapm_volume_signal_abort(
+		     nbd_handle->input_volume,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal input volume to abort.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the bytes per sector
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_set_bytes_per_sector(
+     nbd_handle_t *nbd_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_handle_set_bytes_per_sector";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( vsapmtools_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( value_64bit != 512 )
+	 && ( value_64bit != 1024 )
+	 && ( value_64bit != 2048 )
+	 && ( value_64bit != 4096 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported bytes per sector value.",
+		 function );
+
+		return( -1 );
+	}
+	nbd_handle->bytes_per_sector = (uint32_t) value_64bit;
+
+	return( 1 );
+}
+
+/* Opens the input and selects the partition to export
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_open_input(
+     nbd_handle_t *nbd_handle,
+     const system_character_t *filename,
+     int partition_index,
+     libcerror_error_t **error )
+{
+	static char *function    = "nbd_handle_open_input";
+	int number_of_partitions = 0;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_handle->input_partition != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid NBD handle - input partition value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvsapm_volume_set_bytes_per_sector(
+	     nbd_handle->input_volume,
+	     nbd_handle->bytes_per_sector,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set bytes per sector in input handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libvsapm_volume_open_wide(
+	     nbd_handle->input_volume,
+	     filename,
+	     LIBVSAPM_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libvsapm_volume_open(
+	     nbd_handle->input_volume,
+	     filename,
+	     LIBVSAPM_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open input handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvsapm_volume_get_number_of_partitions(
+	     nbd_handle->input_volume,
+	     &number_of_partitions,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of partitions.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( partition_index < 0 )
+	 || ( partition_index >= number_of_partitions ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid partition index value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvsapm_volume_get_partition_by_index(
+	     nbd_handle->input_volume,
+	     partition_index,
+	     &( nbd_handle->input_partition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve partition: %d.",
+		 function,
+		 partition_index );
+
+		goto on_error;
+	}
+	if( libvsapm_partition_get_volume_offset(
+	     nbd_handle->input_partition,
+	     &( nbd_handle->partition_offset ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve partition volume offset.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvsapm_partition_get_size(
+	     nbd_handle->input_partition,
+	     &( nbd_handle->partition_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve partition size.",
+		 function );
+
+		goto on_error;
+	}
+#if !defined( HAVE_WIDE_SYSTEM_CHARACTER ) && defined( HAVE_PREAD )
+	/* The partition data is stored contiguously in the source, hence the worker
+	 * threads can read it concurrently from a separate descriptor of the same file
+	 */
+	nbd_handle->input_descriptor = open(
+	                                filename,
+	                                O_RDONLY );
+#endif
+	return( 1 );
+
+on_error:
+	if( nbd_handle->input_partition != NULL )
+	{
+		libvsapm_partition_free(
+		 &( nbd_handle->input_partition ),
+		 NULL );
+	}
+	libvsapm_volume_close(
+	 nbd_handle->input_volume,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Closes the input
+ * Returns the 0 if succesful or -1 on error
+ */
+int nbd_handle_close_input(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_handle_close_input";
+	int result            = 0;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_handle->input_descriptor != -1 )
+	{
+		close(
+		 nbd_handle->input_descriptor );
+
+		nbd_handle->input_descriptor = -1;
+	}
+	if( nbd_handle->input_partition != NULL )
+	{
+		if( libvsapm_partition_free(
+		     &( nbd_handle->input_partition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free input partition.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libvsapm_volume_close(
+	     nbd_handle->input_volume,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close input handle.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+/* Opens the Unix domain socket the NBD clients connect to
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_open_socket(
+     nbd_handle_t *nbd_handle,
+     const char *socket_path,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_SYS_SOCKET_H ) && defined( HAVE_SYS_UN_H )
+	struct sockaddr_un socket_address;
+
+	size_t socket_path_length = 0;
+#endif
+
+	static char *function     = "nbd_handle_open_socket";
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_handle->listen_descriptor != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid NBD handle - listen descriptor value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( socket_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid socket path.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_SYS_SOCKET_H ) && defined( HAVE_SYS_UN_H )
+	socket_path_length = narrow_string_length(
+	                      socket_path );
+
+	if( ( socket_path_length == 0 )
+	 || ( socket_path_length >= sizeof( socket_address.sun_path ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid socket path length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     &socket_address,
+	     0,
+	     sizeof( struct sockaddr_un ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear socket address.",
+		 function );
+
+		return( -1 );
+	}
+	socket_address.sun_family = AF_UNIX;
+
+	if( memory_copy(
+	     socket_address.sun_path,
+	     socket_path,
+	     socket_path_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy socket path.",
+		 function );
+
+		return( -1 );
+	}
+	nbd_handle->socket_path = narrow_string_allocate(
+	                           socket_path_length + 1 );
+
+	if( nbd_handle->socket_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create socket path.",
+		 function );
+
+		goto on_error;
+	}
+	if( narrow_string_copy(
+	     nbd_handle->socket_path,
+	     socket_path,
+	     socket_path_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy socket path.",
+		 function );
+
+		goto on_error;
+	}
+	nbd_handle->socket_path[ socket_path_length ] = 0;
+
+	nbd_handle->listen_descriptor = socket(
+	                                 AF_UNIX,
+	                                 SOCK_STREAM,
+	                                 0 );
+
+	if( nbd_handle->listen_descriptor == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to create socket.",
+		 function );
+
+		goto on_error;
+	}
+	/* An existing file is not removed, since the socket path could be
+	 * in use by another server
+	 */
+	if( bind(
+	     nbd_handle->listen_descriptor,
+	     (struct sockaddr *) &socket_address,
+	     sizeof( struct sockaddr_un ) ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to bind socket to path: %s.",
+		 function,
+		 socket_path );
+
+		goto on_error;
+	}
+	if( listen(
+	     nbd_handle->listen_descriptor,
+	     1 ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to listen on socket.",
+		 function );
+
+		unlink(
+		 nbd_handle->socket_path );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( nbd_handle->listen_descriptor != -1 )
+	{
+		close(
+		 nbd_handle->listen_descriptor );
+
+		nbd_handle->listen_descriptor = -1;
+	}
+	if( nbd_handle->socket_path != NULL )
+	{
+		memory_free(
+		 nbd_handle->socket_path );
+
+		nbd_handle->socket_path = NULL;
+	}
+	return( -1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: Unix domain sockets are not supported.",
+	 function );
+
+	return( -1 );
+#endif /* defined( HAVE_SYS_SOCKET_H ) && defined( HAVE_SYS_UN_H ) */
+}
+
+/* Closes the Unix domain socket and removes the socket path
+ * Returns the 0 if succesful or -1 on error
+ */
+int nbd_handle_close_socket(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_handle_close_socket";
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_handle->listen_descriptor != -1 )
+	{
+		close(
+		 nbd_handle->listen_descriptor );
+
+		nbd_handle->listen_descriptor = -1;
+	}
+	if( nbd_handle->socket_path != NULL )
+	{
+		unlink(
+		 nbd_handle->socket_path );
+
+		memory_free(
+		 nbd_handle->socket_path );
+
+		nbd_handle->socket_path = NULL;
+	}
+	return( 0 );
+}
+
+/* Serves the NBD clients one connection at a time until abort is signalled
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_serve(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_SYS_SOCKET_H )
+	libcerror_error_t *connection_error = NULL;
+	int result                          = 0;
+#endif
+
+	static char *function               = "nbd_handle_serve";
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_handle->listen_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid NBD handle - missing listen descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_handle->input_partition == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid NBD handle - missing input partition.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_SYS_SOCKET_H )
+	while( nbd_handle->abort == 0 )
+	{
+		nbd_handle->connection_descriptor = accept(
+		                                     nbd_handle->listen_descriptor,
+		                                     NULL,
+		                                     NULL );
+
+		if( nbd_handle->connection_descriptor == -1 )
+		{
+			if( nbd_handle->abort != 0 )
+			{
+				break;
+			}
+			if( ( errno == EINTR )
+			 || ( errno == ECONNABORTED ) )
+			{
+				continue;
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 errno,
+			 "%s: unable to accept connection.",
+			 function );
+
+			return( -1 );
+		}
+		if( nbd_handle->notify_stream != NULL )
+		{
+			fprintf(
+			 nbd_handle->notify_stream,
+			 "Client connected.\n" );
+		}
+		nbd_handle->use_structured_replies = 0;
+
+		result = nbd_handle_negotiate(
+		          nbd_handle,
+		          &connection_error );
+
+		if( result == 1 )
+		{
+			result = nbd_handle_transmit(
+			          nbd_handle,
+			          &connection_error );
+		}
+		if( result == -1 )
+		{
+			/* An error on a connection only ends that connection
+			 */
+			libcnotify_print_error_backtrace(
+			 connection_error );
+			libcerror_error_free(
+			 &connection_error );
+		}
+		close(
+		 nbd_handle->connection_descriptor );
+
+		nbd_handle->connection_descriptor = -1;
+
+		if( nbd_handle->notify_stream != NULL )
+		{
+			fprintf(
+			 nbd_handle->notify_stream,
+			 "Client disconnected.\n" );
+		}
+	}
+	return( 1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: sockets are not supported.",
+	 function );
+
+	return( -1 );
+#endif /* defined( HAVE_SYS_SOCKET_H ) */
+}
+
+/* Reads data from the connection
+ * Returns 1 if successful, 0 if the connection was closed or -1 on error
+ */
+int nbd_handle_read_data(
+     nbd_handle_t *nbd_handle,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_handle_read_data";
+	size_t data_offset    = 0;
+	ssize_t read_count    = 0;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( data_offset < data_size )
+	{
+		read_count = read(
+		              nbd_handle->connection_descriptor,
+		              &( data[ data_offset ] ),
+		              data_size - data_offset );
+
+		if( read_count < 0 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 errno,
+			 "%s: unable to read from connection.",
+			 function );
+
+			return( -1 );
+		}
+		else if( read_count == 0 )
+		{
+			return( 0 );
+		}
+		data_offset += (size_t) read_count;
+	}
+	return( 1 );
+}
+
+/* Writes data to the connection
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_write_data(
+     nbd_handle_t *nbd_handle,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_handle_write_data";
+	size_t data_offset    = 0;
+	ssize_t write_count   = 0;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( data_offset < data_size )
+	{
+		/* Use send, when available, so that a disconnected client
+		 * results in an error instead of a SIGPIPE
+		 */
+#if defined( HAVE_SYS_SOCKET_H )
+		write_count = send(
+		               nbd_handle->connection_descriptor,
+		               &( data[ data_offset ] ),
+		               data_size - data_offset,
+		               NBD_HANDLE_SEND_FLAGS );
+#else
+		write_count = write(
+		               nbd_handle->connection_descriptor,
+		               &( data[ data_offset ] ),
+		               data_size - data_offset );
+#endif
+		if( write_count < 0 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 errno,
+			 "%s: unable to write to connection.",
+			 function );
+
+			return( -1 );
+		}
+		data_offset += (size_t) write_count;
+	}
+	return( 1 );
+}
+
+/* Writes an option reply
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_write_option_reply(
+     nbd_handle_t *nbd_handle,
+     uint32_t option,
+     uint32_t reply_type,
+     const uint8_t *data,
+     uint32_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t reply_header[ 20 ];
+
+	static char *function = "nbd_handle_write_option_reply";
+
+	if( ( data == NULL )
+	 && ( data_size != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint64_big_endian(
+	 &( reply_header[ 0 ] ),
+	 NBD_OPTION_REPLY_MAGIC );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_header[ 8 ] ),
+	 option );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_header[ 12 ] ),
+	 reply_type );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_header[ 16 ] ),
+	 data_size );
+
+	if( nbd_handle_write_data(
+	     nbd_handle,
+	     reply_header,
+	     20,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write option reply header.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > 0 )
+	{
+		if( nbd_handle_write_data(
+		     nbd_handle,
+		     data,
+		     (size_t) data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write option reply data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Negotiates the options of a connection using the fixed newstyle handshake
+ * The export name requested by the client is ignored since only one partition is exported
+ * Returns 1 if the transmission phase was entered, 0 if the client ended the negotiation or -1 on error
+ */
+int nbd_handle_negotiate(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error )
+{
+	uint8_t option_data[ NBD_HANDLE_MAXIMUM_OPTION_SIZE ];
+	uint8_t reply_data[ 12 + 124 ];
+	uint8_t handshake_data[ 18 ];
+	uint8_t option_header[ 16 ];
+
+	static char *function              = "nbd_handle_negotiate";
+	uint64_t option_magic              = 0;
+	uint32_t client_flags              = 0;
+	uint32_t export_name_size          = 0;
+	uint32_t option                    = 0;
+	uint32_t option_size               = 0;
+	uint16_t information_request_index = 0;
+	uint16_t information_type          = 0;
+	uint16_t number_of_information_requests = 0;
+	uint16_t transmission_flags        = 0;
+	int block_size_requested           = 0;
+	int result                         = 0;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint64_big_endian(
+	 &( handshake_data[ 0 ] ),
+	 NBD_MAGIC );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( handshake_data[ 8 ] ),
+	 NBD_OPTION_MAGIC );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( handshake_data[ 16 ] ),
+	 NBD_FLAG_FIXED_NEWSTYLE | NBD_FLAG_NO_ZEROES );
+
+	if( nbd_handle_write_data(
+	     nbd_handle,
+	     handshake_data,
+	     18,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write handshake.",
+		 function );
+
+		return( -1 );
+	}
+	result = nbd_handle_read_data(
+	          nbd_handle,
+	          handshake_data,
+	          4,
+	          error );
+
+	if( result != 1 )
+	{
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read client flags.",
+			 function );
+		}
+		return( result );
+	}
+	byte_stream_copy_to_uint32_big_endian(
+	 handshake_data,
+	 client_flags );
+
+	if( ( client_flags & NBD_FLAG_FIXED_NEWSTYLE ) == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported client flags: 0x%08" PRIx32 ".",
+		 function,
+		 client_flags );
+
+		return( -1 );
+	}
+	while( nbd_handle->abort == 0 )
+	{
+		result = nbd_handle_read_data(
+		          nbd_handle,
+		          option_header,
+		          16,
+		          error );
+
+		if( result != 1 )
+		{
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read option header.",
+				 function );
+			}
+			return( result );
+		}
+		byte_stream_copy_to_uint64_big_endian(
+		 &( option_header[ 0 ] ),
+		 option_magic );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 &( option_header[ 8 ] ),
+		 option );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 &( option_header[ 12 ] ),
+		 option_size );
+
+		if( option_magic != NBD_OPTION_MAGIC )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_INPUT,
+			 LIBCERROR_INPUT_ERROR_SIGNATURE_MISMATCH,
+			 "%s: unsupported option magic.",
+			 function );
+
+			return( -1 );
+		}
+		if( option_size > NBD_HANDLE_MAXIMUM_OPTION_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid option: %" PRIu32 " size value out of bounds.",
+			 function,
+			 option );
+
+			return( -1 );
+		}
+		if( option_size > 0 )
+		{
+			result = nbd_handle_read_data(
+			          nbd_handle,
+			          option_data,
+			          (size_t) option_size,
+			          error );
+
+			if( result != 1 )
+			{
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read option data.",
+					 function );
+				}
+				return( result );
+			}
+		}
+		transmission_flags = NBD_FLAG_HAS_FLAGS | NBD_FLAG_READ_ONLY;
+
+		if( nbd_handle->use_structured_replies != 0 )
+		{
+			transmission_flags |= NBD_FLAG_SEND_DF;
+		}
+		switch( option )
+		{
+			case NBD_OPT_EXPORT_NAME:
+				if( memory_set(
+				     reply_data,
+				     0,
+				     12 + 124 ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to clear reply data.",
+					 function );
+
+					return( -1 );
+				}
+				byte_stream_copy_from_uint64_big_endian(
+				 &( reply_data[ 0 ] ),
+				 nbd_handle->partition_size );
+
+				byte_stream_copy_from_uint16_big_endian(
+				 &( reply_data[ 8 ] ),
+				 transmission_flags );
+
+				if( nbd_handle_write_data(
+				     nbd_handle,
+				     reply_data,
+				     ( ( client_flags & NBD_FLAG_NO_ZEROES ) != 0 ) ? 10 : 10 + 124,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write export information.",
+					 function );
+
+					return( -1 );
+				}
+				return( 1 );
+
+			case NBD_OPT_ABORT:
+				if( nbd_handle_write_option_reply(
+				     nbd_handle,
+				     option,
+				     NBD_REP_ACK,
+				     NULL,
+				     0,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write option reply.",
+					 function );
+
+					return( -1 );
+				}
+				return( 0 );
+
+			case NBD_OPT_LIST:
+				if( option_size != 0 )
+				{
+					result = nbd_handle_write_option_reply(
+					          nbd_handle,
+					          option,
+					          NBD_REP_ERR_INVALID,
+					          NULL,
+					          0,
+					          error );
+				}
+				else
+				{
+					/* The partition is exported as the default export with an empty name
+					 */
+					byte_stream_copy_from_uint32_big_endian(
+					 reply_data,
+					 0 );
+
+					result = nbd_handle_write_option_reply(
+					          nbd_handle,
+					          option,
+					          NBD_REP_SERVER,
+					          reply_data,
+					          4,
+					          error );
+
+					if( result == 1 )
+					{
+						result = nbd_handle_write_option_reply(
+						          nbd_handle,
+						          option,
+						          NBD_REP_ACK,
+						          NULL,
+						          0,
+						          error );
+					}
+				}
+				break;
+
+			case NBD_OPT_STRUCTURED_REPLY:
+				if( option_size != 0 )
+				{
+					result = nbd_handle_write_option_reply(
+					          nbd_handle,
+					          option,
+					          NBD_REP_ERR_INVALID,
+					          NULL,
+					          0,
+					          error );
+				}
+				else
+				{
+					nbd_handle->use_structured_replies = 1;
+
+					result = nbd_handle_write_option_reply(
+					          nbd_handle,
+					          option,
+					          NBD_REP_ACK,
+					          NULL,
+					          0,
+					          error );
+				}
+				break;
+
+			case NBD_OPT_INFO:
+			case NBD_OPT_GO:
+				result = 1;
+
+				if( option_size < 6 )
+				{
+					result = 0;
+				}
+				else
+				{
+					byte_stream_copy_to_uint32_big_endian(
+					 option_data,
+					 export_name_size );
+
+					if( export_name_size > ( option_size - 6 ) )
+					{
+						result = 0;
+					}
+				}
+				if( result != 0 )
+				{
+					byte_stream_copy_to_uint16_big_endian(
+					 &( option_data[ 4 + export_name_size ] ),
+					 number_of_information_requests );
+
+					if( option_size != ( 6 + export_name_size + ( 2 * (uint32_t) number_of_information_requests ) ) )
+					{
+						result = 0;
+					}
+				}
+				if( result == 0 )
+				{
+					result = nbd_handle_write_option_reply(
+					          nbd_handle,
+					          option,
+					          NBD_REP_ERR_INVALID,
+					          NULL,
+					          0,
+					          error );
+
+					break;
+				}
+				block_size_requested = 0;
+
+				for( information_request_index = 0;
+				     information_request_index < number_of_information_requests;
+				     information_request_index++ )
+				{
+					byte_stream_copy_to_uint16_big_endian(
+					 &( option_data[ 6 + export_name_size + ( 2 * information_request_index ) ] ),
+					 information_type );
+
+					if( information_type == NBD_INFO_BLOCK_SIZE )
+					{
+						block_size_requested = 1;
+					}
+				}
+				byte_stream_copy_from_uint16_big_endian(
+				 &( reply_data[ 0 ] ),
+				 NBD_INFO_EXPORT );
+
+				byte_stream_copy_from_uint64_big_endian(
+				 &( reply_data[ 2 ] ),
+				 nbd_handle->partition_size );
+
+				byte_stream_copy_from_uint16_big_endian(
+				 &( reply_data[ 10 ] ),
+				 transmission_flags );
+
+				result = nbd_handle_write_option_reply(
+				          nbd_handle,
+				          option,
+				          NBD_REP_INFO,
+				          reply_data,
+				          12,
+				          error );
+
+				if( ( result == 1 )
+				 && ( block_size_requested != 0 ) )
+				{
+					byte_stream_copy_from_uint16_big_endian(
+					 &( reply_data[ 0 ] ),
+					 NBD_INFO_BLOCK_SIZE );
+
+					byte_stream_copy_from_uint32_big_endian(
+					 &( reply_data[ 2 ] ),
+					 1 );
+
+					byte_stream_copy_from_uint32_big_endian(
+					 &( reply_data[ 6 ] ),
+					 NBD_HANDLE_HOLE_BLOCK_SIZE );
+
+					byte_stream_copy_from_uint32_big_endian(
+					 &( reply_data[ 10 ] ),
+					 NBD_HANDLE_MAXIMUM_READ_SIZE );
+
+					result = nbd_handle_write_option_reply(
+					          nbd_handle,
+					          option,
+					          NBD_REP_INFO,
+					          reply_data,
+					          14,
+					          error );
+				}
+				if( result == 1 )
+				{
+					result = nbd_handle_write_option_reply(
+					          nbd_handle,
+					          option,
+					          NBD_REP_ACK,
+					          NULL,
+					          0,
+					          error );
+				}
+				if( ( result == 1 )
+				 && ( option == NBD_OPT_GO ) )
+				{
+					return( 1 );
+				}
+				break;
+
+			default:
+				result = nbd_handle_write_option_reply(
+				          nbd_handle,
+				          option,
+				          NBD_REP_ERR_UNSUP,
+				          NULL,
+				          0,
+				          error );
+
+				break;
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write reply to option: %" PRIu32 ".",
+			 function,
+			 option );
+
+			return( -1 );
+		}
+	}
+	return( 0 );
+}
+
+/* Handles the requests of a connection in the transmission phase
+ * Read requests are handed to the request thread pool, so multiple requests
+ * can be in-flight at the same time and their replies can be sent out of order
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_transmit(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error )
+{
+	uint8_t discard_data[ 4096 ];
+	uint8_t request_header[ 28 ];
+
+	nbd_handle_request_t *request = NULL;
+	static char *function         = "nbd_handle_transmit";
+	uint64_t cookie               = 0;
+	uint64_t offset               = 0;
+	uint32_t request_magic        = 0;
+	uint32_t discard_size         = 0;
+	uint32_t size                 = 0;
+	uint16_t command_flags        = 0;
+	uint16_t command_type         = 0;
+	int result                    = 0;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( nbd_handle->request_thread_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid NBD handle - request thread pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_thread_pool_create(
+	     &( nbd_handle->request_thread_pool ),
+	     NULL,
+	     nbd_handle->number_of_threads,
+	     nbd_handle->number_of_threads * NBD_HANDLE_MAXIMUM_NUMBER_OF_PENDING_REQUESTS_PER_THREAD,
+	     (int (*)(intptr_t *, void *)) &nbd_handle_process_request_callback,
+	     (void *) nbd_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create request thread pool.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	while( nbd_handle->abort == 0 )
+	{
+		result = nbd_handle_read_data(
+		          nbd_handle,
+		          request_header,
+		          28,
+		          error );
+
+		if( result == 0 )
+		{
+			break;
+		}
+		else if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read request header.",
+			 function );
+
+			goto on_error;
+		}
+		byte_stream_copy_to_uint32_big_endian(
+		 &( request_header[ 0 ] ),
+		 request_magic );
+
+		byte_stream_copy_to_uint16_big_endian(
+		 &( request_header[ 4 ] ),
+		 command_flags );
+
+		byte_stream_copy_to_uint16_big_endian(
+		 &( request_header[ 6 ] ),
+		 command_type );
+
+		byte_stream_copy_to_uint64_big_endian(
+		 &( request_header[ 8 ] ),
+		 cookie );
+
+		byte_stream_copy_to_uint64_big_endian(
+		 &( request_header[ 16 ] ),
+		 offset );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 &( request_header[ 24 ] ),
+		 size );
+
+		if( request_magic != NBD_REQUEST_MAGIC )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_INPUT,
+			 LIBCERROR_INPUT_ERROR_SIGNATURE_MISMATCH,
+			 "%s: unsupported request magic.",
+			 function );
+
+			goto on_error;
+		}
+		if( command_type == NBD_CMD_DISC )
+		{
+			break;
+		}
+		result = 1;
+
+		switch( command_type )
+		{
+			case NBD_CMD_READ:
+				if( ( size == 0 )
+				 || ( size > NBD_HANDLE_MAXIMUM_READ_SIZE )
+				 || ( offset > nbd_handle->partition_size )
+				 || ( (uint64_t) size > ( nbd_handle->partition_size - offset ) ) )
+				{
+					result = nbd_handle_write_error_reply(
+					          nbd_handle,
+					          cookie,
+					          NBD_EINVAL,
+					          error );
+
+					break;
+				}
+				request = memory_allocate_structure(
+				           nbd_handle_request_t );
+
+				if( request == NULL )
+				{
+					result = nbd_handle_write_error_reply(
+					          nbd_handle,
+					          cookie,
+					          NBD_ENOMEM,
+					          error );
+
+					break;
+				}
+				request->cookie        = cookie;
+				request->offset        = offset;
+				request->size          = size;
+				request->command_flags = command_flags;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+				/* The push blocks when the maximum number of requests are pending
+				 */
+				if( libcthreads_thread_pool_push(
+				     nbd_handle->request_thread_pool,
+				     (intptr_t *) request,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to push request onto request thread pool queue.",
+					 function );
+
+					goto on_error;
+				}
+				request = NULL;
+#else
+				nbd_handle_process_request_callback(
+				 request,
+				 nbd_handle );
+
+				request = NULL;
+#endif
+				break;
+
+			case NBD_CMD_WRITE:
+				/* The partition is exported read-only, hence the data
+				 * of a write request is discarded
+				 */
+				if( size > NBD_HANDLE_MAXIMUM_READ_SIZE )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+					 "%s: invalid write request size value out of bounds.",
+					 function );
+
+					goto on_error;
+				}
+				while( size > 0 )
+				{
+					discard_size = ( size > 4096 ) ? 4096 : size;
+
+					if( nbd_handle_read_data(
+					     nbd_handle,
+					     discard_data,
+					     (size_t) discard_size,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_READ_FAILED,
+						 "%s: unable to read write request data.",
+						 function );
+
+						goto on_error;
+					}
+					size -= discard_size;
+				}
+				result = nbd_handle_write_error_reply(
+				          nbd_handle,
+				          cookie,
+				          NBD_EPERM,
+				          error );
+
+				break;
+
+			case NBD_CMD_FLUSH:
+				result = nbd_handle_write_simple_reply(
+				          nbd_handle,
+				          cookie,
+				          0,
+				          NULL,
+				          0,
+				          error );
+
+				break;
+
+			default:
+				result = nbd_handle_write_error_reply(
+				          nbd_handle,
+				          cookie,
+				          NBD_EINVAL,
+				          error );
+
+				break;
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write reply.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* Joining the thread pool waits for the in-flight requests to be replied
+	 */
+	if( libcthreads_thread_pool_join(
+	     &( nbd_handle->request_thread_pool ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to join request thread pool.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( request != NULL )
+	{
+		memory_free(
+		 request );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( nbd_handle->request_thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &( nbd_handle->request_thread_pool ),
+		 NULL );
+	}
+#endif
+	return( -1 );
+}
+
+/* Reads data at a specific offset of the partition
+ * When an input file descriptor is available the data is read with
+ * a positional read, which allows concurrent reads without locking
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t nbd_handle_read_buffer_at_offset(
+         nbd_handle_t *nbd_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function = "nbd_handle_read_buffer_at_offset";
+	ssize_t read_count    = 0;
+
+#if defined( HAVE_PREAD )
+	size_t buffer_offset  = 0;
+#endif
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_PREAD )
+	if( nbd_handle->input_descriptor != -1 )
+	{
+		if( (size64_t) offset >= nbd_handle->partition_size )
+		{
+			return( 0 );
+		}
+		if( (size64_t) buffer_size > ( nbd_handle->partition_size - (size64_t) offset ) )
+		{
+			buffer_size = (size_t) ( nbd_handle->partition_size - (size64_t) offset );
+		}
+		offset += nbd_handle->partition_offset;
+
+		while( buffer_offset < buffer_size )
+		{
+			read_count = pread(
+			              nbd_handle->input_descriptor,
+			              &( buffer[ buffer_offset ] ),
+			              buffer_size - buffer_offset,
+			              (off_t) offset );
+
+			if( read_count < 0 )
+			{
+				if( errno == EINTR )
+				{
+					continue;
+				}
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 errno,
+				 "%s: unable to read data at offset: %" PRIi64 ".",
+				 function,
+				 offset );
+
+				return( -1 );
+			}
+			else if( read_count == 0 )
+			{
+				break;
+			}
+			buffer_offset += (size_t) read_count;
+			offset        += (off64_t) read_count;
+		}
+		return( (ssize_t) buffer_offset );
+	}
+#endif /* defined( HAVE_PREAD ) */
+
+	read_count = libvsapm_partition_read_buffer_at_offset(
+	              nbd_handle->input_partition,
+	              buffer,
+	              buffer_size,
+	              offset,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ") from partition.",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
+/* Writes a simple reply
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_write_simple_reply(
+     nbd_handle_t *nbd_handle,
+     uint64_t cookie,
+     uint32_t error_value,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t reply_header[ 16 ];
+
+	static char *function = "nbd_handle_write_simple_reply";
+	int result            = 1;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_header[ 0 ] ),
+	 NBD_SIMPLE_REPLY_MAGIC );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_header[ 4 ] ),
+	 error_value );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( reply_header[ 8 ] ),
+	 cookie );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     nbd_handle->reply_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab reply mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( nbd_handle_write_data(
+	     nbd_handle,
+	     reply_header,
+	     16,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write reply header.",
+		 function );
+
+		result = -1;
+	}
+	else if( ( data != NULL )
+	      && ( data_size > 0 ) )
+	{
+		if( nbd_handle_write_data(
+		     nbd_handle,
+		     data,
+		     data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write reply data.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     nbd_handle->reply_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release reply mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Writes a structured reply chunk
+ * The caller is responsible for serializing the replies with the reply mutex
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_write_structured_reply_chunk(
+     nbd_handle_t *nbd_handle,
+     uint64_t cookie,
+     uint16_t reply_flags,
+     uint16_t reply_type,
+     const uint8_t *payload_header,
+     size_t payload_header_size,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t chunk_header[ 20 ];
+
+	static char *function = "nbd_handle_write_structured_reply_chunk";
+
+	if( payload_header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid payload header.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( payload_header_size + data_size ) > (size_t) UINT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid payload size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_big_endian(
+	 &( chunk_header[ 0 ] ),
+	 NBD_STRUCTURED_REPLY_MAGIC );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( chunk_header[ 4 ] ),
+	 reply_flags );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( chunk_header[ 6 ] ),
+	 reply_type );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( chunk_header[ 8 ] ),
+	 cookie );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( chunk_header[ 16 ] ),
+	 (uint32_t) ( payload_header_size + data_size ) );
+
+	if( nbd_handle_write_data(
+	     nbd_handle,
+	     chunk_header,
+	     20,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write chunk header.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_handle_write_data(
+	     nbd_handle,
+	     payload_header,
+	     payload_header_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write chunk payload header.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data != NULL )
+	 && ( data_size > 0 ) )
+	{
+		if( nbd_handle_write_data(
+		     nbd_handle,
+		     data,
+		     data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write chunk data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Writes the reply of a read request
+ * When structured replies were negotiated runs of all-zero blocks are sent
+ * as hole chunks without data, unless the client asked not to fragment the reply
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_write_read_reply(
+     nbd_handle_t *nbd_handle,
+     nbd_handle_request_t *request,
+     const uint8_t *data,
+     libcerror_error_t **error )
+{
+	uint8_t payload_header[ 12 ];
+
+	static char *function = "nbd_handle_write_read_reply";
+	size_t block_size     = 0;
+	size_t data_offset    = 0;
+	size_t run_end_offset = 0;
+	uint16_t reply_flags  = 0;
+	int run_is_zero       = 0;
+	int result            = 1;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid request.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_handle->use_structured_replies == 0 )
+	{
+		return( nbd_handle_write_simple_reply(
+		         nbd_handle,
+		         request->cookie,
+		         0,
+		         data,
+		         (size_t) request->size,
+		         error ) );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     nbd_handle->reply_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab reply mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	while( data_offset < (size_t) request->size )
+	{
+		if( ( request->command_flags & NBD_CMD_FLAG_DF ) != 0 )
+		{
+			run_is_zero    = 0;
+			run_end_offset = (size_t) request->size;
+		}
+		else
+		{
+			/* Determine the run of blocks that are all zero or all not zero
+			 */
+			run_end_offset = data_offset;
+
+			while( run_end_offset < (size_t) request->size )
+			{
+				block_size = (size_t) request->size - run_end_offset;
+
+				if( block_size > NBD_HANDLE_HOLE_BLOCK_SIZE )
+				{
+					block_size = NBD_HANDLE_HOLE_BLOCK_SIZE;
+				}
+				if( run_end_offset == data_offset )
+				{
+					run_is_zero = export_handle_is_zero_block(
+					               &( data[ run_end_offset ] ),
+					               block_size );
+				}
+				else if( export_handle_is_zero_block(
+				          &( data[ run_end_offset ] ),
+				          block_size ) != run_is_zero )
+				{
+					break;
+				}
+				run_end_offset += block_size;
+			}
+		}
+		reply_flags = 0;
+
+		if( run_end_offset >= (size_t) request->size )
+		{
+			reply_flags = NBD_REPLY_FLAG_DONE;
+		}
+		byte_stream_copy_from_uint64_big_endian(
+		 &( payload_header[ 0 ] ),
+		 request->offset + (uint64_t) data_offset );
+
+		if( run_is_zero != 0 )
+		{
+			byte_stream_copy_from_uint32_big_endian(
+			 &( payload_header[ 8 ] ),
+			 (uint32_t) ( run_end_offset - data_offset ) );
+
+			result = nbd_handle_write_structured_reply_chunk(
+			          nbd_handle,
+			          request->cookie,
+			          reply_flags,
+			          NBD_REPLY_TYPE_OFFSET_HOLE,
+			          payload_header,
+			          12,
+			          NULL,
+			          0,
+			          error );
+		}
+		else
+		{
+			result = nbd_handle_write_structured_reply_chunk(
+			          nbd_handle,
+			          request->cookie,
+			          reply_flags,
+			          NBD_REPLY_TYPE_OFFSET_DATA,
+			          payload_header,
+			          8,
+			          &( data[ data_offset ] ),
+			          run_end_offset - data_offset,
+			          error );
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write reply chunk.",
+			 function );
+
+			break;
+		}
+		data_offset = run_end_offset;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     nbd_handle->reply_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release reply mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Writes an error reply
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_write_error_reply(
+     nbd_handle_t *nbd_handle,
+     uint64_t cookie,
+     uint32_t error_value,
+     libcerror_error_t **error )
+{
+	uint8_t payload_header[ 6 ];
+
+	static char *function = "nbd_handle_write_error_reply";
+	int result            = 0;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_handle->use_structured_replies == 0 )
+	{
+		return( nbd_handle_write_simple_reply(
+		         nbd_handle,
+		         cookie,
+		         error_value,
+		         NULL,
+		         0,
+		         error ) );
+	}
+	byte_stream_copy_from_uint32_big_endian(
+	 &( payload_header[ 0 ] ),
+	 error_value );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( payload_header[ 4 ] ),
+	 0 );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     nbd_handle->reply_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab reply mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = nbd_handle_write_structured_reply_chunk(
+	          nbd_handle,
+	          cookie,
+	          NBD_REPLY_FLAG_DONE,
+	          NBD_REPLY_TYPE_ERROR,
+	          payload_header,
+	          6,
+	          NULL,
+	          0,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write error chunk.",
+		 function );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     nbd_handle->reply_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release reply mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Callback function to process a read request
+ * The request is freed by this function
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_process_request_callback(
+     nbd_handle_request_t *request,
+     nbd_handle_t *nbd_handle )
+{
+	libcerror_error_t *error = NULL;
+	uint8_t *data            = NULL;
+	static char *function    = "nbd_handle_process_request_callback";
+	ssize_t read_count       = 0;
+	int result               = 0;
+
+	if( request == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid request.",
+		 function );
+
+		goto on_error;
+	}
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * request->size );
+
+	if( data == NULL )
+	{
+		result = nbd_handle_write_error_reply(
+		          nbd_handle,
+		          request->cookie,
+		          NBD_ENOMEM,
+		          &error );
+	}
+	else
+	{
+		read_count = nbd_handle_read_buffer_at_offset(
+		              nbd_handle,
+		              data,
+		              (size_t) request->size,
+		              (off64_t) request->offset,
+		              &error );
+
+		if( read_count != (ssize_t) request->size )
+		{
+			if( error != NULL )
+			{
+				libcnotify_print_error_backtrace(
+				 error );
+				libcerror_error_free(
+				 &error );
+			}
+			result = nbd_handle_write_error_reply(
+			          nbd_handle,
+			          request->cookie,
+			          NBD_EIO,
+			          &error );
+		}
+		else
+		{
+			result = nbd_handle_write_read_reply(
+			          nbd_handle,
+			          request,
+			          data,
+			          &error );
+		}
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write reply.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 data );
+
+	memory_free(
+	 request );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	if( request != NULL )
+	{
+		memory_free(
+		 request );
+	}
+	return( -1 );
+}
+
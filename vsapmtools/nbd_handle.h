@@ -0,0 +1,333 @@
+/*
+ * Network Block Device (NBD) handle
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _NBD_HANDLE_H )
+#define _NBD_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "vsapmtools_libcerror.h"
+#include "vsapmtools_libcthreads.h"
+#include "vsapmtools_libvsapm.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The maximum number of requests that can be pending per thread
+ */
+#define NBD_HANDLE_MAXIMUM_NUMBER_OF_PENDING_REQUESTS_PER_THREAD	4
+
+/* The default number of threads
+ */
+#define NBD_HANDLE_DEFAULT_NUMBER_OF_THREADS				4
+
+/* The maximum number of threads
+ */
+#define NBD_HANDLE_MAXIMUM_NUMBER_OF_THREADS				64
+
+/* The maximum size of the data of a read request
+ */
+#define NBD_HANDLE_MAXIMUM_READ_SIZE					( 32 * 1024 * 1024 )
+
+/* The maximum size of the data of a negotiation option
+ */
+#define NBD_HANDLE_MAXIMUM_OPTION_SIZE					4096
+
+/* The size of the blocks that are checked for being all zero
+ * and reported as holes in structured replies
+ */
+#define NBD_HANDLE_HOLE_BLOCK_SIZE					4096
+
+/* The NBD protocol magic values
+ */
+#define NBD_MAGIC							0x4e42444d41474943ULL
+#define NBD_OPTION_MAGIC						0x49484156454f5054ULL
+#define NBD_OPTION_REPLY_MAGIC						0x0003e889045565a9ULL
+#define NBD_REQUEST_MAGIC						0x25609513UL
+#define NBD_SIMPLE_REPLY_MAGIC						0x67446698UL
+#define NBD_STRUCTURED_REPLY_MAGIC					0x668e33efUL
+
+/* The NBD protocol handshake flags
+ */
+#define NBD_FLAG_FIXED_NEWSTYLE						0x0001
+#define NBD_FLAG_NO_ZEROES						0x0002
+
+/* The NBD protocol transmission flags
+ */
+#define NBD_FLAG_HAS_FLAGS						0x0001
+#define NBD_FLAG_READ_ONLY						0x0002
+#define NBD_FLAG_SEND_DF						0x0080
+
+/* The NBD protocol options
+ */
+#define NBD_OPT_EXPORT_NAME						1
+#define NBD_OPT_ABORT							2
+#define NBD_OPT_LIST							3
+#define NBD_OPT_INFO							6
+#define NBD_OPT_GO							7
+#define NBD_OPT_STRUCTURED_REPLY					8
+
+/* The NBD protocol option reply types
+ */
+#define NBD_REP_ACK							1
+#define NBD_REP_SERVER							2
+#define NBD_REP_INFO							3
+#define NBD_REP_ERR_UNSUP						0x80000001UL
+#define NBD_REP_ERR_INVALID						0x80000003UL
+
+/* The NBD protocol information types
+ */
+#define NBD_INFO_EXPORT							0
+#define NBD_INFO_BLOCK_SIZE						3
+
+/* The NBD protocol commands
+ */
+#define NBD_CMD_READ							0
+#define NBD_CMD_WRITE							1
+#define NBD_CMD_DISC							2
+#define NBD_CMD_FLUSH							3
+
+/* The NBD protocol command flags
+ */
+#define NBD_CMD_FLAG_DF							0x0002
+
+/* The NBD protocol structured reply flags and types
+ */
+#define NBD_REPLY_FLAG_DONE						0x0001
+#define NBD_REPLY_TYPE_OFFSET_DATA					1
+#define NBD_REPLY_TYPE_OFFSET_HOLE					2
+#define NBD_REPLY_TYPE_ERROR						32769
+
+/* The NBD protocol error values
+ */
+#define NBD_EPERM							1
+#define NBD_EIO								5
+#define NBD_ENOMEM							12
+#define NBD_EINVAL							22
+
+typedef struct nbd_handle_request nbd_handle_request_t;
+
+struct nbd_handle_request
+{
+	/* The cookie used by the client to match the reply
+	 */
+	uint64_t cookie;
+
+	/* The offset of the data in the partition
+	 */
+	uint64_t offset;
+
+	/* The size of the data
+	 */
+	uint32_t size;
+
+	/* The command flags
+	 */
+	uint16_t command_flags;
+};
+
+typedef struct nbd_handle nbd_handle_t;
+
+struct nbd_handle
+{
+	/* The number of bytes per sector
+	 */
+	uint32_t bytes_per_sector;
+
+	/* The number of threads
+	 */
+	int number_of_threads;
+
+	/* The libvsapm input volume
+	 */
+	libvsapm_volume_t *input_volume;
+
+	/* The libvsapm input partition
+	 */
+	libvsapm_partition_t *input_partition;
+
+	/* The offset of the partition in the volume
+	 */
+	off64_t partition_offset;
+
+	/* The size of the partition
+	 */
+	size64_t partition_size;
+
+	/* The input file descriptor used for positional reads or -1 if not available
+	 */
+	int input_descriptor;
+
+	/* The path of the Unix domain socket
+	 */
+	char *socket_path;
+
+	/* The listening socket descriptor
+	 */
+	int listen_descriptor;
+
+	/* The connection socket descriptor
+	 */
+	int connection_descriptor;
+
+	/* Value to indicate the client negotiated structured replies
+	 */
+	int use_structured_replies;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The request thread pool
+	 */
+	libcthreads_thread_pool_t *request_thread_pool;
+
+	/* The mutex that serializes the replies on the connection
+	 */
+	libcthreads_mutex_t *reply_mutex;
+#endif
+};
+
+int nbd_handle_initialize(
+     nbd_handle_t **nbd_handle,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int nbd_handle_free(
+     nbd_handle_t **nbd_handle,
+     libcerror_error_t **error );
+
+int nbd_handle_signal_abort(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error );
+
+int nbd_handle_set_bytes_per_sector(
+     nbd_handle_t *nbd_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int nbd_handle_open_input(
+     nbd_handle_t *nbd_handle,
+     const system_character_t *filename,
+     int partition_index,
+     libcerror_error_t **error );
+
+int nbd_handle_close_input(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error );
+
+int nbd_handle_open_socket(
+     nbd_handle_t *nbd_handle,
+     const char *socket_path,
+     libcerror_error_t **error );
+
+int nbd_handle_close_socket(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error );
+
+int nbd_handle_serve(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error );
+
+int nbd_handle_read_data(
+     nbd_handle_t *nbd_handle,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int nbd_handle_write_data(
+     nbd_handle_t *nbd_handle,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int nbd_handle_write_option_reply(
+     nbd_handle_t *nbd_handle,
+     uint32_t option,
+     uint32_t reply_type,
+     const uint8_t *data,
+     uint32_t data_size,
+     libcerror_error_t **error );
+
+int nbd_handle_negotiate(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error );
+
+int nbd_handle_transmit(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error );
+
+ssize_t nbd_handle_read_buffer_at_offset(
+         nbd_handle_t *nbd_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+int nbd_handle_write_simple_reply(
+     nbd_handle_t *nbd_handle,
+     uint64_t cookie,
+     uint32_t error_value,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int nbd_handle_write_structured_reply_chunk(
+     nbd_handle_t *nbd_handle,
+     uint64_t cookie,
+     uint16_t reply_flags,
+     uint16_t reply_type,
+     const uint8_t *payload_header,
+     size_t payload_header_size,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int nbd_handle_write_read_reply(
+     nbd_handle_t *nbd_handle,
+     nbd_handle_request_t *request,
+     const uint8_t *data,
+     libcerror_error_t **error );
+
+int nbd_handle_write_error_reply(
+     nbd_handle_t *nbd_handle,
+     uint64_t cookie,
+     uint32_t error_value,
+     libcerror_error_t **error );
+
+int nbd_handle_process_request_callback(
+     nbd_handle_request_t *request,
+     nbd_handle_t *nbd_handle );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _NBD_HANDLE_H ) */
+
@@ -0,0 +1,631 @@
+/*
+ * Scan handle
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include "info_handle.h"
+#include "scan_handle.h"
+#include "vsapmtools_libcerror.h"
+#include "vsapmtools_libvsapm.h"
+
+#define SCAN_HANDLE_NOTIFY_STREAM	stdout
+
+/* Creates a scan handle
+ * Make sure the value scan_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int scan_handle_initialize(
+     scan_handle_t **scan_handle,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "scan_handle_initialize";
+
+	if( scan_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scan handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *scan_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid scan handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > SCAN_HANDLE_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*scan_handle = memory_allocate_structure(
+	                scan_handle_t );
+
+	if( *scan_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create scan handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *scan_handle,
+	     0,
+	     sizeof( scan_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear scan handle.",
+		 function );
+
+		memory_free(
+		 *scan_handle );
+
+		*scan_handle = NULL;
+
+		return( -1 );
+	}
+	if( libvsapm_volume_initialize(
+	     &( ( *scan_handle )->input_volume ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input handle.",
+		 function );
+
+		goto on_error;
+	}
+	( *scan_handle )->bytes_per_sector  = 512;
+	( *scan_handle )->number_of_threads = number_of_threads;
+	( *scan_handle )->notify_stream     = SCAN_HANDLE_NOTIFY_STREAM;
+
+	return( 1 );
+
+on_error:
+	if( *scan_handle != NULL )
+	{
+		memory_free(
+		 *scan_handle );
+
+		*scan_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a scan handle
+ * Returns 1 if successful or -1 on error
+ */
+int scan_handle_free(
+     scan_handle_t **scan_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "scan_handle_free";
+	int result            = 1;
+
+	if( scan_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scan handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *scan_handle != NULL )
+	{
+		if( ( *scan_handle )->input_volume != NULL )
+		{
+			if( libvsapm_volume_free(
+			     &( ( *scan_handle )->input_volume ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free input handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *scan_handle );
+
+		*scan_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the scan handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int scan_handle_signal_abort(
+     scan_handle_t *scan_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "scan_handle_signal_abort";
+
+	if( scan_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scan handle.",
+		 function );
+
+		return( -1 );
+	}
+	scan_handle->abort = 1;
+
+	if( scan_handle->input_volume != NULL )
+	{
+		if( libvsapm_volume_signal_abort(
+		     scan_handle->input_volume,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal input handle to abort.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the bytes per sector
+ * Returns 1 if successful or -1 on error
+ */
+int scan_handle_set_bytes_per_sector(
+     scan_handle_t *scan_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "scan_handle_set_bytes_per_sector";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( scan_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scan handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( vsapmtools_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( value_64bit != 512 )
+	 && ( value_64bit != 1024 )
+	 && ( value_64bit != 2048 )
+	 && ( value_64bit != 4096 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported bytes per sector value.",
+		 function );
+
+		return( -1 );
+	}
+	scan_handle->bytes_per_sector = (uint32_t) value_64bit;
+
+	return( 1 );
+}
+
+/* Opens the input by scanning it for partition map entries
+ * Returns 1 if successful or -1 on error
+ */
+int scan_handle_open_input(
+     scan_handle_t *scan_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "scan_handle_open_input";
+
+	if( scan_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scan handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvsapm_volume_set_bytes_per_sector(
+	     scan_handle->input_volume,
+	     scan_handle->bytes_per_sector,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set bytes per sector in input handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libvsapm_volume_open_scan_wide(
+	     scan_handle->input_volume,
+	     filename,
+	     LIBVSAPM_OPEN_READ,
+	     scan_handle->number_of_threads,
+	     error ) != 1 )
+#else
+	if( libvsapm_volume_open_scan(
+	     scan_handle->input_volume,
+	     filename,
+	     LIBVSAPM_OPEN_READ,
+	     scan_handle->number_of_threads,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open input handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Closes the input
+ * Returns the 0 if succesful or -1 on error
+ */
+int scan_handle_close_input(
+     scan_handle_t *scan_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "scan_handle_close_input";
+
+	if( scan_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scan handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvsapm_volume_close(
+	     scan_handle->input_volume,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close input handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 0 );
+}
+
+/* Prints a recovered partition as a row of the partition table
+ * Returns 1 if successful or -1 on error
+ */
+int scan_handle_partition_fprint(
+     scan_handle_t *scan_handle,
+     int partition_index,
+     libvsapm_partition_t *partition,
+     libcerror_error_t **error )
+{
+	char name_string[ 33 ];
+	char type_string[ 33 ];
+
+	static char *function = "scan_handle_partition_fprint";
+	size64_t size         = 0;
+	off64_t volume_offset = 0;
+
+	if( scan_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scan handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvsapm_partition_get_volume_offset(
+	     partition,
+	     &volume_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve partition offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvsapm_partition_get_size(
+	     partition,
+	     &size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve partition size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvsapm_partition_get_type_string(
+	     partition,
+	     type_string,
+	     33,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve partition type string.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvsapm_partition_get_name_string(
+	     partition,
+	     name_string,
+	     33,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve partition name string.",
+		 function );
+
+		return( -1 );
+	}
+	fprintf(
+	 scan_handle->notify_stream,
+	 "%d\t\t0x%08" PRIx64 "\t%" PRIu64 "\t%s\t%s\n",
+	 partition_index + 1,
+	 volume_offset,
+	 size,
+	 type_string,
+	 name_string );
+
+	return( 1 );
+}
+
+/* Prints the recovered partition table
+ * Returns 1 if successful or -1 on error
+ */
+int scan_handle_partitions_fprint(
+     scan_handle_t *scan_handle,
+     libcerror_error_t **error )
+{
+	libvsapm_partition_t *partition = NULL;
+	static char *function           = "scan_handle_partitions_fprint";
+	uint32_t bytes_per_sector       = 0;
+	int number_of_partitions        = 0;
+	int partition_index             = 0;
+
+	if( scan_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scan handle.",
+		 function );
+
+		return( -1 );
+	}
+	fprintf(
+	 scan_handle->notify_stream,
+	 "Recovered Apple Partition Map (APM):\n" );
+
+	if( libvsapm_volume_get_bytes_per_sector(
+	     scan_handle->input_volume,
+	     &bytes_per_sector,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of bytes per sector.",
+		 function );
+
+		goto on_error;
+	}
+	fprintf(
+	 scan_handle->notify_stream,
+	 "\tBytes per sector\t: %" PRIu32 "\n",
+	 bytes_per_sector );
+
+	if( libvsapm_volume_get_number_of_partitions(
+	     scan_handle->input_volume,
+	     &number_of_partitions,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of partitions.",
+		 function );
+
+		goto on_error;
+	}
+	fprintf(
+	 scan_handle->notify_stream,
+	 "\tNumber of partitions\t: %d\n",
+	 number_of_partitions );
+
+	fprintf(
+	 scan_handle->notify_stream,
+	 "\n" );
+
+	fprintf(
+	 scan_handle->notify_stream,
+	 "Partition\tOffset\t\tSize\tType\tName\n" );
+
+	for( partition_index = 0;
+	     partition_index < number_of_partitions;
+	     partition_index++ )
+	{
+		if( scan_handle->abort != 0 )
+		{
+			break;
+		}
+		if( libvsapm_volume_get_partition_by_index(
+		     scan_handle->input_volume,
+		     partition_index,
+		     &partition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve partition: %d.",
+			 function,
+			 partition_index );
+
+			goto on_error;
+		}
+		if( scan_handle_partition_fprint(
+		     scan_handle,
+		     partition_index,
+		     partition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print partition: %d.",
+			 function,
+			 partition_index );
+
+			goto on_error;
+		}
+		if( libvsapm_partition_free(
+		     &partition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free partition: %d.",
+			 function,
+			 partition_index );
+
+			goto on_error;
+		}
+	}
+	fprintf(
+	 scan_handle->notify_stream,
+	 "\n" );
+
+	return( 1 );
+
+on_error:
+	if( partition != NULL )
+	{
+		libvsapm_partition_free(
+		 &partition,
+		 NULL );
+	}
+	return( -1 );
+}
+
@@ -0,0 +1,111 @@
+/*
+ * Scan handle
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _SCAN_HANDLE_H )
+#define _SCAN_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "vsapmtools_libcerror.h"
+#include "vsapmtools_libvsapm.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The default number of threads
+ */
+#define SCAN_HANDLE_DEFAULT_NUMBER_OF_THREADS	4
+
+/* The maximum number of threads
+ */
+#define SCAN_HANDLE_MAXIMUM_NUMBER_OF_THREADS	64
+
+typedef struct scan_handle scan_handle_t;
+
+struct scan_handle
+{
+	/* The number of bytes per sector
+	 */
+	uint32_t bytes_per_sector;
+
+	/* The number of threads
+	 */
+	int number_of_threads;
+
+	/* The libvsapm input volume
+	 */
+	libvsapm_volume_t *input_volume;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int scan_handle_initialize(
+     scan_handle_t **scan_handle,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int scan_handle_free(
+     scan_handle_t **scan_handle,
+     libcerror_error_t **error );
+
+int scan_handle_signal_abort(
+     scan_handle_t *scan_handle,
+     libcerror_error_t **error );
+
+int scan_handle_set_bytes_per_sector(
+     scan_handle_t *scan_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int scan_handle_open_input(
+     scan_handle_t *scan_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int scan_handle_close_input(
+     scan_handle_t *scan_handle,
+     libcerror_error_t **error );
+
+int scan_handle_partition_fprint(
+     scan_handle_t *scan_handle,
+     int partition_index,
+     libvsapm_partition_t *partition,
+     libcerror_error_t **error );
+
+int scan_handle_partitions_fprint(
+     scan_handle_t *scan_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _SCAN_HANDLE_H ) */
+
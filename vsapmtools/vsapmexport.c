@@ -0,0 +1,454 @@
+/*
+ * Exports partitions from an Apple Partition Map (APM) volume system
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include <stdio.h>
+
+#if defined( HAVE_IO_H ) || defined( WINAPI )
+#include <io.h>
+#endif
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "export_handle.h"
+#include "info_handle.h"
+#include "vsapmtools_getopt.h"
+#include "vsapmtools_libcerror.h"
+#include "vsapmtools_libclocale.h"
+#include "vsapmtools_libcnotify.h"
+#include "vsapmtools_libvsapm.h"
+#include "vsapmtools_output.h"
+#include "vsapmtools_signal.h"
+#include "vsapmtools_unused.h"
+
+export_handle_t *vsapmexport_export_handle = NULL;
+int vsapmexport_abort                      = 0;
+
+/* Prints the executable usage information
+ */
+void usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use vsapmexport to export partitions from an Apple Partition\n"
+	                 "Map (APM) volume system.\n\n" );
+
+	fprintf( stream, "Usage: vsapmexport [ -b bytes_per_sector ] [ -p partition_number ]\n"
+	                 "                   [ -t target ] [ -hsuvV ] source\n\n" );
+
+	fprintf( stream, "\tsource: the source file\n\n" );
+
+	fprintf( stream, "\t-b:     specify the number of bytes per sector (default is 512)\n"
+	                 "\t        (use this to override the automatic bytes per sector detection)\n" );
+	fprintf( stream, "\t-h:     shows this help\n" );
+	fprintf( stream, "\t-p:     specify the number of the partition to export, starting at 1\n"
+	                 "\t        (default is all partitions)\n" );
+	fprintf( stream, "\t-s:     write all-zero blocks as holes (sparse output)\n" );
+	fprintf( stream, "\t-t:     specify the target, all partitions are exported to files\n"
+	                 "\t        named target followed by the partition number (default is\n"
+	                 "\t        partition), a single partition is exported to target or to\n"
+	                 "\t        stdout if target is -\n" );
+	fprintf( stream, "\t-u:     do not let the kernel copy the data directly (copy_file_range\n"
+	                 "\t        or sendfile), always read and write via user space buffers\n" );
+	fprintf( stream, "\t-v:     verbose output to stderr\n" );
+	fprintf( stream, "\t-V:     print version\n" );
+}
+
+/* Signal handler for vsapmexport
+ */
+void vsapmexport_signal_handler(
+      vsapmtools_signal_t signal VSAPMTOOLS_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "vsapmexport_signal_handler";
+
+	VSAPMTOOLS_UNREFERENCED_PARAMETER( signal )
+
+	vsapmexport_abort = 1;
+
+	if( vsapmexport_export_handle != NULL )
+	{
+		if( export_handle_signal_abort(
+		     vsapmexport_export_handle,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal export handle to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	/* Force stdin to close otherwise any function reading it will remain blocked
+	 */
+#if defined( WINAPI ) && !defined( __CYGWIN__ )
+	if( _close(
+	     0 ) != 0 )
+#else
+	if( close(
+	     0 ) != 0 )
+#endif
+	{
+		libcnotify_printf(
+		 "%s: unable to close stdin.\n",
+		 function );
+	}
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	system_character_t partition_target_path[ 32 ];
+
+	libcerror_error_t *error                     = NULL;
+	system_character_t *option_bytes_per_sector  = NULL;
+	system_character_t *option_partition_number  = NULL;
+	system_character_t *option_target_path       = NULL;
+	system_character_t *source                   = NULL;
+	char *program                                = "vsapmexport";
+	system_integer_t option                      = 0;
+	size_t string_length                         = 0;
+	uint64_t value_64bit                         = 0;
+	int partition_index                          = -1;
+	int use_kernel_copy                          = 1;
+	int use_sparse_output                        = 0;
+	int verbose                                  = 0;
+
+	libcnotify_stream_set(
+	 stderr,
+	 NULL );
+	libcnotify_verbose_set(
+	 1 );
+
+	if( libclocale_initialize(
+	     "vsapmtools",
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize locale values.\n" );
+
+		goto on_error;
+	}
+	if( vsapmtools_output_initialize(
+	     _IONBF,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize output settings.\n" );
+
+		goto on_error;
+	}
+	while( ( option = vsapmtools_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "b:hp:st:uvV" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				vsapmtools_output_version_fprint(
+				 stderr,
+				 program );
+
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM "\n",
+				 argv[ optind - 1 ] );
+
+				usage_fprint(
+				 stderr );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'b':
+				option_bytes_per_sector = optarg;
+
+				break;
+
+			case (system_integer_t) 'h':
+				vsapmtools_output_version_fprint(
+				 stdout,
+				 program );
+
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'p':
+				option_partition_number = optarg;
+
+				break;
+
+			case (system_integer_t) 's':
+				use_sparse_output = 1;
+
+				break;
+
+			case (system_integer_t) 't':
+				option_target_path = optarg;
+
+				break;
+
+			case (system_integer_t) 'u':
+				use_kernel_copy = 0;
+
+				break;
+
+			case (system_integer_t) 'v':
+				verbose = 1;
+
+				break;
+
+			case (system_integer_t) 'V':
+				vsapmtools_output_version_fprint(
+				 stdout,
+				 program );
+
+				vsapmtools_output_copyright_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+		}
+	}
+	/* The version is printed to stderr since the partition data can be written to stdout
+	 */
+	vsapmtools_output_version_fprint(
+	 stderr,
+	 program );
+
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing source file.\n" );
+
+		usage_fprint(
+		 stderr );
+
+		return( EXIT_FAILURE );
+	}
+	source = argv[ optind ];
+
+	if( option_partition_number != NULL )
+	{
+		string_length = system_string_length(
+		                 option_partition_number );
+
+		if( ( vsapmtools_system_string_copy_from_64_bit_in_decimal(
+		       option_partition_number,
+		       string_length + 1,
+		       &value_64bit,
+		       &error ) != 1 )
+		 || ( value_64bit == 0 )
+		 || ( value_64bit > (uint64_t) INT32_MAX ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported partition number.\n" );
+
+			goto on_error;
+		}
+		partition_index = (int) value_64bit - 1;
+	}
+	if( option_target_path == NULL )
+	{
+		if( partition_index == -1 )
+		{
+			option_target_path = _SYSTEM_STRING( "partition" );
+		}
+		else
+		{
+			if( system_string_sprintf(
+			     partition_target_path,
+			     32,
+			     _SYSTEM_STRING( "partition%d" ),
+			     partition_index + 1 ) < 0 )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to set target path.\n" );
+
+				goto on_error;
+			}
+			option_target_path = partition_target_path;
+		}
+	}
+	libcnotify_verbose_set(
+	 verbose );
+	libvsapm_notify_set_stream(
+	 stderr,
+	 NULL );
+	libvsapm_notify_set_verbose(
+	 verbose );
+
+	if( export_handle_initialize(
+	     &vsapmexport_export_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize export handle.\n" );
+
+		goto on_error;
+	}
+	vsapmexport_export_handle->use_kernel_copy   = use_kernel_copy;
+	vsapmexport_export_handle->use_sparse_output = use_sparse_output;
+
+	if( option_bytes_per_sector != NULL )
+	{
+		if( export_handle_set_bytes_per_sector(
+		     vsapmexport_export_handle,
+		     option_bytes_per_sector,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported bytes per sector.\n" );
+
+			goto on_error;
+		}
+	}
+	if( export_handle_open_input(
+	     vsapmexport_export_handle,
+	     source,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open: %" PRIs_SYSTEM ".\n",
+		 source );
+
+		goto on_error;
+	}
+	if( vsapmtools_signal_attach(
+	     vsapmexport_signal_handler,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to attach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( export_handle_export_partitions(
+	     vsapmexport_export_handle,
+	     partition_index,
+	     option_target_path,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to export partitions.\n" );
+
+		goto on_error;
+	}
+	if( vsapmtools_signal_detach(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to detach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( export_handle_close_input(
+	     vsapmexport_export_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close export handle.\n" );
+
+		goto on_error;
+	}
+	if( export_handle_free(
+	     &vsapmexport_export_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free export handle.\n" );
+
+		goto on_error;
+	}
+	if( vsapmexport_abort != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Export aborted.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	fprintf(
+	 stderr,
+	 "Export completed.\n" );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( vsapmexport_export_handle != NULL )
+	{
+		export_handle_free(
+		 &vsapmexport_export_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,427 @@
+/*
+ * Calculates the hashes of partitions in an Apple Partition Map (APM) volume system
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include <stdio.h>
+
+#if defined( HAVE_IO_H ) || defined( WINAPI )
+#include <io.h>
+#endif
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "hash_handle.h"
+#include "info_handle.h"
+#include "vsapmtools_getopt.h"
+#include "vsapmtools_libcerror.h"
+#include "vsapmtools_libclocale.h"
+#include "vsapmtools_libcnotify.h"
+#include "vsapmtools_libvsapm.h"
+#include "vsapmtools_output.h"
+#include "vsapmtools_signal.h"
+#include "vsapmtools_unused.h"
+
+hash_handle_t *vsapmhash_hash_handle = NULL;
+int vsapmhash_abort                  = 0;
+
+/* Prints the executable usage information
+ */
+void usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use vsapmhash to calculate the hashes of partitions in an Apple\n"
+	                 "Partition Map (APM) volume system.\n\n" );
+
+	fprintf( stream, "Usage: vsapmhash [ -b bytes_per_sector ] [ -B block_size ]\n"
+	                 "                 [ -d digest_types ] [ -p partition_number ]\n"
+	                 "                 [ -hvV ] source\n\n" );
+
+	fprintf( stream, "\tsource: the source file\n\n" );
+
+	fprintf( stream, "\t-b:     specify the number of bytes per sector (default is 512)\n"
+	                 "\t        (use this to override the automatic bytes per sector detection)\n" );
+	fprintf( stream, "\t-B:     specify the block size of the per block hashes, must be a\n"
+	                 "\t        power of 2 (default is no per block hashes)\n" );
+	fprintf( stream, "\t-d:     specify the digest types as a comma separated list, options:\n"
+	                 "\t        md5, sha1, sha256 or all (default is all)\n" );
+	fprintf( stream, "\t-h:     shows this help\n" );
+	fprintf( stream, "\t-p:     specify the number of the partition to hash, starting at 1\n"
+	                 "\t        (default is all partitions)\n" );
+	fprintf( stream, "\t-v:     verbose output to stderr\n" );
+	fprintf( stream, "\t-V:     print version\n" );
+}
+
+/* Signal handler for vsapmhash
+ */
+void vsapmhash_signal_handler(
+      vsapmtools_signal_t signal VSAPMTOOLS_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "vsapmhash_signal_handler";
+
+	VSAPMTOOLS_UNREFERENCED_PARAMETER( signal )
+
+	vsapmhash_abort = 1;
+
+	if( vsapmhash_hash_handle != NULL )
+	{
+		if( hash_handle_signal_abort(
+		     vsapmhash_hash_handle,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal hash handle to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	/* Force stdin to close otherwise any function reading it will remain blocked
+	 */
+#if defined( WINAPI ) && !defined( __CYGWIN__ )
+	if( _close(
+	     0 ) != 0 )
+#else
+	if( close(
+	     0 ) != 0 )
+#endif
+	{
+		libcnotify_printf(
+		 "%s: unable to close stdin.\n",
+		 function );
+	}
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libcerror_error_t *error                     = NULL;
+	system_character_t *option_block_size        = NULL;
+	system_character_t *option_bytes_per_sector  = NULL;
+	system_character_t *option_digest_types      = NULL;
+	system_character_t *option_partition_number  = NULL;
+	system_character_t *source                   = NULL;
+	char *program                                = "vsapmhash";
+	system_integer_t option                      = 0;
+	size_t string_length                         = 0;
+	uint64_t value_64bit                         = 0;
+	int partition_index                          = -1;
+	int verbose                                  = 0;
+
+	libcnotify_stream_set(
+	 stderr,
+	 NULL );
+	libcnotify_verbose_set(
+	 1 );
+
+	if( libclocale_initialize(
+	     "vsapmtools",
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize locale values.\n" );
+
+		goto on_error;
+	}
+	if( vsapmtools_output_initialize(
+	     _IONBF,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize output settings.\n" );
+
+		goto on_error;
+	}
+	vsapmtools_output_version_fprint(
+	 stdout,
+	 program );
+
+	while( ( option = vsapmtools_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "b:B:d:hp:vV" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM "\n",
+				 argv[ optind - 1 ] );
+
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'b':
+				option_bytes_per_sector = optarg;
+
+				break;
+
+			case (system_integer_t) 'B':
+				option_block_size = optarg;
+
+				break;
+
+			case (system_integer_t) 'd':
+				option_digest_types = optarg;
+
+				break;
+
+			case (system_integer_t) 'h':
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'p':
+				option_partition_number = optarg;
+
+				break;
+
+			case (system_integer_t) 'v':
+				verbose = 1;
+
+				break;
+
+			case (system_integer_t) 'V':
+				vsapmtools_output_copyright_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing source file.\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	source = argv[ optind ];
+
+	if( option_partition_number != NULL )
+	{
+		string_length = system_string_length(
+		                 option_partition_number );
+
+		if( ( vsapmtools_system_string_copy_from_64_bit_in_decimal(
+		       option_partition_number,
+		       string_length + 1,
+		       &value_64bit,
+		       &error ) != 1 )
+		 || ( value_64bit == 0 )
+		 || ( value_64bit > (uint64_t) INT32_MAX ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported partition number.\n" );
+
+			goto on_error;
+		}
+		partition_index = (int) value_64bit - 1;
+	}
+	libcnotify_verbose_set(
+	 verbose );
+	libvsapm_notify_set_stream(
+	 stderr,
+	 NULL );
+	libvsapm_notify_set_verbose(
+	 verbose );
+
+	if( hash_handle_initialize(
+	     &vsapmhash_hash_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize hash handle.\n" );
+
+		goto on_error;
+	}
+	if( option_bytes_per_sector != NULL )
+	{
+		if( hash_handle_set_bytes_per_sector(
+		     vsapmhash_hash_handle,
+		     option_bytes_per_sector,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported bytes per sector.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_block_size != NULL )
+	{
+		if( hash_handle_set_block_size(
+		     vsapmhash_hash_handle,
+		     option_block_size,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported block size.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_digest_types != NULL )
+	{
+		if( hash_handle_set_digest_types(
+		     vsapmhash_hash_handle,
+		     option_digest_types,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported digest types.\n" );
+
+			goto on_error;
+		}
+	}
+	if( hash_handle_open_input(
+	     vsapmhash_hash_handle,
+	     source,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open: %" PRIs_SYSTEM ".\n",
+		 source );
+
+		goto on_error;
+	}
+	if( vsapmtools_signal_attach(
+	     vsapmhash_signal_handler,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to attach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( hash_handle_hash_partitions(
+	     vsapmhash_hash_handle,
+	     partition_index,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to hash partitions.\n" );
+
+		goto on_error;
+	}
+	if( vsapmtools_signal_detach(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to detach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( hash_handle_close_input(
+	     vsapmhash_hash_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close hash handle.\n" );
+
+		goto on_error;
+	}
+	if( hash_handle_free(
+	     &vsapmhash_hash_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free hash handle.\n" );
+
+		goto on_error;
+	}
+	if( vsapmhash_abort != 0 )
+	{
+		fprintf(
+		 stdout,
+		 "Hashing aborted.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( vsapmhash_hash_handle != NULL )
+	{
+		hash_handle_free(
+		 &vsapmhash_hash_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
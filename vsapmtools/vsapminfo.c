@@ -39,6 +39,7 @@
 #include <unistd.h>
 #endif
 
+#include "batch_handle.h"
 #include "info_handle.h"
 #include "vsapmtools_getopt.h"
 #include "vsapmtools_libcerror.h"
@@ -49,8 +50,9 @@
 #include "vsapmtools_signal.h"
 #include "vsapmtools_unused.h"
 
-info_handle_t *vsapminfo_info_handle = NULL;
-int vsapminfo_abort                  = 0;
+batch_handle_t *vsapminfo_batch_handle = NULL;
+info_handle_t *vsapminfo_info_handle   = NULL;
+int vsapminfo_abort                    = 0;
 
 /* Prints the executable usage information
  */
@@ -64,13 +66,18 @@ void usage_fprint(
 	fprintf( stream, "Use vsapminfo to determine information about an Apple Partition\n"
 	                 "Map (APM) volume system.\n\n" );
 
-	fprintf( stream, "Usage: vsapminfo [ -b bytes_per_sector ] [ -hvV ] source\n\n" );
+	fprintf( stream, "Usage: vsapminfo [ -b bytes_per_sector ] [ -t number_of_threads ]\n"
+	                 "                 [ -hjvV ] source [ source ... ]\n\n" );
 
-	fprintf( stream, "\tsource: the source file\n\n" );
+	fprintf( stream, "\tsource: the source file, multiple source files can be specified\n"
+	                 "\t        or - to read the source files from stdin, one per line\n\n" );
 
 	fprintf( stream, "\t-b:     specify the number of bytes per sector (default is 512)\n"
 	                 "\t        (use this to override the automatic bytes per sector detection)\n" );
 	fprintf( stream, "\t-h:     shows this help\n" );
+	fprintf( stream, "\t-j:     output newline delimited JSON, one object per source\n" );
+	fprintf( stream, "\t-t:     specify the number of threads used to process multiple\n"
+	                 "\t        sources (default is 1), the output remains in source order\n" );
 	fprintf( stream, "\t-v:     verbose output to stderr\n" );
 	fprintf( stream, "\t-V:     print version\n" );
 }
@@ -103,6 +110,22 @@ void vsapminfo_signal_handler(
 			 &error );
 		}
 	}
+	if( vsapminfo_batch_handle != NULL )
+	{
+		if( batch_handle_signal_abort(
+		     vsapminfo_batch_handle,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal batch handle to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
 	/* Force stdin to close otherwise any function reading it will remain blocked
 	 */
 #if defined( WINAPI ) && !defined( __CYGWIN__ )
@@ -127,13 +150,19 @@ int wmain( int argc, wchar_t * const argv[] )
 int main( int argc, char * const argv[] )
 #endif
 {
-	libcerror_error_t *error                    = NULL;
-	system_character_t *option_bytes_per_sector = NULL;
-	system_character_t *source                  = NULL;
-	char *program                               = "vsapminfo";
-	system_integer_t option                     = 0;
-	int result                                  = 0;
-	int verbose                                 = 0;
+	libcerror_error_t *error                     = NULL;
+	system_character_t *option_bytes_per_sector  = NULL;
+	system_character_t *option_number_of_threads = NULL;
+	system_character_t *source                   = NULL;
+	char *program                                = "vsapminfo";
+	system_integer_t option                      = 0;
+	size_t string_length                         = 0;
+	uint64_t value_64bit                         = 0;
+	int argument_index                           = 0;
+	int number_of_threads                        = 1;
+	int output_format                            = INFO_HANDLE_OUTPUT_FORMAT_TEXT;
+	int result                                   = 0;
+	int verbose                                  = 0;
 
 	libcnotify_stream_set(
 	 stderr,
@@ -161,19 +190,19 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
-	vsapmtools_output_version_fprint(
-	 stdout,
-	 program );
-
 	while( ( option = vsapmtools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "b:hvV" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "b:hjt:vV" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
 			case (system_integer_t) '?':
 			default:
+				vsapmtools_output_version_fprint(
+				 stdout,
+				 program );
+
 				fprintf(
 				 stderr,
 				 "Invalid argument: %" PRIs_SYSTEM "\n",
@@ -190,23 +219,49 @@ int main( int argc, char * const argv[] )
 				break;
 
 			case (system_integer_t) 'h':
+				vsapmtools_output_version_fprint(
+				 stdout,
+				 program );
+
 				usage_fprint(
 				 stdout );
 
 				return( EXIT_SUCCESS );
 
+			case (system_integer_t) 'j':
+				output_format = INFO_HANDLE_OUTPUT_FORMAT_JSON;
+
+				break;
+
+			case (system_integer_t) 't':
+				option_number_of_threads = optarg;
+
+				break;
+
 			case (system_integer_t) 'v':
 				verbose = 1;
 
 				break;
 
 			case (system_integer_t) 'V':
+				vsapmtools_output_version_fprint(
+				 stdout,
+				 program );
+
 				vsapmtools_output_copyright_fprint(
 				 stdout );
 
 				return( EXIT_SUCCESS );
 		}
 	}
+	/* The version is not printed in JSON mode so that the output can be parsed
+	 */
+	if( output_format == INFO_HANDLE_OUTPUT_FORMAT_TEXT )
+	{
+		vsapmtools_output_version_fprint(
+		 stdout,
+		 program );
+	}
 	if( optind == argc )
 	{
 		fprintf(
@@ -220,6 +275,28 @@ int main( int argc, char * const argv[] )
 	}
 	source = argv[ optind ];
 
+	if( option_number_of_threads != NULL )
+	{
+		string_length = system_string_length(
+		                 option_number_of_threads );
+
+		if( ( vsapmtools_system_string_copy_from_64_bit_in_decimal(
+		       option_number_of_threads,
+		       string_length + 1,
+		       &value_64bit,
+		       &error ) != 1 )
+		 || ( value_64bit == 0 )
+		 || ( value_64bit > (uint64_t) BATCH_HANDLE_MAXIMUM_NUMBER_OF_THREADS ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of threads, value should be between 1 and %d.\n",
+			 BATCH_HANDLE_MAXIMUM_NUMBER_OF_THREADS );
+
+			goto on_error;
+		}
+		number_of_threads = (int) value_64bit;
+	}
 	libcnotify_verbose_set(
 	 verbose );
 	libvsapm_notify_set_stream(
@@ -228,6 +305,157 @@ int main( int argc, char * const argv[] )
 	libvsapm_notify_set_verbose(
 	 verbose );
 
+	/* Use batch mode when the output is JSON or there are multiple sources
+	 */
+	if( ( output_format == INFO_HANDLE_OUTPUT_FORMAT_JSON )
+	 || ( ( optind + 1 ) < argc )
+	 || ( system_string_compare(
+	       source,
+	       _SYSTEM_STRING( "-" ),
+	       2 ) == 0 ) )
+	{
+		if( batch_handle_initialize(
+		     &vsapminfo_batch_handle,
+		     number_of_threads,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to initialize batch handle.\n" );
+
+			goto on_error;
+		}
+		if( batch_handle_set_output_format(
+		     vsapminfo_batch_handle,
+		     output_format,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set output format.\n" );
+
+			goto on_error;
+		}
+		if( option_bytes_per_sector != NULL )
+		{
+			if( batch_handle_set_bytes_per_sector(
+			     vsapminfo_batch_handle,
+			     option_bytes_per_sector,
+			     &error ) != 1 )
+			{
+				fprintf(
+				 stderr,
+				 "Unsupported bytes per sector.\n" );
+
+				goto on_error;
+			}
+		}
+		if( vsapmtools_signal_attach(
+		     vsapminfo_signal_handler,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to attach signal handler.\n" );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+		if( batch_handle_start(
+		     vsapminfo_batch_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to start batch handle.\n" );
+
+			goto on_error;
+		}
+		for( argument_index = optind;
+		     argument_index < argc;
+		     argument_index++ )
+		{
+			if( vsapminfo_abort != 0 )
+			{
+				break;
+			}
+			source = argv[ argument_index ];
+
+			string_length = system_string_length(
+			                 source );
+
+			if( ( string_length == 1 )
+			 && ( source[ 0 ] == (system_character_t) '-' ) )
+			{
+				result = batch_handle_push_sources_from_stream(
+				          vsapminfo_batch_handle,
+				          stdin,
+				          &error );
+			}
+			else
+			{
+				result = batch_handle_push_source(
+				          vsapminfo_batch_handle,
+				          source,
+				          string_length,
+				          &error );
+			}
+			if( result != 1 )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to process sources.\n" );
+
+				batch_handle_stop(
+				 vsapminfo_batch_handle,
+				 NULL );
+
+				goto on_error;
+			}
+		}
+		if( batch_handle_stop(
+		     vsapminfo_batch_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to stop batch handle.\n" );
+
+			goto on_error;
+		}
+		if( vsapmtools_signal_detach(
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to detach signal handler.\n" );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+		result = ( vsapminfo_batch_handle->number_of_failed_sources == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+		if( vsapminfo_abort != 0 )
+		{
+			result = EXIT_FAILURE;
+		}
+		if( batch_handle_free(
+		     &vsapminfo_batch_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to free batch handle.\n" );
+
+			goto on_error;
+		}
+		return( result );
+	}
+
 	if( info_handle_initialize(
 	     &vsapminfo_info_handle,
 	     &error ) != 1 )
@@ -313,6 +541,12 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( vsapminfo_batch_handle != NULL )
+	{
+		batch_handle_free(
+		 &vsapminfo_batch_handle,
+		 NULL );
+	}
 	if( vsapminfo_info_handle != NULL )
 	{
 		info_handle_free(
@@ -0,0 +1,586 @@
+/*
+ * Mounts an Apple Partition Map (APM) volume system
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+
+#include <stdio.h>
+
+#if defined( HAVE_IO_H ) || defined( WINAPI )
+#include <io.h>
+#endif
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "mount_fuse.h"
+#include "mount_handle.h"
+#include "vsapmtools_getopt.h"
+#include "vsapmtools_libcerror.h"
+#include "vsapmtools_libclocale.h"
+#include "vsapmtools_libcnotify.h"
+#include "vsapmtools_libvsapm.h"
+#include "vsapmtools_output.h"
+#include "vsapmtools_signal.h"
+#include "vsapmtools_unused.h"
+
+/* The default fuse mount options, the partition data is read-only
+ * hence the kernel page cache can be kept and large reads are requested
+ */
+#define VSAPMMOUNT_FUSE_DEFAULT_OPTIONS		"ro,kernel_cache,max_read=1048576"
+
+mount_handle_t *vsapmmount_mount_handle = NULL;
+int vsapmmount_abort                    = 0;
+
+/* Prints the executable usage information
+ */
+void usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use vsapmmount to mount an Apple Partition Map (APM) volume system\n\n" );
+
+	fprintf( stream, "Usage: vsapmmount [ -b bytes_per_sector ] [ -X extended_options ]\n"
+	                 "                  [ -hvV ] source mount_point\n\n" );
+
+	fprintf( stream, "\tsource:      the source file or device\n" );
+	fprintf( stream, "\tmount_point: the directory to serve as mount point\n\n" );
+
+	fprintf( stream, "\t-b:          specify the number of bytes per sector (default is 512)\n"
+	                 "\t             (use this to override the automatic bytes per sector detection)\n" );
+	fprintf( stream, "\t-h:          shows this help\n" );
+	fprintf( stream, "\t-v:          verbose output to stderr, while vsapmmount will remain running in the\n"
+	                 "\t             foreground\n" );
+	fprintf( stream, "\t-V:          print version\n" );
+	fprintf( stream, "\t-X:          extended options to pass to sub system\n" );
+}
+
+/* Signal handler for vsapmmount
+ */
+void vsapmmount_signal_handler(
+      vsapmtools_signal_t signal VSAPMTOOLS_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "vsapmmount_signal_handler";
+
+	VSAPMTOOLS_UNREFERENCED_PARAMETER( signal )
+
+	vsapmmount_abort = 1;
+
+	if( vsapmmount_mount_handle != NULL )
+	{
+		if( mount_handle_signal_abort(
+		     vsapmmount_mount_handle,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal mount handle to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	/* Force stdin to close otherwise any function reading it will remain blocked
+	 */
+#if defined( WINAPI ) && !defined( __CYGWIN__ )
+	if( _close(
+	     0 ) != 0 )
+#else
+	if( close(
+	     0 ) != 0 )
+#endif
+	{
+		libcnotify_printf(
+		 "%s: unable to close stdin.\n",
+		 function );
+	}
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libcerror_error_t *error                    = NULL;
+	system_character_t *mount_point             = NULL;
+	system_character_t *option_bytes_per_sector = NULL;
+	system_character_t *option_extended_options = NULL;
+	system_character_t *source                  = NULL;
+	char *program                               = "vsapmmount";
+	system_integer_t option                     = 0;
+	int verbose                                 = 0;
+
+#if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 )
+	struct fuse_operations vsapmmount_fuse_operations;
+
+	struct fuse_args vsapmmount_fuse_arguments  = FUSE_ARGS_INIT( 0, NULL );
+	char *fuse_mount_options                    = NULL;
+	struct fuse *vsapmmount_fuse_handle         = NULL;
+	size_t fuse_mount_options_size              = 0;
+	int result                                  = 0;
+
+#if !defined( HAVE_LIBFUSE3 )
+	struct fuse_chan *vsapmmount_fuse_channel   = NULL;
+#endif
+#endif /* defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 ) */
+
+	libcnotify_stream_set(
+	 stderr,
+	 NULL );
+	libcnotify_verbose_set(
+	 1 );
+
+	if( libclocale_initialize(
+	     "vsapmtools",
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize locale values.\n" );
+
+		goto on_error;
+	}
+	if( vsapmtools_output_initialize(
+	     _IONBF,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize output settings.\n" );
+
+		goto on_error;
+	}
+	vsapmtools_output_version_fprint(
+	 stdout,
+	 program );
+
+	while( ( option = vsapmtools_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "b:hvVX:" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM "\n",
+				 argv[ optind - 1 ] );
+
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'b':
+				option_bytes_per_sector = optarg;
+
+				break;
+
+			case (system_integer_t) 'h':
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'v':
+				verbose = 1;
+
+				break;
+
+			case (system_integer_t) 'V':
+				vsapmtools_output_copyright_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'X':
+				option_extended_options = optarg;
+
+				break;
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing source file or device.\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	source = argv[ optind++ ];
+
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing mount point.\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	mount_point = argv[ optind ];
+
+	libcnotify_verbose_set(
+	 verbose );
+	libvsapm_notify_set_stream(
+	 stderr,
+	 NULL );
+	libvsapm_notify_set_verbose(
+	 verbose );
+
+	if( mount_handle_initialize(
+	     &vsapmmount_mount_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize mount handle.\n" );
+
+		goto on_error;
+	}
+	if( option_bytes_per_sector != NULL )
+	{
+		if( mount_handle_set_bytes_per_sector(
+		     vsapmmount_mount_handle,
+		     option_bytes_per_sector,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported bytes per sector.\n" );
+
+			goto on_error;
+		}
+	}
+	if( mount_handle_set_path_prefix(
+	     vsapmmount_mount_handle,
+	     _SYSTEM_STRING( "/vsapm" ),
+	     7,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set path prefix.\n" );
+
+		goto on_error;
+	}
+	if( mount_handle_open(
+	     vsapmmount_mount_handle,
+	     source,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open: %" PRIs_SYSTEM "\n",
+		 source );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 )
+	fuse_mount_options_size = narrow_string_length(
+	                           VSAPMMOUNT_FUSE_DEFAULT_OPTIONS ) + 1;
+
+	if( option_extended_options != NULL )
+	{
+		fuse_mount_options_size += narrow_string_length(
+		                            option_extended_options ) + 1;
+	}
+	fuse_mount_options = narrow_string_allocate(
+	                      fuse_mount_options_size );
+
+	if( fuse_mount_options == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create fuse mount options.\n" );
+
+		goto on_error;
+	}
+	if( option_extended_options != NULL )
+	{
+		result = narrow_string_snprintf(
+		          fuse_mount_options,
+		          fuse_mount_options_size,
+		          "%s,%s",
+		          VSAPMMOUNT_FUSE_DEFAULT_OPTIONS,
+		          option_extended_options );
+	}
+	else
+	{
+		result = narrow_string_snprintf(
+		          fuse_mount_options,
+		          fuse_mount_options_size,
+		          "%s",
+		          VSAPMMOUNT_FUSE_DEFAULT_OPTIONS );
+	}
+	if( ( result < 0 )
+	 || ( (size_t) result >= fuse_mount_options_size ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set fuse mount options.\n" );
+
+		goto on_error;
+	}
+	/* The first fuse argument is expected to be the program name
+	 */
+	if( fuse_opt_add_arg(
+	     &vsapmmount_fuse_arguments,
+	     program ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable add fuse arguments.\n" );
+
+		goto on_error;
+	}
+	if( fuse_opt_add_arg(
+	     &vsapmmount_fuse_arguments,
+	     "-o" ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable add fuse arguments.\n" );
+
+		goto on_error;
+	}
+	if( fuse_opt_add_arg(
+	     &vsapmmount_fuse_arguments,
+	     fuse_mount_options ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable add fuse arguments.\n" );
+
+		goto on_error;
+	}
+	memory_free(
+	 fuse_mount_options );
+
+	fuse_mount_options = NULL;
+
+	if( memory_set(
+	     &vsapmmount_fuse_operations,
+	     0,
+	     sizeof( struct fuse_operations ) ) == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to clear fuse operations.\n" );
+
+		goto on_error;
+	}
+	vsapmmount_fuse_operations.open       = &mount_fuse_open;
+	vsapmmount_fuse_operations.read       = &mount_fuse_read;
+	vsapmmount_fuse_operations.release    = &mount_fuse_release;
+	vsapmmount_fuse_operations.opendir    = &mount_fuse_opendir;
+	vsapmmount_fuse_operations.readdir    = &mount_fuse_readdir;
+	vsapmmount_fuse_operations.releasedir = &mount_fuse_releasedir;
+	vsapmmount_fuse_operations.getattr    = &mount_fuse_getattr;
+	vsapmmount_fuse_operations.init       = &mount_fuse_init;
+
+#if defined( HAVE_LIBFUSE3 )
+	vsapmmount_fuse_handle = fuse_new(
+	                          &vsapmmount_fuse_arguments,
+	                          &vsapmmount_fuse_operations,
+	                          sizeof( struct fuse_operations ),
+	                          vsapmmount_mount_handle );
+
+	if( vsapmmount_fuse_handle == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create fuse handle.\n" );
+
+		goto on_error;
+	}
+	result = fuse_mount(
+	          vsapmmount_fuse_handle,
+	          mount_point );
+
+	if( result != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to fuse mount file system.\n" );
+
+		goto on_error;
+	}
+#else
+	vsapmmount_fuse_channel = fuse_mount(
+	                           mount_point,
+	                           &vsapmmount_fuse_arguments );
+
+	if( vsapmmount_fuse_channel == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create fuse channel.\n" );
+
+		goto on_error;
+	}
+	vsapmmount_fuse_handle = fuse_new(
+	                          vsapmmount_fuse_channel,
+	                          &vsapmmount_fuse_arguments,
+	                          &vsapmmount_fuse_operations,
+	                          sizeof( struct fuse_operations ),
+	                          vsapmmount_mount_handle );
+
+	if( vsapmmount_fuse_handle == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create fuse handle.\n" );
+
+		goto on_error;
+	}
+#endif /* defined( HAVE_LIBFUSE3 ) */
+
+	if( verbose == 0 )
+	{
+		if( fuse_daemonize(
+		     0 ) != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to daemonize fuse.\n" );
+
+			goto on_error;
+		}
+	}
+	/* Use the multi-threaded fuse loop so that reads of different
+	 * partitions, or different regions of the same partition,
+	 * are serviced concurrently
+	 */
+#if defined( HAVE_LIBFUSE3 )
+	result = fuse_loop_mt(
+	          vsapmmount_fuse_handle,
+	          0 );
+#else
+	result = fuse_loop_mt(
+	          vsapmmount_fuse_handle );
+#endif
+	if( result != 0 )
+	{
+		goto on_error;
+	}
+	fuse_destroy(
+	 vsapmmount_fuse_handle );
+
+	fuse_opt_free_args(
+	 &vsapmmount_fuse_arguments );
+
+	if( mount_handle_close(
+	     vsapmmount_mount_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close mount handle.\n" );
+
+		goto on_error;
+	}
+	if( mount_handle_free(
+	     &vsapmmount_mount_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free mount handle.\n" );
+
+		goto on_error;
+	}
+	return( EXIT_SUCCESS );
+
+#else
+	fprintf(
+	 stderr,
+	 "No sub system to mount APM format on: %" PRIs_SYSTEM "\n",
+	 mount_point );
+
+	if( option_extended_options != NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Extended options are not supported.\n" );
+	}
+
+	return( EXIT_FAILURE );
+
+#endif /* defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 ) */
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+#if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 )
+	if( vsapmmount_fuse_handle != NULL )
+	{
+		fuse_destroy(
+		 vsapmmount_fuse_handle );
+	}
+	fuse_opt_free_args(
+	 &vsapmmount_fuse_arguments );
+
+	if( fuse_mount_options != NULL )
+	{
+		memory_free(
+		 fuse_mount_options );
+	}
+#endif
+	if( vsapmmount_mount_handle != NULL )
+	{
+		mount_handle_free(
+		 &vsapmmount_mount_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,473 @@
+/*
+ * Exports a partition in an Apple Partition Map (APM) volume system
+ * using the Network Block Device (NBD) protocol
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include <stdio.h>
+
+#if defined( HAVE_IO_H ) || defined( WINAPI )
+#include <io.h>
+#endif
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "info_handle.h"
+#include "nbd_handle.h"
+#include "vsapmtools_getopt.h"
+#include "vsapmtools_libcerror.h"
+#include "vsapmtools_libclocale.h"
+#include "vsapmtools_libcnotify.h"
+#include "vsapmtools_libvsapm.h"
+#include "vsapmtools_output.h"
+#include "vsapmtools_signal.h"
+#include "vsapmtools_unused.h"
+
+nbd_handle_t *vsapmnbd_nbd_handle = NULL;
+int vsapmnbd_abort                = 0;
+
+/* Prints the executable usage information
+ */
+void usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use vsapmnbd to export a partition in an Apple Partition Map (APM)\n"
+	                 "volume system using the Network Block Device (NBD) protocol.\n\n" );
+
+	fprintf( stream, "Usage: vsapmnbd [ -b bytes_per_sector ] [ -p partition_number ]\n"
+	                 "                [ -t number_of_threads ] [ -hvV ] source socket_path\n\n" );
+
+	fprintf( stream, "\tsource:      the source file\n" );
+	fprintf( stream, "\tsocket_path: the path of the Unix domain socket to listen on\n\n" );
+
+	fprintf( stream, "\t-b:          specify the number of bytes per sector (default is 512)\n"
+	                 "\t             (use this to override the automatic bytes per sector detection)\n" );
+	fprintf( stream, "\t-h:          shows this help\n" );
+	fprintf( stream, "\t-p:          specify the number of the partition to export, starting at 1\n"
+	                 "\t             (default is 1)\n" );
+	fprintf( stream, "\t-t:          specify the number of threads used to process read requests\n"
+	                 "\t             (default is %d)\n",
+	         NBD_HANDLE_DEFAULT_NUMBER_OF_THREADS );
+	fprintf( stream, "\t-v:          verbose output to stderr\n" );
+	fprintf( stream, "\t-V:          print version\n" );
+}
+
+/* Signal handler for vsapmnbd
+ */
+void vsapmnbd_signal_handler(
+      vsapmtools_signal_t signal VSAPMTOOLS_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "vsapmnbd_signal_handler";
+
+	VSAPMTOOLS_UNREFERENCED_PARAMETER( signal )
+
+	vsapmnbd_abort = 1;
+
+	if( vsapmnbd_nbd_handle != NULL )
+	{
+		if( nbd_handle_signal_abort(
+		     vsapmnbd_nbd_handle,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal NBD handle to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	/* Force stdin to close otherwise any function reading it will remain blocked
+	 */
+#if defined( WINAPI ) && !defined( __CYGWIN__ )
+	if( _close(
+	     0 ) != 0 )
+#else
+	if( close(
+	     0 ) != 0 )
+#endif
+	{
+		libcnotify_printf(
+		 "%s: unable to close stdin.\n",
+		 function );
+	}
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libcerror_error_t *error                     = NULL;
+	system_character_t *option_bytes_per_sector  = NULL;
+	system_character_t *option_number_of_threads = NULL;
+	system_character_t *option_partition_number  = NULL;
+	system_character_t *socket_path              = NULL;
+	system_character_t *source                   = NULL;
+	char *program                                = "vsapmnbd";
+	system_integer_t option                      = 0;
+	size_t string_length                         = 0;
+	uint64_t value_64bit                         = 0;
+	int number_of_threads                        = NBD_HANDLE_DEFAULT_NUMBER_OF_THREADS;
+	int partition_index                          = 0;
+	int verbose                                  = 0;
+
+	libcnotify_stream_set(
+	 stderr,
+	 NULL );
+	libcnotify_verbose_set(
+	 1 );
+
+	if( libclocale_initialize(
+	     "vsapmtools",
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize locale values.\n" );
+
+		goto on_error;
+	}
+	if( vsapmtools_output_initialize(
+	     _IONBF,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize output settings.\n" );
+
+		goto on_error;
+	}
+	vsapmtools_output_version_fprint(
+	 stdout,
+	 program );
+
+	while( ( option = vsapmtools_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "b:hp:t:vV" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM "\n",
+				 argv[ optind - 1 ] );
+
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'b':
+				option_bytes_per_sector = optarg;
+
+				break;
+
+			case (system_integer_t) 'h':
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'p':
+				option_partition_number = optarg;
+
+				break;
+
+			case (system_integer_t) 't':
+				option_number_of_threads = optarg;
+
+				break;
+
+			case (system_integer_t) 'v':
+				verbose = 1;
+
+				break;
+
+			case (system_integer_t) 'V':
+				vsapmtools_output_copyright_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing source file.\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	source = argv[ optind++ ];
+
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing socket path.\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	socket_path = argv[ optind ];
+
+	if( option_partition_number != NULL )
+	{
+		string_length = system_string_length(
+		                 option_partition_number );
+
+		if( ( vsapmtools_system_string_copy_from_64_bit_in_decimal(
+		       option_partition_number,
+		       string_length + 1,
+		       &value_64bit,
+		       &error ) != 1 )
+		 || ( value_64bit == 0 )
+		 || ( value_64bit > (uint64_t) INT32_MAX ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported partition number.\n" );
+
+			goto on_error;
+		}
+		partition_index = (int) value_64bit - 1;
+	}
+	if( option_number_of_threads != NULL )
+	{
+		string_length = system_string_length(
+		                 option_number_of_threads );
+
+		if( ( vsapmtools_system_string_copy_from_64_bit_in_decimal(
+		       option_number_of_threads,
+		       string_length + 1,
+		       &value_64bit,
+		       &error ) != 1 )
+		 || ( value_64bit == 0 )
+		 || ( value_64bit > (uint64_t) NBD_HANDLE_MAXIMUM_NUMBER_OF_THREADS ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of threads, value should be between 1 and %d.\n",
+			 NBD_HANDLE_MAXIMUM_NUMBER_OF_THREADS );
+
+			goto on_error;
+		}
+		number_of_threads = (int) value_64bit;
+	}
+	libcnotify_verbose_set(
+	 verbose );
+	libvsapm_notify_set_stream(
+	 stderr,
+	 NULL );
+	libvsapm_notify_set_verbose(
+	 verbose );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	/* The Unix domain socket path is a narrow string
+	 */
+	fprintf(
+	 stderr,
+	 "Unable to serve: %" PRIs_SYSTEM " on: %" PRIs_SYSTEM " NBD is not supported on this platform.\n",
+	 source,
+	 socket_path );
+
+	return( EXIT_FAILURE );
+#else
+	if( nbd_handle_initialize(
+	     &vsapmnbd_nbd_handle,
+	     number_of_threads,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize NBD handle.\n" );
+
+		goto on_error;
+	}
+	if( option_bytes_per_sector != NULL )
+	{
+		if( nbd_handle_set_bytes_per_sector(
+		     vsapmnbd_nbd_handle,
+		     option_bytes_per_sector,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported bytes per sector.\n" );
+
+			goto on_error;
+		}
+	}
+	if( nbd_handle_open_input(
+	     vsapmnbd_nbd_handle,
+	     source,
+	     partition_index,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open: %" PRIs_SYSTEM " partition: %d.\n",
+		 source,
+		 partition_index + 1 );
+
+		goto on_error;
+	}
+	if( nbd_handle_open_socket(
+	     vsapmnbd_nbd_handle,
+	     socket_path,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open socket: %" PRIs_SYSTEM ".\n",
+		 socket_path );
+
+		goto on_error;
+	}
+	if( vsapmtools_signal_attach(
+	     vsapmnbd_signal_handler,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to attach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	fprintf(
+	 stdout,
+	 "Serving partition: %d on: %" PRIs_SYSTEM "\n",
+	 partition_index + 1,
+	 socket_path );
+
+	if( nbd_handle_serve(
+	     vsapmnbd_nbd_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to serve partition.\n" );
+
+		goto on_error;
+	}
+	if( vsapmtools_signal_detach(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to detach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( nbd_handle_close_socket(
+	     vsapmnbd_nbd_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close socket.\n" );
+
+		goto on_error;
+	}
+	if( nbd_handle_close_input(
+	     vsapmnbd_nbd_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close NBD handle.\n" );
+
+		goto on_error;
+	}
+	if( nbd_handle_free(
+	     &vsapmnbd_nbd_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free NBD handle.\n" );
+
+		goto on_error;
+	}
+	if( vsapmnbd_abort != 0 )
+	{
+		fprintf(
+		 stdout,
+		 "Serving stopped.\n" );
+	}
+	return( EXIT_SUCCESS );
+#endif /* defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( vsapmnbd_nbd_handle != NULL )
+	{
+		nbd_handle_close_socket(
+		 vsapmnbd_nbd_handle,
+		 NULL );
+		nbd_handle_free(
+		 &vsapmnbd_nbd_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
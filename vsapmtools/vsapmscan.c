@@ -0,0 +1,385 @@
+/*
+ * Scans for Apple Partition Map (APM) entries and recovers a partition table
+ *
+ * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include <stdio.h>
+
+#if defined( HAVE_IO_H ) || defined( WINAPI )
+#include <io.h>
+#endif
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "info_handle.h"
+#include "scan_handle.h"
+#include "vsapmtools_getopt.h"
+#include "vsapmtools_libcerror.h"
+#include "vsapmtools_libclocale.h"
+#include "vsapmtools_libcnotify.h"
+#include "vsapmtools_libvsapm.h"
+#include "vsapmtools_output.h"
+#include "vsapmtools_signal.h"
+#include "vsapmtools_unused.h"
+
+scan_handle_t *vsapmscan_scan_handle = NULL;
+int vsapmscan_abort                  = 0;
+
+/* Prints the executable usage information
+ */
+void usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use vsapmscan to scan a device or image for Apple Partition Map (APM)\n"
+	                 "entries and recover a probable partition table, for example when\n"
+	                 "the first entry of the partition map is damaged.\n\n" );
+
+	fprintf( stream, "Usage: vsapmscan [ -b bytes_per_sector ] [ -t number_of_threads ]\n"
+	                 "                 [ -hvV ] source\n\n" );
+
+	fprintf( stream, "\tsource: the source file or device\n\n" );
+
+	fprintf( stream, "\t-b:     specify the number of bytes per sector (default is 512)\n"
+	                 "\t        (use this to override the bytes per sector of the driver descriptor)\n" );
+	fprintf( stream, "\t-h:     shows this help\n" );
+	fprintf( stream, "\t-t:     specify the number of threads used to scan the source\n"
+	                 "\t        (default is %d)\n",
+	         SCAN_HANDLE_DEFAULT_NUMBER_OF_THREADS );
+	fprintf( stream, "\t-v:     verbose output to stderr\n" );
+	fprintf( stream, "\t-V:     print version\n" );
+}
+
+/* Signal handler for vsapmscan
+ */
+void vsapmscan_signal_handler(
+      vsapmtools_signal_t signal VSAPMTOOLS_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "vsapmscan_signal_handler";
+
+	VSAPMTOOLS_UNREFERENCED_PARAMETER( signal )
+
+	vsapmscan_abort = 1;
+
+	if( vsapmscan_scan_handle != NULL )
+	{
+		if( scan_handle_signal_abort(
+		     vsapmscan_scan_handle,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal scan handle to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	/* Force stdin to close otherwise any function reading it will remain blocked
+	 */
+#if defined( WINAPI ) && !defined( __CYGWIN__ )
+	if( _close(
+	     0 ) != 0 )
+#else
+	if( close(
+	     0 ) != 0 )
+#endif
+	{
+		libcnotify_printf(
+		 "%s: unable to close stdin.\n",
+		 function );
+	}
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libcerror_error_t *error                     = NULL;
+	system_character_t *option_bytes_per_sector  = NULL;
+	system_character_t *option_number_of_threads = NULL;
+	system_character_t *source                   = NULL;
+	char *program                                = "vsapmscan";
+	system_integer_t option                      = 0;
+	size_t string_length                         = 0;
+	uint64_t value_64bit                         = 0;
+	int number_of_threads                        = SCAN_HANDLE_DEFAULT_NUMBER_OF_THREADS;
+	int verbose                                  = 0;
+
+	libcnotify_stream_set(
+	 stderr,
+	 NULL );
+	libcnotify_verbose_set(
+	 1 );
+
+	if( libclocale_initialize(
+	     "vsapmtools",
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize locale values.\n" );
+
+		goto on_error;
+	}
+	if( vsapmtools_output_initialize(
+	     _IONBF,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize output settings.\n" );
+
+		goto on_error;
+	}
+	vsapmtools_output_version_fprint(
+	 stdout,
+	 program );
+
+	while( ( option = vsapmtools_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "b:ht:vV" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM "\n",
+				 argv[ optind - 1 ] );
+
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'b':
+				option_bytes_per_sector = optarg;
+
+				break;
+
+			case (system_integer_t) 'h':
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 't':
+				option_number_of_threads = optarg;
+
+				break;
+
+			case (system_integer_t) 'v':
+				verbose = 1;
+
+				break;
+
+			case (system_integer_t) 'V':
+				vsapmtools_output_copyright_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing source file.\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	source = argv[ optind ];
+
+	if( option_number_of_threads != NULL )
+	{
+		string_length = system_string_length(
+		                 option_number_of_threads );
+
+		if( ( vsapmtools_system_string_copy_from_64_bit_in_decimal(
+		       option_number_of_threads,
+		       string_length + 1,
+		       &value_64bit,
+		       &error ) != 1 )
+		 || ( value_64bit == 0 )
+		 || ( value_64bit > (uint64_t) SCAN_HANDLE_MAXIMUM_NUMBER_OF_THREADS ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of threads, value should be between 1 and %d.\n",
+			 SCAN_HANDLE_MAXIMUM_NUMBER_OF_THREADS );
+
+			goto on_error;
+		}
+		number_of_threads = (int) value_64bit;
+	}
+	libcnotify_verbose_set(
+	 verbose );
+	libvsapm_notify_set_stream(
+	 stderr,
+	 NULL );
+	libvsapm_notify_set_verbose(
+	 verbose );
+
+	if( scan_handle_initialize(
+	     &vsapmscan_scan_handle,
+	     number_of_threads,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize scan handle.\n" );
+
+		goto on_error;
+	}
+	if( option_bytes_per_sector != NULL )
+	{
+		if( scan_handle_set_bytes_per_sector(
+		     vsapmscan_scan_handle,
+		     option_bytes_per_sector,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported bytes per sector.\n" );
+
+			goto on_error;
+		}
+	}
+	if( vsapmtools_signal_attach(
+	     vsapmscan_signal_handler,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to attach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( scan_handle_open_input(
+	     vsapmscan_scan_handle,
+	     source,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to scan: %" PRIs_SYSTEM ".\n",
+		 source );
+
+		goto on_error;
+	}
+	if( scan_handle_partitions_fprint(
+	     vsapmscan_scan_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to print recovered partition table.\n" );
+
+		goto on_error;
+	}
+	if( vsapmtools_signal_detach(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to detach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( scan_handle_close_input(
+	     vsapmscan_scan_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close scan handle.\n" );
+
+		goto on_error;
+	}
+	if( scan_handle_free(
+	     &vsapmscan_scan_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free scan handle.\n" );
+
+		goto on_error;
+	}
+	if( vsapmscan_abort != 0 )
+	{
+		fprintf(
+		 stdout,
+		 "Scan aborted.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( vsapmscan_scan_handle != NULL )
+	{
+		scan_handle_free(
+		 &vsapmscan_scan_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
@@ -1,5 +1,5 @@
 /*
- * The libfdata header wrapper
+ * The libhmac header wrapper
  *
  * Copyright (C) 2009-2024, Joachim Metz <joachim.metz@gmail.com>
  *
@@ -19,36 +19,33 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
-#if !defined( _LIBVSAPM_LIBFDATA_H )
-#define _LIBVSAPM_LIBFDATA_H
+#if !defined( _VSAPMTOOLS_LIBHMAC_H )
+#define _VSAPMTOOLS_LIBHMAC_H
 
 #include <common.h>
 
-/* Define HAVE_LOCAL_LIBFDATA for local use of libfdata
+/* Define HAVE_LOCAL_LIBHMAC for local use of libhmac
  */
-#if defined( HAVE_LOCAL_LIBFDATA )
+#if defined( HAVE_LOCAL_LIBHMAC )
 
-#include <libfdata_area.h>
-#include <libfdata_definitions.h>
-#include <libfdata_list.h>
-#include <libfdata_list_element.h>
-#include <libfdata_range_list.h>
-#include <libfdata_stream.h>
-#include <libfdata_types.h>
-#include <libfdata_vector.h>
+#include <libhmac_definitions.h>
+#include <libhmac_md5.h>
+#include <libhmac_sha1.h>
+#include <libhmac_sha256.h>
+#include <libhmac_types.h>
 
 #else
 
-/* If libtool DLL support is enabled set LIBFDATA_DLL_IMPORT
- * before including libfdata.h
+/* If libtool DLL support is enabled set LIBHMAC_DLL_IMPORT
+ * before including libhmac.h
  */
-#if defined( _WIN32 ) && defined( DLL_IMPORT )
-#define LIBFDATA_DLL_IMPORT
+#if defined( _WIN32 ) && defined( DLL_IMPORT ) && !defined( HAVE_STATIC_EXECUTABLES )
+#define LIBHMAC_DLL_IMPORT
 #endif
 
-#include <libfdata.h>
+#include <libhmac.h>
 
-#endif /* defined( HAVE_LOCAL_LIBFDATA ) */
+#endif /* defined( HAVE_LOCAL_LIBHMAC ) */
 
-#endif /* !defined( _LIBVSAPM_LIBFDATA_H ) */
+#endif /* !defined( _VSAPMTOOLS_LIBHMAC_H ) */
 